@@ -1,5 +1,5 @@
 // Polynomial multiplication using FFT
-// Fast O(n log n) multiplication via Fast Fourier Transform
+// Fast O(n log n) multiplication via a planned iterative FFT
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
@@ -9,38 +9,93 @@
 #define MAX_DEG 4096
 #define PI 3.14159265358979323846
 
-void fft(double complex *a, int n, int inv) {
-    if (n == 1) return;
-    
-    double complex *even = (double complex*)malloc(n/2 * sizeof(double complex));
-    double complex *odd = (double complex*)malloc(n/2 * sizeof(double complex));
-    
-    for (int i = 0; i < n/2; i++) {
-        even[i] = a[2*i];
-        odd[i] = a[2*i + 1];
+// Plan: bit-reversal table and per-stage twiddles W_m^j = exp(-2 pi i j / m),
+// j < m/2, stored at offset m/2 - 1. Built once, shared by both transforms.
+typedef struct {
+    int n;
+    int log_n;
+    unsigned int *rev;
+    double complex *twiddles;
+} FftPlan;
+
+FftPlan *fft_plan_create(int n) {
+    FftPlan *plan = (FftPlan*)malloc(sizeof(FftPlan));
+    plan->n = n;
+    plan->log_n = 0;
+    while ((1 << plan->log_n) < n) plan->log_n++;
+    
+    plan->rev = (unsigned int*)malloc(n * sizeof(unsigned int));
+    plan->rev[0] = 0;
+    for (int i = 1; i < n; i++) {
+        plan->rev[i] = (plan->rev[i >> 1] >> 1) | ((unsigned int)(i & 1) << (plan->log_n - 1));
     }
     
-    fft(even, n/2, inv);
-    fft(odd, n/2, inv);
+    plan->twiddles = (double complex*)malloc((n > 1 ? n - 1 : 1) * sizeof(double complex));
+    for (int m = 2; m <= n; m <<= 1) {
+        for (int j = 0; j < m / 2; j++) {
+            plan->twiddles[m / 2 - 1 + j] = cexp(-I * 2 * PI * j / m);
+        }
+    }
+    return plan;
+}
+
+void fft_plan_destroy(FftPlan *plan) {
+    free(plan->rev);
+    free(plan->twiddles);
+    free(plan);
+}
+
+// Iterative in-place transform; the inverse uses conjugate twiddles and scales by 1/n.
+// Pairs of radix-2 stages are fused into radix-4 passes (W_4L^L = -i, or +i inverse).
+void fft(const FftPlan *plan, double complex *a, int inv) {
+    int n = plan->n;
+    for (int i = 0; i < n; i++) {
+        unsigned int j = plan->rev[i];
+        if ((unsigned int)i < j) {
+            double complex t = a[i];
+            a[i] = a[j];
+            a[j] = t;
+        }
+    }
     
-    double angle = 2 * PI / n * (inv ? -1 : 1);
-    double complex w = 1;
-    double complex wn = cexp(I * angle);
+    int L = 1;
+    if (plan->log_n & 1) {
+        for (int i = 0; i < n; i += 2) {
+            double complex u = a[i], v = a[i + 1];
+            a[i] = u + v;
+            a[i + 1] = u - v;
+        }
+        L = 2;
+    }
     
-    for (int i = 0; i < n/2; i++) {
-        a[i] = even[i] + w * odd[i];
-        a[i + n/2] = even[i] - w * odd[i];
-        if (inv) {
-            a[i] /= 2;
-            a[i + n/2] /= 2;
+    double complex rot = inv ? I : -I;
+    for (; L < n; L *= 4) {
+        const double complex *w2 = plan->twiddles + (L - 1);
+        const double complex *w4 = plan->twiddles + (2 * L - 1);
+        for (int k = 0; k < n; k += 4 * L) {
+            double complex *x0 = a + k, *x1 = x0 + L, *x2 = x1 + L, *x3 = x2 + L;
+            for (int j = 0; j < L; j++) {
+                double complex t2 = inv ? conj(w2[j]) : w2[j];
+                double complex t4 = inv ? conj(w4[j]) : w4[j];
+                double complex a1 = x1[j] * t2, a3 = x3[j] * t2;
+                double complex b0 = x0[j] + a1, b1 = x0[j] - a1;
+                double complex c2 = (x2[j] + a3) * t4;
+                double complex c3 = (x2[j] - a3) * t4 * rot;
+                x0[j] = b0 + c2;
+                x2[j] = b0 - c2;
+                x1[j] = b1 + c3;
+                x3[j] = b1 - c3;
+            }
         }
-        w *= wn;
     }
     
-    free(even);
-    free(odd);
+    if (inv) {
+        for (int i = 0; i < n; i++) a[i] /= n;
+    }
 }
 
+// Both real inputs ride in one complex transform (a in the real part, b in
+// the imaginary part); their spectra are separated by conjugate symmetry.
 void polynomial_multiply(double *a, int deg_a, double *b, int deg_b, double *result) {
     int result_deg = deg_a + deg_b;
     
@@ -48,27 +103,31 @@ void polynomial_multiply(double *a, int deg_a, double *b, int deg_b, double *res
     int n = 1;
     while (n <= result_deg) n <<= 1;
     
-    double complex *fa = (double complex*)calloc(n, sizeof(double complex));
-    double complex *fb = (double complex*)calloc(n, sizeof(double complex));
+    FftPlan *plan = fft_plan_create(n);
+    double complex *fz = (double complex*)calloc(n, sizeof(double complex));
+    double complex *fp = (double complex*)malloc(n * sizeof(double complex));
     
-    for (int i = 0; i <= deg_a; i++) fa[i] = a[i];
-    for (int i = 0; i <= deg_b; i++) fb[i] = b[i];
+    for (int i = 0; i <= deg_a; i++) fz[i] = a[i];
+    for (int i = 0; i <= deg_b; i++) fz[i] += b[i] * I;
     
-    fft(fa, n, 0);
-    fft(fb, n, 0);
+    fft(plan, fz, 0);
     
     for (int i = 0; i < n; i++) {
-        fa[i] *= fb[i];
+        double complex zk = fz[i], zc = conj(fz[(n - i) & (n - 1)]);
+        double complex fa = (zk + zc) / 2;
+        double complex fb = (zk - zc) / (2 * I);
+        fp[i] = fa * fb;
     }
     
-    fft(fa, n, 1);
+    fft(plan, fp, 1);
     
     for (int i = 0; i <= result_deg; i++) {
-        result[i] = creal(fa[i]);
+        result[i] = creal(fp[i]);
     }
     
-    free(fa);
-    free(fb);
+    fft_plan_destroy(plan);
+    free(fz);
+    free(fp);
 }
 
 void generate_polynomial(double *poly, int degree) {
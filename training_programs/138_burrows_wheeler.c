@@ -8,50 +8,152 @@
 #define TEXT_SIZE 10000
 #define NUM_TRANSFORMS 200
 
+// SA-IS (Nong, Zhang, Chan) suffix sorting. Level 0 reads bytes with a virtual
+// sentinel at index n - 1; deeper levels read the reduced string.
 typedef struct {
-    char *rotation;
-    int index;
-} Rotation;
-
-int compare_rotations(const void *a, const void *b) {
-    Rotation *ra = (Rotation*)a;
-    Rotation *rb = (Rotation*)b;
-    return strcmp(ra->rotation, rb->rotation);
+    const void *s;
+    int level0;
+    int n;
+} SaisText;
+
+static inline int sym(const SaisText *x, int i) {
+    if (x->level0) return i == x->n - 1 ? 0 : ((const unsigned char*)x->s)[i] + 1;
+    return ((const int*)x->s)[i];
 }
 
-void burrows_wheeler_transform(const char *input, char *output, int *primary_index) {
-    int len = strlen(input);
-    
-    // Create all rotations
-    Rotation *rotations = (Rotation*)malloc(len * sizeof(Rotation));
-    for (int i = 0; i < len; i++) {
-        rotations[i].rotation = (char*)malloc(len + 1);
-        rotations[i].index = i;
-        
-        // Create rotation
-        for (int j = 0; j < len; j++) {
-            rotations[i].rotation[j] = input[(i + j) % len];
+#define IS_S(t, i) ((t)[(i) >> 3] & (1 << ((i) & 7)))
+#define IS_LMS(t, i) ((i) > 0 && IS_S(t, i) && !IS_S(t, (i) - 1))
+
+static void get_buckets(const SaisText *x, int *bkt, int k, int end) {
+    memset(bkt, 0, k * sizeof(int));
+    for (int i = 0; i < x->n; i++) bkt[sym(x, i)]++;
+    int sum = 0;
+    for (int c = 0; c < k; c++) {
+        sum += bkt[c];
+        bkt[c] = end ? sum : sum - bkt[c];
+    }
+}
+
+static void induce_l(const SaisText *x, const unsigned char *t, int *sa, int *bkt, int k) {
+    get_buckets(x, bkt, k, 0);
+    for (int i = 0; i < x->n; i++) {
+        int j = sa[i] - 1;
+        if (j >= 0 && !IS_S(t, j)) sa[bkt[sym(x, j)]++] = j;
+    }
+}
+
+static void induce_s(const SaisText *x, const unsigned char *t, int *sa, int *bkt, int k) {
+    get_buckets(x, bkt, k, 1);
+    for (int i = x->n - 1; i >= 0; i--) {
+        int j = sa[i] - 1;
+        if (j >= 0 && IS_S(t, j)) sa[--bkt[sym(x, j)]] = j;
+    }
+}
+
+static void sais_rec(const SaisText *x, int *sa, int k) {
+    int n = x->n;
+    unsigned char *t = (unsigned char*)malloc((n >> 3) + 1);
+    int *bkt = (int*)malloc(k * sizeof(int));
+    memset(t, 0, (n >> 3) + 1);
+
+    // Classify: S if smaller than the next suffix
+    t[(n - 1) >> 3] |= 1 << ((n - 1) & 7);
+    for (int i = n - 2; i >= 0; i--) {
+        int a = sym(x, i), b = sym(x, i + 1);
+        if (a < b || (a == b && IS_S(t, i + 1))) t[i >> 3] |= 1 << (i & 7);
+    }
+
+    // Stage 1: sort LMS substrings by induction
+    get_buckets(x, bkt, k, 1);
+    for (int i = 0; i < n; i++) sa[i] = -1;
+    for (int i = 1; i < n; i++) {
+        if (IS_LMS(t, i)) sa[--bkt[sym(x, i)]] = i;
+    }
+    induce_l(x, t, sa, bkt, k);
+    induce_s(x, t, sa, bkt, k);
+
+    int n1 = 0;
+    for (int i = 0; i < n; i++) {
+        if (IS_LMS(t, sa[i])) sa[n1++] = sa[i];
+    }
+
+    // Name LMS substrings; equal substrings share a name
+    for (int i = n1; i < n; i++) sa[i] = -1;
+    int name = 0, prev = -1;
+    for (int i = 0; i < n1; i++) {
+        int pos = sa[i], diff = 0;
+        for (int d = 0; d < n; d++) {
+            if (prev == -1 || sym(x, pos + d) != sym(x, prev + d) ||
+                !IS_S(t, pos + d) != !IS_S(t, prev + d)) {
+                diff = 1;
+                break;
+            }
+            if (d > 0 && (IS_LMS(t, pos + d) || IS_LMS(t, prev + d))) break;
+        }
+        if (diff) {
+            name++;
+            prev = pos;
         }
-        rotations[i].rotation[len] = '\0';
+        sa[n1 + (pos >> 1)] = name - 1;
+    }
+    for (int i = n - 1, j = n - 1; i >= n1; i--) {
+        if (sa[i] >= 0) sa[j--] = sa[i];
+    }
+
+    // Stage 2: sort the reduced string, recursing only while names repeat
+    int *sa1 = sa, *s1 = sa + n - n1;
+    if (name < n1) {
+        SaisText reduced = {s1, 0, n1};
+        sais_rec(&reduced, sa1, name);
+    } else {
+        for (int i = 0; i < n1; i++) sa1[s1[i]] = i;
+    }
+
+    // Stage 3: induce the full order from the sorted LMS suffixes
+    get_buckets(x, bkt, k, 1);
+    for (int i = 1, j = 0; i < n; i++) {
+        if (IS_LMS(t, i)) s1[j++] = i;
     }
+    for (int i = 0; i < n1; i++) sa1[i] = s1[sa1[i]];
+    for (int i = n1; i < n; i++) sa[i] = -1;
+    for (int i = n1 - 1; i >= 0; i--) {
+        int j = sa[i];
+        sa[i] = -1;
+        sa[--bkt[sym(x, j)]] = j;
+    }
+    induce_l(x, t, sa, bkt, k);
+    induce_s(x, t, sa, bkt, k);
+
+    free(bkt);
+    free(t);
+}
+
+// Rotations are the first len symbols of the suffixes of input+input, so
+// sorting those suffixes sorts the rotations without copying any of them.
+void burrows_wheeler_transform(const char *input, char *output, int *primary_index) {
+    int len = strlen(input);
     
-    // Sort rotations
-    qsort(rotations, len, sizeof(Rotation), compare_rotations);
+    char *doubled = (char*)malloc(2 * len);
+    memcpy(doubled, input, len);
+    memcpy(doubled + len, input, len);
+    int *sa = (int*)malloc((2 * len + 1) * sizeof(int));
+    SaisText x = {doubled, 1, 2 * len + 1};
+    sais_rec(&x, sa, 257);
     
-    // Extract last column and find primary index
-    for (int i = 0; i < len; i++) {
-        output[i] = rotations[i].rotation[len - 1];
-        if (rotations[i].index == 0) {
-            *primary_index = i;
+    // Extract last column and find primary index (sa[0] is the sentinel)
+    int row = 0;
+    for (int i = 1; i <= 2 * len; i++) {
+        int p = sa[i];
+        if (p >= len) continue;
+        if (p == 0) {
+            *primary_index = row;
         }
+        output[row++] = input[(p + len - 1) % len];
     }
     output[len] = '\0';
     
-    // Free memory
-    for (int i = 0; i < len; i++) {
-        free(rotations[i].rotation);
-    }
-    free(rotations);
+    free(sa);
+    free(doubled);
 }
 
 void inverse_burrows_wheeler_transform(const char *input, char *output, int primary_index) {
@@ -78,8 +180,9 @@ void inverse_burrows_wheeler_transform(const char *input, char *output, int prim
         transform[cumulative[c]++] = i;
     }
     
-    // Reconstruct original string
-    int idx = primary_index;
+    // Reconstruct original string: transform steps from rotation i to i + 1,
+    // and row i holds the character before rotation i, so start one row on
+    int idx = transform[primary_index];
     for (int i = 0; i < len; i++) {
         output[i] = input[idx];
         idx = transform[idx];
@@ -1,4 +1,5 @@
 // Autocorrelation function for signal analysis
+// FFT-based (Wiener-Khinchin) with a planned iterative transform
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
@@ -7,6 +8,78 @@
 #define SIGNAL_LENGTH 10000
 #define MAX_LAG 500
 
+// FFT plan over SoA arrays: bit-reversal table and per-stage twiddles
+// W_m^j = exp(-2 pi i j / m), j < m/2, at offset m/2 - 1.
+typedef struct {
+    int n;
+    int log_n;
+    unsigned int *rev;
+    double *tw_re;
+    double *tw_im;
+} FftPlan;
+
+FftPlan *fft_plan_create(int n) {
+    FftPlan *plan = (FftPlan*)malloc(sizeof(FftPlan));
+    plan->n = n;
+    plan->log_n = 0;
+    while ((1 << plan->log_n) < n) plan->log_n++;
+    
+    plan->rev = (unsigned int*)malloc(n * sizeof(unsigned int));
+    plan->rev[0] = 0;
+    for (int i = 1; i < n; i++) {
+        plan->rev[i] = (plan->rev[i >> 1] >> 1) | ((unsigned int)(i & 1) << (plan->log_n - 1));
+    }
+    
+    plan->tw_re = (double*)malloc(n * sizeof(double));
+    plan->tw_im = (double*)malloc(n * sizeof(double));
+    for (int m = 2; m <= n; m <<= 1) {
+        for (int j = 0; j < m / 2; j++) {
+            plan->tw_re[m / 2 - 1 + j] = cos(-2.0 * M_PI * j / m);
+            plan->tw_im[m / 2 - 1 + j] = sin(-2.0 * M_PI * j / m);
+        }
+    }
+    return plan;
+}
+
+void fft_plan_destroy(FftPlan *plan) {
+    free(plan->rev);
+    free(plan->tw_re);
+    free(plan->tw_im);
+    free(plan);
+}
+
+// Iterative in-place forward transform. Calling it with re and im swapped
+// gives the unscaled inverse.
+void fft_forward(const FftPlan *plan, double *re, double *im) {
+    int n = plan->n;
+    for (int i = 0; i < n; i++) {
+        unsigned int j = plan->rev[i];
+        if ((unsigned int)i < j) {
+            double t = re[i]; re[i] = re[j]; re[j] = t;
+            t = im[i]; im[i] = im[j]; im[j] = t;
+        }
+    }
+    
+    for (int m = 2; m <= n; m <<= 1) {
+        int half = m / 2;
+        const double *wr = plan->tw_re + (half - 1), *wi = plan->tw_im + (half - 1);
+        for (int k = 0; k < n; k += m) {
+            double *ur = re + k, *ui = im + k, *vr = ur + half, *vi = ui + half;
+            for (int j = 0; j < half; j++) {
+                double tr = vr[j] * wr[j] - vi[j] * wi[j];
+                double ti = vr[j] * wi[j] + vi[j] * wr[j];
+                vr[j] = ur[j] - tr;
+                vi[j] = ui[j] - ti;
+                ur[j] += tr;
+                ui[j] += ti;
+            }
+        }
+    }
+}
+
+// Wiener-Khinchin: the autocorrelation is the inverse transform of the power
+// spectrum. Zero-padding to at least length + max_lag keeps the circular
+// correlation from wrapping into the lags we keep.
 void compute_autocorrelation(double *signal, int length, double *autocorr, int max_lag) {
     double mean = 0.0;
     for (int i = 0; i < length; i++) {
@@ -20,17 +93,30 @@ void compute_autocorrelation(double *signal, int length, double *autocorr, int m
         variance += diff * diff;
     }
     
+    int n = 1;
+    while (n < length + max_lag) n <<= 1;
+    
+    FftPlan *plan = fft_plan_create(n);
+    double *re = (double*)calloc(n, sizeof(double));
+    double *im = (double*)calloc(n, sizeof(double));
+    for (int i = 0; i < length; i++) {
+        re[i] = signal[i] - mean;
+    }
+    
+    fft_forward(plan, re, im);
+    for (int k = 0; k < n; k++) {
+        re[k] = re[k] * re[k] + im[k] * im[k];
+        im[k] = 0.0;
+    }
+    fft_forward(plan, im, re);
+    
     for (int lag = 0; lag < max_lag; lag++) {
-        double sum = 0.0;
-        int count = 0;
-        
-        for (int i = 0; i < length - lag; i++) {
-            sum += (signal[i] - mean) * (signal[i + lag] - mean);
-            count++;
-        }
-        
-        autocorr[lag] = sum / variance;
+        autocorr[lag] = re[lag] / n / variance;
     }
+    
+    fft_plan_destroy(plan);
+    free(re);
+    free(im);
 }
 
 void generate_noisy_sine(double *signal, int length, double frequency, double noise_level, unsigned int *seed) {
@@ -3,31 +3,133 @@
 #include <string.h>
 #include <time.h>
 
-typedef struct Suffix {
-    int index;
-    char* suff;
-} Suffix;
+// SA-IS (Nong, Zhang, Chan): linear-time induced sorting. Level 0 reads bytes
+// with a virtual sentinel at index n - 1; deeper levels read the reduced string.
+typedef struct {
+    const void *s;
+    int level0;
+    int n;
+} SaisText;
 
-int cmp(const void* a, const void* b) {
-    return strcmp(((Suffix*)a)->suff, ((Suffix*)b)->suff);
+static inline int sym(const SaisText *x, int i) {
+    if (x->level0) return i == x->n - 1 ? 0 : ((const unsigned char*)x->s)[i] + 1;
+    return ((const int*)x->s)[i];
 }
 
-int* build_suffix_array(char* txt, int n) {
-    Suffix* suffixes = (Suffix*)malloc(n * sizeof(Suffix));
-    
+#define IS_S(t, i) ((t)[(i) >> 3] & (1 << ((i) & 7)))
+#define IS_LMS(t, i) ((i) > 0 && IS_S(t, i) && !IS_S(t, (i) - 1))
+
+static void get_buckets(const SaisText *x, int *bkt, int k, int end) {
+    memset(bkt, 0, k * sizeof(int));
+    for (int i = 0; i < x->n; i++) bkt[sym(x, i)]++;
+    int sum = 0;
+    for (int c = 0; c < k; c++) {
+        sum += bkt[c];
+        bkt[c] = end ? sum : sum - bkt[c];
+    }
+}
+
+static void induce_l(const SaisText *x, const unsigned char *t, int *sa, int *bkt, int k) {
+    get_buckets(x, bkt, k, 0);
+    for (int i = 0; i < x->n; i++) {
+        int j = sa[i] - 1;
+        if (j >= 0 && !IS_S(t, j)) sa[bkt[sym(x, j)]++] = j;
+    }
+}
+
+static void induce_s(const SaisText *x, const unsigned char *t, int *sa, int *bkt, int k) {
+    get_buckets(x, bkt, k, 1);
+    for (int i = x->n - 1; i >= 0; i--) {
+        int j = sa[i] - 1;
+        if (j >= 0 && IS_S(t, j)) sa[--bkt[sym(x, j)]] = j;
+    }
+}
+
+static void sais_rec(const SaisText *x, int *sa, int k) {
+    int n = x->n;
+    unsigned char *t = (unsigned char*)malloc((n >> 3) + 1);
+    int *bkt = (int*)malloc(k * sizeof(int));
+    memset(t, 0, (n >> 3) + 1);
+
+    // Classify: S if smaller than the next suffix
+    t[(n - 1) >> 3] |= 1 << ((n - 1) & 7);
+    for (int i = n - 2; i >= 0; i--) {
+        int a = sym(x, i), b = sym(x, i + 1);
+        if (a < b || (a == b && IS_S(t, i + 1))) t[i >> 3] |= 1 << (i & 7);
+    }
+
+    // Stage 1: sort LMS substrings by induction
+    get_buckets(x, bkt, k, 1);
+    for (int i = 0; i < n; i++) sa[i] = -1;
+    for (int i = 1; i < n; i++) {
+        if (IS_LMS(t, i)) sa[--bkt[sym(x, i)]] = i;
+    }
+    induce_l(x, t, sa, bkt, k);
+    induce_s(x, t, sa, bkt, k);
+
+    int n1 = 0;
     for (int i = 0; i < n; i++) {
-        suffixes[i].index = i;
-        suffixes[i].suff = txt + i;
+        if (IS_LMS(t, sa[i])) sa[n1++] = sa[i];
     }
-    
-    qsort(suffixes, n, sizeof(Suffix), cmp);
-    
-    int* suffix_arr = (int*)malloc(n * sizeof(int));
-    for (int i = 0; i < n; i++)
-        suffix_arr[i] = suffixes[i].index;
-    
-    free(suffixes);
-    return suffix_arr;
+
+    // Name LMS substrings; equal substrings share a name
+    for (int i = n1; i < n; i++) sa[i] = -1;
+    int name = 0, prev = -1;
+    for (int i = 0; i < n1; i++) {
+        int pos = sa[i], diff = 0;
+        for (int d = 0; d < n; d++) {
+            if (prev == -1 || sym(x, pos + d) != sym(x, prev + d) ||
+                !IS_S(t, pos + d) != !IS_S(t, prev + d)) {
+                diff = 1;
+                break;
+            }
+            if (d > 0 && (IS_LMS(t, pos + d) || IS_LMS(t, prev + d))) break;
+        }
+        if (diff) {
+            name++;
+            prev = pos;
+        }
+        sa[n1 + (pos >> 1)] = name - 1;
+    }
+    for (int i = n - 1, j = n - 1; i >= n1; i--) {
+        if (sa[i] >= 0) sa[j--] = sa[i];
+    }
+
+    // Stage 2: sort the reduced string, recursing only while names repeat
+    int *sa1 = sa, *s1 = sa + n - n1;
+    if (name < n1) {
+        SaisText reduced = {s1, 0, n1};
+        sais_rec(&reduced, sa1, name);
+    } else {
+        for (int i = 0; i < n1; i++) sa1[s1[i]] = i;
+    }
+
+    // Stage 3: induce the full order from the sorted LMS suffixes
+    get_buckets(x, bkt, k, 1);
+    for (int i = 1, j = 0; i < n; i++) {
+        if (IS_LMS(t, i)) s1[j++] = i;
+    }
+    for (int i = 0; i < n1; i++) sa1[i] = s1[sa1[i]];
+    for (int i = n1; i < n; i++) sa[i] = -1;
+    for (int i = n1 - 1; i >= 0; i--) {
+        int j = sa[i];
+        sa[i] = -1;
+        sa[--bkt[sym(x, j)]] = j;
+    }
+    induce_l(x, t, sa, bkt, k);
+    induce_s(x, t, sa, bkt, k);
+
+    free(bkt);
+    free(t);
+}
+
+int* build_suffix_array(char* txt, int n) {
+    int* sa = (int*)malloc((n + 1) * sizeof(int));
+    SaisText x = {txt, 1, n + 1};
+    sais_rec(&x, sa, 257);
+    // Drop the sentinel suffix, which always sorts first
+    memmove(sa, sa + 1, n * sizeof(int));
+    return sa;
 }
 
 int main() {
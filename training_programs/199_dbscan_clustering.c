@@ -1,4 +1,5 @@
 // DBSCAN clustering algorithm for density-based clustering
+// Range queries over a uniform grid of eps-sized cells
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
@@ -8,6 +9,7 @@
 #define DIM 2
 #define EPSILON 5.0
 #define MIN_POINTS 5
+#define GRID_MAX_CELLS (1 << 22)  // cells are widened past eps to stay under this
 
 typedef struct {
     double coords[DIM];
@@ -24,20 +26,105 @@ double euclidean_distance(Point *a, Point *b) {
     return sqrt(sum);
 }
 
-void range_query(Point *points, int n, int point_idx, double eps, int *neighbors, int *count) {
-    *count = 0;
+// Uniform grid over the first two coordinates with eps x eps cells. Points
+// are bucketed by cell once with a counting sort, so a range query scans the
+// 3 x 3 block of cells around its point instead of all n points; the
+// distance test itself is unchanged. Neighbours are returned in index order,
+// as the full scan did, so clusters come out the same.
+typedef struct {
+    double min_x, min_y, cell;
+    int cols, rows;
+    int *cell_start;    // cols * rows + 1
+    int *cell_points;   // point indices grouped by cell, ascending within a cell
+} Grid;
+
+int grid_cell(Grid *grid, double x, double y) {
+    int cx = (int)((x - grid->min_x) / grid->cell);
+    int cy = (int)((y - grid->min_y) / grid->cell);
+    if (cx >= grid->cols) cx = grid->cols - 1;
+    if (cy >= grid->rows) cy = grid->rows - 1;
+    return cy * grid->cols + cx;
+}
+
+void build_grid(Grid *grid, Point *points, int n, double eps) {
+    double max_x = points[0].coords[0], max_y = points[0].coords[1];
+    grid->min_x = max_x;
+    grid->min_y = max_y;
+    for (int i = 1; i < n; i++) {
+        if (points[i].coords[0] < grid->min_x) grid->min_x = points[i].coords[0];
+        if (points[i].coords[1] < grid->min_y) grid->min_y = points[i].coords[1];
+        if (points[i].coords[0] > max_x) max_x = points[i].coords[0];
+        if (points[i].coords[1] > max_y) max_y = points[i].coords[1];
+    }
+    // Any cell at least eps wide keeps every neighbour inside the 3 x 3
+    // block, so a tiny (or zero) eps just gets coarser cells instead of a
+    // grid too large to count or allocate.
+    double span_x = max_x - grid->min_x, span_y = max_y - grid->min_y;
+    grid->cell = eps > 0.0 ? eps : 1.0;
+    while ((span_x / grid->cell + 1.0) * (span_y / grid->cell + 1.0) > GRID_MAX_CELLS) {
+        grid->cell *= 2.0;
+    }
+    grid->cols = (int)(span_x / grid->cell) + 1;
+    grid->rows = (int)(span_y / grid->cell) + 1;
+    size_t cells = (size_t)grid->cols * grid->rows;
+    grid->cell_start = (int*)calloc(cells + 1, sizeof(int));
+    grid->cell_points = (int*)malloc(n * sizeof(int));
+    int *next = (int*)malloc(cells * sizeof(int));
+    if (!grid->cell_start || !grid->cell_points || !next) {
+        fprintf(stderr, "build_grid: out of memory for %zu cells\n", cells);
+        exit(1);
+    }
     for (int i = 0; i < n; i++) {
-        if (euclidean_distance(&points[point_idx], &points[i]) <= eps) {
-            neighbors[(*count)++] = i;
+        grid->cell_start[grid_cell(grid, points[i].coords[0], points[i].coords[1]) + 1]++;
+    }
+    for (size_t c = 0; c < cells; c++) grid->cell_start[c + 1] += grid->cell_start[c];
+    for (size_t c = 0; c < cells; c++) next[c] = grid->cell_start[c];
+    for (int i = 0; i < n; i++) {
+        grid->cell_points[next[grid_cell(grid, points[i].coords[0], points[i].coords[1])]++] = i;
+    }
+    free(next);
+}
+
+void free_grid(Grid *grid) {
+    free(grid->cell_start);
+    free(grid->cell_points);
+}
+
+void range_query(Grid *grid, Point *points, int point_idx, double eps, int *neighbors, int *count) {
+    *count = 0;
+    int cell = grid_cell(grid, points[point_idx].coords[0], points[point_idx].coords[1]);
+    int cx = cell % grid->cols, cy = cell / grid->cols;
+    for (int y = cy - 1; y <= cy + 1; y++) {
+        if (y < 0 || y >= grid->rows) continue;
+        for (int x = cx - 1; x <= cx + 1; x++) {
+            if (x < 0 || x >= grid->cols) continue;
+            int c = y * grid->cols + x;
+            for (int k = grid->cell_start[c]; k < grid->cell_start[c + 1]; k++) {
+                int i = grid->cell_points[k];
+                if (euclidean_distance(&points[point_idx], &points[i]) <= eps) {
+                    neighbors[(*count)++] = i;
+                }
+            }
         }
     }
+    
+    // back to index order
+    for (int i = 1; i < *count; i++) {
+        int key = neighbors[i];
+        int j = i - 1;
+        while (j >= 0 && neighbors[j] > key) {
+            neighbors[j + 1] = neighbors[j];
+            j--;
+        }
+        neighbors[j + 1] = key;
+    }
 }
 
-void expand_cluster(Point *points, int n, int point_idx, int cluster_id, double eps, int min_pts) {
+void expand_cluster(Grid *grid, Point *points, int n, int point_idx, int cluster_id, double eps, int min_pts) {
     int *neighbors = (int*)malloc(n * sizeof(int));
     int neighbor_count;
     
-    range_query(points, n, point_idx, eps, neighbors, &neighbor_count);
+    range_query(grid, points, point_idx, eps, neighbors, &neighbor_count);
     
     if (neighbor_count < min_pts) {
         points[point_idx].cluster_id = -1;
@@ -47,7 +134,9 @@ void expand_cluster(Point *points, int n, int point_idx, int cluster_id, double
     
     points[point_idx].cluster_id = cluster_id;
     
-    int *queue = (int*)malloc(n * sizeof(int));
+    // a point can be queued once per core neighbour, so the queue grows
+    int queue_capacity = n;
+    int *queue = (int*)malloc(queue_capacity * sizeof(int));
     int queue_size = 0;
     
     for (int i = 0; i < neighbor_count; i++) {
@@ -65,12 +154,16 @@ void expand_cluster(Point *points, int n, int point_idx, int cluster_id, double
         points[current_idx].visited = 1;
         
         int current_neighbor_count;
-        range_query(points, n, current_idx, eps, neighbors, &current_neighbor_count);
+        range_query(grid, points, current_idx, eps, neighbors, &current_neighbor_count);
         
         if (current_neighbor_count >= min_pts) {
             for (int i = 0; i < current_neighbor_count; i++) {
                 int neighbor_idx = neighbors[i];
                 if (points[neighbor_idx].cluster_id == 0) {
+                    if (queue_size == queue_capacity) {
+                        queue_capacity *= 2;
+                        queue = (int*)realloc(queue, queue_capacity * sizeof(int));
+                    }
                     queue[queue_size++] = neighbor_idx;
                 }
             }
@@ -93,6 +186,9 @@ int dbscan(Point *points, int n, double eps, int min_pts) {
         points[i].visited = 0;
     }
     
+    Grid grid;
+    build_grid(&grid, points, n, eps);
+    
     for (int i = 0; i < n; i++) {
         if (points[i].visited) continue;
         
@@ -100,11 +196,11 @@ int dbscan(Point *points, int n, double eps, int min_pts) {
         
         int *neighbors = (int*)malloc(n * sizeof(int));
         int neighbor_count;
-        range_query(points, n, i, eps, neighbors, &neighbor_count);
+        range_query(&grid, points, i, eps, neighbors, &neighbor_count);
         
         if (neighbor_count >= min_pts) {
             cluster_id++;
-            expand_cluster(points, n, i, cluster_id, eps, min_pts);
+            expand_cluster(&grid, points, n, i, cluster_id, eps, min_pts);
         } else {
             points[i].cluster_id = -1;
         }
@@ -112,6 +208,7 @@ int dbscan(Point *points, int n, double eps, int min_pts) {
         free(neighbors);
     }
     
+    free_grid(&grid);
     return cluster_id;
 }
 
@@ -0,0 +1,680 @@
+// Single-source shortest path engine on a CSR graph
+// Indexed binary-heap Dijkstra, radix heap and bucketed delta-stepping, cross-checked
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define GRID_SIDE 512
+#define RANDOM_VERTICES 131072
+#define RANDOM_DEGREE 8
+#define MAX_WEIGHT 100
+#define DELTA 32
+#define NUM_WORKERS 8
+#define REF_VERTICES 2000
+#define REF_EDGES 10000
+#define DIJKSTRA_V 500
+#define DIJKSTRA_EDGES 4000
+#define INF 0x3fffffff
+
+typedef struct {
+    int src, dest, weight;
+} Edge;
+
+// Compressed sparse row: out-edges of u are targets[offsets[u]..offsets[u+1])
+typedef struct {
+    int num_vertices;
+    int num_edges;
+    int *offsets;
+    int *targets;
+    int *weights;
+} CSRGraph;
+
+CSRGraph* build_csr(int num_vertices, Edge *edges, int num_edges) {
+    CSRGraph *g = (CSRGraph*)malloc(sizeof(CSRGraph));
+    g->num_vertices = num_vertices;
+    g->num_edges = num_edges;
+    g->offsets = (int*)calloc(num_vertices + 1, sizeof(int));
+    g->targets = (int*)malloc(num_edges * sizeof(int));
+    g->weights = (int*)malloc(num_edges * sizeof(int));
+
+    for (int i = 0; i < num_edges; i++) {
+        g->offsets[edges[i].src + 1]++;
+    }
+    for (int v = 0; v < num_vertices; v++) {
+        g->offsets[v + 1] += g->offsets[v];
+    }
+
+    int *fill = (int*)malloc(num_vertices * sizeof(int));
+    memcpy(fill, g->offsets, num_vertices * sizeof(int));
+    for (int i = 0; i < num_edges; i++) {
+        int slot = fill[edges[i].src]++;
+        g->targets[slot] = edges[i].dest;
+        g->weights[slot] = edges[i].weight;
+    }
+    free(fill);
+    return g;
+}
+
+void free_csr(CSRGraph *g) {
+    free(g->offsets);
+    free(g->targets);
+    free(g->weights);
+    free(g);
+}
+
+// ---------------------------------------------------------------------------
+// Strategy 1: binary heap with position index for O(log n) decrease-key
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    int *heap;   // vertex ids ordered by key
+    int *pos;    // pos[v] = index of v in heap, -1 if absent
+    int *key;    // points at the distance array
+    int size;
+} IndexedHeap;
+
+static void iheap_sift_up(IndexedHeap *h, int i) {
+    int v = h->heap[i];
+    int k = h->key[v];
+    while (i > 0) {
+        int parent = (i - 1) >> 1;
+        int pv = h->heap[parent];
+        if (h->key[pv] <= k) break;
+        h->heap[i] = pv;
+        h->pos[pv] = i;
+        i = parent;
+    }
+    h->heap[i] = v;
+    h->pos[v] = i;
+}
+
+static void iheap_sift_down(IndexedHeap *h, int i) {
+    int v = h->heap[i];
+    int k = h->key[v];
+    for (;;) {
+        int child = 2 * i + 1;
+        if (child >= h->size) break;
+        if (child + 1 < h->size && h->key[h->heap[child + 1]] < h->key[h->heap[child]]) {
+            child++;
+        }
+        int cv = h->heap[child];
+        if (h->key[cv] >= k) break;
+        h->heap[i] = cv;
+        h->pos[cv] = i;
+        i = child;
+    }
+    h->heap[i] = v;
+    h->pos[v] = i;
+}
+
+static void iheap_push_or_decrease(IndexedHeap *h, int v) {
+    if (h->pos[v] < 0) {
+        h->heap[h->size] = v;
+        h->pos[v] = h->size;
+        h->size++;
+    }
+    iheap_sift_up(h, h->pos[v]);
+}
+
+static int iheap_pop(IndexedHeap *h) {
+    int top = h->heap[0];
+    h->pos[top] = -1;
+    h->size--;
+    if (h->size > 0) {
+        h->heap[0] = h->heap[h->size];
+        h->pos[h->heap[0]] = 0;
+        iheap_sift_down(h, 0);
+    }
+    return top;
+}
+
+void sssp_binary_heap(CSRGraph *g, int src, int *dist) {
+    int n = g->num_vertices;
+    IndexedHeap h;
+    h.heap = (int*)malloc(n * sizeof(int));
+    h.pos = (int*)malloc(n * sizeof(int));
+    h.key = dist;
+    h.size = 0;
+
+    for (int v = 0; v < n; v++) {
+        dist[v] = INF;
+        h.pos[v] = -1;
+    }
+    dist[src] = 0;
+    iheap_push_or_decrease(&h, src);
+
+    while (h.size > 0) {
+        int u = iheap_pop(&h);
+        int du = dist[u];
+        for (int e = g->offsets[u]; e < g->offsets[u + 1]; e++) {
+            int v = g->targets[e];
+            int nd = du + g->weights[e];
+            if (nd < dist[v]) {
+                dist[v] = nd;
+                iheap_push_or_decrease(&h, v);
+            }
+        }
+    }
+
+    free(h.heap);
+    free(h.pos);
+}
+
+// ---------------------------------------------------------------------------
+// Strategy 2: radix heap for monotone integer keys
+// Bucket b holds keys whose highest differing bit from `last` is b-1.
+// ---------------------------------------------------------------------------
+
+#define RADIX_BUCKETS 33
+
+typedef struct {
+    int vertex;
+    int dist;
+} RadixItem;
+
+typedef struct {
+    RadixItem *items[RADIX_BUCKETS];
+    int count[RADIX_BUCKETS];
+    int capacity[RADIX_BUCKETS];
+    int last;
+    int size;
+} RadixHeap;
+
+static int radix_bucket(int key, int last) {
+    unsigned int diff = (unsigned int)(key ^ last);
+    int b = 0;
+    while (diff) {
+        b++;
+        diff >>= 1;
+    }
+    return b;
+}
+
+static void radix_push(RadixHeap *rh, int vertex, int dist) {
+    int b = radix_bucket(dist, rh->last);
+    if (rh->count[b] == rh->capacity[b]) {
+        rh->capacity[b] = rh->capacity[b] ? rh->capacity[b] * 2 : 64;
+        rh->items[b] = (RadixItem*)realloc(rh->items[b], rh->capacity[b] * sizeof(RadixItem));
+    }
+    rh->items[b][rh->count[b]].vertex = vertex;
+    rh->items[b][rh->count[b]].dist = dist;
+    rh->count[b]++;
+    rh->size++;
+}
+
+static RadixItem radix_pop(RadixHeap *rh) {
+    if (rh->count[0] == 0) {
+        int b = 1;
+        while (rh->count[b] == 0) b++;
+
+        int new_last = rh->items[b][0].dist;
+        for (int i = 1; i < rh->count[b]; i++) {
+            if (rh->items[b][i].dist < new_last) new_last = rh->items[b][i].dist;
+        }
+        rh->last = new_last;
+
+        // Redistribute: every item lands in a strictly lower bucket
+        int moved = rh->count[b];
+        rh->count[b] = 0;
+        rh->size -= moved;
+        for (int i = 0; i < moved; i++) {
+            radix_push(rh, rh->items[b][i].vertex, rh->items[b][i].dist);
+        }
+    }
+    rh->size--;
+    return rh->items[0][--rh->count[0]];
+}
+
+void sssp_radix_heap(CSRGraph *g, int src, int *dist) {
+    int n = g->num_vertices;
+    RadixHeap rh;
+    memset(&rh, 0, sizeof(rh));
+
+    for (int v = 0; v < n; v++) dist[v] = INF;
+    dist[src] = 0;
+    radix_push(&rh, src, 0);
+
+    while (rh.size > 0) {
+        RadixItem it = radix_pop(&rh);
+        int u = it.vertex;
+        if (it.dist != dist[u]) continue;  // stale entry
+        for (int e = g->offsets[u]; e < g->offsets[u + 1]; e++) {
+            int v = g->targets[e];
+            int nd = it.dist + g->weights[e];
+            if (nd < dist[v]) {
+                dist[v] = nd;
+                radix_push(&rh, v, nd);
+            }
+        }
+    }
+
+    for (int b = 0; b < RADIX_BUCKETS; b++) free(rh.items[b]);
+}
+
+// ---------------------------------------------------------------------------
+// Strategy 3: delta-stepping
+// Each phase splits the current bucket into NUM_WORKERS independent chunks
+// that only generate relaxation requests; requests are applied afterwards,
+// so request generation has no shared writes (simulates parallel workers).
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    int *data;
+    int count;
+    int capacity;
+} IntVec;
+
+static void vec_push(IntVec *v, int x) {
+    if (v->count == v->capacity) {
+        v->capacity = v->capacity ? v->capacity * 2 : 64;
+        v->data = (int*)realloc(v->data, v->capacity * sizeof(int));
+    }
+    v->data[v->count++] = x;
+}
+
+typedef struct {
+    IntVec vertex;
+    IntVec dist;
+} RequestList;
+
+static void generate_requests(CSRGraph *g, int *dist, int *frontier, int begin, int end,
+                              int light, RequestList *out) {
+    for (int i = begin; i < end; i++) {
+        int u = frontier[i];
+        int du = dist[u];
+        for (int e = g->offsets[u]; e < g->offsets[u + 1]; e++) {
+            int w = g->weights[e];
+            if ((w <= DELTA) == light) {
+                vec_push(&out->vertex, g->targets[e]);
+                vec_push(&out->dist, du + w);
+            }
+        }
+    }
+}
+
+typedef struct {
+    IntVec *buckets;
+    int num_buckets;
+} BucketArray;
+
+static void bucket_insert(BucketArray *ba, int v, int d) {
+    int b = d / DELTA;
+    if (b >= ba->num_buckets) {
+        int grown = ba->num_buckets * 2;
+        while (grown <= b) grown *= 2;
+        ba->buckets = (IntVec*)realloc(ba->buckets, grown * sizeof(IntVec));
+        memset(ba->buckets + ba->num_buckets, 0, (grown - ba->num_buckets) * sizeof(IntVec));
+        ba->num_buckets = grown;
+    }
+    vec_push(&ba->buckets[b], v);
+}
+
+static void apply_requests(RequestList *reqs, int num_lists, int *dist, BucketArray *ba) {
+    for (int w = 0; w < num_lists; w++) {
+        for (int i = 0; i < reqs[w].vertex.count; i++) {
+            int v = reqs[w].vertex.data[i];
+            int nd = reqs[w].dist.data[i];
+            if (nd < dist[v]) {
+                dist[v] = nd;
+                bucket_insert(ba, v, nd);
+            }
+        }
+        reqs[w].vertex.count = 0;
+        reqs[w].dist.count = 0;
+    }
+}
+
+static void run_workers(CSRGraph *g, int *dist, IntVec *frontier, int light, RequestList *reqs) {
+    int chunk = (frontier->count + NUM_WORKERS - 1) / NUM_WORKERS;
+    for (int w = 0; w < NUM_WORKERS; w++) {
+        int begin = w * chunk;
+        int end = begin + chunk < frontier->count ? begin + chunk : frontier->count;
+        if (begin < end) {
+            generate_requests(g, dist, frontier->data, begin, end, light, &reqs[w]);
+        }
+    }
+}
+
+void sssp_delta_stepping(CSRGraph *g, int src, int *dist) {
+    int n = g->num_vertices;
+    BucketArray ba;
+    ba.num_buckets = 64;
+    ba.buckets = (IntVec*)calloc(ba.num_buckets, sizeof(IntVec));
+    RequestList reqs[NUM_WORKERS];
+    memset(reqs, 0, sizeof(reqs));
+    IntVec frontier = {0};
+    IntVec settled = {0};
+    char *in_settled = (char*)calloc(n, 1);
+
+    for (int v = 0; v < n; v++) dist[v] = INF;
+    dist[src] = 0;
+    bucket_insert(&ba, src, 0);
+
+    for (int cur = 0; cur < ba.num_buckets; cur++) {
+        settled.count = 0;
+        while (ba.buckets[cur].count > 0) {
+            // Drain the bucket, dropping entries that moved to a lower distance
+            IntVec *bucket = &ba.buckets[cur];
+            frontier.count = 0;
+            for (int i = 0; i < bucket->count; i++) {
+                int v = bucket->data[i];
+                if (dist[v] / DELTA != cur) continue;
+                vec_push(&frontier, v);
+                if (!in_settled[v]) {
+                    in_settled[v] = 1;
+                    vec_push(&settled, v);
+                }
+            }
+            bucket->count = 0;
+
+            run_workers(g, dist, &frontier, 1, reqs);
+            apply_requests(reqs, NUM_WORKERS, dist, &ba);
+        }
+
+        if (settled.count > 0) {
+            run_workers(g, dist, &settled, 0, reqs);
+            apply_requests(reqs, NUM_WORKERS, dist, &ba);
+            for (int i = 0; i < settled.count; i++) in_settled[settled.data[i]] = 0;
+        }
+    }
+
+    for (int b = 0; b < ba.num_buckets; b++) free(ba.buckets[b].data);
+    free(ba.buckets);
+    for (int w = 0; w < NUM_WORKERS; w++) {
+        free(reqs[w].vertex.data);
+        free(reqs[w].dist.data);
+    }
+    free(frontier.data);
+    free(settled.data);
+    free(in_settled);
+}
+
+// ---------------------------------------------------------------------------
+// Reference implementations (edge-list Bellman-Ford, as in 23_bellman_ford.c)
+// ---------------------------------------------------------------------------
+
+void bellman_ford_reference(Edge *edges, int num_edges, int num_vertices, int src, int *dist) {
+    for (int i = 0; i < num_vertices; i++) dist[i] = INF;
+    dist[src] = 0;
+
+    for (int i = 1; i <= num_vertices - 1; i++) {
+        int changed = 0;
+        for (int j = 0; j < num_edges; j++) {
+            int u = edges[j].src;
+            int v = edges[j].dest;
+            if (dist[u] != INF && dist[u] + edges[j].weight < dist[v]) {
+                dist[v] = dist[u] + edges[j].weight;
+                changed = 1;
+            }
+        }
+        if (!changed) break;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Reference: 64_dijkstra_shortest_path.c, binary heap over an adjacency
+// matrix (V renamed DIJKSTRA_V, INF renamed DIJKSTRA_INF)
+// ---------------------------------------------------------------------------
+
+#define DIJKSTRA_INF 1000000
+
+typedef struct {
+    int vertex;
+    int dist;
+} HeapNode;
+
+typedef struct {
+    HeapNode *data;
+    int size;
+    int *pos;  // Position of vertex in heap
+} MinHeap;
+
+MinHeap* create_heap(int capacity) {
+    MinHeap *heap = (MinHeap*)malloc(sizeof(MinHeap));
+    heap->data = (HeapNode*)malloc(capacity * sizeof(HeapNode));
+    heap->pos = (int*)malloc(capacity * sizeof(int));
+    heap->size = 0;
+    return heap;
+}
+
+void swap_nodes(HeapNode *a, HeapNode *b) {
+    HeapNode temp = *a;
+    *a = *b;
+    *b = temp;
+}
+
+void heapify(MinHeap *heap, int idx) {
+    int smallest = idx;
+    int left = 2 * idx + 1;
+    int right = 2 * idx + 2;
+
+    if (left < heap->size && heap->data[left].dist < heap->data[smallest].dist)
+        smallest = left;
+
+    if (right < heap->size && heap->data[right].dist < heap->data[smallest].dist)
+        smallest = right;
+
+    if (smallest != idx) {
+        HeapNode *smallest_node = &heap->data[smallest];
+        HeapNode *idx_node = &heap->data[idx];
+
+        heap->pos[smallest_node->vertex] = idx;
+        heap->pos[idx_node->vertex] = smallest;
+
+        swap_nodes(smallest_node, idx_node);
+        heapify(heap, smallest);
+    }
+}
+
+HeapNode extract_min(MinHeap *heap) {
+    HeapNode root = heap->data[0];
+    HeapNode last = heap->data[heap->size - 1];
+    heap->data[0] = last;
+
+    heap->pos[root.vertex] = heap->size - 1;
+    heap->pos[last.vertex] = 0;
+
+    heap->size--;
+    heapify(heap, 0);
+
+    return root;
+}
+
+void decrease_key(MinHeap *heap, int vertex, int dist) {
+    int i = heap->pos[vertex];
+    heap->data[i].dist = dist;
+
+    while (i > 0 && heap->data[i].dist < heap->data[(i - 1) / 2].dist) {
+        heap->pos[heap->data[i].vertex] = (i - 1) / 2;
+        heap->pos[heap->data[(i - 1) / 2].vertex] = i;
+
+        swap_nodes(&heap->data[i], &heap->data[(i - 1) / 2]);
+        i = (i - 1) / 2;
+    }
+}
+
+int is_in_heap(MinHeap *heap, int vertex) {
+    return heap->pos[vertex] < heap->size;
+}
+
+void dijkstra(int graph[DIJKSTRA_V][DIJKSTRA_V], int src, int *dist) {
+    MinHeap *heap = create_heap(DIJKSTRA_V);
+
+    for (int v = 0; v < DIJKSTRA_V; v++) {
+        dist[v] = DIJKSTRA_INF;
+        heap->data[v].vertex = v;
+        heap->data[v].dist = DIJKSTRA_INF;
+        heap->pos[v] = v;
+    }
+
+    dist[src] = 0;
+    decrease_key(heap, src, 0);
+    heap->size = DIJKSTRA_V;
+
+    while (heap->size > 0) {
+        HeapNode min = extract_min(heap);
+        int u = min.vertex;
+
+        for (int v = 0; v < DIJKSTRA_V; v++) {
+            if (graph[u][v] && is_in_heap(heap, v) &&
+                dist[u] != DIJKSTRA_INF && dist[u] + graph[u][v] < dist[v]) {
+                dist[v] = dist[u] + graph[u][v];
+                decrease_key(heap, v, dist[v]);
+            }
+        }
+    }
+
+    free(heap->data);
+    free(heap->pos);
+    free(heap);
+}
+
+// ---------------------------------------------------------------------------
+// Graph generators and harness
+// ---------------------------------------------------------------------------
+
+static unsigned int seed = 42;
+
+static int next_rand() {
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 8) & 0x7fffff;
+}
+
+Edge* generate_random_edges(int num_vertices, int num_edges) {
+    Edge *edges = (Edge*)malloc(num_edges * sizeof(Edge));
+    for (int i = 0; i < num_edges; i++) {
+        // Chain edges keep every vertex reachable from 0
+        if (i < num_vertices - 1) {
+            edges[i].src = i;
+            edges[i].dest = i + 1;
+        } else {
+            edges[i].src = next_rand() % num_vertices;
+            edges[i].dest = next_rand() % num_vertices;
+        }
+        edges[i].weight = 1 + next_rand() % MAX_WEIGHT;
+    }
+    return edges;
+}
+
+Edge* generate_grid_edges(int side, int *num_edges) {
+    int max_edges = 4 * side * side;
+    Edge *edges = (Edge*)malloc(max_edges * sizeof(Edge));
+    int count = 0;
+    for (int r = 0; r < side; r++) {
+        for (int c = 0; c < side; c++) {
+            int u = r * side + c;
+            int nbr[4][2] = {{r - 1, c}, {r + 1, c}, {r, c - 1}, {r, c + 1}};
+            for (int k = 0; k < 4; k++) {
+                int nr = nbr[k][0], nc = nbr[k][1];
+                if (nr < 0 || nr >= side || nc < 0 || nc >= side) continue;
+                edges[count].src = u;
+                edges[count].dest = nr * side + nc;
+                edges[count].weight = 1 + next_rand() % MAX_WEIGHT;
+                count++;
+            }
+        }
+    }
+    *num_edges = count;
+    return edges;
+}
+
+typedef void (*SSSPFunc)(CSRGraph*, int, int*);
+
+static int count_mismatches(int *a, int *b, int n) {
+    int bad = 0;
+    for (int i = 0; i < n; i++) {
+        if (a[i] != b[i]) bad++;
+    }
+    return bad;
+}
+
+static int run_suite(const char *name, CSRGraph *g, int *ref_dist) {
+    const char *names[3] = {"binary-heap", "radix-heap", "delta-step"};
+    SSSPFunc funcs[3] = {sssp_binary_heap, sssp_radix_heap, sssp_delta_stepping};
+    int *dist[3];
+    int mismatches = 0;
+
+    for (int s = 0; s < 3; s++) {
+        dist[s] = (int*)malloc(g->num_vertices * sizeof(int));
+        clock_t start = clock();
+        funcs[s](g, 0, dist[s]);
+        clock_t end = clock();
+        double t = (double)(end - start) / CLOCKS_PER_SEC;
+        printf("  %-6s %-12s V=%d E=%d %.6f seconds\n",
+               name, names[s], g->num_vertices, g->num_edges, t);
+    }
+
+    mismatches += count_mismatches(dist[0], dist[1], g->num_vertices);
+    mismatches += count_mismatches(dist[0], dist[2], g->num_vertices);
+    if (ref_dist) {
+        mismatches += count_mismatches(dist[0], ref_dist, g->num_vertices);
+    }
+
+    long long checksum = 0;
+    for (int v = 0; v < g->num_vertices; v++) {
+        if (dist[0][v] != INF) checksum += dist[0][v];
+    }
+    printf("  %-6s distance checksum=%lld mismatches=%d\n", name, checksum, mismatches);
+
+    for (int s = 0; s < 3; s++) free(dist[s]);
+    return mismatches;
+}
+
+int main() {
+    int total_mismatches = 0;
+    clock_t start = clock();
+
+    // Small graph: all engines against the Bellman-Ford reference
+    Edge *ref_edges = generate_random_edges(REF_VERTICES, REF_EDGES);
+    CSRGraph *ref_graph = build_csr(REF_VERTICES, ref_edges, REF_EDGES);
+    int *ref_dist = (int*)malloc(REF_VERTICES * sizeof(int));
+    bellman_ford_reference(ref_edges, REF_EDGES, REF_VERTICES, 0, ref_dist);
+    total_mismatches += run_suite("ref", ref_graph, ref_dist);
+    free(ref_dist);
+    free_csr(ref_graph);
+    free(ref_edges);
+
+    // Dense-matrix graph: all engines against 64's Dijkstra. Parallel edges
+    // keep their lightest weight in the matrix, as the CSR engines see it.
+    Edge *dij_edges = generate_random_edges(DIJKSTRA_V, DIJKSTRA_EDGES);
+    int (*matrix)[DIJKSTRA_V] = (int (*)[DIJKSTRA_V])calloc(DIJKSTRA_V, sizeof(*matrix));
+    for (int i = 0; i < DIJKSTRA_EDGES; i++) {
+        int *w = &matrix[dij_edges[i].src][dij_edges[i].dest];
+        if (dij_edges[i].src != dij_edges[i].dest && (*w == 0 || dij_edges[i].weight < *w)) {
+            *w = dij_edges[i].weight;
+        }
+    }
+    CSRGraph *dij_graph = build_csr(DIJKSTRA_V, dij_edges, DIJKSTRA_EDGES);
+    int *dij_dist = (int*)malloc(DIJKSTRA_V * sizeof(int));
+    dijkstra(matrix, 0, dij_dist);
+    total_mismatches += run_suite("matrix", dij_graph, dij_dist);
+    free(dij_dist);
+    free_csr(dij_graph);
+    free(matrix);
+    free(dij_edges);
+
+    // Large random graph
+    int random_edges = RANDOM_VERTICES * RANDOM_DEGREE;
+    Edge *edges = generate_random_edges(RANDOM_VERTICES, random_edges);
+    CSRGraph *random_graph = build_csr(RANDOM_VERTICES, edges, random_edges);
+    free(edges);
+    total_mismatches += run_suite("random", random_graph, NULL);
+    free_csr(random_graph);
+
+    // Large grid graph
+    int grid_edges;
+    edges = generate_grid_edges(GRID_SIDE, &grid_edges);
+    CSRGraph *grid_graph = build_csr(GRID_SIDE * GRID_SIDE, edges, grid_edges);
+    free(edges);
+    total_mismatches += run_suite("grid", grid_graph, NULL);
+    free_csr(grid_graph);
+
+    clock_t end = clock();
+    double time_spent = (double)(end - start) / CLOCKS_PER_SEC;
+
+    printf("SSSP engine: 3 strategies on 4 graphs, %.6f seconds\n", time_spent);
+    printf("Total mismatches: %d\n", total_mismatches);
+
+    return 0;
+}
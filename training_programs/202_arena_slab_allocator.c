@@ -0,0 +1,994 @@
+// Arena + fixed-size slab allocator with bulk reset
+// Ports AVL, red-black, skip list, treap, B-tree, splay and chained hash to pooled nodes
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define ARENA_CHUNK_SIZE (1 << 20)
+#define ARENA_ALIGN 8
+#define MAX_POOLS 16
+#define MALLOC_OVERHEAD 16  // per-allocation header charged to the malloc baseline
+#define MAX_LEVEL 16
+#define BTREE_T 3
+#define HASH_BUCKETS_PER_KEY 1
+
+#ifdef FULL_SIZE
+static const int key_counts[] = {10000, 100000, 1000000, 10000000};
+#else
+static const int key_counts[] = {10000, 50000};  // -DFULL_SIZE for the full 10^4..10^7 sweep
+#endif
+#define NUM_SIZES (int)(sizeof(key_counts) / sizeof(key_counts[0]))
+
+// ---------------------------------------------------------------------------
+// Arena: bump allocation out of large chunks; reset rewinds without freeing
+// ---------------------------------------------------------------------------
+
+typedef struct ArenaChunk {
+    struct ArenaChunk *next;
+    size_t size;
+    size_t used;
+    char data[];
+} ArenaChunk;
+
+typedef struct {
+    ArenaChunk *head;
+    ArenaChunk *current;
+    size_t reserved;
+} Arena;
+
+void arena_init(Arena *a) {
+    a->head = NULL;
+    a->current = NULL;
+    a->reserved = 0;
+}
+
+static ArenaChunk* arena_new_chunk(Arena *a, size_t min_size) {
+    size_t size = min_size > ARENA_CHUNK_SIZE ? min_size : ARENA_CHUNK_SIZE;
+    ArenaChunk *chunk = (ArenaChunk*)malloc(sizeof(ArenaChunk) + size);
+    chunk->size = size;
+    chunk->used = 0;
+    chunk->next = NULL;
+    a->reserved += sizeof(ArenaChunk) + size;
+    return chunk;
+}
+
+void* arena_alloc(Arena *a, size_t size) {
+    size = (size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+
+    while (!a->current || a->current->used + size > a->current->size) {
+        if (a->current && a->current->next) {
+            // Reuse chunks retained by an earlier reset
+            a->current = a->current->next;
+            a->current->used = 0;
+            continue;
+        }
+        ArenaChunk *chunk = arena_new_chunk(a, size);
+        if (a->current) {
+            a->current->next = chunk;
+        } else {
+            a->head = chunk;
+        }
+        a->current = chunk;
+    }
+
+    void *p = a->current->data + a->current->used;
+    a->current->used += size;
+    return p;
+}
+
+void arena_reset(Arena *a) {
+    a->current = a->head;
+    if (a->current) a->current->used = 0;
+}
+
+void arena_destroy(Arena *a) {
+    ArenaChunk *chunk = a->head;
+    while (chunk) {
+        ArenaChunk *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    arena_init(a);
+}
+
+// ---------------------------------------------------------------------------
+// Slab pool: fixed-size slots carved from an arena, recycled via a free list
+// ---------------------------------------------------------------------------
+
+typedef struct FreeSlot {
+    struct FreeSlot *next;
+} FreeSlot;
+
+typedef struct {
+    Arena *arena;
+    size_t slot_size;
+    FreeSlot *free_list;
+} Pool;
+
+void pool_init(Pool *p, Arena *arena, size_t slot_size) {
+    p->arena = arena;
+    p->slot_size = slot_size < sizeof(FreeSlot) ? sizeof(FreeSlot) : slot_size;
+    p->free_list = NULL;
+}
+
+void* pool_alloc(Pool *p) {
+    if (p->free_list) {
+        FreeSlot *slot = p->free_list;
+        p->free_list = slot->next;
+        return slot;
+    }
+    return arena_alloc(p->arena, p->slot_size);
+}
+
+void pool_free(Pool *p, void *ptr) {
+    FreeSlot *slot = (FreeSlot*)ptr;
+    slot->next = p->free_list;
+    p->free_list = slot;
+}
+
+void pool_reset(Pool *p) {
+    p->free_list = NULL;
+}
+
+// ---------------------------------------------------------------------------
+// Node allocator: one entry point, malloc or slab backend.
+// Size classes map to pools (skip list uses one class per tower height).
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    int use_malloc;
+    Arena arena;
+    Pool pools[MAX_POOLS];
+    int num_pools;
+    long long live_bytes;
+    long long peak_bytes;
+} NodeAlloc;
+
+void node_alloc_init(NodeAlloc *na, int use_malloc) {
+    na->use_malloc = use_malloc;
+    na->num_pools = 0;
+    na->live_bytes = 0;
+    na->peak_bytes = 0;
+    arena_init(&na->arena);
+}
+
+void node_alloc_set_class(NodeAlloc *na, int cls, size_t size) {
+    pool_init(&na->pools[cls], &na->arena, size);
+    if (cls >= na->num_pools) na->num_pools = cls + 1;
+}
+
+void* node_alloc(NodeAlloc *na, int cls) {
+    if (na->use_malloc) {
+        size_t size = na->pools[cls].slot_size;
+        na->live_bytes += size + MALLOC_OVERHEAD;
+        if (na->live_bytes > na->peak_bytes) na->peak_bytes = na->live_bytes;
+        return malloc(size);
+    }
+    void *p = pool_alloc(&na->pools[cls]);
+    if ((long long)na->arena.reserved > na->peak_bytes) na->peak_bytes = na->arena.reserved;
+    return p;
+}
+
+void node_free(NodeAlloc *na, int cls, void *ptr) {
+    if (na->use_malloc) {
+        na->live_bytes -= na->pools[cls].slot_size + MALLOC_OVERHEAD;
+        free(ptr);
+    } else {
+        pool_free(&na->pools[cls], ptr);
+    }
+}
+
+// Bulk release: the slab backend rewinds the arena in O(chunks)
+void node_alloc_reset(NodeAlloc *na) {
+    for (int i = 0; i < na->num_pools; i++) pool_reset(&na->pools[i]);
+    arena_reset(&na->arena);
+}
+
+void node_alloc_destroy(NodeAlloc *na) {
+    arena_destroy(&na->arena);
+}
+
+// ---------------------------------------------------------------------------
+// AVL tree (17_avl_tree.c) with key, height and children in one node
+// ---------------------------------------------------------------------------
+
+typedef struct AvlNode {
+    int key;
+    int height;
+    struct AvlNode *child[2];
+} AvlNode;
+
+static int avl_height(AvlNode *n) {
+    return n ? n->height : 0;
+}
+
+static void avl_update(AvlNode *n) {
+    int hl = avl_height(n->child[0]);
+    int hr = avl_height(n->child[1]);
+    n->height = 1 + (hl > hr ? hl : hr);
+}
+
+// dir = 0 rotates left (right child rises), dir = 1 rotates right
+static AvlNode* avl_rotate(AvlNode *n, int dir) {
+    AvlNode *up = n->child[!dir];
+    n->child[!dir] = up->child[dir];
+    up->child[dir] = n;
+    avl_update(n);
+    avl_update(up);
+    return up;
+}
+
+static AvlNode* avl_rebalance(AvlNode *n) {
+    avl_update(n);
+    int balance = avl_height(n->child[0]) - avl_height(n->child[1]);
+    if (balance > 1) {
+        if (avl_height(n->child[0]->child[0]) < avl_height(n->child[0]->child[1])) {
+            n->child[0] = avl_rotate(n->child[0], 0);
+        }
+        return avl_rotate(n, 1);
+    }
+    if (balance < -1) {
+        if (avl_height(n->child[1]->child[1]) < avl_height(n->child[1]->child[0])) {
+            n->child[1] = avl_rotate(n->child[1], 1);
+        }
+        return avl_rotate(n, 0);
+    }
+    return n;
+}
+
+AvlNode* avl_insert(AvlNode *n, NodeAlloc *na, int key) {
+    if (!n) {
+        AvlNode *node = (AvlNode*)node_alloc(na, 0);
+        node->key = key;
+        node->height = 1;
+        node->child[0] = node->child[1] = NULL;
+        return node;
+    }
+    if (key == n->key) return n;
+    int dir = key > n->key;
+    n->child[dir] = avl_insert(n->child[dir], na, key);
+    return avl_rebalance(n);
+}
+
+AvlNode* avl_delete(AvlNode *n, NodeAlloc *na, int key) {
+    if (!n) return NULL;
+    if (key != n->key) {
+        int dir = key > n->key;
+        n->child[dir] = avl_delete(n->child[dir], na, key);
+        return avl_rebalance(n);
+    }
+    if (!n->child[0] || !n->child[1]) {
+        AvlNode *rest = n->child[0] ? n->child[0] : n->child[1];
+        node_free(na, 0, n);
+        return rest;
+    }
+    AvlNode *succ = n->child[1];
+    while (succ->child[0]) succ = succ->child[0];
+    n->key = succ->key;
+    n->child[1] = avl_delete(n->child[1], na, succ->key);
+    return avl_rebalance(n);
+}
+
+int avl_search(AvlNode *n, int key) {
+    while (n) {
+        if (key == n->key) return 1;
+        n = n->child[key > n->key];
+    }
+    return 0;
+}
+
+void avl_free(AvlNode *n, NodeAlloc *na) {
+    if (!n) return;
+    avl_free(n->child[0], na);
+    avl_free(n->child[1], na);
+    node_free(na, 0, n);
+}
+
+// ---------------------------------------------------------------------------
+// Red-black tree (18_red_black_tree.c) with parent pointer and fixup
+// ---------------------------------------------------------------------------
+
+typedef struct RbNode {
+    int key;
+    int red;
+    struct RbNode *child[2];
+    struct RbNode *parent;
+} RbNode;
+
+static void rb_rotate(RbNode **root, RbNode *x, int dir) {
+    RbNode *y = x->child[!dir];
+    x->child[!dir] = y->child[dir];
+    if (y->child[dir]) y->child[dir]->parent = x;
+    y->parent = x->parent;
+    if (!x->parent) {
+        *root = y;
+    } else {
+        x->parent->child[x == x->parent->child[1]] = y;
+    }
+    y->child[dir] = x;
+    x->parent = y;
+}
+
+void rb_insert(RbNode **root, NodeAlloc *na, int key) {
+    RbNode *parent = NULL;
+    RbNode *cur = *root;
+    while (cur) {
+        if (key == cur->key) return;
+        parent = cur;
+        cur = cur->child[key > cur->key];
+    }
+
+    RbNode *z = (RbNode*)node_alloc(na, 0);
+    z->key = key;
+    z->red = 1;
+    z->child[0] = z->child[1] = NULL;
+    z->parent = parent;
+    if (!parent) {
+        *root = z;
+    } else {
+        parent->child[key > parent->key] = z;
+    }
+
+    while (z->parent && z->parent->red) {
+        RbNode *p = z->parent;
+        RbNode *g = p->parent;
+        int side = (p == g->child[1]);
+        RbNode *uncle = g->child[!side];
+        if (uncle && uncle->red) {
+            p->red = 0;
+            uncle->red = 0;
+            g->red = 1;
+            z = g;
+        } else {
+            if (z == p->child[!side]) {
+                z = p;
+                rb_rotate(root, z, side);
+                p = z->parent;
+            }
+            p->red = 0;
+            g->red = 1;
+            rb_rotate(root, g, !side);
+        }
+    }
+    (*root)->red = 0;
+}
+
+int rb_search(RbNode *n, int key) {
+    while (n) {
+        if (key == n->key) return 1;
+        n = n->child[key > n->key];
+    }
+    return 0;
+}
+
+void rb_free(RbNode *n, NodeAlloc *na) {
+    if (!n) return;
+    rb_free(n->child[0], na);
+    rb_free(n->child[1], na);
+    node_free(na, 0, n);
+}
+
+// ---------------------------------------------------------------------------
+// Skip list (84_skip_list.c): forward pointers live inside the node
+// ---------------------------------------------------------------------------
+
+typedef struct SkipNode {
+    int key;
+    int level;
+    struct SkipNode *forward[];
+} SkipNode;
+
+typedef struct {
+    int level;
+    unsigned int seed;
+    SkipNode *header;
+} SkipList;
+
+static int skip_random_level(SkipList *list) {
+    int level = 1;
+    list->seed = list->seed * 1103515245 + 12345;
+    unsigned int bits = list->seed >> 8;
+    while ((bits & 1) && level < MAX_LEVEL) {
+        level++;
+        bits >>= 1;
+    }
+    return level;
+}
+
+static void skip_init_classes(NodeAlloc *na) {
+    for (int lvl = 1; lvl <= MAX_LEVEL; lvl++) {
+        node_alloc_set_class(na, lvl - 1, sizeof(SkipNode) + lvl * sizeof(SkipNode*));
+    }
+}
+
+void skip_init(SkipList *list, NodeAlloc *na) {
+    list->level = 1;
+    list->seed = 42;
+    list->header = (SkipNode*)node_alloc(na, MAX_LEVEL - 1);
+    list->header->key = -1;
+    list->header->level = MAX_LEVEL;
+    for (int i = 0; i < MAX_LEVEL; i++) list->header->forward[i] = NULL;
+}
+
+void skip_insert(SkipList *list, NodeAlloc *na, int key) {
+    SkipNode *update[MAX_LEVEL];
+    SkipNode *x = list->header;
+    for (int i = list->level - 1; i >= 0; i--) {
+        while (x->forward[i] && x->forward[i]->key < key) x = x->forward[i];
+        update[i] = x;
+    }
+    x = x->forward[0];
+    if (x && x->key == key) return;
+
+    int level = skip_random_level(list);
+    if (level > list->level) {
+        for (int i = list->level; i < level; i++) update[i] = list->header;
+        list->level = level;
+    }
+    SkipNode *node = (SkipNode*)node_alloc(na, level - 1);
+    node->key = key;
+    node->level = level;
+    for (int i = 0; i < level; i++) {
+        node->forward[i] = update[i]->forward[i];
+        update[i]->forward[i] = node;
+    }
+}
+
+int skip_search(SkipList *list, int key) {
+    SkipNode *x = list->header;
+    for (int i = list->level - 1; i >= 0; i--) {
+        while (x->forward[i] && x->forward[i]->key < key) x = x->forward[i];
+    }
+    x = x->forward[0];
+    return x && x->key == key;
+}
+
+void skip_delete(SkipList *list, NodeAlloc *na, int key) {
+    SkipNode *update[MAX_LEVEL];
+    SkipNode *x = list->header;
+    for (int i = list->level - 1; i >= 0; i--) {
+        while (x->forward[i] && x->forward[i]->key < key) x = x->forward[i];
+        update[i] = x;
+    }
+    x = x->forward[0];
+    if (!x || x->key != key) return;
+
+    for (int i = 0; i < x->level; i++) {
+        if (update[i]->forward[i] == x) update[i]->forward[i] = x->forward[i];
+    }
+    node_free(na, x->level - 1, x);
+    while (list->level > 1 && !list->header->forward[list->level - 1]) list->level--;
+}
+
+void skip_free(SkipList *list, NodeAlloc *na) {
+    SkipNode *x = list->header;
+    while (x) {
+        SkipNode *next = x->forward[0];
+        node_free(na, x->level - 1, x);
+        x = next;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Treap (125_treap.c)
+// ---------------------------------------------------------------------------
+
+typedef struct TreapNode {
+    int key;
+    unsigned int priority;
+    struct TreapNode *child[2];
+} TreapNode;
+
+// Priorities hash the key (murmur3's finalizer) rather than drawing from an
+// LCG: the keys come from the same LCG, so a second stream with the same seed
+// would make priority grow with key and degrade the treap into a chain. A
+// hash also gives the malloc and slab runs the same tree shape.
+static unsigned int treap_priority(int key) {
+    unsigned int h = (unsigned int)key;
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+    return h;
+}
+
+static TreapNode* treap_rotate(TreapNode *n, int dir) {
+    TreapNode *up = n->child[!dir];
+    n->child[!dir] = up->child[dir];
+    up->child[dir] = n;
+    return up;
+}
+
+TreapNode* treap_insert(TreapNode *n, NodeAlloc *na, int key) {
+    if (!n) {
+        TreapNode *node = (TreapNode*)node_alloc(na, 0);
+        node->key = key;
+        node->priority = treap_priority(key);
+        node->child[0] = node->child[1] = NULL;
+        return node;
+    }
+    if (key == n->key) return n;
+    int dir = key > n->key;
+    n->child[dir] = treap_insert(n->child[dir], na, key);
+    if (n->child[dir]->priority > n->priority) {
+        n = treap_rotate(n, !dir);
+    }
+    return n;
+}
+
+TreapNode* treap_delete(TreapNode *n, NodeAlloc *na, int key) {
+    if (!n) return NULL;
+    if (key != n->key) {
+        int dir = key > n->key;
+        n->child[dir] = treap_delete(n->child[dir], na, key);
+        return n;
+    }
+    if (!n->child[0] || !n->child[1]) {
+        TreapNode *rest = n->child[0] ? n->child[0] : n->child[1];
+        node_free(na, 0, n);
+        return rest;
+    }
+    // Rotate the higher-priority child up, then continue on the other side
+    int up = n->child[1]->priority > n->child[0]->priority;
+    n = treap_rotate(n, !up);
+    n->child[!up] = treap_delete(n->child[!up], na, key);
+    return n;
+}
+
+int treap_search(TreapNode *n, int key) {
+    while (n) {
+        if (key == n->key) return 1;
+        n = n->child[key > n->key];
+    }
+    return 0;
+}
+
+void treap_free(TreapNode *n, NodeAlloc *na) {
+    if (!n) return;
+    treap_free(n->child[0], na);
+    treap_free(n->child[1], na);
+    node_free(na, 0, n);
+}
+
+// ---------------------------------------------------------------------------
+// B-tree (130_b_tree.c): keys and children inline instead of three mallocs
+// ---------------------------------------------------------------------------
+
+typedef struct BNode {
+    int num_keys;
+    int is_leaf;
+    int keys[2 * BTREE_T - 1];
+    struct BNode *children[2 * BTREE_T];
+} BNode;
+
+static BNode* bnode_create(NodeAlloc *na, int is_leaf) {
+    BNode *node = (BNode*)node_alloc(na, 0);
+    node->num_keys = 0;
+    node->is_leaf = is_leaf;
+    return node;
+}
+
+static void btree_split_child(NodeAlloc *na, BNode *parent, int index) {
+    BNode *full = parent->children[index];
+    BNode *right = bnode_create(na, full->is_leaf);
+    right->num_keys = BTREE_T - 1;
+    for (int i = 0; i < BTREE_T - 1; i++) right->keys[i] = full->keys[i + BTREE_T];
+    if (!full->is_leaf) {
+        for (int i = 0; i < BTREE_T; i++) right->children[i] = full->children[i + BTREE_T];
+    }
+    full->num_keys = BTREE_T - 1;
+
+    for (int i = parent->num_keys; i > index; i--) parent->children[i + 1] = parent->children[i];
+    parent->children[index + 1] = right;
+    for (int i = parent->num_keys - 1; i >= index; i--) parent->keys[i + 1] = parent->keys[i];
+    parent->keys[index] = full->keys[BTREE_T - 1];
+    parent->num_keys++;
+}
+
+static void btree_insert_non_full(NodeAlloc *na, BNode *node, int key) {
+    int i = node->num_keys - 1;
+    if (node->is_leaf) {
+        while (i >= 0 && key < node->keys[i]) {
+            node->keys[i + 1] = node->keys[i];
+            i--;
+        }
+        node->keys[i + 1] = key;
+        node->num_keys++;
+        return;
+    }
+    while (i >= 0 && key < node->keys[i]) i--;
+    i++;
+    if (node->children[i]->num_keys == 2 * BTREE_T - 1) {
+        btree_split_child(na, node, i);
+        if (key > node->keys[i]) i++;
+    }
+    btree_insert_non_full(na, node->children[i], key);
+}
+
+int btree_search(BNode *node, int key) {
+    while (node) {
+        int i = 0;
+        while (i < node->num_keys && key > node->keys[i]) i++;
+        if (i < node->num_keys && key == node->keys[i]) return 1;
+        node = node->is_leaf ? NULL : node->children[i];
+    }
+    return 0;
+}
+
+void btree_insert(BNode **root, NodeAlloc *na, int key) {
+    if (!*root) *root = bnode_create(na, 1);
+    if (btree_search(*root, key)) return;
+    if ((*root)->num_keys == 2 * BTREE_T - 1) {
+        BNode *new_root = bnode_create(na, 0);
+        new_root->children[0] = *root;
+        btree_split_child(na, new_root, 0);
+        *root = new_root;
+    }
+    btree_insert_non_full(na, *root, key);
+}
+
+void btree_free(BNode *node, NodeAlloc *na) {
+    if (!node) return;
+    if (!node->is_leaf) {
+        for (int i = 0; i <= node->num_keys; i++) btree_free(node->children[i], na);
+    }
+    node_free(na, 0, node);
+}
+
+// ---------------------------------------------------------------------------
+// Splay tree (141_splay_tree.c), top-down splaying
+// ---------------------------------------------------------------------------
+
+typedef struct SplayNode {
+    int key;
+    struct SplayNode *child[2];
+} SplayNode;
+
+static SplayNode* splay(SplayNode *t, int key) {
+    if (!t) return NULL;
+    SplayNode header;
+    header.child[0] = header.child[1] = NULL;
+    SplayNode *left_max = &header;
+    SplayNode *right_min = &header;
+
+    for (;;) {
+        if (key == t->key) break;
+        int dir = key > t->key;
+        if (!t->child[dir]) break;
+        if ((key > t->child[dir]->key) == dir && key != t->child[dir]->key) {
+            // zig-zig: rotate before linking
+            SplayNode *c = t->child[dir];
+            t->child[dir] = c->child[!dir];
+            c->child[!dir] = t;
+            t = c;
+            if (!t->child[dir]) break;
+        }
+        if (dir) {
+            left_max->child[1] = t;
+            left_max = t;
+        } else {
+            right_min->child[0] = t;
+            right_min = t;
+        }
+        t = t->child[dir];
+    }
+    left_max->child[1] = t->child[0];
+    right_min->child[0] = t->child[1];
+    t->child[0] = header.child[1];
+    t->child[1] = header.child[0];
+    return t;
+}
+
+SplayNode* splay_insert(SplayNode *t, NodeAlloc *na, int key) {
+    t = splay(t, key);
+    if (t && t->key == key) return t;
+    SplayNode *node = (SplayNode*)node_alloc(na, 0);
+    node->key = key;
+    if (!t) {
+        node->child[0] = node->child[1] = NULL;
+    } else {
+        int dir = key > t->key;
+        node->child[!dir] = t;
+        node->child[dir] = t->child[dir];
+        t->child[dir] = NULL;
+    }
+    return node;
+}
+
+SplayNode* splay_delete(SplayNode *t, NodeAlloc *na, int key) {
+    t = splay(t, key);
+    if (!t || t->key != key) return t;
+    SplayNode *rest;
+    if (!t->child[0]) {
+        rest = t->child[1];
+    } else {
+        rest = splay(t->child[0], key);
+        rest->child[1] = t->child[1];
+    }
+    node_free(na, 0, t);
+    return rest;
+}
+
+void splay_free(SplayNode *n, NodeAlloc *na) {
+    while (n) {
+        // Flatten left spine iteratively; splay trees can be deep
+        if (n->child[0]) {
+            SplayNode *l = n->child[0];
+            n->child[0] = l->child[1];
+            l->child[1] = n;
+            n = l;
+        } else {
+            SplayNode *next = n->child[1];
+            node_free(na, 0, n);
+            n = next;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Chained hash table (91_hash_table.c) with pooled entries
+// ---------------------------------------------------------------------------
+
+typedef struct Entry {
+    int key;
+    int value;
+    struct Entry *next;
+} Entry;
+
+typedef struct {
+    Entry **buckets;
+    int size;
+} HashTable;
+
+static unsigned int hash_int(int key) {
+    unsigned int h = (unsigned int)key * 2654435761u;
+    return h ^ (h >> 16);
+}
+
+void hash_init(HashTable *ht, int size) {
+    ht->size = size;
+    ht->buckets = (Entry**)calloc(size, sizeof(Entry*));
+}
+
+void hash_insert(HashTable *ht, NodeAlloc *na, int key, int value) {
+    unsigned int idx = hash_int(key) % ht->size;
+    for (Entry *e = ht->buckets[idx]; e; e = e->next) {
+        if (e->key == key) {
+            e->value = value;
+            return;
+        }
+    }
+    Entry *e = (Entry*)node_alloc(na, 0);
+    e->key = key;
+    e->value = value;
+    e->next = ht->buckets[idx];
+    ht->buckets[idx] = e;
+}
+
+int hash_search(HashTable *ht, int key) {
+    for (Entry *e = ht->buckets[hash_int(key) % ht->size]; e; e = e->next) {
+        if (e->key == key) return 1;
+    }
+    return 0;
+}
+
+void hash_delete(HashTable *ht, NodeAlloc *na, int key) {
+    Entry **link = &ht->buckets[hash_int(key) % ht->size];
+    while (*link) {
+        if ((*link)->key == key) {
+            Entry *dead = *link;
+            *link = dead->next;
+            node_free(na, 0, dead);
+            return;
+        }
+        link = &(*link)->next;
+    }
+}
+
+void hash_free(HashTable *ht, NodeAlloc *na) {
+    for (int i = 0; i < ht->size; i++) {
+        Entry *e = ht->buckets[i];
+        while (e) {
+            Entry *next = e->next;
+            node_free(na, 0, e);
+            e = next;
+        }
+    }
+    free(ht->buckets);
+}
+
+// ---------------------------------------------------------------------------
+// Benchmark driver
+// ---------------------------------------------------------------------------
+
+enum { S_AVL, S_RB, S_SKIP, S_TREAP, S_BTREE, S_SPLAY, S_HASH, NUM_STRUCTURES };
+
+static const char *structure_names[NUM_STRUCTURES] = {
+    "avl", "red-black", "skip-list", "treap", "b-tree", "splay", "hash"
+};
+
+typedef struct {
+    double insert_time;
+    double search_time;
+    double delete_time;
+    double teardown_time;
+    long long peak_bytes;
+    int found;
+} BenchResult;
+
+typedef struct {
+    AvlNode *avl;
+    RbNode *rb;
+    SkipList skip;
+    TreapNode *treap;
+    BNode *btree;
+    SplayNode *splay;
+    HashTable hash;
+} Structures;
+
+static void setup_classes(NodeAlloc *na, int s) {
+    switch (s) {
+        case S_AVL:   node_alloc_set_class(na, 0, sizeof(AvlNode)); break;
+        case S_RB:    node_alloc_set_class(na, 0, sizeof(RbNode)); break;
+        case S_SKIP:  skip_init_classes(na); break;
+        case S_TREAP: node_alloc_set_class(na, 0, sizeof(TreapNode)); break;
+        case S_BTREE: node_alloc_set_class(na, 0, sizeof(BNode)); break;
+        case S_SPLAY: node_alloc_set_class(na, 0, sizeof(SplayNode)); break;
+        case S_HASH:  node_alloc_set_class(na, 0, sizeof(Entry)); break;
+    }
+}
+
+static void do_insert(Structures *st, NodeAlloc *na, int s, int key) {
+    switch (s) {
+        case S_AVL:   st->avl = avl_insert(st->avl, na, key); break;
+        case S_RB:    rb_insert(&st->rb, na, key); break;
+        case S_SKIP:  skip_insert(&st->skip, na, key); break;
+        case S_TREAP: st->treap = treap_insert(st->treap, na, key); break;
+        case S_BTREE: btree_insert(&st->btree, na, key); break;
+        case S_SPLAY: st->splay = splay_insert(st->splay, na, key); break;
+        case S_HASH:  hash_insert(&st->hash, na, key, key); break;
+    }
+}
+
+static int do_search(Structures *st, int s, int key) {
+    switch (s) {
+        case S_AVL:   return avl_search(st->avl, key);
+        case S_RB:    return rb_search(st->rb, key);
+        case S_SKIP:  return skip_search(&st->skip, key);
+        case S_TREAP: return treap_search(st->treap, key);
+        case S_BTREE: return btree_search(st->btree, key);
+        case S_SPLAY:
+            st->splay = splay(st->splay, key);
+            return st->splay && st->splay->key == key;
+        case S_HASH:  return hash_search(&st->hash, key);
+    }
+    return 0;
+}
+
+// Returns 0 when the structure has no single-key delete (red-black, B-tree)
+static int do_delete(Structures *st, NodeAlloc *na, int s, int key) {
+    switch (s) {
+        case S_AVL:   st->avl = avl_delete(st->avl, na, key); return 1;
+        case S_SKIP:  skip_delete(&st->skip, na, key); return 1;
+        case S_TREAP: st->treap = treap_delete(st->treap, na, key); return 1;
+        case S_SPLAY: st->splay = splay_delete(st->splay, na, key); return 1;
+        case S_HASH:  hash_delete(&st->hash, na, key); return 1;
+    }
+    return 0;
+}
+
+static void do_teardown(Structures *st, NodeAlloc *na, int s) {
+    if (!na->use_malloc) {
+        // Slab backend: whole structure released by one reset
+        if (s == S_HASH) free(st->hash.buckets);
+        node_alloc_reset(na);
+        return;
+    }
+    switch (s) {
+        case S_AVL:   avl_free(st->avl, na); break;
+        case S_RB:    rb_free(st->rb, na); break;
+        case S_SKIP:  skip_free(&st->skip, na); break;
+        case S_TREAP: treap_free(st->treap, na); break;
+        case S_BTREE: btree_free(st->btree, na); break;
+        case S_SPLAY: splay_free(st->splay, na); break;
+        case S_HASH:  hash_free(&st->hash, na); break;
+    }
+}
+
+static double elapsed(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+// Formats a phase time, or "-" for a phase the structure does not support
+static const char *format_time(char *buf, size_t size, double t) {
+    if (t < 0) return "-";
+    snprintf(buf, size, "%.4f", t);
+    return buf;
+}
+
+BenchResult run_benchmark(int s, int use_malloc, int *keys, int n) {
+    BenchResult r;
+    NodeAlloc na;
+    Structures st;
+    memset(&st, 0, sizeof(st));
+    node_alloc_init(&na, use_malloc);
+    setup_classes(&na, s);
+    if (s == S_SKIP) skip_init(&st.skip, &na);
+    if (s == S_HASH) hash_init(&st.hash, n * HASH_BUCKETS_PER_KEY);
+
+    clock_t start = clock();
+    for (int i = 0; i < n; i++) do_insert(&st, &na, s, keys[i]);
+    r.insert_time = elapsed(start);
+
+    // Half the probes hit (odd keys were inserted), half miss
+    start = clock();
+    r.found = 0;
+    for (int i = 0; i < n; i++) {
+        r.found += do_search(&st, s, keys[i] ^ (i & 1));
+    }
+    r.search_time = elapsed(start);
+
+    start = clock();
+    r.delete_time = -1.0;
+    int supports_delete = 1;
+    for (int i = 0; i < n / 2 && supports_delete; i++) {
+        supports_delete = do_delete(&st, &na, s, keys[i]);
+    }
+    if (supports_delete) r.delete_time = elapsed(start);
+
+    r.peak_bytes = na.peak_bytes;
+
+    start = clock();
+    do_teardown(&st, &na, s);
+    r.teardown_time = elapsed(start);
+
+    node_alloc_destroy(&na);
+    return r;
+}
+
+int main() {
+    int max_keys = key_counts[NUM_SIZES - 1];
+    int *keys = (int*)malloc(max_keys * sizeof(int));
+    unsigned int seed = 42;
+
+    clock_t start = clock();
+    long long total_found = 0;
+
+    for (int si = 0; si < NUM_SIZES; si++) {
+        int n = key_counts[si];
+        for (int i = 0; i < n; i++) {
+            seed = seed * 1103515245 + 12345;
+            keys[i] = (int)((seed >> 4) & 0x3ffffffe) | 1;  // odd keys only
+        }
+
+        for (int s = 0; s < NUM_STRUCTURES; s++) {
+            BenchResult base = run_benchmark(s, 1, keys, n);
+            BenchResult slab = run_benchmark(s, 0, keys, n);
+            total_found += base.found + slab.found;
+            if (base.found != slab.found) {
+                printf("  MISMATCH %s n=%d: malloc found %d, slab found %d\n",
+                       structure_names[s], n, base.found, slab.found);
+            }
+            char base_delete[32], slab_delete[32];
+            printf("  n=%-8d %-10s insert %.4f/%.4f  search %.4f/%.4f  "
+                   "delete %s/%s  teardown %.4f/%.4f  peak KB %lld/%lld\n",
+                   n, structure_names[s],
+                   base.insert_time, slab.insert_time,
+                   base.search_time, slab.search_time,
+                   format_time(base_delete, sizeof(base_delete), base.delete_time),
+                   format_time(slab_delete, sizeof(slab_delete), slab.delete_time),
+                   base.teardown_time, slab.teardown_time,
+                   base.peak_bytes / 1024, slab.peak_bytes / 1024);
+        }
+    }
+
+    double time_spent = elapsed(start);
+    printf("Arena/slab allocator: %d structures x %d sizes (malloc/slab), %.6f seconds\n",
+           NUM_STRUCTURES, NUM_SIZES, time_spent);
+    printf("Total keys found: %lld\n", total_found);
+
+    free(keys);
+    return 0;
+}
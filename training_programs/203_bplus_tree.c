@@ -0,0 +1,589 @@
+// Cache-conscious B+-tree with branchless intra-node search
+// Linked leaves for range scans, bulk load, range delete; compared to the classic B-tree
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+
+#define NODE_KEYS 16          // 16 x int = one 64-byte line of keys
+#define LEAF_FILL 14          // bulk load leaves some slack for inserts
+#define CACHE_LINE 64
+#ifdef FULL_SIZE
+#define NUM_KEYS (1 << 20)
+#define NUM_LOOKUPS 250000
+#define NUM_MIXED 200000
+#define KEY_SPACE (1 << 26)
+#else
+#define NUM_KEYS (1 << 17)    // -DFULL_SIZE for 1M keys
+#define NUM_LOOKUPS 32000
+#define NUM_MIXED 25000
+#define KEY_SPACE (1 << 23)
+#endif
+#define NUM_RANGES 2000
+#define RANGE_WIDTH 2000
+#define KEY_SENTINEL INT_MAX  // pads unused slots; real keys stay below KEY_SPACE
+
+static const int degree_sweep[] = {3, 8, 32};
+#define NUM_DEGREES 3
+
+// ---------------------------------------------------------------------------
+// B+-tree: keys first (one cache line), then children or leaf payload.
+// A node is 208 bytes on LP64 and pool slots are rounded up to 256, so the
+// search touches only the first line and a descent reads one more for the
+// child pointer.
+// ---------------------------------------------------------------------------
+
+typedef struct BPNode {
+    int keys[NODE_KEYS];
+    int num_keys;
+    int is_leaf;
+    union {
+        struct BPNode *children[NODE_KEYS + 1];
+        struct {
+            int values[NODE_KEYS];
+            struct BPNode *next;
+        } leaf;
+    } u;
+} BPNode;
+
+typedef struct {
+    char *block;        // current slab of line-aligned nodes
+    int used;
+    int capacity;
+    char **slabs;
+    int num_slabs;
+    int slab_capacity;
+} NodePool;
+
+typedef struct {
+    BPNode *root;
+    BPNode *first_leaf;
+    NodePool pool;
+    int height;
+} BPTree;
+
+#define NODE_STRIDE (((int)sizeof(BPNode) + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE)
+#define POOL_SLAB_NODES 4096
+
+static BPNode* pool_node(NodePool *p) {
+    if (!p->block || p->used == p->capacity) {
+        char *raw = (char*)malloc((size_t)POOL_SLAB_NODES * NODE_STRIDE + CACHE_LINE);
+        if (p->num_slabs == p->slab_capacity) {
+            p->slab_capacity = p->slab_capacity ? p->slab_capacity * 2 : 16;
+            p->slabs = (char**)realloc(p->slabs, p->slab_capacity * sizeof(char*));
+        }
+        p->slabs[p->num_slabs++] = raw;
+        p->block = (char*)(((size_t)raw + CACHE_LINE - 1) & ~(size_t)(CACHE_LINE - 1));
+        p->used = 0;
+        p->capacity = POOL_SLAB_NODES;
+    }
+    BPNode *node = (BPNode*)(p->block + (size_t)p->used * NODE_STRIDE);
+    p->used++;
+    return node;
+}
+
+static BPNode* bp_new_node(BPTree *t, int is_leaf) {
+    BPNode *node = pool_node(&t->pool);
+    for (int i = 0; i < NODE_KEYS; i++) node->keys[i] = KEY_SENTINEL;
+    node->num_keys = 0;
+    node->is_leaf = is_leaf;
+    if (is_leaf) node->u.leaf.next = NULL;
+    return node;
+}
+
+void bp_init(BPTree *t) {
+    memset(t, 0, sizeof(*t));
+    t->root = bp_new_node(t, 1);
+    t->first_leaf = t->root;
+    t->height = 1;
+}
+
+void bp_destroy(BPTree *t) {
+    for (int i = 0; i < t->pool.num_slabs; i++) free(t->pool.slabs[i]);
+    free(t->pool.slabs);
+    memset(t, 0, sizeof(*t));
+}
+
+// Fixed trip count, no early exit: unused slots hold KEY_SENTINEL, so the
+// loop compiles to compares + adds that the vectorizer can widen.
+static inline int count_less(const int *keys, int key) {
+    int pos = 0;
+    for (int i = 0; i < NODE_KEYS; i++) pos += keys[i] < key;
+    return pos;
+}
+
+// A key equal to KEY_SENTINEL also counts the padding slots, so the child
+// index is capped at num_keys to stay inside children[0..num_keys].
+static inline int count_less_equal(const int *keys, int num_keys, int key) {
+    int pos = 0;
+    for (int i = 0; i < NODE_KEYS; i++) pos += keys[i] <= key;
+    return pos < num_keys ? pos : num_keys;
+}
+
+static BPNode* bp_find_leaf(BPTree *t, int key) {
+    BPNode *node = t->root;
+    while (!node->is_leaf) {
+        node = node->u.children[count_less_equal(node->keys, node->num_keys, key)];
+    }
+    return node;
+}
+
+int bp_lookup(BPTree *t, int key, int *value) {
+    BPNode *leaf = bp_find_leaf(t, key);
+    int pos = count_less(leaf->keys, key);
+    if (pos < leaf->num_keys && leaf->keys[pos] == key) {
+        *value = leaf->u.leaf.values[pos];
+        return 1;
+    }
+    return 0;
+}
+
+// Inserts into the subtree; on split returns the new right sibling and its separator
+static BPNode* bp_insert_rec(BPTree *t, BPNode *node, int key, int value, int *sep) {
+    if (node->is_leaf) {
+        int pos = count_less(node->keys, key);
+        if (pos < node->num_keys && node->keys[pos] == key) {
+            node->u.leaf.values[pos] = value;
+            return NULL;
+        }
+        if (node->num_keys < NODE_KEYS) {
+            memmove(&node->keys[pos + 1], &node->keys[pos], (node->num_keys - pos) * sizeof(int));
+            memmove(&node->u.leaf.values[pos + 1], &node->u.leaf.values[pos],
+                    (node->num_keys - pos) * sizeof(int));
+            node->keys[pos] = key;
+            node->u.leaf.values[pos] = value;
+            node->num_keys++;
+            return NULL;
+        }
+
+        // Split a full leaf: merge the new key into a scratch copy, halve it
+        int tmp_keys[NODE_KEYS + 1], tmp_vals[NODE_KEYS + 1];
+        memcpy(tmp_keys, node->keys, pos * sizeof(int));
+        memcpy(tmp_vals, node->u.leaf.values, pos * sizeof(int));
+        tmp_keys[pos] = key;
+        tmp_vals[pos] = value;
+        memcpy(&tmp_keys[pos + 1], &node->keys[pos], (NODE_KEYS - pos) * sizeof(int));
+        memcpy(&tmp_vals[pos + 1], &node->u.leaf.values[pos], (NODE_KEYS - pos) * sizeof(int));
+
+        BPNode *right = bp_new_node(t, 1);
+        int left_count = (NODE_KEYS + 1) / 2;
+        int right_count = NODE_KEYS + 1 - left_count;
+        for (int i = 0; i < NODE_KEYS; i++) node->keys[i] = KEY_SENTINEL;
+        memcpy(node->keys, tmp_keys, left_count * sizeof(int));
+        memcpy(node->u.leaf.values, tmp_vals, left_count * sizeof(int));
+        memcpy(right->keys, &tmp_keys[left_count], right_count * sizeof(int));
+        memcpy(right->u.leaf.values, &tmp_vals[left_count], right_count * sizeof(int));
+        node->num_keys = left_count;
+        right->num_keys = right_count;
+        right->u.leaf.next = node->u.leaf.next;
+        node->u.leaf.next = right;
+        *sep = right->keys[0];
+        return right;
+    }
+
+    int idx = count_less_equal(node->keys, node->num_keys, key);
+    int child_sep;
+    BPNode *split = bp_insert_rec(t, node->u.children[idx], key, value, &child_sep);
+    if (!split) return NULL;
+
+    if (node->num_keys < NODE_KEYS) {
+        memmove(&node->keys[idx + 1], &node->keys[idx], (node->num_keys - idx) * sizeof(int));
+        memmove(&node->u.children[idx + 2], &node->u.children[idx + 1],
+                (node->num_keys - idx) * sizeof(BPNode*));
+        node->keys[idx] = child_sep;
+        node->u.children[idx + 1] = split;
+        node->num_keys++;
+        return NULL;
+    }
+
+    // Split a full internal node; the middle separator moves up
+    int tmp_keys[NODE_KEYS + 1];
+    BPNode *tmp_children[NODE_KEYS + 2];
+    memcpy(tmp_keys, node->keys, idx * sizeof(int));
+    tmp_keys[idx] = child_sep;
+    memcpy(&tmp_keys[idx + 1], &node->keys[idx], (NODE_KEYS - idx) * sizeof(int));
+    memcpy(tmp_children, node->u.children, (idx + 1) * sizeof(BPNode*));
+    tmp_children[idx + 1] = split;
+    memcpy(&tmp_children[idx + 2], &node->u.children[idx + 1], (NODE_KEYS - idx) * sizeof(BPNode*));
+
+    int mid = (NODE_KEYS + 1) / 2;
+    BPNode *right = bp_new_node(t, 0);
+    for (int i = 0; i < NODE_KEYS; i++) node->keys[i] = KEY_SENTINEL;
+    memcpy(node->keys, tmp_keys, mid * sizeof(int));
+    memcpy(node->u.children, tmp_children, (mid + 1) * sizeof(BPNode*));
+    node->num_keys = mid;
+    int right_count = NODE_KEYS - mid;
+    memcpy(right->keys, &tmp_keys[mid + 1], right_count * sizeof(int));
+    memcpy(right->u.children, &tmp_children[mid + 1], (right_count + 1) * sizeof(BPNode*));
+    right->num_keys = right_count;
+    *sep = tmp_keys[mid];
+    return right;
+}
+
+void bp_insert(BPTree *t, int key, int value) {
+    int sep;
+    BPNode *split = bp_insert_rec(t, t->root, key, value, &sep);
+    if (split) {
+        BPNode *root = bp_new_node(t, 0);
+        root->keys[0] = sep;
+        root->num_keys = 1;
+        root->u.children[0] = t->root;
+        root->u.children[1] = split;
+        t->root = root;
+        t->height++;
+    }
+}
+
+// Sum of values with lo <= key < hi, walking the leaf chain
+long long bp_range_sum(BPTree *t, int lo, int hi, int *count) {
+    BPNode *leaf = bp_find_leaf(t, lo);
+    int pos = count_less(leaf->keys, lo);
+    long long sum = 0;
+    int n = 0;
+    while (leaf) {
+        for (; pos < leaf->num_keys; pos++) {
+            if (leaf->keys[pos] >= hi) {
+                *count = n;
+                return sum;
+            }
+            sum += leaf->u.leaf.values[pos];
+            n++;
+        }
+        leaf = leaf->u.leaf.next;
+        pos = 0;
+    }
+    *count = n;
+    return sum;
+}
+
+// Bottom-up build from sorted unique keys; previous contents are discarded
+void bp_bulk_load(BPTree *t, const int *keys, const int *values, int n) {
+    bp_destroy(t);
+    memset(t, 0, sizeof(*t));
+
+    int num_nodes = (n + LEAF_FILL - 1) / LEAF_FILL;
+    if (num_nodes == 0) num_nodes = 1;
+    BPNode **level = (BPNode**)malloc(num_nodes * sizeof(BPNode*));
+    int *level_min = (int*)malloc(num_nodes * sizeof(int));
+
+    BPNode *prev = NULL;
+    for (int i = 0; i < num_nodes; i++) {
+        BPNode *leaf = bp_new_node(t, 1);
+        int begin = i * LEAF_FILL;
+        int count = n - begin < LEAF_FILL ? n - begin : LEAF_FILL;
+        if (count < 0) count = 0;
+        memcpy(leaf->keys, &keys[begin], count * sizeof(int));
+        memcpy(leaf->u.leaf.values, &values[begin], count * sizeof(int));
+        leaf->num_keys = count;
+        if (prev) prev->u.leaf.next = leaf;
+        else t->first_leaf = leaf;
+        prev = leaf;
+        level[i] = leaf;
+        level_min[i] = count ? keys[begin] : 0;
+    }
+    t->height = 1;
+
+    while (num_nodes > 1) {
+        int fanout = NODE_KEYS + 1;
+        int parents = (num_nodes + fanout - 1) / fanout;
+        for (int p = 0; p < parents; p++) {
+            BPNode *node = bp_new_node(t, 0);
+            int begin = p * fanout;
+            int count = num_nodes - begin < fanout ? num_nodes - begin : fanout;
+            for (int c = 0; c < count; c++) {
+                node->u.children[c] = level[begin + c];
+                if (c > 0) node->keys[c - 1] = level_min[begin + c];
+            }
+            node->num_keys = count - 1;
+            level[p] = node;
+            level_min[p] = level_min[begin];
+        }
+        num_nodes = parents;
+        t->height++;
+    }
+
+    t->root = level[0];
+    free(level);
+    free(level_min);
+}
+
+// Removes every key in [lo, hi) by compacting leaves along the chain.
+// Separators stay valid as routing bounds, so no restructuring is needed;
+// emptied leaves are reclaimed on the next bulk load.
+int bp_delete_range(BPTree *t, int lo, int hi) {
+    BPNode *leaf = bp_find_leaf(t, lo);
+    int removed = 0;
+    while (leaf) {
+        if (leaf->num_keys > 0 && leaf->keys[0] >= hi) break;
+        int out = 0;
+        for (int i = 0; i < leaf->num_keys; i++) {
+            int k = leaf->keys[i];
+            if (k >= lo && k < hi) {
+                removed++;
+                continue;
+            }
+            leaf->keys[out] = k;
+            leaf->u.leaf.values[out] = leaf->u.leaf.values[i];
+            out++;
+        }
+        for (int i = out; i < leaf->num_keys; i++) leaf->keys[i] = KEY_SENTINEL;
+        leaf->num_keys = out;
+        leaf = leaf->u.leaf.next;
+    }
+    return removed;
+}
+
+// ---------------------------------------------------------------------------
+// Classic B-tree baseline (130_b_tree.c) with the minimum degree as a parameter
+// ---------------------------------------------------------------------------
+
+typedef struct BTreeNode {
+    int *keys;
+    struct BTreeNode **children;
+    int num_keys;
+    int is_leaf;
+} BTreeNode;
+
+typedef struct {
+    BTreeNode *root;
+    int t;
+} BTree;
+
+static BTreeNode* bt_create_node(int t, int is_leaf) {
+    BTreeNode *node = (BTreeNode*)malloc(sizeof(BTreeNode));
+    node->keys = (int*)malloc((2 * t - 1) * sizeof(int));
+    node->children = (BTreeNode**)malloc(2 * t * sizeof(BTreeNode*));
+    node->num_keys = 0;
+    node->is_leaf = is_leaf;
+    return node;
+}
+
+static void bt_split_child(int t, BTreeNode *parent, int index) {
+    BTreeNode *full = parent->children[index];
+    BTreeNode *right = bt_create_node(t, full->is_leaf);
+    right->num_keys = t - 1;
+    for (int i = 0; i < t - 1; i++) right->keys[i] = full->keys[i + t];
+    if (!full->is_leaf) {
+        for (int i = 0; i < t; i++) right->children[i] = full->children[i + t];
+    }
+    full->num_keys = t - 1;
+    for (int i = parent->num_keys; i > index; i--) parent->children[i + 1] = parent->children[i];
+    parent->children[index + 1] = right;
+    for (int i = parent->num_keys - 1; i >= index; i--) parent->keys[i + 1] = parent->keys[i];
+    parent->keys[index] = full->keys[t - 1];
+    parent->num_keys++;
+}
+
+static void bt_insert_non_full(int t, BTreeNode *node, int key) {
+    int i = node->num_keys - 1;
+    if (node->is_leaf) {
+        while (i >= 0 && key < node->keys[i]) {
+            node->keys[i + 1] = node->keys[i];
+            i--;
+        }
+        node->keys[i + 1] = key;
+        node->num_keys++;
+        return;
+    }
+    while (i >= 0 && key < node->keys[i]) i--;
+    i++;
+    if (node->children[i]->num_keys == 2 * t - 1) {
+        bt_split_child(t, node, i);
+        if (key > node->keys[i]) i++;
+    }
+    bt_insert_non_full(t, node->children[i], key);
+}
+
+int bt_search(BTreeNode *node, int key) {
+    while (node) {
+        int i = 0;
+        while (i < node->num_keys && key > node->keys[i]) i++;
+        if (i < node->num_keys && key == node->keys[i]) return 1;
+        node = node->is_leaf ? NULL : node->children[i];
+    }
+    return 0;
+}
+
+void bt_insert(BTree *tree, int key) {
+    if (bt_search(tree->root, key)) return;
+    BTreeNode *root = tree->root;
+    if (root->num_keys == 2 * tree->t - 1) {
+        BTreeNode *new_root = bt_create_node(tree->t, 0);
+        new_root->children[0] = root;
+        bt_split_child(tree->t, new_root, 0);
+        tree->root = new_root;
+    }
+    bt_insert_non_full(tree->t, tree->root, key);
+}
+
+// In-order walk restricted to [lo, hi); values equal keys in the baseline
+static long long bt_range_sum(BTreeNode *node, int lo, int hi, int *count) {
+    long long sum = 0;
+    int i = 0;
+    while (i < node->num_keys && node->keys[i] < lo) i++;
+    for (; i <= node->num_keys; i++) {
+        if (!node->is_leaf) sum += bt_range_sum(node->children[i], lo, hi, count);
+        if (i == node->num_keys || node->keys[i] >= hi) break;
+        sum += node->keys[i];
+        (*count)++;
+    }
+    return sum;
+}
+
+void bt_free(BTreeNode *node) {
+    if (!node->is_leaf) {
+        for (int i = 0; i <= node->num_keys; i++) bt_free(node->children[i]);
+    }
+    free(node->keys);
+    free(node->children);
+    free(node);
+}
+
+// ---------------------------------------------------------------------------
+// Benchmark
+// ---------------------------------------------------------------------------
+
+static unsigned int seed = 42;
+
+static int next_key() {
+    seed = seed * 1103515245 + 12345;
+    return (int)((seed >> 2) % KEY_SPACE);
+}
+
+// Separate stream for the mixed-workload operation mix, so the choice of
+// operation is independent of the key's low bits
+static unsigned int op_seed = 7;
+
+static int next_op() {
+    op_seed = op_seed * 1103515245 + 12345;
+    return (int)((op_seed >> 16) & 3);
+}
+
+static int cmp_int(const void *a, const void *b) {
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+static double seconds_since(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+int main() {
+    int *keys = (int*)malloc(NUM_KEYS * sizeof(int));
+    int *probes = (int*)malloc(NUM_LOOKUPS * sizeof(int));
+    for (int i = 0; i < NUM_KEYS; i++) keys[i] = next_key();
+    for (int i = 0; i < NUM_LOOKUPS; i++) probes[i] = (i & 1) ? keys[next_key() % NUM_KEYS] : next_key();
+
+    clock_t total_start = clock();
+    int mismatches = 0;
+
+    // Incremental inserts
+    BPTree bp;
+    bp_init(&bp);
+    clock_t start = clock();
+    for (int i = 0; i < NUM_KEYS; i++) bp_insert(&bp, keys[i], keys[i]);
+    printf("  B+-tree   insert     %.6f s (height %d)\n", seconds_since(start), bp.height);
+
+    // Bulk load from sorted unique input
+    int *sorted = (int*)malloc(NUM_KEYS * sizeof(int));
+    memcpy(sorted, keys, NUM_KEYS * sizeof(int));
+    qsort(sorted, NUM_KEYS, sizeof(int), cmp_int);
+    int unique = 0;
+    for (int i = 0; i < NUM_KEYS; i++) {
+        if (unique == 0 || sorted[unique - 1] != sorted[i]) sorted[unique++] = sorted[i];
+    }
+    BPTree bulk;
+    bp_init(&bulk);
+    start = clock();
+    bp_bulk_load(&bulk, sorted, sorted, unique);
+    printf("  B+-tree   bulk load  %.6f s (%d keys, height %d)\n", seconds_since(start), unique, bulk.height);
+
+    // Point lookups
+    int found_bp = 0, found_bulk = 0, value;
+    start = clock();
+    for (int i = 0; i < NUM_LOOKUPS; i++) found_bp += bp_lookup(&bp, probes[i], &value);
+    printf("  B+-tree   lookups    %.6f s (found %d)\n", seconds_since(start), found_bp);
+    for (int i = 0; i < NUM_LOOKUPS; i++) found_bulk += bp_lookup(&bulk, probes[i], &value);
+    if (found_bulk != found_bp) mismatches++;
+
+    // Range scans
+    long long range_bp = 0;
+    int range_count = 0, c;
+    start = clock();
+    for (int i = 0; i < NUM_RANGES; i++) {
+        int lo = probes[i];
+        range_bp += bp_range_sum(&bp, lo, lo + RANGE_WIDTH * (KEY_SPACE / NUM_KEYS), &c);
+        range_count += c;
+    }
+    printf("  B+-tree   ranges     %.6f s (%d keys scanned)\n", seconds_since(start), range_count);
+
+    // Classic B-tree degree sweep on the same workload
+    for (int d = 0; d < NUM_DEGREES; d++) {
+        BTree bt;
+        bt.t = degree_sweep[d];
+        bt.root = bt_create_node(bt.t, 1);
+
+        start = clock();
+        for (int i = 0; i < NUM_KEYS; i++) bt_insert(&bt, keys[i]);
+        double t_insert = seconds_since(start);
+
+        int found_bt = 0;
+        start = clock();
+        for (int i = 0; i < NUM_LOOKUPS; i++) found_bt += bt_search(bt.root, probes[i]);
+        double t_lookup = seconds_since(start);
+
+        long long range_bt = 0;
+        start = clock();
+        for (int i = 0; i < NUM_RANGES; i++) {
+            int lo = probes[i];
+            int cnt = 0;
+            range_bt += bt_range_sum(bt.root, lo, lo + RANGE_WIDTH * (KEY_SPACE / NUM_KEYS), &cnt);
+        }
+        double t_range = seconds_since(start);
+
+        if (found_bt != found_bp || range_bt != range_bp) mismatches++;
+        printf("  B-tree T=%-2d insert %.6f s, lookups %.6f s, ranges %.6f s\n",
+               bt.t, t_insert, t_lookup, t_range);
+        bt_free(bt.root);
+    }
+
+    // Mixed workload: 50% lookup, 25% insert, 25% short range scan
+    long long mixed_sum = 0;
+    start = clock();
+    for (int i = 0; i < NUM_MIXED; i++) {
+        int k = next_key();
+        switch (next_op()) {
+            case 0:
+            case 1:
+                mixed_sum += bp_lookup(&bulk, k, &value);
+                break;
+            case 2:
+                bp_insert(&bulk, k, k);
+                break;
+            default:
+                mixed_sum += bp_range_sum(&bulk, k, k + 64 * (KEY_SPACE / NUM_KEYS), &c);
+                break;
+        }
+    }
+    printf("  B+-tree   mixed      %.6f s (%d ops, checksum %lld)\n", seconds_since(start), NUM_MIXED, mixed_sum);
+
+    // Bulk delete of the lower quarter of the key space
+    start = clock();
+    int removed = bp_delete_range(&bulk, 0, KEY_SPACE / 4);
+    double t_delete = seconds_since(start);
+    bp_range_sum(&bulk, 0, KEY_SPACE / 4, &c);
+    if (c != 0) mismatches++;
+    printf("  B+-tree   range del  %.6f s (%d keys removed)\n", t_delete, removed);
+
+    double time_spent = seconds_since(total_start);
+    printf("B+-tree: %d keys, %d-key nodes, %.6f seconds\n", NUM_KEYS, NODE_KEYS, time_spent);
+    printf("Lookups found: %d, range checksum: %lld, mismatches: %d\n", found_bp, range_bp, mismatches);
+
+    bp_destroy(&bp);
+    bp_destroy(&bulk);
+    free(sorted);
+    free(keys);
+    free(probes);
+    return 0;
+}
@@ -0,0 +1,651 @@
+// Flat open-addressing hash table with 16-wide control-byte groups (Swiss-table style)
+// Backward-shift deletion (no tombstones), incremental resize; vs chained, cuckoo, Robin Hood
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#define GROUP_WIDTH 16
+#define CTRL_EMPTY 0x80
+#define MIGRATE_STEP 32           // old-table slots moved per mutating operation
+#define MAX_LOAD_NUM 15           // grow above 15/16 occupancy
+#define MAX_LOAD_DEN 16
+#ifdef FULL_SIZE
+#define BENCH_CAPACITY (1 << 18)
+#define RESIZE_KEYS 500000
+#else
+#define BENCH_CAPACITY (1 << 16)  // -DFULL_SIZE for 256K slots
+#define RESIZE_KEYS 125000
+#endif
+#define NUM_LOAD_FACTORS 5
+#define MAX_REHASH 500
+
+static const double load_factors[NUM_LOAD_FACTORS] = {0.5, 0.6, 0.7, 0.8, 0.9};
+
+static inline uint32_t hash_key(uint32_t key) {
+    key ^= key >> 16;
+    key *= 0x85ebca6bu;
+    key ^= key >> 13;
+    key *= 0xc2b2ae35u;
+    key ^= key >> 16;
+    return key;
+}
+
+// ---------------------------------------------------------------------------
+// Group matching on 8-byte words (two words per 16-byte group).
+// Full slots store the low 7 hash bits, empty slots 0x80.
+// ---------------------------------------------------------------------------
+
+#define LSB_BYTES 0x0101010101010101ULL
+#define MSB_BYTES 0x8080808080808080ULL
+
+static inline uint64_t load_word(const unsigned char *p) {
+    uint64_t w;
+    memcpy(&w, p, sizeof(w));
+    return w;
+}
+
+// High bit set in every byte equal to tag (may over-report after a true
+// match because of borrows; callers always confirm with a key compare)
+static inline uint64_t match_tag(uint64_t w, unsigned char tag) {
+    uint64_t x = w ^ (LSB_BYTES * tag);
+    return (x - LSB_BYTES) & ~x & MSB_BYTES;
+}
+
+static inline uint64_t match_empty(uint64_t w) {
+    return w & MSB_BYTES;
+}
+
+// Index of the lowest flagged byte in a mask produced above
+static inline int first_flagged_byte(uint64_t m) {
+    return (int)((((m & (~m + 1)) >> 7) * 0x0001020304050607ULL) >> 56);
+}
+
+// ---------------------------------------------------------------------------
+// Flat table: linear probing over slots, scanned one 16-byte group at a time.
+// The first GROUP_WIDTH control bytes are mirrored past the end so a group
+// read never wraps.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    unsigned char *ctrl;
+    uint32_t *keys;
+    int *values;
+    int capacity;
+    int mask;
+    int size;
+} FlatTable;
+
+static void flat_init(FlatTable *ft, int capacity) {
+    ft->capacity = capacity;
+    ft->mask = capacity - 1;
+    ft->size = 0;
+    ft->ctrl = (unsigned char*)malloc(capacity + GROUP_WIDTH);
+    memset(ft->ctrl, CTRL_EMPTY, capacity + GROUP_WIDTH);
+    ft->keys = (uint32_t*)malloc(capacity * sizeof(uint32_t));
+    ft->values = (int*)malloc(capacity * sizeof(int));
+}
+
+static void flat_free(FlatTable *ft) {
+    free(ft->ctrl);
+    free(ft->keys);
+    free(ft->values);
+    memset(ft, 0, sizeof(*ft));
+}
+
+static inline void flat_set_ctrl(FlatTable *ft, int i, unsigned char c) {
+    ft->ctrl[i] = c;
+    if (i < GROUP_WIDTH) ft->ctrl[ft->capacity + i] = c;
+}
+
+static int flat_find(FlatTable *ft, uint32_t key, uint32_t h) {
+    unsigned char tag = h & 0x7f;
+    int pos = (h >> 7) & ft->mask;
+    for (;;) {
+        for (int half = 0; half < GROUP_WIDTH; half += 8) {
+            uint64_t w = load_word(ft->ctrl + pos + half);
+            uint64_t m = match_tag(w, tag);
+            while (m) {
+                int slot = (pos + half + first_flagged_byte(m)) & ft->mask;
+                if (ft->keys[slot] == key) return slot;
+                m &= m - 1;
+            }
+            // A key never sits past the first empty slot of its probe run
+            if (match_empty(w)) return -1;
+        }
+        pos = (pos + GROUP_WIDTH) & ft->mask;
+    }
+}
+
+// Caller guarantees the key is absent and a free slot exists
+static void flat_insert_new(FlatTable *ft, uint32_t key, int value, uint32_t h) {
+    int pos = (h >> 7) & ft->mask;
+    for (;;) {
+        for (int half = 0; half < GROUP_WIDTH; half += 8) {
+            uint64_t e = match_empty(load_word(ft->ctrl + pos + half));
+            if (e) {
+                int slot = (pos + half + first_flagged_byte(e)) & ft->mask;
+                flat_set_ctrl(ft, slot, h & 0x7f);
+                ft->keys[slot] = key;
+                ft->values[slot] = value;
+                ft->size++;
+                return;
+            }
+        }
+        pos = (pos + GROUP_WIDTH) & ft->mask;
+    }
+}
+
+// Knuth's Algorithm R: pull later run members back instead of leaving a tombstone
+static void flat_erase_slot(FlatTable *ft, int hole) {
+    int j = hole;
+    for (;;) {
+        j = (j + 1) & ft->mask;
+        if (ft->ctrl[j] == CTRL_EMPTY) break;
+        int home = (hash_key(ft->keys[j]) >> 7) & ft->mask;
+        if (((j - home) & ft->mask) >= ((j - hole) & ft->mask)) {
+            flat_set_ctrl(ft, hole, ft->ctrl[j]);
+            ft->keys[hole] = ft->keys[j];
+            ft->values[hole] = ft->values[j];
+            hole = j;
+        }
+    }
+    flat_set_ctrl(ft, hole, CTRL_EMPTY);
+    ft->size--;
+}
+
+// ---------------------------------------------------------------------------
+// Swiss table: current flat table plus an old one drained a few slots per
+// insert/erase, so no single operation pays for a full rehash.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    FlatTable cur;
+    FlatTable old;
+    int migrating;
+    int cursor;
+} SwissTable;
+
+void swiss_init(SwissTable *st, int capacity) {
+    int cap = GROUP_WIDTH;
+    while (cap < capacity) cap <<= 1;
+    flat_init(&st->cur, cap);
+    memset(&st->old, 0, sizeof(st->old));
+    st->migrating = 0;
+    st->cursor = 0;
+}
+
+void swiss_free(SwissTable *st) {
+    flat_free(&st->cur);
+    if (st->migrating) flat_free(&st->old);
+}
+
+static void swiss_migrate(SwissTable *st, int budget) {
+    FlatTable *old = &st->old;
+    while (budget-- > 0 && st->cursor < old->capacity) {
+        int i = st->cursor;
+        if (old->ctrl[i] == CTRL_EMPTY) {
+            st->cursor++;
+            continue;
+        }
+        uint32_t key = old->keys[i];
+        flat_insert_new(&st->cur, key, old->values[i], hash_key(key));
+        // Backward shift may refill slot i from later in the run; revisit it
+        flat_erase_slot(old, i);
+    }
+    if (st->cursor >= old->capacity || old->size == 0) {
+        flat_free(old);
+        st->migrating = 0;
+    }
+}
+
+static void swiss_maybe_grow(SwissTable *st) {
+    int total = st->cur.size + (st->migrating ? st->old.size : 0);
+    if ((long long)(total + 1) * MAX_LOAD_DEN <= (long long)st->cur.capacity * MAX_LOAD_NUM) return;
+
+    // Finish any earlier migration before starting the next one
+    while (st->migrating) swiss_migrate(st, st->old.capacity);
+    st->old = st->cur;
+    flat_init(&st->cur, st->old.capacity * 2);
+    st->migrating = 1;
+    st->cursor = 0;
+}
+
+int swiss_lookup(SwissTable *st, uint32_t key, int *value) {
+    uint32_t h = hash_key(key);
+    int slot = flat_find(&st->cur, key, h);
+    if (slot >= 0) {
+        *value = st->cur.values[slot];
+        return 1;
+    }
+    if (st->migrating) {
+        slot = flat_find(&st->old, key, h);
+        if (slot >= 0) {
+            *value = st->old.values[slot];
+            return 1;
+        }
+    }
+    return 0;
+}
+
+void swiss_insert(SwissTable *st, uint32_t key, int value) {
+    uint32_t h = hash_key(key);
+    int slot = flat_find(&st->cur, key, h);
+    if (slot >= 0) {
+        st->cur.values[slot] = value;
+        return;
+    }
+    if (st->migrating) {
+        slot = flat_find(&st->old, key, h);
+        if (slot >= 0) {
+            st->old.values[slot] = value;
+            swiss_migrate(st, MIGRATE_STEP);
+            return;
+        }
+    }
+    swiss_maybe_grow(st);
+    flat_insert_new(&st->cur, key, value, h);
+    if (st->migrating) swiss_migrate(st, MIGRATE_STEP);
+}
+
+int swiss_erase(SwissTable *st, uint32_t key) {
+    uint32_t h = hash_key(key);
+    int erased = 0;
+    int slot = flat_find(&st->cur, key, h);
+    if (slot >= 0) {
+        flat_erase_slot(&st->cur, slot);
+        erased = 1;
+    } else if (st->migrating) {
+        slot = flat_find(&st->old, key, h);
+        if (slot >= 0) {
+            flat_erase_slot(&st->old, slot);
+            erased = 1;
+        }
+    }
+    if (st->migrating) swiss_migrate(st, MIGRATE_STEP);
+    return erased;
+}
+
+int swiss_size(SwissTable *st) {
+    return st->cur.size + (st->migrating ? st->old.size : 0);
+}
+
+// ---------------------------------------------------------------------------
+// Robin Hood linear probing with backward-shift deletion
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    uint32_t *keys;
+    int *values;
+    int *dist;      // probe distance from home slot, -1 when empty
+    int capacity;
+    int mask;
+    int size;
+} RobinHoodTable;
+
+void rh_init(RobinHoodTable *t, int capacity) {
+    t->capacity = capacity;
+    t->mask = capacity - 1;
+    t->size = 0;
+    t->keys = (uint32_t*)malloc(capacity * sizeof(uint32_t));
+    t->values = (int*)malloc(capacity * sizeof(int));
+    t->dist = (int*)malloc(capacity * sizeof(int));
+    for (int i = 0; i < capacity; i++) t->dist[i] = -1;
+}
+
+void rh_free(RobinHoodTable *t) {
+    free(t->keys);
+    free(t->values);
+    free(t->dist);
+}
+
+static int rh_find(RobinHoodTable *t, uint32_t key) {
+    int pos = hash_key(key) & t->mask;
+    for (int d = 0;; d++) {
+        if (t->dist[pos] < d) return -1;  // empty (-1) or a richer resident
+        if (t->keys[pos] == key) return pos;
+        pos = (pos + 1) & t->mask;
+    }
+}
+
+int rh_lookup(RobinHoodTable *t, uint32_t key, int *value) {
+    int slot = rh_find(t, key);
+    if (slot < 0) return 0;
+    *value = t->values[slot];
+    return 1;
+}
+
+void rh_insert(RobinHoodTable *t, uint32_t key, int value) {
+    int slot = rh_find(t, key);
+    if (slot >= 0) {
+        t->values[slot] = value;
+        return;
+    }
+    int pos = hash_key(key) & t->mask;
+    int d = 0;
+    for (;;) {
+        if (t->dist[pos] < 0) {
+            t->keys[pos] = key;
+            t->values[pos] = value;
+            t->dist[pos] = d;
+            t->size++;
+            return;
+        }
+        if (t->dist[pos] < d) {
+            uint32_t k = t->keys[pos];
+            int v = t->values[pos];
+            int od = t->dist[pos];
+            t->keys[pos] = key;
+            t->values[pos] = value;
+            t->dist[pos] = d;
+            key = k;
+            value = v;
+            d = od;
+        }
+        pos = (pos + 1) & t->mask;
+        d++;
+    }
+}
+
+int rh_erase(RobinHoodTable *t, uint32_t key) {
+    int pos = rh_find(t, key);
+    if (pos < 0) return 0;
+    int next = (pos + 1) & t->mask;
+    while (t->dist[next] > 0) {
+        t->keys[pos] = t->keys[next];
+        t->values[pos] = t->values[next];
+        t->dist[pos] = t->dist[next] - 1;
+        pos = next;
+        next = (next + 1) & t->mask;
+    }
+    t->dist[pos] = -1;
+    t->size--;
+    return 1;
+}
+
+// ---------------------------------------------------------------------------
+// Baselines: chained table from 91_hash_table.c, cuckoo from 127_cuckoo_hashing.c
+// ---------------------------------------------------------------------------
+
+typedef struct ChainEntry {
+    uint32_t key;
+    int value;
+    struct ChainEntry *next;
+} ChainEntry;
+
+typedef struct {
+    ChainEntry **buckets;
+    int size;
+} ChainedTable;
+
+void chained_init(ChainedTable *t, int size) {
+    t->size = size;
+    t->buckets = (ChainEntry**)calloc(size, sizeof(ChainEntry*));
+}
+
+void chained_insert(ChainedTable *t, uint32_t key, int value) {
+    int idx = key % t->size;
+    for (ChainEntry *e = t->buckets[idx]; e; e = e->next) {
+        if (e->key == key) {
+            e->value = value;
+            return;
+        }
+    }
+    ChainEntry *e = (ChainEntry*)malloc(sizeof(ChainEntry));
+    e->key = key;
+    e->value = value;
+    e->next = t->buckets[idx];
+    t->buckets[idx] = e;
+}
+
+int chained_lookup(ChainedTable *t, uint32_t key, int *value) {
+    for (ChainEntry *e = t->buckets[key % t->size]; e; e = e->next) {
+        if (e->key == key) {
+            *value = e->value;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int chained_erase(ChainedTable *t, uint32_t key) {
+    ChainEntry **link = &t->buckets[key % t->size];
+    while (*link) {
+        if ((*link)->key == key) {
+            ChainEntry *dead = *link;
+            *link = dead->next;
+            free(dead);
+            return 1;
+        }
+        link = &(*link)->next;
+    }
+    return 0;
+}
+
+void chained_free(ChainedTable *t) {
+    for (int i = 0; i < t->size; i++) {
+        ChainEntry *e = t->buckets[i];
+        while (e) {
+            ChainEntry *next = e->next;
+            free(e);
+            e = next;
+        }
+    }
+    free(t->buckets);
+}
+
+typedef struct {
+    uint32_t key;
+    int value;
+    int occupied;
+} CuckooEntry;
+
+typedef struct {
+    CuckooEntry *table1;
+    CuckooEntry *table2;
+    int size;
+} CuckooTable;
+
+static int cuckoo_h1(uint32_t key, int size) {
+    return ((key * 2654435761u) ^ 42u) % size;
+}
+
+static int cuckoo_h2(uint32_t key, int size) {
+    return ((key * 2246822519u) ^ 123u) % size;
+}
+
+void cuckoo_init(CuckooTable *t, int size) {
+    t->size = size;
+    t->table1 = (CuckooEntry*)calloc(size, sizeof(CuckooEntry));
+    t->table2 = (CuckooEntry*)calloc(size, sizeof(CuckooEntry));
+}
+
+static CuckooEntry* cuckoo_find(CuckooTable *t, uint32_t key) {
+    CuckooEntry *e = &t->table1[cuckoo_h1(key, t->size)];
+    if (e->occupied && e->key == key) return e;
+    e = &t->table2[cuckoo_h2(key, t->size)];
+    if (e->occupied && e->key == key) return e;
+    return NULL;
+}
+
+int cuckoo_lookup(CuckooTable *t, uint32_t key, int *value) {
+    CuckooEntry *e = cuckoo_find(t, key);
+    if (!e) return 0;
+    *value = e->value;
+    return 1;
+}
+
+// Returns 0 when the eviction chain exceeds MAX_REHASH (the key is lost,
+// as in the original, which has no rehash path)
+int cuckoo_insert(CuckooTable *t, uint32_t key, int value) {
+    CuckooEntry *e = cuckoo_find(t, key);
+    if (e) {
+        e->value = value;
+        return 1;
+    }
+    CuckooEntry cur = {key, value, 1};
+    for (int i = 0; i < MAX_REHASH; i++) {
+        CuckooEntry *slot = (i & 1) ? &t->table2[cuckoo_h2(cur.key, t->size)]
+                                    : &t->table1[cuckoo_h1(cur.key, t->size)];
+        CuckooEntry evicted = *slot;
+        *slot = cur;
+        if (!evicted.occupied) return 1;
+        cur = evicted;
+    }
+    return 0;
+}
+
+int cuckoo_erase(CuckooTable *t, uint32_t key) {
+    CuckooEntry *e = cuckoo_find(t, key);
+    if (!e) return 0;
+    e->occupied = 0;
+    return 1;
+}
+
+void cuckoo_free(CuckooTable *t) {
+    free(t->table1);
+    free(t->table2);
+}
+
+// ---------------------------------------------------------------------------
+// Benchmark
+// ---------------------------------------------------------------------------
+
+enum { T_SWISS, T_ROBIN, T_CHAINED, T_CUCKOO, NUM_TABLES };
+
+static const char *table_names[NUM_TABLES] = {"swiss", "robin-hood", "chained", "cuckoo"};
+
+typedef struct {
+    SwissTable swiss;
+    RobinHoodTable robin;
+    ChainedTable chained;
+    CuckooTable cuckoo;
+} AnyTable;
+
+static void any_init(AnyTable *t, int kind, int capacity) {
+    switch (kind) {
+        case T_SWISS:   swiss_init(&t->swiss, capacity); break;
+        case T_ROBIN:   rh_init(&t->robin, capacity); break;
+        case T_CHAINED: chained_init(&t->chained, capacity); break;
+        case T_CUCKOO:  cuckoo_init(&t->cuckoo, capacity / 2); break;
+    }
+}
+
+static int any_insert(AnyTable *t, int kind, uint32_t key, int value) {
+    switch (kind) {
+        case T_SWISS:   swiss_insert(&t->swiss, key, value); return 1;
+        case T_ROBIN:   rh_insert(&t->robin, key, value); return 1;
+        case T_CHAINED: chained_insert(&t->chained, key, value); return 1;
+        case T_CUCKOO:  return cuckoo_insert(&t->cuckoo, key, value);
+    }
+    return 0;
+}
+
+static int any_lookup(AnyTable *t, int kind, uint32_t key, int *value) {
+    switch (kind) {
+        case T_SWISS:   return swiss_lookup(&t->swiss, key, value);
+        case T_ROBIN:   return rh_lookup(&t->robin, key, value);
+        case T_CHAINED: return chained_lookup(&t->chained, key, value);
+        case T_CUCKOO:  return cuckoo_lookup(&t->cuckoo, key, value);
+    }
+    return 0;
+}
+
+static int any_erase(AnyTable *t, int kind, uint32_t key) {
+    switch (kind) {
+        case T_SWISS:   return swiss_erase(&t->swiss, key);
+        case T_ROBIN:   return rh_erase(&t->robin, key);
+        case T_CHAINED: return chained_erase(&t->chained, key);
+        case T_CUCKOO:  return cuckoo_erase(&t->cuckoo, key);
+    }
+    return 0;
+}
+
+static void any_free(AnyTable *t, int kind) {
+    switch (kind) {
+        case T_SWISS:   swiss_free(&t->swiss); break;
+        case T_ROBIN:   rh_free(&t->robin); break;
+        case T_CHAINED: chained_free(&t->chained); break;
+        case T_CUCKOO:  cuckoo_free(&t->cuckoo); break;
+    }
+}
+
+// Distinct, well-scattered keys: the mixer is a bijection on 32-bit integers
+static inline uint32_t key_at(int i) {
+    return hash_key((uint32_t)i ^ 0x9e3779b9u);
+}
+
+static double mops(int ops, clock_t start) {
+    double t = (double)(clock() - start) / CLOCKS_PER_SEC;
+    return t > 0 ? ops / t / 1e6 : 0.0;
+}
+
+int main() {
+    clock_t total_start = clock();
+    int errors = 0;
+    long long checksum = 0;
+
+    for (int li = 0; li < NUM_LOAD_FACTORS; li++) {
+        int n = (int)(load_factors[li] * BENCH_CAPACITY);
+        for (int kind = 0; kind < NUM_TABLES; kind++) {
+            AnyTable t;
+            int value, failed = 0, hits = 0, misses = 0, erased = 0;
+            any_init(&t, kind, BENCH_CAPACITY);
+
+            clock_t start = clock();
+            for (int i = 0; i < n; i++) failed += !any_insert(&t, kind, key_at(i), i);
+            double ins = mops(n, start);
+
+            start = clock();
+            for (int i = 0; i < n; i++) {
+                if (any_lookup(&t, kind, key_at(i), &value)) {
+                    hits++;
+                    checksum += value;
+                }
+            }
+            double hit = mops(n, start);
+
+            start = clock();
+            for (int i = n; i < 2 * n; i++) misses += any_lookup(&t, kind, key_at(i), &value);
+            double miss = mops(n, start);
+
+            start = clock();
+            for (int i = 0; i < n; i += 2) erased += any_erase(&t, kind, key_at(i));
+            double era = mops(n / 2, start);
+
+            // Every odd key must survive the erases of its neighbours
+            int survivors = 0;
+            for (int i = 1; i < n; i += 2) survivors += any_lookup(&t, kind, key_at(i), &value);
+
+            if (misses != 0 || (kind != T_CUCKOO && (hits != n || survivors != n / 2))) errors++;
+            printf("  lf=%.1f %-10s insert %6.1f  hit %6.1f  miss %6.1f  erase %6.1f Mops/s"
+                   "  (failed inserts %d)\n",
+                   load_factors[li], table_names[kind], ins, hit, miss, era, failed);
+            any_free(&t, kind);
+        }
+    }
+
+    // Incremental resize: start tiny and grow while interleaving erases
+    SwissTable grow;
+    swiss_init(&grow, GROUP_WIDTH);
+    clock_t start = clock();
+    for (int i = 0; i < RESIZE_KEYS; i++) {
+        swiss_insert(&grow, key_at(i), i);
+        if (i % 3 == 0) swiss_erase(&grow, key_at(i / 2));
+    }
+    double grow_rate = mops(RESIZE_KEYS, start);
+    int present = 0, value;
+    for (int i = 0; i < RESIZE_KEYS; i++) present += swiss_lookup(&grow, key_at(i), &value);
+    if (present != swiss_size(&grow)) errors++;
+    printf("  swiss incremental growth: %d keys live, capacity %d, %.1f Mops/s\n",
+           swiss_size(&grow), grow.cur.capacity, grow_rate);
+    swiss_free(&grow);
+
+    double time_spent = (double)(clock() - total_start) / CLOCKS_PER_SEC;
+    printf("Swiss hash table: capacity=%d, %d load factors, %.6f seconds\n",
+           BENCH_CAPACITY, NUM_LOAD_FACTORS, time_spent);
+    printf("Checksum: %lld, errors: %d\n", checksum, errors);
+
+    return 0;
+}
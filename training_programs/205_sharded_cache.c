@@ -0,0 +1,506 @@
+// Sharded cache with strict LRU, CLOCK and S3-FIFO eviction plus TinyLFU admission
+// Zipfian key streams from simulated threads, with shard locks in a work/span model
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#define NUM_SHARDS 16
+#ifdef FULL_SIZE
+#define CACHE_CAPACITY 16384      // total entries across all shards
+#define KEY_SPACE (1 << 20)
+#define OPS_PER_RUN 409600
+#else
+#define CACHE_CAPACITY 4096       // -DFULL_SIZE for 16K entries and 400K ops
+#define KEY_SPACE (1 << 18)
+#define OPS_PER_RUN 81920         // multiple of MAX_THREADS * ROUND_OPS
+#endif
+#define ZIPF_EXPONENT 0.99
+#define ROUND_OPS 256             // ops each simulated thread runs per round
+#define SKETCH_ROWS 4
+#define SKETCH_MAX 15
+#define SMALL_QUEUE_PERCENT 10
+#define MAX_THREADS 8
+
+static const int thread_counts[] = {1, 2, 4, 8};
+#define NUM_THREAD_COUNTS 4
+
+enum { POLICY_LRU, POLICY_CLOCK, POLICY_S3FIFO };
+static const char *policy_names[] = {"lru", "clock", "s3-fifo"};
+
+static inline uint32_t mix32(uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x7feb352du;
+    x ^= x >> 15;
+    x *= 0x846ca68bu;
+    x ^= x >> 16;
+    return x;
+}
+
+// ---------------------------------------------------------------------------
+// TinyLFU: count-min sketch of 4-bit-range counters, halved periodically
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    unsigned char *counters;
+    int width_mask;
+    int samples;
+    int sample_limit;
+} Sketch;
+
+static void sketch_init(Sketch *s, int capacity) {
+    int width = 16;
+    while (width < 4 * capacity) width <<= 1;
+    s->counters = (unsigned char*)calloc((size_t)SKETCH_ROWS * width, 1);
+    s->width_mask = width - 1;
+    s->samples = 0;
+    s->sample_limit = 10 * capacity;
+}
+
+static void sketch_record(Sketch *s, uint32_t key) {
+    uint32_t h = mix32(key);
+    for (int r = 0; r < SKETCH_ROWS; r++) {
+        unsigned char *c = &s->counters[r * (s->width_mask + 1) + ((h >> (8 * r)) & s->width_mask)];
+        if (*c < SKETCH_MAX) (*c)++;
+        h = h * 0x9e3779b1u + r;
+    }
+    if (++s->samples >= s->sample_limit) {
+        // Aging keeps the sketch tracking recent popularity
+        int total = SKETCH_ROWS * (s->width_mask + 1);
+        for (int i = 0; i < total; i++) s->counters[i] >>= 1;
+        s->samples /= 2;
+    }
+}
+
+static int sketch_estimate(Sketch *s, uint32_t key) {
+    uint32_t h = mix32(key);
+    int best = SKETCH_MAX;
+    for (int r = 0; r < SKETCH_ROWS; r++) {
+        int c = s->counters[r * (s->width_mask + 1) + ((h >> (8 * r)) & s->width_mask)];
+        if (c < best) best = c;
+        h = h * 0x9e3779b1u + r;
+    }
+    return best;
+}
+
+// ---------------------------------------------------------------------------
+// Shard: slot arrays indexed by int, chained hash index, per-policy metadata
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    int *slots;
+    int head;
+    int count;
+    int capacity;
+} Ring;
+
+static void ring_init(Ring *r, int capacity) {
+    r->slots = (int*)malloc(capacity * sizeof(int));
+    r->head = 0;
+    r->count = 0;
+    r->capacity = capacity;
+}
+
+static void ring_push(Ring *r, int slot) {
+    r->slots[(r->head + r->count) % r->capacity] = slot;
+    r->count++;
+}
+
+static int ring_pop(Ring *r) {
+    int slot = r->slots[r->head];
+    r->head = (r->head + 1) % r->capacity;
+    r->count--;
+    return slot;
+}
+
+typedef struct {
+    int policy;
+    int use_admission;
+    int capacity;
+    int size;
+    uint32_t *keys;
+    int *values;
+    int *buckets;
+    int *hash_next;
+    int bucket_mask;
+
+    // LRU: doubly linked list through slots, head = most recent
+    int *prev;
+    int *next;
+    int lru_head;
+    int lru_tail;
+
+    // CLOCK: reference bits swept by a hand
+    unsigned char *ref;
+    int hand;
+
+    // S3-FIFO: small and main FIFO queues, hit counters, direct-mapped ghost keys
+    unsigned char *freq;
+    Ring small;
+    Ring main;
+    uint32_t *ghost;
+    int ghost_mask;
+
+    Sketch sketch;
+    long long locked_ops;
+    long long rejected;
+} Shard;
+
+static void shard_init(Shard *sh, int policy, int use_admission, int capacity) {
+    memset(sh, 0, sizeof(*sh));
+    sh->policy = policy;
+    sh->use_admission = use_admission;
+    sh->capacity = capacity;
+    int nb = 16;
+    while (nb < 2 * capacity) nb <<= 1;
+    sh->bucket_mask = nb - 1;
+    sh->buckets = (int*)malloc(nb * sizeof(int));
+    for (int i = 0; i < nb; i++) sh->buckets[i] = -1;
+    sh->keys = (uint32_t*)malloc(capacity * sizeof(uint32_t));
+    sh->values = (int*)malloc(capacity * sizeof(int));
+    sh->hash_next = (int*)malloc(capacity * sizeof(int));
+    sh->prev = (int*)malloc(capacity * sizeof(int));
+    sh->next = (int*)malloc(capacity * sizeof(int));
+    sh->lru_head = sh->lru_tail = -1;
+    sh->ref = (unsigned char*)calloc(capacity, 1);
+    sh->freq = (unsigned char*)calloc(capacity, 1);
+    ring_init(&sh->small, capacity);
+    ring_init(&sh->main, capacity);
+    sh->ghost_mask = nb - 1;
+    sh->ghost = (uint32_t*)calloc(nb, sizeof(uint32_t));
+    if (use_admission) sketch_init(&sh->sketch, capacity);
+}
+
+static void shard_free(Shard *sh) {
+    free(sh->buckets);
+    free(sh->keys);
+    free(sh->values);
+    free(sh->hash_next);
+    free(sh->prev);
+    free(sh->next);
+    free(sh->ref);
+    free(sh->freq);
+    free(sh->small.slots);
+    free(sh->main.slots);
+    free(sh->ghost);
+    if (sh->use_admission) free(sh->sketch.counters);
+}
+
+static int shard_find(Shard *sh, uint32_t key) {
+    for (int s = sh->buckets[mix32(key) & sh->bucket_mask]; s >= 0; s = sh->hash_next[s]) {
+        if (sh->keys[s] == key) return s;
+    }
+    return -1;
+}
+
+static void index_insert(Shard *sh, int slot) {
+    int b = mix32(sh->keys[slot]) & sh->bucket_mask;
+    sh->hash_next[slot] = sh->buckets[b];
+    sh->buckets[b] = slot;
+}
+
+static void index_remove(Shard *sh, int slot) {
+    int *link = &sh->buckets[mix32(sh->keys[slot]) & sh->bucket_mask];
+    while (*link != slot) link = &sh->hash_next[*link];
+    *link = sh->hash_next[slot];
+}
+
+static void lru_unlink(Shard *sh, int s) {
+    if (sh->prev[s] >= 0) sh->next[sh->prev[s]] = sh->next[s];
+    else sh->lru_head = sh->next[s];
+    if (sh->next[s] >= 0) sh->prev[sh->next[s]] = sh->prev[s];
+    else sh->lru_tail = sh->prev[s];
+}
+
+static void lru_push_front(Shard *sh, int s) {
+    sh->prev[s] = -1;
+    sh->next[s] = sh->lru_head;
+    if (sh->lru_head >= 0) sh->prev[sh->lru_head] = s;
+    sh->lru_head = s;
+    if (sh->lru_tail < 0) sh->lru_tail = s;
+}
+
+// Hit path. Only strict LRU mutates shared structure (and so needs the shard
+// lock); CLOCK and S3-FIFO touch a single byte in the entry.
+int shard_get(Shard *sh, uint32_t key, int *value) {
+    if (sh->use_admission) sketch_record(&sh->sketch, key);
+    int s = shard_find(sh, key);
+    if (s < 0) return 0;
+    *value = sh->values[s];
+    switch (sh->policy) {
+        case POLICY_LRU:
+            sh->locked_ops++;
+            if (sh->lru_head != s) {
+                lru_unlink(sh, s);
+                lru_push_front(sh, s);
+            }
+            break;
+        case POLICY_CLOCK:
+            sh->ref[s] = 1;
+            break;
+        case POLICY_S3FIFO:
+            if (sh->freq[s] < 3) sh->freq[s]++;
+            break;
+    }
+    return 1;
+}
+
+static int clock_pick_victim(Shard *sh) {
+    while (sh->ref[sh->hand]) {
+        sh->ref[sh->hand] = 0;
+        sh->hand = (sh->hand + 1) % sh->capacity;
+    }
+    return sh->hand;
+}
+
+// Frees one slot following S3-FIFO: one-hit wonders leave through the small
+// queue into the ghost table, re-referenced entries are promoted or recycled.
+static int s3fifo_evict(Shard *sh) {
+    int small_target = sh->capacity * SMALL_QUEUE_PERCENT / 100;
+    for (;;) {
+        if (sh->small.count > small_target || sh->main.count == 0) {
+            int s = ring_pop(&sh->small);
+            if (sh->freq[s] > 1) {
+                sh->freq[s] = 0;
+                ring_push(&sh->main, s);
+                continue;
+            }
+            sh->ghost[mix32(sh->keys[s]) & sh->ghost_mask] = sh->keys[s];
+            return s;
+        }
+        int s = ring_pop(&sh->main);
+        if (sh->freq[s] > 0) {
+            sh->freq[s]--;
+            ring_push(&sh->main, s);
+            continue;
+        }
+        return s;
+    }
+}
+
+void shard_put(Shard *sh, uint32_t key, int value) {
+    sh->locked_ops++;
+    int s = shard_find(sh, key);
+    if (s >= 0) {
+        sh->values[s] = value;
+        return;
+    }
+
+    if (sh->size < sh->capacity) {
+        s = sh->size++;
+    } else {
+        int victim;
+        switch (sh->policy) {
+            case POLICY_LRU:   victim = sh->lru_tail; break;
+            case POLICY_CLOCK: victim = clock_pick_victim(sh); break;
+            default:           victim = s3fifo_evict(sh); break;
+        }
+        if (sh->use_admission && sh->policy != POLICY_S3FIFO &&
+            sketch_estimate(&sh->sketch, key) <= sketch_estimate(&sh->sketch, sh->keys[victim])) {
+            // Candidate is not hotter than what it would displace
+            sh->rejected++;
+            if (sh->policy == POLICY_CLOCK) sh->hand = (sh->hand + 1) % sh->capacity;
+            return;
+        }
+        index_remove(sh, victim);
+        if (sh->policy == POLICY_LRU) lru_unlink(sh, victim);
+        s = victim;
+    }
+
+    sh->keys[s] = key;
+    sh->values[s] = value;
+    index_insert(sh, s);
+    switch (sh->policy) {
+        case POLICY_LRU:
+            lru_push_front(sh, s);
+            break;
+        case POLICY_CLOCK:
+            sh->ref[s] = 0;
+            if (s == sh->hand) sh->hand = (sh->hand + 1) % sh->capacity;
+            break;
+        case POLICY_S3FIFO:
+            sh->freq[s] = 0;
+            if (sh->ghost[mix32(key) & sh->ghost_mask] == key) {
+                ring_push(&sh->main, s);
+            } else {
+                ring_push(&sh->small, s);
+            }
+            break;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Sharded front end
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    Shard shards[NUM_SHARDS];
+} ShardedCache;
+
+void cache_init(ShardedCache *c, int policy, int use_admission) {
+    for (int i = 0; i < NUM_SHARDS; i++) {
+        shard_init(&c->shards[i], policy, use_admission, CACHE_CAPACITY / NUM_SHARDS);
+    }
+}
+
+void cache_free(ShardedCache *c) {
+    for (int i = 0; i < NUM_SHARDS; i++) shard_free(&c->shards[i]);
+}
+
+static inline Shard* shard_for(ShardedCache *c, uint32_t key) {
+    return &c->shards[(mix32(key) >> 24) % NUM_SHARDS];
+}
+
+int cache_get(ShardedCache *c, uint32_t key, int *value) {
+    return shard_get(shard_for(c, key), key, value);
+}
+
+void cache_put(ShardedCache *c, uint32_t key, int value) {
+    shard_put(shard_for(c, key), key, value);
+}
+
+// ---------------------------------------------------------------------------
+// Zipfian workload: inverse-CDF sampling over ranks, ranks scattered to keys
+// ---------------------------------------------------------------------------
+
+static double *zipf_cdf;
+
+static void zipf_init() {
+    zipf_cdf = (double*)malloc(KEY_SPACE * sizeof(double));
+    double sum = 0.0;
+    for (int i = 0; i < KEY_SPACE; i++) {
+        sum += 1.0 / pow(i + 1, ZIPF_EXPONENT);
+        zipf_cdf[i] = sum;
+    }
+    for (int i = 0; i < KEY_SPACE; i++) zipf_cdf[i] /= sum;
+}
+
+static uint32_t zipf_next(uint64_t *state) {
+    *state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+    double u = (double)(*state >> 11) * (1.0 / 9007199254740992.0);
+    int lo = 0, hi = KEY_SPACE - 1;
+    while (lo < hi) {
+        int mid = (lo + hi) >> 1;
+        if (zipf_cdf[mid] < u) lo = mid + 1;
+        else hi = mid;
+    }
+    return (uint32_t)lo * 2654435761u;
+}
+
+// ---------------------------------------------------------------------------
+// Simulated threads run one after another, ROUND_OPS operations each per
+// round. Operations under a shard lock serialize across threads, lock-free
+// hits do not, so a round's span is the slowest thread or the busiest shard
+// lock, whichever is longer. A thread's lock time on a shard is its round
+// time scaled by the share of its operations that locked that shard.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    double work, span;
+    double worker[MAX_THREADS];
+    double shard_busy[NUM_SHARDS];
+    long long locked_before[NUM_SHARDS];
+} WorkClock;
+
+static void phase_start(WorkClock *c) {
+    memset(c->worker, 0, sizeof(c->worker));
+    memset(c->shard_busy, 0, sizeof(c->shard_busy));
+}
+
+static void worker_begin(WorkClock *c, ShardedCache *cache) {
+    for (int i = 0; i < NUM_SHARDS; i++) c->locked_before[i] = cache->shards[i].locked_ops;
+}
+
+static void worker_done(WorkClock *c, ShardedCache *cache, int w, clock_t t0) {
+    double t = (double)(clock() - t0) / CLOCKS_PER_SEC;
+    c->worker[w] += t;
+    for (int i = 0; i < NUM_SHARDS; i++) {
+        long long locked = cache->shards[i].locked_ops - c->locked_before[i];
+        c->shard_busy[i] += t * locked / ROUND_OPS;
+    }
+}
+
+static void phase_end(WorkClock *c, int workers) {
+    double slowest = 0;
+    for (int w = 0; w < workers; w++) {
+        c->work += c->worker[w];
+        if (c->worker[w] > slowest) slowest = c->worker[w];
+    }
+    for (int i = 0; i < NUM_SHARDS; i++) {
+        if (c->shard_busy[i] > slowest) slowest = c->shard_busy[i];
+    }
+    c->span += slowest;
+}
+
+int main() {
+    zipf_init();
+    clock_t total_start = clock();
+    long long checksum = 0;
+
+    int configs[5][2] = {
+        {POLICY_LRU, 0}, {POLICY_LRU, 1}, {POLICY_CLOCK, 0}, {POLICY_CLOCK, 1}, {POLICY_S3FIFO, 0}
+    };
+
+    for (int cfg = 0; cfg < 5; cfg++) {
+        int policy = configs[cfg][0];
+        int admission = configs[cfg][1];
+        for (int ti = 0; ti < NUM_THREAD_COUNTS; ti++) {
+            int threads = thread_counts[ti];
+            ShardedCache *cache = (ShardedCache*)malloc(sizeof(ShardedCache));
+            cache_init(cache, policy, admission);
+
+            uint64_t streams[MAX_THREADS];
+            for (int t = 0; t < threads; t++) streams[t] = 42 + 7919 * t;
+
+            // Read-through: a miss fetches and inserts the value
+            long long hits = 0;
+            WorkClock clk;
+            memset(&clk, 0, sizeof(clk));
+            for (int op = 0; op < OPS_PER_RUN; op += threads * ROUND_OPS) {
+                phase_start(&clk);
+                for (int t = 0; t < threads; t++) {
+                    worker_begin(&clk, cache);
+                    clock_t t0 = clock();
+                    for (int i = 0; i < ROUND_OPS; i++) {
+                        uint32_t key = zipf_next(&streams[t]);
+                        int value;
+                        if (cache_get(cache, key, &value)) {
+                            hits++;
+                            checksum += value;
+                        } else {
+                            cache_put(cache, key, (int)(key >> 8));
+                        }
+                    }
+                    worker_done(&clk, cache, t, t0);
+                }
+                phase_end(&clk, threads);
+            }
+
+            long long locked = 0, rejected = 0;
+            for (int i = 0; i < NUM_SHARDS; i++) {
+                locked += cache->shards[i].locked_ops;
+                rejected += cache->shards[i].rejected;
+            }
+            printf("  %-8s tinylfu=%d threads=%d  %6.2f Mops/s x%-4.1f hit rate %.4f  "
+                   "locked ops %.3f  rejected %lld\n",
+                   policy_names[policy], admission, threads,
+                   clk.span > 0 ? OPS_PER_RUN / clk.span / 1e6 : 0.0,
+                   clk.span > 0 ? clk.work / clk.span : 0.0,
+                   (double)hits / OPS_PER_RUN, (double)locked / OPS_PER_RUN, rejected);
+
+            cache_free(cache);
+            free(cache);
+        }
+    }
+
+    double time_spent = (double)(clock() - total_start) / CLOCKS_PER_SEC;
+    printf("(Mops/s over the busiest thread or shard lock, whichever is slower; xN = total thread time / that)\n");
+    printf("Sharded cache: %d shards, capacity=%d, %d ops per run, %.6f seconds\n",
+           NUM_SHARDS, CACHE_CAPACITY, OPS_PER_RUN, time_spent);
+    printf("Value checksum: %lld\n", checksum);
+
+    free(zipf_cdf);
+    return 0;
+}
@@ -0,0 +1,377 @@
+// Lane-grouped Mandelbrot/Julia renderer with adaptive tiles
+// Masked early exit, cardioid/bulb rejection, periodicity checking, dynamic tile queue
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef FULL_SIZE
+#define WIDTH 3840
+#define HEIGHT 2160
+#else
+#define WIDTH 640             // -DFULL_SIZE for the 4K run
+#define HEIGHT 360
+#endif
+#define MAX_ITER 1024
+#define LANES 8
+#define ITER_BLOCK 8          // iterations between lane-exit checks
+#define SPAN_CHUNK 256
+#define TILE_SIZE 64
+#define MIN_TILE 16
+#define NUM_WORKERS 8
+#define PERIOD_EPS 1e-13
+
+typedef struct {
+    double x_min, x_max, y_min, y_max;
+    int julia;                // 0: z0 = 0, c = pixel; 1: z0 = pixel, c = (jx, jy)
+    double jx, jy;
+} View;
+
+// ---------------------------------------------------------------------------
+// Reference scalar kernels (40_mandelbrot.c, 166_julia_set.c)
+// ---------------------------------------------------------------------------
+
+int escape_scalar(double zx, double zy, double cx, double cy) {
+    int iter = 0;
+    while (zx * zx + zy * zy < 4.0 && iter < MAX_ITER) {
+        double temp = zx * zx - zy * zy + cx;
+        zy = 2.0 * zx * zy + cy;
+        zx = temp;
+        iter++;
+    }
+    return iter;
+}
+
+static inline double pixel_x(const View *v, int px) {
+    return v->x_min + (v->x_max - v->x_min) * px / WIDTH;
+}
+
+static inline double pixel_y(const View *v, int py) {
+    return v->y_min + (v->y_max - v->y_min) * py / HEIGHT;
+}
+
+void render_scalar(const View *v, int *out) {
+    for (int py = 0; py < HEIGHT; py++) {
+        double y = pixel_y(v, py);
+        for (int px = 0; px < WIDTH; px++) {
+            double x = pixel_x(v, px);
+            out[py * WIDTH + px] = v->julia ? escape_scalar(x, y, v->jx, v->jy)
+                                            : escape_scalar(0.0, 0.0, x, y);
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Lane kernel: LANES points advance together. Every lane runs the same
+// straight-line update; finished lanes are frozen by selects rather than
+// branches. Between iteration blocks, finished lanes store their result and
+// are refilled with the next pending point, so one slow pixel does not hold
+// the whole group back.
+// ---------------------------------------------------------------------------
+
+// Main cardioid and period-2 bulb are inside the set; skip iterating them
+static inline int in_cardioid_or_bulb(double x, double y) {
+    double xq = x - 0.25;
+    double q = xq * xq + y * y;
+    if (q * (q + xq) <= 0.25 * y * y) return 1;
+    double xb = x + 1.0;
+    return xb * xb + y * y <= 0.0625;
+}
+
+void escape_stream(const double *zx0, const double *zy0, const double *cx0, const double *cy0,
+                   int n, int *out) {
+    double zx[LANES], zy[LANES], cx[LANES], cy[LANES], sx[LANES], sy[LANES];
+    int count[LANES], active[LANES], pixel[LANES], save_at[LANES];
+    int next = 0;
+    int live = 0;
+
+    for (int l = 0; l < LANES; l++) {
+        pixel[l] = next < n ? next++ : -1;
+        int p = pixel[l] >= 0 ? pixel[l] : 0;
+        zx[l] = sx[l] = pixel[l] >= 0 ? zx0[p] : 0.0;
+        zy[l] = sy[l] = pixel[l] >= 0 ? zy0[p] : 0.0;
+        cx[l] = pixel[l] >= 0 ? cx0[p] : 0.0;
+        cy[l] = pixel[l] >= 0 ? cy0[p] : 0.0;
+        count[l] = 0;
+        save_at[l] = ITER_BLOCK;
+        active[l] = pixel[l] >= 0;
+        live += active[l];
+    }
+
+    while (live > 0) {
+        for (int k = 0; k < ITER_BLOCK; k++) {
+            for (int l = 0; l < LANES; l++) {
+                double x2 = zx[l] * zx[l];
+                double y2 = zy[l] * zy[l];
+                int still = active[l] & (x2 + y2 < 4.0) & (count[l] < MAX_ITER);
+                double nx = x2 - y2 + cx[l];
+                double ny = 2.0 * zx[l] * zy[l] + cy[l];
+                zx[l] = still ? nx : zx[l];
+                zy[l] = still ? ny : zy[l];
+                count[l] += still;
+                active[l] = still;
+            }
+        }
+
+        for (int l = 0; l < LANES; l++) {
+            if (pixel[l] < 0) continue;
+            int finished = !active[l];
+            if (!finished) {
+                // Orbit returned to a saved point: it is periodic, hence bounded
+                double dx = zx[l] - sx[l];
+                double dy = zy[l] - sy[l];
+                if (dx * dx + dy * dy < PERIOD_EPS * PERIOD_EPS) {
+                    count[l] = MAX_ITER;
+                    finished = 1;
+                } else if (count[l] >= save_at[l]) {
+                    // Brent-style: move the reference point at doubling intervals
+                    sx[l] = zx[l];
+                    sy[l] = zy[l];
+                    save_at[l] *= 2;
+                }
+            }
+            if (!finished) continue;
+
+            out[pixel[l]] = count[l];
+            if (next < n) {
+                int p = next++;
+                pixel[l] = p;
+                zx[l] = sx[l] = zx0[p];
+                zy[l] = sy[l] = zy0[p];
+                cx[l] = cx0[p];
+                cy[l] = cy0[p];
+                count[l] = 0;
+                save_at[l] = ITER_BLOCK;
+                active[l] = 1;
+            } else {
+                pixel[l] = -1;
+                active[l] = 0;
+                live--;
+            }
+        }
+    }
+}
+
+// Renders pixels [x0, x0+len) of row py through the lane kernel
+static void render_span(const View *v, int x0, int py, int len, int *out) {
+    double y = pixel_y(v, py);
+    double zx[SPAN_CHUNK], zy[SPAN_CHUNK], cx[SPAN_CHUNK], cy[SPAN_CHUNK];
+    int idx[SPAN_CHUNK], res[SPAN_CHUNK];
+
+    for (int base = 0; base < len; base += SPAN_CHUNK) {
+        int n = len - base < SPAN_CHUNK ? len - base : SPAN_CHUNK;
+        int pending = 0;
+        for (int i = base; i < base + n; i++) {
+            double x = pixel_x(v, x0 + i);
+            if (!v->julia && in_cardioid_or_bulb(x, y)) {
+                out[i] = MAX_ITER;
+                continue;
+            }
+            idx[pending] = i;
+            zx[pending] = v->julia ? x : 0.0;
+            zy[pending] = v->julia ? y : 0.0;
+            cx[pending] = v->julia ? v->jx : x;
+            cy[pending] = v->julia ? v->jy : y;
+            pending++;
+        }
+        if (pending == 0) continue;
+        escape_stream(zx, zy, cx, cy, pending, res);
+        for (int i = 0; i < pending; i++) out[idx[i]] = res[i];
+    }
+}
+
+void render_lanes(const View *v, int *out) {
+    for (int py = 0; py < HEIGHT; py++) {
+        render_span(v, 0, py, WIDTH, &out[py * WIDTH]);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Tiled renderer. Tiles sit in a queue that workers drain one index at a
+// time (dynamic scheduling): each simulated worker keeps a clock of the time
+// it has spent on tiles, and the next tile goes to the worker whose clock is
+// lowest, i.e. the one that would become free first. A Mandelbrot tile whose border never escapes is
+// filled without iterating, since the set is connected with no holes;
+// otherwise it is split into quadrants that go back on the queue.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    int x0, y0, w, h;
+} Tile;
+
+typedef struct {
+    Tile *tiles;
+    int count;
+    int capacity;
+    int next;
+} TileQueue;
+
+static void queue_push(TileQueue *q, int x0, int y0, int w, int h) {
+    if (q->count == q->capacity) {
+        q->capacity = q->capacity ? q->capacity * 2 : 256;
+        q->tiles = (Tile*)realloc(q->tiles, q->capacity * sizeof(Tile));
+    }
+    Tile t = {x0, y0, w, h};
+    q->tiles[q->count++] = t;
+}
+
+typedef struct {
+    long long pixels;
+    int tiles;
+    double busy;              // simulated clock: seconds spent on claimed tiles
+} WorkerStats;
+
+static void compute_row(const View *v, int *out, unsigned char *done, int x0, int py, int w) {
+    int start = -1;
+    for (int x = x0; x <= x0 + w; x++) {
+        int need = x < x0 + w && !done[py * WIDTH + x];
+        if (need && start < 0) start = x;
+        if (!need && start >= 0) {
+            render_span(v, start, py, x - start, &out[py * WIDTH + start]);
+            memset(&done[py * WIDTH + start], 1, x - start);
+            start = -1;
+        }
+    }
+}
+
+static long long process_tile(const View *v, Tile t, int *out, unsigned char *done, TileQueue *q,
+                              int adaptive) {
+    long long pixels = (long long)t.w * t.h;
+    if (!adaptive || t.w < 2 * MIN_TILE || t.h < 2 * MIN_TILE) {
+        for (int y = t.y0; y < t.y0 + t.h; y++) compute_row(v, out, done, t.x0, y, t.w);
+        return pixels;
+    }
+
+    // Border: top and bottom rows, then left and right columns
+    compute_row(v, out, done, t.x0, t.y0, t.w);
+    compute_row(v, out, done, t.x0, t.y0 + t.h - 1, t.w);
+    for (int y = t.y0 + 1; y < t.y0 + t.h - 1; y++) {
+        compute_row(v, out, done, t.x0, y, 1);
+        compute_row(v, out, done, t.x0 + t.w - 1, y, 1);
+    }
+
+    int uniform = 1;
+    for (int x = t.x0; x < t.x0 + t.w && uniform; x++) {
+        uniform = out[t.y0 * WIDTH + x] == MAX_ITER && out[(t.y0 + t.h - 1) * WIDTH + x] == MAX_ITER;
+    }
+    for (int y = t.y0; y < t.y0 + t.h && uniform; y++) {
+        uniform = out[y * WIDTH + t.x0] == MAX_ITER && out[y * WIDTH + t.x0 + t.w - 1] == MAX_ITER;
+    }
+
+    if (uniform) {
+        for (int y = t.y0 + 1; y < t.y0 + t.h - 1; y++) {
+            for (int x = t.x0 + 1; x < t.x0 + t.w - 1; x++) {
+                out[y * WIDTH + x] = MAX_ITER;
+                done[y * WIDTH + x] = 1;
+            }
+        }
+        return pixels;
+    }
+
+    int hw = t.w / 2, hh = t.h / 2;
+    queue_push(q, t.x0, t.y0, hw, hh);
+    queue_push(q, t.x0 + hw, t.y0, t.w - hw, hh);
+    queue_push(q, t.x0, t.y0 + hh, hw, t.h - hh);
+    queue_push(q, t.x0 + hw, t.y0 + hh, t.w - hw, t.h - hh);
+    return 2LL * (t.w + t.h);
+}
+
+void render_tiled(const View *v, int *out, int adaptive, WorkerStats *stats) {
+    unsigned char *done = (unsigned char*)calloc((size_t)WIDTH * HEIGHT, 1);
+    TileQueue q = {0};
+    for (int y = 0; y < HEIGHT; y += TILE_SIZE) {
+        for (int x = 0; x < WIDTH; x += TILE_SIZE) {
+            int w = WIDTH - x < TILE_SIZE ? WIDTH - x : TILE_SIZE;
+            int h = HEIGHT - y < TILE_SIZE ? HEIGHT - y : TILE_SIZE;
+            queue_push(&q, x, y, w, h);
+        }
+    }
+    memset(stats, 0, NUM_WORKERS * sizeof(WorkerStats));
+
+    // The first worker to become free claims the next queued tile
+    while (q.next < q.count) {
+        int w = 0;
+        for (int i = 1; i < NUM_WORKERS; i++) {
+            if (stats[i].busy < stats[w].busy) w = i;
+        }
+        Tile t = q.tiles[q.next++];
+        clock_t t0 = clock();
+        stats[w].pixels += process_tile(v, t, out, done, &q, adaptive && !v->julia);
+        stats[w].busy += (double)(clock() - t0) / CLOCKS_PER_SEC;
+        stats[w].tiles++;
+    }
+
+    free(q.tiles);
+    free(done);
+}
+
+// ---------------------------------------------------------------------------
+// Benchmark
+// ---------------------------------------------------------------------------
+
+static int count_mismatches(const int *a, const int *b) {
+    int bad = 0;
+    for (int i = 0; i < WIDTH * HEIGHT; i++) bad += a[i] != b[i];
+    return bad;
+}
+
+static double mpixels(clock_t start) {
+    double t = (double)(clock() - start) / CLOCKS_PER_SEC;
+    return t > 0 ? (double)WIDTH * HEIGHT / t / 1e6 : 0.0;
+}
+
+int main() {
+    View views[2] = {
+        {-2.5, 1.0, -1.0, 1.0, 0, 0.0, 0.0},
+        {-2.0, 2.0, -1.125, 1.125, 1, -0.8, 0.156}
+    };
+    const char *names[2] = {"mandelbrot", "julia"};
+    int *ref = (int*)malloc((size_t)WIDTH * HEIGHT * sizeof(int));
+    int *img = (int*)malloc((size_t)WIDTH * HEIGHT * sizeof(int));
+    WorkerStats stats[NUM_WORKERS];
+    long long checksum = 0;
+
+    clock_t total_start = clock();
+    for (int vi = 0; vi < 2; vi++) {
+        View *v = &views[vi];
+
+        clock_t start = clock();
+        render_scalar(v, ref);
+        double scalar_rate = mpixels(start);
+
+        start = clock();
+        render_lanes(v, img);
+        double lane_rate = mpixels(start);
+        int lane_bad = count_mismatches(ref, img);
+
+        start = clock();
+        render_tiled(v, img, 1, stats);
+        double tiled_rate = mpixels(start);
+        int tiled_bad = count_mismatches(ref, img);
+
+        long long min_px = stats[0].pixels, max_px = stats[0].pixels;
+        double work = 0, span = 0;
+        for (int w = 0; w < NUM_WORKERS; w++) {
+            if (stats[w].pixels < min_px) min_px = stats[w].pixels;
+            if (stats[w].pixels > max_px) max_px = stats[w].pixels;
+            work += stats[w].busy;
+            if (stats[w].busy > span) span = stats[w].busy;
+        }
+        for (int i = 0; i < WIDTH * HEIGHT; i++) checksum += img[i];
+
+        printf("  %-10s scalar %7.2f  lanes %7.2f  tiled %7.2f Mpixel/s\n",
+               names[vi], scalar_rate, lane_rate, tiled_rate);
+        printf("  %-10s mismatches lanes=%d tiled=%d, worker pixel spread %lld..%lld, x%.1f\n",
+               names[vi], lane_bad, tiled_bad, min_px, max_px, span > 0 ? work / span : 0.0);
+    }
+
+    double time_spent = (double)(clock() - total_start) / CLOCKS_PER_SEC;
+    printf("(xN = tile time of all %d simulated workers / the busiest one)\n", NUM_WORKERS);
+    printf("Tiled fractal renderer %dx%d, max_iter=%d: %.6f seconds\n",
+           WIDTH, HEIGHT, MAX_ITER, time_spent);
+    printf("Iteration checksum: %lld\n", checksum);
+
+    free(ref);
+    free(img);
+    return 0;
+}
@@ -0,0 +1,744 @@
+// Bit-parallel Game of Life engine with HashLife mode
+// 64 cells per word via bit-sliced adders, striped update with halo rows, memoized quadtree
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#define REF_SIZE 200          // 113_game_of_life.c grid
+#define REF_GENERATIONS 100
+#ifdef FULL_SIZE
+#define GRID_DIM 4096         // 16384 / 65536 for the large sweep (65536^2 needs 2 x 512 MB)
+#define CHECK_DIM 2048
+#else
+#define GRID_DIM 2048         // -DFULL_SIZE for 4096
+#define CHECK_DIM 1024        // soup growth over 512 generations stays well inside
+#endif
+#define BENCH_GENERATIONS 64
+#define NUM_STRIPES 8         // simulated workers, one horizontal stripe each
+#define SOUP_SIZE 64
+#define CHECK_GENERATIONS 512 // 2^9, advanced in a single HashLife step
+#define HASHLIFE_LOG_GENS 16  // long-run HashLife: 2^16 generations
+#define INITIAL_BUCKETS (1 << 16)
+
+// ---------------------------------------------------------------------------
+// Reference engine (113_game_of_life.c)
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    int cells[REF_SIZE][REF_SIZE];
+    int width;
+    int height;
+} Grid;
+
+int get_cell(Grid *g, int x, int y) {
+    if (x < 0 || x >= g->width || y < 0 || y >= g->height) {
+        return 0;
+    }
+    return g->cells[y][x];
+}
+
+int count_neighbors(Grid *g, int x, int y) {
+    int count = 0;
+    for (int dy = -1; dy <= 1; dy++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            if (dx == 0 && dy == 0) continue;
+            count += get_cell(g, x + dx, y + dy);
+        }
+    }
+    return count;
+}
+
+void ref_step(Grid *current, Grid *next) {
+    for (int y = 0; y < current->height; y++) {
+        for (int x = 0; x < current->width; x++) {
+            int neighbors = count_neighbors(current, x, y);
+            if (get_cell(current, x, y)) {
+                next->cells[y][x] = (neighbors == 2 || neighbors == 3) ? 1 : 0;
+            } else {
+                next->cells[y][x] = (neighbors == 3) ? 1 : 0;
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Bit-packed grid: bit i of word j in a row is cell x = 64 * j + i.
+// Cells outside the grid are dead; tail bits of the last word stay clear.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    uint64_t *words;
+    int width;
+    int height;
+    int row_words;
+    uint64_t tail_mask;
+} BitGrid;
+
+void bitgrid_init(BitGrid *g, int width, int height) {
+    g->width = width;
+    g->height = height;
+    g->row_words = (width + 63) / 64;
+    g->tail_mask = (width % 64) ? ((1ULL << (width % 64)) - 1) : ~0ULL;
+    g->words = (uint64_t *)calloc((size_t)g->row_words * height, sizeof(uint64_t));
+}
+
+void bitgrid_free(BitGrid *g) {
+    free(g->words);
+}
+
+static inline uint64_t *bitgrid_row(const BitGrid *g, int y) {
+    return g->words + (size_t)y * g->row_words;
+}
+
+static inline int bitgrid_get(const BitGrid *g, int x, int y) {
+    if (x < 0 || x >= g->width || y < 0 || y >= g->height) return 0;
+    return (int)((bitgrid_row(g, y)[x >> 6] >> (x & 63)) & 1);
+}
+
+static inline void bitgrid_set(BitGrid *g, int x, int y) {
+    if (x < 0 || x >= g->width || y < 0 || y >= g->height) return;
+    bitgrid_row(g, y)[x >> 6] |= 1ULL << (x & 63);
+}
+
+long long bitgrid_population(const BitGrid *g) {
+    long long count = 0;
+    size_t total = (size_t)g->row_words * g->height;
+    for (size_t i = 0; i < total; i++) {
+        count += __builtin_popcountll(g->words[i]);
+    }
+    return count;
+}
+
+static inline void full_add(uint64_t a, uint64_t b, uint64_t c, uint64_t *sum, uint64_t *carry) {
+    uint64_t t = a ^ b;
+    *sum = t ^ c;
+    *carry = (a & b) | (t & c);
+}
+
+// Next state of 64 cells from the three rows above, at and below them.
+// The eight neighbour masks are summed into a 3-bit count (8 wraps to 0,
+// which is dead either way); alive next iff count is 3, or 2 and alive now.
+static inline uint64_t life_word(const uint64_t *up, const uint64_t *mid, const uint64_t *down,
+                                 int j, int row_words) {
+    uint64_t u = up[j], m = mid[j], d = down[j];
+    uint64_t ul = 0, ml = 0, dl = 0, ur = 0, mr = 0, dr = 0;
+    if (j > 0) {
+        ul = up[j - 1] >> 63;
+        ml = mid[j - 1] >> 63;
+        dl = down[j - 1] >> 63;
+    }
+    if (j + 1 < row_words) {
+        ur = up[j + 1] << 63;
+        mr = mid[j + 1] << 63;
+        dr = down[j + 1] << 63;
+    }
+    uint64_t n0 = (u << 1) | ul, n1 = u, n2 = (u >> 1) | ur;
+    uint64_t n3 = (m << 1) | ml, n4 = (m >> 1) | mr;
+    uint64_t n5 = (d << 1) | dl, n6 = d, n7 = (d >> 1) | dr;
+
+    uint64_t sa, ca, sb, cb, s0, cd, t0, tc;
+    full_add(n0, n1, n2, &sa, &ca);
+    full_add(n3, n4, n5, &sb, &cb);
+    uint64_t sc = n6 ^ n7, cc = n6 & n7;
+    full_add(sa, sb, sc, &s0, &cd);
+    full_add(ca, cb, cc, &t0, &tc);
+    uint64_t s1 = t0 ^ cd;
+    uint64_t s2 = tc ^ (t0 & cd);
+    return s1 & ~s2 & (s0 | m);
+}
+
+// Rows [y0, y1) of dst from src; up/down rows outside the grid read as zero_row.
+void bitgrid_step_rows(const BitGrid *src, BitGrid *dst, int y0, int y1, const uint64_t *zero_row) {
+    int rw = src->row_words;
+    for (int y = y0; y < y1; y++) {
+        const uint64_t *up = y > 0 ? bitgrid_row(src, y - 1) : zero_row;
+        const uint64_t *mid = bitgrid_row(src, y);
+        const uint64_t *down = y + 1 < src->height ? bitgrid_row(src, y + 1) : zero_row;
+        uint64_t *out = bitgrid_row(dst, y);
+        for (int j = 0; j < rw; j++) {
+            out[j] = life_word(up, mid, down, j, rw);
+        }
+        out[rw - 1] &= src->tail_mask;
+    }
+}
+
+void bitgrid_step(const BitGrid *src, BitGrid *dst, const uint64_t *zero_row) {
+    bitgrid_step_rows(src, dst, 0, src->height, zero_row);
+}
+
+// ---------------------------------------------------------------------------
+// Striped update: each worker owns a private slab of rows plus one halo row
+// above and below, refreshed from the neighbouring stripes every generation.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    int y0, y1;               // owned rows in global coordinates
+    int rows;
+    uint64_t *cur;            // (rows + 2) * row_words, halo rows at 0 and rows + 1
+    uint64_t *next;
+} Stripe;
+
+typedef struct {
+    Stripe stripes[NUM_STRIPES];
+    int num_stripes;
+    int row_words;
+    int height;
+    uint64_t tail_mask;
+    long long halo_words_moved;
+} StripedLife;
+
+void striped_init(StripedLife *s, const BitGrid *g) {
+    s->num_stripes = NUM_STRIPES < g->height ? NUM_STRIPES : g->height;
+    s->row_words = g->row_words;
+    s->height = g->height;
+    s->tail_mask = g->tail_mask;
+    s->halo_words_moved = 0;
+    for (int i = 0; i < s->num_stripes; i++) {
+        Stripe *st = &s->stripes[i];
+        st->y0 = (int)((long long)g->height * i / s->num_stripes);
+        st->y1 = (int)((long long)g->height * (i + 1) / s->num_stripes);
+        st->rows = st->y1 - st->y0;
+        size_t words = (size_t)(st->rows + 2) * s->row_words;
+        st->cur = (uint64_t *)calloc(words, sizeof(uint64_t));
+        st->next = (uint64_t *)calloc(words, sizeof(uint64_t));
+        memcpy(st->cur + s->row_words, bitgrid_row(g, st->y0),
+               (size_t)st->rows * s->row_words * sizeof(uint64_t));
+    }
+}
+
+void striped_free(StripedLife *s) {
+    for (int i = 0; i < s->num_stripes; i++) {
+        free(s->stripes[i].cur);
+        free(s->stripes[i].next);
+    }
+}
+
+// Copy each stripe's boundary rows into its neighbours' halos; grid edges stay zero.
+void striped_exchange_halos(StripedLife *s) {
+    int rw = s->row_words;
+    size_t row_bytes = (size_t)rw * sizeof(uint64_t);
+    for (int i = 0; i < s->num_stripes; i++) {
+        Stripe *st = &s->stripes[i];
+        if (i > 0) {
+            Stripe *above = &s->stripes[i - 1];
+            memcpy(st->cur, above->cur + (size_t)above->rows * rw, row_bytes);
+            s->halo_words_moved += rw;
+        }
+        if (i + 1 < s->num_stripes) {
+            Stripe *below = &s->stripes[i + 1];
+            memcpy(st->cur + (size_t)(st->rows + 1) * rw, below->cur + rw, row_bytes);
+            s->halo_words_moved += rw;
+        }
+    }
+}
+
+void striped_step_stripe(StripedLife *s, Stripe *st) {
+    int rw = s->row_words;
+    for (int r = 1; r <= st->rows; r++) {
+        const uint64_t *up = st->cur + (size_t)(r - 1) * rw;
+        const uint64_t *mid = st->cur + (size_t)r * rw;
+        const uint64_t *down = st->cur + (size_t)(r + 1) * rw;
+        uint64_t *out = st->next + (size_t)r * rw;
+        for (int j = 0; j < rw; j++) {
+            out[j] = life_word(up, mid, down, j, rw);
+        }
+        out[rw - 1] &= s->tail_mask;
+    }
+    uint64_t *tmp = st->cur;
+    st->cur = st->next;
+    st->next = tmp;
+}
+
+void striped_run(StripedLife *s, int generations) {
+    for (int gen = 0; gen < generations; gen++) {
+        striped_exchange_halos(s);
+        // Barrier: every worker has read its halos before anyone writes.
+        for (int w = 0; w < s->num_stripes; w++) {
+            striped_step_stripe(s, &s->stripes[w]);
+        }
+    }
+}
+
+void striped_gather(const StripedLife *s, BitGrid *g) {
+    for (int i = 0; i < s->num_stripes; i++) {
+        const Stripe *st = &s->stripes[i];
+        memcpy(bitgrid_row(g, st->y0), st->cur + s->row_words,
+               (size_t)st->rows * s->row_words * sizeof(uint64_t));
+    }
+}
+
+// ---------------------------------------------------------------------------
+// HashLife: hash-consed quadtree nodes with a memoized successor.
+// A level-k node covers 2^k x 2^k cells; its result is the centred
+// level-(k-1) square advanced 2^min(step, k-2) generations.
+// ---------------------------------------------------------------------------
+
+typedef struct HNode {
+    struct HNode *nw, *ne, *sw, *se;
+    struct HNode *result;
+    struct HNode *hash_next;
+    long long population;
+    int level;
+} HNode;
+
+#define NODE_BLOCK 4096
+
+typedef struct NodeBlock {
+    HNode nodes[NODE_BLOCK];
+    struct NodeBlock *next;
+} NodeBlock;
+
+typedef struct {
+    HNode **buckets;
+    size_t bucket_count;
+    size_t node_count;
+    NodeBlock *blocks;
+    int block_used;
+    HNode *leaf[2];
+    HNode *empty[64];
+    int step_log;
+    long long cache_hits;
+    long long cache_misses;
+} HashLife;
+
+static inline size_t node_hash(const HNode *nw, const HNode *ne, const HNode *sw, const HNode *se) {
+    uint64_t h = (uint64_t)(uintptr_t)nw;
+    h = h * 0x9e3779b97f4a7c15ULL ^ (uint64_t)(uintptr_t)ne;
+    h = h * 0x9e3779b97f4a7c15ULL ^ (uint64_t)(uintptr_t)sw;
+    h = h * 0x9e3779b97f4a7c15ULL ^ (uint64_t)(uintptr_t)se;
+    return (size_t)(h ^ (h >> 29));
+}
+
+static HNode *hl_alloc(HashLife *hl) {
+    if (!hl->blocks || hl->block_used == NODE_BLOCK) {
+        NodeBlock *b = (NodeBlock *)malloc(sizeof(NodeBlock));
+        b->next = hl->blocks;
+        hl->blocks = b;
+        hl->block_used = 0;
+    }
+    HNode *n = &hl->blocks->nodes[hl->block_used++];
+    memset(n, 0, sizeof(HNode));
+    return n;
+}
+
+static void hl_rehash(HashLife *hl) {
+    size_t new_count = hl->bucket_count * 2;
+    HNode **nb = (HNode **)calloc(new_count, sizeof(HNode *));
+    for (size_t i = 0; i < hl->bucket_count; i++) {
+        HNode *n = hl->buckets[i];
+        while (n) {
+            HNode *next = n->hash_next;
+            size_t b = node_hash(n->nw, n->ne, n->sw, n->se) & (new_count - 1);
+            n->hash_next = nb[b];
+            nb[b] = n;
+            n = next;
+        }
+    }
+    free(hl->buckets);
+    hl->buckets = nb;
+    hl->bucket_count = new_count;
+}
+
+HNode *hl_join(HashLife *hl, HNode *nw, HNode *ne, HNode *sw, HNode *se) {
+    size_t b = node_hash(nw, ne, sw, se) & (hl->bucket_count - 1);
+    for (HNode *n = hl->buckets[b]; n; n = n->hash_next) {
+        if (n->nw == nw && n->ne == ne && n->sw == sw && n->se == se) return n;
+    }
+    HNode *n = hl_alloc(hl);
+    n->nw = nw;
+    n->ne = ne;
+    n->sw = sw;
+    n->se = se;
+    n->level = nw->level + 1;
+    n->population = nw->population + ne->population + sw->population + se->population;
+    n->hash_next = hl->buckets[b];
+    hl->buckets[b] = n;
+    if (++hl->node_count > hl->bucket_count) hl_rehash(hl);
+    return n;
+}
+
+void hl_init(HashLife *hl, int step_log) {
+    memset(hl, 0, sizeof(HashLife));
+    hl->bucket_count = INITIAL_BUCKETS;
+    hl->buckets = (HNode **)calloc(hl->bucket_count, sizeof(HNode *));
+    hl->step_log = step_log;
+    for (int v = 0; v < 2; v++) {
+        hl->leaf[v] = hl_alloc(hl);
+        hl->leaf[v]->population = v;
+    }
+    hl->empty[0] = hl->leaf[0];
+    for (int k = 1; k < 64; k++) {
+        HNode *e = hl->empty[k - 1];
+        hl->empty[k] = hl_join(hl, e, e, e, e);
+    }
+}
+
+void hl_free(HashLife *hl) {
+    while (hl->blocks) {
+        NodeBlock *next = hl->blocks->next;
+        free(hl->blocks);
+        hl->blocks = next;
+    }
+    free(hl->buckets);
+}
+
+// Results depend on the step size, so changing it drops every memo.
+void hl_set_step(HashLife *hl, int step_log) {
+    if (step_log == hl->step_log) return;
+    hl->step_log = step_log;
+    for (NodeBlock *b = hl->blocks; b; b = b->next) {
+        int used = b == hl->blocks ? hl->block_used : NODE_BLOCK;
+        for (int i = 0; i < used; i++) b->nodes[i].result = NULL;
+    }
+}
+
+static inline HNode *hl_centre(HashLife *hl, HNode *n) {
+    return hl_join(hl, n->nw->se, n->ne->sw, n->sw->ne, n->se->nw);
+}
+
+static inline HNode *hl_horizontal(HashLife *hl, HNode *w, HNode *e) {
+    return hl_join(hl, w->ne, e->nw, w->se, e->sw);
+}
+
+static inline HNode *hl_vertical(HashLife *hl, HNode *n, HNode *s) {
+    return hl_join(hl, n->sw, n->se, s->nw, s->ne);
+}
+
+HNode *hl_expand(HashLife *hl, HNode *n) {
+    HNode *e = hl->empty[n->level - 1];
+    return hl_join(hl, hl_join(hl, e, e, e, n->nw), hl_join(hl, e, e, n->ne, e),
+                   hl_join(hl, e, n->sw, e, e), hl_join(hl, n->se, e, e, e));
+}
+
+// Level-2 base case: one generation of the 4x4 block's inner 2x2.
+static HNode *hl_base_step(HashLife *hl, HNode *n) {
+    int cell[4][4];
+    HNode *quad[2][2] = {{n->nw, n->ne}, {n->sw, n->se}};
+    for (int qy = 0; qy < 2; qy++) {
+        for (int qx = 0; qx < 2; qx++) {
+            HNode *q = quad[qy][qx];
+            cell[qy * 2][qx * 2] = (int)q->nw->population;
+            cell[qy * 2][qx * 2 + 1] = (int)q->ne->population;
+            cell[qy * 2 + 1][qx * 2] = (int)q->sw->population;
+            cell[qy * 2 + 1][qx * 2 + 1] = (int)q->se->population;
+        }
+    }
+    HNode *out[2][2];
+    for (int y = 1; y <= 2; y++) {
+        for (int x = 1; x <= 2; x++) {
+            int sum = 0;
+            for (int dy = -1; dy <= 1; dy++) {
+                for (int dx = -1; dx <= 1; dx++) {
+                    if (dx || dy) sum += cell[y + dy][x + dx];
+                }
+            }
+            int alive = sum == 3 || (sum == 2 && cell[y][x]);
+            out[y - 1][x - 1] = hl->leaf[alive];
+        }
+    }
+    return hl_join(hl, out[0][0], out[0][1], out[1][0], out[1][1]);
+}
+
+HNode *hl_successor(HashLife *hl, HNode *n) {
+    if (n->result) {
+        hl->cache_hits++;
+        return n->result;
+    }
+    hl->cache_misses++;
+    HNode *result;
+    if (n->population == 0) {
+        result = hl->empty[n->level - 1];
+    } else if (n->level == 2) {
+        result = hl_base_step(hl, n);
+    } else {
+        HNode *c00 = n->nw, *c02 = n->ne, *c20 = n->sw, *c22 = n->se;
+        HNode *c01 = hl_horizontal(hl, n->nw, n->ne);
+        HNode *c10 = hl_vertical(hl, n->nw, n->sw);
+        HNode *c11 = hl_centre(hl, n);
+        HNode *c12 = hl_vertical(hl, n->ne, n->se);
+        HNode *c21 = hl_horizontal(hl, n->sw, n->se);
+        if (hl->step_log >= n->level - 2) {
+            // Full speed: two half-steps of 2^(k-3) generations each.
+            HNode *r00 = hl_successor(hl, c00), *r01 = hl_successor(hl, c01), *r02 = hl_successor(hl, c02);
+            HNode *r10 = hl_successor(hl, c10), *r11 = hl_successor(hl, c11), *r12 = hl_successor(hl, c12);
+            HNode *r20 = hl_successor(hl, c20), *r21 = hl_successor(hl, c21), *r22 = hl_successor(hl, c22);
+            result = hl_join(hl,
+                             hl_successor(hl, hl_join(hl, r00, r01, r10, r11)),
+                             hl_successor(hl, hl_join(hl, r01, r02, r11, r12)),
+                             hl_successor(hl, hl_join(hl, r10, r11, r20, r21)),
+                             hl_successor(hl, hl_join(hl, r11, r12, r21, r22)));
+        } else {
+            // Slow mode: recentre without advancing, then one step of 2^step_log.
+            HNode *r00 = hl_centre(hl, c00), *r01 = hl_centre(hl, c01), *r02 = hl_centre(hl, c02);
+            HNode *r10 = hl_centre(hl, c10), *r11 = hl_centre(hl, c11), *r12 = hl_centre(hl, c12);
+            HNode *r20 = hl_centre(hl, c20), *r21 = hl_centre(hl, c21), *r22 = hl_centre(hl, c22);
+            result = hl_join(hl,
+                             hl_successor(hl, hl_join(hl, r00, r01, r10, r11)),
+                             hl_successor(hl, hl_join(hl, r01, r02, r11, r12)),
+                             hl_successor(hl, hl_join(hl, r10, r11, r20, r21)),
+                             hl_successor(hl, hl_join(hl, r11, r12, r21, r22)));
+        }
+    }
+    n->result = result;
+    return result;
+}
+
+typedef struct {
+    HNode *root;
+    long long origin_x;       // world coordinates of the root's top-left cell
+    long long origin_y;
+    long long generation;
+} Universe;
+
+static HNode *hl_build(HashLife *hl, const BitGrid *g, int x0, int y0, int level) {
+    if (x0 >= g->width || y0 >= g->height) return hl->empty[level];
+    if (level == 0) return hl->leaf[bitgrid_get(g, x0, y0)];
+    int half = 1 << (level - 1);
+    if (level == 6) {
+        // Level-6 squares are word-aligned: skip empty 64x64 blocks by word.
+        int any = 0;
+        for (int y = y0; y < y0 + 64 && y < g->height && !any; y++) {
+            any = bitgrid_row(g, y)[x0 >> 6] != 0;
+        }
+        if (!any) return hl->empty[level];
+    }
+    return hl_join(hl, hl_build(hl, g, x0, y0, level - 1), hl_build(hl, g, x0 + half, y0, level - 1),
+                   hl_build(hl, g, x0, y0 + half, level - 1),
+                   hl_build(hl, g, x0 + half, y0 + half, level - 1));
+}
+
+void universe_from_grid(Universe *u, HashLife *hl, const BitGrid *g) {
+    int level = 3;
+    while ((1 << level) < g->width || (1 << level) < g->height) level++;
+    u->root = hl_build(hl, g, 0, 0, level);
+    u->origin_x = 0;
+    u->origin_y = 0;
+    u->generation = 0;
+}
+
+// Pad with empty space so the advanced pattern stays inside the result square.
+void universe_advance(Universe *u, HashLife *hl, int step_log) {
+    hl_set_step(hl, step_log);
+    while (u->root->level < step_log + 3) {
+        long long half = 1LL << (u->root->level - 1);
+        u->root = hl_expand(hl, u->root);
+        u->origin_x -= half;
+        u->origin_y -= half;
+    }
+    for (int pad = 0; pad < 2; pad++) {
+        long long half = 1LL << (u->root->level - 1);
+        u->root = hl_expand(hl, u->root);
+        u->origin_x -= half;
+        u->origin_y -= half;
+    }
+    long long quarter = 1LL << (u->root->level - 2);
+    u->root = hl_successor(hl, u->root);
+    u->origin_x += quarter;
+    u->origin_y += quarter;
+    u->generation += 1LL << step_log;
+    // Crop empty borders so the root tracks the live region.
+    while (u->root->level > 3) {
+        HNode *c = hl_centre(hl, u->root);
+        if (c->population != u->root->population) break;
+        long long q = 1LL << (u->root->level - 2);
+        u->root = c;
+        u->origin_x += q;
+        u->origin_y += q;
+    }
+}
+
+static void hl_paint(const HNode *n, long long x0, long long y0, BitGrid *g) {
+    if (n->population == 0) return;
+    if (x0 >= g->width || y0 >= g->height) return;
+    long long size = 1LL << n->level;
+    if (x0 + size <= 0 || y0 + size <= 0) return;
+    if (n->level == 0) {
+        bitgrid_set(g, (int)x0, (int)y0);
+        return;
+    }
+    long long half = size / 2;
+    hl_paint(n->nw, x0, y0, g);
+    hl_paint(n->ne, x0 + half, y0, g);
+    hl_paint(n->sw, x0, y0 + half, g);
+    hl_paint(n->se, x0 + half, y0 + half, g);
+}
+
+// ---------------------------------------------------------------------------
+// Patterns and checks
+// ---------------------------------------------------------------------------
+
+void random_fill(BitGrid *g, int x0, int y0, int w, int h, unsigned int seed) {
+    for (int y = y0; y < y0 + h; y++) {
+        for (int x = x0; x < x0 + w; x++) {
+            seed = seed * 1103515245 + 12345;
+            if ((seed % 100) < 30) bitgrid_set(g, x, y);  // 30% alive
+        }
+    }
+}
+
+long long grid_mismatches(const BitGrid *a, const BitGrid *b) {
+    long long diff = 0;
+    size_t total = (size_t)a->row_words * a->height;
+    for (size_t i = 0; i < total; i++) {
+        diff += __builtin_popcountll(a->words[i] ^ b->words[i]);
+    }
+    return diff;
+}
+
+int check_against_reference(void) {
+    static Grid ref[2];
+    BitGrid bits[2];
+    ref[0].width = ref[0].height = ref[1].width = ref[1].height = REF_SIZE;
+    memset(ref[0].cells, 0, sizeof(ref[0].cells));
+    bitgrid_init(&bits[0], REF_SIZE, REF_SIZE);
+    bitgrid_init(&bits[1], REF_SIZE, REF_SIZE);
+    uint64_t *zero_row = (uint64_t *)calloc(bits[0].row_words, sizeof(uint64_t));
+
+    unsigned int seed = 42;
+    for (int y = 0; y < REF_SIZE; y++) {
+        for (int x = 0; x < REF_SIZE; x++) {
+            seed = seed * 1103515245 + 12345;
+            ref[0].cells[y][x] = (seed % 100) < 30 ? 1 : 0;
+            if (ref[0].cells[y][x]) bitgrid_set(&bits[0], x, y);
+        }
+    }
+
+    int mismatches = 0;
+    int cur = 0;
+    double ref_time = 0, bit_time = 0;
+    for (int gen = 0; gen < REF_GENERATIONS; gen++) {
+        clock_t t0 = clock();
+        ref_step(&ref[cur], &ref[cur ^ 1]);
+        clock_t t1 = clock();
+        bitgrid_step(&bits[cur], &bits[cur ^ 1], zero_row);
+        clock_t t2 = clock();
+        ref_time += (double)(t1 - t0) / CLOCKS_PER_SEC;
+        bit_time += (double)(t2 - t1) / CLOCKS_PER_SEC;
+        cur ^= 1;
+        for (int y = 0; y < REF_SIZE; y++) {
+            for (int x = 0; x < REF_SIZE; x++) {
+                if (ref[cur].cells[y][x] != bitgrid_get(&bits[cur], x, y)) mismatches++;
+            }
+        }
+    }
+    printf("Reference check: %dx%d, %d generations, population %lld, mismatches %d\n",
+           REF_SIZE, REF_SIZE, REF_GENERATIONS, bitgrid_population(&bits[cur]), mismatches);
+    double updates = (double)REF_SIZE * REF_SIZE * REF_GENERATIONS;
+    printf("  int grid: %.3e cell-updates/s, bit-packed: %.3e cell-updates/s\n",
+           ref_time > 0 ? updates / ref_time : 0.0, bit_time > 0 ? updates / bit_time : 0.0);
+    free(zero_row);
+    bitgrid_free(&bits[0]);
+    bitgrid_free(&bits[1]);
+    return mismatches;
+}
+
+// A soup in the middle of a large grid never reaches the edges within
+// CHECK_GENERATIONS, so the bounded and infinite-plane answers agree.
+long long check_hashlife(void) {
+    BitGrid g[2], painted;
+    bitgrid_init(&g[0], CHECK_DIM, CHECK_DIM);
+    bitgrid_init(&g[1], CHECK_DIM, CHECK_DIM);
+    bitgrid_init(&painted, CHECK_DIM, CHECK_DIM);
+    int off = (CHECK_DIM - SOUP_SIZE) / 2;
+    random_fill(&g[0], off, off, SOUP_SIZE, SOUP_SIZE, 7);
+
+    HashLife hl;
+    int step_log = 0;
+    while ((1 << step_log) < CHECK_GENERATIONS) step_log++;
+    hl_init(&hl, step_log);
+    Universe u;
+    universe_from_grid(&u, &hl, &g[0]);
+    universe_advance(&u, &hl, step_log);
+    hl_paint(u.root, u.origin_x, u.origin_y, &painted);
+
+    uint64_t *zero_row = (uint64_t *)calloc(g[0].row_words, sizeof(uint64_t));
+    int cur = 0;
+    for (int gen = 0; gen < CHECK_GENERATIONS; gen++) {
+        bitgrid_step(&g[cur], &g[cur ^ 1], zero_row);
+        cur ^= 1;
+    }
+    long long mismatches = grid_mismatches(&g[cur], &painted);
+    printf("HashLife check: %d-cell soup, %d generations, population %lld/%lld, mismatches %lld\n",
+           SOUP_SIZE, CHECK_GENERATIONS, u.root->population, bitgrid_population(&g[cur]), mismatches);
+
+    free(zero_row);
+    hl_free(&hl);
+    bitgrid_free(&g[0]);
+    bitgrid_free(&g[1]);
+    bitgrid_free(&painted);
+    return mismatches;
+}
+
+int main() {
+    int ref_mismatches = check_against_reference();
+    long long hl_mismatches = check_hashlife();
+
+    // Dense soup across the whole grid: single-pass vs striped engine
+    BitGrid g[2], gathered;
+    bitgrid_init(&g[0], GRID_DIM, GRID_DIM);
+    bitgrid_init(&g[1], GRID_DIM, GRID_DIM);
+    bitgrid_init(&gathered, GRID_DIM, GRID_DIM);
+    random_fill(&g[0], 0, 0, GRID_DIM, GRID_DIM, 42);
+    long long initial_alive = bitgrid_population(&g[0]);
+    uint64_t *zero_row = (uint64_t *)calloc(g[0].row_words, sizeof(uint64_t));
+
+    StripedLife striped;
+    striped_init(&striped, &g[0]);
+
+    clock_t start = clock();
+    int cur = 0;
+    for (int gen = 0; gen < BENCH_GENERATIONS; gen++) {
+        bitgrid_step(&g[cur], &g[cur ^ 1], zero_row);
+        cur ^= 1;
+    }
+    clock_t end = clock();
+    double bit_time = (double)(end - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    striped_run(&striped, BENCH_GENERATIONS);
+    end = clock();
+    double striped_time = (double)(end - start) / CLOCKS_PER_SEC;
+    striped_gather(&striped, &gathered);
+    long long stripe_mismatches = grid_mismatches(&g[cur], &gathered);
+
+    double cell_updates = (double)GRID_DIM * GRID_DIM * BENCH_GENERATIONS;
+    printf("Bit-sliced: %dx%d grid, %d generations, %.3e cell-updates/s, %.6f seconds\n",
+           GRID_DIM, GRID_DIM, BENCH_GENERATIONS, cell_updates / bit_time, bit_time);
+    printf("Striped (%d workers): %.3e cell-updates/s, %lld halo words, mismatches %lld, %.6f seconds\n",
+           striped.num_stripes, cell_updates / striped_time, striped.halo_words_moved,
+           stripe_mismatches, striped_time);
+    printf("Initial alive: %lld, Final alive: %lld\n", initial_alive, bitgrid_population(&g[cur]));
+
+    // Sparse soup, long horizon: HashLife advances 2^HASHLIFE_LOG_GENS in one step
+    BitGrid soup;
+    bitgrid_init(&soup, SOUP_SIZE, SOUP_SIZE);
+    random_fill(&soup, 0, 0, SOUP_SIZE, SOUP_SIZE, 7);
+    HashLife hl;
+    hl_init(&hl, HASHLIFE_LOG_GENS);
+    Universe u;
+    universe_from_grid(&u, &hl, &soup);
+
+    start = clock();
+    universe_advance(&u, &hl, HASHLIFE_LOG_GENS);
+    end = clock();
+    double hl_time = (double)(end - start) / CLOCKS_PER_SEC;
+    double side = (double)(1LL << u.root->level);
+    double hl_updates = side * side * (double)u.generation;
+    printf("HashLife: %lld generations, root level %d, population %lld, %zu nodes, "
+           "%.3e effective cell-updates/s, %.6f seconds\n",
+           u.generation, u.root->level, u.root->population, hl.node_count,
+           hl_time > 0 ? hl_updates / hl_time : 0.0, hl_time);
+    printf("Mismatches: reference %d, hashlife %lld, striped %lld\n",
+           ref_mismatches, hl_mismatches, stripe_mismatches);
+
+    hl_free(&hl);
+    bitgrid_free(&soup);
+    striped_free(&striped);
+    free(zero_row);
+    bitgrid_free(&g[0]);
+    bitgrid_free(&g[1]);
+    bitgrid_free(&gathered);
+    return 0;
+}
@@ -0,0 +1,607 @@
+// Temporal-blocked 5-point stencil engine for heat, wave and Laplace solvers
+// Spatial tiles, skewed time tiles run as a wavefront over workers, red-black Gauss-Seidel
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#ifdef FULL_SIZE
+#define NUM_SIZES 3           // raise to 5 to include 4096 and 8192
+#define UPDATES_PER_RUN (1 << 25)
+#define LAPLACE_SIZE 64
+#else
+#define NUM_SIZES 3           // -DFULL_SIZE for 256..2048 grids and 16x the updates
+#define UPDATES_PER_RUN (1 << 21)
+#define LAPLACE_SIZE 48
+#endif
+#define TILE_Y 32
+#define TILE_X 256
+#define T_BLOCK 8             // timesteps fused per skewed tile
+#define NUM_WORKERS 8
+#define ALPHA 0.1
+#define WAVE_R 0.4            // c * dt / dx, stable below 1/sqrt(2)
+#define LAPLACE_TOLERANCE 1e-8
+#define LAPLACE_MAX_ITER 20000
+#define DENSE_SIDE 16         // 61_gauss_seidel.c system: 16x16 interior = 256 unknowns
+#define DENSE_MAX_ITER 2000
+#define DENSE_TOLERANCE 1e-10
+
+#ifdef FULL_SIZE
+static const int grid_sizes[] = {256, 1024, 2048, 4096, 8192};
+#else
+static const int grid_sizes[] = {128, 256, 512};
+#endif
+
+// ---------------------------------------------------------------------------
+// Reference kernels (47_heat_diffusion.c, 167_wave_equation.c in 2D,
+// 168_laplace_equation.c, 61_gauss_seidel.c)
+// ---------------------------------------------------------------------------
+
+void heat_diffusion_step(double *T, double *T_new, int n, double alpha) {
+    for (int i = 1; i < n - 1; i++) {
+        for (int j = 1; j < n - 1; j++) {
+            T_new[i * n + j] = T[i * n + j] + alpha * (
+                T[(i-1) * n + j] + T[(i+1) * n + j] +
+                T[i * n + (j-1)] + T[i * n + (j+1)] -
+                4.0 * T[i * n + j]
+            );
+        }
+    }
+
+    // Copy boundaries
+    for (int i = 0; i < n; i++) {
+        T_new[i] = T[i];
+        T_new[(n-1) * n + i] = T[(n-1) * n + i];
+        T_new[i * n] = T[i * n];
+        T_new[i * n + (n-1)] = T[i * n + (n-1)];
+    }
+}
+
+void wave_step_2d(double *u, double *u_prev, double *u_next, int n, double r) {
+    double r_sq = r * r;
+    for (int i = 1; i < n - 1; i++) {
+        for (int j = 1; j < n - 1; j++) {
+            int k = i * n + j;
+            u_next[k] = 2.0 * u[k] - u_prev[k] +
+                        r_sq * (u[k - n] + u[k + n] + u[k - 1] + u[k + 1] - 4.0 * u[k]);
+        }
+    }
+}
+
+double gauss_seidel_iteration(double **grid, int n) {
+    double max_change = 0.0;
+
+    for (int i = 1; i < n - 1; i++) {
+        for (int j = 1; j < n - 1; j++) {
+            double old_value = grid[i][j];
+
+            grid[i][j] = 0.25 * (grid[i - 1][j] + grid[i + 1][j] +
+                                 grid[i][j - 1] + grid[i][j + 1]);
+
+            double change = fabs(grid[i][j] - old_value);
+            if (change > max_change) {
+                max_change = change;
+            }
+        }
+    }
+
+    return max_change;
+}
+
+int gauss_seidel_dense(double *A, double *b, double *x, int n, int max_iter, double tol) {
+    double *x_old = (double*)malloc(n * sizeof(double));
+    int iter;
+
+    for (int i = 0; i < n; i++) {
+        x[i] = 0.0;
+    }
+
+    for (iter = 0; iter < max_iter; iter++) {
+        for (int i = 0; i < n; i++) {
+            x_old[i] = x[i];
+        }
+
+        for (int i = 0; i < n; i++) {
+            double sum = b[i];
+            for (int j = 0; j < n; j++) {
+                if (j != i) {
+                    sum -= A[i * n + j] * x[j];
+                }
+            }
+            x[i] = sum / A[i * n + i];
+        }
+
+        double max_diff = 0.0;
+        for (int i = 0; i < n; i++) {
+            double diff = fabs(x[i] - x_old[i]);
+            if (diff > max_diff) max_diff = diff;
+        }
+        if (max_diff < tol) {
+            break;
+        }
+    }
+
+    free(x_old);
+    return iter;
+}
+
+// ---------------------------------------------------------------------------
+// Stencil engine
+//   out = c_self * u + c_nbr * (N + S + W + E) + c_prev * out_old
+// Heat:    c_self = 1 - 4a, c_nbr = a,   c_prev = 0
+// Wave:    c_self = 2 - 4r^2, c_nbr = r^2, c_prev = -1 (leapfrog, u^{t-1} in place)
+// Jacobi:  c_self = 0,     c_nbr = 1/4, c_prev = 0
+// buf[t & 1] holds time t; buf[(t + 1) & 1] holds t - 1 and receives t + 1.
+// Boundary cells are never written, so both buffers keep Dirichlet values.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    double c_self;
+    double c_nbr;
+    double c_prev;
+    int bytes_per_update;     // streaming traffic of one naive sweep, for GB/s
+} Stencil;
+
+typedef struct {
+    int n;
+    double *buf[2];
+    long long t;
+} Field;
+
+void field_init(Field *f, int n) {
+    f->n = n;
+    f->buf[0] = (double*)calloc((size_t)n * n, sizeof(double));
+    f->buf[1] = (double*)calloc((size_t)n * n, sizeof(double));
+    f->t = 0;
+}
+
+void field_free(Field *f) {
+    free(f->buf[0]);
+    free(f->buf[1]);
+}
+
+void field_copy(Field *dst, const Field *src) {
+    size_t bytes = (size_t)src->n * src->n * sizeof(double);
+    memcpy(dst->buf[0], src->buf[0], bytes);
+    memcpy(dst->buf[1], src->buf[1], bytes);
+    dst->t = src->t;
+}
+
+static inline double *field_now(const Field *f) {
+    return f->buf[f->t & 1];
+}
+
+static inline void stencil_row(const Stencil *st, const double *up, const double *mid,
+                               const double *down, double *out, int j0, int j1) {
+    double cs = st->c_self, cn = st->c_nbr, cp = st->c_prev;
+    if (cp == 0.0) {
+        for (int j = j0; j < j1; j++) {
+            out[j] = cs * mid[j] + cn * (up[j] + down[j] + mid[j - 1] + mid[j + 1]);
+        }
+    } else {
+        for (int j = j0; j < j1; j++) {
+            out[j] = cs * mid[j] + cn * (up[j] + down[j] + mid[j - 1] + mid[j + 1]) + cp * out[j];
+        }
+    }
+}
+
+static inline void stencil_block(const Stencil *st, const double *src, double *dst, int n,
+                                 int i0, int i1, int j0, int j1) {
+    for (int i = i0; i < i1; i++) {
+        stencil_row(st, src + (size_t)(i - 1) * n, src + (size_t)i * n,
+                    src + (size_t)(i + 1) * n, dst + (size_t)i * n, j0, j1);
+    }
+}
+
+void engine_sweep_naive(const Stencil *st, Field *f, int steps) {
+    int n = f->n;
+    for (int s = 0; s < steps; s++) {
+        stencil_block(st, f->buf[f->t & 1], f->buf[(f->t + 1) & 1], n, 1, n - 1, 1, n - 1);
+        f->t++;
+    }
+}
+
+void engine_sweep_tiled(const Stencil *st, Field *f, int steps) {
+    int n = f->n;
+    for (int s = 0; s < steps; s++) {
+        const double *src = f->buf[f->t & 1];
+        double *dst = f->buf[(f->t + 1) & 1];
+        for (int y0 = 1; y0 < n - 1; y0 += TILE_Y) {
+            int y1 = y0 + TILE_Y < n - 1 ? y0 + TILE_Y : n - 1;
+            for (int x0 = 1; x0 < n - 1; x0 += TILE_X) {
+                int x1 = x0 + TILE_X < n - 1 ? x0 + TILE_X : n - 1;
+                stencil_block(st, src, dst, n, y0, y1, x0, x1);
+            }
+        }
+        f->t++;
+    }
+}
+
+// One skewed tile: at sub-step s it covers rows [y0 - s, y0 + TILE_Y - s) and
+// columns [x0 - s, x0 + TILE_X - s). Shifting up-left by one cell per step keeps
+// every read inside data already produced by this tile or by tiles up/left of it,
+// and a cell's t - 1 value is overwritten only once all its readers have run.
+static long long skewed_tile(const Stencil *st, Field *f, int depth, int y0, int x0) {
+    int n = f->n;
+    long long cells = 0;
+    for (int s = 0; s < depth; s++) {
+        int i0 = y0 - s > 1 ? y0 - s : 1;
+        int i1 = y0 + TILE_Y - s < n - 1 ? y0 + TILE_Y - s : n - 1;
+        int j0 = x0 - s > 1 ? x0 - s : 1;
+        int j1 = x0 + TILE_X - s < n - 1 ? x0 + TILE_X - s : n - 1;
+        if (i0 >= i1 || j0 >= j1) continue;
+        stencil_block(st, f->buf[(f->t + s) & 1], f->buf[(f->t + s + 1) & 1], n, i0, i1, j0, j1);
+        cells += (long long)(i1 - i0) * (j1 - j0);
+    }
+    return cells;
+}
+
+// Tiles extend depth - 1 cells past the far edge so skewed sub-steps cover it.
+static void skewed_tile_counts(int n, int depth, int *tiles_y, int *tiles_x) {
+    *tiles_y = (n - 2 + depth - 1 + TILE_Y - 1) / TILE_Y;
+    *tiles_x = (n - 2 + depth - 1 + TILE_X - 1) / TILE_X;
+}
+
+void engine_sweep_temporal(const Stencil *st, Field *f, int steps) {
+    for (int done = 0; done < steps; done += T_BLOCK) {
+        int depth = steps - done < T_BLOCK ? steps - done : T_BLOCK;
+        int ty, tx;
+        skewed_tile_counts(f->n, depth, &ty, &tx);
+        for (int by = 0; by < ty; by++) {
+            for (int bx = 0; bx < tx; bx++) {
+                skewed_tile(st, f, depth, 1 + by * TILE_Y, 1 + bx * TILE_X);
+            }
+        }
+        f->t += depth;
+    }
+}
+
+typedef struct {
+    long long cells[NUM_WORKERS];
+    long long tiles;
+    long long diagonals;
+} WavefrontStats;
+
+// Tiles on one anti-diagonal (bx + by = d) only depend on earlier diagonals,
+// so they are dealt round-robin to workers. Workers run in reverse order here
+// to show that the result does not depend on the order inside a diagonal.
+void engine_sweep_wavefront(const Stencil *st, Field *f, int steps, WavefrontStats *ws) {
+    for (int done = 0; done < steps; done += T_BLOCK) {
+        int depth = steps - done < T_BLOCK ? steps - done : T_BLOCK;
+        int ty, tx;
+        skewed_tile_counts(f->n, depth, &ty, &tx);
+        for (int d = 0; d < ty + tx - 1; d++) {
+            int by_lo = d - (tx - 1) > 0 ? d - (tx - 1) : 0;
+            int by_hi = d < ty - 1 ? d : ty - 1;
+            for (int w = NUM_WORKERS - 1; w >= 0; w--) {
+                for (int by = by_lo + w; by <= by_hi; by += NUM_WORKERS) {
+                    int bx = d - by;
+                    ws->cells[w] += skewed_tile(st, f, depth, 1 + by * TILE_Y, 1 + bx * TILE_X);
+                    ws->tiles++;
+                }
+            }
+            ws->diagonals++;
+        }
+        f->t += depth;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Red-black Gauss-Seidel: all red cells ((i + j) even) depend only on black
+// ones and vice versa, so each half-sweep splits into independent row chunks.
+// ---------------------------------------------------------------------------
+
+static double rb_half_sweep(double *g, int n, int color) {
+    double max_change = 0.0;
+    for (int w = 0; w < NUM_WORKERS; w++) {
+        int i0 = 1 + (int)((long long)(n - 2) * w / NUM_WORKERS);
+        int i1 = 1 + (int)((long long)(n - 2) * (w + 1) / NUM_WORKERS);
+        for (int i = i0; i < i1; i++) {
+            double *row = g + (size_t)i * n;
+            const double *up = row - n, *down = row + n;
+            for (int j = 1 + ((i + 1 + color) & 1); j < n - 1; j += 2) {
+                double v = 0.25 * (up[j] + down[j] + row[j - 1] + row[j + 1]);
+                double change = fabs(v - row[j]);
+                if (change > max_change) max_change = change;
+                row[j] = v;
+            }
+        }
+    }
+    return max_change;
+}
+
+double red_black_iteration(double *g, int n) {
+    double red = rb_half_sweep(g, n, 0);
+    double black = rb_half_sweep(g, n, 1);
+    return red > black ? red : black;
+}
+
+// ---------------------------------------------------------------------------
+// Problem setup and checks
+// ---------------------------------------------------------------------------
+
+void init_heat(Field *f) {
+    int n = f->n;
+    double *T = f->buf[0];
+    int center = n / 2;
+    int radius = n / 8;
+    for (int i = center - radius; i < center + radius; i++) {
+        for (int j = center - radius; j < center + radius; j++) {
+            T[i * n + j] = 100.0;
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        T[i] = 20.0;
+        T[(n-1) * n + i] = 20.0;
+        T[i * n] = 20.0;
+        T[i * n + (n-1)] = 20.0;
+    }
+    memcpy(f->buf[1], T, (size_t)n * n * sizeof(double));
+    f->t = 0;
+}
+
+// Gaussian pulse at rest: u^0 = u^{-1}, zero on the boundary.
+void init_wave(Field *f) {
+    int n = f->n;
+    double sigma = n / 16.0;
+    for (int i = 1; i < n - 1; i++) {
+        for (int j = 1; j < n - 1; j++) {
+            double dx = (j - n / 2) / sigma, dy = (i - n / 2) / sigma;
+            f->buf[0][i * n + j] = exp(-(dx * dx + dy * dy));
+        }
+    }
+    memcpy(f->buf[1], f->buf[0], (size_t)n * n * sizeof(double));
+    f->t = 0;
+}
+
+double wave_energy(const Field *f, double r) {
+    int n = f->n;
+    const double *u = f->buf[f->t & 1], *u_prev = f->buf[(f->t + 1) & 1];
+    double kinetic = 0.0, potential = 0.0;
+    for (int i = 1; i < n - 1; i++) {
+        for (int j = 1; j < n - 1; j++) {
+            int k = i * n + j;
+            double v = u[k] - u_prev[k];
+            kinetic += v * v;
+            double gx = (u[k + 1] - u[k - 1]) * 0.5, gy = (u[k + n] - u[k - n]) * 0.5;
+            potential += r * r * (gx * gx + gy * gy);
+        }
+    }
+    return 0.5 * (kinetic + potential);
+}
+
+double max_abs_diff(const double *a, const double *b, size_t count) {
+    double m = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        double d = fabs(a[i] - b[i]);
+        if (d > m) m = d;
+    }
+    return m;
+}
+
+double field_average(const Field *f) {
+    const double *u = field_now(f);
+    double sum = 0.0;
+    size_t count = (size_t)f->n * f->n;
+    for (size_t i = 0; i < count; i++) sum += u[i];
+    return sum / count;
+}
+
+typedef struct {
+    const char *name;
+    double seconds;
+    double max_diff;          // vs engine naive sweep (0 expected for reorderings)
+} RunResult;
+
+void print_run(const RunResult *r, int n, int steps, int bytes_per_update) {
+    double updates = (double)(n - 2) * (n - 2) * steps;
+    double rate = r->seconds > 0 ? updates / r->seconds : 0.0;
+    printf("  %-22s %.3e cells/s, %6.2f GB/s effective, max diff %.3e, %.6f seconds\n",
+           r->name, rate, rate * bytes_per_update / 1e9, r->max_diff, r->seconds);
+}
+
+int bench_stencil(const char *label, const Stencil *st, int n, int steps, int is_wave) {
+    Field base, work;
+    field_init(&base, n);
+    field_init(&work, n);
+    if (is_wave) init_wave(&base);
+    else init_heat(&base);
+    size_t cells = (size_t)n * n;
+    int mismatches = 0;
+
+    printf("%s %dx%d, %d steps:\n", label, n, n, steps);
+
+    // Existing hand-rolled loop on its own buffers
+    double *a = (double*)malloc(cells * sizeof(double));
+    double *b = (double*)malloc(cells * sizeof(double));
+    double *c = (double*)malloc(cells * sizeof(double));
+    memcpy(a, base.buf[0], cells * sizeof(double));
+    memcpy(b, base.buf[1], cells * sizeof(double));
+    memcpy(c, base.buf[0], cells * sizeof(double));
+    clock_t start = clock();
+    for (int s = 0; s < steps; s++) {
+        if (is_wave) {
+            wave_step_2d(a, b, c, n, WAVE_R);
+            double *tmp = b; b = a; a = c; c = tmp;
+        } else {
+            heat_diffusion_step(a, b, n, ALPHA);
+            double *tmp = a; a = b; b = tmp;
+        }
+    }
+    clock_t end = clock();
+    double *ref_now = a;
+    RunResult ref = {is_wave ? "167-style wave_step" : "47 heat_diffusion_step",
+                     (double)(end - start) / CLOCKS_PER_SEC, 0.0};
+
+    field_copy(&work, &base);
+    start = clock();
+    engine_sweep_naive(st, &work, steps);
+    end = clock();
+    double *naive = (double*)malloc(cells * sizeof(double));
+    memcpy(naive, field_now(&work), cells * sizeof(double));
+    ref.max_diff = max_abs_diff(ref_now, naive, cells);
+    if (ref.max_diff > 1e-9) mismatches++;
+    RunResult naive_run = {"engine naive", (double)(end - start) / CLOCKS_PER_SEC, 0.0};
+    double energy = is_wave ? wave_energy(&work, WAVE_R) : field_average(&work);
+
+    field_copy(&work, &base);
+    start = clock();
+    engine_sweep_tiled(st, &work, steps);
+    end = clock();
+    RunResult tiled = {"spatial tiles", (double)(end - start) / CLOCKS_PER_SEC,
+                       max_abs_diff(naive, field_now(&work), cells)};
+
+    field_copy(&work, &base);
+    start = clock();
+    engine_sweep_temporal(st, &work, steps);
+    end = clock();
+    RunResult temporal = {"temporal blocks", (double)(end - start) / CLOCKS_PER_SEC,
+                          max_abs_diff(naive, field_now(&work), cells)};
+
+    WavefrontStats ws;
+    memset(&ws, 0, sizeof(ws));
+    field_copy(&work, &base);
+    start = clock();
+    engine_sweep_wavefront(st, &work, steps, &ws);
+    end = clock();
+    RunResult wave = {"wavefront workers", (double)(end - start) / CLOCKS_PER_SEC,
+                      max_abs_diff(naive, field_now(&work), cells)};
+
+    if (tiled.max_diff != 0.0) mismatches++;
+    if (temporal.max_diff != 0.0) mismatches++;
+    if (wave.max_diff != 0.0) mismatches++;
+
+    print_run(&ref, n, steps, st->bytes_per_update);
+    print_run(&naive_run, n, steps, st->bytes_per_update);
+    print_run(&tiled, n, steps, st->bytes_per_update);
+    print_run(&temporal, n, steps, st->bytes_per_update);
+    print_run(&wave, n, steps, st->bytes_per_update);
+
+    long long busiest = 0, total = 0;
+    for (int w = 0; w < NUM_WORKERS; w++) {
+        total += ws.cells[w];
+        if (ws.cells[w] > busiest) busiest = ws.cells[w];
+    }
+    printf("  %s %.6f, %lld tiles over %lld diagonals, worker balance %.3f\n",
+           is_wave ? "energy" : "avg_temp", energy, ws.tiles, ws.diagonals,
+           busiest > 0 ? (double)total / (NUM_WORKERS * busiest) : 0.0);
+
+    free(a);
+    free(b);
+    free(c);
+    free(naive);
+    field_free(&base);
+    field_free(&work);
+    return mismatches;
+}
+
+int check_laplace(void) {
+    int n = LAPLACE_SIZE;
+    double **grid = (double**)malloc(n * sizeof(double *));
+    double *rb = (double*)calloc((size_t)n * n, sizeof(double));
+    for (int i = 0; i < n; i++) {
+        grid[i] = (double*)calloc(n, sizeof(double));
+        grid[0][i] = 100.0;
+        rb[i] = 100.0;
+    }
+
+    clock_t start = clock();
+    int gs_iters = 0;
+    double change;
+    do {
+        change = gauss_seidel_iteration(grid, n);
+        gs_iters++;
+    } while (change > LAPLACE_TOLERANCE && gs_iters < LAPLACE_MAX_ITER);
+    clock_t end = clock();
+    double gs_time = (double)(end - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    int rb_iters = 0;
+    do {
+        change = red_black_iteration(rb, n);
+        rb_iters++;
+    } while (change > LAPLACE_TOLERANCE && rb_iters < LAPLACE_MAX_ITER);
+    end = clock();
+    double rb_time = (double)(end - start) / CLOCKS_PER_SEC;
+
+    double max_diff = 0.0;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            double d = fabs(grid[i][j] - rb[i * n + j]);
+            if (d > max_diff) max_diff = d;
+        }
+    }
+    printf("Laplace %dx%d: lexicographic GS %d iterations %.6f seconds, "
+           "red-black GS %d iterations %.6f seconds, max diff %.3e\n",
+           n, n, gs_iters, gs_time, rb_iters, rb_time, max_diff);
+
+    for (int i = 0; i < n; i++) free(grid[i]);
+    free(grid);
+    free(rb);
+    return max_diff > 1e-4;
+}
+
+// The 5-point Laplacian as the dense system 61_gauss_seidel.c solves,
+// checked against red-black sweeps over the same grid.
+int check_dense_system(void) {
+    int side = DENSE_SIDE, m = side * side, n = side + 2;
+    double *A = (double*)calloc((size_t)m * m, sizeof(double));
+    double *b = (double*)calloc(m, sizeof(double));
+    double *x = (double*)malloc(m * sizeof(double));
+    for (int i = 0; i < side; i++) {
+        for (int j = 0; j < side; j++) {
+            int r = i * side + j;
+            A[r * m + r] = 4.0;
+            if (i > 0) A[r * m + r - side] = -1.0;
+            else b[r] += 100.0;            // top boundary held at 100
+            if (i < side - 1) A[r * m + r + side] = -1.0;
+            if (j > 0) A[r * m + r - 1] = -1.0;
+            if (j < side - 1) A[r * m + r + 1] = -1.0;
+        }
+    }
+    int dense_iters = gauss_seidel_dense(A, b, x, m, DENSE_MAX_ITER, DENSE_TOLERANCE);
+
+    double *g = (double*)calloc((size_t)n * n, sizeof(double));
+    for (int j = 0; j < n; j++) g[j] = 100.0;
+    int rb_iters = 0;
+    while (red_black_iteration(g, n) > DENSE_TOLERANCE && rb_iters < DENSE_MAX_ITER) rb_iters++;
+
+    double max_diff = 0.0;
+    for (int i = 0; i < side; i++) {
+        for (int j = 0; j < side; j++) {
+            double d = fabs(x[i * side + j] - g[(i + 1) * n + j + 1]);
+            if (d > max_diff) max_diff = d;
+        }
+    }
+    printf("Dense Gauss-Seidel %dx%d vs red-black stencil: %d / %d iterations, max diff %.3e\n",
+           m, m, dense_iters, rb_iters, max_diff);
+    free(A);
+    free(b);
+    free(x);
+    free(g);
+    return max_diff > 1e-6;
+}
+
+int main() {
+    Stencil heat = {1.0 - 4.0 * ALPHA, ALPHA, 0.0, 16};
+    Stencil wave = {2.0 - 4.0 * WAVE_R * WAVE_R, WAVE_R * WAVE_R, -1.0, 24};
+    int mismatches = 0;
+
+    clock_t start = clock();
+    for (int s = 0; s < NUM_SIZES; s++) {
+        int n = grid_sizes[s];
+        int steps = (int)(UPDATES_PER_RUN / ((long long)n * n));
+        steps = steps < T_BLOCK ? T_BLOCK : steps - steps % T_BLOCK;
+        mismatches += bench_stencil("Heat", &heat, n, steps, 0);
+        mismatches += bench_stencil("Wave", &wave, n, steps, 1);
+    }
+    mismatches += check_laplace();
+    mismatches += check_dense_system();
+    clock_t end = clock();
+
+    printf("Stencil engine: %d sizes, tile %dx%d, %d-step time blocks, %.6f seconds\n",
+           NUM_SIZES, TILE_Y, TILE_X, T_BLOCK, (double)(end - start) / CLOCKS_PER_SEC);
+    printf("Mismatches: %d\n", mismatches);
+    return 0;
+}
@@ -0,0 +1,951 @@
+// Tiled image-filtering pipeline on grayscale images (4K with -DFULL_SIZE)
+// Separable blur/Sobel, constant-time median, van Herk/Gil-Werman morphology, bilateral grid, fused line buffers
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#ifdef FULL_SIZE
+#define WIDTH 3840
+#define HEIGHT 2160
+#define BILATERAL_CROP 384    // brute-force 139 reference runs on this crop
+#define MEDIAN_REF_ROWS 540   // 45 reference median runs on the top quarter only
+#else
+#define WIDTH 512             // -DFULL_SIZE for 3840x2160
+#define HEIGHT 512
+#define BILATERAL_CROP 128    // brute-force 139 reference runs on this crop
+#define MEDIAN_REF_ROWS 128   // 45 reference median runs on the top quarter only
+#endif
+#define KERNEL_SIZE 5
+#define KERNEL_RADIUS (KERNEL_SIZE / 2)
+#define SIGMA 1.4
+#define BAND_ROWS 128         // rows per pipeline tile
+#define NUM_WORKERS 8
+#define BILATERAL_SIGMA_S 2.0
+#define BILATERAL_SIGMA_R 0.1
+#define GRID_PAD 1         // blur and trilinear reach one cell past the data
+
+typedef unsigned char u8;
+
+// ---------------------------------------------------------------------------
+// Reference filters (34, 55, 45, 158, 139), on flat row-major buffers
+// ---------------------------------------------------------------------------
+
+void generate_gaussian_kernel(float kernel[KERNEL_SIZE][KERNEL_SIZE], float sigma) {
+    float sum = 0.0;
+    int half = KERNEL_SIZE / 2;
+
+    for (int y = -half; y <= half; y++) {
+        for (int x = -half; x <= half; x++) {
+            float value = exp(-(x*x + y*y) / (2.0 * sigma * sigma));
+            kernel[y + half][x + half] = value;
+            sum += value;
+        }
+    }
+    for (int y = 0; y < KERNEL_SIZE; y++) {
+        for (int x = 0; x < KERNEL_SIZE; x++) {
+            kernel[y][x] /= sum;
+        }
+    }
+}
+
+void apply_gaussian_blur(const u8 *in, u8 *out, int width, int height,
+                         float kernel[KERNEL_SIZE][KERNEL_SIZE]) {
+    int half = KERNEL_SIZE / 2;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            float sum = 0.0;
+            for (int ky = 0; ky < KERNEL_SIZE; ky++) {
+                for (int kx = 0; kx < KERNEL_SIZE; kx++) {
+                    int py = y + ky - half;
+                    int px = x + kx - half;
+                    if (py < 0) py = 0;
+                    if (py >= height) py = height - 1;
+                    if (px < 0) px = 0;
+                    if (px >= width) px = width - 1;
+                    sum += in[py * width + px] * kernel[ky][kx];
+                }
+            }
+            out[y * width + x] = (u8)(sum + 0.5);
+        }
+    }
+}
+
+void sobel_filter(const u8 *in, u8 *out, int width, int height) {
+    int gx[3][3] = {{-1, 0, 1}, {-2, 0, 2}, {-1, 0, 1}};
+    int gy[3][3] = {{-1, -2, -1}, {0, 0, 0}, {1, 2, 1}};
+    memset(out, 0, (size_t)width * height);
+    for (int y = 1; y < height - 1; y++) {
+        for (int x = 1; x < width - 1; x++) {
+            int sum_x = 0, sum_y = 0;
+            for (int ky = -1; ky <= 1; ky++) {
+                for (int kx = -1; kx <= 1; kx++) {
+                    int pixel = in[(y + ky) * width + x + kx];
+                    sum_x += pixel * gx[ky + 1][kx + 1];
+                    sum_y += pixel * gy[ky + 1][kx + 1];
+                }
+            }
+            int magnitude = (int)sqrt(sum_x * sum_x + sum_y * sum_y);
+            out[y * width + x] = (magnitude > 255) ? 255 : (u8)magnitude;
+        }
+    }
+}
+
+void insertion_sort(u8 *arr, int n) {
+    for (int i = 1; i < n; i++) {
+        u8 key = arr[i];
+        int j = i - 1;
+        while (j >= 0 && arr[j] > key) {
+            arr[j + 1] = arr[j];
+            j--;
+        }
+        arr[j + 1] = key;
+    }
+}
+
+// Rows [0, rows) only; the window still sees the full image height.
+void median_filter(const u8 *in, u8 *out, int width, int height, int rows, int window_size) {
+    int half = window_size / 2;
+    u8 window[KERNEL_SIZE * KERNEL_SIZE];
+    for (int y = 0; y < rows; y++) {
+        for (int x = 0; x < width; x++) {
+            int count = 0;
+            for (int wy = -half; wy <= half; wy++) {
+                for (int wx = -half; wx <= half; wx++) {
+                    int py = y + wy, px = x + wx;
+                    if (py >= 0 && py < height && px >= 0 && px < width) {
+                        window[count++] = in[py * width + px];
+                    }
+                }
+            }
+            insertion_sort(window, count);
+            out[y * width + x] = window[count / 2];
+        }
+    }
+}
+
+// 158: out-of-range neighbours are skipped (identity padding).
+void morph_reference(const u8 *in, u8 *out, int width, int height, int is_max) {
+    int half = KERNEL_SIZE / 2;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            u8 best = is_max ? 0 : 255;
+            for (int ky = -half; ky <= half; ky++) {
+                for (int kx = -half; kx <= half; kx++) {
+                    int ny = y + ky, nx = x + kx;
+                    if (ny >= 0 && ny < height && nx >= 0 && nx < width) {
+                        u8 val = in[ny * width + nx];
+                        if (is_max ? val > best : val < best) best = val;
+                    }
+                }
+            }
+            out[y * width + x] = best;
+        }
+    }
+}
+
+double gaussian(double x, double sigma) {
+    return exp(-(x * x) / (2.0 * sigma * sigma));
+}
+
+void bilateral_filter(double *input, double *output, int width, int height,
+                      double sigma_spatial, double sigma_range) {
+    int half_window = KERNEL_SIZE / 2;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            double sum = 0.0;
+            double weight_sum = 0.0;
+            double center_value = input[y * width + x];
+            for (int dy = -half_window; dy <= half_window; dy++) {
+                for (int dx = -half_window; dx <= half_window; dx++) {
+                    int ny = y + dy;
+                    int nx = x + dx;
+                    if (ny >= 0 && ny < height && nx >= 0 && nx < width) {
+                        double neighbor_value = input[ny * width + nx];
+                        double spatial_weight = gaussian(sqrt(dx * dx + dy * dy), sigma_spatial);
+                        double range_weight = gaussian(neighbor_value - center_value, sigma_range);
+                        double weight = spatial_weight * range_weight;
+                        sum += neighbor_value * weight;
+                        weight_sum += weight;
+                    }
+                }
+            }
+            output[y * width + x] = sum / weight_sum;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Line kernels shared by the full-image and the fused paths
+// ---------------------------------------------------------------------------
+
+static inline int clamp_index(int i, int n) {
+    return i < 0 ? 0 : (i >= n ? n - 1 : i);
+}
+
+void gauss_h_line(const u8 *in, float *out, int width, const float *k) {
+    int r = KERNEL_RADIUS;
+    for (int x = 0; x < width; x++) {
+        float sum = 0.0f;
+        if (x >= r && x < width - r) {
+            for (int i = 0; i < KERNEL_SIZE; i++) sum += in[x + i - r] * k[i];
+        } else {
+            for (int i = 0; i < KERNEL_SIZE; i++) sum += in[clamp_index(x + i - r, width)] * k[i];
+        }
+        out[x] = sum;
+    }
+}
+
+void gauss_v_line(const float *rows[KERNEL_SIZE], u8 *out, int width, const float *k) {
+    for (int x = 0; x < width; x++) {
+        float sum = 0.0f;
+        for (int i = 0; i < KERNEL_SIZE; i++) sum += rows[i][x] * k[i];
+        out[x] = (u8)(sum + 0.5f);
+    }
+}
+
+// Sobel as [1 2 1]^T x [-1 0 1] and [-1 0 1]^T x [1 2 1]: one vertical pass
+// builds smoothed and differenced columns, one horizontal pass combines them.
+void sobel_line(const u8 *r0, const u8 *r1, const u8 *r2, u8 *out, int width,
+                int *smooth, int *diff) {
+    for (int x = 0; x < width; x++) {
+        smooth[x] = r0[x] + 2 * r1[x] + r2[x];
+        diff[x] = r2[x] - r0[x];
+    }
+    out[0] = out[width - 1] = 0;
+    for (int x = 1; x < width - 1; x++) {
+        int sx = smooth[x + 1] - smooth[x - 1];
+        int sy = diff[x - 1] + 2 * diff[x] + diff[x + 1];
+        int magnitude = (int)sqrt(sx * sx + sy * sy);
+        out[x] = magnitude > 255 ? 255 : (u8)magnitude;
+    }
+}
+
+// van Herk/Gil-Werman running max/min of width KERNEL_SIZE over a line padded
+// with the identity: prefix (g) and suffix (h) extrema inside blocks of
+// KERNEL_SIZE make every window two lookups, independent of the kernel size.
+void vhgw_line(const u8 *in, u8 *out, int n, int is_max, u8 *g, u8 *h) {
+    int k = KERNEL_SIZE, r = KERNEL_RADIUS;
+    int padded = n + 2 * r;
+    int blocks = (padded + k - 1) / k;
+    u8 identity = is_max ? 0 : 255;
+    for (int b = 0; b < blocks; b++) {
+        int start = b * k, end = start + k;
+        u8 acc = identity;
+        for (int i = start; i < end; i++) {
+            u8 v = (i >= r && i < n + r) ? in[i - r] : identity;
+            acc = is_max ? (v > acc ? v : acc) : (v < acc ? v : acc);
+            g[i] = acc;
+        }
+        acc = identity;
+        for (int i = end - 1; i >= start; i--) {
+            u8 v = (i >= r && i < n + r) ? in[i - r] : identity;
+            acc = is_max ? (v > acc ? v : acc) : (v < acc ? v : acc);
+            h[i] = acc;
+        }
+    }
+    for (int x = 0; x < n; x++) {
+        u8 a = h[x], b = g[x + k - 1];
+        out[x] = is_max ? (a > b ? a : b) : (a < b ? a : b);
+    }
+}
+
+void morph_v_line(const u8 *rows[KERNEL_SIZE], u8 *out, int width, int is_max) {
+    memcpy(out, rows[0], width);
+    for (int i = 1; i < KERNEL_SIZE; i++) {
+        const u8 *row = rows[i];
+        if (is_max) {
+            for (int x = 0; x < width; x++) out[x] = row[x] > out[x] ? row[x] : out[x];
+        } else {
+            for (int x = 0; x < width; x++) out[x] = row[x] < out[x] ? row[x] : out[x];
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Full-image separable passes (one intermediate image per pass)
+// ---------------------------------------------------------------------------
+
+void gaussian_separable(const u8 *in, u8 *out, float *tmp, int width, int height, const float *k) {
+    for (int y = 0; y < height; y++) {
+        gauss_h_line(in + (size_t)y * width, tmp + (size_t)y * width, width, k);
+    }
+    const float *rows[KERNEL_SIZE];
+    for (int y = 0; y < height; y++) {
+        for (int i = 0; i < KERNEL_SIZE; i++) {
+            rows[i] = tmp + (size_t)clamp_index(y + i - KERNEL_RADIUS, height) * width;
+        }
+        gauss_v_line(rows, out + (size_t)y * width, width, k);
+    }
+}
+
+void sobel_separable(const u8 *in, u8 *out, int width, int height, int *smooth, int *diff) {
+    memset(out, 0, width);
+    memset(out + (size_t)(height - 1) * width, 0, width);
+    for (int y = 1; y < height - 1; y++) {
+        sobel_line(in + (size_t)(y - 1) * width, in + (size_t)y * width,
+                   in + (size_t)(y + 1) * width, out + (size_t)y * width, width, smooth, diff);
+    }
+}
+
+// Rows run through vhgw_line; columns use the same block scheme across whole
+// rows so the inner loops stay contiguous.
+void morph_vhgw(const u8 *in, u8 *out, u8 *tmp, int width, int height, int is_max) {
+    int k = KERNEL_SIZE, r = KERNEL_RADIUS;
+    int n = width > height ? width : height;
+    u8 *g = (u8*)malloc(n + 2 * k), *h = (u8*)malloc(n + 2 * k);
+    for (int y = 0; y < height; y++) {
+        vhgw_line(in + (size_t)y * width, tmp + (size_t)y * width, width, is_max, g, h);
+    }
+    free(g);
+    free(h);
+
+    // Padded row i is image row i - r; G holds prefix rows of two blocks, H suffix rows of one.
+    u8 identity = is_max ? 0 : 255;
+    u8 *G = (u8*)malloc((size_t)2 * k * width), *H = (u8*)malloc((size_t)k * width);
+    u8 *pad = (u8*)malloc(width);
+    memset(pad, identity, width);
+    int padded = height + 2 * r;
+    int blocks = (padded + k - 1) / k;
+    for (int b = 0; b <= blocks; b++) {
+        // Prefix rows of block b into slot b & 1
+        u8 *gb = G + (size_t)(b & 1) * k * width;
+        for (int i = 0; i < k; i++) {
+            int row = b * k + i - r;
+            const u8 *src = (row >= 0 && row < height) ? tmp + (size_t)row * width : pad;
+            u8 *dst = gb + (size_t)i * width;
+            if (i == 0) {
+                memcpy(dst, src, width);
+            } else {
+                const u8 *prev = dst - width;
+                if (is_max) for (int x = 0; x < width; x++) dst[x] = src[x] > prev[x] ? src[x] : prev[x];
+                else for (int x = 0; x < width; x++) dst[x] = src[x] < prev[x] ? src[x] : prev[x];
+            }
+        }
+        if (b == 0) continue;
+        // Suffix rows of block b - 1, then emit its outputs
+        int pb = b - 1;
+        for (int i = k - 1; i >= 0; i--) {
+            int row = pb * k + i - r;
+            const u8 *src = (row >= 0 && row < height) ? tmp + (size_t)row * width : pad;
+            u8 *dst = H + (size_t)i * width;
+            if (i == k - 1) {
+                memcpy(dst, src, width);
+            } else {
+                const u8 *next = dst + width;
+                if (is_max) for (int x = 0; x < width; x++) dst[x] = src[x] > next[x] ? src[x] : next[x];
+                else for (int x = 0; x < width; x++) dst[x] = src[x] < next[x] ? src[x] : next[x];
+            }
+        }
+        for (int i = 0; i < k; i++) {
+            int y = pb * k + i;   // output row y covers padded rows [y, y + k - 1]
+            if (y >= height) break;
+            int gi = y + k - 1;   // lies in block pb (i == 0) or pb + 1
+            const u8 *a = H + (size_t)i * width;
+            const u8 *c = G + (size_t)((gi / k) & 1) * k * width + (size_t)(gi % k) * width;
+            u8 *dst = out + (size_t)y * width;
+            if (is_max) for (int x = 0; x < width; x++) dst[x] = a[x] > c[x] ? a[x] : c[x];
+            else for (int x = 0; x < width; x++) dst[x] = a[x] < c[x] ? a[x] : c[x];
+        }
+    }
+    free(G);
+    free(H);
+    free(pad);
+}
+
+// ---------------------------------------------------------------------------
+// Constant-time median (Perreault/Hebert): per-column histograms slide down,
+// the kernel histogram slides right. Coarse 16-bin histograms are updated per
+// pixel; each fine 16-bin segment is brought up to date only when the median
+// falls inside it.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    unsigned short *col_fine;    // width * 256
+    unsigned short *col_coarse;  // width * 16
+    int width, height, r;
+} MedianState;
+
+void median_state_init(MedianState *m, int width, int height, int r) {
+    m->width = width;
+    m->height = height;
+    m->r = r;
+    m->col_fine = (unsigned short*)malloc((size_t)width * 256 * sizeof(unsigned short));
+    m->col_coarse = (unsigned short*)malloc((size_t)width * 16 * sizeof(unsigned short));
+}
+
+void median_state_free(MedianState *m) {
+    free(m->col_fine);
+    free(m->col_coarse);
+}
+
+static inline void col_hist_add(MedianState *m, const u8 *row, int delta) {
+    for (int x = 0; x < m->width; x++) {
+        m->col_fine[(size_t)x * 256 + row[x]] += delta;
+        m->col_coarse[(size_t)x * 16 + (row[x] >> 4)] += delta;
+    }
+}
+
+void median_ctmf_rows(MedianState *m, const u8 *in, u8 *out, int y0, int y1) {
+    int width = m->width, height = m->height, r = m->r;
+    memset(m->col_fine, 0, (size_t)width * 256 * sizeof(unsigned short));
+    memset(m->col_coarse, 0, (size_t)width * 16 * sizeof(unsigned short));
+    for (int y = y0 - r; y <= y0 + r; y++) {
+        if (y >= 0 && y < height) col_hist_add(m, in + (size_t)y * width, 1);
+    }
+
+    for (int y = y0; y < y1; y++) {
+        if (y > y0) {
+            if (y - r - 1 >= 0) col_hist_add(m, in + (size_t)(y - r - 1) * width, -1);
+            if (y + r < height) col_hist_add(m, in + (size_t)(y + r) * width, 1);
+        }
+        int rows_valid = (y + r < height ? y + r : height - 1) - (y - r > 0 ? y - r : 0) + 1;
+
+        int coarse[16] = {0};
+        unsigned short fine[16][16];
+        int fine_x[16];
+        for (int b = 0; b < 16; b++) fine_x[b] = -1000000;
+        for (int c = 0; c <= r && c < width; c++) {
+            for (int b = 0; b < 16; b++) coarse[b] += m->col_coarse[(size_t)c * 16 + b];
+        }
+
+        for (int x = 0; x < width; x++) {
+            if (x > 0) {
+                if (x + r < width) {
+                    const unsigned short *cc = m->col_coarse + (size_t)(x + r) * 16;
+                    for (int b = 0; b < 16; b++) coarse[b] += cc[b];
+                }
+                if (x - r - 1 >= 0) {
+                    const unsigned short *cc = m->col_coarse + (size_t)(x - r - 1) * 16;
+                    for (int b = 0; b < 16; b++) coarse[b] -= cc[b];
+                }
+            }
+            int cols_valid = (x + r < width ? x + r : width - 1) - (x - r > 0 ? x - r : 0) + 1;
+            int rank = rows_valid * cols_valid / 2;
+
+            int b = 0, cum = 0;
+            while (cum + coarse[b] <= rank) cum += coarse[b++];
+
+            unsigned short *seg = fine[b];
+            if (x - fine_x[b] > 2 * r + 1) {
+                memset(seg, 0, sizeof(fine[b]));
+                int c0 = x - r > 0 ? x - r : 0, c1 = x + r < width ? x + r : width - 1;
+                for (int c = c0; c <= c1; c++) {
+                    const unsigned short *cf = m->col_fine + (size_t)c * 256 + b * 16;
+                    for (int i = 0; i < 16; i++) seg[i] += cf[i];
+                }
+            } else {
+                for (int xx = fine_x[b] + 1; xx <= x; xx++) {
+                    if (xx + r < width) {
+                        const unsigned short *cf = m->col_fine + (size_t)(xx + r) * 256 + b * 16;
+                        for (int i = 0; i < 16; i++) seg[i] += cf[i];
+                    }
+                    if (xx - r - 1 >= 0) {
+                        const unsigned short *cf = m->col_fine + (size_t)(xx - r - 1) * 256 + b * 16;
+                        for (int i = 0; i < 16; i++) seg[i] -= cf[i];
+                    }
+                }
+            }
+            fine_x[b] = x;
+
+            int v = 0;
+            while (cum + seg[v] <= rank) cum += seg[v++];
+            out[(size_t)y * width + x] = (u8)(b * 16 + v);
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Bilateral grid (Paris/Durand): splat into a coarse (x, y, intensity) grid,
+// blur it with [1 2 1] along each axis, slice trilinearly. Built per band of
+// rows plus a margin so only a slab of the grid is alive at once.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    float *data;              // (value, weight) pairs
+    float *tmp;
+    int gw, gh, gd;
+    size_t capacity;
+} BilateralGrid;
+
+void bgrid_init(BilateralGrid *bg, int width, int band_rows) {
+    double ss = BILATERAL_SIGMA_S, sr = BILATERAL_SIGMA_R;
+    int margin = (int)(3 * ss) + 1;
+    bg->gw = (int)((width - 1) / ss + 0.5) + 1 + 2 * GRID_PAD;
+    bg->gh = (int)((band_rows + 2 * margin - 1) / ss + 0.5) + 1 + 2 * GRID_PAD;
+    bg->gd = (int)(1.0 / sr + 0.5) + 1 + 2 * GRID_PAD;
+    bg->capacity = (size_t)bg->gw * bg->gh * bg->gd * 2;
+    bg->data = (float*)malloc(bg->capacity * sizeof(float));
+    bg->tmp = (float*)malloc(bg->capacity * sizeof(float));
+}
+
+void bgrid_free(BilateralGrid *bg) {
+    free(bg->data);
+    free(bg->tmp);
+}
+
+// The grid is [outer][extent][inner] along the blurred axis; inner runs are
+// contiguous (value, weight) pairs.
+static void bgrid_blur_axis(BilateralGrid *bg, size_t inner, int extent) {
+    const float *src = bg->data;
+    float *dst = bg->tmp;
+    size_t run = inner * 2;
+    size_t outer = bg->capacity / (run * extent);
+    for (size_t o = 0; o < outer; o++) {
+        for (int p = 0; p < extent; p++) {
+            const float *c = src + (o * extent + p) * run;
+            const float *lo = p > 0 ? c - run : NULL;
+            const float *hi = p + 1 < extent ? c + run : NULL;
+            float *d = dst + (o * extent + p) * run;
+            for (size_t i = 0; i < run; i++) {
+                float v = 0.5f * c[i];
+                if (lo) v += 0.25f * lo[i];
+                if (hi) v += 0.25f * hi[i];
+                d[i] = v;
+            }
+        }
+    }
+    bg->tmp = bg->data;
+    bg->data = dst;
+}
+
+void bilateral_grid_rows(BilateralGrid *bg, const u8 *in, u8 *out, int width, int height,
+                         int y0, int y1) {
+    double ss = BILATERAL_SIGMA_S, sr = BILATERAL_SIGMA_R;
+    int margin = (int)(3 * ss) + 1;
+    int ylo = y0 - margin > 0 ? y0 - margin : 0;
+    int yhi = y1 + margin < height ? y1 + margin : height;
+    int gw = bg->gw, gd = bg->gd;
+    memset(bg->data, 0, bg->capacity * sizeof(float));
+
+    for (int y = ylo; y < yhi; y++) {
+        int gy = (int)((y - ylo) / ss + 0.5) + GRID_PAD;
+        const u8 *row = in + (size_t)y * width;
+        for (int x = 0; x < width; x++) {
+            float v = row[x] * (1.0f / 255.0f);
+            int gx = (int)(x / ss + 0.5) + GRID_PAD;
+            int gz = (int)(v / sr + 0.5) + GRID_PAD;
+            float *cell = bg->data + (((size_t)gy * gw + gx) * gd + gz) * 2;
+            cell[0] += v;
+            cell[1] += 1.0f;
+        }
+    }
+
+    bgrid_blur_axis(bg, 1, gd);
+    bgrid_blur_axis(bg, (size_t)gd, gw);
+    bgrid_blur_axis(bg, (size_t)gd * gw, bg->gh);
+
+    for (int y = y0; y < y1; y++) {
+        float fy = (float)((y - ylo) / ss) + GRID_PAD;
+        int iy = (int)fy;
+        float wy = fy - iy;
+        const u8 *row = in + (size_t)y * width;
+        for (int x = 0; x < width; x++) {
+            float v = row[x] * (1.0f / 255.0f);
+            float fx = (float)(x / ss) + GRID_PAD, fz = (float)(v / sr) + GRID_PAD;
+            int ix = (int)fx, iz = (int)fz;
+            float wx = fx - ix, wz = fz - iz;
+            float acc[2] = {0.0f, 0.0f};
+            for (int dy = 0; dy < 2; dy++) {
+                for (int dx = 0; dx < 2; dx++) {
+                    for (int dz = 0; dz < 2; dz++) {
+                        float w = (dy ? wy : 1 - wy) * (dx ? wx : 1 - wx) * (dz ? wz : 1 - wz);
+                        const float *cell = bg->data +
+                            (((size_t)(iy + dy) * gw + ix + dx) * gd + iz + dz) * 2;
+                        acc[0] += w * cell[0];
+                        acc[1] += w * cell[1];
+                    }
+                }
+            }
+            float result = acc[1] > 0 ? acc[0] / acc[1] : v;
+            int q = (int)(result * 255.0f + 0.5f);
+            out[(size_t)y * width + x] = (u8)(q < 0 ? 0 : (q > 255 ? 255 : q));
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Fused pipeline: each stage produces rows on demand into a small ring of
+// line buffers, so chained filters never materialise a full-image temporary.
+// ---------------------------------------------------------------------------
+
+typedef struct Stage Stage;
+typedef void (*RowFn)(Stage *s, int y, void *out);
+
+struct Stage {
+    RowFn row_fn;             // NULL: source stage reading pixels directly
+    Stage *src;
+    const u8 *pixels;
+    int width, height;
+    size_t elem_size;
+    int ring_rows;
+    unsigned char *ring;
+    int next_row;
+    int started;
+    const float *taps;        // Gaussian stages
+    int is_max;               // morphology stages
+    u8 *scratch_a, *scratch_b;
+    int *iscratch_a, *iscratch_b;
+    long long rows_computed;
+};
+
+void stage_init(Stage *s, RowFn fn, Stage *src, int width, int height, size_t elem_size) {
+    memset(s, 0, sizeof(Stage));
+    s->row_fn = fn;
+    s->src = src;
+    s->width = width;
+    s->height = height;
+    s->elem_size = elem_size;
+    s->ring_rows = KERNEL_SIZE;
+    if (fn) s->ring = (unsigned char*)malloc((size_t)s->ring_rows * width * elem_size);
+}
+
+void stage_free(Stage *s) {
+    free(s->ring);
+    free(s->scratch_a);
+    free(s->scratch_b);
+    free(s->iscratch_a);
+    free(s->iscratch_b);
+}
+
+void stage_restart(Stage *s) {
+    for (; s; s = s->src) s->started = 0;
+}
+
+// Rows outside the image clamp to the edge; requests must stay within the
+// ring window behind the newest row, or the stage restarts from y.
+const void *stage_row(Stage *s, int y) {
+    y = clamp_index(y, s->height);
+    if (!s->row_fn) return s->pixels + (size_t)y * s->width;
+    if (!s->started || y < s->next_row - s->ring_rows) {
+        s->next_row = y;
+        s->started = 1;
+    }
+    while (s->next_row <= y) {
+        void *slot = s->ring + (size_t)(s->next_row % s->ring_rows) * s->width * s->elem_size;
+        s->row_fn(s, s->next_row, slot);
+        s->next_row++;
+        s->rows_computed++;
+    }
+    return s->ring + (size_t)(y % s->ring_rows) * s->width * s->elem_size;
+}
+
+static void gauss_h_stage(Stage *s, int y, void *out) {
+    gauss_h_line(stage_row(s->src, y), out, s->width, s->taps);
+}
+
+static void gauss_v_stage(Stage *s, int y, void *out) {
+    const float *rows[KERNEL_SIZE];
+    for (int i = 0; i < KERNEL_SIZE; i++) rows[i] = stage_row(s->src, y + i - KERNEL_RADIUS);
+    gauss_v_line(rows, out, s->width, s->taps);
+}
+
+static void sobel_stage(Stage *s, int y, void *out) {
+    if (y == 0 || y == s->height - 1) {
+        memset(out, 0, s->width);
+        return;
+    }
+    const u8 *r0 = stage_row(s->src, y - 1);
+    const u8 *r1 = stage_row(s->src, y);
+    const u8 *r2 = stage_row(s->src, y + 1);
+    sobel_line(r0, r1, r2, out, s->width, s->iscratch_a, s->iscratch_b);
+}
+
+static void morph_h_stage(Stage *s, int y, void *out) {
+    vhgw_line(stage_row(s->src, y), out, s->width, s->is_max, s->scratch_a, s->scratch_b);
+}
+
+// Clamped rows repeat an edge row, which leaves a max/min unchanged.
+static void morph_v_stage(Stage *s, int y, void *out) {
+    const u8 *rows[KERNEL_SIZE];
+    for (int i = 0; i < KERNEL_SIZE; i++) rows[i] = stage_row(s->src, y + i - KERNEL_RADIUS);
+    morph_v_line(rows, out, s->width, s->is_max);
+}
+
+typedef struct {
+    Stage source;
+    Stage stages[4];
+    int num_stages;
+} Pipeline;
+
+Stage *pipeline_last(Pipeline *p) {
+    return &p->stages[p->num_stages - 1];
+}
+
+void pipeline_blur_sobel(Pipeline *p, const u8 *in, int width, int height, const float *taps) {
+    memset(p, 0, sizeof(Pipeline));
+    stage_init(&p->source, NULL, NULL, width, height, 1);
+    p->source.pixels = in;
+    stage_init(&p->stages[0], gauss_h_stage, &p->source, width, height, sizeof(float));
+    stage_init(&p->stages[1], gauss_v_stage, &p->stages[0], width, height, 1);
+    stage_init(&p->stages[2], sobel_stage, &p->stages[1], width, height, 1);
+    p->stages[0].taps = p->stages[1].taps = taps;
+    p->stages[2].iscratch_a = (int*)malloc(width * sizeof(int));
+    p->stages[2].iscratch_b = (int*)malloc(width * sizeof(int));
+    p->num_stages = 3;
+}
+
+// Opening (erode then dilate) or closing (dilate then erode).
+void pipeline_morph(Pipeline *p, const u8 *in, int width, int height, int closing) {
+    memset(p, 0, sizeof(Pipeline));
+    stage_init(&p->source, NULL, NULL, width, height, 1);
+    p->source.pixels = in;
+    Stage *prev = &p->source;
+    for (int i = 0; i < 4; i++) {
+        stage_init(&p->stages[i], (i & 1) ? morph_v_stage : morph_h_stage, prev, width, height, 1);
+        p->stages[i].is_max = (i < 2) ? closing : !closing;
+        if (!(i & 1)) {
+            p->stages[i].scratch_a = (u8*)malloc(width + 2 * KERNEL_SIZE);
+            p->stages[i].scratch_b = (u8*)malloc(width + 2 * KERNEL_SIZE);
+        }
+        prev = &p->stages[i];
+    }
+    p->num_stages = 4;
+}
+
+void pipeline_free(Pipeline *p) {
+    for (int i = 0; i < p->num_stages; i++) stage_free(&p->stages[i]);
+}
+
+long long pipeline_rows_computed(Pipeline *p) {
+    long long total = 0;
+    for (int i = 0; i < p->num_stages; i++) total += p->stages[i].rows_computed;
+    return total;
+}
+
+// Bands of BAND_ROWS are dealt round-robin to workers, each with its own
+// line buffers; a band re-derives the halo rows its stages need.
+double run_pipeline_bands(Pipeline workers[NUM_WORKERS], u8 *out, int width, int height,
+                          long long *rows_computed) {
+    int bands = (height + BAND_ROWS - 1) / BAND_ROWS;
+    for (int b = 0; b < bands; b++) {
+        Pipeline *p = &workers[b % NUM_WORKERS];
+        Stage *last = pipeline_last(p);
+        stage_restart(last);
+        int y1 = (b + 1) * BAND_ROWS < height ? (b + 1) * BAND_ROWS : height;
+        for (int y = b * BAND_ROWS; y < y1; y++) {
+            memcpy(out + (size_t)y * width, stage_row(last, y), width);
+        }
+    }
+    long long total = 0;
+    for (int w = 0; w < NUM_WORKERS; w++) total += pipeline_rows_computed(&workers[w]);
+    *rows_computed = total;
+    return (double)total / ((double)height * workers[0].num_stages);
+}
+
+// ---------------------------------------------------------------------------
+// Test image and reporting
+// ---------------------------------------------------------------------------
+
+void init_test_image(u8 *img, int width, int height) {
+    unsigned int seed = 42;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            int v = (x * 160) / width + (y * 64) / height;
+            if (((x / 240) + (y / 240)) & 1) v += 60;
+            if ((x + y) % 40 < 5) v = 230;
+            seed = seed * 1103515245 + 12345;
+            v += (int)((seed >> 16) % 17) - 8;
+            seed = seed * 1103515245 + 12345;
+            if ((seed >> 16) % 200 == 0) v = ((seed >> 8) & 1) ? 255 : 0;  // salt and pepper
+            img[y * width + x] = (u8)(v < 0 ? 0 : (v > 255 ? 255 : v));
+        }
+    }
+}
+
+long long count_diff(const u8 *a, const u8 *b, size_t n, int tolerance) {
+    long long count = 0;
+    for (size_t i = 0; i < n; i++) {
+        int d = a[i] - b[i];
+        if (d > tolerance || d < -tolerance) count++;
+    }
+    return count;
+}
+
+void report(const char *name, double seconds, long long mismatches) {
+    double mpix = (double)WIDTH * HEIGHT / 1e6;
+    printf("  %-30s %8.1f Mpix/s, mismatches %lld, %.6f seconds\n",
+           name, seconds > 0 ? mpix / seconds : 0.0, mismatches, seconds);
+}
+
+int main() {
+    int width = WIDTH, height = HEIGHT;
+    size_t pixels = (size_t)width * height;
+    u8 *image = (u8*)malloc(pixels);
+    u8 *ref = (u8*)malloc(pixels);
+    u8 *out = (u8*)malloc(pixels);
+    u8 *tmp = (u8*)malloc(pixels);
+    u8 *ref2 = (u8*)malloc(pixels);
+    float *ftmp = (float*)malloc(pixels * sizeof(float));
+    int *smooth = (int*)malloc(width * sizeof(int)), *diff = (int*)malloc(width * sizeof(int));
+    long long total_mismatches = 0;
+    init_test_image(image, width, height);
+
+    float kernel2d[KERNEL_SIZE][KERNEL_SIZE];
+    generate_gaussian_kernel(kernel2d, SIGMA);
+    float taps[KERNEL_SIZE];
+    float tap_sum = 0.0f;
+    for (int i = 0; i < KERNEL_SIZE; i++) {
+        int x = i - KERNEL_RADIUS;
+        taps[i] = exp(-(x * x) / (2.0 * SIGMA * SIGMA));
+        tap_sum += taps[i];
+    }
+    for (int i = 0; i < KERNEL_SIZE; i++) taps[i] /= tap_sum;
+
+    printf("Image pipeline %dx%d, kernel %d, bands of %d rows over %d workers\n",
+           width, height, KERNEL_SIZE, BAND_ROWS, NUM_WORKERS);
+
+    // Gaussian blur: 2D kernel vs separable (float rounding may move a pixel by 1)
+    clock_t start = clock();
+    apply_gaussian_blur(image, ref, width, height, kernel2d);
+    clock_t end = clock();
+    printf("Gaussian blur:\n");
+    report("34 2D kernel", (double)(end - start) / CLOCKS_PER_SEC, 0);
+    start = clock();
+    gaussian_separable(image, out, ftmp, width, height, taps);
+    end = clock();
+    long long off_by_more = count_diff(ref, out, pixels, 1);
+    total_mismatches += off_by_more;
+    report("separable", (double)(end - start) / CLOCKS_PER_SEC, off_by_more);
+    printf("  pixels off by one from float rounding: %lld\n", count_diff(ref, out, pixels, 0));
+    memcpy(tmp, out, pixels);
+
+    // Sobel on the blurred image: reference, separable, fused blur -> Sobel
+    printf("Sobel (on blurred image):\n");
+    start = clock();
+    sobel_filter(tmp, ref, width, height);
+    end = clock();
+    report("55 3x3 kernels", (double)(end - start) / CLOCKS_PER_SEC, 0);
+    start = clock();
+    sobel_separable(tmp, out, width, height, smooth, diff);
+    end = clock();
+    long long m = count_diff(ref, out, pixels, 0);
+    total_mismatches += m;
+    report("separable", (double)(end - start) / CLOCKS_PER_SEC, m);
+
+    Pipeline workers[NUM_WORKERS];
+    for (int w = 0; w < NUM_WORKERS; w++) pipeline_blur_sobel(&workers[w], image, width, height, taps);
+    long long rows_computed;
+    start = clock();
+    double overhead = run_pipeline_bands(workers, out, width, height, &rows_computed);
+    end = clock();
+    m = count_diff(ref, out, pixels, 0);
+    total_mismatches += m;
+    report("fused blur+sobel (banded)", (double)(end - start) / CLOCKS_PER_SEC, m);
+    printf("  stage rows computed %lld, halo overhead %.3fx\n", rows_computed, overhead);
+    for (int w = 0; w < NUM_WORKERS; w++) pipeline_free(&workers[w]);
+
+    // Median 5x5
+    printf("Median %dx%d:\n", KERNEL_SIZE, KERNEL_SIZE);
+    start = clock();
+    median_filter(image, ref, width, height, MEDIAN_REF_ROWS, KERNEL_SIZE);
+    end = clock();
+    double scaled = (double)(end - start) / CLOCKS_PER_SEC * height / MEDIAN_REF_ROWS;
+    report("45 insertion sort (scaled)", scaled, 0);
+    MedianState ms;
+    median_state_init(&ms, width, height, KERNEL_RADIUS);
+    start = clock();
+    int bands = (height + BAND_ROWS - 1) / BAND_ROWS;
+    for (int b = 0; b < bands; b++) {
+        int y1 = (b + 1) * BAND_ROWS < height ? (b + 1) * BAND_ROWS : height;
+        median_ctmf_rows(&ms, image, out, b * BAND_ROWS, y1);
+    }
+    end = clock();
+    m = count_diff(ref, out, (size_t)width * MEDIAN_REF_ROWS, 0);
+    total_mismatches += m;
+    report("constant-time histogram", (double)(end - start) / CLOCKS_PER_SEC, m);
+    median_state_free(&ms);
+
+    // Morphology: dilate, erode, opening, closing
+    printf("Morphology %dx%d:\n", KERNEL_SIZE, KERNEL_SIZE);
+    for (int op = 0; op < 4; op++) {
+        static const char *names[] = {"dilate", "erode", "opening", "closing"};
+        char label[64];
+        start = clock();
+        if (op < 2) {
+            morph_reference(image, ref, width, height, op == 0);
+        } else {
+            morph_reference(image, ref2, width, height, op == 3);
+            morph_reference(ref2, ref, width, height, op == 2);
+        }
+        end = clock();
+        snprintf(label, sizeof(label), "158 %s", names[op]);
+        report(label, (double)(end - start) / CLOCKS_PER_SEC, 0);
+
+        start = clock();
+        if (op < 2) {
+            morph_vhgw(image, out, tmp, width, height, op == 0);
+        } else {
+            morph_vhgw(image, ref2, tmp, width, height, op == 3);
+            morph_vhgw(ref2, out, tmp, width, height, op == 2);
+        }
+        end = clock();
+        m = count_diff(ref, out, pixels, 0);
+        total_mismatches += m;
+        snprintf(label, sizeof(label), "vHGW %s", names[op]);
+        report(label, (double)(end - start) / CLOCKS_PER_SEC, m);
+
+        if (op >= 2) {
+            for (int w = 0; w < NUM_WORKERS; w++) pipeline_morph(&workers[w], image, width, height, op == 3);
+            start = clock();
+            overhead = run_pipeline_bands(workers, out, width, height, &rows_computed);
+            end = clock();
+            m = count_diff(ref, out, pixels, 0);
+            total_mismatches += m;
+            snprintf(label, sizeof(label), "fused %s (banded)", names[op]);
+            report(label, (double)(end - start) / CLOCKS_PER_SEC, m);
+            printf("  halo overhead %.3fx\n", overhead);
+            for (int w = 0; w < NUM_WORKERS; w++) pipeline_free(&workers[w]);
+        }
+    }
+
+    // Bilateral: grid over the whole image, brute force (139) on a crop
+    printf("Bilateral (sigma_s %.1f, sigma_r %.2f):\n", BILATERAL_SIGMA_S, BILATERAL_SIGMA_R);
+    BilateralGrid bg;
+    bgrid_init(&bg, width, BAND_ROWS);
+    start = clock();
+    for (int b = 0; b < bands; b++) {
+        int y1 = (b + 1) * BAND_ROWS < height ? (b + 1) * BAND_ROWS : height;
+        bilateral_grid_rows(&bg, image, out, width, height, b * BAND_ROWS, y1);
+    }
+    end = clock();
+    report("bilateral grid (banded)", (double)(end - start) / CLOCKS_PER_SEC, 0);
+    bgrid_free(&bg);
+
+    int crop = BILATERAL_CROP, cx = width / 2 - crop / 2, cy = height / 2 - crop / 2;
+    double *crop_in = (double*)malloc((size_t)crop * crop * sizeof(double));
+    double *crop_out = (double*)malloc((size_t)crop * crop * sizeof(double));
+    for (int y = 0; y < crop; y++) {
+        for (int x = 0; x < crop; x++) crop_in[y * crop + x] = image[(size_t)(cy + y) * width + cx + x] / 255.0;
+    }
+    start = clock();
+    bilateral_filter(crop_in, crop_out, crop, crop, BILATERAL_SIGMA_S, BILATERAL_SIGMA_R);
+    end = clock();
+    double crop_seconds = (double)(end - start) / CLOCKS_PER_SEC;
+    double abs_err = 0.0;
+    int border = KERNEL_RADIUS, samples = 0;
+    for (int y = border; y < crop - border; y++) {
+        for (int x = border; x < crop - border; x++) {
+            abs_err += fabs(crop_out[y * crop + x] * 255.0 - out[(size_t)(cy + y) * width + cx + x]);
+            samples++;
+        }
+    }
+    printf("  %-30s %8.1f Mpix/s on %dx%d crop, %.6f seconds\n", "139 brute force",
+           crop_seconds > 0 ? (double)crop * crop / 1e6 / crop_seconds : 0.0, crop, crop, crop_seconds);
+    printf("  grid vs brute force mean abs error %.3f grey levels\n", abs_err / samples);
+
+    printf("Total mismatches: %lld\n", total_mismatches);
+
+    free(crop_in);
+    free(crop_out);
+    free(image);
+    free(ref);
+    free(ref2);
+    free(out);
+    free(tmp);
+    free(ftmp);
+    free(smooth);
+    free(diff);
+    return 0;
+}
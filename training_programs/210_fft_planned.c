@@ -0,0 +1,500 @@
+// Planned iterative FFT: cached twiddle tables, radix-2^2 passes, SoA layout
+// Complex, real-input and batched transforms benchmarked against 29 (recursive) and 43 (radix-2)
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#define PI 3.14159265358979323846
+#define MIN_LOG 8
+#ifdef FULL_SIZE
+#define MAX_LOG 22
+#define POINTS_PER_SIZE (1 << 19)      // transforms per size repeat up to this many points
+#define RECURSIVE_MAX_LOG 18           // 29's malloc-per-level recursion is only timed up to here
+#define RECURSIVE_POINTS (1 << 16)
+#else
+#define MAX_LOG 16                     // -DFULL_SIZE for sizes up to 2^22
+#define POINTS_PER_SIZE (1 << 16)      // transforms per size repeat up to this many points
+#define RECURSIVE_MAX_LOG 16           // 29's malloc-per-level recursion is only timed up to here
+#define RECURSIVE_POINTS (1 << 14)
+#endif
+#define BATCH_MAX_LOG 12               // batched mode for short transforms
+#define CHECK_LOG 10                   // naive DFT check size
+
+// ---------------------------------------------------------------------------
+// Reference transforms (29_fast_fourier.c, 43_fft_radix2.c)
+// ---------------------------------------------------------------------------
+
+typedef struct Complex {
+    double real;
+    double imag;
+} Complex;
+
+Complex add(Complex a, Complex b) {
+    Complex result;
+    result.real = a.real + b.real;
+    result.imag = a.imag + b.imag;
+    return result;
+}
+
+Complex sub(Complex a, Complex b) {
+    Complex result;
+    result.real = a.real - b.real;
+    result.imag = a.imag - b.imag;
+    return result;
+}
+
+Complex mul(Complex a, Complex b) {
+    Complex result;
+    result.real = a.real * b.real - a.imag * b.imag;
+    result.imag = a.real * b.imag + a.imag * b.real;
+    return result;
+}
+
+void fft_recursive(Complex* x, int n) {
+    if (n <= 1) return;
+
+    Complex* even = (Complex*)malloc((n / 2) * sizeof(Complex));
+    Complex* odd = (Complex*)malloc((n / 2) * sizeof(Complex));
+
+    for (int i = 0; i < n / 2; i++) {
+        even[i] = x[i * 2];
+        odd[i] = x[i * 2 + 1];
+    }
+
+    fft_recursive(even, n / 2);
+    fft_recursive(odd, n / 2);
+
+    for (int k = 0; k < n / 2; k++) {
+        Complex t;
+        t.real = cos(-2 * PI * k / n);
+        t.imag = sin(-2 * PI * k / n);
+        t = mul(t, odd[k]);
+
+        x[k] = add(even[k], t);
+        x[k + n / 2] = sub(even[k], t);
+    }
+
+    free(even);
+    free(odd);
+}
+
+unsigned int reverse_bits(unsigned int x, int log_n) {
+    unsigned int result = 0;
+    for (int i = 0; i < log_n; i++) {
+        result = (result << 1) | (x & 1);
+        x >>= 1;
+    }
+    return result;
+}
+
+void fft_radix2(Complex *data, int n) {
+    int log_n = 0;
+    while ((1 << log_n) < n) log_n++;
+    for (unsigned int i = 0; i < (unsigned int)n; i++) {
+        unsigned int j = reverse_bits(i, log_n);
+        if (i < j) {
+            Complex temp = data[i];
+            data[i] = data[j];
+            data[j] = temp;
+        }
+    }
+
+    for (int stage = 1; stage <= log_n; stage++) {
+        int m = 1 << stage;
+        int m2 = m >> 1;
+        double theta = -2.0 * PI / m;
+        Complex wm = {cos(theta), sin(theta)};
+
+        for (int k = 0; k < n; k += m) {
+            Complex w = {1.0, 0.0};
+            for (int j = 0; j < m2; j++) {
+                Complex t;
+                t.real = w.real * data[k + j + m2].real - w.imag * data[k + j + m2].imag;
+                t.imag = w.real * data[k + j + m2].imag + w.imag * data[k + j + m2].real;
+                Complex u = data[k + j];
+                data[k + j].real = u.real + t.real;
+                data[k + j].imag = u.imag + t.imag;
+                data[k + j + m2].real = u.real - t.real;
+                data[k + j + m2].imag = u.imag - t.imag;
+                double w_real = w.real * wm.real - w.imag * wm.imag;
+                double w_imag = w.real * wm.imag + w.imag * wm.real;
+                w.real = w_real;
+                w.imag = w_imag;
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// FFT plan. Complex data is SoA (separate re[] and im[] arrays) so every
+// butterfly loop is a unit-stride stream over four arrays.
+// Stage tables hold W_M^j = exp(-2 pi i j / M), j < M/2, at offset M/2 - 1.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    int n;
+    int log_n;
+    unsigned int *rev;
+    double *tw_re;
+    double *tw_im;
+} FftPlan;
+
+FftPlan *fft_plan_create(int n) {
+    FftPlan *p = (FftPlan*)malloc(sizeof(FftPlan));
+    p->n = n;
+    p->log_n = 0;
+    while ((1 << p->log_n) < n) p->log_n++;
+    p->rev = (unsigned int*)malloc(n * sizeof(unsigned int));
+    p->rev[0] = 0;
+    for (int i = 1; i < n; i++) {
+        p->rev[i] = (p->rev[i >> 1] >> 1) | ((unsigned int)(i & 1) << (p->log_n - 1));
+    }
+    int table = n > 1 ? n - 1 : 1;
+    p->tw_re = (double*)malloc(table * sizeof(double));
+    p->tw_im = (double*)malloc(table * sizeof(double));
+    for (int m = 2; m <= n; m <<= 1) {
+        double *re = p->tw_re + (m / 2 - 1), *im = p->tw_im + (m / 2 - 1);
+        for (int j = 0; j < m / 2; j++) {
+            re[j] = cos(-2.0 * PI * j / m);
+            im[j] = sin(-2.0 * PI * j / m);
+        }
+    }
+    return p;
+}
+
+void fft_plan_destroy(FftPlan *p) {
+    free(p->rev);
+    free(p->tw_re);
+    free(p->tw_im);
+    free(p);
+}
+
+static void fft_permute(const FftPlan *p, double *re, double *im) {
+    for (int i = 0; i < p->n; i++) {
+        unsigned int j = p->rev[i];
+        if ((unsigned int)i < j) {
+            double t = re[i]; re[i] = re[j]; re[j] = t;
+            t = im[i]; im[i] = im[j]; im[j] = t;
+        }
+    }
+}
+
+static void fft_pass_radix2(double *re, double *im, int n) {
+    for (int k = 0; k < n; k += 2) {
+        double ar = re[k], ai = im[k], br = re[k + 1], bi = im[k + 1];
+        re[k] = ar + br; im[k] = ai + bi;
+        re[k + 1] = ar - br; im[k + 1] = ai - bi;
+    }
+}
+
+// Two radix-2 stages (sizes 2L and 4L) fused: four points per butterfly, two
+// complex multiplies, and the W_4L^L = -i factor applied as a swap.
+static void fft_pass_radix4(const FftPlan *p, double *re, double *im, int L) {
+    int n = p->n;
+    const double *w2r = p->tw_re + (L - 1), *w2i = p->tw_im + (L - 1);
+    const double *w4r = p->tw_re + (2 * L - 1), *w4i = p->tw_im + (2 * L - 1);
+    for (int k = 0; k < n; k += 4 * L) {
+        double *r0 = re + k, *r1 = r0 + L, *r2 = r1 + L, *r3 = r2 + L;
+        double *i0 = im + k, *i1 = i0 + L, *i2 = i1 + L, *i3 = i2 + L;
+        for (int j = 0; j < L; j++) {
+            double ar = w2r[j], ai = w2i[j], br = w4r[j], bi = w4i[j];
+            double a1r = r1[j] * ar - i1[j] * ai, a1i = r1[j] * ai + i1[j] * ar;
+            double a3r = r3[j] * ar - i3[j] * ai, a3i = r3[j] * ai + i3[j] * ar;
+            double b0r = r0[j] + a1r, b0i = i0[j] + a1i;
+            double b1r = r0[j] - a1r, b1i = i0[j] - a1i;
+            double b2r = r2[j] + a3r, b2i = i2[j] + a3i;
+            double b3r = r2[j] - a3r, b3i = i2[j] - a3i;
+            double c2r = b2r * br - b2i * bi, c2i = b2r * bi + b2i * br;
+            double pr = b3r * br - b3i * bi, pi = b3r * bi + b3i * br;
+            double c3r = pi, c3i = -pr;
+            r0[j] = b0r + c2r; i0[j] = b0i + c2i;
+            r2[j] = b0r - c2r; i2[j] = b0i - c2i;
+            r1[j] = b1r + c3r; i1[j] = b1i + c3i;
+            r3[j] = b1r - c3r; i3[j] = b1i - c3i;
+        }
+    }
+}
+
+void fft_forward(const FftPlan *p, double *re, double *im) {
+    if (p->n < 2) return;
+    fft_permute(p, re, im);
+    int L = 1;
+    if (p->log_n & 1) {
+        fft_pass_radix2(re, im, p->n);
+        L = 2;
+    }
+    for (; L < p->n; L *= 4) fft_pass_radix4(p, re, im, L);
+}
+
+// Swapping re and im conjugates input and output (times i), which turns the
+// forward transform into the unscaled inverse.
+void fft_inverse(const FftPlan *p, double *re, double *im) {
+    fft_forward(p, im, re);
+    double scale = 1.0 / p->n;
+    for (int i = 0; i < p->n; i++) {
+        re[i] *= scale;
+        im[i] *= scale;
+    }
+}
+
+// Batch of transforms stored back to back; each pass sweeps the whole batch
+// so a stage's twiddles stay in cache across transforms.
+void fft_forward_batch(const FftPlan *p, double *re, double *im, int batch) {
+    int n = p->n;
+    if (n < 2) return;
+    for (int b = 0; b < batch; b++) fft_permute(p, re + (size_t)b * n, im + (size_t)b * n);
+    int L = 1;
+    if (p->log_n & 1) {
+        fft_pass_radix2(re, im, n * batch);
+        L = 2;
+    }
+    for (; L < n; L *= 4) {
+        for (int b = 0; b < batch; b++) fft_pass_radix4(p, re + (size_t)b * n, im + (size_t)b * n, L);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Real-input FFT: n real samples packed as n/2 complex points, one half-size
+// transform, then a split step using W_n^k.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    int n;
+    FftPlan *half;
+    double *w_re, *w_im;      // W_n^k, k < n/2
+    double *zr, *zi;          // packed work arrays
+} RealFftPlan;
+
+RealFftPlan *rfft_plan_create(int n) {
+    RealFftPlan *p = (RealFftPlan*)malloc(sizeof(RealFftPlan));
+    p->n = n;
+    p->half = fft_plan_create(n / 2);
+    p->w_re = (double*)malloc((n / 2) * sizeof(double));
+    p->w_im = (double*)malloc((n / 2) * sizeof(double));
+    for (int k = 0; k < n / 2; k++) {
+        p->w_re[k] = cos(-2.0 * PI * k / n);
+        p->w_im[k] = sin(-2.0 * PI * k / n);
+    }
+    p->zr = (double*)malloc((n / 2) * sizeof(double));
+    p->zi = (double*)malloc((n / 2) * sizeof(double));
+    return p;
+}
+
+void rfft_plan_destroy(RealFftPlan *p) {
+    fft_plan_destroy(p->half);
+    free(p->w_re);
+    free(p->w_im);
+    free(p->zr);
+    free(p->zi);
+    free(p);
+}
+
+// x[n] -> X[0..n/2] (n/2 + 1 bins; the rest follow from conjugate symmetry)
+void rfft_forward(RealFftPlan *p, const double *x, double *out_re, double *out_im) {
+    int h = p->n / 2;
+    for (int m = 0; m < h; m++) {
+        p->zr[m] = x[2 * m];
+        p->zi[m] = x[2 * m + 1];
+    }
+    fft_forward(p->half, p->zr, p->zi);
+    for (int k = 0; k <= h; k++) {
+        int a = k % h, b = (h - k) % h;
+        double zr = p->zr[a], zi = p->zi[a], cr = p->zr[b], ci = -p->zi[b];
+        double er = 0.5 * (zr + cr), ei = 0.5 * (zi + ci);        // even samples
+        double orr = 0.5 * (zi - ci), oi = -0.5 * (zr - cr);      // odd samples: (Z - conj)/2i
+        double wr = k < h ? p->w_re[k] : -1.0, wi = k < h ? p->w_im[k] : 0.0;
+        out_re[k] = er + wr * orr - wi * oi;
+        out_im[k] = ei + wr * oi + wi * orr;
+    }
+}
+
+void rfft_inverse(RealFftPlan *p, const double *in_re, const double *in_im, double *x) {
+    int h = p->n / 2;
+    for (int k = 0; k < h; k++) {
+        double xr = in_re[k], xi = in_im[k], cr = in_re[h - k], ci = -in_im[h - k];
+        double er = 0.5 * (xr + cr), ei = 0.5 * (xi + ci);
+        double dr = 0.5 * (xr - cr), di = 0.5 * (xi - ci);
+        // odd = d / W^k = d * conj(W^k)
+        double wr = p->w_re[k], wi = p->w_im[k];
+        double orr = dr * wr + di * wi, oi = di * wr - dr * wi;
+        p->zr[k] = er - oi;
+        p->zi[k] = ei + orr;
+    }
+    fft_inverse(p->half, p->zr, p->zi);
+    for (int m = 0; m < h; m++) {
+        x[2 * m] = p->zr[m];
+        x[2 * m + 1] = p->zi[m];
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Checks and benchmark
+// ---------------------------------------------------------------------------
+
+void fill_signal(double *re, double *im, int n, unsigned int seed) {
+    for (int i = 0; i < n; i++) {
+        seed = seed * 1103515245 + 12345;
+        re[i] = (double)((seed >> 8) % 1000) / 100.0 - 5.0;
+        seed = seed * 1103515245 + 12345;
+        im[i] = im ? (double)((seed >> 8) % 1000) / 100.0 - 5.0 : 0.0;
+    }
+}
+
+double max_error(const double *ar, const double *ai, const double *br, const double *bi, int n) {
+    double m = 0.0;
+    for (int i = 0; i < n; i++) {
+        double d = fabs(ar[i] - br[i]) + fabs(ai[i] - bi[i]);
+        if (d > m) m = d;
+    }
+    return m;
+}
+
+int check_accuracy(void) {
+    int n = 1 << CHECK_LOG, failures = 0;
+    double *re = (double*)malloc(n * sizeof(double)), *im = (double*)malloc(n * sizeof(double));
+    double *xr = (double*)malloc(n * sizeof(double)), *xi = (double*)malloc(n * sizeof(double));
+    double *dr = (double*)malloc(n * sizeof(double)), *di = (double*)malloc(n * sizeof(double));
+    fill_signal(xr, xi, n, 7);
+
+    for (int k = 0; k < n; k++) {
+        double sr = 0.0, si = 0.0;
+        for (int t = 0; t < n; t++) {
+            double angle = -2.0 * PI * (double)((long long)k * t % n) / n;
+            sr += xr[t] * cos(angle) - xi[t] * sin(angle);
+            si += xr[t] * sin(angle) + xi[t] * cos(angle);
+        }
+        dr[k] = sr;
+        di[k] = si;
+    }
+    FftPlan *p = fft_plan_create(n);
+    memcpy(re, xr, n * sizeof(double));
+    memcpy(im, xi, n * sizeof(double));
+    fft_forward(p, re, im);
+    double dft_err = max_error(re, im, dr, di, n);
+    fft_inverse(p, re, im);
+    double round_err = max_error(re, im, xr, xi, n);
+
+    RealFftPlan *rp = rfft_plan_create(n);
+    double *rr = (double*)malloc((n / 2 + 1) * sizeof(double)), *ri = (double*)malloc((n / 2 + 1) * sizeof(double));
+    memset(im, 0, n * sizeof(double));
+    memcpy(re, xr, n * sizeof(double));
+    fft_forward(p, re, im);
+    rfft_forward(rp, xr, rr, ri);
+    double real_err = max_error(rr, ri, re, im, n / 2 + 1);
+    double *back = (double*)malloc(n * sizeof(double));
+    rfft_inverse(rp, rr, ri, back);
+    double real_round = 0.0;
+    for (int i = 0; i < n; i++) {
+        double d = fabs(back[i] - xr[i]);
+        if (d > real_round) real_round = d;
+    }
+
+    printf("Accuracy n=%d: vs naive DFT %.2e, roundtrip %.2e, real vs complex %.2e, real roundtrip %.2e\n",
+           n, dft_err, round_err, real_err, real_round);
+    if (dft_err > 1e-8 || round_err > 1e-12 || real_err > 1e-9 || real_round > 1e-12) failures++;
+
+    fft_plan_destroy(p);
+    rfft_plan_destroy(rp);
+    free(re); free(im); free(xr); free(xi); free(dr); free(di);
+    free(rr); free(ri); free(back);
+    return failures;
+}
+
+double mflops(int n, int log_n, int reps, double seconds) {
+    return seconds > 0 ? 5.0 * n * log_n * reps / seconds / 1e6 : 0.0;
+}
+
+int main() {
+    int failures = check_accuracy();
+    int max_n = 1 << MAX_LOG;
+    double *re = (double*)malloc(max_n * sizeof(double)), *im = (double*)malloc(max_n * sizeof(double));
+    double *xr = (double*)malloc(max_n * sizeof(double)), *xi = (double*)malloc(max_n * sizeof(double));
+    double *spec_re = (double*)malloc((max_n / 2 + 1) * sizeof(double));
+    double *spec_im = (double*)malloc((max_n / 2 + 1) * sizeof(double));
+    Complex *aos = (Complex*)malloc(max_n * sizeof(Complex));
+    double worst_error = 0.0;
+
+    printf("%-6s %12s %12s %12s %12s %12s  (MFLOPS, 5 n log2 n)\n",
+           "log2n", "29 recursive", "43 radix-2", "planned", "real-input", "batched");
+    clock_t total_start = clock();
+    for (int lg = MIN_LOG; lg <= MAX_LOG; lg++) {
+        int n = 1 << lg;
+        int reps = POINTS_PER_SIZE / n > 0 ? POINTS_PER_SIZE / n : 1;
+        fill_signal(xr, xi, n, 42 + lg);
+
+        double rec = 0.0;
+        if (lg <= RECURSIVE_MAX_LOG) {
+            int rreps = RECURSIVE_POINTS / n > 0 ? RECURSIVE_POINTS / n : 1;
+            clock_t start = clock();
+            for (int r = 0; r < rreps; r++) {
+                for (int i = 0; i < n; i++) { aos[i].real = xr[i]; aos[i].imag = xi[i]; }
+                fft_recursive(aos, n);
+            }
+            rec = mflops(n, lg, rreps, (double)(clock() - start) / CLOCKS_PER_SEC);
+        }
+
+        clock_t start = clock();
+        for (int r = 0; r < reps; r++) {
+            for (int i = 0; i < n; i++) { aos[i].real = xr[i]; aos[i].imag = xi[i]; }
+            fft_radix2(aos, n);
+        }
+        double r2 = mflops(n, lg, reps, (double)(clock() - start) / CLOCKS_PER_SEC);
+
+        FftPlan *p = fft_plan_create(n);
+        start = clock();
+        for (int r = 0; r < reps; r++) {
+            memcpy(re, xr, n * sizeof(double));
+            memcpy(im, xi, n * sizeof(double));
+            fft_forward(p, re, im);
+        }
+        double planned = mflops(n, lg, reps, (double)(clock() - start) / CLOCKS_PER_SEC);
+
+        // Planned vs 43 on the same input, relative to the spectrum's scale
+        double scale = 0.0, err = 0.0;
+        for (int i = 0; i < n; i++) {
+            double mag = fabs(aos[i].real) + fabs(aos[i].imag);
+            if (mag > scale) scale = mag;
+            double d = fabs(aos[i].real - re[i]) + fabs(aos[i].imag - im[i]);
+            if (d > err) err = d;
+        }
+        if (err / scale > worst_error) worst_error = err / scale;
+
+        RealFftPlan *rp = rfft_plan_create(n);
+        start = clock();
+        for (int r = 0; r < reps; r++) rfft_forward(rp, xr, spec_re, spec_im);
+        // A real transform is half the work of a complex one of the same length
+        double real = 0.5 * mflops(n, lg, reps, (double)(clock() - start) / CLOCKS_PER_SEC);
+        rfft_plan_destroy(rp);
+
+        double batched = 0.0;
+        if (lg <= BATCH_MAX_LOG) {
+            int batch = max_n / n;
+            int breps = POINTS_PER_SIZE / (n * batch) > 0 ? POINTS_PER_SIZE / (n * batch) : 1;
+            for (int b = 0; b < batch; b++) {
+                memcpy(re + (size_t)b * n, xr, n * sizeof(double));
+                memcpy(im + (size_t)b * n, xi, n * sizeof(double));
+            }
+            start = clock();
+            for (int r = 0; r < breps; r++) fft_forward_batch(p, re, im, batch);
+            batched = mflops(n, lg, breps * batch, (double)(clock() - start) / CLOCKS_PER_SEC);
+        }
+        fft_plan_destroy(p);
+
+        char rec_s[16] = "-", batch_s[16] = "-";
+        if (lg <= RECURSIVE_MAX_LOG) snprintf(rec_s, sizeof(rec_s), "%.1f", rec);
+        if (lg <= BATCH_MAX_LOG) snprintf(batch_s, sizeof(batch_s), "%.1f", batched);
+        printf("%-6d %12s %12.1f %12.1f %12.1f %12s\n", lg, rec_s, r2, planned, real, batch_s);
+    }
+    clock_t total_end = clock();
+    if (worst_error > 1e-8) failures++;   // 43's twiddle recurrence drifts with n
+
+    printf("Planned FFT: sizes 2^%d..2^%d, worst relative error vs 43 %.2e, %.6f seconds\n",
+           MIN_LOG, MAX_LOG, worst_error, (double)(total_end - total_start) / CLOCKS_PER_SEC);
+    printf("Failures: %d\n", failures);
+
+    free(re); free(im); free(xr); free(xi);
+    free(spec_re); free(spec_im); free(aos);
+    return 0;
+}
@@ -0,0 +1,1033 @@
+// Force engine: SoA particles, cell list + Verlet list for Lennard-Jones MD, Barnes-Hut octree for gravity
+// Race-free worker partitions, energy checks against 36_nbody_simulation.c and 143_molecular_dynamics.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#define NUM_WORKERS 8
+
+// Lennard-Jones (reduced units, mass 1)
+#define LJ_CUTOFF 2.5
+#define LJ_SKIN 0.3
+#define LJ_DENSITY 0.8
+#define LJ_TEMPERATURE 1.0
+#define LJ_DT 0.004
+#ifdef FULL_SIZE
+#define LJ_ENERGY_STEPS 100   // energy-drift run at the smallest size
+#else
+#define LJ_ENERGY_STEPS 25
+#endif
+#define LJ_BENCH_STEPS 10
+
+// Barnes-Hut (G = 1, total mass 1)
+#define BH_SOFTENING 1e-4     // added to r^2, as in 36
+#define BH_LEAF_SIZE 8
+#define BH_MAX_DEPTH 32
+#define BH_SAMPLE 256         // targets checked against direct summation
+#define BH_DT 1e-3
+#define BH_ENERGY_STEPS 5
+
+// 36_nbody_simulation.c setup
+#define N_BODIES 256
+#define TIME_STEPS 50
+#define DT 0.01
+#define G 6.674e-11
+#define SOFTENING 1e-9
+
+// 143_molecular_dynamics.c setup
+#define NUM_PARTICLES 500
+#ifdef FULL_SIZE
+#define NUM_STEPS 100
+#else
+#define NUM_STEPS 25          // 143 runs 100; its O(n^2) forces dominate the default run
+#endif
+#define MD_DT 0.001
+#define BOX_SIZE 10.0
+
+#ifdef FULL_SIZE
+static const int particle_counts[] = {10000, 100000, 1000000};
+#else
+static const int particle_counts[] = {1000, 4000};  // -DFULL_SIZE for 10^4..10^6
+#endif
+#define NUM_SIZES (int)(sizeof(particle_counts) / sizeof(particle_counts[0]))
+
+// ---------------------------------------------------------------------------
+// SoA particle store
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    int n;
+    double *x, *y, *z;
+    double *vx, *vy, *vz;
+    double *ax, *ay, *az;
+    double *mass;
+} Particles;
+
+void particles_alloc(Particles *p, int n) {
+    p->n = n;
+    double **fields[] = {&p->x, &p->y, &p->z, &p->vx, &p->vy, &p->vz, &p->ax, &p->ay, &p->az, &p->mass};
+    for (int f = 0; f < 10; f++) *fields[f] = (double*)calloc(n, sizeof(double));
+}
+
+void particles_free(Particles *p) {
+    double *fields[] = {p->x, p->y, p->z, p->vx, p->vy, p->vz, p->ax, p->ay, p->az, p->mass};
+    for (int f = 0; f < 10; f++) free(fields[f]);
+}
+
+// Reorder every field so that new slot i holds old particle perm[i].
+void particles_permute(Particles *p, const int *perm, double *scratch) {
+    double *fields[] = {p->x, p->y, p->z, p->vx, p->vy, p->vz, p->ax, p->ay, p->az, p->mass};
+    for (int f = 0; f < 10; f++) {
+        double *a = fields[f];
+        for (int i = 0; i < p->n; i++) scratch[i] = a[perm[i]];
+        memcpy(a, scratch, p->n * sizeof(double));
+    }
+}
+
+static inline double rand_unit(unsigned int *seed) {
+    *seed = *seed * 1103515245 + 12345;
+    return ((*seed >> 8) & 0xFFFFFF) / (double)0x1000000;
+}
+
+double kinetic_energy(const Particles *p) {
+    double ke = 0.0;
+    for (int i = 0; i < p->n; i++) {
+        ke += 0.5 * p->mass[i] * (p->vx[i] * p->vx[i] + p->vy[i] * p->vy[i] + p->vz[i] * p->vz[i]);
+    }
+    return ke;
+}
+
+// ---------------------------------------------------------------------------
+// Lennard-Jones: cell list and Verlet neighbour list in a periodic box.
+// The potential is truncated and shifted at LJ_CUTOFF so energy is continuous.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    double box;
+    double cutoff;
+    double skin;
+    double shift;             // V(cutoff)
+    int cells_per_dim;
+    double cell_size;
+    int *cell_start;          // cells + 1 offsets into the cell-sorted order
+    int *cell_of;
+    int *perm;
+    double *scratch;
+    int *nbr_start;           // full list: n + 1 offsets
+    int *nbr;
+    size_t nbr_capacity;
+    double *x0, *y0, *z0;     // positions at the last build
+    int rebuilds;
+    long long pair_checks;
+} NeighborList;
+
+static inline double lj_energy(double r2) {
+    double inv6 = 1.0 / (r2 * r2 * r2);
+    return 4.0 * inv6 * (inv6 - 1.0);
+}
+
+void nlist_init(NeighborList *nl, int n, double box) {
+    memset(nl, 0, sizeof(NeighborList));
+    nl->box = box;
+    nl->cutoff = LJ_CUTOFF;
+    nl->skin = LJ_SKIN;
+    nl->shift = lj_energy(LJ_CUTOFF * LJ_CUTOFF);
+    nl->cells_per_dim = (int)(box / (LJ_CUTOFF + LJ_SKIN));
+    if (nl->cells_per_dim < 3) nl->cells_per_dim = 3;
+    nl->cell_size = box / nl->cells_per_dim;
+    int cells = nl->cells_per_dim * nl->cells_per_dim * nl->cells_per_dim;
+    nl->cell_start = (int*)malloc((cells + 1) * sizeof(int));
+    nl->cell_of = (int*)malloc(n * sizeof(int));
+    nl->perm = (int*)malloc(n * sizeof(int));
+    nl->scratch = (double*)malloc(n * sizeof(double));
+    nl->nbr_start = (int*)malloc((n + 1) * sizeof(int));
+    nl->nbr_capacity = (size_t)n * 64;
+    nl->nbr = (int*)malloc(nl->nbr_capacity * sizeof(int));
+    nl->x0 = (double*)malloc(n * sizeof(double));
+    nl->y0 = (double*)malloc(n * sizeof(double));
+    nl->z0 = (double*)malloc(n * sizeof(double));
+}
+
+void nlist_free(NeighborList *nl) {
+    free(nl->cell_start);
+    free(nl->cell_of);
+    free(nl->perm);
+    free(nl->scratch);
+    free(nl->nbr_start);
+    free(nl->nbr);
+    free(nl->x0);
+    free(nl->y0);
+    free(nl->z0);
+}
+
+static inline double min_image(double d, double box) {
+    if (d > 0.5 * box) d -= box;
+    else if (d < -0.5 * box) d += box;
+    return d;
+}
+
+static inline int cell_coord(double v, const NeighborList *nl) {
+    int c = (int)(v / nl->cell_size);
+    return c >= nl->cells_per_dim ? nl->cells_per_dim - 1 : (c < 0 ? 0 : c);
+}
+
+// Counting sort by cell, then reorder the particles so each cell is contiguous.
+void cell_sort(NeighborList *nl, Particles *p) {
+    int m = nl->cells_per_dim, cells = m * m * m;
+    memset(nl->cell_start, 0, (cells + 1) * sizeof(int));
+    for (int i = 0; i < p->n; i++) {
+        int c = (cell_coord(p->z[i], nl) * m + cell_coord(p->y[i], nl)) * m + cell_coord(p->x[i], nl);
+        nl->cell_of[i] = c;
+        nl->cell_start[c + 1]++;
+    }
+    for (int c = 0; c < cells; c++) nl->cell_start[c + 1] += nl->cell_start[c];
+    int *fill = (int*)malloc(cells * sizeof(int));
+    memcpy(fill, nl->cell_start, cells * sizeof(int));
+    for (int i = 0; i < p->n; i++) nl->perm[fill[nl->cell_of[i]]++] = i;
+    free(fill);
+    particles_permute(p, nl->perm, nl->scratch);
+}
+
+// Visit the 27 periodic neighbour cells of cell (cx, cy, cz).
+#define FOR_NEIGHBOR_CELLS(nl, cx, cy, cz, cell_var)                                   \
+    for (int dz_ = -1; dz_ <= 1; dz_++)                                                 \
+        for (int dy_ = -1; dy_ <= 1; dy_++)                                             \
+            for (int dx_ = -1; dx_ <= 1; dx_++)                                         \
+                for (int cell_var = ((((cz) + dz_ + (nl)->cells_per_dim) % (nl)->cells_per_dim) \
+                                     * (nl)->cells_per_dim +                            \
+                                     (((cy) + dy_ + (nl)->cells_per_dim) % (nl)->cells_per_dim)) \
+                                    * (nl)->cells_per_dim +                             \
+                                    (((cx) + dx_ + (nl)->cells_per_dim) % (nl)->cells_per_dim), \
+                         once_ = 1; once_; once_ = 0)
+
+// Full (both directions) list within cutoff + skin, built per worker chunk so
+// each worker only writes its own particles' entries.
+void nlist_build(NeighborList *nl, Particles *p) {
+    cell_sort(nl, p);
+    int n = p->n;
+    double reach2 = (nl->cutoff + nl->skin) * (nl->cutoff + nl->skin);
+    size_t count = 0;
+    for (int w = 0; w < NUM_WORKERS; w++) {
+        int i0 = (int)((long long)n * w / NUM_WORKERS), i1 = (int)((long long)n * (w + 1) / NUM_WORKERS);
+        for (int i = i0; i < i1; i++) {
+            nl->nbr_start[i] = (int)count;
+            int cx = cell_coord(p->x[i], nl), cy = cell_coord(p->y[i], nl), cz = cell_coord(p->z[i], nl);
+            FOR_NEIGHBOR_CELLS(nl, cx, cy, cz, c) {
+                for (int j = nl->cell_start[c]; j < nl->cell_start[c + 1]; j++) {
+                    if (j == i) continue;
+                    double dx = min_image(p->x[i] - p->x[j], nl->box);
+                    double dy = min_image(p->y[i] - p->y[j], nl->box);
+                    double dz = min_image(p->z[i] - p->z[j], nl->box);
+                    nl->pair_checks++;
+                    if (dx * dx + dy * dy + dz * dz < reach2) {
+                        if (count == nl->nbr_capacity) {
+                            nl->nbr_capacity *= 2;
+                            nl->nbr = (int*)realloc(nl->nbr, nl->nbr_capacity * sizeof(int));
+                        }
+                        nl->nbr[count++] = j;
+                    }
+                }
+            }
+        }
+    }
+    nl->nbr_start[n] = (int)count;
+    memcpy(nl->x0, p->x, n * sizeof(double));
+    memcpy(nl->y0, p->y, n * sizeof(double));
+    memcpy(nl->z0, p->z, n * sizeof(double));
+    nl->rebuilds++;
+}
+
+// Rebuild once any particle has moved more than half the skin.
+int nlist_needs_rebuild(const NeighborList *nl, const Particles *p) {
+    double limit2 = 0.25 * nl->skin * nl->skin;
+    for (int i = 0; i < p->n; i++) {
+        double dx = min_image(p->x[i] - nl->x0[i], nl->box);
+        double dy = min_image(p->y[i] - nl->y0[i], nl->box);
+        double dz = min_image(p->z[i] - nl->z0[i], nl->box);
+        if (dx * dx + dy * dy + dz * dz > limit2) return 1;
+    }
+    return 0;
+}
+
+// Each worker owns a contiguous range of i and writes only a[i]; every pair is
+// evaluated from both sides, so the energy is halved.
+double lj_forces_verlet(const NeighborList *nl, Particles *p) {
+    double rc2 = nl->cutoff * nl->cutoff, box = nl->box, pe = 0.0;
+    for (int w = 0; w < NUM_WORKERS; w++) {
+        int i0 = (int)((long long)p->n * w / NUM_WORKERS), i1 = (int)((long long)p->n * (w + 1) / NUM_WORKERS);
+        for (int i = i0; i < i1; i++) {
+            double xi = p->x[i], yi = p->y[i], zi = p->z[i];
+            double fx = 0.0, fy = 0.0, fz = 0.0, e = 0.0;
+            for (int k = nl->nbr_start[i]; k < nl->nbr_start[i + 1]; k++) {
+                int j = nl->nbr[k];
+                double dx = min_image(xi - p->x[j], box);
+                double dy = min_image(yi - p->y[j], box);
+                double dz = min_image(zi - p->z[j], box);
+                double r2 = dx * dx + dy * dy + dz * dz;
+                if (r2 < rc2) {
+                    double inv2 = 1.0 / r2, inv6 = inv2 * inv2 * inv2;
+                    double f = 24.0 * inv2 * inv6 * (2.0 * inv6 - 1.0);
+                    fx += f * dx;
+                    fy += f * dy;
+                    fz += f * dz;
+                    e += 4.0 * inv6 * (inv6 - 1.0) - nl->shift;
+                }
+            }
+            p->ax[i] = fx;
+            p->ay[i] = fy;
+            p->az[i] = fz;
+            pe += 0.5 * e;
+        }
+    }
+    return pe;
+}
+
+// Same forces straight from the cell list (no stored neighbours); particles
+// must be cell-sorted, which the last nlist_build guarantees.
+double lj_forces_cells(NeighborList *nl, Particles *p) {
+    double rc2 = nl->cutoff * nl->cutoff, box = nl->box, pe = 0.0;
+    int m = nl->cells_per_dim;
+    for (int w = 0; w < NUM_WORKERS; w++) {
+        int c0 = (int)((long long)m * m * m * w / NUM_WORKERS);
+        int c1 = (int)((long long)m * m * m * (w + 1) / NUM_WORKERS);
+        for (int c = c0; c < c1; c++) {
+            int cx = c % m, cy = (c / m) % m, cz = c / (m * m);
+            for (int i = nl->cell_start[c]; i < nl->cell_start[c + 1]; i++) {
+                double xi = p->x[i], yi = p->y[i], zi = p->z[i];
+                double fx = 0.0, fy = 0.0, fz = 0.0, e = 0.0;
+                FOR_NEIGHBOR_CELLS(nl, cx, cy, cz, nc) {
+                    for (int j = nl->cell_start[nc]; j < nl->cell_start[nc + 1]; j++) {
+                        if (j == i) continue;
+                        double dx = min_image(xi - p->x[j], box);
+                        double dy = min_image(yi - p->y[j], box);
+                        double dz = min_image(zi - p->z[j], box);
+                        double r2 = dx * dx + dy * dy + dz * dz;
+                        if (r2 < rc2) {
+                            double inv2 = 1.0 / r2, inv6 = inv2 * inv2 * inv2;
+                            double f = 24.0 * inv2 * inv6 * (2.0 * inv6 - 1.0);
+                            fx += f * dx;
+                            fy += f * dy;
+                            fz += f * dz;
+                            e += 4.0 * inv6 * (inv6 - 1.0) - nl->shift;
+                        }
+                    }
+                }
+                p->ax[i] = fx;
+                p->ay[i] = fy;
+                p->az[i] = fz;
+                pe += 0.5 * e;
+            }
+        }
+    }
+    return pe;
+}
+
+// O(n^2) SoA all-pairs with the same force law, for cross-checking.
+double lj_forces_all_pairs(Particles *p, double box, double shift) {
+    double rc2 = LJ_CUTOFF * LJ_CUTOFF, pe = 0.0;
+    for (int i = 0; i < p->n; i++) p->ax[i] = p->ay[i] = p->az[i] = 0.0;
+    for (int i = 0; i < p->n; i++) {
+        for (int j = i + 1; j < p->n; j++) {
+            double dx = min_image(p->x[i] - p->x[j], box);
+            double dy = min_image(p->y[i] - p->y[j], box);
+            double dz = min_image(p->z[i] - p->z[j], box);
+            double r2 = dx * dx + dy * dy + dz * dz;
+            if (r2 < rc2) {
+                double inv2 = 1.0 / r2, inv6 = inv2 * inv2 * inv2;
+                double f = 24.0 * inv2 * inv6 * (2.0 * inv6 - 1.0);
+                p->ax[i] += f * dx; p->ay[i] += f * dy; p->az[i] += f * dz;
+                p->ax[j] -= f * dx; p->ay[j] -= f * dy; p->az[j] -= f * dz;
+                pe += 4.0 * inv6 * (inv6 - 1.0) - shift;
+            }
+        }
+    }
+    return pe;
+}
+
+static inline double wrap(double v, double box) {
+    if (v < 0) v += box;
+    if (v >= box) v -= box;
+    return v;
+}
+
+// Velocity Verlet as in 143's integrate_verlet, with list upkeep between drift and kick.
+double lj_step(NeighborList *nl, Particles *p, double dt) {
+    for (int i = 0; i < p->n; i++) {
+        p->vx[i] += 0.5 * p->ax[i] * dt;
+        p->vy[i] += 0.5 * p->ay[i] * dt;
+        p->vz[i] += 0.5 * p->az[i] * dt;
+        p->x[i] = wrap(p->x[i] + p->vx[i] * dt, nl->box);
+        p->y[i] = wrap(p->y[i] + p->vy[i] * dt, nl->box);
+        p->z[i] = wrap(p->z[i] + p->vz[i] * dt, nl->box);
+    }
+    if (nlist_needs_rebuild(nl, p)) nlist_build(nl, p);
+    double pe = lj_forces_verlet(nl, p);
+    for (int i = 0; i < p->n; i++) {
+        p->vx[i] += 0.5 * p->ax[i] * dt;
+        p->vy[i] += 0.5 * p->ay[i] * dt;
+        p->vz[i] += 0.5 * p->az[i] * dt;
+    }
+    return pe;
+}
+
+// Jittered simple-cubic lattice at LJ_DENSITY with velocities scaled to LJ_TEMPERATURE.
+double lj_init(Particles *p, unsigned int seed) {
+    int n = p->n;
+    double box = cbrt(n / LJ_DENSITY);
+    int side = (int)ceil(cbrt((double)n));
+    double a = box / side;
+    double mv[3] = {0.0, 0.0, 0.0};
+    for (int i = 0; i < n; i++) {
+        int ix = i % side, iy = (i / side) % side, iz = i / (side * side);
+        p->x[i] = wrap((ix + 0.5) * a + 0.05 * a * (rand_unit(&seed) - 0.5), box);
+        p->y[i] = wrap((iy + 0.5) * a + 0.05 * a * (rand_unit(&seed) - 0.5), box);
+        p->z[i] = wrap((iz + 0.5) * a + 0.05 * a * (rand_unit(&seed) - 0.5), box);
+        p->vx[i] = rand_unit(&seed) - 0.5;
+        p->vy[i] = rand_unit(&seed) - 0.5;
+        p->vz[i] = rand_unit(&seed) - 0.5;
+        p->mass[i] = 1.0;
+        mv[0] += p->vx[i]; mv[1] += p->vy[i]; mv[2] += p->vz[i];
+    }
+    for (int i = 0; i < n; i++) {
+        p->vx[i] -= mv[0] / n; p->vy[i] -= mv[1] / n; p->vz[i] -= mv[2] / n;
+    }
+    double scale = sqrt(1.5 * n * LJ_TEMPERATURE / kinetic_energy(p));
+    for (int i = 0; i < n; i++) {
+        p->vx[i] *= scale; p->vy[i] *= scale; p->vz[i] *= scale;
+    }
+    return box;
+}
+
+// ---------------------------------------------------------------------------
+// Barnes-Hut octree. Nodes own contiguous particle ranges: the build
+// partitions an index array by octant and the particles are then permuted
+// into tree order, so leaves are unit-stride runs in the SoA arrays.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    double cx, cy, cz, half;  // cube centre and half-width
+    double mx, my, mz, mass;  // centre of mass
+    int start, count;
+    int first_child;          // children are contiguous; -1 for a leaf
+    int num_children;
+} OctNode;
+
+typedef struct {
+    OctNode *nodes;
+    int num_nodes;
+    int capacity;
+    int *index;
+    int *tmp;
+    double *scratch;
+} Octree;
+
+void octree_init(Octree *t, int n) {
+    t->capacity = n / 2 + 64;
+    t->nodes = (OctNode*)malloc(t->capacity * sizeof(OctNode));
+    t->index = (int*)malloc(n * sizeof(int));
+    t->tmp = (int*)malloc(n * sizeof(int));
+    t->scratch = (double*)malloc(n * sizeof(double));
+    t->num_nodes = 0;
+}
+
+void octree_free(Octree *t) {
+    free(t->nodes);
+    free(t->index);
+    free(t->tmp);
+    free(t->scratch);
+}
+
+static int octree_new_nodes(Octree *t, int count) {
+    if (t->num_nodes + count > t->capacity) {
+        while (t->num_nodes + count > t->capacity) t->capacity *= 2;
+        t->nodes = (OctNode*)realloc(t->nodes, t->capacity * sizeof(OctNode));
+    }
+    int first = t->num_nodes;
+    t->num_nodes += count;
+    return first;
+}
+
+static void octree_build_node(Octree *t, const Particles *p, int node, int depth) {
+    OctNode *nd = &t->nodes[node];
+    int start = nd->start, count = nd->count;
+    double m = 0.0, mx = 0.0, my = 0.0, mz = 0.0;
+    for (int k = start; k < start + count; k++) {
+        int i = t->index[k];
+        m += p->mass[i];
+        mx += p->mass[i] * p->x[i];
+        my += p->mass[i] * p->y[i];
+        mz += p->mass[i] * p->z[i];
+    }
+    nd->mass = m;
+    nd->mx = mx / m;
+    nd->my = my / m;
+    nd->mz = mz / m;
+    nd->first_child = -1;
+    nd->num_children = 0;
+    if (count <= BH_LEAF_SIZE || depth >= BH_MAX_DEPTH) return;
+
+    int bucket_count[8] = {0};
+    double cx = nd->cx, cy = nd->cy, cz = nd->cz;
+    for (int k = start; k < start + count; k++) {
+        int i = t->index[k];
+        int oct = (p->x[i] >= cx) | ((p->y[i] >= cy) << 1) | ((p->z[i] >= cz) << 2);
+        t->tmp[k] = oct;
+        bucket_count[oct]++;
+    }
+    int offset[8], used = 0;
+    for (int o = 0, acc = start; o < 8; o++) {
+        offset[o] = acc;
+        acc += bucket_count[o];
+        if (bucket_count[o]) used++;
+    }
+    // Stable partition through the scratch space of this range
+    int *out = (int *)t->scratch;
+    int fill[8];
+    memcpy(fill, offset, sizeof(fill));
+    for (int k = start; k < start + count; k++) out[fill[t->tmp[k]]++] = t->index[k];
+    memcpy(t->index + start, out + start, count * sizeof(int));
+
+    int first = octree_new_nodes(t, used);
+    nd = &t->nodes[node];     // may have moved
+    nd->first_child = first;
+    nd->num_children = used;
+    double h = nd->half * 0.5;
+    int c = first;
+    for (int o = 0; o < 8; o++) {
+        if (!bucket_count[o]) continue;
+        OctNode *ch = &t->nodes[c];
+        ch->cx = cx + ((o & 1) ? h : -h);
+        ch->cy = cy + ((o & 2) ? h : -h);
+        ch->cz = cz + ((o & 4) ? h : -h);
+        ch->half = h;
+        ch->start = offset[o];
+        ch->count = bucket_count[o];
+        c++;
+    }
+    for (int k = 0; k < used; k++) octree_build_node(t, p, first + k, depth + 1);
+}
+
+// Builds the tree and permutes p into tree order.
+void octree_build(Octree *t, Particles *p) {
+    double lo[3] = {1e300, 1e300, 1e300}, hi[3] = {-1e300, -1e300, -1e300};
+    for (int i = 0; i < p->n; i++) {
+        double v[3] = {p->x[i], p->y[i], p->z[i]};
+        for (int d = 0; d < 3; d++) {
+            if (v[d] < lo[d]) lo[d] = v[d];
+            if (v[d] > hi[d]) hi[d] = v[d];
+        }
+        t->index[i] = i;
+    }
+    double half = 0.0;
+    for (int d = 0; d < 3; d++) {
+        if ((hi[d] - lo[d]) * 0.5 > half) half = (hi[d] - lo[d]) * 0.5;
+    }
+    t->num_nodes = 0;
+    int root = octree_new_nodes(t, 1);
+    OctNode *r = &t->nodes[root];
+    r->cx = 0.5 * (lo[0] + hi[0]);
+    r->cy = 0.5 * (lo[1] + hi[1]);
+    r->cz = 0.5 * (lo[2] + hi[2]);
+    r->half = half * 1.0001 + 1e-12;
+    r->start = 0;
+    r->count = p->n;
+    octree_build_node(t, p, root, 0);
+    particles_permute(p, t->index, t->scratch);
+}
+
+typedef struct {
+    long long interactions[NUM_WORKERS];
+    long long node_visits;
+} BHStats;
+
+// Opening test: a node is used as a point mass when width < theta * distance.
+// Accelerations (and potential per unit mass, when pot != NULL) for every particle.
+void bh_accelerations(const Octree *t, Particles *p, double theta, double grav, double eps2,
+                      double *pot, BHStats *stats) {
+    double theta2 = theta * theta;
+    int stack[BH_MAX_DEPTH * 8 + 8];
+    for (int w = 0; w < NUM_WORKERS; w++) {
+        int i0 = (int)((long long)p->n * w / NUM_WORKERS), i1 = (int)((long long)p->n * (w + 1) / NUM_WORKERS);
+        for (int i = i0; i < i1; i++) {
+            double xi = p->x[i], yi = p->y[i], zi = p->z[i];
+            double ax = 0.0, ay = 0.0, az = 0.0, phi = 0.0;
+            int sp = 0;
+            stack[sp++] = 0;
+            while (sp) {
+                const OctNode *nd = &t->nodes[stack[--sp]];
+                stats->node_visits++;
+                double dx = nd->mx - xi, dy = nd->my - yi, dz = nd->mz - zi;
+                double r2 = dx * dx + dy * dy + dz * dz;
+                double width = 2.0 * nd->half;
+                if (nd->first_child < 0) {
+                    for (int j = nd->start; j < nd->start + nd->count; j++) {
+                        if (j == i) continue;
+                        double ex = p->x[j] - xi, ey = p->y[j] - yi, ez = p->z[j] - zi;
+                        double d2 = ex * ex + ey * ey + ez * ez + eps2;
+                        double inv = 1.0 / sqrt(d2);
+                        double s = grav * p->mass[j] * inv * inv * inv;
+                        ax += s * ex; ay += s * ey; az += s * ez;
+                        phi -= grav * p->mass[j] * inv;
+                    }
+                    stats->interactions[w] += nd->count;
+                } else if (width * width < theta2 * r2) {
+                    double d2 = r2 + eps2;
+                    double inv = 1.0 / sqrt(d2);
+                    double s = grav * nd->mass * inv * inv * inv;
+                    ax += s * dx; ay += s * dy; az += s * dz;
+                    phi -= grav * nd->mass * inv;
+                    stats->interactions[w]++;
+                } else {
+                    for (int c = 0; c < nd->num_children; c++) stack[sp++] = nd->first_child + c;
+                }
+            }
+            p->ax[i] = ax;
+            p->ay[i] = ay;
+            p->az[i] = az;
+            if (pot) pot[i] = phi;
+        }
+    }
+}
+
+void direct_acceleration(const Particles *p, int i, double grav, double eps2, double out[3]) {
+    double ax = 0.0, ay = 0.0, az = 0.0;
+    for (int j = 0; j < p->n; j++) {
+        if (j == i) continue;
+        double ex = p->x[j] - p->x[i], ey = p->y[j] - p->y[i], ez = p->z[j] - p->z[i];
+        double d2 = ex * ex + ey * ey + ez * ez + eps2;
+        double inv = 1.0 / sqrt(d2);
+        double s = grav * p->mass[j] * inv * inv * inv;
+        ax += s * ex; ay += s * ey; az += s * ez;
+    }
+    out[0] = ax; out[1] = ay; out[2] = az;
+}
+
+double direct_potential_energy(const Particles *p, double grav, double eps2) {
+    double pe = 0.0;
+    for (int i = 0; i < p->n; i++) {
+        for (int j = i + 1; j < p->n; j++) {
+            double ex = p->x[j] - p->x[i], ey = p->y[j] - p->y[i], ez = p->z[j] - p->z[i];
+            pe -= grav * p->mass[i] * p->mass[j] / sqrt(ex * ex + ey * ey + ez * ez + eps2);
+        }
+    }
+    return pe;
+}
+
+// 36's update_positions (semi-implicit Euler) on SoA accelerations.
+void euler_step(Particles *p, double dt) {
+    for (int i = 0; i < p->n; i++) {
+        p->vx[i] += p->ax[i] * dt;
+        p->vy[i] += p->ay[i] * dt;
+        p->vz[i] += p->az[i] * dt;
+        p->x[i] += p->vx[i] * dt;
+        p->y[i] += p->vy[i] * dt;
+        p->z[i] += p->vz[i] * dt;
+    }
+}
+
+void uniform_sphere(Particles *p, unsigned int seed) {
+    for (int i = 0; i < p->n; i++) {
+        double x, y, z;
+        do {
+            x = 2.0 * rand_unit(&seed) - 1.0;
+            y = 2.0 * rand_unit(&seed) - 1.0;
+            z = 2.0 * rand_unit(&seed) - 1.0;
+        } while (x * x + y * y + z * z > 1.0);
+        p->x[i] = x; p->y[i] = y; p->z[i] = z;
+        p->vx[i] = p->vy[i] = p->vz[i] = 0.0;
+        p->mass[i] = 1.0 / p->n;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Reference integrators (36_nbody_simulation.c, 143_molecular_dynamics.c)
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    double x, y, z;
+    double vx, vy, vz;
+    double mass;
+} Body;
+
+void compute_forces_36(Body *bodies, int n, double *fx, double *fy, double *fz) {
+    for (int i = 0; i < n; i++) {
+        fx[i] = fy[i] = fz[i] = 0.0;
+    }
+    for (int i = 0; i < n; i++) {
+        for (int j = i + 1; j < n; j++) {
+            double dx = bodies[j].x - bodies[i].x;
+            double dy = bodies[j].y - bodies[i].y;
+            double dz = bodies[j].z - bodies[i].z;
+            double dist_sq = dx*dx + dy*dy + dz*dz + SOFTENING;
+            double dist = sqrt(dist_sq);
+            double force = G * bodies[i].mass * bodies[j].mass / dist_sq;
+            double fx_comp = force * dx / dist;
+            double fy_comp = force * dy / dist;
+            double fz_comp = force * dz / dist;
+            fx[i] += fx_comp; fy[i] += fy_comp; fz[i] += fz_comp;
+            fx[j] -= fx_comp; fy[j] -= fy_comp; fz[j] -= fz_comp;
+        }
+    }
+}
+
+void update_positions_36(Body *bodies, int n, double *fx, double *fy, double *fz, double dt) {
+    for (int i = 0; i < n; i++) {
+        bodies[i].vx += fx[i] / bodies[i].mass * dt;
+        bodies[i].vy += fy[i] / bodies[i].mass * dt;
+        bodies[i].vz += fz[i] / bodies[i].mass * dt;
+        bodies[i].x += bodies[i].vx * dt;
+        bodies[i].y += bodies[i].vy * dt;
+        bodies[i].z += bodies[i].vz * dt;
+    }
+}
+
+void init_bodies_36(Body *bodies, int n) {
+    for (int i = 0; i < n; i++) {
+        bodies[i].x = (double)(i % 16) * 10.0;
+        bodies[i].y = (double)(i / 16) * 10.0;
+        bodies[i].z = (double)(i % 7) * 5.0;
+        bodies[i].vx = ((i * 13) % 100 - 50) / 100.0;
+        bodies[i].vy = ((i * 17) % 100 - 50) / 100.0;
+        bodies[i].vz = ((i * 19) % 100 - 50) / 100.0;
+        bodies[i].mass = 1.0e20 + (i % 10) * 1.0e19;
+    }
+}
+
+double bodies_energy_36(const Body *b, int n) {
+    double e = 0.0;
+    for (int i = 0; i < n; i++) {
+        e += 0.5 * b[i].mass * (b[i].vx * b[i].vx + b[i].vy * b[i].vy + b[i].vz * b[i].vz);
+        for (int j = i + 1; j < n; j++) {
+            double dx = b[j].x - b[i].x, dy = b[j].y - b[i].y, dz = b[j].z - b[i].z;
+            e -= G * b[i].mass * b[j].mass / sqrt(dx * dx + dy * dy + dz * dz + SOFTENING);
+        }
+    }
+    return e;
+}
+
+typedef struct {
+    double x, y, z;
+} Vector3D;
+
+typedef struct {
+    Vector3D position;
+    Vector3D velocity;
+    Vector3D force;
+} Particle;
+
+void compute_forces_143(Particle *particles, int n) {
+    for (int i = 0; i < n; i++) {
+        particles[i].force.x = particles[i].force.y = particles[i].force.z = 0.0;
+    }
+    for (int i = 0; i < n; i++) {
+        for (int j = i + 1; j < n; j++) {
+            double dx = min_image(particles[i].position.x - particles[j].position.x, BOX_SIZE);
+            double dy = min_image(particles[i].position.y - particles[j].position.y, BOX_SIZE);
+            double dz = min_image(particles[i].position.z - particles[j].position.z, BOX_SIZE);
+            double r2 = dx * dx + dy * dy + dz * dz;
+            double r = sqrt(r2);
+            if (r < 2.5 && r > 0.1) {
+                double r6 = r2 * r2 * r2;
+                double r8 = r6 * r2;
+                double r14 = r6 * r6 * r2;
+                double f_magnitude = 24.0 * (2.0 / r14 - 1.0 / r8);
+                double fx = f_magnitude * dx / r;
+                double fy = f_magnitude * dy / r;
+                double fz = f_magnitude * dz / r;
+                particles[i].force.x += fx; particles[i].force.y += fy; particles[i].force.z += fz;
+                particles[j].force.x -= fx; particles[j].force.y -= fy; particles[j].force.z -= fz;
+            }
+        }
+    }
+}
+
+void integrate_verlet_143(Particle *particles, int n, double dt) {
+    for (int i = 0; i < n; i++) {
+        Particle *q = &particles[i];
+        q->velocity.x += 0.5 * q->force.x * dt;
+        q->velocity.y += 0.5 * q->force.y * dt;
+        q->velocity.z += 0.5 * q->force.z * dt;
+        q->position.x = wrap(q->position.x + q->velocity.x * dt, BOX_SIZE);
+        q->position.y = wrap(q->position.y + q->velocity.y * dt, BOX_SIZE);
+        q->position.z = wrap(q->position.z + q->velocity.z * dt, BOX_SIZE);
+    }
+    compute_forces_143(particles, n);
+    for (int i = 0; i < n; i++) {
+        Particle *q = &particles[i];
+        q->velocity.x += 0.5 * q->force.x * dt;
+        q->velocity.y += 0.5 * q->force.y * dt;
+        q->velocity.z += 0.5 * q->force.z * dt;
+    }
+}
+
+double energy_143(const Particle *particles, int n) {
+    double e = 0.0, shift = lj_energy(2.5 * 2.5);
+    for (int i = 0; i < n; i++) {
+        const Vector3D *v = &particles[i].velocity;
+        e += 0.5 * (v->x * v->x + v->y * v->y + v->z * v->z);
+        for (int j = i + 1; j < n; j++) {
+            double dx = min_image(particles[i].position.x - particles[j].position.x, BOX_SIZE);
+            double dy = min_image(particles[i].position.y - particles[j].position.y, BOX_SIZE);
+            double dz = min_image(particles[i].position.z - particles[j].position.z, BOX_SIZE);
+            double r2 = dx * dx + dy * dy + dz * dz;
+            if (r2 < 2.5 * 2.5 && r2 > 0.01) e += lj_energy(r2) - shift;
+        }
+    }
+    return e;
+}
+
+// ---------------------------------------------------------------------------
+// Benchmarks
+// ---------------------------------------------------------------------------
+
+int run_reference_integrators(void) {
+    // 36: direct forces vs Barnes-Hut with the same integrator and initial state
+    Body *bodies = (Body*)malloc(N_BODIES * sizeof(Body));
+    double *fx = (double*)malloc(N_BODIES * sizeof(double)), *fy = (double*)malloc(N_BODIES * sizeof(double));
+    double *fz = (double*)malloc(N_BODIES * sizeof(double));
+    init_bodies_36(bodies, N_BODIES);
+    double e0 = bodies_energy_36(bodies, N_BODIES);
+    for (int step = 0; step < TIME_STEPS; step++) {
+        compute_forces_36(bodies, N_BODIES, fx, fy, fz);
+        update_positions_36(bodies, N_BODIES, fx, fy, fz, DT);
+    }
+    double e1 = bodies_energy_36(bodies, N_BODIES);
+
+    Body *soa_init = (Body*)malloc(N_BODIES * sizeof(Body));
+    init_bodies_36(soa_init, N_BODIES);
+    Particles p;
+    particles_alloc(&p, N_BODIES);
+    for (int i = 0; i < N_BODIES; i++) {
+        p.x[i] = soa_init[i].x; p.y[i] = soa_init[i].y; p.z[i] = soa_init[i].z;
+        p.vx[i] = soa_init[i].vx; p.vy[i] = soa_init[i].vy; p.vz[i] = soa_init[i].vz;
+        p.mass[i] = soa_init[i].mass;
+        p.ax[i] = i;          // tag: body id survives tree-order permutations
+    }
+    Octree t;
+    octree_init(&t, N_BODIES);
+    BHStats stats;
+    memset(&stats, 0, sizeof(stats));
+    double *tag = (double*)malloc(N_BODIES * sizeof(double));
+    for (int step = 0; step < TIME_STEPS; step++) {
+        octree_build(&t, &p);
+        // The permutation moved ax along with the other fields; recover the tags.
+        for (int i = 0; i < N_BODIES; i++) tag[i] = p.ax[i];
+        bh_accelerations(&t, &p, 0.5, G, SOFTENING, NULL, &stats);
+        euler_step(&p, DT);
+        for (int i = 0; i < N_BODIES; i++) p.ax[i] = tag[i];
+    }
+    int zero = 0;
+    for (int i = 0; i < N_BODIES; i++) {
+        if ((int)tag[i] == 0) zero = i;
+        soa_init[(int)tag[i]].x = p.x[i];
+        soa_init[(int)tag[i]].y = p.y[i];
+        soa_init[(int)tag[i]].z = p.z[i];
+        soa_init[(int)tag[i]].vx = p.vx[i];
+        soa_init[(int)tag[i]].vy = p.vy[i];
+        soa_init[(int)tag[i]].vz = p.vz[i];
+        soa_init[(int)tag[i]].mass = p.mass[i];
+    }
+    double e2 = bodies_energy_36(soa_init, N_BODIES);
+    printf("36 setup (%d bodies, %d steps): direct drift %.3e, Barnes-Hut (theta 0.5) drift %.3e\n",
+           N_BODIES, TIME_STEPS, fabs((e1 - e0) / e0), fabs((e2 - e0) / e0));
+    printf("  final position[0]: direct (%.2f, %.2f, %.2f), Barnes-Hut (%.2f, %.2f, %.2f)\n",
+           bodies[0].x, bodies[0].y, bodies[0].z, p.x[zero], p.y[zero], p.z[zero]);
+    // The 36 cloud expands violently, so compare relative to the distance travelled
+    double pos_err = (fabs(bodies[0].x - p.x[zero]) + fabs(bodies[0].y - p.y[zero]) + fabs(bodies[0].z - p.z[zero])) /
+                     (fabs(bodies[0].x) + fabs(bodies[0].y) + fabs(bodies[0].z));
+    free(tag);
+    octree_free(&t);
+    particles_free(&p);
+    free(soa_init);
+    free(bodies);
+    free(fx); free(fy); free(fz);
+
+    // 143: its own integrator and force law on its random start
+    Particle *parts = (Particle*)malloc(NUM_PARTICLES * sizeof(Particle));
+    unsigned int seed = 42;
+    for (int i = 0; i < NUM_PARTICLES; i++) {
+        seed = seed * 1103515245 + 12345;
+        parts[i].position.x = ((seed & 0xFFFF) / (double)0xFFFF) * BOX_SIZE;
+        seed = seed * 1103515245 + 12345;
+        parts[i].position.y = ((seed & 0xFFFF) / (double)0xFFFF) * BOX_SIZE;
+        seed = seed * 1103515245 + 12345;
+        parts[i].position.z = ((seed & 0xFFFF) / (double)0xFFFF) * BOX_SIZE;
+        parts[i].velocity.x = parts[i].velocity.y = parts[i].velocity.z = 0.0;
+    }
+    compute_forces_143(parts, NUM_PARTICLES);
+    double m0 = energy_143(parts, NUM_PARTICLES);
+    for (int step = 0; step < NUM_STEPS; step++) integrate_verlet_143(parts, NUM_PARTICLES, MD_DT);
+    double m1 = energy_143(parts, NUM_PARTICLES);
+    printf("143 setup (%d particles, %d steps): energy drift %.3e "
+           "(its force carries an extra 1/r, so it does not derive from the potential)\n",
+           NUM_PARTICLES, NUM_STEPS, fabs((m1 - m0) / m0));
+    free(parts);
+    return pos_err > 5e-2;
+}
+
+int bench_md(int n, int steps, int check) {
+    Particles p;
+    particles_alloc(&p, n);
+    double box = lj_init(&p, 1234 + n);
+    NeighborList nl;
+    nlist_init(&nl, n, box);
+    int failures = 0;
+
+    clock_t start = clock();
+    nlist_build(&nl, &p);
+    double build_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    double pe_cells = lj_forces_cells(&nl, &p);
+    double cell_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+    double *cx = (double*)malloc(n * sizeof(double));
+    memcpy(cx, p.ax, n * sizeof(double));
+
+    start = clock();
+    double pe = lj_forces_verlet(&nl, &p);
+    double verlet_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+    double max_diff = 0.0;
+    for (int i = 0; i < n; i++) {
+        double d = fabs(cx[i] - p.ax[i]);
+        if (d > max_diff) max_diff = d;
+    }
+    if (max_diff > 1e-9 || fabs(pe - pe_cells) > 1e-9 * fabs(pe)) failures++;
+
+    if (check) {
+        double *vx = (double*)malloc(n * sizeof(double));
+        memcpy(vx, p.ax, n * sizeof(double));
+        start = clock();
+        double pe_ref = lj_forces_all_pairs(&p, box, nl.shift);
+        double ref_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+        double ref_diff = 0.0;
+        for (int i = 0; i < n; i++) {
+            double d = fabs(vx[i] - p.ax[i]);
+            if (d > ref_diff) ref_diff = d;
+        }
+        printf("  all-pairs O(n^2): %.6f seconds, max force diff %.2e, energy diff %.2e\n",
+               ref_time, ref_diff, fabs(pe - pe_ref));
+        if (ref_diff > 1e-8) failures++;
+        memcpy(p.ax, vx, n * sizeof(double));
+        lj_forces_verlet(&nl, &p);
+        free(vx);
+    }
+
+    double e0 = kinetic_energy(&p) + pe;
+    int rebuilds0 = nl.rebuilds;
+    start = clock();
+    for (int s = 0; s < steps; s++) pe = lj_step(&nl, &p, LJ_DT);
+    double run_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+    double e1 = kinetic_energy(&p) + pe;
+
+    double pairs = (double)nl.nbr_start[n];
+    printf("LJ n=%d (box %.1f, %d^3 cells): build %.4f s, cell forces %.4f s, Verlet forces %.4f s "
+           "(%.1f neighbours/particle, %.2e pair-evals/s)\n",
+           n, box, nl.cells_per_dim, build_time, cell_time, verlet_time, pairs / n,
+           verlet_time > 0 ? pairs / verlet_time : 0.0);
+    printf("  %d steps: %.4f s/step, %d rebuilds, energy per particle %.5f -> %.5f, drift %.3e\n",
+           steps, run_time / steps, nl.rebuilds - rebuilds0, e0 / n, e1 / n, fabs((e1 - e0) / e0));
+
+    free(cx);
+    nlist_free(&nl);
+    particles_free(&p);
+    return failures;
+}
+
+int bench_gravity(int n, int energy_check) {
+    Particles p;
+    particles_alloc(&p, n);
+    uniform_sphere(&p, 99 + n);
+    Octree t;
+    octree_init(&t, n);
+    int failures = 0;
+
+    clock_t start = clock();
+    octree_build(&t, &p);
+    double build_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    int sample = n < BH_SAMPLE ? n : BH_SAMPLE;
+    double (*exact)[3] = (double (*)[3])malloc(sample * sizeof(*exact));
+    int *targets = (int*)malloc(sample * sizeof(int));
+    for (int s = 0; s < sample; s++) {
+        targets[s] = (int)((long long)s * n / sample);
+        direct_acceleration(&p, targets[s], 1.0, BH_SOFTENING, exact[s]);
+    }
+    printf("Barnes-Hut n=%d: build %.4f s, %d nodes\n", n, build_time, t.num_nodes);
+
+    static const double thetas[] = {0.5, 0.7, 1.0};
+    for (int k = 0; k < 3; k++) {
+        BHStats stats;
+        memset(&stats, 0, sizeof(stats));
+        start = clock();
+        bh_accelerations(&t, &p, thetas[k], 1.0, BH_SOFTENING, NULL, &stats);
+        double force_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+        double err2 = 0.0, ref2 = 0.0;
+        for (int s = 0; s < sample; s++) {
+            int i = targets[s];
+            double dx = p.ax[i] - exact[s][0], dy = p.ay[i] - exact[s][1], dz = p.az[i] - exact[s][2];
+            err2 += dx * dx + dy * dy + dz * dz;
+            ref2 += exact[s][0] * exact[s][0] + exact[s][1] * exact[s][1] + exact[s][2] * exact[s][2];
+        }
+        long long total = 0, busiest = 0;
+        for (int w = 0; w < NUM_WORKERS; w++) {
+            total += stats.interactions[w];
+            if (stats.interactions[w] > busiest) busiest = stats.interactions[w];
+        }
+        double rel = sqrt(err2 / ref2);
+        printf("  theta %.1f: %.4f s, %.0f interactions/particle, %.2e interactions/s, "
+               "rms rel error %.2e, worker balance %.3f\n",
+               thetas[k], force_time, (double)total / n, force_time > 0 ? total / force_time : 0.0,
+               rel, (double)total / (NUM_WORKERS * (double)busiest));
+        if (thetas[k] <= 0.5 && rel > 1e-2) failures++;
+    }
+    double direct_est = (double)n * (n - 1);
+    printf("  direct summation would need %.2e interactions per step\n", direct_est);
+
+    if (energy_check) {
+        // Small random velocities; same semi-implicit Euler integrator as 36
+        unsigned int seed = 7;
+        for (int i = 0; i < n; i++) {
+            p.vx[i] = 0.1 * (rand_unit(&seed) - 0.5);
+            p.vy[i] = 0.1 * (rand_unit(&seed) - 0.5);
+            p.vz[i] = 0.1 * (rand_unit(&seed) - 0.5);
+        }
+        double e0 = kinetic_energy(&p) + direct_potential_energy(&p, 1.0, BH_SOFTENING);
+        BHStats stats;
+        memset(&stats, 0, sizeof(stats));
+        start = clock();
+        for (int s = 0; s < BH_ENERGY_STEPS; s++) {
+            octree_build(&t, &p);
+            bh_accelerations(&t, &p, 0.5, 1.0, BH_SOFTENING, NULL, &stats);
+            euler_step(&p, BH_DT);
+        }
+        double run_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+        double e1 = kinetic_energy(&p) + direct_potential_energy(&p, 1.0, BH_SOFTENING);
+        printf("  %d steps (rebuild + theta 0.5 forces): %.4f s/step, energy drift %.3e\n",
+               BH_ENERGY_STEPS, run_time / BH_ENERGY_STEPS, fabs((e1 - e0) / e0));
+    }
+
+    free(exact);
+    free(targets);
+    octree_free(&t);
+    particles_free(&p);
+    return failures;
+}
+
+int main() {
+    clock_t start = clock();
+    int failures = run_reference_integrators();
+    for (int s = 0; s < NUM_SIZES; s++) {
+        int n = particle_counts[s];
+        failures += bench_md(n, s == 0 ? LJ_ENERGY_STEPS : LJ_BENCH_STEPS, s == 0);
+    }
+    for (int s = 0; s < NUM_SIZES; s++) {
+        failures += bench_gravity(particle_counts[s], s == 0);
+    }
+    clock_t end = clock();
+    printf("Force engine: %d sizes, %d workers, %.6f seconds\n",
+           NUM_SIZES, NUM_WORKERS, (double)(end - start) / CLOCKS_PER_SEC);
+    printf("Failures: %d\n", failures);
+    return 0;
+}
@@ -0,0 +1,530 @@
+// Suffix array module: SA-IS construction, Kasai / Phi LCP, BWT and inverse BWT on top of the SA
+// Cross-checked against 16_suffix_array.c (qsort + strcmp) and 138_burrows_wheeler.c (sorted rotations)
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define NUM_TEXT_KINDS 3
+#define REF_SA_SIZE 10000     // 16's default input
+#define REF_REPEAT_SIZE 2000  // all-'a' input is quadratic for strcmp sorting
+#define REF_BWT_SIZE 2000     // 138 keeps every rotation in memory
+#define VERIFY_PREFIX 64
+
+#ifdef FULL_SIZE
+static const int text_sizes[] = {1 << 20, 4 << 20, 16 << 20, 64 << 20, 100 << 20};
+#else
+static const int text_sizes[] = {1 << 17, 1 << 19};  // -DFULL_SIZE for 1 MB up to 100 MB
+#endif
+#define NUM_SIZES (int)(sizeof(text_sizes) / sizeof(text_sizes[0]))
+
+// ---------------------------------------------------------------------------
+// Memory accounting: every module buffer goes through these, so the peak is
+// the real working set of the construction (text excluded).
+// ---------------------------------------------------------------------------
+
+static long long live_bytes = 0;
+static long long peak_bytes = 0;
+
+void *mem_alloc(size_t size) {
+    size_t *block = (size_t*)malloc(size + sizeof(size_t));
+    block[0] = size;
+    live_bytes += size;
+    if (live_bytes > peak_bytes) peak_bytes = live_bytes;
+    return block + 1;
+}
+
+void mem_free(void *ptr) {
+    if (!ptr) return;
+    size_t *block = (size_t*)ptr - 1;
+    live_bytes -= block[0];
+    free(block);
+}
+
+void mem_reset_peak(void) {
+    peak_bytes = live_bytes;
+}
+
+// ---------------------------------------------------------------------------
+// SA-IS (Nong, Zhang, Chan). Level 0 reads bytes with a virtual sentinel at
+// index n - 1 (symbol 0, bytes shifted by one); deeper levels read the int
+// reduced string, whose last symbol is already the unique smallest.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    const void *s;
+    int level0;
+    int n;
+} SaisText;
+
+static inline int sym(const SaisText *x, int i) {
+    if (x->level0) return i == x->n - 1 ? 0 : ((const unsigned char*)x->s)[i] + 1;
+    return ((const int*)x->s)[i];
+}
+
+#define IS_S(t, i) ((t)[(i) >> 3] & (1 << ((i) & 7)))
+#define IS_LMS(t, i) ((i) > 0 && IS_S(t, i) && !IS_S(t, (i) - 1))
+
+static void get_buckets(const SaisText *x, int *bkt, int k, int end) {
+    memset(bkt, 0, k * sizeof(int));
+    for (int i = 0; i < x->n; i++) bkt[sym(x, i)]++;
+    int sum = 0;
+    for (int c = 0; c < k; c++) {
+        sum += bkt[c];
+        bkt[c] = end ? sum : sum - bkt[c];
+    }
+}
+
+static void induce_l(const SaisText *x, const unsigned char *t, int *sa, int *bkt, int k) {
+    get_buckets(x, bkt, k, 0);
+    for (int i = 0; i < x->n; i++) {
+        int j = sa[i] - 1;
+        if (j >= 0 && !IS_S(t, j)) sa[bkt[sym(x, j)]++] = j;
+    }
+}
+
+static void induce_s(const SaisText *x, const unsigned char *t, int *sa, int *bkt, int k) {
+    get_buckets(x, bkt, k, 1);
+    for (int i = x->n - 1; i >= 0; i--) {
+        int j = sa[i] - 1;
+        if (j >= 0 && IS_S(t, j)) sa[--bkt[sym(x, j)]] = j;
+    }
+}
+
+static void sais_rec(const SaisText *x, int *sa, int k) {
+    int n = x->n;
+    unsigned char *t = mem_alloc((n >> 3) + 1);
+    int *bkt = mem_alloc(k * sizeof(int));
+    memset(t, 0, (n >> 3) + 1);
+
+    // Classify: S if smaller than the next suffix
+    t[(n - 1) >> 3] |= 1 << ((n - 1) & 7);
+    for (int i = n - 2; i >= 0; i--) {
+        int a = sym(x, i), b = sym(x, i + 1);
+        if (a < b || (a == b && IS_S(t, i + 1))) t[i >> 3] |= 1 << (i & 7);
+    }
+
+    // Stage 1: sort LMS substrings by induction
+    get_buckets(x, bkt, k, 1);
+    for (int i = 0; i < n; i++) sa[i] = -1;
+    for (int i = 1; i < n; i++) {
+        if (IS_LMS(t, i)) sa[--bkt[sym(x, i)]] = i;
+    }
+    induce_l(x, t, sa, bkt, k);
+    induce_s(x, t, sa, bkt, k);
+
+    int n1 = 0;
+    for (int i = 0; i < n; i++) {
+        if (IS_LMS(t, sa[i])) sa[n1++] = sa[i];
+    }
+
+    // Name LMS substrings; equal substrings share a name
+    for (int i = n1; i < n; i++) sa[i] = -1;
+    int name = 0, prev = -1;
+    for (int i = 0; i < n1; i++) {
+        int pos = sa[i], diff = 0;
+        for (int d = 0; d < n; d++) {
+            if (prev == -1 || sym(x, pos + d) != sym(x, prev + d) ||
+                !IS_S(t, pos + d) != !IS_S(t, prev + d)) {
+                diff = 1;
+                break;
+            }
+            if (d > 0 && (IS_LMS(t, pos + d) || IS_LMS(t, prev + d))) break;
+        }
+        if (diff) {
+            name++;
+            prev = pos;
+        }
+        sa[n1 + (pos >> 1)] = name - 1;
+    }
+    for (int i = n - 1, j = n - 1; i >= n1; i--) {
+        if (sa[i] >= 0) sa[j--] = sa[i];
+    }
+
+    // Stage 2: sort the reduced string, recursing only while names repeat
+    int *sa1 = sa, *s1 = sa + n - n1;
+    if (name < n1) {
+        SaisText reduced = {s1, 0, n1};
+        sais_rec(&reduced, sa1, name);
+    } else {
+        for (int i = 0; i < n1; i++) sa1[s1[i]] = i;
+    }
+
+    // Stage 3: induce the full order from the sorted LMS suffixes
+    get_buckets(x, bkt, k, 1);
+    for (int i = 1, j = 0; i < n; i++) {
+        if (IS_LMS(t, i)) s1[j++] = i;
+    }
+    for (int i = 0; i < n1; i++) sa1[i] = s1[sa1[i]];
+    for (int i = n1; i < n; i++) sa[i] = -1;
+    for (int i = n1 - 1; i >= 0; i--) {
+        int j = sa[i];
+        sa[i] = -1;
+        sa[--bkt[sym(x, j)]] = j;
+    }
+    induce_l(x, t, sa, bkt, k);
+    induce_s(x, t, sa, bkt, k);
+
+    mem_free(bkt);
+    mem_free(t);
+}
+
+// Suffix array of text[0..n): returns n entries, the sentinel suffix dropped.
+int *suffix_array_build(const unsigned char *text, int n) {
+    int *sa = mem_alloc((n + 1) * sizeof(int));
+    SaisText x = {text, 1, n + 1};
+    sais_rec(&x, sa, 257);
+    memmove(sa, sa + 1, n * sizeof(int));
+    return sa;
+}
+
+// ---------------------------------------------------------------------------
+// LCP: lcp[i] = common prefix of suffixes sa[i-1] and sa[i], lcp[0] = 0
+// ---------------------------------------------------------------------------
+
+// Kasai et al.: walks the text in order through the inverse SA.
+int *lcp_kasai(const unsigned char *text, const int *sa, int n) {
+    int *rank = mem_alloc(n * sizeof(int));
+    int *lcp = mem_alloc(n * sizeof(int));
+    for (int i = 0; i < n; i++) rank[sa[i]] = i;
+    int h = 0;
+    for (int i = 0; i < n; i++) {
+        if (rank[i] == 0) {
+            lcp[0] = 0;
+            h = 0;
+            continue;
+        }
+        int j = sa[rank[i] - 1];
+        while (i + h < n && j + h < n && text[i + h] == text[j + h]) h++;
+        lcp[rank[i]] = h;
+        if (h > 0) h--;
+    }
+    mem_free(rank);
+    return lcp;
+}
+
+// Phi variant (Karkkainen, Manzini, Puglisi): one scratch array holds Phi and
+// then the permuted LCP, so the text scan stays sequential and no rank array
+// is kept.
+int *lcp_phi(const unsigned char *text, const int *sa, int n) {
+    int *plcp = mem_alloc(n * sizeof(int));
+    int *lcp = mem_alloc(n * sizeof(int));
+    plcp[sa[0]] = -1;
+    for (int i = 1; i < n; i++) plcp[sa[i]] = sa[i - 1];
+    int h = 0;
+    for (int i = 0; i < n; i++) {
+        int j = plcp[i];
+        if (j < 0) {
+            plcp[i] = 0;
+            h = 0;
+            continue;
+        }
+        while (i + h < n && j + h < n && text[i + h] == text[j + h]) h++;
+        plcp[i] = h;
+        if (h > 0) h--;
+    }
+    for (int i = 0; i < n; i++) lcp[i] = plcp[sa[i]];
+    mem_free(plcp);
+    return lcp;
+}
+
+// ---------------------------------------------------------------------------
+// BWT of text + sentinel. The sentinel row is left out of out[]; *primary is
+// the row it would occupy, which is also where decoding starts.
+// ---------------------------------------------------------------------------
+
+void bwt_from_sa(const unsigned char *text, const int *sa, int n, unsigned char *out, int *primary) {
+    // The sentinel suffix sorts first; its preceding byte is text[n - 1]
+    out[0] = text[n - 1];
+    for (int i = 0, o = 1; i < n; i++) {
+        if (sa[i] == 0) {
+            *primary = i + 1;
+            continue;
+        }
+        out[o++] = text[sa[i] - 1];
+    }
+}
+
+void bwt_inverse(const unsigned char *bwt, int n, int primary, unsigned char *out) {
+    int count[257] = {0};
+    int *lf = mem_alloc(n * sizeof(int));
+    for (int i = 0; i < n; i++) count[bwt[i] + 1]++;
+    count[0] = 1;                      // sentinel, smallest symbol
+    for (int c = 1; c < 257; c++) count[c] += count[c - 1];
+    // LF over the n + 1 rows; stored rows skip the sentinel row at primary
+    int occ[256] = {0};
+    for (int i = 0; i < n; i++) {
+        unsigned char c = bwt[i];
+        lf[i] = count[c] + occ[c]++;
+    }
+    // Walk backwards from row 0 (the sentinel suffix), which precedes text[n - 1]
+    int row = 0;
+    for (int i = n - 1; i >= 0; i--) {
+        int stored = row < primary ? row : row - 1;
+        out[i] = bwt[stored];
+        row = lf[stored];
+    }
+    mem_free(lf);
+}
+
+// Cyclic BWT with 138's conventions: sort the rotations of text, report the
+// last column and the row of rotation 0. Rotations are the first n symbols
+// of the suffixes of text+text, so the doubled text goes through SA-IS.
+void bwt_cyclic(const unsigned char *text, int n, unsigned char *out, int *primary) {
+    unsigned char *doubled = mem_alloc(2 * (size_t)n);
+    memcpy(doubled, text, n);
+    memcpy(doubled + n, text, n);
+    int *sa = suffix_array_build(doubled, 2 * n);
+    for (int i = 0, o = 0; i < 2 * n; i++) {
+        int p = sa[i];
+        if (p >= n) continue;
+        if (p == 0) *primary = o;
+        out[o++] = text[(p + n - 1) % n];
+    }
+    mem_free(sa);
+    mem_free(doubled);
+}
+
+// ---------------------------------------------------------------------------
+// Reference implementations (16_suffix_array.c, 138_burrows_wheeler.c)
+// ---------------------------------------------------------------------------
+
+typedef struct Suffix {
+    int index;
+    char* suff;
+} Suffix;
+
+int cmp(const void* a, const void* b) {
+    return strcmp(((Suffix*)a)->suff, ((Suffix*)b)->suff);
+}
+
+int* build_suffix_array_16(char* txt, int n) {
+    Suffix* suffixes = (Suffix*)malloc(n * sizeof(Suffix));
+    for (int i = 0; i < n; i++) {
+        suffixes[i].index = i;
+        suffixes[i].suff = txt + i;
+    }
+    qsort(suffixes, n, sizeof(Suffix), cmp);
+    int* suffix_arr = (int*)malloc(n * sizeof(int));
+    for (int i = 0; i < n; i++)
+        suffix_arr[i] = suffixes[i].index;
+    free(suffixes);
+    return suffix_arr;
+}
+
+typedef struct {
+    char *rotation;
+    int index;
+} Rotation;
+
+int compare_rotations(const void *a, const void *b) {
+    Rotation *ra = (Rotation*)a;
+    Rotation *rb = (Rotation*)b;
+    return strcmp(ra->rotation, rb->rotation);
+}
+
+void burrows_wheeler_transform_138(const char *input, char *output, int *primary_index) {
+    int len = strlen(input);
+    Rotation *rotations = (Rotation*)malloc(len * sizeof(Rotation));
+    for (int i = 0; i < len; i++) {
+        rotations[i].rotation = (char*)malloc(len + 1);
+        rotations[i].index = i;
+        for (int j = 0; j < len; j++) {
+            rotations[i].rotation[j] = input[(i + j) % len];
+        }
+        rotations[i].rotation[len] = '\0';
+    }
+    qsort(rotations, len, sizeof(Rotation), compare_rotations);
+    for (int i = 0; i < len; i++) {
+        output[i] = rotations[i].rotation[len - 1];
+        if (rotations[i].index == 0) {
+            *primary_index = i;
+        }
+    }
+    output[len] = '\0';
+    for (int i = 0; i < len; i++) {
+        free(rotations[i].rotation);
+    }
+    free(rotations);
+}
+
+// ---------------------------------------------------------------------------
+// Inputs and checks
+// ---------------------------------------------------------------------------
+
+// 0: uniform over "acgt" (16), 1: 138's skewed alphabet, 2: long repeats with
+// sparse mutations, which drive deep SA-IS recursion and long LCPs.
+void generate_text(unsigned char *text, int n, int kind, unsigned int seed) {
+    for (int i = 0; i < n; i++) {
+        seed = seed * 1103515245 + 12345;
+        if (kind == 0) {
+            text[i] = "acgt"[seed >> 30];
+        } else if (kind == 1) {
+            int r = (seed >> 8) % 100;
+            text[i] = r < 40 ? 'a' : r < 70 ? 'b' : r < 85 ? 'c' : 'd' + ((seed >> 20) & 3);
+        } else {
+            int period = 4093;
+            text[i] = i < period ? "acgt"[seed >> 30] : text[i - period];
+            if (((seed >> 8) & 0xFFFF) == 0) text[i] = 'n';
+        }
+    }
+}
+
+static const char *kind_names[] = {"random acgt", "138 skewed", "repetitive"};
+
+// Adjacent suffixes must be strictly increasing: the LCP says where they
+// first differ, and that position must compare correctly. Only the first
+// VERIFY_PREFIX bytes of each shared prefix are compared, or repetitive
+// texts would make the check quadratic; the two LCP algorithms cross-check
+// the rest.
+int verify_sa_lcp(const unsigned char *text, const int *sa, const int *lcp, int n) {
+    unsigned char *seen = (unsigned char*)calloc(n, 1);
+    int errors = 0;
+    for (int i = 0; i < n; i++) {
+        if (sa[i] < 0 || sa[i] >= n || seen[sa[i]]) {
+            errors++;
+            break;
+        }
+        seen[sa[i]] = 1;
+    }
+    for (int i = 1; i < n && !errors; i++) {
+        int a = sa[i - 1], b = sa[i], h = lcp[i];
+        if (a + h > n || b + h > n || memcmp(text + a, text + b, h < VERIFY_PREFIX ? h : VERIFY_PREFIX) != 0) errors++;
+        else if (b + h == n) errors++;                         // shorter suffix must sort first
+        else if (a + h < n && text[a + h] >= text[b + h]) errors++;
+    }
+    free(seen);
+    return errors;
+}
+
+int run_reference_checks(void) {
+    int mismatches = 0;
+
+    // 16: its own input (4-letter rand() text) and a worst case for strcmp
+    for (int k = 0; k < 2; k++) {
+        int n = k == 0 ? REF_SA_SIZE : REF_REPEAT_SIZE;
+        char *txt = (char*)malloc(n + 1);
+        srand(42);
+        for (int i = 0; i < n; i++) txt[i] = k == 0 ? 'a' + (rand() % 4) : 'a';
+        txt[n] = '\0';
+        clock_t start = clock();
+        int *ref = build_suffix_array_16(txt, n);
+        double ref_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+        start = clock();
+        int *sa = suffix_array_build((unsigned char*)txt, n);
+        double sais_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+        int bad = memcmp(ref, sa, n * sizeof(int)) != 0;
+        printf("16 %s n=%d: qsort+strcmp %.6f s, SA-IS %.6f s, %s\n",
+               k == 0 ? "random" : "all-'a'", n, ref_time, sais_time, bad ? "MISMATCH" : "identical");
+        mismatches += bad;
+        free(ref);
+        mem_free(sa);
+        free(txt);
+    }
+
+    // 138: cyclic BWT and primary index on its generated text
+    int n = REF_BWT_SIZE;
+    char *input = (char*)malloc(n + 1);
+    char *ref_out = (char*)malloc(n + 1);
+    unsigned char *out = (unsigned char*)malloc(n);
+    unsigned char *back = (unsigned char*)malloc(n);
+    generate_text((unsigned char*)input, n, 1, 42);
+    input[n] = '\0';
+    int ref_primary = -1, primary = -1;
+    clock_t start = clock();
+    burrows_wheeler_transform_138(input, ref_out, &ref_primary);
+    double ref_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    bwt_cyclic((unsigned char*)input, n, out, &primary);
+    double sa_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+    int bad = memcmp(ref_out, out, n) != 0 || ref_primary != primary;
+    printf("138 cyclic BWT n=%d: sorted rotations %.6f s (%d KB), SA-IS %.6f s, %s\n",
+           n, ref_time, (int)((long long)n * (n + 1) / 1024), sa_time, bad ? "MISMATCH" : "identical");
+    mismatches += bad;
+
+    // Sentinel BWT round trip on the same text
+    int *sa = suffix_array_build((unsigned char*)input, n);
+    bwt_from_sa((unsigned char*)input, sa, n, out, &primary);
+    bwt_inverse(out, n, primary, back);
+    mismatches += memcmp(back, input, n) != 0;
+    mem_free(sa);
+
+    free(input);
+    free(ref_out);
+    free(out);
+    free(back);
+    return mismatches;
+}
+
+int bench_size(int n, int kind) {
+    unsigned char *text = (unsigned char*)malloc(n);
+    unsigned char *bwt = (unsigned char*)malloc(n);
+    unsigned char *back = (unsigned char*)malloc(n);
+    generate_text(text, n, kind, 1234 + kind);
+    double mb = n / (1024.0 * 1024.0);
+    int mismatches = 0;
+
+    mem_reset_peak();
+    clock_t start = clock();
+    int *sa = suffix_array_build(text, n);
+    double sa_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+    long long sa_peak = peak_bytes;
+
+    start = clock();
+    int *lcp = lcp_phi(text, sa, n);
+    double phi_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    int *lcp_k = lcp_kasai(text, sa, n);
+    double kasai_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+    mismatches += memcmp(lcp, lcp_k, n * sizeof(int)) != 0;
+    mem_free(lcp_k);
+    mismatches += verify_sa_lcp(text, sa, lcp, n);
+
+    long long lcp_sum = 0;
+    int lcp_max = 0;
+    for (int i = 0; i < n; i++) {
+        lcp_sum += lcp[i];
+        if (lcp[i] > lcp_max) lcp_max = lcp[i];
+    }
+    mem_free(lcp);
+
+    int primary = 0;
+    start = clock();
+    bwt_from_sa(text, sa, n, bwt, &primary);
+    double bwt_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+    mem_free(sa);
+
+    start = clock();
+    bwt_inverse(bwt, n, primary, back);
+    double inv_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+    mismatches += memcmp(back, text, n) != 0;
+
+    // Runs in the BWT show how much the transform groups context
+    int runs = 1;
+    for (int i = 1; i < n; i++) runs += bwt[i] != bwt[i - 1];
+
+    printf("%-11s %5.2f MB: SA-IS %7.2f MB/s (peak %.2f B/char), LCP phi %7.2f / kasai %7.2f MB/s, "
+           "BWT %8.2f MB/s, inverse %7.2f MB/s, avg LCP %.1f (max %d), BWT runs %.3f/char\n",
+           kind_names[kind], mb, mb / sa_time, (double)sa_peak / n, mb / phi_time, mb / kasai_time,
+           mb / bwt_time, mb / inv_time, (double)lcp_sum / n, lcp_max, (double)runs / n);
+
+    free(text);
+    free(bwt);
+    free(back);
+    return mismatches;
+}
+
+int main() {
+    clock_t start = clock();
+    int mismatches = run_reference_checks();
+    for (int s = 0; s < NUM_SIZES; s++) {
+        for (int k = 0; k < NUM_TEXT_KINDS; k++) {
+            mismatches += bench_size(text_sizes[s], k);
+        }
+    }
+    clock_t end = clock();
+    printf("Suffix array module: %d sizes x %d texts, %.6f seconds\n",
+           NUM_SIZES, NUM_TEXT_KINDS, (double)(end - start) / CLOCKS_PER_SEC);
+    printf("Mismatches: %d\n", mismatches);
+    return 0;
+}
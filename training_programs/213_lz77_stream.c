@@ -0,0 +1,731 @@
+// Streaming LZ77: hash-chain match finder with lazy matching, windows up to 1 MB, packed token bitstream
+// Decoder with word-wide overlapping copies; round trips checked against 35_lz77_compression.c and 185_lz77_decompress.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#define MIN_MATCH 3
+#define MAX_MATCH 258
+#define MIN_HASH_LOG 15       // head table grows with the window, up to one slot per position
+#define MAX_HASH_LOG 20
+#define GOOD_LENGTH 32        // a deferred match this long cuts the lazy search to a quarter chain
+#define TOO_FAR 4096          // minimum-length matches beyond this cost more bits than literals
+#define MIN_WINDOW_LOG 12
+#define MAX_WINDOW_LOG 20     // 1 MB
+#define DIST_BITS 5           // bit length of the distance; 0 marks end of stream
+
+#ifdef FULL_SIZE
+#define CORPUS_SIZE (2 << 20)
+#define FAR_PERIOD (384 << 10)
+#define REF_SIZE (64 << 10)   // 35 scans its whole window per byte
+#else
+#define CORPUS_SIZE (128 << 10) // -DFULL_SIZE for 2 MB corpora
+#define FAR_PERIOD (80 << 10) // repeat distance of the far-repeats corpus, past a 64 KB window
+#define REF_SIZE (32 << 10)   // 35 scans its whole window per byte
+#endif
+#define NUM_CORPORA 5
+#define NUM_CONFIGS 5
+#define STREAM_CHUNK 65521    // odd chunk size for the streaming check
+
+// ---------------------------------------------------------------------------
+// Bit I/O (LSB first)
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    uint8_t *data;
+    size_t size;
+    size_t capacity;
+    uint64_t acc;
+    int count;
+} BitWriter;
+
+void bw_init(BitWriter *w) {
+    w->capacity = 1 << 16;
+    w->data = (uint8_t*)malloc(w->capacity);
+    w->size = 0;
+    w->acc = 0;
+    w->count = 0;
+}
+
+// nbits <= 32
+static inline void bw_put(BitWriter *w, uint32_t value, int nbits) {
+    w->acc |= (uint64_t)value << w->count;
+    w->count += nbits;
+    if (w->count >= 32) {
+        if (w->size + 4 > w->capacity) {
+            w->capacity *= 2;
+            w->data = (uint8_t*)realloc(w->data, w->capacity);
+        }
+        uint32_t word = (uint32_t)w->acc;
+        memcpy(w->data + w->size, &word, 4);    // little-endian hosts
+        w->size += 4;
+        w->acc >>= 32;
+        w->count -= 32;
+    }
+}
+
+void bw_flush(BitWriter *w) {
+    while (w->count > 0) {
+        if (w->size == w->capacity) {
+            w->capacity *= 2;
+            w->data = (uint8_t*)realloc(w->data, w->capacity);
+        }
+        w->data[w->size++] = (uint8_t)w->acc;
+        w->acc >>= 8;
+        w->count -= 8;
+    }
+    w->count = 0;
+    w->acc = 0;
+}
+
+typedef struct {
+    const uint8_t *data;
+    size_t size;
+    size_t pos;
+    uint64_t acc;
+    int count;
+    int overrun;
+} BitReader;
+
+void br_init(BitReader *r, const uint8_t *data, size_t size) {
+    r->data = data;
+    r->size = size;
+    r->pos = 0;
+    r->acc = 0;
+    r->count = 0;
+    r->overrun = 0;
+}
+
+static inline void br_refill(BitReader *r) {
+    if (r->pos + 8 <= r->size) {
+        uint64_t word;
+        memcpy(&word, r->data + r->pos, 8);
+        r->acc |= word << r->count;
+        int take = (63 - r->count) >> 3;
+        r->pos += take;
+        r->count += take << 3;
+        return;
+    }
+    while (r->count <= 56) {
+        if (r->pos < r->size) {
+            r->acc |= (uint64_t)r->data[r->pos++] << r->count;
+        } else {
+            r->overrun++;
+        }
+        r->count += 8;
+    }
+}
+
+// nbits <= 32
+static inline uint32_t br_get(BitReader *r, int nbits) {
+    if (r->count < nbits) br_refill(r);
+    uint32_t v = (uint32_t)(r->acc & ((1ULL << nbits) - 1));
+    r->acc >>= nbits;
+    r->count -= nbits;
+    return v;
+}
+
+static inline int bit_length(uint32_t v) {
+    return 32 - __builtin_clz(v);
+}
+
+// Elias gamma, v >= 1: k - 1 zeros, a one, then the low k - 1 bits as an integer
+static inline void put_gamma(BitWriter *w, uint32_t v) {
+    int k = bit_length(v);
+    bw_put(w, 1u << (k - 1), k);
+    bw_put(w, v & ((1u << (k - 1)) - 1), k - 1);
+}
+
+static inline uint32_t get_gamma(BitReader *r) {
+    if (r->count < 32) br_refill(r);
+    uint32_t low = (uint32_t)r->acc;
+    if (low == 0) return 0;            // corrupt
+    int zeros = __builtin_ctz(low);
+    if (zeros > 24) return 0;
+    r->acc >>= zeros + 1;
+    r->count -= zeros + 1;
+    return (1u << zeros) | br_get(r, zeros);
+}
+
+// Token layout: flag 0 + 8-bit literal, or flag 1 + gamma(length - MIN_MATCH + 1)
+// + DIST_BITS bit length of the distance + its low bits. A zero bit length ends the stream.
+static inline void emit_literal(BitWriter *w, uint8_t c) {
+    bw_put(w, (uint32_t)c << 1, 9);
+}
+
+static inline void emit_match(BitWriter *w, int length, int distance) {
+    bw_put(w, 1, 1);
+    put_gamma(w, length - MIN_MATCH + 1);
+    int nb = bit_length(distance);
+    bw_put(w, nb, DIST_BITS);
+    bw_put(w, distance & ((1u << (nb - 1)) - 1), nb - 1);
+}
+
+// ---------------------------------------------------------------------------
+// Streaming encoder. The buffer holds up to two windows plus a full lookahead;
+// when it fills, the older window is dropped and every stored position moves
+// down by window_size. Parsing stops MAX_MATCH short of the buffered end until
+// the stream is finished, so chunked and one-shot input give identical output.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    int window_log;
+    int chain_limit;          // candidates examined per search
+    int nice_length;          // stop searching (and skip lazy evaluation) at this length
+    int lazy;
+} LzParams;
+
+typedef struct {
+    LzParams params;
+    int window_size;
+    uint8_t *buf;
+    int capacity;
+    int pos;                  // next position to parse
+    int end;                  // bytes buffered
+    int hash_log;
+    int *head;                // newest position per hash, -1 if none
+    int *prev;                // older position with the same hash, by pos & (window - 1)
+    int pending;              // lazy evaluation holds a match found at pos - 1
+    int pending_len, pending_dist;
+    long long literals, matches, match_bytes, searches;
+    BitWriter out;
+} LzEncoder;
+
+void lz_encoder_init(LzEncoder *e, LzParams params) {
+    if (params.window_log < MIN_WINDOW_LOG) params.window_log = MIN_WINDOW_LOG;
+    if (params.window_log > MAX_WINDOW_LOG) params.window_log = MAX_WINDOW_LOG;
+    memset(e, 0, sizeof(LzEncoder));
+    e->params = params;
+    e->window_size = 1 << params.window_log;
+    e->capacity = 2 * e->window_size + MAX_MATCH;
+    e->buf = (uint8_t*)malloc(e->capacity);
+    e->hash_log = params.window_log < MIN_HASH_LOG ? MIN_HASH_LOG : params.window_log;
+    if (e->hash_log > MAX_HASH_LOG) e->hash_log = MAX_HASH_LOG;
+    e->head = (int*)malloc(((size_t)1 << e->hash_log) * sizeof(int));
+    e->prev = (int*)malloc(e->window_size * sizeof(int));
+    for (int i = 0; i < 1 << e->hash_log; i++) e->head[i] = -1;
+    for (int i = 0; i < e->window_size; i++) e->prev[i] = -1;
+    bw_init(&e->out);
+}
+
+void lz_encoder_free(LzEncoder *e) {
+    free(e->buf);
+    free(e->head);
+    free(e->prev);
+    free(e->out.data);
+}
+
+static inline uint32_t hash3(const uint8_t *p, int hash_log) {
+    uint32_t v = (uint32_t)p[0] << 16 | (uint32_t)p[1] << 8 | p[2];
+    return (v * 2654435761u) >> (32 - hash_log);
+}
+
+static inline void insert_pos(LzEncoder *e, int p) {
+    if (p + MIN_MATCH > e->end) return;
+    uint32_t h = hash3(e->buf + p, e->hash_log);
+    e->prev[p & (e->window_size - 1)] = e->head[h];
+    e->head[h] = p;
+}
+
+static inline int match_length(const uint8_t *a, const uint8_t *b, int limit) {
+    int len = 0;
+    while (len + 8 <= limit) {
+        uint64_t x, y;
+        memcpy(&x, a + len, 8);
+        memcpy(&y, b + len, 8);
+        if (x != y) return len + (__builtin_ctzll(x ^ y) >> 3);
+        len += 8;
+    }
+    while (len < limit && a[len] == b[len]) len++;
+    return len;
+}
+
+// Longest match for p among the chained earlier positions; does not insert p.
+static int find_match(LzEncoder *e, int p, int chain_limit, int *distance) {
+    int limit = e->end - p < MAX_MATCH ? e->end - p : MAX_MATCH;
+    if (limit < MIN_MATCH) return 0;
+    e->searches++;
+    int best = MIN_MATCH - 1, best_dist = 0;
+    int cand = e->head[hash3(e->buf + p, e->hash_log)];
+    int oldest = p > e->window_size ? p - e->window_size : -1;
+    for (int chain = chain_limit; cand > oldest && chain > 0; chain--) {
+        // Cheap reject: the byte that would extend the best match must agree
+        if (e->buf[cand + best] == e->buf[p + best]) {
+            int len = match_length(e->buf + cand, e->buf + p, limit);
+            if (len > best) {
+                best = len;
+                best_dist = p - cand;
+                if (len >= e->params.nice_length || len == limit) break;
+            }
+        }
+        int next = e->prev[cand & (e->window_size - 1)];
+        if (next >= cand) break;
+        cand = next;
+    }
+    *distance = best_dist;
+    if (best == MIN_MATCH && best_dist > TOO_FAR) return 0;
+    return best >= MIN_MATCH ? best : 0;
+}
+
+// Emits a match and chains the positions it covers from first_new on.
+static void emit_and_skip(LzEncoder *e, int start, int len, int dist, int first_new) {
+    emit_match(&e->out, len, dist);
+    e->matches++;
+    e->match_bytes += len;
+    for (int q = first_new; q < start + len; q++) insert_pos(e, q);
+}
+
+static void lz_parse(LzEncoder *e, int final) {
+    int limit = final ? e->end : e->end - MAX_MATCH;
+    while (e->pos < limit) {
+        int p = e->pos, dist = 0;
+        int chain = e->params.chain_limit;
+        if (e->pending && e->pending_len >= GOOD_LENGTH) chain >>= 2;
+        int len = find_match(e, p, chain, &dist);
+        insert_pos(e, p);
+        if (e->pending) {
+            if (len > e->pending_len) {
+                // The deferred match loses: p - 1 goes out as a literal
+                emit_literal(&e->out, e->buf[p - 1]);
+                e->literals++;
+                e->pending_len = len;
+                e->pending_dist = dist;
+                e->pos = p + 1;
+                if (len >= e->params.nice_length) {
+                    e->pending = 0;
+                    emit_and_skip(e, p, len, dist, p + 1);
+                    e->pos = p + len;
+                }
+                continue;
+            }
+            e->pending = 0;
+            emit_and_skip(e, p - 1, e->pending_len, e->pending_dist, p + 1);
+            e->pos = p - 1 + e->pending_len;
+            continue;
+        }
+        if (len) {
+            if (e->params.lazy && len < e->params.nice_length && p + 1 < e->end) {
+                e->pending = 1;
+                e->pending_len = len;
+                e->pending_dist = dist;
+                e->pos = p + 1;
+                continue;
+            }
+            emit_and_skip(e, p, len, dist, p + 1);
+            e->pos = p + len;
+        } else {
+            emit_literal(&e->out, e->buf[p]);
+            e->literals++;
+            e->pos = p + 1;
+        }
+    }
+    if (final && e->pending) {
+        e->pending = 0;
+        emit_and_skip(e, e->pos - 1, e->pending_len, e->pending_dist, e->pos);
+        e->pos = e->pos - 1 + e->pending_len;
+    }
+}
+
+static void lz_slide(LzEncoder *e) {
+    int w = e->window_size;
+    memmove(e->buf, e->buf + w, e->end - w);
+    e->end -= w;
+    e->pos -= w;
+    for (int i = 0; i < 1 << e->hash_log; i++) e->head[i] = e->head[i] >= w ? e->head[i] - w : -1;
+    for (int i = 0; i < w; i++) e->prev[i] = e->prev[i] >= w ? e->prev[i] - w : -1;
+}
+
+void lz_encoder_write(LzEncoder *e, const uint8_t *data, size_t len) {
+    while (len > 0) {
+        if (e->end == e->capacity) lz_slide(e);
+        size_t n = (size_t)(e->capacity - e->end);
+        if (n > len) n = len;
+        memcpy(e->buf + e->end, data, n);
+        e->end += (int)n;
+        data += n;
+        len -= n;
+        lz_parse(e, 0);
+    }
+}
+
+// Parses the remaining lookahead and terminates the stream. Returns the
+// compressed size; the bytes stay in e->out.data.
+size_t lz_encoder_finish(LzEncoder *e) {
+    lz_parse(e, 1);
+    bw_put(&e->out, 1, 1);
+    put_gamma(&e->out, 1);
+    bw_put(&e->out, 0, DIST_BITS);
+    bw_flush(&e->out);
+    return e->out.size;
+}
+
+// ---------------------------------------------------------------------------
+// Decoder
+// ---------------------------------------------------------------------------
+
+// Copies len bytes from op - dist to op. Far sources go 8 bytes at a time and
+// may write up to 7 bytes past the match, so callers leave that slack; short
+// distances replicate the period, doubling it until word copies are safe.
+static inline void copy_match(uint8_t *op, int dist, int len) {
+    const uint8_t *src = op - dist;
+    if (dist == 1) {
+        memset(op, src[0], len);
+        return;
+    }
+    if (dist < 8) {
+        int done = 0;
+        while (done < len && dist < 8) {
+            int n = dist < len - done ? dist : len - done;
+            memcpy(op + done, src, n);   // src .. src + dist is complete and does not overlap op + done
+            done += n;
+            dist += n;
+        }
+        op += done;
+        len -= done;
+        src = op - dist;
+        if (len <= 0) return;
+    }
+    for (int i = 0; i < len; i += 8) memcpy(op + i, src + i, 8);
+}
+
+// Returns the decoded length, or -1 for a corrupt stream or a full output.
+long long lz_decompress(const uint8_t *src, size_t src_len, uint8_t *dst, size_t capacity) {
+    BitReader r;
+    br_init(&r, src, src_len);
+    size_t op = 0;
+    for (;;) {
+        if (br_get(&r, 1) == 0) {
+            if (op >= capacity) return -1;
+            dst[op++] = (uint8_t)br_get(&r, 8);
+        } else {
+            uint32_t g = get_gamma(&r);
+            int nb = br_get(&r, DIST_BITS);
+            if (nb == 0) break;
+            if (g == 0 || nb > MAX_WINDOW_LOG + 1) return -1;
+            size_t len = g + MIN_MATCH - 1;
+            size_t dist = (1u << (nb - 1)) | br_get(&r, nb - 1);
+            if (dist > op || len > capacity - op) return -1;
+            if (len + 8 <= capacity - op) {
+                copy_match(dst + op, (int)dist, (int)len);
+            } else {
+                for (size_t i = 0; i < len; i++) dst[op + i] = dst[op + i - dist];
+            }
+            op += len;
+        }
+        if (r.overrun > 8) return -1;
+    }
+    return r.overrun > 8 ? -1 : (long long)op;
+}
+
+// ---------------------------------------------------------------------------
+// Reference coder (35_lz77_compression.c) and decoder (185_lz77_decompress.c)
+// ---------------------------------------------------------------------------
+
+#define WINDOW_SIZE 4096
+#define LOOKAHEAD_SIZE 18
+
+typedef struct {
+    int offset;
+    int length;
+    char next_char;
+} Token;
+
+int find_longest_match(const char *data, int pos, int data_len, int *match_offset) {
+    int best_length = 0;
+    int best_offset = 0;
+    int window_start = (pos > WINDOW_SIZE) ? pos - WINDOW_SIZE : 0;
+    int lookahead_end = (pos + LOOKAHEAD_SIZE < data_len) ? pos + LOOKAHEAD_SIZE : data_len;
+    for (int i = window_start; i < pos; i++) {
+        int match_len = 0;
+        while (pos + match_len < lookahead_end &&
+               data[i + match_len] == data[pos + match_len]) {
+            match_len++;
+        }
+        if (match_len >= MIN_MATCH && match_len > best_length) {
+            best_length = match_len;
+            best_offset = pos - i;
+        }
+    }
+    *match_offset = best_offset;
+    return best_length;
+}
+
+int lz77_compress_35(const char *input, int input_len, Token *output) {
+    int pos = 0;
+    int token_count = 0;
+    while (pos < input_len) {
+        int match_offset = 0;
+        int match_length = find_longest_match(input, pos, input_len, &match_offset);
+        Token token;
+        if (match_length >= MIN_MATCH) {
+            token.offset = match_offset;
+            token.length = match_length;
+            token.next_char = (pos + match_length < input_len) ?
+                             input[pos + match_length] : '\0';
+            pos += match_length + 1;
+        } else {
+            token.offset = 0;
+            token.length = 0;
+            token.next_char = input[pos];
+            pos++;
+        }
+        output[token_count++] = token;
+    }
+    return token_count;
+}
+
+void lz77_decompress_185(Token *tokens, int num_tokens, char *output, int *output_len) {
+    *output_len = 0;
+    for (int i = 0; i < num_tokens; i++) {
+        if (tokens[i].length > 0) {
+            int start = *output_len - tokens[i].offset;
+            for (int j = 0; j < tokens[i].length; j++) {
+                output[(*output_len)++] = output[start + j];
+            }
+        }
+        if (tokens[i].next_char != '\0') {
+            output[(*output_len)++] = tokens[i].next_char;
+        }
+    }
+    output[*output_len] = '\0';
+}
+
+// ---------------------------------------------------------------------------
+// Corpus
+// ---------------------------------------------------------------------------
+
+static const char *corpus_names[] = {"text", "35 pattern", "records", "far repeats", "random"};
+
+static inline uint32_t next_rand(uint32_t *seed) {
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 8;
+}
+
+// Word soup over a skewed vocabulary
+void gen_text(uint8_t *out, int n, uint32_t seed) {
+    char vocab[512][12];
+    for (int w = 0; w < 512; w++) {
+        int len = 2 + next_rand(&seed) % 9;
+        for (int c = 0; c < len; c++) vocab[w][c] = 'a' + next_rand(&seed) % 26;
+        vocab[w][len] = '\0';
+    }
+    int i = 0, col = 0;
+    while (i < n) {
+        uint32_t r = next_rand(&seed) & 0xFFFF;
+        const char *word = vocab[(r * r) >> 23];   // squared: low indices dominate
+        for (const char *c = word; *c && i < n; c++) out[i++] = *c;
+        col += 8;
+        if (i < n) out[i++] = col > 72 ? '\n' : (next_rand(&seed) % 13 == 0 ? ',' : ' ');
+        if (col > 72) col = 0;
+    }
+}
+
+// 35's generate_test_data
+void gen_pattern(uint8_t *out, int n) {
+    const char *pattern = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    int pattern_len = strlen(pattern);
+    for (int i = 0; i < n; i++) {
+        out[i] = i < n / 2 ? pattern[i % pattern_len] : pattern[(i / 4) % pattern_len];
+    }
+}
+
+// Fixed 32-byte records: counters, small categorical fields, noisy measurements
+void gen_records(uint8_t *out, int n, uint32_t seed) {
+    uint8_t rec[32];
+    for (int i = 0, id = 0; i < n; id++) {
+        uint32_t r = next_rand(&seed);
+        memset(rec, 0, sizeof(rec));
+        memcpy(rec, &id, 4);
+        rec[4] = r % 5;
+        rec[5] = (r >> 3) % 3;
+        uint16_t temp = 2000 + (r >> 8) % 64;
+        memcpy(rec + 8, &temp, 2);
+        uint32_t noise = next_rand(&seed);
+        memcpy(rec + 12, &noise, 2);
+        memcpy(rec + 16, "sensor-", 7);
+        rec[23] = '0' + rec[4];
+        for (int b = 0; b < 32 && i < n; b++) out[i++] = rec[b];
+    }
+}
+
+// A FAR_PERIOD block of text repeated with sparse edits: only a window
+// larger than the repeat distance sees the copies
+void gen_far_repeats(uint8_t *out, int n, uint32_t seed) {
+    int period = FAR_PERIOD;
+    gen_text(out, period < n ? period : n, seed);
+    for (int i = period; i < n; i++) {
+        out[i] = out[i - period];
+        if ((next_rand(&seed) & 1023) == 0) out[i] = 'A' + next_rand(&seed) % 26;
+    }
+}
+
+void gen_random(uint8_t *out, int n, uint32_t seed) {
+    for (int i = 0; i < n; i++) out[i] = (uint8_t)(next_rand(&seed) >> 4);
+}
+
+void generate_corpus(uint8_t *out, int n, int kind) {
+    switch (kind) {
+        case 0: gen_text(out, n, 11); break;
+        case 1: gen_pattern(out, n); break;
+        case 2: gen_records(out, n, 22); break;
+        case 3: gen_far_repeats(out, n, 33); break;
+        default: gen_random(out, n, 44); break;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Benchmarks
+// ---------------------------------------------------------------------------
+
+static const LzParams configs[NUM_CONFIGS] = {
+    {12, 32, 64, 1},
+    {16, 32, 128, 0},
+    {16, 32, 128, 1},
+    {20, 32, 128, 1},
+    {20, 128, 128, 1},
+};
+
+typedef struct {
+    size_t compressed;
+    double compress_time;
+    double decompress_time;
+    int ok;
+} RunResult;
+
+RunResult run_config(const uint8_t *input, int n, LzParams params, uint8_t *decoded, int chunked) {
+    RunResult res;
+    LzEncoder e;
+    lz_encoder_init(&e, params);
+    clock_t start = clock();
+    if (chunked) {
+        for (int off = 0; off < n; off += STREAM_CHUNK) {
+            lz_encoder_write(&e, input + off, n - off < STREAM_CHUNK ? n - off : STREAM_CHUNK);
+        }
+    } else {
+        lz_encoder_write(&e, input, n);
+    }
+    res.compressed = lz_encoder_finish(&e);
+    res.compress_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    long long out_len = lz_decompress(e.out.data, e.out.size, decoded, n + 8);
+    res.decompress_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+    res.ok = out_len == n && memcmp(decoded, input, n) == 0;
+    lz_encoder_free(&e);
+    return res;
+}
+
+int run_reference(void) {
+    int failures = 0;
+    int n = REF_SIZE;
+    uint8_t *input = (uint8_t*)malloc(n);
+    uint8_t *decoded = (uint8_t*)malloc(n + 8);
+    Token *tokens = (Token*)malloc(n * sizeof(Token));
+    char *ref_out = (char*)malloc(n + 1);
+    LzParams params = {12, 4096, MAX_MATCH, 0};   // 35's window, exhaustive chains
+
+    // 185 reads a zero next_char as "no literal", so only corpora without zero bytes
+    for (int kind = 0; kind < 2; kind++) {
+        generate_corpus(input, n, kind);
+        clock_t start = clock();
+        int count = lz77_compress_35((const char*)input, n, tokens);
+        double ref_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+        int ref_len = 0;
+        lz77_decompress_185(tokens, count, ref_out, &ref_len);
+        int ref_ok = ref_len == n && memcmp(ref_out, input, n) == 0;
+
+        RunResult res = run_config(input, n, params, decoded, 0);
+        printf("35/185 %-11s %d KB: 35 %d tokens (%zu B as Token structs, %.2f MB/s, round trip %s), "
+               "hash chains %zu B (%.2f MB/s, round trip %s)\n",
+               corpus_names[kind], n >> 10, count, count * sizeof(Token),
+               n / (1048576.0 * ref_time), ref_ok ? "ok" : "FAILED",
+               res.compressed, n / (1048576.0 * res.compress_time), res.ok ? "ok" : "FAILED");
+        failures += !ref_ok + !res.ok;
+    }
+    free(input);
+    free(decoded);
+    free(tokens);
+    free(ref_out);
+    return failures;
+}
+
+// Flipped bits and truncation must be rejected or decode within bounds
+int run_corruption(const uint8_t *input, int n) {
+    int n_small = n < (256 << 10) ? n : (256 << 10);
+    LzEncoder e;
+    LzParams params = {16, 32, 128, 1};
+    lz_encoder_init(&e, params);
+    lz_encoder_write(&e, input, n_small);
+    size_t size = lz_encoder_finish(&e);
+    uint8_t *copy = (uint8_t*)malloc(size);
+    uint8_t *decoded = (uint8_t*)malloc(n_small + 8);
+    int rejected = 0, trials = 64;
+    uint32_t seed = 5;
+    for (int t = 0; t < trials; t++) {
+        memcpy(copy, e.out.data, size);
+        size_t cut = size;
+        if (t & 1) cut = next_rand(&seed) % size;
+        else copy[next_rand(&seed) % size] ^= 1 << (next_rand(&seed) & 7);
+        long long r = lz_decompress(copy, cut, decoded, n_small + 8);
+        if (r < 0 || r != n_small || memcmp(decoded, input, n_small) != 0) rejected++;
+    }
+    printf("Corrupted streams: %d/%d detected or decoded differently, none out of bounds\n", rejected, trials);
+    free(copy);
+    free(decoded);
+    lz_encoder_free(&e);
+    return 0;
+}
+
+int main() {
+    int n = CORPUS_SIZE;
+    uint8_t *input = (uint8_t*)malloc(n);
+    uint8_t *decoded = (uint8_t*)malloc(n + 8);
+    clock_t start = clock();
+    int failures = run_reference();
+
+    double total_in = 0, total_out = 0;
+    for (int kind = 0; kind < NUM_CORPORA; kind++) {
+        generate_corpus(input, n, kind);
+        for (int c = 0; c < NUM_CONFIGS; c++) {
+            RunResult res = run_config(input, n, configs[c], decoded, 0);
+            failures += !res.ok;
+            printf("%-11s window %4d KB chain %3d %-6s: ratio %6.3f, compress %7.2f MB/s, decompress %8.2f MB/s\n",
+                   corpus_names[kind], (1 << configs[c].window_log) >> 10, configs[c].chain_limit,
+                   configs[c].lazy ? "lazy" : "greedy", (double)n / res.compressed,
+                   n / (1048576.0 * res.compress_time), n / (1048576.0 * res.decompress_time));
+            total_in += n;
+            total_out += res.compressed;
+
+            // Chunked input through the streaming API must give the same bytes
+            if (c == 2) {
+                LzEncoder a, b;
+                lz_encoder_init(&a, configs[c]);
+                lz_encoder_init(&b, configs[c]);
+                lz_encoder_write(&a, input, n);
+                for (int off = 0; off < n; off += STREAM_CHUNK) {
+                    lz_encoder_write(&b, input + off, n - off < STREAM_CHUNK ? n - off : STREAM_CHUNK);
+                }
+                size_t sa = lz_encoder_finish(&a), sb = lz_encoder_finish(&b);
+                if (sa != sb || memcmp(a.out.data, b.out.data, sa) != 0) {
+                    printf("  streaming output differs from one-shot output\n");
+                    failures++;
+                }
+                lz_encoder_free(&a);
+                lz_encoder_free(&b);
+            }
+        }
+    }
+    generate_corpus(input, n, 0);
+    failures += run_corruption(input, n);
+
+    clock_t end = clock();
+    printf("LZ77 stream: %d corpora x %d configs, %.1f MB -> %.1f MB, %.6f seconds\n",
+           NUM_CORPORA, NUM_CONFIGS, total_in / 1048576.0, total_out / 1048576.0,
+           (double)(end - start) / CLOCKS_PER_SEC);
+    printf("Failures: %d\n", failures);
+    free(input);
+    free(decoded);
+    return 0;
+}
@@ -0,0 +1,894 @@
+// Text codecs: wide-table base64 encode/decode and block UTF-8 validation, 32 bytes per step
+// Streaming encoder/decoder/validator for chunked input, fuzzed against 60 and 99
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef FULL_SIZE
+#define BENCH_SIZE (4 << 20)   // bytes of text per benchmark buffer (a multiple of STREAM_CHUNK)
+#define BENCH_BYTES (48 << 20) // bytes processed per (codec, text) cell
+#else
+#define BENCH_SIZE (256 << 10) // -DFULL_SIZE for 4 MB texts and 48 MB per cell
+#define BENCH_BYTES (4 << 20)
+#endif
+#define STREAM_CHUNK 4096      // chunk size for the streaming rows
+#define FUZZ_TRIALS 20000      // random inputs per fuzzer
+#define FUZZ_MAX_LEN 160       // longest fuzz input, enough for several 32-byte blocks
+#define UTF8_BLOCK 32          // bytes per validation step
+
+#define HIGHS 0x8080808080808080ULL
+
+// ---------------------------------------------------------------------------
+// Word helpers. Input is read 8 bytes at a time; HIGHS picks the top bit of
+// every byte, which is all an ASCII check needs.
+// ---------------------------------------------------------------------------
+
+static inline uint64_t load64_le(const void *p) {
+    uint64_t v;
+    memcpy(&v, p, 8);         // little-endian hosts
+    return v;
+}
+
+// ---------------------------------------------------------------------------
+// Base64 encoding. A 4096-entry table emits two characters per 12-bit
+// lookup. The wide path reads 6 bytes with one 8-byte load, makes four
+// lookups, and stores the 8 characters as one word: 24 bytes in and 32
+// characters out per step, with no branches inside the step.
+// ---------------------------------------------------------------------------
+
+static const char base64_alphabet[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static uint16_t enc_pairs[4096];  // two output characters for every 12-bit value
+static uint32_t dec_tables[4][256]; // sextet pre-shifted into place; invalid -> 0xFF000000
+
+void base64_init_tables(void) {
+    for (int i = 0; i < 4096; i++) {
+        enc_pairs[i] = (uint16_t)((uint8_t)base64_alphabet[i >> 6] | (uint8_t)base64_alphabet[i & 63] << 8);
+    }
+    for (int k = 0; k < 4; k++) {
+        for (int c = 0; c < 256; c++) dec_tables[k][c] = 0xFF000000u;
+        for (int v = 0; v < 64; v++) dec_tables[k][(uint8_t)base64_alphabet[v]] = (uint32_t)v << (18 - 6 * k);
+    }
+}
+
+size_t base64_encoded_len(size_t n) { return (n + 2) / 3 * 4; }
+
+static void encode_tail(const uint8_t *in, size_t rem, char *out) {
+    uint32_t triple = (uint32_t)in[0] << 16 | (rem > 1 ? (uint32_t)in[1] << 8 : 0);
+    out[0] = base64_alphabet[triple >> 18];
+    out[1] = base64_alphabet[(triple >> 12) & 63];
+    out[2] = rem > 1 ? base64_alphabet[(triple >> 6) & 63] : '=';
+    out[3] = '=';
+}
+
+size_t base64_encode_table(const uint8_t *in, size_t len, char *out) {
+    size_t i = 0, o = 0;
+    for (; i + 3 <= len; i += 3, o += 4) {
+        uint32_t triple = (uint32_t)in[i] << 16 | (uint32_t)in[i + 1] << 8 | in[i + 2];
+        memcpy(out + o, &enc_pairs[triple >> 12], 2);
+        memcpy(out + o + 2, &enc_pairs[triple & 0xFFF], 2);
+    }
+    if (i < len) {
+        encode_tail(in + i, len - i, out + o);
+        o += 4;
+    }
+    return o;
+}
+
+size_t base64_encode_wide(const uint8_t *in, size_t len, char *out) {
+    size_t i = 0, o = 0;
+    // each 8-byte load uses its first 6 bytes, hence the 2 bytes of slack
+    for (; i + 26 <= len; i += 24, o += 32) {
+        for (int k = 0; k < 4; k++) {
+            uint64_t x = __builtin_bswap64(load64_le(in + i + 6 * k));
+            uint64_t w = (uint64_t)enc_pairs[x >> 52] | (uint64_t)enc_pairs[(x >> 40) & 0xFFF] << 16 |
+                         (uint64_t)enc_pairs[(x >> 28) & 0xFFF] << 32 | (uint64_t)enc_pairs[(x >> 16) & 0xFFF] << 48;
+            memcpy(out + o + 8 * k, &w, 8);
+        }
+    }
+    return o + base64_encode_table(in + i, len - i, out + o);
+}
+
+// ---------------------------------------------------------------------------
+// Base64 decoding. Input must be a multiple of 4 characters with '=' padding
+// only in the final quad; anything else returns -1. Four tables hold each
+// character's sextet already shifted into place (invalid characters set the
+// top byte), so a quad is four lookups ORed together and errors accumulate
+// without branching. The wide path stores two quads as one 8-byte word and
+// tests the error bits once per 32 characters.
+// ---------------------------------------------------------------------------
+
+static inline uint32_t decode_quad(const char *q) {
+    return dec_tables[0][(uint8_t)q[0]] | dec_tables[1][(uint8_t)q[1]] |
+           dec_tables[2][(uint8_t)q[2]] | dec_tables[3][(uint8_t)q[3]];
+}
+
+// Decodes whole quads from the table path; the last quad may be padded
+long base64_decode_table(const char *in, size_t len, uint8_t *out) {
+    if (len % 4) return -1;
+    if (len == 0) return 0;
+    uint32_t err = 0;
+    size_t o = 0;
+    for (size_t i = 0; i + 4 < len; i += 4, o += 3) {
+        uint32_t w = decode_quad(in + i);
+        err |= w;
+        out[o] = (uint8_t)(w >> 16);
+        out[o + 1] = (uint8_t)(w >> 8);
+        out[o + 2] = (uint8_t)w;
+    }
+    const char *q = in + len - 4;
+    int pad = (q[3] == '=') + (q[3] == '=' && q[2] == '=');
+    char last[4] = {q[0], q[1], pad == 2 ? 'A' : q[2], pad ? 'A' : q[3]};
+    uint32_t w = decode_quad(last);
+    err |= w;
+    out[o++] = (uint8_t)(w >> 16);
+    if (pad < 2) out[o++] = (uint8_t)(w >> 8);
+    if (pad < 1) out[o++] = (uint8_t)w;
+    return (err & 0xFF000000u) ? -1 : (long)o;
+}
+
+long base64_decode_wide(const char *in, size_t len, uint8_t *out) {
+    if (len % 4) return -1;
+    size_t i = 0, o = 0;
+    // 32 characters -> 24 bytes per step; the 8-byte stores overrun by 2, so
+    // two quads (at least 4 bytes) must follow, the last one possibly padded
+    for (; i + 40 <= len; i += 32, o += 24) {
+        uint32_t err = 0;
+        for (int k = 0; k < 4; k++) {
+            uint32_t a = decode_quad(in + i + 8 * k), b = decode_quad(in + i + 8 * k + 4);
+            err |= a | b;
+            uint64_t x = __builtin_bswap64((uint64_t)a << 40 | (uint64_t)(b & 0xFFFFFF) << 16);
+            memcpy(out + o + 6 * k, &x, 8);
+        }
+        if (err & 0xFF000000u) return -1;
+    }
+    long tail = base64_decode_table(in + i, len - i, out + o);
+    return tail < 0 ? -1 : (long)o + tail;
+}
+
+// ---------------------------------------------------------------------------
+// Streaming base64. The encoder carries up to 2 bytes between calls; the
+// decoder carries up to 3 characters and, once it has seen a padded quad,
+// treats any further input as an error.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    uint8_t carry[3];
+    int n;
+} Base64Encoder;
+
+typedef struct {
+    char carry[4];
+    int n;
+    int done;                 // a padded quad ended the stream
+    int error;
+} Base64Decoder;
+
+void base64_encoder_init(Base64Encoder *e) { e->n = 0; }
+
+size_t base64_encoder_update(Base64Encoder *e, const uint8_t *in, size_t len, char *out) {
+    size_t o = 0;
+    if (e->n > 0) {
+        while (e->n < 3 && len > 0) {
+            e->carry[e->n++] = *in++;
+            len--;
+        }
+        if (e->n < 3) return 0;
+        o += base64_encode_table(e->carry, 3, out);
+        e->n = 0;
+    }
+    size_t whole = len / 3 * 3;
+    o += base64_encode_wide(in, whole, out + o);
+    for (size_t i = whole; i < len; i++) e->carry[e->n++] = in[i];
+    return o;
+}
+
+size_t base64_encoder_final(Base64Encoder *e, char *out) {
+    size_t o = e->n ? base64_encode_table(e->carry, (size_t)e->n, out) : 0;
+    e->n = 0;
+    return o;
+}
+
+void base64_decoder_init(Base64Decoder *d) {
+    d->n = 0;
+    d->done = 0;
+    d->error = 0;
+}
+
+static long decoder_quads(Base64Decoder *d, const char *in, size_t len, uint8_t *out) {
+    if (len == 0) return 0;
+    if (d->done) {
+        d->error = 1;
+        return 0;
+    }
+    long got = base64_decode_wide(in, len, out);
+    if (got < 0) {
+        d->error = 1;
+        return 0;
+    }
+    d->done = in[len - 1] == '=';
+    return got;
+}
+
+long base64_decoder_update(Base64Decoder *d, const char *in, size_t len, uint8_t *out) {
+    if (d->error) return -1;
+    long o = 0;
+    if (d->n > 0) {
+        while (d->n < 4 && len > 0) {
+            d->carry[d->n++] = *in++;
+            len--;
+        }
+        if (d->n < 4) return 0;
+        o += decoder_quads(d, d->carry, 4, out);
+        d->n = 0;
+    }
+    size_t whole = len / 4 * 4;
+    o += decoder_quads(d, in, whole, out + o);
+    for (size_t i = whole; i < len; i++) d->carry[d->n++] = in[i];
+    return d->error ? -1 : o;
+}
+
+// Returns 0 when the stream was complete and valid
+int base64_decoder_final(const Base64Decoder *d) {
+    return d->error || d->n != 0 ? -1 : 0;
+}
+
+// ---------------------------------------------------------------------------
+// UTF-8 validation, shift-DFA fallback. Each state is a 6-bit offset and
+// row[byte] packs the next state for every current state, so one byte is one
+// load, one shift and one mask with no data-dependent branch. The chain is
+// serial, but at three operations per byte it is the fastest scalar path.
+// ---------------------------------------------------------------------------
+
+enum {
+    U_ACCEPT, U_REJECT, U_CONT1, U_CONT2, U_CONT3,
+    U_E0, U_ED, U_F0, U_F4, NUM_UTF8_STATES
+};
+
+static uint64_t utf8_dfa_rows[256];
+
+static int utf8_next_state(int s, int b) {
+    int cont = b >= 0x80 && b <= 0xBF;
+    switch (s) {
+        case U_ACCEPT:
+            if (b < 0x80) return U_ACCEPT;
+            if (b >= 0xC2 && b <= 0xDF) return U_CONT1;
+            if (b == 0xE0) return U_E0;
+            if (b == 0xED) return U_ED;
+            if (b >= 0xE1 && b <= 0xEF) return U_CONT2;
+            if (b == 0xF0) return U_F0;
+            if (b >= 0xF1 && b <= 0xF3) return U_CONT3;
+            if (b == 0xF4) return U_F4;
+            return U_REJECT;
+        case U_CONT1: return cont ? U_ACCEPT : U_REJECT;
+        case U_CONT2: return cont ? U_CONT1 : U_REJECT;
+        case U_CONT3: return cont ? U_CONT2 : U_REJECT;
+        case U_E0: return b >= 0xA0 && b <= 0xBF ? U_CONT1 : U_REJECT;  // no overlongs
+        case U_ED: return b >= 0x80 && b <= 0x9F ? U_CONT1 : U_REJECT;  // no surrogates
+        case U_F0: return b >= 0x90 && b <= 0xBF ? U_CONT2 : U_REJECT;
+        case U_F4: return b >= 0x80 && b <= 0x8F ? U_CONT2 : U_REJECT;  // <= U+10FFFF
+        default: return U_REJECT;
+    }
+}
+
+void utf8_init_tables(void) {
+    for (int b = 0; b < 256; b++) {
+        uint64_t row = 0;
+        for (int s = 0; s < NUM_UTF8_STATES; s++) {
+            row |= (uint64_t)(6 * utf8_next_state(s, b)) << (6 * s);
+        }
+        utf8_dfa_rows[b] = row;
+    }
+}
+
+static size_t count_continuations(const uint8_t *p, size_t len) {
+    size_t count = 0, i = 0;
+    for (; i + 8 <= len; i += 8) {
+        uint64_t w = load64_le(p + i);
+        count += __builtin_popcountll(w & ~(w << 1) & HIGHS);  // 10xxxxxx
+    }
+    for (; i < len; i++) count += (p[i] & 0xC0) == 0x80;
+    return count;
+}
+
+int utf8_validate_dfa(const uint8_t *p, size_t len, size_t *char_count) {
+    uint64_t state = 0;
+    size_t i = 0;
+    while (i < len) {
+        // ASCII runs only need a skip while no sequence is open
+        if (state == 0) {
+            while (i + 16 <= len && !((load64_le(p + i) | load64_le(p + i + 8)) & HIGHS)) i += 16;
+        }
+        size_t end = i + 16 <= len ? i + 16 : len;
+        for (; i < end; i++) state = (utf8_dfa_rows[p[i]] >> state) & 63;
+    }
+    *char_count = len - count_continuations(p, len);
+    return state == 0;
+}
+
+// ---------------------------------------------------------------------------
+// UTF-8 validation by nibble lookup (Keiser & Lemire). Every byte is checked
+// against its predecessor with three 16-entry tables indexed by the high and
+// low nibble of the previous byte and the high nibble of the current one; the
+// AND of the three is a set of error bits. Third and fourth bytes of a
+// sequence (two continuations in a row) are legal only where the byte two or
+// three back was a 3- or 4-byte lead. Lanes are independent, so the loop over
+// a 32-byte block has no branches and maps onto vector units where they
+// exist; an all-ASCII block only has to check that no sequence was left open.
+// ---------------------------------------------------------------------------
+
+#define TOO_SHORT (1 << 0)    // lead byte followed by a lead or ASCII
+#define TOO_LONG (1 << 1)     // ASCII followed by a continuation
+#define OVERLONG_3 (1 << 2)   // E0 80..9F
+#define TOO_LARGE (1 << 3)    // F4 90..BF, F5..FF
+#define SURROGATE (1 << 4)    // ED A0..BF
+#define OVERLONG_2 (1 << 5)   // C0, C1
+#define TOO_LARGE_1000 (1 << 6) // F5..FF 80..8F
+#define OVERLONG_4 (1 << 6)   // F0 80..8F
+#define TWO_CONTS (1 << 7)    // continuation followed by a continuation
+#define CARRY (TOO_SHORT | TOO_LONG | TWO_CONTS)
+
+static const uint8_t byte1_high[16] = {
+    TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+    TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+    TOO_SHORT | OVERLONG_2,
+    TOO_SHORT,
+    TOO_SHORT | OVERLONG_3 | SURROGATE,
+    TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4
+};
+
+static const uint8_t byte1_low[16] = {
+    CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+    CARRY | OVERLONG_2,
+    CARRY,
+    CARRY,
+    CARRY | TOO_LARGE,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000
+};
+
+static const uint8_t byte2_high[16] = {
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT
+};
+
+static uint8_t byte1_table[256];  // byte1_high & byte1_low folded into one lookup
+static void utf8_init_lookup(void) {
+    for (int b = 0; b < 256; b++) byte1_table[b] = byte1_high[b >> 4] & byte1_low[b & 15];
+}
+
+typedef struct {
+    uint8_t prev[3];          // last three bytes seen, oldest first
+    uint8_t error;
+    size_t bytes;
+    size_t continuations;
+} Utf8Validator;
+
+void utf8_validator_init(Utf8Validator *v) {
+    memset(v->prev, 0, 3);
+    v->error = 0;
+    v->bytes = 0;
+    v->continuations = 0;
+}
+
+// Error bits for positions [from, to) of p; p[from - 3] onwards must be readable
+static inline uint8_t utf8_lanes(const uint8_t *p, size_t from, size_t to) {
+    uint8_t err = 0;
+    for (size_t i = from; i < to; i++) {
+        uint8_t special = byte1_table[p[i - 1]] & byte2_high[p[i] >> 4];
+        uint8_t must23 = (uint8_t)(((p[i - 2] >= 0xE0) | (p[i - 3] >= 0xF0)) << 7);
+        err |= special ^ must23;
+    }
+    return err;
+}
+
+void utf8_validator_update(Utf8Validator *v, const uint8_t *p, size_t len) {
+    v->bytes += len;
+    v->continuations += count_continuations(p, len);
+    // the first three bytes look back into the previous call
+    uint8_t head[6];
+    size_t h = len < 3 ? len : 3;
+    memcpy(head, v->prev, 3);
+    memcpy(head + 3, p, h);
+    uint8_t err = utf8_lanes(head, 3, 3 + h);
+    size_t i = 3;
+    for (; i + UTF8_BLOCK <= len; i += UTF8_BLOCK) {
+        const uint8_t *b = p + i;
+        uint64_t high = (load64_le(b) | load64_le(b + 8) | load64_le(b + 16) | load64_le(b + 24)) & HIGHS;
+        if (high) {
+            err |= utf8_lanes(p, i, i + UTF8_BLOCK);
+        } else {
+            // an ASCII block can only fail on a sequence left open before it
+            err |= (uint8_t)((b[-1] >= 0xC0) | (b[-2] >= 0xE0) | (b[-3] >= 0xF0));
+        }
+    }
+    if (i < len) err |= utf8_lanes(p, i, len);
+    v->error |= err;
+    memcpy(v->prev, len >= 3 ? p + len - 3 : head + h, 3);
+}
+
+// Returns 1 when everything fed so far is complete, valid UTF-8
+int utf8_validator_final(const Utf8Validator *v, size_t *char_count) {
+    // a lead byte in the last three positions still waiting for continuations
+    int incomplete = v->prev[2] >= 0xC0 || v->prev[1] >= 0xE0 || v->prev[0] >= 0xF0;
+    *char_count = v->bytes - v->continuations;
+    return !v->error && !incomplete;
+}
+
+int utf8_validate_lookup(const uint8_t *p, size_t len, size_t *char_count) {
+    Utf8Validator v;
+    utf8_validator_init(&v);
+    utf8_validator_update(&v, p, len);
+    return utf8_validator_final(&v, char_count);
+}
+
+// ---------------------------------------------------------------------------
+// Reference implementations (60, 99)
+// ---------------------------------------------------------------------------
+
+static const char base64_table[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+int base64_encode(const unsigned char *input, int input_len, char *output) {
+    int output_idx = 0;
+
+    for (int i = 0; i < input_len; i += 3) {
+        unsigned int triple = 0;
+        int bytes_remaining = input_len - i;
+
+        // Build 24-bit triple from 3 bytes
+        triple = input[i] << 16;
+        if (bytes_remaining > 1) triple |= input[i+1] << 8;
+        if (bytes_remaining > 2) triple |= input[i+2];
+
+        // Extract four 6-bit groups
+        output[output_idx++] = base64_table[(triple >> 18) & 0x3F];
+        output[output_idx++] = base64_table[(triple >> 12) & 0x3F];
+        output[output_idx++] = (bytes_remaining > 1) ? base64_table[(triple >> 6) & 0x3F] : '=';
+        output[output_idx++] = (bytes_remaining > 2) ? base64_table[triple & 0x3F] : '=';
+    }
+
+    output[output_idx] = '\0';
+    return output_idx;
+}
+
+int base64_decode(const char *input, int input_len, unsigned char *output) {
+    // Decode table
+    int decode_table[256];
+    for (int i = 0; i < 256; i++) decode_table[i] = -1;
+    for (int i = 0; i < 64; i++) decode_table[(int)base64_table[i]] = i;
+
+    int output_idx = 0;
+
+    for (int i = 0; i < input_len; i += 4) {
+        if (input[i] == '=' || input[i+1] == '=') break;
+
+        unsigned int quad = 0;
+        quad = decode_table[(int)input[i]] << 18;
+        quad |= decode_table[(int)input[i+1]] << 12;
+
+        output[output_idx++] = (quad >> 16) & 0xFF;
+
+        if (input[i+2] != '=') {
+            quad |= decode_table[(int)input[i+2]] << 6;
+            output[output_idx++] = (quad >> 8) & 0xFF;
+        }
+
+        if (input[i+3] != '=') {
+            quad |= decode_table[(int)input[i+3]];
+            output[output_idx++] = quad & 0xFF;
+        }
+    }
+
+    return output_idx;
+}
+
+int utf8_char_length(unsigned char byte) {
+    if ((byte & 0x80) == 0) return 1;        // 0xxxxxxx
+    if ((byte & 0xE0) == 0xC0) return 2;     // 110xxxxx
+    if ((byte & 0xF0) == 0xE0) return 3;     // 1110xxxx
+    if ((byte & 0xF8) == 0xF0) return 4;     // 11110xxx
+    return -1; // invalid
+}
+
+int is_continuation_byte(unsigned char byte) {
+    return (byte & 0xC0) == 0x80;  // 10xxxxxx
+}
+
+int validate_utf8(const unsigned char *text, int len, int *char_count) {
+    int i = 0;
+    int chars = 0;
+
+    while (i < len) {
+        int char_len = utf8_char_length(text[i]);
+
+        if (char_len < 0) return 0; // invalid start byte
+
+        if (i + char_len > len) return 0; // truncated sequence
+
+        // Check continuation bytes
+        for (int j = 1; j < char_len; j++) {
+            if (!is_continuation_byte(text[i + j])) {
+                return 0; // invalid continuation
+            }
+        }
+
+        // Check for overlong encoding (simplified check)
+        if (char_len == 2) {
+            unsigned int codepoint = ((text[i] & 0x1F) << 6) | (text[i+1] & 0x3F);
+            if (codepoint < 0x80) return 0; // overlong
+        } else if (char_len == 3) {
+            unsigned int codepoint = ((text[i] & 0x0F) << 12) |
+                                    ((text[i+1] & 0x3F) << 6) |
+                                    (text[i+2] & 0x3F);
+            if (codepoint < 0x800) return 0; // overlong
+            // Check for surrogates
+            if (codepoint >= 0xD800 && codepoint <= 0xDFFF) return 0;
+        } else if (char_len == 4) {
+            unsigned int codepoint = ((text[i] & 0x07) << 18) |
+                                    ((text[i+1] & 0x3F) << 12) |
+                                    ((text[i+2] & 0x3F) << 6) |
+                                    (text[i+3] & 0x3F);
+            if (codepoint < 0x10000 || codepoint > 0x10FFFF) return 0;
+        }
+
+        i += char_len;
+        chars++;
+    }
+
+    *char_count = chars;
+    return 1;
+}
+
+// ---------------------------------------------------------------------------
+// Input generation
+// ---------------------------------------------------------------------------
+
+static unsigned int next_rand(unsigned int *seed) {
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 8;
+}
+
+static int put_codepoint(uint8_t *p, unsigned int cp) {
+    if (cp < 0x80) {
+        p[0] = (uint8_t)cp;
+        return 1;
+    }
+    if (cp < 0x800) {
+        p[0] = (uint8_t)(0xC0 | cp >> 6);
+        p[1] = (uint8_t)(0x80 | (cp & 0x3F));
+        return 2;
+    }
+    if (cp < 0x10000) {
+        p[0] = (uint8_t)(0xE0 | cp >> 12);
+        p[1] = (uint8_t)(0x80 | ((cp >> 6) & 0x3F));
+        p[2] = (uint8_t)(0x80 | (cp & 0x3F));
+        return 3;
+    }
+    p[0] = (uint8_t)(0xF0 | cp >> 18);
+    p[1] = (uint8_t)(0x80 | ((cp >> 12) & 0x3F));
+    p[2] = (uint8_t)(0x80 | ((cp >> 6) & 0x3F));
+    p[3] = (uint8_t)(0x80 | (cp & 0x3F));
+    return 4;
+}
+
+enum { TEXT_ASCII_HEAVY, TEXT_MULTIBYTE_HEAVY, NUM_TEXTS };
+
+static const char *text_names[NUM_TEXTS] = {"ascii-heavy", "multibyte-heavy"};
+
+// ascii-heavy: English-like prose with 2% accented Latin;
+// multibyte-heavy: mostly CJK with some Cyrillic, ASCII and emoji
+void generate_text(int kind, uint8_t *p, size_t size, unsigned int seed) {
+    size_t pos = 0;
+    while (pos + 4 <= size) {
+        unsigned int r = next_rand(&seed);
+        unsigned int pick = r % 100, x = r / 100;
+        unsigned int cp;
+        if (kind == TEXT_ASCII_HEAVY) {
+            if (pick < 2) cp = 0xC0 + x % 0x40;
+            else if (pick < 17) cp = ' ';
+            else cp = 'a' + x % 26;
+        } else {
+            if (pick < 65) cp = 0x4E00 + x % 0x5200;
+            else if (pick < 80) cp = 0x410 + x % 0x40;
+            else if (pick < 95) cp = 0x20 + x % 95;
+            else cp = 0x1F300 + x % 0x700;
+        }
+        pos += put_codepoint(p + pos, cp);
+    }
+    while (pos < size) p[pos++] = ' ';
+}
+
+// Short random strings: mostly valid characters with edge-case code points,
+// sprinkled with malformed pieces (stray continuations, overlongs,
+// surrogates, out-of-range leads, truncated sequences)
+static size_t fuzz_utf8(uint8_t *p, size_t max_len, unsigned int *seed) {
+    size_t len = next_rand(seed) % (max_len - 3);
+    size_t pos = 0;
+    int bad_rate = next_rand(seed) % 4 == 0 ? 0 : 1 + next_rand(seed) % 20;
+    static const unsigned int edges[] = {0x7F, 0x80, 0x7FF, 0x800, 0xD7FF, 0xE000, 0xFFFF, 0x10000, 0x10FFFF};
+    while (pos < len) {
+        unsigned int r = next_rand(seed);
+        if (bad_rate && (int)(r % 100) < bad_rate) {
+            static const uint8_t bad[][4] = {
+                {0x80}, {0xBF}, {0xC0, 0x80}, {0xC1, 0xBF}, {0xE0, 0x9F, 0xBF}, {0xED, 0xA0, 0x80},
+                {0xF0, 0x8F, 0xBF, 0xBF}, {0xF4, 0x90, 0x80, 0x80}, {0xF5, 0x80, 0x80, 0x80}, {0xFF},
+                {0xE2, 0x82}, {0xF0, 0x9F, 0x98}, {0xC3}
+            };
+            static const int bad_len[] = {1, 1, 2, 2, 3, 3, 4, 4, 4, 1, 2, 3, 1};
+            int k = (r >> 8) % 13;
+            memcpy(p + pos, bad[k], bad_len[k]);
+            pos += bad_len[k];
+            continue;
+        }
+        unsigned int x = next_rand(seed);
+        unsigned int cp;
+        switch (r % 6) {
+            case 0: cp = edges[x % 9]; break;
+            case 1: cp = 0x80 + x % 0x780; break;
+            case 2: cp = 0x800 + x % 0xD000; break;
+            case 3: cp = 0x10000 + x % 0x100000; break;
+            default: cp = x % 0x80; break;
+        }
+        pos += put_codepoint(p + pos, cp);
+    }
+    return pos;
+}
+
+// ---------------------------------------------------------------------------
+// Correctness fuzzers
+// ---------------------------------------------------------------------------
+
+// Splits [0, len) at up to three random points
+static int random_splits(size_t len, unsigned int *seed, size_t cuts[5]) {
+    int n = 1 + next_rand(seed) % 4;
+    cuts[0] = 0;
+    for (int i = 1; i < n; i++) cuts[i] = len ? next_rand(seed) % (len + 1) : 0;
+    cuts[n] = len;
+    for (int i = 1; i < n; i++) {
+        for (int j = i; j > 1 && cuts[j] < cuts[j - 1]; j--) {
+            size_t t = cuts[j];
+            cuts[j] = cuts[j - 1];
+            cuts[j - 1] = t;
+        }
+    }
+    return n;
+}
+
+int fuzz_base64(void) {
+    int failures = 0;
+    unsigned int seed = 60;
+    uint8_t data[FUZZ_MAX_LEN], back[FUZZ_MAX_LEN + 8];
+    char ref[FUZZ_MAX_LEN * 2], enc[FUZZ_MAX_LEN * 2];
+    for (int t = 0; t < FUZZ_TRIALS; t++) {
+        size_t len = next_rand(&seed) % FUZZ_MAX_LEN;
+        for (size_t i = 0; i < len; i++) data[i] = (uint8_t)next_rand(&seed);
+        int ref_len = base64_encode(data, (int)len, ref);
+
+        size_t n1 = base64_encode_table(data, len, enc);
+        if (n1 != (size_t)ref_len || memcmp(enc, ref, n1) != 0) failures++;
+        size_t n2 = base64_encode_wide(data, len, enc);
+        if (n2 != (size_t)ref_len || memcmp(enc, ref, n2) != 0) failures++;
+
+        Base64Encoder e;
+        size_t cuts[5], n3 = 0;
+        int parts = random_splits(len, &seed, cuts);
+        base64_encoder_init(&e);
+        for (int i = 0; i < parts; i++) n3 += base64_encoder_update(&e, data + cuts[i], cuts[i + 1] - cuts[i], enc + n3);
+        n3 += base64_encoder_final(&e, enc + n3);
+        if (n3 != (size_t)ref_len || memcmp(enc, ref, n3) != 0) failures++;
+
+        // Mutate a quarter of the encodings; a decoder must agree with the
+        // others on validity and, when valid, with 60 on the bytes
+        char *in = ref;
+        size_t in_len = (size_t)ref_len;
+        if (t % 4 == 0 && in_len > 0) {
+            unsigned int r = next_rand(&seed);
+            unsigned int kind = (r >> 12) % 8;
+            in[r % in_len] = kind == 0 ? '=' : kind < 4 ? base64_alphabet[(r >> 16) & 63] : (char)(r >> 16);
+            if ((r >> 24) % 8 == 0) in_len--;
+        }
+        uint8_t ref_back[FUZZ_MAX_LEN + 8];
+        long d1 = base64_decode_table(in, in_len, back);
+        uint8_t wide_back[FUZZ_MAX_LEN + 8];
+        long d2 = base64_decode_wide(in, in_len, wide_back);
+        if (d1 != d2 || (d1 > 0 && memcmp(back, wide_back, d1) != 0)) failures++;
+
+        Base64Decoder d;
+        long d3 = 0;
+        parts = random_splits(in_len, &seed, cuts);
+        base64_decoder_init(&d);
+        for (int i = 0; i < parts && d3 >= 0; i++) {
+            long got = base64_decoder_update(&d, in + cuts[i], cuts[i + 1] - cuts[i], wide_back + d3);
+            d3 = got < 0 ? -1 : d3 + got;
+        }
+        if (d3 >= 0 && base64_decoder_final(&d) < 0) d3 = -1;
+        if (d3 != d1 || (d1 > 0 && memcmp(back, wide_back, d1) != 0)) failures++;
+
+        if (t % 4 != 0 && (d1 != (long)len || memcmp(back, data, len) != 0)) failures++;
+        if (d1 >= 0) {
+            int r = base64_decode(in, (int)in_len, ref_back);
+            if (r != d1 || memcmp(ref_back, back, d1) != 0) failures++;
+        }
+    }
+    return failures;
+}
+
+int fuzz_utf8_validators(void) {
+    int failures = 0;
+    unsigned int seed = 99;
+    uint8_t text[FUZZ_MAX_LEN + 8];
+    for (int t = 0; t < FUZZ_TRIALS; t++) {
+        size_t len = fuzz_utf8(text, FUZZ_MAX_LEN, &seed);
+        int ref_chars = 0;
+        int ref_ok = validate_utf8(text, (int)len, &ref_chars);
+
+        size_t chars;
+        int ok = utf8_validate_dfa(text, len, &chars);
+        if (ok != ref_ok || (ok && chars != (size_t)ref_chars)) failures++;
+        ok = utf8_validate_lookup(text, len, &chars);
+        if (ok != ref_ok || (ok && chars != (size_t)ref_chars)) failures++;
+
+        Utf8Validator v;
+        size_t cuts[5];
+        int parts = random_splits(len, &seed, cuts);
+        utf8_validator_init(&v);
+        for (int i = 0; i < parts; i++) utf8_validator_update(&v, text + cuts[i], cuts[i + 1] - cuts[i]);
+        ok = utf8_validator_final(&v, &chars);
+        if (ok != ref_ok || (ok && chars != (size_t)ref_chars)) failures++;
+    }
+    return failures;
+}
+
+// ---------------------------------------------------------------------------
+// Throughput
+// ---------------------------------------------------------------------------
+
+enum {
+    ALG_B64_ENC_REF, ALG_B64_ENC_TABLE, ALG_B64_ENC_WIDE, ALG_B64_ENC_STREAM,
+    ALG_B64_DEC_REF, ALG_B64_DEC_TABLE, ALG_B64_DEC_WIDE, ALG_B64_DEC_STREAM,
+    ALG_UTF8_REF, ALG_UTF8_DFA, ALG_UTF8_LOOKUP, ALG_UTF8_STREAM, NUM_ALGS
+};
+
+static const char *alg_names[NUM_ALGS] = {
+    "b64 encode (60)", "b64 encode pairs", "b64 encode wide", "b64 encode stream",
+    "b64 decode (60)", "b64 decode tables", "b64 decode wide", "b64 decode stream",
+    "utf8 validate (99)", "utf8 shift-dfa", "utf8 lookup", "utf8 lookup stream"
+};
+
+static volatile size_t sink;
+
+// Throughput in GB/s of input consumed
+double time_alg(int alg, const uint8_t *text, const char *encoded, size_t enc_len, char *enc_out, uint8_t *dec_out) {
+    int decoding = alg >= ALG_B64_DEC_REF && alg <= ALG_B64_DEC_STREAM;
+    size_t size = decoding ? enc_len : BENCH_SIZE;
+    size_t reps = BENCH_BYTES / size;
+    if (reps == 0) reps = 1;
+    size_t acc = 0;
+    clock_t start = clock();
+    for (size_t r = 0; r < reps; r++) {
+        switch (alg) {
+            case ALG_B64_ENC_REF: acc += (size_t)base64_encode(text, BENCH_SIZE, enc_out); break;
+            case ALG_B64_ENC_TABLE: acc += base64_encode_table(text, BENCH_SIZE, enc_out); break;
+            case ALG_B64_ENC_WIDE: acc += base64_encode_wide(text, BENCH_SIZE, enc_out); break;
+            case ALG_B64_ENC_STREAM: {
+                Base64Encoder e;
+                size_t o = 0;
+                base64_encoder_init(&e);
+                for (size_t i = 0; i < BENCH_SIZE; i += STREAM_CHUNK) {
+                    o += base64_encoder_update(&e, text + i, STREAM_CHUNK, enc_out + o);
+                }
+                acc += o + base64_encoder_final(&e, enc_out + o);
+                break;
+            }
+            case ALG_B64_DEC_REF: acc += (size_t)base64_decode(encoded, (int)enc_len, dec_out); break;
+            case ALG_B64_DEC_TABLE: acc += (size_t)base64_decode_table(encoded, enc_len, dec_out); break;
+            case ALG_B64_DEC_WIDE: acc += (size_t)base64_decode_wide(encoded, enc_len, dec_out); break;
+            case ALG_B64_DEC_STREAM: {
+                Base64Decoder d;
+                long o = 0;
+                base64_decoder_init(&d);
+                for (size_t i = 0; i < enc_len; i += STREAM_CHUNK) {
+                    size_t n = enc_len - i < STREAM_CHUNK ? enc_len - i : STREAM_CHUNK;
+                    o += base64_decoder_update(&d, encoded + i, n, dec_out + o);
+                }
+                acc += (size_t)o + (size_t)base64_decoder_final(&d);
+                break;
+            }
+            case ALG_UTF8_REF: {
+                int chars = 0;
+                acc += (size_t)validate_utf8(text, BENCH_SIZE, &chars) + (size_t)chars;
+                break;
+            }
+            case ALG_UTF8_DFA: {
+                size_t chars;
+                acc += (size_t)utf8_validate_dfa(text, BENCH_SIZE, &chars) + chars;
+                break;
+            }
+            case ALG_UTF8_LOOKUP: {
+                size_t chars;
+                acc += (size_t)utf8_validate_lookup(text, BENCH_SIZE, &chars) + chars;
+                break;
+            }
+            default: {
+                Utf8Validator v;
+                size_t chars;
+                utf8_validator_init(&v);
+                for (size_t i = 0; i < BENCH_SIZE; i += STREAM_CHUNK) utf8_validator_update(&v, text + i, STREAM_CHUNK);
+                acc += (size_t)utf8_validator_final(&v, &chars) + chars;
+                break;
+            }
+        }
+    }
+    sink = acc;
+    double t = (double)(clock() - start) / CLOCKS_PER_SEC;
+    return t > 0 ? (double)reps * size / t / 1e9 : 0.0;
+}
+
+int main() {
+    base64_init_tables();
+    utf8_init_tables();
+    utf8_init_lookup();
+    clock_t start = clock();
+    int failures = fuzz_base64();
+    failures += fuzz_utf8_validators();
+
+    uint8_t *texts[NUM_TEXTS];
+    char *encoded[NUM_TEXTS];
+    size_t enc_len[NUM_TEXTS];
+    char *enc_out = (char*)malloc(base64_encoded_len(BENCH_SIZE) + 1);
+    uint8_t *dec_out = (uint8_t*)malloc(BENCH_SIZE + 8);
+    for (int k = 0; k < NUM_TEXTS; k++) {
+        texts[k] = (uint8_t*)malloc(BENCH_SIZE);
+        generate_text(k, texts[k], BENCH_SIZE, 2024 + k);
+        encoded[k] = (char*)malloc(base64_encoded_len(BENCH_SIZE));
+        enc_len[k] = base64_encode_wide(texts[k], BENCH_SIZE, encoded[k]);
+        // the benchmark texts must round-trip and validate under every implementation
+        int chars = 0;
+        size_t c1, c2;
+        int ok = validate_utf8(texts[k], BENCH_SIZE, &chars);
+        if (!ok || !utf8_validate_dfa(texts[k], BENCH_SIZE, &c1) || !utf8_validate_lookup(texts[k], BENCH_SIZE, &c2) ||
+            c1 != (size_t)chars || c2 != (size_t)chars) failures++;
+        if (base64_decode_wide(encoded[k], enc_len[k], dec_out) != BENCH_SIZE ||
+            memcmp(dec_out, texts[k], BENCH_SIZE) != 0) failures++;
+    }
+
+    printf("%-20s", "GB/s");
+    for (int k = 0; k < NUM_TEXTS; k++) printf("%17s", text_names[k]);
+    printf("\n");
+    for (int alg = 0; alg < NUM_ALGS; alg++) {
+        printf("%-20s", alg_names[alg]);
+        for (int k = 0; k < NUM_TEXTS; k++) {
+            printf("%17.3f", time_alg(alg, texts[k], encoded[k], enc_len[k], enc_out, dec_out));
+        }
+        printf("\n");
+    }
+
+    clock_t end = clock();
+    printf("Text codecs: %d fuzz inputs per codec, %d KB texts, %.6f seconds\n",
+           FUZZ_TRIALS, BENCH_SIZE >> 10, (double)(end - start) / CLOCKS_PER_SEC);
+    printf("Failures: %d\n", failures);
+    for (int k = 0; k < NUM_TEXTS; k++) {
+        free(texts[k]);
+        free(encoded[k]);
+    }
+    free(enc_out);
+    free(dec_out);
+    return 0;
+}
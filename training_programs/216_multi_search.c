@@ -0,0 +1,1127 @@
+// Multi-pattern search: Aho-Corasick as dense DFA or double-array, Teddy prefilter, Horspool
+// Engine picked from pattern count/length, streaming across buffers; checked against 15, 44, 14, 13, 111
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#define NUM_COUNTS 5          // pattern-set sizes benchmarked, 1 .. 10000
+#ifdef FULL_SIZE
+#define TEXT_MB 16            // benchmark text; raise to 1024 for the 1 GB run
+#define REF_SLICE (1 << 20)   // text prefix searched by the single-pattern references
+#define FUZZ_TRIALS 400       // random pattern sets checked against the naive search
+#else
+#define TEXT_MB 1             // -DFULL_SIZE for a 16 MB text, 1 MB reference slice and 400 fuzz sets
+#define REF_SLICE (256 << 10)
+#define FUZZ_TRIALS 150
+#endif
+#define VOCAB_SIZE 20000      // distinct words the text and the patterns are drawn from
+#define STREAM_CHUNK (64 << 10)
+#define TEDDY_MAX_PATTERNS 64 // larger sets go to Aho-Corasick
+#define TEDDY_BUCKETS 8       // one bit per bucket in the fingerprint masks
+#define DFA_MAX_ENTRIES (1 << 18) // dense table cap (1 MB, cache resident); bigger sets use the double array
+#define HORSPOOL_MIN_LEN 4    // single patterns shorter than this go to Teddy
+
+static const int pattern_counts[] = {1, 10, 100, 1000, 10000};
+
+// ---------------------------------------------------------------------------
+// Match sink. Engines report (pattern, end offset) pairs; the sink keeps a
+// count and an order-independent hash so engines that report in different
+// orders can be compared. The stream uses the two limits to drop matches it
+// has already seen or will see again.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    uint64_t count;
+    uint64_t hash;
+    uint64_t end_after;       // report only matches ending past this offset
+    uint64_t start_before;    // ... and starting before this one
+} MatchSink;
+
+void sink_init(MatchSink *m) {
+    m->count = 0;
+    m->hash = 0;
+    m->end_after = 0;
+    m->start_before = UINT64_MAX;
+}
+
+static inline uint64_t mix64(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDULL;
+    x ^= x >> 33;
+    x *= 0xC4CEB9FE1A85EC53ULL;
+    return x ^ (x >> 33);
+}
+
+static inline void sink_report(MatchSink *m, int pattern, uint64_t end, int len) {
+    if (end <= m->end_after || end - len >= m->start_before) return;
+    m->count++;
+    m->hash += mix64((uint64_t)pattern << 40 ^ end);
+}
+
+// ---------------------------------------------------------------------------
+// Pattern trie with failure and dictionary links. Children are kept as
+// sibling lists; the trie is only the build-time form and is compiled into
+// one of the two scan-time automata below. dict[v] is the nearest proper
+// suffix of v that ends a pattern, so reporting walks only output states.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    int *child, *sibling, *fail, *out, *dict;
+    uint8_t *byte;
+    int *order;               // nodes in BFS order, root first
+    int *pat_next;            // next pattern ending at the same node
+    int num_nodes, cap;
+} Trie;
+
+static int trie_new_node(Trie *t, int b) {
+    if (t->num_nodes == t->cap) {
+        t->cap *= 2;
+        t->child = (int*)realloc(t->child, t->cap * sizeof(int));
+        t->sibling = (int*)realloc(t->sibling, t->cap * sizeof(int));
+        t->fail = (int*)realloc(t->fail, t->cap * sizeof(int));
+        t->out = (int*)realloc(t->out, t->cap * sizeof(int));
+        t->dict = (int*)realloc(t->dict, t->cap * sizeof(int));
+        t->byte = (uint8_t*)realloc(t->byte, t->cap);
+    }
+    int v = t->num_nodes++;
+    t->child[v] = t->sibling[v] = t->out[v] = t->dict[v] = -1;
+    t->fail[v] = 0;
+    t->byte[v] = (uint8_t)b;
+    return v;
+}
+
+static int trie_goto(const Trie *t, int v, int b) {
+    for (int c = t->child[v]; c >= 0; c = t->sibling[c]) {
+        if (t->byte[c] == b) return c;
+    }
+    return -1;
+}
+
+void trie_build(Trie *t, const uint8_t *const *pats, const int *lens, int count) {
+    t->cap = 1024;
+    t->num_nodes = 0;
+    t->child = (int*)malloc(t->cap * sizeof(int));
+    t->sibling = (int*)malloc(t->cap * sizeof(int));
+    t->fail = (int*)malloc(t->cap * sizeof(int));
+    t->out = (int*)malloc(t->cap * sizeof(int));
+    t->dict = (int*)malloc(t->cap * sizeof(int));
+    t->byte = (uint8_t*)malloc(t->cap);
+    t->pat_next = (int*)malloc(count * sizeof(int));
+    trie_new_node(t, 0);
+    for (int p = 0; p < count; p++) {
+        int v = 0;
+        for (int j = 0; j < lens[p]; j++) {
+            int c = trie_goto(t, v, pats[p][j]);
+            if (c < 0) {
+                c = trie_new_node(t, pats[p][j]);
+                t->sibling[c] = t->child[v];
+                t->child[v] = c;
+            }
+            v = c;
+        }
+        t->pat_next[p] = t->out[v];
+        t->out[v] = p;
+    }
+
+    t->order = (int*)malloc(t->num_nodes * sizeof(int));
+    int head = 0, tail = 0;
+    t->order[tail++] = 0;
+    while (head < tail) {
+        int u = t->order[head++];
+        for (int v = t->child[u]; v >= 0; v = t->sibling[v]) {
+            int f = 0;
+            if (u != 0) {
+                f = t->fail[u];
+                while (f != 0 && trie_goto(t, f, t->byte[v]) < 0) f = t->fail[f];
+                int g = trie_goto(t, f, t->byte[v]);
+                f = g >= 0 ? g : 0;
+            }
+            t->fail[v] = f;
+            t->dict[v] = t->out[f] >= 0 ? f : t->dict[f];
+            t->order[tail++] = v;
+        }
+    }
+}
+
+void trie_free(Trie *t) {
+    free(t->child);
+    free(t->sibling);
+    free(t->fail);
+    free(t->out);
+    free(t->dict);
+    free(t->byte);
+    free(t->order);
+    free(t->pat_next);
+}
+
+static inline int trie_has_output(const Trie *t, int v) {
+    return t->out[v] >= 0 || t->dict[v] >= 0;
+}
+
+// ---------------------------------------------------------------------------
+// Searcher: the pattern set plus whichever engine was compiled for it
+// ---------------------------------------------------------------------------
+
+enum { ENGINE_AUTO = -1, ENGINE_HORSPOOL, ENGINE_TEDDY, ENGINE_DFA, ENGINE_DOUBLE_ARRAY, NUM_ENGINES };
+
+static const char *engine_names[NUM_ENGINES] = {"horspool", "teddy", "ac-dfa", "ac-double-array"};
+
+typedef struct {
+    uint8_t cls[256];         // byte -> column; bytes in no pattern share column 0
+    int num_classes;
+    int32_t *next;            // next[row + cls] is a row offset (state * num_classes)
+    int32_t first_match_row;  // states with outputs are numbered last
+    int *row_node;            // trie node of each state
+} Dfa;
+
+typedef struct {
+    int32_t *base, *check, *fail;
+    int32_t *node;            // trie node in each slot, -1 when empty
+    uint8_t *has_out;
+    int32_t root_next[256];   // the root always has a full row
+    int size;
+} DoubleArray;
+
+typedef struct {
+    int fp_len;               // fingerprint bytes: min(3, shortest pattern)
+    uint8_t masks[3][256];    // bucket bits allowed at each fingerprint position
+    int bucket_start[TEDDY_BUCKETS + 1];
+    int *bucket_pats;         // pattern ids grouped by bucket
+} Teddy;
+
+typedef struct {
+    int engine;
+    int count, min_len, max_len;
+    uint8_t **pats;
+    int *lens;
+    Trie trie;
+    Dfa dfa;
+    DoubleArray da;
+    Teddy teddy;
+    int shift[256];           // Horspool bad-character shifts
+} Searcher;
+
+static void report_outputs(const Searcher *s, int v, uint64_t end, MatchSink *sink) {
+    const Trie *t = &s->trie;
+    for (; v >= 0; v = t->dict[v]) {
+        for (int p = t->out[v]; p >= 0; p = t->pat_next[p]) sink_report(sink, p, end, s->lens[p]);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Aho-Corasick, dense DFA. Failure links are folded into the table so each
+// byte is exactly one load; bytes that appear in no pattern share a column.
+// ---------------------------------------------------------------------------
+
+static long dfa_entries(const Searcher *s) {
+    int used[256] = {0}, classes = 1;
+    for (int p = 0; p < s->count; p++) {
+        for (int j = 0; j < s->lens[p]; j++) {
+            if (!used[s->pats[p][j]]) {
+                used[s->pats[p][j]] = 1;
+                classes++;
+            }
+        }
+    }
+    return (long)s->trie.num_nodes * classes;
+}
+
+void dfa_build(Searcher *s) {
+    Dfa *d = &s->dfa;
+    const Trie *t = &s->trie;
+    memset(d->cls, 0, sizeof(d->cls));
+    d->num_classes = 1;
+    for (int v = 1; v < t->num_nodes; v++) {
+        if (d->cls[t->byte[v]] == 0) d->cls[t->byte[v]] = (uint8_t)d->num_classes++;
+    }
+    int n = t->num_nodes, nc = d->num_classes;
+    // renumber: states without outputs first (root stays 0), BFS order within each group
+    int *id = (int*)malloc(n * sizeof(int));
+    int next_id = 0;
+    for (int k = 0; k < n; k++) {
+        if (!trie_has_output(t, t->order[k])) id[t->order[k]] = next_id++;
+    }
+    d->first_match_row = next_id * nc;
+    for (int k = 0; k < n; k++) {
+        if (trie_has_output(t, t->order[k])) id[t->order[k]] = next_id++;
+    }
+    d->next = (int32_t*)malloc((size_t)n * nc * sizeof(int32_t));
+    d->row_node = (int*)malloc(n * sizeof(int));
+    for (int k = 0; k < n; k++) {
+        int u = t->order[k];
+        int32_t *row = d->next + (size_t)id[u] * nc;
+        d->row_node[id[u]] = u;
+        // rows are filled in BFS order, so the failure state's row is complete
+        if (u == 0) memset(row, 0, nc * sizeof(int32_t));
+        else memcpy(row, d->next + (size_t)id[t->fail[u]] * nc, nc * sizeof(int32_t));
+        for (int c = t->child[u]; c >= 0; c = t->sibling[c]) row[d->cls[t->byte[c]]] = id[c] * nc;
+    }
+    free(id);
+}
+
+static void dfa_scan(const Searcher *s, int32_t *state, const uint8_t *p, size_t n, uint64_t base, MatchSink *sink) {
+    const Dfa *d = &s->dfa;
+    const int32_t *next = d->next;
+    int32_t r = *state;
+    for (size_t i = 0; i < n; i++) {
+        r = next[r + d->cls[p[i]]];
+        if (r >= d->first_match_row) report_outputs(s, d->row_node[r / d->num_classes], base + i + 1, sink);
+    }
+    *state = r;
+}
+
+// ---------------------------------------------------------------------------
+// Aho-Corasick, double array. A state's children live at base[s] + byte and
+// are recognised by check[slot] == s, so memory is about two ints per state
+// regardless of alphabet; a miss follows the failure link.
+// ---------------------------------------------------------------------------
+
+static inline void da_reserve(DoubleArray *da, int need) {
+    if (need <= da->size) return;
+    int size = da->size ? da->size : 256;
+    while (size < need) size *= 2;
+    da->base = (int32_t*)realloc(da->base, size * sizeof(int32_t));
+    da->check = (int32_t*)realloc(da->check, size * sizeof(int32_t));
+    da->fail = (int32_t*)realloc(da->fail, size * sizeof(int32_t));
+    da->node = (int32_t*)realloc(da->node, size * sizeof(int32_t));
+    for (int i = da->size; i < size; i++) {
+        da->base[i] = 0;
+        da->check[i] = -1;
+        da->fail[i] = 0;
+        da->node[i] = -1;
+    }
+    da->size = size;
+}
+
+void da_build(Searcher *s) {
+    DoubleArray *da = &s->da;
+    const Trie *t = &s->trie;
+    da->base = da->check = da->fail = da->node = NULL;
+    da->size = 0;
+    da_reserve(da, 2 * t->num_nodes + 256);
+    da->check[0] = -2;        // root slot is taken
+    da->node[0] = 0;
+
+    int *slot = (int*)malloc(t->num_nodes * sizeof(int));
+    slot[0] = 0;
+    // next_check is where the search for a free slot starts; like darts, it
+    // only moves past a region once that region is almost entirely taken
+    int next_check = 1, max_slot = 0;
+    for (int k = 0; k < t->num_nodes; k++) {
+        int u = t->order[k];
+        int c0 = t->child[u];
+        if (c0 < 0) continue;
+        int pos = next_check > t->byte[c0] + 1 ? next_check : t->byte[c0] + 1;
+        int start = pos, taken = 0, first_empty = -1;
+        for (;; pos++) {
+            da_reserve(da, pos + 257);
+            if (da->check[pos] != -1) {
+                taken++;
+                continue;
+            }
+            if (first_empty < 0) first_empty = pos;
+            int b = pos - t->byte[c0];
+            int ok = 1;
+            for (int c = t->sibling[c0]; c >= 0 && ok; c = t->sibling[c]) ok = da->check[b + t->byte[c]] == -1;
+            if (ok) break;
+        }
+        int b = pos - t->byte[c0];
+        da->base[slot[u]] = b;
+        for (int c = c0; c >= 0; c = t->sibling[c]) {
+            int sl = b + t->byte[c];
+            da->check[sl] = slot[u];
+            da->node[sl] = c;
+            slot[c] = sl;
+            if (sl > max_slot) max_slot = sl;
+        }
+        if (20 * taken >= 19 * (pos - start + 1) && first_empty > next_check) next_check = first_empty;
+    }
+    // leaves keep base 0; pad so base + 255 stays inside the arrays
+    da_reserve(da, max_slot + 257);
+    da->has_out = (uint8_t*)calloc(da->size, 1);
+    for (int v = 1; v < t->num_nodes; v++) {
+        da->fail[slot[v]] = slot[t->fail[v]];
+        da->has_out[slot[v]] = (uint8_t)trie_has_output(t, v);
+    }
+    for (int b = 0; b < 256; b++) da->root_next[b] = 0;
+    for (int c = t->child[0]; c >= 0; c = t->sibling[c]) da->root_next[t->byte[c]] = slot[c];
+    free(slot);
+}
+
+static void da_scan(const Searcher *s, int32_t *state, const uint8_t *p, size_t n, uint64_t base, MatchSink *sink) {
+    const DoubleArray *da = &s->da;
+    int32_t st = *state;
+    for (size_t i = 0; i < n; i++) {
+        int c = p[i];
+        for (;;) {
+            if (st == 0) {
+                st = da->root_next[c];
+                break;
+            }
+            int32_t t = da->base[st] + c;
+            if (da->check[t] == st) {
+                st = t;
+                break;
+            }
+            st = da->fail[st];
+        }
+        if (da->has_out[st]) report_outputs(s, da->node[st], base + i + 1, sink);
+    }
+    *state = st;
+}
+
+// ---------------------------------------------------------------------------
+// Teddy prefilter for small sets. Patterns are sorted by their first bytes
+// and split into 8 buckets; masks[k][b] has bit j set when some pattern in
+// bucket j has byte b at offset k. ANDing the masks of 3 consecutive bytes
+// gives the buckets that can start at a position. Eight positions are packed
+// into one 64-bit word per step, so the loop branches once per 8 bytes and
+// only verifies (memcmp) the buckets that survive.
+// ---------------------------------------------------------------------------
+
+static const Searcher *sort_ctx;
+
+static int cmp_fingerprint(const void *a, const void *b) {
+    int pa = *(const int *)a, pb = *(const int *)b;
+    int c = memcmp(sort_ctx->pats[pa], sort_ctx->pats[pb], sort_ctx->teddy.fp_len);
+    return c ? c : pa - pb;
+}
+
+void teddy_build(Searcher *s) {
+    Teddy *td = &s->teddy;
+    td->fp_len = s->min_len < 3 ? s->min_len : 3;
+    td->bucket_pats = (int*)malloc(s->count * sizeof(int));
+    for (int p = 0; p < s->count; p++) td->bucket_pats[p] = p;
+    sort_ctx = s;
+    qsort(td->bucket_pats, s->count, sizeof(int), cmp_fingerprint);
+    for (int k = 0; k < 3; k++) memset(td->masks[k], k < td->fp_len ? 0 : 0xFF, 256);
+    int per = (s->count + TEDDY_BUCKETS - 1) / TEDDY_BUCKETS;
+    for (int b = 0; b <= TEDDY_BUCKETS; b++) td->bucket_start[b] = b * per < s->count ? b * per : s->count;
+    for (int b = 0; b < TEDDY_BUCKETS; b++) {
+        for (int i = td->bucket_start[b]; i < td->bucket_start[b + 1]; i++) {
+            const uint8_t *pat = s->pats[td->bucket_pats[i]];
+            for (int k = 0; k < td->fp_len; k++) td->masks[k][pat[k]] |= (uint8_t)(1 << b);
+        }
+    }
+}
+
+static void teddy_verify(const Searcher *s, uint64_t m, const uint8_t *p, size_t n, size_t i,
+                         uint64_t base, MatchSink *sink) {
+    const Teddy *td = &s->teddy;
+    while (m) {
+        int bit = __builtin_ctzll(m);
+        size_t start = i + (bit >> 3);
+        int b = bit & 7;
+        for (int k = td->bucket_start[b]; k < td->bucket_start[b + 1]; k++) {
+            int pid = td->bucket_pats[k];
+            int len = s->lens[pid];
+            if (start + len <= n && memcmp(p + start, s->pats[pid], len) == 0) {
+                sink_report(sink, pid, base + start + len, len);
+            }
+        }
+        m &= m - 1;
+    }
+}
+
+static void teddy_scan(const Searcher *s, const uint8_t *p, size_t n, uint64_t base, MatchSink *sink) {
+    const Teddy *td = &s->teddy;
+    const uint8_t *m0 = td->masks[0], *m1 = td->masks[1], *m2 = td->masks[2];
+    size_t starts = n >= (size_t)td->fp_len ? n - td->fp_len + 1 : 0;
+    size_t i = 0;
+    for (; i + 10 <= n && i + 8 <= starts; i += 8) {
+        uint64_t m = 0;
+        for (int j = 0; j < 8; j++) {
+            m |= (uint64_t)(m0[p[i + j]] & m1[p[i + j + 1]] & m2[p[i + j + 2]]) << (8 * j);
+        }
+        if (m) teddy_verify(s, m, p, n, i, base, sink);
+    }
+    for (; i < starts; i++) {
+        uint8_t m = m0[p[i]];
+        if (td->fp_len > 1) m &= m1[p[i + 1]];
+        if (td->fp_len > 2) m &= m2[p[i + 2]];
+        if (m) teddy_verify(s, m, p, n, i, base, sink);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Horspool for one longer pattern: compare the window's last byte first and
+// shift by that byte's distance from the pattern end.
+// ---------------------------------------------------------------------------
+
+void horspool_build(Searcher *s) {
+    int m = s->lens[0];
+    for (int c = 0; c < 256; c++) s->shift[c] = m;
+    for (int j = 0; j < m - 1; j++) s->shift[s->pats[0][j]] = m - 1 - j;
+}
+
+static void horspool_scan(const Searcher *s, const uint8_t *p, size_t n, uint64_t base, MatchSink *sink) {
+    const uint8_t *pat = s->pats[0];
+    size_t m = (size_t)s->lens[0];
+    uint8_t last = pat[m - 1];
+    for (size_t i = 0; i + m <= n;) {
+        uint8_t c = p[i + m - 1];
+        if (c == last && memcmp(p + i, pat, m - 1) == 0) sink_report(sink, 0, base + i + m, (int)m);
+        i += s->shift[c];
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Building, engine selection and one-shot search
+// ---------------------------------------------------------------------------
+
+static int select_engine(const Searcher *s) {
+    if (s->count == 1 && s->min_len >= HORSPOOL_MIN_LEN) return ENGINE_HORSPOOL;
+    // a 1- or 2-byte fingerprint over many buckets passes too much to verification
+    if (s->count <= TEDDY_BUCKETS || (s->count <= TEDDY_MAX_PATTERNS && s->min_len >= 3)) return ENGINE_TEDDY;
+    return dfa_entries(s) <= DFA_MAX_ENTRIES ? ENGINE_DFA : ENGINE_DOUBLE_ARRAY;
+}
+
+// Returns 0, or -1 when the requested engine cannot handle this pattern set
+int searcher_build(Searcher *s, const uint8_t *const *pats, const int *lens, int count, int engine) {
+    s->count = count;
+    s->pats = (uint8_t**)malloc(count * sizeof(uint8_t *));
+    s->lens = (int*)malloc(count * sizeof(int));
+    s->min_len = 1 << 30;
+    s->max_len = 0;
+    for (int p = 0; p < count; p++) {
+        s->lens[p] = lens[p];
+        s->pats[p] = (uint8_t*)malloc(lens[p]);
+        memcpy(s->pats[p], pats[p], lens[p]);
+        if (lens[p] < s->min_len) s->min_len = lens[p];
+        if (lens[p] > s->max_len) s->max_len = lens[p];
+    }
+    trie_build(&s->trie, pats, lens, count);
+    if (engine == ENGINE_AUTO) engine = select_engine(s);
+    int ok = (engine != ENGINE_HORSPOOL || count == 1) &&
+             (engine != ENGINE_TEDDY || count <= TEDDY_MAX_PATTERNS) &&
+             (engine != ENGINE_DFA || dfa_entries(s) <= DFA_MAX_ENTRIES);
+    s->engine = ok ? engine : ENGINE_AUTO;   // nothing engine-specific to free on failure
+    if (!ok) return -1;
+    switch (engine) {
+        case ENGINE_HORSPOOL: horspool_build(s); break;
+        case ENGINE_TEDDY: teddy_build(s); break;
+        case ENGINE_DFA: dfa_build(s); break;
+        default: da_build(s); break;
+    }
+    return 0;
+}
+
+void searcher_free(Searcher *s) {
+    switch (s->engine) {
+        case ENGINE_TEDDY: free(s->teddy.bucket_pats); break;
+        case ENGINE_DFA:
+            free(s->dfa.next);
+            free(s->dfa.row_node);
+            break;
+        case ENGINE_DOUBLE_ARRAY:
+            free(s->da.base);
+            free(s->da.check);
+            free(s->da.fail);
+            free(s->da.node);
+            free(s->da.has_out);
+            break;
+        default: break;
+    }
+    trie_free(&s->trie);
+    for (int p = 0; p < s->count; p++) free(s->pats[p]);
+    free(s->pats);
+    free(s->lens);
+}
+
+static int engine_is_automaton(int engine) {
+    return engine == ENGINE_DFA || engine == ENGINE_DOUBLE_ARRAY;
+}
+
+static void scan_automaton(const Searcher *s, int32_t *state, const uint8_t *p, size_t n, uint64_t base, MatchSink *sink) {
+    if (s->engine == ENGINE_DFA) dfa_scan(s, state, p, n, base, sink);
+    else da_scan(s, state, p, n, base, sink);
+}
+
+static void scan_window(const Searcher *s, const uint8_t *p, size_t n, uint64_t base, MatchSink *sink) {
+    if (s->engine == ENGINE_HORSPOOL) horspool_scan(s, p, n, base, sink);
+    else teddy_scan(s, p, n, base, sink);
+}
+
+void searcher_scan(const Searcher *s, const uint8_t *p, size_t n, MatchSink *sink) {
+    if (engine_is_automaton(s->engine)) {
+        int32_t state = 0;
+        scan_automaton(s, &state, p, n, 0, sink);
+    } else {
+        scan_window(s, p, n, 0, sink);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Streaming search. The automata simply keep their state between chunks.
+// The window engines keep the last max_len - 1 bytes; each new chunk first
+// rescans that tail joined with the chunk's head, keeping only matches that
+// straddle the boundary, then scans the chunk itself.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    const Searcher *s;
+    int32_t state;
+    uint8_t *window;          // tail of earlier input, then room for the next chunk's head
+    size_t tail_len;
+    uint64_t offset;          // absolute offset of the next chunk
+} SearchStream;
+
+void stream_init(SearchStream *st, const Searcher *s) {
+    st->s = s;
+    st->state = 0;
+    st->window = (uint8_t*)malloc(2 * (size_t)s->max_len);
+    st->tail_len = 0;
+    st->offset = 0;
+}
+
+void stream_feed(SearchStream *st, const uint8_t *p, size_t n, MatchSink *sink) {
+    const Searcher *s = st->s;
+    if (engine_is_automaton(s->engine)) {
+        scan_automaton(s, &st->state, p, n, st->offset, sink);
+        st->offset += n;
+        return;
+    }
+    size_t keep = (size_t)s->max_len - 1;
+    size_t head = n < keep ? n : keep;
+    memcpy(st->window + st->tail_len, p, head);
+    if (st->tail_len > 0 && head > 0) {
+        uint64_t end_after = sink->end_after, start_before = sink->start_before;
+        sink->end_after = st->offset;
+        sink->start_before = st->offset;
+        scan_window(s, st->window, st->tail_len + head, st->offset - st->tail_len, sink);
+        sink->end_after = end_after;
+        sink->start_before = start_before;
+    }
+    scan_window(s, p, n, st->offset, sink);
+    if (n >= keep) {
+        memcpy(st->window, p + n - keep, keep);
+        st->tail_len = keep;
+    } else {
+        size_t total = st->tail_len + n;
+        size_t drop = total > keep ? total - keep : 0;
+        memmove(st->window, st->window + drop, total - drop);
+        st->tail_len = total - drop;
+    }
+    st->offset += n;
+}
+
+void stream_free(SearchStream *st) { free(st->window); }
+
+// ---------------------------------------------------------------------------
+// Reference implementations (15, 44, 14, 13, 111)
+// ---------------------------------------------------------------------------
+
+#define MAXS 5000
+#define MAXC 26
+
+int out_15[MAXS];
+int go_to[MAXS][MAXC];
+int states = 1;
+
+void build_goto(char* patterns[], int k) {
+    memset(out_15, 0, sizeof(out_15));
+    memset(go_to, -1, sizeof(go_to));
+
+    for (int i = 0; i < k; i++) {
+        char* word = patterns[i];
+        int current = 0;
+
+        for (int j = 0; word[j] != '\0'; j++) {
+            int ch = word[j] - 'a';
+
+            if (go_to[current][ch] == -1)
+                go_to[current][ch] = states++;
+
+            current = go_to[current][ch];
+        }
+        out_15[current] |= (1 << i);
+    }
+
+    for (int ch = 0; ch < MAXC; ch++)
+        if (go_to[0][ch] == -1)
+            go_to[0][ch] = 0;
+}
+
+int search_words(char* text, int k) {
+    (void)k;
+    int current = 0;
+    int count = 0;
+
+    for (int i = 0; text[i] != '\0'; i++) {
+        int ch = text[i] - 'a';
+        if (ch < 0 || ch >= MAXC)
+            continue;
+
+        while (current != 0 && go_to[current][ch] == -1)
+            current = 0;
+
+        if (go_to[current][ch] != -1)
+            current = go_to[current][ch];
+
+        if (out_15[current] != 0)
+            count++;
+    }
+
+    return count;
+}
+
+void compute_lps(const char *pattern, int m, int *lps) {
+    int len = 0;
+    lps[0] = 0;
+    int i = 1;
+
+    while (i < m) {
+        if (pattern[i] == pattern[len]) {
+            len++;
+            lps[i] = len;
+            i++;
+        } else {
+            if (len != 0) {
+                len = lps[len - 1];
+            } else {
+                lps[i] = 0;
+                i++;
+            }
+        }
+    }
+}
+
+int kmp_search(const char *text, int n, const char *pattern, int m, int *matches) {
+    int *lps = (int*)malloc(m * sizeof(int));
+    compute_lps(pattern, m, lps);
+
+    int count = 0;
+    int i = 0, j = 0;
+
+    while (i < n) {
+        if (pattern[j] == text[i]) {
+            i++;
+            j++;
+        }
+
+        if (j == m) {
+            matches[count++] = i - j;
+            j = lps[j - 1];
+        } else if (i < n && pattern[j] != text[i]) {
+            if (j != 0) {
+                j = lps[j - 1];
+            } else {
+                i++;
+            }
+        }
+    }
+
+    free(lps);
+    return count;
+}
+
+#define MAX_CHAR 256
+
+void bad_char_heuristic(char* str, int size, int badchar[MAX_CHAR]) {
+    for (int i = 0; i < MAX_CHAR; i++)
+        badchar[i] = -1;
+    for (int i = 0; i < size; i++)
+        badchar[(int)str[i]] = i;
+}
+
+int boyer_moore(char* text, char* pattern) {
+    int m = strlen(pattern);
+    int n = strlen(text);
+    int badchar[MAX_CHAR];
+    int count = 0;
+
+    bad_char_heuristic(pattern, m, badchar);
+
+    int s = 0;
+    while (s <= (n - m)) {
+        int j = m - 1;
+
+        while (j >= 0 && pattern[j] == text[s + j])
+            j--;
+
+        if (j < 0) {
+            count++;
+            s += (s + m < n) ? m - badchar[(int)text[s + m]] : 1;
+        } else {
+            int shift = j - badchar[(int)text[s + j]];
+            s += (shift > 1) ? shift : 1;
+        }
+    }
+
+    return count;
+}
+
+#define d 256
+#define q 101
+
+int rabin_karp(char* text, char* pattern) {
+    int m = strlen(pattern);
+    int n = strlen(text);
+    int p = 0;
+    int t = 0;
+    int h = 1;
+    int count = 0;
+
+    for (int i = 0; i < m - 1; i++)
+        h = (h * d) % q;
+
+    for (int i = 0; i < m; i++) {
+        p = (d * p + pattern[i]) % q;
+        t = (d * t + text[i]) % q;
+    }
+
+    for (int i = 0; i <= n - m; i++) {
+        if (p == t) {
+            int j;
+            for (j = 0; j < m; j++) {
+                if (text[i + j] != pattern[j])
+                    break;
+            }
+            if (j == m)
+                count++;
+        }
+
+        if (i < n - m) {
+            t = (d * (t - text[i] * h) + text[i + m]) % q;
+            if (t < 0)
+                t = (t + q);
+        }
+    }
+
+    return count;
+}
+
+#undef d
+#undef q
+
+void compute_z_array(const char *str, int n, int *z) {
+    int l = 0, r = 0;
+    z[0] = n;
+
+    for (int i = 1; i < n; i++) {
+        if (i > r) {
+            l = r = i;
+            while (r < n && str[r - l] == str[r]) {
+                r++;
+            }
+            z[i] = r - l;
+            r--;
+        } else {
+            int k = i - l;
+            if (z[k] < r - i + 1) {
+                z[i] = z[k];
+            } else {
+                l = i;
+                while (r < n && str[r - l] == str[r]) {
+                    r++;
+                }
+                z[i] = r - l;
+                r--;
+            }
+        }
+    }
+}
+
+int z_algorithm_search(const char *text, const char *pattern, int *matches) {
+    int text_len = strlen(text);
+    int pattern_len = strlen(pattern);
+    int concat_len = pattern_len + 1 + text_len;
+
+    char *concat = (char*)malloc(concat_len + 1);
+    int *z = (int*)malloc(concat_len * sizeof(int));
+
+    // Create pattern$text
+    sprintf(concat, "%s$%s", pattern, text);
+
+    compute_z_array(concat, concat_len, z);
+
+    int match_count = 0;
+    for (int i = pattern_len + 1; i < concat_len; i++) {
+        if (z[i] == pattern_len) {
+            matches[match_count++] = i - pattern_len - 1;
+        }
+    }
+
+    free(concat);
+    free(z);
+
+    return match_count;
+}
+
+// ---------------------------------------------------------------------------
+// Inputs: a vocabulary of random words, text drawn from it with a skew
+// towards the first words, and pattern sets sampled from the vocabulary
+// ---------------------------------------------------------------------------
+
+static unsigned int next_rand(unsigned int *seed) {
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 8;
+}
+
+typedef struct {
+    char words[VOCAB_SIZE][12];
+    int lens[VOCAB_SIZE];
+} Vocabulary;
+
+void build_vocabulary(Vocabulary *v, unsigned int seed) {
+    for (int w = 0; w < VOCAB_SIZE; w++) {
+        int len = 3 + next_rand(&seed) % 8;
+        for (int j = 0; j < len; j++) v->words[w][j] = (char)('a' + next_rand(&seed) % 26);
+        v->words[w][len] = '\0';
+        v->lens[w] = len;
+    }
+}
+
+void generate_text(const Vocabulary *v, uint8_t *text, size_t size, unsigned int seed) {
+    size_t pos = 0;
+    while (pos < size) {
+        unsigned int a = next_rand(&seed) % VOCAB_SIZE, b = next_rand(&seed) % VOCAB_SIZE;
+        int w = (int)((uint64_t)a * b / VOCAB_SIZE);
+        for (int j = 0; j < v->lens[w] && pos < size; j++) text[pos++] = (uint8_t)v->words[w][j];
+        if (pos < size) text[pos++] = next_rand(&seed) % 16 == 0 ? '\n' : ' ';
+    }
+}
+
+// count distinct words; duplicates in the vocabulary are harmless
+void pick_patterns(const Vocabulary *v, int count, const uint8_t **pats, int *lens, unsigned int seed) {
+    int *perm = (int*)malloc(VOCAB_SIZE * sizeof(int));
+    for (int i = 0; i < VOCAB_SIZE; i++) perm[i] = i;
+    for (int i = 0; i < count; i++) {
+        int j = i + next_rand(&seed) % (VOCAB_SIZE - i);
+        int t = perm[i];
+        perm[i] = perm[j];
+        perm[j] = t;
+        pats[i] = (const uint8_t *)v->words[perm[i]];
+        lens[i] = v->lens[perm[i]];
+    }
+    free(perm);
+}
+
+// ---------------------------------------------------------------------------
+// Correctness
+// ---------------------------------------------------------------------------
+
+void naive_scan(const uint8_t *const *pats, const int *lens, int count, const uint8_t *p, size_t n, MatchSink *sink) {
+    for (size_t i = 0; i < n; i++) {
+        for (int k = 0; k < count; k++) {
+            if (i + lens[k] <= n && memcmp(p + i, pats[k], lens[k]) == 0) sink_report(sink, k, i + lens[k], lens[k]);
+        }
+    }
+}
+
+static int same(const MatchSink *a, const MatchSink *b) {
+    return a->count == b->count && a->hash == b->hash;
+}
+
+// Scans p in random-sized chunks, including empty and single-byte ones
+static void stream_random(const Searcher *s, const uint8_t *p, size_t n, unsigned int *seed, MatchSink *sink) {
+    SearchStream st;
+    stream_init(&st, s);
+    size_t i = 0;
+    while (i < n) {
+        size_t chunk = next_rand(seed) % 4 == 0 ? next_rand(seed) % 3 : next_rand(seed) % 64;
+        if (chunk > n - i) chunk = n - i;
+        stream_feed(&st, p + i, chunk, sink);
+        i += chunk;
+    }
+    stream_free(&st);
+}
+
+int fuzz_engines(void) {
+    static const uint8_t binary_bytes[] = {0x00, 0xFF, 0x80, 0x7F, 0x01, 0xFE};
+    int failures = 0;
+    unsigned int seed = 41;
+    uint8_t text[2048];
+    uint8_t pat_store[200][16];
+    const uint8_t *pats[200];
+    int lens[200];
+    for (int t = 0; t < FUZZ_TRIALS; t++) {
+        int alphabet = 2 + next_rand(&seed) % 5;
+        int binary = next_rand(&seed) % 4 == 0;   // bytes outside the letters, including 0 and 0xFF
+        int count = 1 + next_rand(&seed) % (t % 3 == 0 ? 200 : 12);
+        int max_len = 1 + next_rand(&seed) % 12;
+        size_t n = next_rand(&seed) % sizeof(text);
+        for (size_t i = 0; i < n; i++) {
+            unsigned int r = next_rand(&seed) % alphabet;
+            text[i] = binary ? binary_bytes[r] : (uint8_t)('a' + r);
+        }
+        for (int k = 0; k < count; k++) {
+            lens[k] = 1 + next_rand(&seed) % max_len;
+            // half the patterns are cut from the text so they occur
+            if (n > 16 && next_rand(&seed) % 2) {
+                size_t at = next_rand(&seed) % (n - lens[k]);
+                memcpy(pat_store[k], text + at, lens[k]);
+            } else {
+                for (int j = 0; j < lens[k]; j++) {
+                    unsigned int r = next_rand(&seed) % alphabet;
+                    pat_store[k][j] = binary ? binary_bytes[r] : (uint8_t)('a' + r);
+                }
+            }
+            pats[k] = pat_store[k];
+        }
+        MatchSink want;
+        sink_init(&want);
+        naive_scan(pats, lens, count, text, n, &want);
+        for (int e = ENGINE_AUTO; e < NUM_ENGINES; e++) {
+            Searcher s;
+            if (searcher_build(&s, pats, lens, count, e) == 0) {
+                MatchSink got, streamed;
+                sink_init(&got);
+                sink_init(&streamed);
+                searcher_scan(&s, text, n, &got);
+                stream_random(&s, text, n, &seed, &streamed);
+                if (!same(&got, &want) || !same(&streamed, &want)) failures++;
+            }
+            searcher_free(&s);
+        }
+    }
+    return failures;
+}
+
+int check_against_references(const Vocabulary *v, const uint8_t *text) {
+    int failures = 0;
+    char *slice = (char*)malloc(REF_SLICE + 1);
+    memcpy(slice, text, REF_SLICE);
+    slice[REF_SLICE] = '\0';
+    int *positions = (int*)malloc(REF_SLICE * sizeof(int));
+
+    // single patterns: common, rare and absent words, and a phrase spanning a space
+    const char *extra[] = {"zzzzzzzq", "e a"};
+    for (int k = 0; k < 8; k++) {
+        const char *pat = k < 6 ? v->words[k * k * 40] : extra[k - 6];
+        int len = (int)strlen(pat);
+        int kmp = kmp_search(slice, REF_SLICE, pat, len, positions);
+        MatchSink want;
+        sink_init(&want);
+        for (int i = 0; i < kmp; i++) sink_report(&want, 0, (uint64_t)positions[i] + len, len);
+        int z = z_algorithm_search(slice, pat, positions);
+        if (z != kmp || boyer_moore(slice, (char *)pat) != kmp || rabin_karp(slice, (char *)pat) != kmp) failures++;
+        const uint8_t *pp = (const uint8_t *)pat;
+        for (int e = 0; e < NUM_ENGINES; e++) {
+            Searcher s;
+            if (searcher_build(&s, &pp, &len, 1, e) == 0) {
+                MatchSink got;
+                sink_init(&got);
+                searcher_scan(&s, (const uint8_t *)slice, REF_SLICE, &got);
+                if (!same(&got, &want)) failures++;
+            }
+            searcher_free(&s);
+        }
+    }
+
+    // 15 on its own pattern set, where resetting to the root loses no match
+    char *patterns[] = {"abc", "def", "ghi", "jkl"};
+    unsigned int seed = 15;
+    for (int i = 0; i < REF_SLICE; i++) slice[i] = (char)('a' + next_rand(&seed) % 12);
+    build_goto(patterns, 4);
+    int ref = search_words(slice, 4);
+    const uint8_t *pats[4];
+    int lens[4];
+    for (int k = 0; k < 4; k++) {
+        pats[k] = (const uint8_t *)patterns[k];
+        lens[k] = 3;
+    }
+    for (int e = 0; e < NUM_ENGINES; e++) {
+        Searcher s;
+        if (searcher_build(&s, pats, lens, 4, e) == 0) {
+            MatchSink got;
+            sink_init(&got);
+            searcher_scan(&s, (const uint8_t *)slice, REF_SLICE, &got);
+            if (got.count != (uint64_t)ref) failures++;
+        }
+        searcher_free(&s);
+    }
+    free(slice);
+    free(positions);
+    return failures;
+}
+
+// ---------------------------------------------------------------------------
+// Throughput
+// ---------------------------------------------------------------------------
+
+#define COL_AUTO NUM_ENGINES
+#define COL_STREAM (NUM_ENGINES + 1)
+
+// GB/s, or a negative value when the engine does not apply
+double time_engine(const uint8_t *const *pats, const int *lens, int count, int engine, int streaming,
+                   const uint8_t *text, size_t n, MatchSink *sink, int *chosen) {
+    Searcher s;
+    double gbs = -1.0;
+    if (searcher_build(&s, pats, lens, count, engine) == 0) {
+        *chosen = s.engine;
+        sink_init(sink);
+        clock_t start = clock();
+        if (streaming) {
+            SearchStream st;
+            stream_init(&st, &s);
+            for (size_t i = 0; i < n; i += STREAM_CHUNK) {
+                stream_feed(&st, text + i, n - i < STREAM_CHUNK ? n - i : STREAM_CHUNK, sink);
+            }
+            stream_free(&st);
+        } else {
+            searcher_scan(&s, text, n, sink);
+        }
+        double t = (double)(clock() - start) / CLOCKS_PER_SEC;
+        gbs = t > 0 ? n / t / 1e9 : 0.0;
+    }
+    searcher_free(&s);
+    return gbs;
+}
+
+int main() {
+    clock_t start = clock();
+    Vocabulary *vocab = (Vocabulary*)malloc(sizeof(Vocabulary));
+    build_vocabulary(vocab, 2024);
+    size_t n = (size_t)TEXT_MB << 20;
+    uint8_t *text = (uint8_t*)malloc(n);
+    generate_text(vocab, text, n, 7);
+
+    int failures = fuzz_engines();
+    failures += check_against_references(vocab, text);
+
+    int max_count = pattern_counts[NUM_COUNTS - 1];
+    const uint8_t **pats = (const uint8_t**)malloc(max_count * sizeof(uint8_t *));
+    int *lens = (int*)malloc(max_count * sizeof(int));
+
+    printf("%-9s", "GB/s");
+    for (int e = 0; e < NUM_ENGINES; e++) printf("%16s", engine_names[e]);
+    printf("%16s%16s  %-16s%12s\n", "auto", "auto stream", "auto picks", "matches");
+    for (int c = 0; c < NUM_COUNTS; c++) {
+        int count = pattern_counts[c];
+        pick_patterns(vocab, count, pats, lens, 100 + c);
+        printf("%-9d", count);
+        MatchSink first;
+        sink_init(&first);
+        int have_first = 0, chosen = 0;
+        for (int col = 0; col <= COL_STREAM; col++) {
+            MatchSink sink;
+            int engine = col < NUM_ENGINES ? col : ENGINE_AUTO;
+            double gbs = time_engine(pats, lens, count, engine, col == COL_STREAM, text, n, &sink, &chosen);
+            if (gbs < 0) {
+                printf("%16s", "-");
+                continue;
+            }
+            printf("%16.3f", gbs);
+            if (!have_first) {
+                first = sink;
+                have_first = 1;
+            } else if (!same(&sink, &first)) {
+                failures++;
+            }
+        }
+        printf("  %-16s%12llu\n", engine_names[chosen], (unsigned long long)first.count);
+    }
+
+    clock_t end = clock();
+    printf("Multi-pattern search: %d MB text, %d pattern-set sizes, %.6f seconds\n",
+           TEXT_MB, NUM_COUNTS, (double)(end - start) / CLOCKS_PER_SEC);
+    printf("Failures: %d\n", failures);
+    free(pats);
+    free(lens);
+    free(text);
+    free(vocab);
+    return 0;
+}
@@ -0,0 +1,1104 @@
+// Regex engine: parser -> Thompson NFA -> lazily built DFA with a bounded state cache
+// NFA simulation fallback when the cache thrashes, literal-prefix scan; compared with 180 on log lines
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef FULL_SIZE
+#define LOG_SIZE (16 << 20)   // log corpus bytes
+#else
+#define LOG_SIZE (512 << 10)  // log corpus bytes; -DFULL_SIZE for 16 MB
+#endif
+#define REF_SLICE (32 << 10)  // bytes of the corpus run through 180's list simulation
+#define DFA_CACHE_STATES 1024 // lazy DFA states kept before the cache is flushed
+#define DFA_MIN_BYTES_PER_STATE 16 // fewer bytes per cached state between flushes means thrashing
+#define MAX_NFA_STATES 20000  // larger patterns (mostly from {m,n}) are rejected
+#define MAX_REPEAT 255        // largest count allowed in {m,n}
+#define MAX_PREFIX 32         // longest literal prefix used to skip ahead
+#define FUZZ_TRIALS 3000      // random regexes checked across engines and against 180
+
+// ---------------------------------------------------------------------------
+// Byte sets and the parse tree. Every atom (literal, '.', class, escape)
+// becomes a 256-bit set, deduplicated per pattern.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    uint64_t bits[4];
+} ByteSet;
+
+static inline int set_has(const ByteSet *s, int b) { return (s->bits[b >> 6] >> (b & 63)) & 1; }
+static inline void set_add(ByteSet *s, int b) { s->bits[b >> 6] |= 1ULL << (b & 63); }
+
+static int set_count(const ByteSet *s) {
+    return __builtin_popcountll(s->bits[0]) + __builtin_popcountll(s->bits[1]) +
+           __builtin_popcountll(s->bits[2]) + __builtin_popcountll(s->bits[3]);
+}
+
+enum { A_SET, A_CAT, A_ALT, A_STAR, A_PLUS, A_QUEST, A_REPEAT, A_EMPTY };
+
+typedef struct {
+    int kind;
+    int left, right;          // children (right unused for unary nodes)
+    int min, max;             // A_REPEAT; max < 0 is unbounded
+    int set;                  // A_SET
+} AstNode;
+
+// ---------------------------------------------------------------------------
+// NFA. N_BYTE consumes one byte from its set; N_SPLIT is an epsilon fork;
+// N_EOL is the trailing '$' (passable only at the end of the line); N_MATCH
+// accepts. States are built back to front: compiling a node takes the state
+// that follows it and returns the node's entry state.
+// ---------------------------------------------------------------------------
+
+enum { N_BYTE, N_SPLIT, N_EOL, N_MATCH };
+
+typedef struct {
+    int kind;
+    int set;
+    int out, out1;            // out1 only for N_SPLIT
+} NfaState;
+
+// ---------------------------------------------------------------------------
+// Lazy DFA. A DFA state is the sorted set of NFA states (byte, EOL and match
+// states only) reachable after the input so far. Transitions are filled in
+// on first use; entries are row offsets tagged in the low two bits with
+// MATCH/DEAD so the scan loop tests one word per byte. When the cache is
+// full it is flushed; if flushes come faster than DFA_MIN_BYTES_PER_STATE
+// bytes per cached state, the search gives up and the NFA takes over.
+// ---------------------------------------------------------------------------
+
+#define DFA_MATCH 1
+#define DFA_DEAD 2
+#define DFA_EOL 4             // flags[] only: accepts at end of line
+#define DFA_UNKNOWN (-1)
+#define DFA_GAVE_UP (-2)
+
+enum { START_ANCHORED, START_UNANCHORED };
+
+typedef struct {
+    int cap;                  // cache bound in states
+    int num;
+    int *trans;               // cap * num_classes tagged entries
+    int *set_off, *set_len;   // each state's NFA set inside pool
+    uint8_t *flags;
+    int *pool;
+    int pool_len, pool_cap;
+    int *table;               // open-addressing hash: set -> state id
+    int table_mask;
+    int start[2];             // tagged start states, DFA_UNKNOWN until built
+    long bytes_since_flush;
+    int flushes;
+    int gave_up;
+} LazyDfa;
+
+typedef struct {
+    AstNode *ast;
+    int num_nodes, nodes_cap;
+    ByteSet *sets;
+    int num_sets, sets_cap;
+    NfaState *nfa;
+    int num_nfa, nfa_cap;
+    int start[2];             // NFA entry: anchored at the current byte, or anywhere later
+    int bol, eol;             // pattern began with '^' / ended with '$'
+    uint8_t prefix[MAX_PREFIX];
+    int prefix_len;
+    uint8_t cls[256];         // byte -> equivalence class
+    uint8_t class_rep[256];   // one byte of every class
+    int num_classes;
+    LazyDfa dfa;
+    int *mark, mark_gen;      // closure bookkeeping
+    int *stack, *list_a, *list_b;
+    const char *error;
+    // parser state
+    const char *pat;
+    int pos, len;
+} Regex;
+
+// ---------------------------------------------------------------------------
+// Parser: alt := cat ('|' cat)*, cat := repeat*, repeat := atom quantifier*,
+// atom := '(' alt ')' | '[' class ']' | '.' | '\' escape | byte.
+// '^' is accepted only at the very start and '$' only at the very end.
+// ---------------------------------------------------------------------------
+
+static int new_node(Regex *re, int kind, int left, int right) {
+    if (re->num_nodes == re->nodes_cap) {
+        re->nodes_cap = re->nodes_cap ? 2 * re->nodes_cap : 64;
+        re->ast = (AstNode*)realloc(re->ast, re->nodes_cap * sizeof(AstNode));
+    }
+    AstNode *n = &re->ast[re->num_nodes];
+    n->kind = kind;
+    n->left = left;
+    n->right = right;
+    n->min = n->max = 0;
+    n->set = -1;
+    return re->num_nodes++;
+}
+
+static int set_node(Regex *re, const ByteSet *s) {
+    int id = 0;
+    while (id < re->num_sets && memcmp(&re->sets[id], s, sizeof(ByteSet)) != 0) id++;
+    if (id == re->num_sets) {
+        if (re->num_sets == re->sets_cap) {
+            re->sets_cap = re->sets_cap ? 2 * re->sets_cap : 16;
+            re->sets = (ByteSet*)realloc(re->sets, re->sets_cap * sizeof(ByteSet));
+        }
+        re->sets[re->num_sets++] = *s;
+    }
+    int n = new_node(re, A_SET, -1, -1);
+    re->ast[n].set = id;
+    return n;
+}
+
+static void add_range(ByteSet *s, int lo, int hi) {
+    for (int b = lo; b <= hi; b++) set_add(s, b);
+}
+
+// \d \w \s and their negations; returns 0 if c is not a class escape
+static int class_escape(ByteSet *s, int c) {
+    ByteSet t = {{0, 0, 0, 0}};
+    switch (c | 0x20) {
+        case 'd': add_range(&t, '0', '9'); break;
+        case 'w':
+            add_range(&t, '0', '9');
+            add_range(&t, 'a', 'z');
+            add_range(&t, 'A', 'Z');
+            set_add(&t, '_');
+            break;
+        case 's':
+            set_add(&t, ' ');
+            add_range(&t, '\t', '\r');
+            break;
+        default: return 0;
+    }
+    int negate = c >= 'A' && c <= 'Z';
+    for (int k = 0; k < 4; k++) s->bits[k] |= negate ? ~t.bits[k] : t.bits[k];
+    return 1;
+}
+
+static int escape_byte(int c) {
+    switch (c) {
+        case 'n': return '\n';
+        case 't': return '\t';
+        case 'r': return '\r';
+        default: return c;
+    }
+}
+
+static int parse_alt(Regex *re);
+
+static int parse_class(Regex *re) {
+    ByteSet s = {{0, 0, 0, 0}};
+    int negate = re->pos < re->len && re->pat[re->pos] == '^';
+    if (negate) re->pos++;
+    int first = 1;
+    while (re->pos < re->len && (re->pat[re->pos] != ']' || first)) {
+        first = 0;
+        int lo = (uint8_t)re->pat[re->pos++];
+        if (lo == '\\' && re->pos < re->len) {
+            int c = (uint8_t)re->pat[re->pos++];
+            if (class_escape(&s, c)) continue;
+            lo = escape_byte(c);
+        }
+        int hi = lo;
+        if (re->pos + 1 < re->len && re->pat[re->pos] == '-' && re->pat[re->pos + 1] != ']') {
+            re->pos++;
+            hi = (uint8_t)re->pat[re->pos++];
+            if (hi == '\\' && re->pos < re->len) hi = escape_byte((uint8_t)re->pat[re->pos++]);
+            if (hi < lo) {
+                re->error = "bad class range";
+                return -1;
+            }
+        }
+        add_range(&s, lo, hi);
+    }
+    if (re->pos >= re->len) {
+        re->error = "missing ]";
+        return -1;
+    }
+    re->pos++;
+    if (negate) {
+        for (int k = 0; k < 4; k++) s.bits[k] = ~s.bits[k];
+    }
+    return set_node(re, &s);
+}
+
+static int parse_atom(Regex *re) {
+    int c = (uint8_t)re->pat[re->pos++];
+    ByteSet s = {{0, 0, 0, 0}};
+    switch (c) {
+        case '(': {
+            int n = parse_alt(re);
+            if (n < 0) return -1;
+            if (re->pos >= re->len || re->pat[re->pos] != ')') {
+                re->error = "missing )";
+                return -1;
+            }
+            re->pos++;
+            return n;
+        }
+        case '[': return parse_class(re);
+        case '.':
+            for (int k = 0; k < 4; k++) s.bits[k] = ~0ULL;
+            return set_node(re, &s);
+        case '*': case '+': case '?': case '{':
+            re->error = "nothing to repeat";
+            return -1;
+        case '^': case '$':
+            re->error = "anchor only allowed at the ends";
+            return -1;
+        case '\\':
+            if (re->pos >= re->len) {
+                re->error = "trailing backslash";
+                return -1;
+            }
+            c = (uint8_t)re->pat[re->pos++];
+            if (class_escape(&s, c)) return set_node(re, &s);
+            c = escape_byte(c);
+            break;
+        default: break;
+    }
+    set_add(&s, c);
+    return set_node(re, &s);
+}
+
+static int parse_count(Regex *re) {
+    int v = -1;
+    while (re->pos < re->len && re->pat[re->pos] >= '0' && re->pat[re->pos] <= '9') {
+        v = (v < 0 ? 0 : v * 10) + (re->pat[re->pos++] - '0');
+        if (v > MAX_REPEAT) return MAX_REPEAT + 1;
+    }
+    return v;
+}
+
+static int parse_repeat(Regex *re) {
+    int n = parse_atom(re);
+    while (n >= 0 && re->pos < re->len) {
+        char c = re->pat[re->pos];
+        if (c == '*') n = new_node(re, A_STAR, n, -1);
+        else if (c == '+') n = new_node(re, A_PLUS, n, -1);
+        else if (c == '?') n = new_node(re, A_QUEST, n, -1);
+        else if (c == '{') {
+            re->pos++;
+            int lo = parse_count(re), hi = lo;
+            if (re->pos < re->len && re->pat[re->pos] == ',') {
+                re->pos++;
+                hi = parse_count(re);
+            }
+            if (lo < 0 || lo > MAX_REPEAT || hi > MAX_REPEAT || (hi >= 0 && hi < lo) ||
+                re->pos >= re->len || re->pat[re->pos] != '}') {
+                re->error = "bad {m,n}";
+                return -1;
+            }
+            n = new_node(re, A_REPEAT, n, -1);
+            re->ast[n].min = lo;
+            re->ast[n].max = hi;
+        } else {
+            break;
+        }
+        re->pos++;
+    }
+    return n;
+}
+
+static int parse_cat(Regex *re) {
+    int n = -1;
+    while (re->pos < re->len && re->pat[re->pos] != '|' && re->pat[re->pos] != ')') {
+        int r = parse_repeat(re);
+        if (r < 0) return -1;
+        n = n < 0 ? r : new_node(re, A_CAT, n, r);
+    }
+    return n < 0 ? new_node(re, A_EMPTY, -1, -1) : n;
+}
+
+static int parse_alt(Regex *re) {
+    int n = parse_cat(re);
+    while (n >= 0 && re->pos < re->len && re->pat[re->pos] == '|') {
+        re->pos++;
+        int r = parse_cat(re);
+        if (r < 0) return -1;
+        n = new_node(re, A_ALT, n, r);
+    }
+    return n;
+}
+
+// ---------------------------------------------------------------------------
+// NFA construction, byte classes and the literal prefix
+// ---------------------------------------------------------------------------
+
+static int new_state(Regex *re, int kind, int set, int out, int out1) {
+    if (re->num_nfa >= MAX_NFA_STATES) {
+        re->error = "pattern too large";
+        return -1;
+    }
+    if (re->num_nfa == re->nfa_cap) {
+        re->nfa_cap = re->nfa_cap ? 2 * re->nfa_cap : 64;
+        re->nfa = (NfaState*)realloc(re->nfa, re->nfa_cap * sizeof(NfaState));
+    }
+    NfaState *s = &re->nfa[re->num_nfa];
+    s->kind = kind;
+    s->set = set;
+    s->out = out;
+    s->out1 = out1;
+    return re->num_nfa++;
+}
+
+// Returns the entry state of node n followed by state next, or -1
+static int compile_node(Regex *re, int n, int next) {
+    if (next < 0) return -1;
+    const AstNode a = re->ast[n];
+    switch (a.kind) {
+        case A_SET: return new_state(re, N_BYTE, a.set, next, -1);
+        case A_CAT: return compile_node(re, a.left, compile_node(re, a.right, next));
+        case A_ALT: {
+            int l = compile_node(re, a.left, next), r = compile_node(re, a.right, next);
+            return l < 0 || r < 0 ? -1 : new_state(re, N_SPLIT, -1, l, r);
+        }
+        case A_STAR:
+        case A_PLUS: {
+            int loop = new_state(re, N_SPLIT, -1, -1, next);
+            int body = compile_node(re, a.left, loop);
+            if (body < 0) return -1;
+            re->nfa[loop].out = body;
+            return a.kind == A_STAR ? loop : body;
+        }
+        case A_QUEST: {
+            int body = compile_node(re, a.left, next);
+            return body < 0 ? -1 : new_state(re, N_SPLIT, -1, body, next);
+        }
+        case A_REPEAT: {
+            int t = next;
+            if (a.max < 0) {
+                // x{m,} is m copies of x followed by x*
+                int loop = new_state(re, N_SPLIT, -1, -1, next);
+                int body = compile_node(re, a.left, loop);
+                if (body < 0) return -1;
+                re->nfa[loop].out = body;
+                t = loop;
+            } else {
+                // x{m,n}: optional copies nest so that each one skips straight to next
+                for (int k = 0; k < a.max - a.min && t >= 0; k++) {
+                    int body = compile_node(re, a.left, t);
+                    t = body < 0 ? -1 : new_state(re, N_SPLIT, -1, body, next);
+                }
+            }
+            for (int k = 0; k < a.min && t >= 0; k++) t = compile_node(re, a.left, t);
+            return t;
+        }
+        default: return next;
+    }
+}
+
+// Partition the bytes so that two bytes share a class iff every set treats them alike
+static void build_classes(Regex *re) {
+    memset(re->cls, 0, sizeof(re->cls));
+    int num = 1;
+    for (int s = 0; s < re->num_sets; s++) {
+        int remap[256][2];
+        for (int c = 0; c < num; c++) remap[c][0] = remap[c][1] = -1;
+        int next = 0;
+        for (int b = 0; b < 256; b++) {
+            int in = set_has(&re->sets[s], b);
+            int *slot = &remap[re->cls[b]][in];
+            if (*slot < 0) *slot = next++;
+            re->cls[b] = (uint8_t)*slot;
+        }
+        num = next;
+    }
+    for (int b = 255; b >= 0; b--) re->class_rep[re->cls[b]] = (uint8_t)b;
+    re->num_classes = num;
+}
+
+// Appends the literal prefix of node n; returns 1 if the whole node was literal
+static int literal_prefix(Regex *re, int n) {
+    const AstNode *a = &re->ast[n];
+    if (a->kind == A_SET) {
+        const ByteSet *s = &re->sets[a->set];
+        if (set_count(s) != 1 || re->prefix_len == MAX_PREFIX) return 0;
+        for (int b = 0; b < 256; b++) {
+            if (set_has(s, b)) re->prefix[re->prefix_len++] = (uint8_t)b;
+        }
+        return 1;
+    }
+    if (a->kind == A_CAT) return literal_prefix(re, a->left) && literal_prefix(re, a->right);
+    return a->kind == A_EMPTY;
+}
+
+static void dfa_init(LazyDfa *d, int cap, int num_classes) {
+    d->cap = cap;
+    d->trans = (int*)malloc((size_t)cap * num_classes * sizeof(int));
+    d->set_off = (int*)malloc(cap * sizeof(int));
+    d->set_len = (int*)malloc(cap * sizeof(int));
+    d->flags = (uint8_t*)malloc(cap);
+    d->pool_cap = cap * 16;
+    d->pool = (int*)malloc(d->pool_cap * sizeof(int));
+    int size = 1;
+    while (size < 2 * cap) size <<= 1;
+    d->table = (int*)malloc(size * sizeof(int));
+    d->table_mask = size - 1;
+    d->num = 0;
+    d->pool_len = 0;
+    for (int i = 0; i < size; i++) d->table[i] = -1;
+    d->start[0] = d->start[1] = DFA_UNKNOWN;
+    d->bytes_since_flush = 0;
+    d->flushes = 0;
+    d->gave_up = 0;
+}
+
+// Returns 0, or -1 with re->error set
+int regex_compile(Regex *re, const char *pattern, int cache_states) {
+    memset(re, 0, sizeof(*re));
+    re->pat = pattern;
+    re->len = (int)strlen(pattern);
+    if (re->len > 0 && pattern[0] == '^') {
+        re->bol = 1;
+        re->pos = 1;
+    }
+    if (re->len > re->pos && pattern[re->len - 1] == '$' &&
+        (re->len < 2 || pattern[re->len - 2] != '\\')) {
+        re->eol = 1;
+        re->len--;
+    }
+    int root = parse_alt(re);
+    if (root >= 0 && re->pos < re->len) {
+        re->error = "unmatched )";
+        root = -1;
+    }
+    if (root < 0) return -1;
+
+    int match = new_state(re, N_MATCH, -1, -1, -1);
+    int tail = re->eol ? new_state(re, N_EOL, -1, match, -1) : match;
+    re->start[START_ANCHORED] = compile_node(re, root, tail);
+    if (re->start[START_ANCHORED] < 0) return -1;
+    // unanchored: loop on any byte before trying the pattern again
+    ByteSet any = {{~0ULL, ~0ULL, ~0ULL, ~0ULL}};
+    set_node(re, &any);
+    int loop = new_state(re, N_SPLIT, -1, re->start[START_ANCHORED], -1);
+    int skip = new_state(re, N_BYTE, re->ast[re->num_nodes - 1].set, loop, -1);
+    if (loop < 0 || skip < 0) return -1;
+    re->nfa[loop].out1 = skip;
+    re->start[START_UNANCHORED] = loop;
+
+    build_classes(re);
+    literal_prefix(re, root);
+    re->mark = (int*)calloc(re->num_nfa, sizeof(int));
+    re->stack = (int*)malloc(re->num_nfa * sizeof(int));
+    re->list_a = (int*)malloc(re->num_nfa * sizeof(int));
+    re->list_b = (int*)malloc(re->num_nfa * sizeof(int));
+    dfa_init(&re->dfa, cache_states, re->num_classes);
+    return 0;
+}
+
+void regex_free(Regex *re) {
+    LazyDfa *d = &re->dfa;
+    free(d->trans);
+    free(d->set_off);
+    free(d->set_len);
+    free(d->flags);
+    free(d->pool);
+    free(d->table);
+    free(re->ast);
+    free(re->sets);
+    free(re->nfa);
+    free(re->mark);
+    free(re->stack);
+    free(re->list_a);
+    free(re->list_b);
+}
+
+// ---------------------------------------------------------------------------
+// Epsilon closure and the NFA simulation
+// ---------------------------------------------------------------------------
+
+static int cmp_int(const void *a, const void *b) {
+    return *(const int *)a - *(const int *)b;
+}
+
+// Closure of seeds into out, keeping only byte/EOL/match states; sorted if asked
+static int closure(Regex *re, const int *seeds, int num_seeds, int *out, int sorted) {
+    if (++re->mark_gen == 0x7FFFFFFF) {
+        memset(re->mark, 0, re->num_nfa * sizeof(int));
+        re->mark_gen = 1;
+    }
+    int gen = re->mark_gen, top = 0, n = 0;
+    for (int i = num_seeds - 1; i >= 0; i--) re->stack[top++] = seeds[i];
+    while (top > 0) {
+        int s = re->stack[--top];
+        if (re->mark[s] == gen) continue;
+        re->mark[s] = gen;
+        const NfaState *st = &re->nfa[s];
+        if (st->kind == N_SPLIT) {
+            if (re->mark[st->out1] != gen) re->stack[top++] = st->out1;
+            if (re->mark[st->out] != gen) re->stack[top++] = st->out;
+        } else {
+            out[n++] = s;
+        }
+    }
+    if (sorted) qsort(out, n, sizeof(int), cmp_int);
+    return n;
+}
+
+// States reached from list by byte b, before closure
+static int step_states(const Regex *re, const int *list, int n, int b, int *out) {
+    int m = 0;
+    for (int i = 0; i < n; i++) {
+        const NfaState *st = &re->nfa[list[i]];
+        if (st->kind == N_BYTE && set_has(&re->sets[st->set], b)) out[m++] = st->out;
+    }
+    return m;
+}
+
+static int list_has_kind(const Regex *re, const int *list, int n, int kind) {
+    for (int i = 0; i < n; i++) {
+        if (re->nfa[list[i]].kind == kind) return 1;
+    }
+    return 0;
+}
+
+// 1 if the pattern matches inside p[0, n), starting at p[0] when anchored
+int nfa_line(Regex *re, int start_kind, const uint8_t *p, size_t n) {
+    int *cur = re->list_a, *nxt = re->list_b;
+    int count = closure(re, &re->start[start_kind], 1, cur, 0);
+    for (size_t i = 0; i < n; i++) {
+        if (list_has_kind(re, cur, count, N_MATCH)) return 1;
+        int m = step_states(re, cur, count, p[i], nxt);
+        count = closure(re, nxt, m, cur, 0);
+        if (count == 0) return 0;
+    }
+    return list_has_kind(re, cur, count, N_MATCH) || list_has_kind(re, cur, count, N_EOL);
+}
+
+// ---------------------------------------------------------------------------
+// Lazy DFA construction and scan
+// ---------------------------------------------------------------------------
+
+static uint32_t hash_set(const int *s, int n) {
+    uint32_t h = 2166136261u;
+    for (int i = 0; i < n; i++) h = (h ^ (uint32_t)s[i]) * 16777619u;
+    return h;
+}
+
+static void dfa_flush(LazyDfa *d) {
+    if (d->bytes_since_flush < (long)DFA_MIN_BYTES_PER_STATE * d->cap) d->gave_up = 1;
+    d->bytes_since_flush = 0;
+    d->flushes++;
+    d->num = 0;
+    d->pool_len = 0;
+    for (int i = 0; i <= d->table_mask; i++) d->table[i] = -1;
+    d->start[0] = d->start[1] = DFA_UNKNOWN;
+}
+
+// Tagged state for the NFA set, or DFA_UNKNOWN if the cache is full
+static int dfa_lookup(Regex *re, const int *set, int n) {
+    LazyDfa *d = &re->dfa;
+    int nc = re->num_classes;
+    uint32_t slot = hash_set(set, n) & d->table_mask;
+    for (; d->table[slot] >= 0; slot = (slot + 1) & d->table_mask) {
+        int id = d->table[slot];
+        if (d->set_len[id] == n && memcmp(d->pool + d->set_off[id], set, n * sizeof(int)) == 0) {
+            return id * nc << 2 | (d->flags[id] & (DFA_MATCH | DFA_DEAD));
+        }
+    }
+    if (d->num == d->cap || d->pool_len + n > d->pool_cap) return DFA_UNKNOWN;
+    int id = d->num++;
+    d->table[slot] = id;
+    d->set_off[id] = d->pool_len;
+    d->set_len[id] = n;
+    memcpy(d->pool + d->pool_len, set, n * sizeof(int));
+    d->pool_len += n;
+    uint8_t f = n == 0 ? DFA_DEAD : 0;
+    if (list_has_kind(re, set, n, N_MATCH)) f |= DFA_MATCH;
+    if (list_has_kind(re, set, n, N_EOL)) f |= DFA_EOL;
+    d->flags[id] = f;
+    for (int c = 0; c < nc; c++) d->trans[id * nc + c] = DFA_UNKNOWN;
+    return id * nc << 2 | (f & (DFA_MATCH | DFA_DEAD));
+}
+
+// Adds a set, flushing once if the cache is full
+static int dfa_insert(Regex *re, const int *set, int n) {
+    int t = dfa_lookup(re, set, n);
+    if (t != DFA_UNKNOWN) return t;
+    dfa_flush(&re->dfa);
+    if (!re->dfa.gave_up) t = dfa_lookup(re, set, n);
+    // a single set larger than the whole pool cannot be cached at all
+    if (t == DFA_UNKNOWN) re->dfa.gave_up = 1;
+    return re->dfa.gave_up ? DFA_GAVE_UP : t;
+}
+
+static int dfa_start(Regex *re, int kind) {
+    LazyDfa *d = &re->dfa;
+    if (d->start[kind] == DFA_UNKNOWN) {
+        int n = closure(re, &re->start[kind], 1, re->list_a, 1);
+        int t = dfa_insert(re, re->list_a, n);
+        if (t == DFA_GAVE_UP) return t;
+        d->start[kind] = t;
+    }
+    return d->start[kind];
+}
+
+static int dfa_step(Regex *re, int tagged, int c) {
+    LazyDfa *d = &re->dfa;
+    int id = (tagged >> 2) / re->num_classes;
+    int m = step_states(re, d->pool + d->set_off[id], d->set_len[id], re->class_rep[c], re->list_b);
+    int n = closure(re, re->list_b, m, re->list_a, 1);
+    int flushes = d->flushes;
+    int t = dfa_insert(re, re->list_a, n);
+    // after a flush the source row no longer exists
+    if (t >= 0 && d->flushes == flushes) d->trans[(tagged >> 2) + c] = t;
+    return t;
+}
+
+// Same contract as nfa_line, or DFA_GAVE_UP when the cache thrashes
+int dfa_line(Regex *re, int start_kind, const uint8_t *p, size_t n) {
+    LazyDfa *d = &re->dfa;
+    int t = dfa_start(re, start_kind);
+    if (t < 0) return t;
+    if (t & DFA_MATCH) return 1;
+    const int *trans = d->trans;
+    for (size_t i = 0; i < n; i++) {
+        int c = re->cls[p[i]];
+        int next = trans[(t >> 2) + c];
+        if (next < 0) {
+            next = dfa_step(re, t, c);
+            if (next < 0) return next;
+        }
+        t = next;
+        if (t & (DFA_MATCH | DFA_DEAD)) {
+            d->bytes_since_flush += (long)i + 1;
+            return t & DFA_MATCH;
+        }
+    }
+    d->bytes_since_flush += (long)n;
+    return (d->flags[(t >> 2) / re->num_classes] & DFA_EOL) != 0;
+}
+
+// ---------------------------------------------------------------------------
+// Counting matching lines. MODE_DFA falls back to the NFA for the rest of
+// the buffer once the DFA gives up; MODE_AUTO also jumps between
+// occurrences of the literal prefix and runs the anchored automaton there.
+// ---------------------------------------------------------------------------
+
+enum { MODE_NFA, MODE_DFA, MODE_AUTO, NUM_MODES };
+
+typedef struct {
+    size_t lines;
+    int fell_back;
+} CountResult;
+
+static const uint8_t *find_prefix(const Regex *re, const uint8_t *p, const uint8_t *end) {
+    int k = re->prefix_len;
+    while (end - p >= k) {
+        p = memchr(p, re->prefix[0], end - p - k + 1);
+        if (p == NULL) return NULL;
+        if (memcmp(p + 1, re->prefix + 1, k - 1) == 0) return p;
+        p++;
+    }
+    return NULL;
+}
+
+static int run_line(Regex *re, int *use_nfa, int start_kind, const uint8_t *p, size_t n) {
+    if (!*use_nfa) {
+        int r = dfa_line(re, start_kind, p, n);
+        if (r != DFA_GAVE_UP) return r;
+        *use_nfa = 1;
+    }
+    return nfa_line(re, start_kind, p, n);
+}
+
+CountResult regex_count_lines(Regex *re, const uint8_t *buf, size_t n, int mode) {
+    CountResult res = {0, 0};
+    int use_nfa = mode == MODE_NFA;
+    re->dfa.gave_up = 0;
+    re->dfa.bytes_since_flush = 0;
+    const uint8_t *p = buf, *end = buf + n;
+    if (mode == MODE_AUTO && re->prefix_len > 0 && !re->bol) {
+        while (p < end) {
+            const uint8_t *hit = find_prefix(re, p, end);
+            if (hit == NULL) break;
+            const uint8_t *eol = memchr(hit, '\n', end - hit);
+            if (eol == NULL) eol = end;
+            if (run_line(re, &use_nfa, START_ANCHORED, hit, eol - hit)) {
+                res.lines++;
+                p = eol + 1;
+            } else {
+                p = hit + 1;
+            }
+        }
+    } else {
+        int kind = re->bol ? START_ANCHORED : START_UNANCHORED;
+        while (p < end) {
+            const uint8_t *eol = memchr(p, '\n', end - p);
+            if (eol == NULL) eol = end;
+            res.lines += run_line(re, &use_nfa, kind, p, eol - p);
+            p = eol + 1;
+        }
+    }
+    res.fell_back = use_nfa && mode != MODE_NFA;
+    return res;
+}
+
+// ---------------------------------------------------------------------------
+// Reference implementation (180): the list-based NFA simulation. Its
+// compile_simple_regex keeps only the last concatenation run and its
+// compile_star/compile_concat overwrite the loop edge, so the State graphs
+// for it are translated from the NFA above instead.
+// ---------------------------------------------------------------------------
+
+#define MAX_STATES 1000
+
+typedef struct State {
+    int is_end;
+    char c;
+    struct State *out1;
+    struct State *out2;
+} State;
+
+State* create_state(char c, State *out1, State *out2) {
+    State *s = (State*)malloc(sizeof(State));
+    s->is_end = 0;
+    s->c = c;
+    s->out1 = out1;
+    s->out2 = out2;
+    return s;
+}
+
+void add_state(State **list, int *count, State *s) {
+    if (s == NULL || *count >= MAX_STATES) return;
+
+    for (int i = 0; i < *count; i++) {
+        if (list[i] == s) return;
+    }
+
+    list[(*count)++] = s;
+
+    if (s->c == 0) {
+        add_state(list, count, s->out1);
+        add_state(list, count, s->out2);
+    }
+}
+
+int match(State *start, const char *text) {
+    State *current_buf[MAX_STATES];
+    State *next_buf[MAX_STATES];
+    State **current_states = current_buf;   // 180 swapped the arrays themselves
+    State **next_states = next_buf;
+    int current_count = 0;
+    int next_count = 0;
+
+    add_state(current_states, &current_count, start);
+
+    for (int i = 0; text[i]; i++) {
+        next_count = 0;
+
+        for (int j = 0; j < current_count; j++) {
+            State *s = current_states[j];
+            if (s->c == text[i] || s->c == '.') {
+                add_state(next_states, &next_count, s->out1);
+            }
+        }
+
+        State **temp = current_states;
+        current_states = next_states;
+        next_states = temp;
+        current_count = next_count;
+    }
+
+    for (int i = 0; i < current_count; i++) {
+        if (current_states[i]->is_end) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+typedef struct {
+    State **all;
+    int num, cap;
+    State *start;
+} StateGraph;
+
+static State *graph_state(StateGraph *g, char c) {
+    if (g->num == g->cap) {
+        g->cap = g->cap ? 2 * g->cap : 256;
+        g->all = (State**)realloc(g->all, g->cap * sizeof(State *));
+    }
+    return g->all[g->num++] = create_state(c, NULL, NULL);
+}
+
+// 180's matcher is a whole-string match, so an unanchored pattern is wrapped
+// as .*R.* and '$' becomes plain acceptance. Byte 0 and a literal '.' have no
+// encoding there; returns -1 for those patterns.
+int build_state_graph(const Regex *re, StateGraph *g) {
+    g->all = NULL;
+    g->num = g->cap = 0;
+    State **entry = (State**)malloc(re->num_nfa * sizeof(State *));
+    int ok = 1;
+    for (int s = 0; s < re->num_nfa && ok; s++) {
+        const NfaState *st = &re->nfa[s];
+        int count = st->kind == N_BYTE ? set_count(&re->sets[st->set]) : 0;
+        if (count == 1) {
+            int b = 0;
+            while (!set_has(&re->sets[st->set], b)) b++;
+            ok = b != 0 && b != '.';
+            entry[s] = graph_state(g, (char)b);
+        } else {
+            entry[s] = graph_state(g, count == 256 ? '.' : 0);
+        }
+    }
+    for (int s = 0; s < re->num_nfa && ok; s++) {
+        const NfaState *st = &re->nfa[s];
+        State *e = entry[s];
+        if (st->kind == N_SPLIT) {
+            e->out1 = entry[st->out];
+            e->out2 = entry[st->out1];
+        } else if (st->kind == N_EOL) {
+            e->out1 = entry[st->out];
+        } else if (st->kind == N_MATCH) {
+            // trailing .* unless '$' pinned the end
+            if (!re->eol) {
+                State *any = graph_state(g, '.');
+                State *loop = graph_state(g, 0);
+                any->out1 = loop;
+                loop->out1 = any;
+                e->out1 = loop;
+                loop->is_end = 1;
+            }
+            e->is_end = 1;
+        } else if (e->c != 0) {
+            e->out1 = entry[st->out];
+        } else {
+            // a multi-byte set becomes a chain of forks into one state per byte
+            const ByteSet *set = &re->sets[st->set];
+            State *fork = e;
+            for (int b = 1; b < 256; b++) {
+                if (!set_has(set, b)) continue;
+                if (b == '.') ok = 0;
+                State *c = graph_state(g, (char)b);
+                c->out1 = entry[st->out];
+                State *next = graph_state(g, 0);
+                fork->out1 = c;
+                fork->out2 = next;
+                fork = next;
+            }
+            if (set_has(set, 0)) ok = 0;
+        }
+    }
+    g->start = entry[re->start[re->bol ? START_ANCHORED : START_UNANCHORED]];
+    free(entry);
+    return ok ? 0 : -1;
+}
+
+void free_state_graph(StateGraph *g) {
+    for (int i = 0; i < g->num; i++) free(g->all[i]);
+    free(g->all);
+}
+
+size_t count_lines_180(State *start, const uint8_t *buf, size_t n) {
+    char *line = (char*)malloc(n + 1);
+    size_t lines = 0;
+    const uint8_t *p = buf, *end = buf + n;
+    while (p < end) {
+        const uint8_t *eol = memchr(p, '\n', end - p);
+        if (eol == NULL) eol = end;
+        memcpy(line, p, eol - p);
+        line[eol - p] = '\0';
+        lines += match(start, line);
+        p = eol + 1;
+    }
+    free(line);
+    return lines;
+}
+
+// ---------------------------------------------------------------------------
+// Inputs
+// ---------------------------------------------------------------------------
+
+static unsigned int next_rand(unsigned int *seed) {
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 8;
+}
+
+// Application-log lines: timestamp, level, worker, request, id, status, latency
+size_t generate_log(uint8_t *buf, size_t size, unsigned int seed) {
+    static const char *methods[] = {"GET", "GET", "GET", "POST", "PUT", "DELETE"};
+    static const char *resources[] = {"users", "orders", "items", "carts", "sessions"};
+    static const int statuses[] = {200, 200, 200, 200, 201, 204, 304, 400, 404, 404, 500, 503};
+    size_t pos = 0;
+    char line[256];
+    while (1) {
+        unsigned int r = next_rand(&seed);
+        int lvl = r % 100;
+        const char *level = lvl < 80 ? "INFO" : lvl < 90 ? "DEBUG" : lvl < 97 ? "WARN" : "ERROR";
+        int latency = 1 + next_rand(&seed) % (next_rand(&seed) % 8 == 0 ? 5000 : 200);
+        int len = snprintf(line, sizeof(line),
+                           "2024-03-%02u %02u:%02u:%02u %-5s [worker-%u] %s /api/v%u/%s/%u id=%08x%08x status=%d latency=%dms\n",
+                           1 + next_rand(&seed) % 28, next_rand(&seed) % 24, next_rand(&seed) % 60, next_rand(&seed) % 60,
+                           level, next_rand(&seed) % 32, methods[next_rand(&seed) % 6], 1 + next_rand(&seed) % 2,
+                           resources[next_rand(&seed) % 5], next_rand(&seed) % 10000, next_rand(&seed), next_rand(&seed),
+                           statuses[next_rand(&seed) % 12], latency);
+        if (pos + len > size) break;
+        memcpy(buf + pos, line, len);
+        pos += len;
+    }
+    return pos;
+}
+
+// Random pattern over {a, b, c} using only what 180 can express plus
+// classes, '+', '?' and {m,n}
+static void random_regex(char *out, int *len, int depth, unsigned int *seed) {
+    int r = next_rand(seed) % (depth > 3 ? 3 : 10);
+    switch (r) {
+        case 0: case 1: out[(*len)++] = "abc"[next_rand(seed) % 3]; break;
+        case 2: out[(*len)++] = '.'; break;
+        case 3: case 4:
+            random_regex(out, len, depth + 1, seed);
+            random_regex(out, len, depth + 1, seed);
+            break;
+        case 5:
+            out[(*len)++] = '(';
+            random_regex(out, len, depth + 1, seed);
+            out[(*len)++] = '|';
+            random_regex(out, len, depth + 1, seed);
+            out[(*len)++] = ')';
+            break;
+        case 6: memcpy(out + *len, "[ab]", 4); *len += 4; break;
+        default: {
+            out[(*len)++] = '(';
+            random_regex(out, len, depth + 1, seed);
+            out[(*len)++] = ')';
+            static const char *quant[] = {"*", "+", "?", "{2}", "{0,2}", "{1,}"};
+            const char *q = quant[next_rand(seed) % 6];
+            memcpy(out + *len, q, strlen(q));
+            *len += (int)strlen(q);
+            break;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Correctness: random patterns on random lines, every engine and 180 must
+// agree; a 4-state cache forces flushes and the NFA fallback
+// ---------------------------------------------------------------------------
+
+int fuzz_engines(void) {
+    int failures = 0;
+    unsigned int seed = 180;
+    char pattern[512];
+    uint8_t buf[1024];
+    for (int t = 0; t < FUZZ_TRIALS; t++) {
+        int len = 0;
+        if (next_rand(&seed) % 4 == 0) pattern[len++] = '^';
+        random_regex(pattern, &len, 0, &seed);
+        if (next_rand(&seed) % 4 == 0) pattern[len++] = '$';
+        pattern[len] = '\0';
+        size_t n = 0;
+        int num_lines = 1 + next_rand(&seed) % 12;
+        for (int l = 0; l < num_lines; l++) {
+            int line_len = next_rand(&seed) % 14;
+            for (int i = 0; i < line_len; i++) buf[n++] = (uint8_t)"abcx"[next_rand(&seed) % 4];
+            buf[n++] = '\n';
+        }
+        Regex big, tiny;
+        if (regex_compile(&big, pattern, DFA_CACHE_STATES) < 0 || regex_compile(&tiny, pattern, 4) < 0) {
+            failures++;
+            continue;
+        }
+        StateGraph g;
+        long want = -1;
+        if (build_state_graph(&big, &g) == 0) want = (long)count_lines_180(g.start, buf, n);
+        free_state_graph(&g);
+        CountResult nfa = regex_count_lines(&big, buf, n, MODE_NFA);
+        if (want >= 0 && (long)nfa.lines != want) failures++;
+        for (int mode = MODE_DFA; mode < NUM_MODES; mode++) {
+            if (regex_count_lines(&big, buf, n, mode).lines != nfa.lines) failures++;
+            if (regex_count_lines(&tiny, buf, n, mode).lines != nfa.lines) failures++;
+        }
+        regex_free(&big);
+        regex_free(&tiny);
+    }
+    // malformed patterns must be rejected, not crash
+    const char *bad[] = {"(ab", "ab)", "[a-", "*a", "a{3,1}", "a{999}", "a^b", "\\", "[z-a]", "((((x)){255}){255}){255}"};
+    for (int i = 0; i < 10; i++) {
+        Regex re;
+        if (regex_compile(&re, bad[i], 16) == 0) failures++;
+        regex_free(&re);
+    }
+    return failures;
+}
+
+// ---------------------------------------------------------------------------
+// Throughput on the log corpus
+// ---------------------------------------------------------------------------
+
+#define NUM_PATTERNS 7
+
+static const char *log_patterns[NUM_PATTERNS] = {
+    "ERROR",
+    "status=5[0-9][0-9]",
+    "worker-(1|2)[0-9]\\] (GET|POST)",
+    "(GET|PUT) /api/v[12]/(users|orders)/[0-9]+ id=[0-9a-f]+ status=404",
+    "^2024-03-1[0-9] 1[0-2]:[0-9]+:[0-9]+ WARN",
+    "latency=[0-9]{4}ms$",
+    "[ -~]*[0-9][ -~]{14}$",    // ~2^15 DFA states: thrashes the cache
+};
+
+static double mb_per_s(size_t bytes, clock_t start) {
+    double t = (double)(clock() - start) / CLOCKS_PER_SEC;
+    return t > 0 ? bytes / t / 1e6 : 0.0;
+}
+
+int main() {
+    clock_t start = clock();
+    int failures = fuzz_engines();
+
+    size_t cap = LOG_SIZE;
+    uint8_t *log = (uint8_t*)malloc(cap);
+    size_t n = generate_log(log, cap, 42);
+    size_t slice = REF_SLICE;
+    while (slice < n && log[slice - 1] != '\n') slice++;
+
+    printf("%-66s %9s %9s %9s %9s %9s %8s\n", "MB/s", "180", "nfa", "dfa", "auto", "lines", "flushes");
+    for (int k = 0; k < NUM_PATTERNS; k++) {
+        Regex re;
+        if (regex_compile(&re, log_patterns[k], DFA_CACHE_STATES) < 0) {
+            printf("%-66s compile error: %s\n", log_patterns[k], re.error);
+            failures++;
+            regex_free(&re);
+            continue;
+        }
+        printf("%-66s", log_patterns[k]);
+        StateGraph g;
+        if (build_state_graph(&re, &g) == 0) {
+            clock_t t0 = clock();
+            size_t ref = count_lines_180(g.start, log, slice);
+            printf(" %9.2f", mb_per_s(slice, t0));
+            if (ref != regex_count_lines(&re, log, slice, MODE_NFA).lines) failures++;
+        } else {
+            printf(" %9s", "-");
+        }
+        free_state_graph(&g);
+
+        CountResult res[NUM_MODES];
+        int flushes = 0;
+        for (int mode = 0; mode < NUM_MODES; mode++) {
+            int before = re.dfa.flushes;
+            clock_t t0 = clock();
+            res[mode] = regex_count_lines(&re, log, n, mode);
+            printf(" %8.1f%s", mb_per_s(n, t0), res[mode].fell_back ? "*" : " ");
+            flushes += re.dfa.flushes - before;
+            if (res[mode].lines != res[0].lines) failures++;
+        }
+        printf(" %9zu %8d\n", res[0].lines, flushes);
+        regex_free(&re);
+    }
+    printf("(* = DFA cache thrashed, finished on the NFA; 180 runs on the first %d KB)\n", (int)(slice >> 10));
+
+    clock_t end = clock();
+    printf("Regex lazy DFA: %d patterns, %zu KB log, %.6f seconds\n",
+           NUM_PATTERNS, n >> 10, (double)(end - start) / CLOCKS_PER_SEC);
+    printf("Failures: %d\n", failures);
+    free(log);
+    return 0;
+}
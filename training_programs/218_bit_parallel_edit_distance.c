@@ -0,0 +1,457 @@
+// Edit distance with Myers' bit-vector algorithm: multi-word blocks, a threshold-bounded band
+// with early exit, and a batched many-vs-one mode; compared with the DP versions from 122 and 58
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef FULL_SIZE
+#define MAX_LENGTH 10000      // longest benchmarked string
+#define NUM_LENGTHS 6
+#define PAIR_BYTES (1 << 19)  // pairs per length = max(MIN_PAIRS, PAIR_BYTES / length)
+#define DP_CELL_BUDGET (1 << 25) // DP engines run at most this many cells per length
+#define FUZZ_TRIALS 4000      // random pairs checked against the DP versions
+#else
+#define MAX_LENGTH 4000       // -DFULL_SIZE for lengths up to 10000 and 8x the pairs
+#define NUM_LENGTHS 5
+#define PAIR_BYTES (1 << 16)
+#define DP_CELL_BUDGET (1 << 22)
+#define FUZZ_TRIALS 500
+#endif
+#define MIN_PAIRS 8
+#define DP_TABLE_MAX 2000     // 122 allocates the full table; skipped above this length
+#define EDIT_RATE 20          // second string of a pair: about one edit per EDIT_RATE bytes
+
+// ---------------------------------------------------------------------------
+// Myers' algorithm keeps one DP column as vertical +1/-1 bit vectors over
+// the pattern and advances it one text byte at a time with a handful of
+// word operations. Long patterns are split into 64-row blocks; the
+// horizontal delta at the bottom of each block carries into the next.
+//
+// The pattern object owns its match-mask table peq[c * blocks + b] and is
+// meant to be reused: building a new pattern clears only the bits the
+// previous one set, so short patterns never pay for zeroing 256 words.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    int m, blocks;
+    uint64_t *peq;            // bit r of peq[c * blocks + b]: pattern[64b + r] == c
+    uint64_t last_mask;       // bit of row m - 1 inside the last block
+    uint8_t *text;            // copy of the pattern, used to clear peq on rebuild
+    int cap_m, cap_blocks;
+    uint64_t *pv, *mv;        // per-block column state
+    int *score;               // DP value at the bottom row of each block
+} MyersPattern;
+
+void myers_init(MyersPattern *p) {
+    memset(p, 0, sizeof(*p));
+}
+
+void myers_free(MyersPattern *p) {
+    free(p->peq);
+    free(p->text);
+    free(p->pv);
+    free(p->mv);
+    free(p->score);
+}
+
+void myers_build(MyersPattern *p, const char *s, int m) {
+    for (int i = 0; i < p->m; i++) p->peq[p->text[i] * p->blocks + (i >> 6)] = 0;
+    int blocks = (m + 63) >> 6;
+    if (blocks > p->cap_blocks) {
+        free(p->peq);
+        free(p->pv);
+        free(p->mv);
+        free(p->score);
+        p->cap_blocks = blocks;
+        p->peq = (uint64_t*)calloc((size_t)256 * blocks, sizeof(uint64_t));
+        p->pv = (uint64_t*)malloc(blocks * sizeof(uint64_t));
+        p->mv = (uint64_t*)malloc(blocks * sizeof(uint64_t));
+        p->score = (int*)malloc(blocks * sizeof(int));
+    }
+    if (m > p->cap_m) {
+        free(p->text);
+        p->cap_m = m;
+        p->text = (uint8_t*)malloc(m);
+    }
+    p->m = m;
+    p->blocks = blocks;
+    memcpy(p->text, s, m);
+    for (int i = 0; i < m; i++) p->peq[p->text[i] * blocks + (i >> 6)] |= 1ULL << (i & 63);
+    p->last_mask = 1ULL << ((m - 1) & 63);
+}
+
+// One block, one text byte. hin is the horizontal delta entering the top
+// row; returns the delta leaving the row selected by mask.
+static inline int advance_block(uint64_t *pv_io, uint64_t *mv_io, uint64_t eq, int hin, uint64_t mask) {
+    uint64_t pv = *pv_io, mv = *mv_io;
+    uint64_t xv = eq | mv;
+    if (hin < 0) eq |= 1;
+    uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+    uint64_t ph = mv | ~(xh | pv);
+    uint64_t mh = pv & xh;
+    int hout = (ph & mask) ? 1 : (mh & mask) ? -1 : 0;
+    ph <<= 1;
+    mh <<= 1;
+    if (hin < 0) mh |= 1;
+    else if (hin > 0) ph |= 1;
+    *pv_io = mh | ~(xv | ph);
+    *mv_io = ph & xv;
+    return hout;
+}
+
+// Single-word exact distance: the whole column lives in registers
+static int myers_word(const MyersPattern *p, const uint8_t *t, int n) {
+    uint64_t pv = ~0ULL, mv = 0, mask = p->last_mask;
+    const uint64_t *peq = p->peq;
+    int score = p->m;
+    for (int j = 0; j < n; j++) {
+        uint64_t eq = peq[t[j]];
+        uint64_t xv = eq | mv;
+        uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        uint64_t ph = mv | ~(xh | pv);
+        uint64_t mh = pv & xh;
+        score += (ph & mask) != 0;
+        score -= (mh & mask) != 0;
+        ph = (ph << 1) | 1;
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+    }
+    return score;
+}
+
+static inline int rows_in_block(const MyersPattern *p, int b) {
+    return b == p->blocks - 1 ? p->m - 64 * b : 64;
+}
+
+// Distance between the pattern and t, or -1 if it exceeds k (k < 0: exact).
+// With a bound only rows within k of the diagonal can hold values <= k, so
+// the blocks computed per column form a band [first, last] that slides down.
+// A block entering at the bottom starts as "+1 per row" from the block above,
+// and the band's top edge is fed +1 per column; both are upper bounds, which
+// leaves every value <= k exact. The scan stops once no block can hold a
+// value <= k, since path values never decrease.
+int myers_distance(MyersPattern *p, const char *text, int n, int k) {
+    const uint8_t *t = (const uint8_t *)text;
+    int m = p->m, nb = p->blocks;
+    if (m == 0) return k < 0 || n <= k ? n : -1;
+    if (k >= 0 && abs(m - n) > k) return -1;
+    if (nb == 1) {
+        int d = myers_word(p, t, n);
+        return k < 0 || d <= k ? d : -1;
+    }
+    long kk = k < 0 || k > m + n ? m + n : k;
+
+    int first = 0, last = 0;
+    while (last < nb - 1 && 64L * (last + 1) + 1 <= kk) last++;
+    for (int b = 0; b <= last; b++) {
+        p->pv[b] = ~0ULL;
+        p->mv[b] = 0;
+        p->score[b] = 64 * b + rows_in_block(p, b);
+    }
+    for (int j = 0; j < n; j++) {
+        long col = j + 1;
+        while (last < nb - 1 && 64L * (last + 1) + 1 <= col + kk) {
+            last++;
+            p->pv[last] = ~0ULL;
+            p->mv[last] = 0;
+            p->score[last] = p->score[last - 1] + rows_in_block(p, last);
+        }
+        while (first < last && 64L * (first + 1) < col - kk) first++;
+
+        const uint64_t *eq = p->peq + t[j] * nb;
+        int hin = 1;
+        for (int b = first; b < last; b++) {
+            hin = advance_block(&p->pv[b], &p->mv[b], eq[b], hin, 1ULL << 63);
+            p->score[b] += hin;
+        }
+        uint64_t mask = last == nb - 1 ? p->last_mask : 1ULL << 63;
+        p->score[last] += advance_block(&p->pv[last], &p->mv[last], eq[last], hin, mask);
+        if (k >= 0 && (j & 63) == 63) {
+            int hopeless = 1;
+            for (int b = first; b <= last && hopeless; b++) hopeless = p->score[b] - rows_in_block(p, b) >= kk;
+            if (hopeless) return -1;
+        }
+    }
+    int d = p->score[nb - 1];
+    return k < 0 || d <= k ? d : -1;
+}
+
+// Many-vs-one: the query's masks are built once for the whole batch
+void myers_batch(MyersPattern *p, const char *query, int m,
+                 const char *const *texts, const int *lens, int count, int k, int *out) {
+    myers_build(p, query, m);
+    for (int i = 0; i < count; i++) out[i] = myers_distance(p, texts[i], lens[i], k);
+}
+
+// Pair API: the shorter string becomes the pattern
+int edit_distance_myers(MyersPattern *p, const char *a, int la, const char *b, int lb, int k) {
+    if (la > lb) {
+        const char *ts = a;
+        a = b;
+        b = ts;
+        int tl = la;
+        la = lb;
+        lb = tl;
+    }
+    myers_build(p, a, la);
+    return myers_distance(p, b, lb, k);
+}
+
+// ---------------------------------------------------------------------------
+// Reference implementations: full-table DP (122) and two-row DP (58)
+// ---------------------------------------------------------------------------
+
+int min3(int a, int b, int c) {
+    int min = a;
+    if (b < min) min = b;
+    if (c < min) min = c;
+    return min;
+}
+
+int edit_distance(const char *s1, const char *s2) {
+    int len1 = strlen(s1);
+    int len2 = strlen(s2);
+
+    int **dp = (int**)calloc(len1 + 1, sizeof(int*));
+    for (int i = 0; i <= len1; i++) {
+        dp[i] = (int*)malloc((len2 + 1) * sizeof(int));
+    }
+
+    // Initialize base cases
+    for (int i = 0; i <= len1; i++) {
+        dp[i][0] = i;
+    }
+    for (int j = 0; j <= len2; j++) {
+        dp[0][j] = j;
+    }
+
+    // Fill DP table
+    for (int i = 1; i <= len1; i++) {
+        for (int j = 1; j <= len2; j++) {
+            if (s1[i-1] == s2[j-1]) {
+                dp[i][j] = dp[i-1][j-1];
+            } else {
+                dp[i][j] = 1 + min3(
+                    dp[i-1][j],      // Delete
+                    dp[i][j-1],      // Insert
+                    dp[i-1][j-1]     // Replace
+                );
+            }
+        }
+    }
+
+    int result = dp[len1][len2];
+
+    for (int i = 0; i <= len1; i++) {
+        free(dp[i]);
+    }
+    free(dp);
+
+    return result;
+}
+
+// Space-optimized version using only 2 rows
+int edit_distance_optimized(const char *s1, int len1, const char *s2, int len2) {
+    int prev[len2 + 1];
+    int curr[len2 + 1];
+
+    for (int j = 0; j <= len2; j++) {
+        prev[j] = j;
+    }
+
+    for (int i = 1; i <= len1; i++) {
+        curr[0] = i;
+        for (int j = 1; j <= len2; j++) {
+            if (s1[i-1] == s2[j-1]) {
+                curr[j] = prev[j-1];
+            } else {
+                curr[j] = 1 + min3(prev[j-1], prev[j], curr[j-1]);
+            }
+        }
+
+        // Swap rows
+        for (int j = 0; j <= len2; j++) {
+            prev[j] = curr[j];
+        }
+    }
+
+    return prev[len2];
+}
+
+// ---------------------------------------------------------------------------
+// Inputs: a random string and an edited copy (substitutions, insertions and
+// deletions at about one per EDIT_RATE bytes)
+// ---------------------------------------------------------------------------
+
+static unsigned int next_rand(unsigned int *seed) {
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 8;
+}
+
+void random_string(char *s, int len, int alphabet, unsigned int *seed) {
+    for (int i = 0; i < len; i++) s[i] = (char)('a' + next_rand(seed) % alphabet);
+    s[len] = '\0';
+}
+
+// Writes at most max_len bytes plus a terminator; returns the length
+int mutate_string(const char *src, int len, char *dst, int max_len, int rate, int alphabet, unsigned int *seed) {
+    int n = 0;
+    for (int i = 0; i < len && n < max_len; i++) {
+        unsigned int r = next_rand(seed) % (3 * rate);
+        if (r == 0) continue;                                              // delete
+        if (r == 1 && n + 1 < max_len) dst[n++] = (char)('a' + next_rand(seed) % alphabet); // insert
+        dst[n++] = r == 2 ? (char)('a' + next_rand(seed) % alphabet) : src[i];             // substitute
+    }
+    dst[n] = '\0';
+    return n;
+}
+
+// ---------------------------------------------------------------------------
+// Correctness: Myers exact, bounded and batched against both DP versions
+// ---------------------------------------------------------------------------
+
+int check_against_dp(void) {
+    int failures = 0;
+    unsigned int seed = 58;
+    MyersPattern p;
+    myers_init(&p);
+    char *a = (char*)malloc(2 * MAX_LENGTH + 2), *b = (char*)malloc(2 * MAX_LENGTH + 2);
+    for (int t = 0; t < FUZZ_TRIALS; t++) {
+        int long_case = t % 400 == 0;
+        int la = next_rand(&seed) % (long_case ? 3000 : 300);
+        int alphabet = 1 + next_rand(&seed) % 8;
+        random_string(a, la, alphabet, &seed);
+        int lb = t % 2 ? mutate_string(a, la, b, 2 * MAX_LENGTH, 1 + next_rand(&seed) % 20, alphabet, &seed)
+                       : (random_string(b, next_rand(&seed) % (long_case ? 3000 : 300), alphabet, &seed), (int)strlen(b));
+        int want = edit_distance_optimized(a, la, b, lb);
+        if (!long_case && edit_distance(a, b) != want) failures++;
+        if (edit_distance_myers(&p, a, la, b, lb, -1) != want) failures++;
+        if (edit_distance_myers(&p, b, lb, a, la, -1) != want) failures++;
+        // the pattern need not be the shorter string
+        myers_build(&p, b, lb);
+        if (myers_distance(&p, a, la, -1) != want) failures++;
+        int ks[4] = {0, want - 1, want, (int)(next_rand(&seed) % 200)};
+        for (int i = 0; i < 4; i++) {
+            if (ks[i] < 0) continue;
+            int got = edit_distance_myers(&p, a, la, b, lb, ks[i]);
+            if (got != (want <= ks[i] ? want : -1)) failures++;
+        }
+    }
+    // batch against single calls
+    const char *texts[64];
+    int lens[64], out[64];
+    char *pool = (char*)malloc(64 * 400);
+    random_string(a, 150, 4, &seed);
+    for (int i = 0; i < 64; i++) {
+        char *s = pool + i * 400;
+        lens[i] = mutate_string(a, 150, s, 399, 2 + i, 4, &seed);
+        texts[i] = s;
+    }
+    for (int k = -1; k < 40; k += 8) {
+        myers_batch(&p, a, 150, texts, lens, 64, k, out);
+        for (int i = 0; i < 64; i++) {
+            int want = edit_distance_optimized(a, 150, texts[i], lens[i]);
+            if (out[i] != (k < 0 || want <= k ? want : -1)) failures++;
+        }
+    }
+    free(pool);
+    free(a);
+    free(b);
+    myers_free(&p);
+    return failures;
+}
+
+// ---------------------------------------------------------------------------
+// Throughput in pairs per second for each string length
+// ---------------------------------------------------------------------------
+
+enum { ALG_DP_TABLE, ALG_DP_TWO_ROWS, ALG_MYERS, ALG_BANDED, ALG_BATCH, NUM_ALGS };
+
+static const char *alg_names[NUM_ALGS] = {"dp (122)", "2-row (58)", "myers", "banded", "batch"};
+
+static const int lengths[] = {16, 64, 256, 1000, 4000, 10000};
+
+int main() {
+    clock_t start = clock();
+    int failures = check_against_dp();
+
+    printf("%-8s %7s", "pairs/s", "pairs");
+    for (int a = 0; a < NUM_ALGS; a++) printf(" %12s", alg_names[a]);
+    printf("\n");
+
+    MyersPattern p;
+    myers_init(&p);
+    unsigned int seed = 122;
+    for (int li = 0; li < NUM_LENGTHS; li++) {
+        int len = lengths[li];
+        int pairs = PAIR_BYTES / len > MIN_PAIRS ? PAIR_BYTES / len : MIN_PAIRS;
+        int stride = len + len / 4 + 2;
+        char *left = (char*)malloc((size_t)pairs * stride), *right = (char*)malloc((size_t)pairs * stride);
+        const char **texts = (const char**)malloc(pairs * sizeof(char *));
+        int *lens = (int*)malloc(pairs * sizeof(int)), *dist = (int*)malloc(pairs * sizeof(int));
+        int *out = (int*)malloc(pairs * sizeof(int));
+        for (int i = 0; i < pairs; i++) dist[i] = -1;
+        // many edited copies of one string, so per-pair calls and the batch see the same work
+        random_string(left, len, 20, &seed);
+        for (int i = 0; i < pairs; i++) {
+            memcpy(left + (size_t)i * stride, left, len + 1);
+            lens[i] = mutate_string(left, len, right + (size_t)i * stride, stride - 1, EDIT_RATE, 20, &seed);
+            texts[i] = right + (size_t)i * stride;
+        }
+        long dp_pairs = DP_CELL_BUDGET / ((long)len * len);
+        if (dp_pairs < 1) dp_pairs = 1;
+        if (dp_pairs > pairs) dp_pairs = pairs;
+        int band = len / 10 + 4;  // well above the expected len * 3 / (2 * EDIT_RATE) edits
+
+        printf("%-8d %7d", len, pairs);
+        for (int a = 0; a < NUM_ALGS; a++) {
+            int count = a <= ALG_DP_TWO_ROWS ? (int)dp_pairs : pairs;
+            if (a == ALG_DP_TABLE && len > DP_TABLE_MAX) {
+                printf(" %12s", "-");
+                continue;
+            }
+            clock_t t0 = clock();
+            if (a == ALG_BATCH) {
+                myers_batch(&p, left, len, texts, lens, count, band, out);
+            } else {
+                for (int i = 0; i < count; i++) {
+                    const char *s = left + (size_t)i * stride;
+                    switch (a) {
+                        case ALG_DP_TABLE: out[i] = edit_distance(s, texts[i]); break;
+                        case ALG_DP_TWO_ROWS: out[i] = edit_distance_optimized(s, len, texts[i], lens[i]); break;
+                        case ALG_MYERS: out[i] = edit_distance_myers(&p, s, len, texts[i], lens[i], -1); break;
+                        default: out[i] = edit_distance_myers(&p, s, len, texts[i], lens[i], band); break;
+                    }
+                }
+            }
+            double t = (double)(clock() - t0) / CLOCKS_PER_SEC;
+            printf(" %12.0f", t > 0 ? count / t : 0.0);
+            // exact engines must agree wherever two of them ran; the band must cut at its bound
+            for (int i = 0; i < count; i++) {
+                if (a >= ALG_BANDED) {
+                    failures += out[i] != (dist[i] <= band ? dist[i] : -1);
+                } else {
+                    failures += dist[i] >= 0 && dist[i] != out[i];
+                    dist[i] = out[i];
+                }
+            }
+        }
+        printf("\n");
+        free(left);
+        free(right);
+        free(texts);
+        free(lens);
+        free(dist);
+        free(out);
+    }
+    myers_free(&p);
+
+    clock_t end = clock();
+    printf("Bit-parallel edit distance: lengths %d..%d, %.6f seconds\n",
+           lengths[0], lengths[NUM_LENGTHS - 1], (double)(end - start) / CLOCKS_PER_SEC);
+    printf("Failures: %d\n", failures);
+    return 0;
+}
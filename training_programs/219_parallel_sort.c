@@ -0,0 +1,772 @@
+// Sorting library: LSD radix with per-worker histograms, merge sort with merge-path splitting,
+// sample sort; 32/64-bit keys and key/value; benchmarked across worker counts and distributions
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef FULL_SIZE
+#define SORT_N (1 << 19)      // keys per benchmark run; 10^9 needs about 24 GB with buffers
+#else
+#define SORT_N (1 << 15)      // -DFULL_SIZE for 512K keys
+#endif
+#define MAX_WORKERS 8         // radix, merge and sample sort give each worker one run of the keys
+#define OVERSAMPLE 32         // sample-sort samples per splitter
+#define MAX_BUCKETS (2 * MAX_WORKERS - 1) // sample-sort ranges plus one equality bucket per splitter
+#define MERGE_RUN 24          // local merge sort starts from insertion-sorted runs
+#define CHECK_N 20011         // keys per correctness run (odd, so slices are uneven)
+
+// ---------------------------------------------------------------------------
+// Simulated workers run one after another. Each phase records the time every
+// worker spent; the slowest one is the phase's span, so work / span estimates
+// the speedup real threads would get (memory bandwidth aside). Serial steps
+// (prefix sums, splitter selection) count towards both.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    double work, span;
+    double worker[MAX_WORKERS];
+} WorkClock;
+
+static void phase_start(WorkClock *c) {
+    memset(c->worker, 0, sizeof(c->worker));
+}
+
+static void worker_done(WorkClock *c, int w, clock_t t0) {
+    c->worker[w] += (double)(clock() - t0) / CLOCKS_PER_SEC;
+}
+
+static void phase_end(WorkClock *c, int workers) {
+    double slowest = 0;
+    for (int w = 0; w < workers; w++) {
+        c->work += c->worker[w];
+        if (c->worker[w] > slowest) slowest = c->worker[w];
+    }
+    c->span += slowest;
+}
+
+static void serial_done(WorkClock *c, clock_t t0) {
+    double t = (double)(clock() - t0) / CLOCKS_PER_SEC;
+    c->work += t;
+    c->span += t;
+}
+
+static inline size_t slice_begin(size_t n, int w, int workers) {
+    return (size_t)((unsigned long long)n * w / workers);
+}
+
+// ---------------------------------------------------------------------------
+// LSD radix sort, 8 bits per pass. Every pass is two phases: each worker
+// histograms its own slice, then after a serial prefix over (digit, worker)
+// each worker scatters its slice to private, non-overlapping offsets, which
+// keeps the sort stable. Passes whose digit is the same for every key are
+// skipped. The key/value form carries a 32-bit value with each key.
+// ---------------------------------------------------------------------------
+
+void radix_sort_u32(uint32_t *a, uint32_t *tmp, size_t n, int workers, WorkClock *clk) {
+    static size_t hist[MAX_WORKERS][256];
+    uint32_t *src = a, *dst = tmp;
+    for (int shift = 0; shift < 32; shift += 8) {
+        phase_start(clk);
+        for (int w = 0; w < workers; w++) {
+            clock_t t0 = clock();
+            size_t *h = hist[w];
+            memset(h, 0, sizeof(hist[w]));
+            for (size_t i = slice_begin(n, w, workers); i < slice_begin(n, w + 1, workers); i++) {
+                h[(src[i] >> shift) & 0xFF]++;
+            }
+            worker_done(clk, w, t0);
+        }
+        phase_end(clk, workers);
+
+        clock_t t0 = clock();
+        size_t sum = 0;
+        int trivial = 0;
+        for (int d = 0; d < 256; d++) {
+            size_t digit_total = 0;
+            for (int w = 0; w < workers; w++) {
+                size_t c = hist[w][d];
+                hist[w][d] = sum;
+                sum += c;
+                digit_total += c;
+            }
+            if (digit_total == n) trivial = 1;
+        }
+        serial_done(clk, t0);
+        if (trivial) continue;
+
+        phase_start(clk);
+        for (int w = 0; w < workers; w++) {
+            clock_t t1 = clock();
+            size_t *off = hist[w];
+            for (size_t i = slice_begin(n, w, workers); i < slice_begin(n, w + 1, workers); i++) {
+                uint32_t k = src[i];
+                dst[off[(k >> shift) & 0xFF]++] = k;
+            }
+            worker_done(clk, w, t1);
+        }
+        phase_end(clk, workers);
+        uint32_t *t = src;
+        src = dst;
+        dst = t;
+    }
+    if (src != a) {
+        phase_start(clk);
+        for (int w = 0; w < workers; w++) {
+            clock_t t0 = clock();
+            size_t lo = slice_begin(n, w, workers);
+            memcpy(a + lo, src + lo, (slice_begin(n, w + 1, workers) - lo) * sizeof(uint32_t));
+            worker_done(clk, w, t0);
+        }
+        phase_end(clk, workers);
+    }
+}
+
+// 64-bit keys; vals (and tmp_vals) may be NULL for a keys-only sort
+void radix_sort_u64(uint64_t *keys, uint32_t *vals, uint64_t *tmp_keys, uint32_t *tmp_vals,
+                    size_t n, int workers, WorkClock *clk) {
+    static size_t hist[MAX_WORKERS][256];
+    uint64_t *src = keys, *dst = tmp_keys;
+    uint32_t *src_v = vals, *dst_v = tmp_vals;
+    for (int shift = 0; shift < 64; shift += 8) {
+        phase_start(clk);
+        for (int w = 0; w < workers; w++) {
+            clock_t t0 = clock();
+            size_t *h = hist[w];
+            memset(h, 0, sizeof(hist[w]));
+            for (size_t i = slice_begin(n, w, workers); i < slice_begin(n, w + 1, workers); i++) {
+                h[(src[i] >> shift) & 0xFF]++;
+            }
+            worker_done(clk, w, t0);
+        }
+        phase_end(clk, workers);
+
+        clock_t t0 = clock();
+        size_t sum = 0;
+        int trivial = 0;
+        for (int d = 0; d < 256; d++) {
+            size_t digit_total = 0;
+            for (int w = 0; w < workers; w++) {
+                size_t c = hist[w][d];
+                hist[w][d] = sum;
+                sum += c;
+                digit_total += c;
+            }
+            if (digit_total == n) trivial = 1;
+        }
+        serial_done(clk, t0);
+        if (trivial) continue;
+
+        phase_start(clk);
+        for (int w = 0; w < workers; w++) {
+            clock_t t1 = clock();
+            size_t *off = hist[w];
+            size_t lo = slice_begin(n, w, workers), hi = slice_begin(n, w + 1, workers);
+            if (vals) {
+                for (size_t i = lo; i < hi; i++) {
+                    size_t o = off[(src[i] >> shift) & 0xFF]++;
+                    dst[o] = src[i];
+                    dst_v[o] = src_v[i];
+                }
+            } else {
+                for (size_t i = lo; i < hi; i++) {
+                    uint64_t k = src[i];
+                    dst[off[(k >> shift) & 0xFF]++] = k;
+                }
+            }
+            worker_done(clk, w, t1);
+        }
+        phase_end(clk, workers);
+        uint64_t *t = src;
+        src = dst;
+        dst = t;
+        uint32_t *tv = src_v;
+        src_v = dst_v;
+        dst_v = tv;
+    }
+    if (src != keys) {
+        phase_start(clk);
+        for (int w = 0; w < workers; w++) {
+            clock_t t0 = clock();
+            size_t lo = slice_begin(n, w, workers), len = slice_begin(n, w + 1, workers) - lo;
+            memcpy(keys + lo, src + lo, len * sizeof(uint64_t));
+            if (vals) memcpy(vals + lo, src_v + lo, len * sizeof(uint32_t));
+            worker_done(clk, w, t0);
+        }
+        phase_end(clk, workers);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Merge sort. Workers first sort their slices locally (insertion-sorted runs
+// merged bottom-up, ping-ponging with the caller's buffer; nothing is
+// allocated inside the sort). Then runs are merged pairwise, and in every
+// round the output positions are cut into equal worker ranges: a worker
+// finds where its range starts inside a merge with a merge-path binary
+// search on the diagonal and merges only that piece, so the last rounds,
+// with a single huge merge, stay balanced. Ties take the left run (stable).
+// ---------------------------------------------------------------------------
+
+static void insertion_sort_kv(uint64_t *k, uint32_t *v, size_t n) {
+    for (size_t i = 1; i < n; i++) {
+        uint64_t key = k[i];
+        uint32_t val = v ? v[i] : 0;
+        size_t j = i;
+        while (j > 0 && k[j - 1] > key) {
+            k[j] = k[j - 1];
+            if (v) v[j] = v[j - 1];
+            j--;
+        }
+        k[j] = key;
+        if (v) v[j] = val;
+    }
+}
+
+// Outputs out_len elements of the merge of a and b, starting after
+// a_skip elements of a and b_skip of b have been taken
+static void merge_piece(const uint64_t *ak, const uint32_t *av, size_t na,
+                        const uint64_t *bk, const uint32_t *bv, size_t nb,
+                        size_t i, size_t j, size_t out_len, uint64_t *ok, uint32_t *ov) {
+    size_t o = 0;
+    if (av) {
+        while (o < out_len && i < na && j < nb) {
+            if (ak[i] <= bk[j]) {
+                ov[o] = av[i];
+                ok[o++] = ak[i++];
+            } else {
+                ov[o] = bv[j];
+                ok[o++] = bk[j++];
+            }
+        }
+        size_t rest = out_len - o;
+        if (i < na) {
+            memcpy(ok + o, ak + i, rest * sizeof(uint64_t));
+            memcpy(ov + o, av + i, rest * sizeof(uint32_t));
+        } else {
+            memcpy(ok + o, bk + j, rest * sizeof(uint64_t));
+            memcpy(ov + o, bv + j, rest * sizeof(uint32_t));
+        }
+    } else {
+        while (o < out_len && i < na && j < nb) {
+            uint64_t x = ak[i], y = bk[j];
+            int take_a = x <= y;
+            ok[o++] = take_a ? x : y;
+            i += take_a;
+            j += !take_a;
+        }
+        size_t rest = out_len - o;
+        memcpy(ok + o, i < na ? ak + i : bk + j, rest * sizeof(uint64_t));
+    }
+}
+
+// Elements of a among the first diag outputs of the stable merge of a and b
+static size_t merge_path(const uint64_t *a, size_t na, const uint64_t *b, size_t nb, size_t diag) {
+    size_t lo = diag > nb ? diag - nb : 0, hi = diag < na ? diag : na;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (a[mid] <= b[diag - mid - 1]) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+// Sorts k (and v) using tk/tv as scratch; the result ends in k
+static void local_merge_sort(uint64_t *k, uint32_t *v, uint64_t *tk, uint32_t *tv, size_t n) {
+    for (size_t i = 0; i < n; i += MERGE_RUN) {
+        insertion_sort_kv(k + i, v ? v + i : NULL, n - i < MERGE_RUN ? n - i : MERGE_RUN);
+    }
+    uint64_t *sk = k, *dk = tk;
+    uint32_t *sv = v, *dv = tv;
+    for (size_t width = MERGE_RUN; width < n; width *= 2) {
+        for (size_t lo = 0; lo < n; lo += 2 * width) {
+            size_t mid = lo + width < n ? lo + width : n;
+            size_t hi = mid + width < n ? mid + width : n;
+            merge_piece(sk + lo, sv ? sv + lo : NULL, mid - lo, sk + mid, sv ? sv + mid : NULL, hi - mid,
+                        0, 0, hi - lo, dk + lo, dv ? dv + lo : NULL);
+        }
+        uint64_t *t = sk;
+        sk = dk;
+        dk = t;
+        uint32_t *tvv = sv;
+        sv = dv;
+        dv = tvv;
+    }
+    if (sk != k) {
+        memcpy(k, sk, n * sizeof(uint64_t));
+        if (v) memcpy(v, sv, n * sizeof(uint32_t));
+    }
+}
+
+void merge_sort_parallel(uint64_t *keys, uint32_t *vals, uint64_t *tmp_keys, uint32_t *tmp_vals,
+                         size_t n, int workers, WorkClock *clk) {
+    size_t bounds[MAX_WORKERS + 1];
+    for (int w = 0; w <= workers; w++) bounds[w] = slice_begin(n, w, workers);
+    phase_start(clk);
+    for (int w = 0; w < workers; w++) {
+        clock_t t0 = clock();
+        size_t lo = bounds[w];
+        local_merge_sort(keys + lo, vals ? vals + lo : NULL, tmp_keys + lo, tmp_vals ? tmp_vals + lo : NULL,
+                         bounds[w + 1] - lo);
+        worker_done(clk, w, t0);
+    }
+    phase_end(clk, workers);
+
+    uint64_t *sk = keys, *dk = tmp_keys;
+    uint32_t *sv = vals, *dv = tmp_vals;
+    int runs = workers;
+    while (runs > 1) {
+        phase_start(clk);
+        for (int w = 0; w < workers; w++) {
+            clock_t t0 = clock();
+            size_t out_lo = slice_begin(n, w, workers), out_hi = slice_begin(n, w + 1, workers);
+            for (int r = 0; r < runs; r += 2) {
+                size_t lo = bounds[r], mid = bounds[r + 1], hi = r + 1 < runs ? bounds[r + 2] : mid;
+                size_t seg_lo = out_lo > lo ? out_lo : lo, seg_hi = out_hi < hi ? out_hi : hi;
+                if (seg_lo >= seg_hi) continue;
+                if (r + 1 == runs) {
+                    // odd run out: carried over unchanged
+                    memcpy(dk + seg_lo, sk + seg_lo, (seg_hi - seg_lo) * sizeof(uint64_t));
+                    if (sv) memcpy(dv + seg_lo, sv + seg_lo, (seg_hi - seg_lo) * sizeof(uint32_t));
+                    continue;
+                }
+                size_t i = merge_path(sk + lo, mid - lo, sk + mid, hi - mid, seg_lo - lo);
+                merge_piece(sk + lo, sv ? sv + lo : NULL, mid - lo, sk + mid, sv ? sv + mid : NULL, hi - mid,
+                            i, seg_lo - lo - i, seg_hi - seg_lo, dk + seg_lo, dv ? dv + seg_lo : NULL);
+            }
+            worker_done(clk, w, t0);
+        }
+        phase_end(clk, workers);
+        int merged = 0;
+        for (int r = 0; r < runs; r += 2) bounds[merged++] = bounds[r];
+        bounds[merged] = n;
+        runs = merged;
+        uint64_t *t = sk;
+        sk = dk;
+        dk = t;
+        uint32_t *tv = sv;
+        sv = dv;
+        dv = tv;
+    }
+    if (sk != keys) {
+        phase_start(clk);
+        for (int w = 0; w < workers; w++) {
+            clock_t t0 = clock();
+            size_t lo = slice_begin(n, w, workers), len = slice_begin(n, w + 1, workers) - lo;
+            memcpy(keys + lo, sk + lo, len * sizeof(uint64_t));
+            if (vals) memcpy(vals + lo, sv + lo, len * sizeof(uint32_t));
+            worker_done(clk, w, t0);
+        }
+        phase_end(clk, workers);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Sample sort. OVERSAMPLE samples per worker pick workers - 1 splitters;
+// duplicate splitters collapse, and every splitter also gets an equality
+// bucket, so heavy keys land in a bucket that needs no sorting instead of
+// overloading one worker. Workers count bucket sizes over their slices,
+// scatter (stable, through per-worker offsets) and then sort the buckets
+// they own.
+// ---------------------------------------------------------------------------
+
+static inline int sample_bucket(const uint64_t *spl, int num_spl, uint64_t key) {
+    int lo = 0, hi = num_spl;  // first splitter >= key
+    while (lo < hi) {
+        int mid = (lo + hi) >> 1;
+        if (spl[mid] < key) lo = mid + 1;
+        else hi = mid;
+    }
+    return 2 * lo + (lo < num_spl && spl[lo] == key);
+}
+
+void sample_sort_parallel(uint64_t *keys, uint32_t *vals, uint64_t *tmp_keys, uint32_t *tmp_vals,
+                          size_t n, int workers, WorkClock *clk) {
+    if (workers == 1 || n < (size_t)workers * OVERSAMPLE * 8) {
+        phase_start(clk);
+        clock_t t0 = clock();
+        local_merge_sort(keys, vals, tmp_keys, tmp_vals, n);
+        worker_done(clk, 0, t0);
+        phase_end(clk, 1);
+        return;
+    }
+    clock_t t0 = clock();
+    uint64_t samples[MAX_WORKERS * OVERSAMPLE], spl[MAX_WORKERS];
+    int num_samples = workers * OVERSAMPLE, num_spl = 0;
+    size_t stride = n / num_samples;
+    unsigned int seed = 219;
+    for (int i = 0; i < num_samples; i++) {
+        seed = seed * 1103515245 + 12345;
+        samples[i] = keys[i * stride + (seed >> 8) % stride];
+    }
+    insertion_sort_kv(samples, NULL, num_samples);
+    for (int i = 1; i < workers; i++) {
+        uint64_t s = samples[i * OVERSAMPLE];
+        if (num_spl == 0 || s != spl[num_spl - 1]) spl[num_spl++] = s;
+    }
+    int buckets = 2 * num_spl + 1;
+    serial_done(clk, t0);
+
+    size_t counts[MAX_WORKERS][MAX_BUCKETS];
+    phase_start(clk);
+    for (int w = 0; w < workers; w++) {
+        clock_t t1 = clock();
+        memset(counts[w], 0, sizeof(counts[w]));
+        for (size_t i = slice_begin(n, w, workers); i < slice_begin(n, w + 1, workers); i++) {
+            counts[w][sample_bucket(spl, num_spl, keys[i])]++;
+        }
+        worker_done(clk, w, t1);
+    }
+    phase_end(clk, workers);
+
+    t0 = clock();
+    size_t bucket_lo[MAX_BUCKETS + 1], sum = 0;
+    for (int b = 0; b < buckets; b++) {
+        bucket_lo[b] = sum;
+        for (int w = 0; w < workers; w++) {
+            size_t c = counts[w][b];
+            counts[w][b] = sum;
+            sum += c;
+        }
+    }
+    bucket_lo[buckets] = n;
+    serial_done(clk, t0);
+
+    phase_start(clk);
+    for (int w = 0; w < workers; w++) {
+        clock_t t1 = clock();
+        size_t *off = counts[w];
+        for (size_t i = slice_begin(n, w, workers); i < slice_begin(n, w + 1, workers); i++) {
+            size_t o = off[sample_bucket(spl, num_spl, keys[i])]++;
+            tmp_keys[o] = keys[i];
+            if (vals) tmp_vals[o] = vals[i];
+        }
+        worker_done(clk, w, t1);
+    }
+    phase_end(clk, workers);
+
+    // worker i owns the range below splitter i and its equality bucket
+    phase_start(clk);
+    for (int b = 0; b < buckets; b++) {
+        clock_t t1 = clock();
+        size_t lo = bucket_lo[b], len = bucket_lo[b + 1] - lo;
+        memcpy(keys + lo, tmp_keys + lo, len * sizeof(uint64_t));
+        if (vals) memcpy(vals + lo, tmp_vals + lo, len * sizeof(uint32_t));
+        if (b % 2 == 0) {
+            local_merge_sort(keys + lo, vals ? vals + lo : NULL, tmp_keys + lo, tmp_vals ? tmp_vals + lo : NULL, len);
+        }
+        worker_done(clk, b / 2, t1);
+    }
+    phase_end(clk, workers);
+}
+
+// ---------------------------------------------------------------------------
+// Reference implementations: decimal LSD radix sort (04) and the simulated
+// parallel merge sort (131), both on int arrays
+// ---------------------------------------------------------------------------
+
+int get_max(int arr[], int n) {
+    int max = arr[0];
+    for (int i = 1; i < n; i++)
+        if (arr[i] > max)
+            max = arr[i];
+    return max;
+}
+
+void counting_sort_by_digit(int arr[], int n, int exp) {
+    int* output = (int*)malloc(n * sizeof(int));
+    int count[10] = {0};
+
+    for (int i = 0; i < n; i++)
+        count[(arr[i] / exp) % 10]++;
+
+    for (int i = 1; i < 10; i++)
+        count[i] += count[i - 1];
+
+    for (int i = n - 1; i >= 0; i--) {
+        output[count[(arr[i] / exp) % 10] - 1] = arr[i];
+        count[(arr[i] / exp) % 10]--;
+    }
+
+    for (int i = 0; i < n; i++)
+        arr[i] = output[i];
+
+    free(output);
+}
+
+void radix_sort(int arr[], int n) {
+    int max = get_max(arr, n);
+
+    for (int exp = 1; max / exp > 0; exp *= 10)
+        counting_sort_by_digit(arr, n, exp);
+}
+
+void merge(int arr[], int left, int mid, int right, int temp[]) {
+    int i = left, j = mid + 1, k = left;
+
+    while (i <= mid && j <= right) {
+        if (arr[i] <= arr[j]) {
+            temp[k++] = arr[i++];
+        } else {
+            temp[k++] = arr[j++];
+        }
+    }
+
+    while (i <= mid) {
+        temp[k++] = arr[i++];
+    }
+
+    while (j <= right) {
+        temp[k++] = arr[j++];
+    }
+
+    for (i = left; i <= right; i++) {
+        arr[i] = temp[i];
+    }
+}
+
+void parallel_merge_sort(int arr[], int n) {
+    int *temp = (int*)malloc(n * sizeof(int));
+
+    // Bottom-up merge sort (simulates parallel execution)
+    for (int size = 1; size < n; size *= 2) {
+        // Process independent merge operations
+        for (int left = 0; left < n - size; left += 2 * size) {
+            int mid = left + size - 1;
+            int right = (left + 2 * size - 1 < n - 1) ? left + 2 * size - 1 : n - 1;
+            merge(arr, left, mid, right, temp);
+        }
+    }
+
+    free(temp);
+}
+
+// ---------------------------------------------------------------------------
+// Inputs
+// ---------------------------------------------------------------------------
+
+enum { DIST_UNIFORM, DIST_DUPLICATES, DIST_SORTED, DIST_REVERSE, DIST_SKEWED, NUM_DISTS };
+
+static const char *dist_names[NUM_DISTS] = {"uniform", "dup1000", "sorted", "reverse", "skewed"};
+
+static uint64_t next_rand64(uint64_t *seed) {
+    *seed = *seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    uint64_t x = *seed;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    return x ^ (x >> 33);
+}
+
+void generate_keys(uint64_t *keys, size_t n, int dist, uint64_t seed) {
+    for (size_t i = 0; i < n; i++) {
+        uint64_t r = next_rand64(&seed);
+        switch (dist) {
+            case DIST_UNIFORM: keys[i] = r; break;
+            case DIST_DUPLICATES: keys[i] = r % 1000; break;
+            case DIST_SORTED: keys[i] = i; break;
+            case DIST_REVERSE: keys[i] = n - i; break;
+            default: keys[i] = r >> (next_rand64(&seed) % 64); break;  // magnitudes spread over all scales
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Sort dispatch: every variant keyed by one enum so the check and the
+// benchmark drive them the same way
+// ---------------------------------------------------------------------------
+
+enum { SORT_RADIX_U32, SORT_RADIX_U64, SORT_RADIX_KV, SORT_MERGE_U64, SORT_MERGE_KV,
+       SORT_SAMPLE_U64, SORT_SAMPLE_KV, NUM_SORTS };
+
+static const char *sort_names[NUM_SORTS] = {"radix u32", "radix u64", "radix kv", "merge u64", "merge kv",
+                                            "sample u64", "sample kv"};
+
+typedef struct {
+    uint64_t *keys, *tmp_keys;
+    uint32_t *vals, *tmp_vals;
+    uint32_t *keys32, *tmp32;
+} SortBuffers;
+
+static void alloc_buffers(SortBuffers *b, size_t n) {
+    b->keys = (uint64_t*)malloc(n * sizeof(uint64_t));
+    b->tmp_keys = (uint64_t*)malloc(n * sizeof(uint64_t));
+    b->vals = (uint32_t*)malloc(n * sizeof(uint32_t));
+    b->tmp_vals = (uint32_t*)malloc(n * sizeof(uint32_t));
+    b->keys32 = (uint32_t*)malloc(n * sizeof(uint32_t));
+    b->tmp32 = (uint32_t*)malloc(n * sizeof(uint32_t));
+}
+
+static void free_buffers(SortBuffers *b) {
+    free(b->keys);
+    free(b->tmp_keys);
+    free(b->vals);
+    free(b->tmp_vals);
+    free(b->keys32);
+    free(b->tmp32);
+}
+
+// Loads the input (values = original positions) and sorts it
+static void run_sort(int alg, SortBuffers *b, const uint64_t *input, size_t n, int workers, WorkClock *clk) {
+    int kv = alg == SORT_RADIX_KV || alg == SORT_MERGE_KV || alg == SORT_SAMPLE_KV;
+    if (alg == SORT_RADIX_U32) {
+        for (size_t i = 0; i < n; i++) b->keys32[i] = (uint32_t)input[i];
+    } else {
+        memcpy(b->keys, input, n * sizeof(uint64_t));
+    }
+    if (kv) {
+        for (size_t i = 0; i < n; i++) b->vals[i] = (uint32_t)i;
+    }
+    uint32_t *v = kv ? b->vals : NULL, *tv = kv ? b->tmp_vals : NULL;
+    memset(clk, 0, sizeof(*clk));
+    switch (alg) {
+        case SORT_RADIX_U32: radix_sort_u32(b->keys32, b->tmp32, n, workers, clk); break;
+        case SORT_RADIX_U64:
+        case SORT_RADIX_KV: radix_sort_u64(b->keys, v, b->tmp_keys, tv, n, workers, clk); break;
+        case SORT_MERGE_U64:
+        case SORT_MERGE_KV: merge_sort_parallel(b->keys, v, b->tmp_keys, tv, n, workers, clk); break;
+        default: sample_sort_parallel(b->keys, v, b->tmp_keys, tv, n, workers, clk); break;
+    }
+}
+
+static int cmp_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static int cmp_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+// ---------------------------------------------------------------------------
+// Correctness: every variant, distribution and an uneven worker count
+// against qsort; key/value sorts must also be stable permutations
+// ---------------------------------------------------------------------------
+
+int check_sorts(void) {
+    int failures = 0;
+    size_t n = CHECK_N;
+    SortBuffers b;
+    alloc_buffers(&b, n);
+    uint64_t *input = (uint64_t*)malloc(n * sizeof(uint64_t)), *want = (uint64_t*)malloc(n * sizeof(uint64_t));
+    uint32_t *want32 = (uint32_t*)malloc(n * sizeof(uint32_t));
+    uint8_t *seen = (uint8_t*)malloc(n);
+    static const int worker_counts[3] = {1, 3, MAX_WORKERS};
+    for (int dist = 0; dist < NUM_DISTS; dist++) {
+        generate_keys(input, n, dist, 1000 + dist);
+        memcpy(want, input, n * sizeof(uint64_t));
+        qsort(want, n, sizeof(uint64_t), cmp_u64);
+        for (size_t i = 0; i < n; i++) want32[i] = (uint32_t)input[i];
+        qsort(want32, n, sizeof(uint32_t), cmp_u32);
+        for (int alg = 0; alg < NUM_SORTS; alg++) {
+            for (int wi = 0; wi < 3; wi++) {
+                WorkClock clk;
+                run_sort(alg, &b, input, n, worker_counts[wi], &clk);
+                if (alg == SORT_RADIX_U32) {
+                    failures += memcmp(b.keys32, want32, n * sizeof(uint32_t)) != 0;
+                    continue;
+                }
+                failures += memcmp(b.keys, want, n * sizeof(uint64_t)) != 0;
+                if (alg != SORT_RADIX_KV && alg != SORT_MERGE_KV && alg != SORT_SAMPLE_KV) continue;
+                memset(seen, 0, n);
+                for (size_t i = 0; i < n; i++) {
+                    uint32_t v = b.vals[i];
+                    if (v >= n || seen[v] || input[v] != b.keys[i] ||
+                        (i > 0 && b.keys[i] == b.keys[i - 1] && v < b.vals[i - 1])) {
+                        failures++;
+                        break;
+                    }
+                    seen[v] = 1;
+                }
+            }
+        }
+        // references on the 0..999999 ints their own demos sort
+        int *ints = (int*)malloc(n * sizeof(int)), *ints2 = (int*)malloc(n * sizeof(int));
+        for (size_t i = 0; i < n; i++) ints[i] = ints2[i] = (int)(input[i] % 1000000);
+        radix_sort(ints, (int)n);
+        parallel_merge_sort(ints2, (int)n);
+        for (size_t i = 1; i < n; i++) {
+            if (ints[i - 1] > ints[i] || ints[i] != ints2[i]) {
+                failures++;
+                break;
+            }
+        }
+        free(ints);
+        free(ints2);
+    }
+    free(input);
+    free(want);
+    free(want32);
+    free(seen);
+    free_buffers(&b);
+    return failures;
+}
+
+// ---------------------------------------------------------------------------
+// Benchmark: estimated parallel throughput (keys / span) per worker count
+// ---------------------------------------------------------------------------
+
+#define NUM_WORKER_COUNTS 4
+
+static const int bench_workers[NUM_WORKER_COUNTS] = {1, 2, 4, 8};
+
+int main() {
+    clock_t start = clock();
+    int failures = check_sorts();
+
+    size_t n = SORT_N;
+    SortBuffers b;
+    alloc_buffers(&b, n);
+    uint64_t *input = (uint64_t*)malloc(n * sizeof(uint64_t));
+    int *ints = (int*)malloc(n * sizeof(int));
+
+    printf("Mkeys/s (n=%zu)     ", n);
+    for (int wi = 0; wi < NUM_WORKER_COUNTS; wi++) printf("    workers=%d", bench_workers[wi]);
+    printf("\n");
+    for (int dist = 0; dist < NUM_DISTS; dist++) {
+        generate_keys(input, n, dist, 7 + dist);
+        for (int alg = 0; alg < NUM_SORTS; alg++) {
+            printf("%-8s %-11s", dist_names[dist], sort_names[alg]);
+            for (int wi = 0; wi < NUM_WORKER_COUNTS; wi++) {
+                WorkClock clk;
+                run_sort(alg, &b, input, n, bench_workers[wi], &clk);
+                double rate = clk.span > 0 ? n / clk.span / 1e6 : 0.0;
+                printf(" %7.1f x%-4.1f", rate, clk.span > 0 ? clk.work / clk.span : 0.0);
+            }
+            printf("\n");
+            if (alg != SORT_RADIX_U32) {
+                for (size_t i = 1; i < n; i++) {
+                    if (b.keys[i - 1] > b.keys[i]) {
+                        failures++;
+                        break;
+                    }
+                }
+            }
+        }
+        if (dist != DIST_UNIFORM) continue;
+        // serial baselines; 04 and 131 get the keys mod 10^6, as in their demos
+        memcpy(b.keys, input, n * sizeof(uint64_t));
+        clock_t t0 = clock();
+        qsort(b.keys, n, sizeof(uint64_t), cmp_u64);
+        printf("%-8s %-11s %7.1f\n", "", "qsort", n / ((double)(clock() - t0) / CLOCKS_PER_SEC) / 1e6);
+        for (size_t i = 0; i < n; i++) ints[i] = (int)(input[i] % 1000000);
+        t0 = clock();
+        radix_sort(ints, (int)n);
+        printf("%-8s %-11s %7.1f\n", "", "radix (04)", n / ((double)(clock() - t0) / CLOCKS_PER_SEC) / 1e6);
+        for (size_t i = 0; i < n; i++) ints[i] = (int)(input[i] % 1000000);
+        t0 = clock();
+        parallel_merge_sort(ints, (int)n);
+        printf("%-8s %-11s %7.1f\n", "", "merge (131)", n / ((double)(clock() - t0) / CLOCKS_PER_SEC) / 1e6);
+    }
+    printf("(sorts: slowest worker of each phase, summed over phases; xN = total worker time / that; "
+           "qsort, 04 and 131 are serial)\n");
+
+    free(input);
+    free(ints);
+    free_buffers(&b);
+    clock_t end = clock();
+    printf("Parallel sort library: %zu keys, %d distributions, %.6f seconds\n",
+           n, NUM_DISTS, (double)(end - start) / CLOCKS_PER_SEC);
+    printf("Failures: %d\n", failures);
+    return 0;
+}
@@ -0,0 +1,784 @@
+// Selection: introselect with a median-of-medians fallback, Floyd-Rivest, batched multi-quantile
+// select, partial sort, and sliding-window medians (two heaps, running histograms) vs 121 and 45
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#ifdef FULL_SIZE
+#define SELECT_N (1 << 20)    // array size for the selection benchmark
+#define STREAM_N 200000       // values in the 1-D sliding-median benchmark
+#define WIDTH 256
+#define HEIGHT 256
+#define FUZZ_TRIALS 2000      // random arrays checked against qsort
+#else
+#define SELECT_N (1 << 16)    // -DFULL_SIZE for 1M values, 200K stream, 256x256 image
+#define STREAM_N 50000
+#define WIDTH 96
+#define HEIGHT 96
+#define FUZZ_TRIALS 800
+#endif
+#define SELECT_REPS 4         // selections timed per algorithm and distribution
+#define SMALL_SELECT 16       // ranges this small are finished by insertion sort
+#define FR_SAMPLE_MIN 600     // Floyd-Rivest samples ranges larger than this
+#define NUM_QUANTILES 9       // deciles for the multi-select benchmark
+#define PARTIAL_K 1000        // partial sort: smallest PARTIAL_K in order
+#define SORT_FILTER_MAX 9     // 45's sort-per-window filter is only timed up to this window
+
+static inline void swap_int(int *a, int *b) {
+    int t = *a;
+    *a = *b;
+    *b = t;
+}
+
+static void insertion_sort_int(int *a, int n) {
+    for (int i = 1; i < n; i++) {
+        int key = a[i], j = i - 1;
+        while (j >= 0 && a[j] > key) {
+            a[j + 1] = a[j];
+            j--;
+        }
+        a[j + 1] = key;
+    }
+}
+
+static int cmp_int(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+// ---------------------------------------------------------------------------
+// Introselect: quickselect with a median-of-three/ninther pivot and Hoare partition
+// (equal keys split evenly, so duplicates cost nothing), iterating only into
+// the side that holds k. After 2 log2(n) rounds without finishing it
+// switches to median of medians, which bounds the worst case at O(n).
+// ---------------------------------------------------------------------------
+
+// Partitions a[lo..hi] around the value a[lo]; returns j with
+// a[lo..j] <= pivot <= a[j+1..hi] and lo <= j < hi
+static int hoare_partition(int *a, int lo, int hi) {
+    int p = a[lo], i = lo - 1, j = hi + 1;
+    for (;;) {
+        do i++; while (a[i] < p);
+        do j--; while (a[j] > p);
+        if (i >= j) return j;
+        swap_int(&a[i], &a[j]);
+    }
+}
+
+static inline int median3_index(const int *a, int i, int j, int k) {
+    if (a[i] < a[j]) return a[j] < a[k] ? j : (a[i] < a[k] ? k : i);
+    return a[i] < a[k] ? i : (a[j] < a[k] ? k : j);
+}
+
+// Moves the pivot to a[lo]: median of three, or Tukey's ninther (median of
+// three medians) on large ranges, which also defuses organ-pipe inputs
+static void pivot_to_front(int *a, int lo, int hi) {
+    int mid = lo + (hi - lo) / 2, p;
+    if (hi - lo > 128) {
+        int d = (hi - lo) / 8;
+        p = median3_index(a, median3_index(a, lo, lo + d, lo + 2 * d),
+                          median3_index(a, mid - d, mid, mid + d),
+                          median3_index(a, hi - 2 * d, hi - d, hi));
+    } else {
+        p = median3_index(a, lo, mid, hi);
+    }
+    swap_int(&a[lo], &a[p]);
+}
+
+// Dutch-flag partition of a[lo..hi] around value p: a[lo..*lt) < p, a[*lt..*gt] == p
+static void partition3(int *a, int lo, int hi, int p, int *lt, int *gt) {
+    int l = lo, i = lo, g = hi;
+    while (i <= g) {
+        if (a[i] < p) swap_int(&a[l++], &a[i++]);
+        else if (a[i] > p) swap_int(&a[i], &a[g--]);
+        else i++;
+    }
+    *lt = l;
+    *gt = g;
+}
+
+static int mom_select_range(int *a, int lo, int hi, int k);
+
+// Median of the medians of groups of five, gathered at the front of the range
+static int mom_pivot(int *a, int lo, int hi) {
+    int m = lo;
+    for (int i = lo; i <= hi; i += 5) {
+        int len = hi - i + 1 < 5 ? hi - i + 1 : 5;
+        insertion_sort_int(a + i, len);
+        swap_int(&a[m++], &a[i + (len - 1) / 2]);
+    }
+    return mom_select_range(a, lo, m - 1, lo + (m - lo - 1) / 2);
+}
+
+static int mom_select_range(int *a, int lo, int hi, int k) {
+    while (hi - lo > SMALL_SELECT) {
+        int p = mom_pivot(a, lo, hi), lt, gt;
+        partition3(a, lo, hi, p, &lt, &gt);
+        if (k < lt) hi = lt - 1;
+        else if (k > gt) lo = gt + 1;
+        else return p;
+    }
+    insertion_sort_int(a + lo, hi - lo + 1);
+    return a[k];
+}
+
+// k-th smallest (0-based); a is permuted so that a[k] holds it
+int introselect(int *a, int n, int k) {
+    int lo = 0, hi = n - 1, budget = 4;
+    for (int m = n; m > 1; m >>= 1) budget += 2;
+    while (hi - lo > SMALL_SELECT) {
+        if (budget-- == 0) return mom_select_range(a, lo, hi, k);
+        pivot_to_front(a, lo, hi);
+        int j = hoare_partition(a, lo, hi);
+        if (k <= j) hi = j;
+        else lo = j + 1;
+    }
+    insertion_sort_int(a + lo, hi - lo + 1);
+    return a[k];
+}
+
+// ---------------------------------------------------------------------------
+// Floyd-Rivest: before partitioning a large range it recursively selects
+// within a small sample around the expected position of k, so the two
+// pivots bracket k tightly and the range shrinks to about n^(2/3) per pass.
+// ---------------------------------------------------------------------------
+
+static void fr_select(int *a, int left, int right, int k) {
+    while (right > left) {
+        if (right - left > FR_SAMPLE_MIN) {
+            double n = right - left + 1, i = k - left + 1;
+            double z = log(n), s = 0.5 * exp(2 * z / 3);
+            double sd = 0.5 * sqrt(z * s * (n - s) / n) * (i - n / 2 < 0 ? -1 : 1);
+            int new_left = (int)(k - i * s / n + sd), new_right = (int)(k + (n - i) * s / n + sd);
+            fr_select(a, new_left > left ? new_left : left, new_right < right ? new_right : right, k);
+        }
+        int t = a[k], i = left, j = right;
+        swap_int(&a[left], &a[k]);
+        if (a[right] > t) swap_int(&a[right], &a[left]);
+        while (i < j) {
+            swap_int(&a[i], &a[j]);
+            i++;
+            j--;
+            while (a[i] < t) i++;
+            while (a[j] > t) j--;
+        }
+        if (a[left] == t) {
+            swap_int(&a[left], &a[j]);
+        } else {
+            j++;
+            swap_int(&a[j], &a[right]);
+        }
+        if (j <= k) left = j + 1;
+        if (k <= j) right = j - 1;
+    }
+}
+
+int floyd_rivest_select(int *a, int n, int k) {
+    fr_select(a, 0, n - 1, k);
+    return a[k];
+}
+
+// ---------------------------------------------------------------------------
+// Multi-select: one partition serves every requested rank; the sorted rank
+// list is split at the pivot and each side recurses with its own ranks, so
+// m quantiles cost about n log m instead of m separate selections.
+// ---------------------------------------------------------------------------
+
+static void multi_select_rec(int *a, int lo, int hi, const int *ks, int nk, int budget) {
+    while (nk > 0) {
+        if (hi - lo <= SMALL_SELECT) {
+            insertion_sort_int(a + lo, hi - lo + 1);
+            return;
+        }
+        if (budget-- == 0) {
+            for (int i = 0; i < nk; i++) {
+                if (ks[i] < lo) continue;  // repeated rank
+                mom_select_range(a, lo, hi, ks[i]);
+                lo = ks[i] + 1;
+            }
+            return;
+        }
+        pivot_to_front(a, lo, hi);
+        int j = hoare_partition(a, lo, hi);
+        int split = 0;
+        while (split < nk && ks[split] <= j) split++;
+        // recurse into the side with fewer ranks, loop on the other
+        if (split < nk - split) {
+            multi_select_rec(a, lo, j, ks, split, budget);
+            lo = j + 1;
+            ks += split;
+            nk -= split;
+        } else {
+            multi_select_rec(a, j + 1, hi, ks + split, nk - split, budget);
+            hi = j;
+            nk = split;
+        }
+    }
+}
+
+// After the call a[ks[i]] is the ks[i]-th smallest for every i; out gets the values
+void multi_select(int *a, int n, const int *ks, int nk, int *out) {
+    int *sorted = (int*)malloc(nk * sizeof(int));
+    memcpy(sorted, ks, nk * sizeof(int));
+    insertion_sort_int(sorted, nk);
+    int budget = 4;
+    for (int m = n; m > 1; m >>= 1) budget += 2;
+    multi_select_rec(a, 0, n - 1, sorted, nk, budget);
+    for (int i = 0; i < nk; i++) out[i] = a[ks[i]];
+    free(sorted);
+}
+
+// Smallest k elements, in order, at the front of a
+void partial_sort(int *a, int n, int k) {
+    if (k <= 0) return;
+    if (k < n) introselect(a, n, k - 1);
+    qsort(a, k, sizeof(int), cmp_int);
+}
+
+// ---------------------------------------------------------------------------
+// Sliding-window median over a stream: a max-heap holding the lower
+// window/2 + 1 values and a min-heap with the rest. Heaps store ring slots,
+// and every slot knows its heap position, so the value leaving the window
+// is deleted in O(log w) without searching. The median reported is the
+// element of rank count/2, matching 45's values[count / 2].
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    int window;
+    int *ring;                // value per slot
+    int *lo, *hi;             // slots; lo is a max-heap, hi a min-heap
+    int n_lo, n_hi;
+    int *where;               // slot -> position in lo (>= 0) or ~position in hi
+    long pushed;
+} SlidingMedian;
+
+void sliding_init(SlidingMedian *s, int window) {
+    s->window = window;
+    s->ring = (int*)malloc(window * sizeof(int));
+    s->lo = (int*)malloc(window * sizeof(int));
+    s->hi = (int*)malloc(window * sizeof(int));
+    s->where = (int*)malloc(window * sizeof(int));
+    s->n_lo = s->n_hi = 0;
+    s->pushed = 0;
+}
+
+void sliding_free(SlidingMedian *s) {
+    free(s->ring);
+    free(s->lo);
+    free(s->hi);
+    free(s->where);
+}
+
+// sign = 1 for the max-heap, -1 for the min-heap
+static inline int heap_before(const SlidingMedian *s, int sign, int x, int y) {
+    return sign > 0 ? s->ring[x] > s->ring[y] : s->ring[x] < s->ring[y];
+}
+
+static inline void heap_place(SlidingMedian *s, int *heap, int sign, int pos, int slot) {
+    heap[pos] = slot;
+    s->where[slot] = sign > 0 ? pos : ~pos;
+}
+
+static void heap_fix(SlidingMedian *s, int *heap, int n, int sign, int pos) {
+    int slot = heap[pos];
+    while (pos > 0 && heap_before(s, sign, slot, heap[(pos - 1) / 2])) {
+        heap_place(s, heap, sign, pos, heap[(pos - 1) / 2]);
+        pos = (pos - 1) / 2;
+    }
+    for (;;) {
+        int c = 2 * pos + 1;
+        if (c >= n) break;
+        if (c + 1 < n && heap_before(s, sign, heap[c + 1], heap[c])) c++;
+        if (!heap_before(s, sign, heap[c], slot)) break;
+        heap_place(s, heap, sign, pos, heap[c]);
+        pos = c;
+    }
+    heap_place(s, heap, sign, pos, slot);
+}
+
+static void heap_push(SlidingMedian *s, int *heap, int *n, int sign, int slot) {
+    heap_place(s, heap, sign, (*n)++, slot);
+    heap_fix(s, heap, *n, sign, *n - 1);
+}
+
+static int heap_remove(SlidingMedian *s, int *heap, int *n, int sign, int pos) {
+    int slot = heap[pos];
+    if (pos != --*n) {
+        heap_place(s, heap, sign, pos, heap[*n]);
+        heap_fix(s, heap, *n, sign, pos);
+    }
+    return slot;
+}
+
+static void sliding_rebalance(SlidingMedian *s) {
+    int target = (s->n_lo + s->n_hi) / 2 + 1;
+    while (s->n_lo > target) heap_push(s, s->hi, &s->n_hi, -1, heap_remove(s, s->lo, &s->n_lo, 1, 0));
+    while (s->n_lo < target && s->n_hi > 0) heap_push(s, s->lo, &s->n_lo, 1, heap_remove(s, s->hi, &s->n_hi, -1, 0));
+}
+
+// Adds a value (dropping the oldest once the window is full); returns the median
+int sliding_push(SlidingMedian *s, int value) {
+    int slot = (int)(s->pushed++ % s->window);
+    if (s->pushed > s->window) {
+        int w = s->where[slot];
+        if (w >= 0) heap_remove(s, s->lo, &s->n_lo, 1, w);
+        else heap_remove(s, s->hi, &s->n_hi, -1, ~w);
+    }
+    s->ring[slot] = value;
+    if (s->n_lo == 0 || value <= s->ring[s->lo[0]]) heap_push(s, s->lo, &s->n_lo, 1, slot);
+    else heap_push(s, s->hi, &s->n_hi, -1, slot);
+    sliding_rebalance(s);
+    return s->ring[s->lo[0]];
+}
+
+// ---------------------------------------------------------------------------
+// 2-D median filter with running histograms (Huang). The window's 8-bit
+// values are counted in 256 fine bins plus 16 coarse bins; moving one pixel
+// right removes a column and adds a column (2 * window height updates) and
+// the rank query walks at most 16 coarse and 16 fine bins. Border windows
+// are clipped like 45's, and the rank is count/2 as there.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    unsigned char data[HEIGHT][WIDTH];
+} Image;
+
+static inline int histogram_rank(const int *coarse, const int *fine, int rank) {
+    int c = 0;
+    while (rank >= coarse[c]) rank -= coarse[c++];
+    int v = c << 4;
+    while (rank >= fine[v]) rank -= fine[v++];
+    return v;
+}
+
+void median_filter_huang(const Image *input, Image *output, int window_size) {
+    int half = window_size / 2;
+    for (int y = 0; y < HEIGHT; y++) {
+        int y0 = y - half < 0 ? 0 : y - half, y1 = y + half >= HEIGHT ? HEIGHT - 1 : y + half;
+        int coarse[16] = {0}, fine[256] = {0}, count = 0;
+        for (int x = 0; x <= half && x < WIDTH; x++) {
+            for (int py = y0; py <= y1; py++) {
+                int v = input->data[py][x];
+                fine[v]++;
+                coarse[v >> 4]++;
+            }
+            count += y1 - y0 + 1;
+        }
+        for (int x = 0; x < WIDTH; x++) {
+            if (x > 0) {
+                int out = x - half - 1, in = x + half;
+                if (out >= 0) {
+                    for (int py = y0; py <= y1; py++) {
+                        int v = input->data[py][out];
+                        fine[v]--;
+                        coarse[v >> 4]--;
+                    }
+                    count -= y1 - y0 + 1;
+                }
+                if (in < WIDTH) {
+                    for (int py = y0; py <= y1; py++) {
+                        int v = input->data[py][in];
+                        fine[v]++;
+                        coarse[v >> 4]++;
+                    }
+                    count += y1 - y0 + 1;
+                }
+            }
+            output->data[y][x] = (unsigned char)histogram_rank(coarse, fine, count / 2);
+        }
+    }
+}
+
+// Same window walk, but each window is gathered and handed to introselect
+void median_filter_select(const Image *input, Image *output, int window_size) {
+    int half = window_size / 2;
+    int *window = (int*)malloc(window_size * window_size * sizeof(int));
+    for (int y = 0; y < HEIGHT; y++) {
+        for (int x = 0; x < WIDTH; x++) {
+            int count = 0;
+            for (int py = y - half; py <= y + half; py++) {
+                if (py < 0 || py >= HEIGHT) continue;
+                for (int px = x - half; px <= x + half; px++) {
+                    if (px >= 0 && px < WIDTH) window[count++] = input->data[py][px];
+                }
+            }
+            output->data[y][x] = (unsigned char)introselect(window, count, count / 2);
+        }
+    }
+    free(window);
+}
+
+// ---------------------------------------------------------------------------
+// Reference implementations: median of medians (121) and the
+// sort-per-window median filter (45)
+// ---------------------------------------------------------------------------
+
+void swap(int *a, int *b) {
+    int temp = *a;
+    *a = *b;
+    *b = temp;
+}
+
+void insertion_sort(int arr[], int n) {
+    for (int i = 1; i < n; i++) {
+        int key = arr[i];
+        int j = i - 1;
+        while (j >= 0 && arr[j] > key) {
+            arr[j + 1] = arr[j];
+            j--;
+        }
+        arr[j + 1] = key;
+    }
+}
+
+int partition(int arr[], int left, int right, int pivot) {
+    // Find pivot and move to end
+    for (int i = left; i <= right; i++) {
+        if (arr[i] == pivot) {
+            swap(&arr[i], &arr[right]);
+            break;
+        }
+    }
+
+    int i = left;
+    for (int j = left; j < right; j++) {
+        if (arr[j] < pivot) {
+            swap(&arr[i], &arr[j]);
+            i++;
+        }
+    }
+    swap(&arr[i], &arr[right]);
+    return i;
+}
+
+int select_pivot(int arr[], int left, int right) {
+    if (right - left < 5) {
+        insertion_sort(arr + left, right - left + 1);
+        return arr[left + (right - left) / 2];
+    }
+
+    // Divide into groups of 5
+    int num_medians = 0;
+    for (int i = left; i <= right; i += 5) {
+        int sub_right = (i + 4 <= right) ? i + 4 : right;
+        insertion_sort(arr + i, sub_right - i + 1);
+        swap(&arr[left + num_medians], &arr[i + (sub_right - i) / 2]);
+        num_medians++;
+    }
+
+    // Recursively find median of medians
+    return select_pivot(arr, left, left + num_medians - 1);
+}
+
+int median_of_medians(int arr[], int left, int right, int k) {
+    if (left == right) {
+        return arr[left];
+    }
+
+    int pivot = select_pivot(arr, left, right);
+    int pivot_index = partition(arr, left, right, pivot);
+
+    if (k == pivot_index) {
+        return arr[k];
+    } else if (k < pivot_index) {
+        return median_of_medians(arr, left, pivot_index - 1, k);
+    } else {
+        return median_of_medians(arr, pivot_index + 1, right, k);
+    }
+}
+
+void insertion_sort_uchar(unsigned char *arr, int n) {
+    for (int i = 1; i < n; i++) {
+        unsigned char key = arr[i];
+        int j = i - 1;
+        while (j >= 0 && arr[j] > key) {
+            arr[j + 1] = arr[j];
+            j--;
+        }
+        arr[j + 1] = key;
+    }
+}
+
+unsigned char find_median(unsigned char *values, int count) {
+    insertion_sort_uchar(values, count);
+    return values[count / 2];
+}
+
+void median_filter(Image *input, Image *output, int window_size) {
+    int half = window_size / 2;
+    int max_values = window_size * window_size;
+    unsigned char *window = (unsigned char*)malloc(max_values);
+
+    for (int y = 0; y < HEIGHT; y++) {
+        for (int x = 0; x < WIDTH; x++) {
+            int count = 0;
+
+            for (int wy = -half; wy <= half; wy++) {
+                for (int wx = -half; wx <= half; wx++) {
+                    int py = y + wy;
+                    int px = x + wx;
+
+                    if (py >= 0 && py < HEIGHT && px >= 0 && px < WIDTH) {
+                        window[count++] = input->data[py][px];
+                    }
+                }
+            }
+
+            output->data[y][x] = find_median(window, count);
+        }
+    }
+
+    free(window);
+}
+
+// ---------------------------------------------------------------------------
+// Inputs
+// ---------------------------------------------------------------------------
+
+enum { DIST_UNIFORM, DIST_FEW, DIST_SORTED, DIST_ORGAN, NUM_DISTS };
+
+static const char *dist_names[NUM_DISTS] = {"uniform", "16 values", "sorted", "organ pipe"};
+
+static unsigned int next_rand(unsigned int *seed) {
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 8;
+}
+
+void generate_array(int *a, int n, int dist, unsigned int seed) {
+    for (int i = 0; i < n; i++) {
+        switch (dist) {
+            case DIST_UNIFORM: a[i] = (int)next_rand(&seed); break;
+            case DIST_FEW: a[i] = next_rand(&seed) % 16; break;
+            case DIST_SORTED: a[i] = i; break;
+            default: a[i] = i < n / 2 ? i : n - i; break;
+        }
+    }
+}
+
+// 45's test image: a gradient with salt-and-pepper noise
+void noisy_image(Image *img, int noise_level, unsigned int seed) {
+    for (int y = 0; y < HEIGHT; y++) {
+        for (int x = 0; x < WIDTH; x++) {
+            img->data[y][x] = (x + y * 2) % 256;
+        }
+    }
+    for (int i = 0; i < noise_level; i++) {
+        int x = next_rand(&seed) % WIDTH;
+        int y = next_rand(&seed) % HEIGHT;
+        img->data[y][x] = (next_rand(&seed) % 2) ? 255 : 0;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Correctness: every selector against qsort on random arrays with
+// duplicates, sliding medians against a sorted window, filters against 45
+// ---------------------------------------------------------------------------
+
+int check_selection(void) {
+    int failures = 0;
+    unsigned int seed = 121;
+    int *a = (int*)malloc(5000 * sizeof(int)), *b = (int*)malloc(5000 * sizeof(int)), *sorted = (int*)malloc(5000 * sizeof(int));
+    for (int t = 0; t < FUZZ_TRIALS; t++) {
+        int n = 1 + next_rand(&seed) % (t % 10 == 0 ? 5000 : 200);
+        int range = 1 + next_rand(&seed) % (t % 3 == 0 ? 4 : 100000);
+        for (int i = 0; i < n; i++) a[i] = next_rand(&seed) % range - range / 2;
+        if (t % 7 == 0) insertion_sort_int(a, n < 300 ? n : 300);
+        memcpy(sorted, a, n * sizeof(int));
+        qsort(sorted, n, sizeof(int), cmp_int);
+        int k = next_rand(&seed) % n;
+        memcpy(b, a, n * sizeof(int));
+        failures += introselect(b, n, k) != sorted[k];
+        memcpy(b, a, n * sizeof(int));
+        failures += floyd_rivest_select(b, n, k) != sorted[k];
+        memcpy(b, a, n * sizeof(int));
+        failures += mom_select_range(b, 0, n - 1, k) != sorted[k];
+        memcpy(b, a, n * sizeof(int));
+        failures += median_of_medians(b, 0, n - 1, k) != sorted[k];
+        int ks[NUM_QUANTILES], got[NUM_QUANTILES];
+        for (int q = 0; q < NUM_QUANTILES; q++) ks[q] = next_rand(&seed) % n;
+        memcpy(b, a, n * sizeof(int));
+        multi_select(b, n, ks, NUM_QUANTILES, got);
+        for (int q = 0; q < NUM_QUANTILES; q++) failures += got[q] != sorted[ks[q]];
+        int pk = next_rand(&seed) % (n + 1);
+        memcpy(b, a, n * sizeof(int));
+        partial_sort(b, n, pk);
+        failures += memcmp(b, sorted, pk * sizeof(int)) != 0;
+    }
+    // sliding medians against sorting each window
+    for (int t = 0; t < 20; t++) {
+        int window = 1 + next_rand(&seed) % 40, n = 500;
+        SlidingMedian s;
+        sliding_init(&s, window);
+        for (int i = 0; i < n; i++) {
+            a[i] = next_rand(&seed) % (t % 2 ? 5 : 1000);
+            int got = sliding_push(&s, a[i]);
+            int lo = i + 1 > window ? i + 1 - window : 0, c = i + 1 - lo;
+            memcpy(b, a + lo, c * sizeof(int));
+            insertion_sort_int(b, c);
+            failures += got != b[c / 2];
+        }
+        sliding_free(&s);
+    }
+    free(a);
+    free(b);
+    free(sorted);
+    return failures;
+}
+
+// ---------------------------------------------------------------------------
+// Benchmarks
+// ---------------------------------------------------------------------------
+
+enum { ALG_MOM_121, ALG_INTROSELECT, ALG_FLOYD_RIVEST, ALG_QSORT, ALG_MULTI, ALG_REPEATED, ALG_PARTIAL, NUM_ALGS };
+
+static const char *alg_names[NUM_ALGS] = {"mom (121)", "introselect", "floyd-rivest", "qsort",
+                                          "9 quantiles", "9 x intro", "partial 1k"};
+
+static double seconds_since(clock_t t0) {
+    return (double)(clock() - t0) / CLOCKS_PER_SEC;
+}
+
+int bench_selection(void) {
+    int failures = 0, n = SELECT_N;
+    int *src = (int*)malloc(n * sizeof(int)), *a = (int*)malloc(n * sizeof(int)), *sorted = (int*)malloc(n * sizeof(int));
+    int ks[NUM_QUANTILES], got[NUM_QUANTILES];
+    for (int q = 0; q < NUM_QUANTILES; q++) ks[q] = (int)((long)n * (q + 1) / (NUM_QUANTILES + 1));
+    printf("Select ms/op (n=%d) ", n);
+    for (int alg = 0; alg < NUM_ALGS; alg++) printf(" %12s", alg_names[alg]);
+    printf("\n");
+    for (int dist = 0; dist < NUM_DISTS; dist++) {
+        generate_array(src, n, dist, 45 + dist);
+        memcpy(sorted, src, n * sizeof(int));
+        qsort(sorted, n, sizeof(int), cmp_int);
+        printf("%-18s", dist_names[dist]);
+        for (int alg = 0; alg < NUM_ALGS; alg++) {
+            // 121's Lomuto partition keeps all duplicates on one side: quadratic here
+            if (alg == ALG_MOM_121 && dist == DIST_FEW) {
+                printf(" %12s", "-");
+                continue;
+            }
+            double t = 0;
+            for (int rep = 0; rep < SELECT_REPS; rep++) {
+                memcpy(a, src, n * sizeof(int));
+                int k = n / 2, v = sorted[k];
+                clock_t t0 = clock();
+                switch (alg) {
+                    case ALG_MOM_121: v = median_of_medians(a, 0, n - 1, k); break;
+                    case ALG_INTROSELECT: v = introselect(a, n, k); break;
+                    case ALG_FLOYD_RIVEST: v = floyd_rivest_select(a, n, k); break;
+                    case ALG_QSORT:
+                        qsort(a, n, sizeof(int), cmp_int);
+                        v = a[k];
+                        break;
+                    case ALG_MULTI:
+                        multi_select(a, n, ks, NUM_QUANTILES, got);
+                        break;
+                    case ALG_REPEATED:
+                        for (int q = 0; q < NUM_QUANTILES; q++) got[q] = introselect(a, n, ks[q]);
+                        break;
+                    default:
+                        partial_sort(a, n, PARTIAL_K);
+                        failures += memcmp(a, sorted, PARTIAL_K * sizeof(int)) != 0;
+                        break;
+                }
+                t += seconds_since(t0);
+                failures += v != sorted[k];
+                if (alg == ALG_MULTI || alg == ALG_REPEATED) {
+                    for (int q = 0; q < NUM_QUANTILES; q++) failures += got[q] != sorted[ks[q]];
+                }
+            }
+            printf(" %12.2f", t * 1000 / SELECT_REPS);
+        }
+        printf("\n");
+    }
+    free(src);
+    free(a);
+    free(sorted);
+    return failures;
+}
+
+int bench_stream(void) {
+    int failures = 0;
+    static const int windows[3] = {9, 99, 999};
+    int *values = (int*)malloc(STREAM_N * sizeof(int)), *medians = (int*)malloc(STREAM_N * sizeof(int));
+    int *buf = (int*)malloc(1000 * sizeof(int));
+    generate_array(values, STREAM_N, DIST_UNIFORM, 7);
+    printf("Sliding median Mvalues/s (n=%d):", STREAM_N);
+    for (int wi = 0; wi < 3; wi++) {
+        int w = windows[wi];
+        SlidingMedian s;
+        sliding_init(&s, w);
+        clock_t t0 = clock();
+        for (int i = 0; i < STREAM_N; i++) medians[i] = sliding_push(&s, values[i]);
+        double t_heap = seconds_since(t0);
+        sliding_free(&s);
+        // introselect on every step-th window only, rate scaled to windows done
+        int step = w > 99 ? 64 : 8, done = 0;
+        t0 = clock();
+        for (int i = 0; i < STREAM_N; i += step) {
+            int lo = i + 1 > w ? i + 1 - w : 0, c = i + 1 - lo;
+            memcpy(buf, values + lo, c * sizeof(int));
+            failures += introselect(buf, c, c / 2) != medians[i];
+            done++;
+        }
+        double t_select = seconds_since(t0);
+        printf("  w=%d heaps %.2f select %.2f", w, STREAM_N / t_heap / 1e6, done / t_select / 1e6);
+    }
+    printf("\n");
+    free(values);
+    free(medians);
+    free(buf);
+    return failures;
+}
+
+#define NUM_WINDOWS 8
+
+static const int filter_windows[NUM_WINDOWS] = {3, 5, 7, 9, 11, 15, 21, 31};
+
+int bench_filters(void) {
+    int failures = 0;
+    Image *input = (Image*)malloc(sizeof(Image)), *ref = (Image*)malloc(sizeof(Image)), *out = (Image*)malloc(sizeof(Image));
+    noisy_image(input, 1000, 42);
+    printf("Median filter Mpixel/s %12s %12s %12s\n", "sort (45)", "introselect", "histogram");
+    for (int wi = 0; wi < NUM_WINDOWS; wi++) {
+        int w = filter_windows[wi];
+        printf("  window %2dx%-2d        ", w, w);
+        double mpix = WIDTH * HEIGHT / 1e6;
+        if (w <= SORT_FILTER_MAX) {
+            clock_t t0 = clock();
+            median_filter(input, ref, w);
+            printf(" %12.2f", mpix / seconds_since(t0));
+        } else {
+            printf(" %12s", "-");
+        }
+        clock_t t0 = clock();
+        median_filter_select(input, out, w);
+        printf(" %12.2f", mpix / seconds_since(t0));
+        if (w > SORT_FILTER_MAX) memcpy(ref, out, sizeof(Image));
+        failures += memcmp(ref, out, sizeof(Image)) != 0;
+        t0 = clock();
+        median_filter_huang(input, out, w);
+        printf(" %12.2f\n", mpix / seconds_since(t0));
+        failures += memcmp(ref, out, sizeof(Image)) != 0;
+    }
+    free(input);
+    free(ref);
+    free(out);
+    return failures;
+}
+
+int main() {
+    clock_t start = clock();
+    int failures = check_selection();
+    failures += bench_selection();
+    failures += bench_stream();
+    failures += bench_filters();
+    clock_t end = clock();
+    printf("Selection: n=%d, %d filter windows, %.6f seconds\n",
+           SELECT_N, NUM_WINDOWS, (double)(end - start) / CLOCKS_PER_SEC);
+    printf("Failures: %d\n", failures);
+    return 0;
+}
@@ -0,0 +1,874 @@
+// Union-find library: path halving with union by rank/size or by index, lock-free CAS linking,
+// connected components on CSR graphs and two-pass block-merged image labeling across workers
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef FULL_SIZE
+#define UF_N (1 << 20)        // elements / vertices; 10^8 needs about 2.5 GB for graph and parents
+#define IMAGE_SIZE 2048       // square image side; 16384 needs about 1.6 GB for image, parents, labels
+#else
+#define UF_N (1 << 17)        // -DFULL_SIZE for 1M elements and a 2048x2048 image
+#define IMAGE_SIZE 768
+#endif
+#define UF_OPS (4 * UF_N)     // random unions + finds in the operation benchmark
+#define AVG_DEGREE 4          // random graph edges per vertex (undirected, stored twice in CSR)
+#define MAX_WORKERS 8         // vertex ranges balanced by edge count, or bands of image rows
+#define CHECK_N 3001          // vertices / image side for the correctness runs (odd, so slices are uneven)
+
+// ---------------------------------------------------------------------------
+// Simulated workers run one after another. Each phase records the time every
+// worker spent; the slowest one is the phase's span, so work / span estimates
+// the speedup real threads would get (memory bandwidth aside). Serial steps
+// count towards both.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    double work, span;
+    double worker[MAX_WORKERS];
+} WorkClock;
+
+static void phase_start(WorkClock *c) {
+    memset(c->worker, 0, sizeof(c->worker));
+}
+
+static void worker_done(WorkClock *c, int w, clock_t t0) {
+    c->worker[w] += (double)(clock() - t0) / CLOCKS_PER_SEC;
+}
+
+static void phase_end(WorkClock *c, int workers) {
+    double slowest = 0;
+    for (int w = 0; w < workers; w++) {
+        c->work += c->worker[w];
+        if (c->worker[w] > slowest) slowest = c->worker[w];
+    }
+    c->span += slowest;
+}
+
+static void serial_done(WorkClock *c, clock_t t0) {
+    double t = (double)(clock() - t0) / CLOCKS_PER_SEC;
+    c->work += t;
+    c->span += t;
+}
+
+static inline int slice_begin(int n, int w, int workers) {
+    return (int)((long long)n * w / workers);
+}
+
+// ---------------------------------------------------------------------------
+// Sequential union-find. find uses path halving: every node on the walk is
+// pointed at its grandparent, which flattens the tree as well as full path
+// compression does in the amortized sense but needs one pass and no stack.
+// Three linking rules: by rank (one byte per element), by size (ints, also
+// answers "how big is my set"), and by index, where the smaller root always
+// wins. Linking by index keeps parent[i] <= i, so every root is the smallest
+// element of its set - the labeling code below relies on that to number
+// components in first-appearance order without a relabel pass.
+// ---------------------------------------------------------------------------
+
+typedef enum { LINK_RANK, LINK_SIZE, LINK_INDEX } LinkRule;
+
+typedef struct {
+    int *parent;
+    int *size;               // LINK_SIZE only
+    unsigned char *rank;     // LINK_RANK only
+    int n;
+    int sets;
+    LinkRule rule;
+} UnionFind;
+
+void uf_init(UnionFind *uf, int n, LinkRule rule) {
+    uf->n = n;
+    uf->sets = n;
+    uf->rule = rule;
+    uf->parent = (int*)malloc(n * sizeof(int));
+    uf->size = rule == LINK_SIZE ? (int*)malloc(n * sizeof(int)) : NULL;
+    uf->rank = rule == LINK_RANK ? (unsigned char*)calloc(n, 1) : NULL;
+    for (int i = 0; i < n; i++) uf->parent[i] = i;
+    if (uf->size) {
+        for (int i = 0; i < n; i++) uf->size[i] = 1;
+    }
+}
+
+void uf_free(UnionFind *uf) {
+    free(uf->parent);
+    free(uf->size);
+    free(uf->rank);
+}
+
+static inline int uf_find(int *parent, int x) {
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
+}
+
+// Returns 1 if x and y were in different sets.
+int uf_union(UnionFind *uf, int x, int y) {
+    int rx = uf_find(uf->parent, x);
+    int ry = uf_find(uf->parent, y);
+    if (rx == ry) return 0;
+    switch (uf->rule) {
+    case LINK_RANK:
+        if (uf->rank[rx] < uf->rank[ry]) {
+            int t = rx; rx = ry; ry = t;
+        } else if (uf->rank[rx] == uf->rank[ry]) {
+            uf->rank[rx]++;
+        }
+        break;
+    case LINK_SIZE:
+        if (uf->size[rx] < uf->size[ry]) {
+            int t = rx; rx = ry; ry = t;
+        }
+        uf->size[rx] += uf->size[ry];
+        break;
+    case LINK_INDEX:
+        if (rx > ry) {
+            int t = rx; rx = ry; ry = t;
+        }
+        break;
+    }
+    uf->parent[ry] = rx;
+    uf->sets--;
+    return 1;
+}
+
+int uf_set_size(UnionFind *uf, int x) {
+    return uf->size ? uf->size[uf_find(uf->parent, x)] : 0;
+}
+
+// ---------------------------------------------------------------------------
+// Lock-free union-find for concurrent use, after Anderson and Woll. A root
+// is linked by compare-and-swap on its own parent slot from "itself" to the
+// other root, so two workers can never both link the same root; if the CAS
+// fails, someone else linked it first and the union retries from the new
+// roots. Linking is by index (larger root under smaller), which gives a
+// total order and rules out cycles without ranks that would need a second
+// atomic word. Path halving is a plain store: it only ever replaces a
+// parent with one of its ancestors, so a stale write costs compression but
+// never correctness. Here the workers are simulated, but the code is the
+// one real threads would run.
+// ---------------------------------------------------------------------------
+
+static inline int cuf_find(int *parent, int x) {
+    for (;;) {
+        int p = parent[x];
+        if (p == x) return x;
+        int gp = parent[p];
+        if (gp != p) *(volatile int *)&parent[x] = gp;
+        x = gp;
+    }
+}
+
+// Returns 1 if this call merged two sets.
+static inline int cuf_union(int *parent, int x, int y) {
+    for (;;) {
+        x = cuf_find(parent, x);
+        y = cuf_find(parent, y);
+        if (x == y) return 0;
+        if (x < y) {
+            int t = x; x = y; y = t;
+        }
+        if (__sync_bool_compare_and_swap(&parent[x], x, y)) return 1;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// 85_disjoint_set.c: recursive path compression and union by rank (the
+// sequential baseline that the others are measured against).
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    int *parent;
+    int *rank;
+    int n;
+} DisjointSet;
+
+DisjointSet* create_disjoint_set(int n) {
+    DisjointSet *ds = (DisjointSet*)malloc(sizeof(DisjointSet));
+    ds->n = n;
+    ds->parent = (int*)malloc(n * sizeof(int));
+    ds->rank = (int*)malloc(n * sizeof(int));
+
+    for (int i = 0; i < n; i++) {
+        ds->parent[i] = i;
+        ds->rank[i] = 0;
+    }
+
+    return ds;
+}
+
+int find(DisjointSet *ds, int x) {
+    if (ds->parent[x] != x) {
+        ds->parent[x] = find(ds, ds->parent[x]);  // Path compression
+    }
+    return ds->parent[x];
+}
+
+void union_sets(DisjointSet *ds, int x, int y) {
+    int root_x = find(ds, x);
+    int root_y = find(ds, y);
+
+    if (root_x == root_y) return;
+
+    // Union by rank
+    if (ds->rank[root_x] < ds->rank[root_y]) {
+        ds->parent[root_x] = root_y;
+    } else if (ds->rank[root_x] > ds->rank[root_y]) {
+        ds->parent[root_y] = root_x;
+    } else {
+        ds->parent[root_y] = root_x;
+        ds->rank[root_x]++;
+    }
+}
+
+void free_disjoint_set(DisjointSet *ds) {
+    free(ds->parent);
+    free(ds->rank);
+    free(ds);
+}
+
+// ---------------------------------------------------------------------------
+// Connected components on a CSR graph. Each worker takes a vertex slice and
+// unions every vertex with its neighbours. Each undirected edge is stored
+// twice, so one copy is skipped: the lower endpoint owns it when the two
+// numbers have equal parity, the higher one otherwise. Owning it always at
+// the lower endpoint would hand early slices three quarters of the unions
+// on a random graph. A second phase points
+// every vertex straight at its root, so comp[v] is the smallest vertex of
+// v's component. Slices are balanced by edge count, not vertex count: the
+// boundaries are found by binary search on the CSR offsets, so one hub with
+// a huge adjacency list does not serialize a worker.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    int n;
+    long long m;             // directed edge slots (2 x undirected edges)
+    long long *offset;       // n + 1
+    int *adj;
+} CsrGraph;
+
+void csr_free(CsrGraph *g) {
+    free(g->offset);
+    free(g->adj);
+}
+
+static int edge_slice_begin(const CsrGraph *g, int w, int workers) {
+    long long target = g->m * w / workers;
+    int lo = 0, hi = g->n;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (g->offset[mid] < target) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+// comp must hold n ints; returns the number of components.
+int graph_components(const CsrGraph *g, int *comp, int workers, WorkClock *clk) {
+    int bound[MAX_WORKERS + 1];
+    memset(clk, 0, sizeof(*clk));
+    for (int w = 0; w <= workers; w++) bound[w] = w == workers ? g->n : edge_slice_begin(g, w, workers);
+
+    phase_start(clk);
+    for (int w = 0; w < workers; w++) {
+        clock_t t0 = clock();
+        for (int v = slice_begin(g->n, w, workers); v < slice_begin(g->n, w + 1, workers); v++) comp[v] = v;
+        worker_done(clk, w, t0);
+    }
+    phase_end(clk, workers);
+
+    phase_start(clk);
+    for (int w = 0; w < workers; w++) {
+        clock_t t0 = clock();
+        for (int v = bound[w]; v < bound[w + 1]; v++) {
+            for (long long e = g->offset[v]; e < g->offset[v + 1]; e++) {
+                int u = g->adj[e];
+                if ((u < v) == ((u ^ v) & 1) && u != v) cuf_union(comp, v, u);
+            }
+        }
+        worker_done(clk, w, t0);
+    }
+    phase_end(clk, workers);
+
+    int counts[MAX_WORKERS];
+    phase_start(clk);
+    for (int w = 0; w < workers; w++) {
+        clock_t t0 = clock();
+        int roots = 0;
+        for (int v = slice_begin(g->n, w, workers); v < slice_begin(g->n, w + 1, workers); v++) {
+            comp[v] = cuf_find(comp, v);
+            roots += comp[v] == v;
+        }
+        counts[w] = roots;
+        worker_done(clk, w, t0);
+    }
+    phase_end(clk, workers);
+
+    int total = 0;
+    for (int w = 0; w < workers; w++) total += counts[w];
+    return total;
+}
+
+// Breadth-first reference: labels every vertex with the smallest vertex of
+// its component, like graph_components.
+int graph_components_bfs(const CsrGraph *g, int *comp) {
+    int *queue = (int*)malloc(g->n * sizeof(int));
+    int count = 0;
+    for (int v = 0; v < g->n; v++) comp[v] = -1;
+    for (int s = 0; s < g->n; s++) {
+        if (comp[s] >= 0) continue;
+        int head = 0, tail = 0;
+        queue[tail++] = s;
+        comp[s] = s;
+        while (head < tail) {
+            int v = queue[head++];
+            for (long long e = g->offset[v]; e < g->offset[v + 1]; e++) {
+                int u = g->adj[e];
+                if (comp[u] < 0) {
+                    comp[u] = s;
+                    queue[tail++] = u;
+                }
+            }
+        }
+        count++;
+    }
+    free(queue);
+    return count;
+}
+
+// ---------------------------------------------------------------------------
+// Two-pass binary image labeling, 4-connectivity as in 159. The image is cut
+// into horizontal strips, one per worker.
+//
+// Pass 1 (per strip): a raster scan where each foreground pixel points at
+// its upper neighbour if that is foreground, else its left one, else itself;
+// when both are foreground and the upper-left pixel is not (otherwise they
+// are already joined) the two sets are united. Every link goes to a smaller
+// index, so parent[i] <= i throughout and roots are first pixels in raster
+// order. The top row of a strip does not look upwards.
+//
+// Merge: the top row of every strip is united with the bottom row of the
+// strip above using the CAS union, one boundary per worker.
+//
+// Pass 2 (per strip): each worker counts roots in its strip; a serial prefix
+// over the counts gives every strip its first label, then each worker gives
+// its roots consecutive labels in raster order and resolves every other
+// pixel through its root. Roots are first pixels and strips are in raster
+// order, so the labels are exactly those of 159's single-threaded scan.
+// ---------------------------------------------------------------------------
+
+int label_image(const unsigned char *img, int *parent, int *labels, int width, int height,
+                int workers, WorkClock *clk) {
+    int counts[MAX_WORKERS];
+    memset(clk, 0, sizeof(*clk));
+    if (workers > height) workers = height;
+
+    phase_start(clk);
+    for (int w = 0; w < workers; w++) {
+        clock_t t0 = clock();
+        int y0 = slice_begin(height, w, workers), y1 = slice_begin(height, w + 1, workers);
+        for (int y = y0; y < y1; y++) {
+            const unsigned char *row = img + (size_t)y * width;
+            int *par = parent + (size_t)y * width;
+            int base = y * width;
+            for (int x = 0; x < width; x++) {
+                int idx = base + x;
+                if (!row[x]) {
+                    par[x] = -1;
+                    continue;
+                }
+                int up = y > y0 && row[x - width];
+                int left = x > 0 && row[x - 1];
+                if (up) {
+                    par[x] = idx - width;
+                    if (left && !row[x - width - 1]) {
+                        int a = uf_find(parent, idx - width), b = uf_find(parent, idx - 1);
+                        if (a < b) parent[b] = a;
+                        else if (b < a) parent[a] = b;
+                    }
+                } else {
+                    par[x] = left ? idx - 1 : idx;
+                }
+            }
+        }
+        worker_done(clk, w, t0);
+    }
+    phase_end(clk, workers);
+
+    phase_start(clk);
+    for (int w = 1; w < workers; w++) {
+        clock_t t0 = clock();
+        int y = slice_begin(height, w, workers);
+        const unsigned char *row = img + (size_t)y * width;
+        int base = y * width;
+        for (int x = 0; x < width; x++) {
+            // a run touching the boundary only needs one union per run above
+            if (row[x] && row[x - width] && !(x > 0 && row[x - 1] && row[x - width - 1])) {
+                cuf_union(parent, base + x, base + x - width);
+            }
+        }
+        worker_done(clk, w, t0);
+    }
+    phase_end(clk, workers);
+
+    phase_start(clk);
+    for (int w = 0; w < workers; w++) {
+        clock_t t0 = clock();
+        int roots = 0;
+        size_t lo = (size_t)slice_begin(height, w, workers) * width;
+        size_t hi = (size_t)slice_begin(height, w + 1, workers) * width;
+        for (size_t i = lo; i < hi; i++) roots += parent[i] == (int)i;
+        counts[w] = roots;
+        worker_done(clk, w, t0);
+    }
+    phase_end(clk, workers);
+
+    clock_t t0 = clock();
+    int total = 0;
+    for (int w = 0; w < workers; w++) {
+        int c = counts[w];
+        counts[w] = total;
+        total += c;
+    }
+    serial_done(clk, t0);
+
+    // Roots are labeled in one phase and everything else reads its root's
+    // label in the next: the root may sit in an earlier strip, so real
+    // threads need the barrier between the two.
+    phase_start(clk);
+    for (int w = 0; w < workers; w++) {
+        clock_t t1 = clock();
+        int next = counts[w];
+        size_t lo = (size_t)slice_begin(height, w, workers) * width;
+        size_t hi = (size_t)slice_begin(height, w + 1, workers) * width;
+        for (size_t i = lo; i < hi; i++) {
+            if (parent[i] == (int)i) labels[i] = ++next;
+        }
+        worker_done(clk, w, t1);
+    }
+    phase_end(clk, workers);
+
+    phase_start(clk);
+    for (int w = 0; w < workers; w++) {
+        clock_t t1 = clock();
+        size_t lo = (size_t)slice_begin(height, w, workers) * width;
+        size_t hi = (size_t)slice_begin(height, w + 1, workers) * width;
+        for (size_t i = lo; i < hi; i++) {
+            int p = parent[i];
+            if (p < 0) labels[i] = 0;
+            else if (p != (int)i) labels[i] = labels[cuf_find(parent, p)];
+        }
+        worker_done(clk, w, t1);
+    }
+    phase_end(clk, workers);
+    return total;
+}
+
+// ---------------------------------------------------------------------------
+// 159_connected_components.c (its union-find renamed so it can sit next to
+// 85's): the single-threaded reference for image labels.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    int parent;
+    int rank;
+} PixelSet;
+
+int find_pixel(PixelSet *ds, int x) {
+    if (ds[x].parent != x) {
+        ds[x].parent = find_pixel(ds, ds[x].parent);
+    }
+    return ds[x].parent;
+}
+
+void union_pixels(PixelSet *ds, int x, int y) {
+    int root_x = find_pixel(ds, x);
+    int root_y = find_pixel(ds, y);
+
+    if (root_x != root_y) {
+        if (ds[root_x].rank < ds[root_y].rank) {
+            ds[root_x].parent = root_y;
+        } else if (ds[root_x].rank > ds[root_y].rank) {
+            ds[root_y].parent = root_x;
+        } else {
+            ds[root_y].parent = root_x;
+            ds[root_x].rank++;
+        }
+    }
+}
+
+int connected_components(unsigned char *binary, int *labels, int width, int height) {
+    int num_pixels = width * height;
+    PixelSet *ds = (PixelSet*)malloc(num_pixels * sizeof(PixelSet));
+
+    for (int i = 0; i < num_pixels; i++) {
+        ds[i].parent = i;
+        ds[i].rank = 0;
+        labels[i] = 0;
+    }
+
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            int idx = y * width + x;
+
+            if (binary[idx]) {
+                if (x > 0 && binary[idx - 1]) {
+                    union_pixels(ds, idx, idx - 1);
+                }
+
+                if (y > 0 && binary[idx - width]) {
+                    union_pixels(ds, idx, idx - width);
+                }
+            }
+        }
+    }
+
+    int num_components = 0;
+    int *component_map = (int*)calloc(num_pixels, sizeof(int));
+
+    for (int i = 0; i < num_pixels; i++) {
+        if (binary[i]) {
+            int root = find_pixel(ds, i);
+            if (component_map[root] == 0) {
+                component_map[root] = ++num_components;
+            }
+            labels[i] = component_map[root];
+        }
+    }
+
+    free(ds);
+    free(component_map);
+
+    return num_components;
+}
+
+// ---------------------------------------------------------------------------
+// Inputs. Graphs: a random graph with AVG_DEGREE edges per vertex (one giant
+// component plus isolated bits) and a "chains" graph of many short paths
+// whose vertex numbers are scattered, so unions walk far apart in memory.
+// Images: 159's noise at two densities - 50% gives many small blobs, 70% is
+// past the percolation threshold, so one component crosses every strip.
+// ---------------------------------------------------------------------------
+
+enum { GRAPH_RANDOM, GRAPH_CHAINS, NUM_GRAPHS };
+static const char *graph_names[NUM_GRAPHS] = {"random", "chains"};
+
+// The LCG's low bits have short periods (its bit 1 alternates with period 4,
+// which made every vertex pick even), so only the top 16 bits are used.
+static unsigned int next_rand(unsigned int *seed) {
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 16;
+}
+
+static unsigned int rand_below(unsigned int *seed, unsigned int n) {
+    return (unsigned int)(((unsigned long long)next_rand(seed) << 16 | next_rand(seed)) % n);
+}
+
+// Edge list of n * AVG_DEGREE / 2 undirected edges.
+static long long make_edges(int kind, int n, int **src, int **dst, unsigned int seed) {
+    long long m = (long long)n * AVG_DEGREE / 2;
+    *src = (int*)malloc(m * sizeof(int));
+    *dst = (int*)malloc(m * sizeof(int));
+    if (kind == GRAPH_RANDOM) {
+        for (long long e = 0; e < m; e++) {
+            (*src)[e] = rand_below(&seed, n);
+            (*dst)[e] = rand_below(&seed, n);
+        }
+        return m;
+    }
+    int *perm = (int*)malloc(n * sizeof(int));
+    for (int i = 0; i < n; i++) perm[i] = i;
+    for (int i = n - 1; i > 0; i--) {
+        int j = rand_below(&seed, i + 1);
+        int t = perm[i]; perm[i] = perm[j]; perm[j] = t;
+    }
+    long long e = 0;
+    for (int i = 1; i < n && e < m; i++) {
+        if (rand_below(&seed, 64) == 0) continue; // chain break
+        (*src)[e] = perm[i - 1];
+        (*dst)[e] = perm[i];
+        e++;
+    }
+    free(perm);
+    return e;
+}
+
+static void build_csr(CsrGraph *g, int n, const int *src, const int *dst, long long m) {
+    g->n = n;
+    g->m = 2 * m;
+    g->offset = (long long*)calloc(n + 1, sizeof(long long));
+    g->adj = (int*)malloc(g->m * sizeof(int));
+    for (long long e = 0; e < m; e++) {
+        g->offset[src[e] + 1]++;
+        g->offset[dst[e] + 1]++;
+    }
+    for (int v = 0; v < n; v++) g->offset[v + 1] += g->offset[v];
+    long long *fill = (long long*)malloc(n * sizeof(long long));
+    memcpy(fill, g->offset, n * sizeof(long long));
+    for (long long e = 0; e < m; e++) {
+        g->adj[fill[src[e]]++] = dst[e];
+        g->adj[fill[dst[e]]++] = src[e];
+    }
+    free(fill);
+}
+
+static void make_image(unsigned char *img, int width, int height, int percent, unsigned int seed) {
+    int cut = 256 * percent / 100;
+    for (size_t i = 0; i < (size_t)width * height; i++) {
+        seed = seed * 1103515245 + 12345;
+        img[i] = (int)((seed >> 16) & 0xFF) < cut;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Correctness: every union-find variant on the same random edge list must
+// agree on the set count and put both ends of every edge in one set; graph
+// components must match BFS labels exactly (both are "smallest vertex");
+// image labels must match 159 exactly, across worker counts and strip
+// boundaries that fall on awkward rows.
+// ---------------------------------------------------------------------------
+
+static int check_union_find(void) {
+    int failures = 0;
+    int n = CHECK_N;
+    for (int kind = 0; kind < NUM_GRAPHS; kind++) {
+        int *src, *dst;
+        long long m = make_edges(kind, n, &src, &dst, 11 + kind);
+        DisjointSet *ds = create_disjoint_set(n);
+        for (long long e = 0; e < m; e++) union_sets(ds, src[e], dst[e]);
+        int expect = 0;
+        for (int i = 0; i < n; i++) expect += find(ds, i) == i;
+
+        for (int rule = LINK_RANK; rule <= LINK_INDEX; rule++) {
+            UnionFind uf;
+            uf_init(&uf, n, (LinkRule)rule);
+            for (long long e = 0; e < m; e++) uf_union(&uf, src[e], dst[e]);
+            if (uf.sets != expect) failures++;
+            for (long long e = 0; e < m; e++) {
+                if (uf_find(uf.parent, src[e]) != uf_find(uf.parent, dst[e])) {
+                    failures++;
+                    break;
+                }
+            }
+            if (rule == LINK_SIZE) {
+                long long total = 0;
+                for (int i = 0; i < n; i++) {
+                    if (uf.parent[i] == i) total += uf_set_size(&uf, i);
+                }
+                if (total != n) failures++;
+            }
+            uf_free(&uf);
+        }
+
+        // interleave the workers' unions round-robin so links race with
+        // half-finished paths the way they would under real threads
+        int *par = (int*)malloc(n * sizeof(int));
+        for (int i = 0; i < n; i++) par[i] = i;
+        int merged = 0;
+        long long quarter = (m + 3) / 4;
+        for (long long i = 0; i < quarter; i++) {
+            for (int w = 0; w < 4; w++) {
+                long long k = w * quarter + i;
+                if (k < m) merged += cuf_union(par, src[k], dst[k]);
+            }
+        }
+        if (n - merged != expect) failures++;
+
+        CsrGraph g;
+        build_csr(&g, n, src, dst, m);
+        int *comp = (int*)malloc(n * sizeof(int));
+        int *ref = (int*)malloc(n * sizeof(int));
+        int ref_count = graph_components_bfs(&g, ref);
+        if (ref_count != expect) failures++;
+        for (int workers = 1; workers <= MAX_WORKERS; workers++) {
+            WorkClock clk;
+            if (graph_components(&g, comp, workers, &clk) != ref_count) failures++;
+            if (memcmp(comp, ref, n * sizeof(int)) != 0) failures++;
+        }
+        free(comp);
+        free(ref);
+        free(par);
+        csr_free(&g);
+        free_disjoint_set(ds);
+        free(src);
+        free(dst);
+    }
+
+    int sides[3][2] = {{CHECK_N / 10, CHECK_N / 10}, {1, 37}, {53, 5}};
+    for (int s = 0; s < 3; s++) {
+        int width = sides[s][0], height = sides[s][1];
+        size_t px = (size_t)width * height;
+        unsigned char *img = (unsigned char*)malloc(px);
+        int *ref = (int*)malloc(px * sizeof(int));
+        int *labels = (int*)malloc(px * sizeof(int));
+        int *parent = (int*)malloc(px * sizeof(int));
+        for (int percent = 30; percent <= 90; percent += 20) {
+            make_image(img, width, height, percent, 5 + percent);
+            int expect = connected_components(img, ref, width, height);
+            for (int workers = 1; workers <= MAX_WORKERS; workers++) {
+                WorkClock clk;
+                if (label_image(img, parent, labels, width, height, workers, &clk) != expect) failures++;
+                if (memcmp(labels, ref, px * sizeof(int)) != 0) failures++;
+            }
+        }
+        free(img);
+        free(ref);
+        free(labels);
+        free(parent);
+    }
+    return failures;
+}
+
+// ---------------------------------------------------------------------------
+// Benchmark: union-find operation mix (85's rules against path halving with
+// each linking rule), graph components against BFS, image labeling against
+// 159, the parallel engines at 1-8 workers.
+// ---------------------------------------------------------------------------
+
+#define NUM_WORKER_COUNTS 4
+static const int bench_workers[NUM_WORKER_COUNTS] = {1, 2, 4, 8};
+
+static double seconds_since(clock_t t0) {
+    return (double)(clock() - t0) / CLOCKS_PER_SEC;
+}
+
+static void bench_operations(int n, int *failures) {
+    static const char *rule_names[3] = {"rank", "size", "index"};
+    int *xs = (int*)malloc(UF_OPS * sizeof(int));
+    int *ys = (int*)malloc(UF_OPS * sizeof(int));
+    unsigned int seed = 3;
+    for (int i = 0; i < UF_OPS; i++) {
+        xs[i] = rand_below(&seed, n);
+        ys[i] = rand_below(&seed, n);
+    }
+    // even ops union, odd ops ask "connected?"
+    printf("Union-find, %d elements, %d mixed ops (Mops/s):\n", n, UF_OPS);
+    DisjointSet *ds = create_disjoint_set(n);
+    int expect = 0;
+    clock_t t0 = clock();
+    for (int i = 0; i < UF_OPS; i += 2) {
+        union_sets(ds, xs[i], ys[i]);
+        expect += find(ds, xs[i + 1]) == find(ds, ys[i + 1]);
+    }
+    printf("  %-26s %7.1f\n", "85 compression + rank", UF_OPS / seconds_since(t0) / 1e6);
+    free_disjoint_set(ds);
+
+    for (int rule = LINK_RANK; rule <= LINK_INDEX; rule++) {
+        UnionFind uf;
+        uf_init(&uf, n, (LinkRule)rule);
+        int connected = 0;
+        t0 = clock();
+        for (int i = 0; i < UF_OPS; i += 2) {
+            uf_union(&uf, xs[i], ys[i]);
+            connected += uf_find(uf.parent, xs[i + 1]) == uf_find(uf.parent, ys[i + 1]);
+        }
+        char name[40];
+        snprintf(name, sizeof(name), "halving + %s", rule_names[rule]);
+        printf("  %-26s %7.1f\n", name, UF_OPS / seconds_since(t0) / 1e6);
+        if (connected != expect) (*failures)++;
+        uf_free(&uf);
+    }
+
+    int *par = (int*)malloc(n * sizeof(int));
+    for (int i = 0; i < n; i++) par[i] = i;
+    int connected = 0;
+    t0 = clock();
+    for (int i = 0; i < UF_OPS; i += 2) {
+        cuf_union(par, xs[i], ys[i]);
+        connected += cuf_find(par, xs[i + 1]) == cuf_find(par, ys[i + 1]);
+    }
+    printf("  %-26s %7.1f\n", "CAS link (1 worker)", UF_OPS / seconds_since(t0) / 1e6);
+    if (connected != expect) (*failures)++;
+    free(par);
+    free(xs);
+    free(ys);
+}
+
+static void bench_graphs(int n, int *failures) {
+    int *comp = (int*)malloc(n * sizeof(int));
+    int *ref = (int*)malloc(n * sizeof(int));
+    printf("Graph components, %d vertices (Medges/s; workers count the slowest slice of each phase, xN = all slices / slowest):\n", n);
+    printf("  %-8s %9s %9s", "graph", "BFS", "85 DSU");
+    for (int wi = 0; wi < NUM_WORKER_COUNTS; wi++) printf("    workers=%d", bench_workers[wi]);
+    printf("   components\n");
+    for (int kind = 0; kind < NUM_GRAPHS; kind++) {
+        int *src, *dst;
+        long long m = make_edges(kind, n, &src, &dst, 21 + kind);
+        CsrGraph g;
+        build_csr(&g, n, src, dst, m);
+
+        clock_t t0 = clock();
+        int expect = graph_components_bfs(&g, ref);
+        double bfs = seconds_since(t0);
+        DisjointSet *ds = create_disjoint_set(n);
+        t0 = clock();
+        for (long long e = 0; e < m; e++) union_sets(ds, src[e], dst[e]);
+        double dsu = seconds_since(t0);
+        free_disjoint_set(ds);
+        printf("  %-8s %9.1f %9.1f", graph_names[kind], m / bfs / 1e6, m / dsu / 1e6);
+
+        for (int wi = 0; wi < NUM_WORKER_COUNTS; wi++) {
+            WorkClock clk;
+            int count = graph_components(&g, comp, bench_workers[wi], &clk);
+            if (count != expect || memcmp(comp, ref, n * sizeof(int)) != 0) (*failures)++;
+            printf(" %7.1f x%-4.1f", clk.span > 0 ? m / clk.span / 1e6 : 0.0,
+                   clk.span > 0 ? clk.work / clk.span : 0.0);
+        }
+        printf("   %d\n", expect);
+        csr_free(&g);
+        free(src);
+        free(dst);
+    }
+    free(comp);
+    free(ref);
+}
+
+static void bench_images(int side, int *failures) {
+    size_t px = (size_t)side * side;
+    unsigned char *img = (unsigned char*)malloc(px);
+    int *ref = (int*)malloc(px * sizeof(int));
+    int *labels = (int*)malloc(px * sizeof(int));
+    int *parent = (int*)malloc(px * sizeof(int));
+    memset(labels, 0, px * sizeof(int)); // fault the pages in before the first timed run
+    memset(parent, 0, px * sizeof(int));
+    printf("Image labeling, %dx%d (Mpixels/s):\n", side, side);
+    printf("  %-8s %9s", "density", "159");
+    for (int wi = 0; wi < NUM_WORKER_COUNTS; wi++) printf("    workers=%d", bench_workers[wi]);
+    printf("   components\n");
+    for (int percent = 50; percent <= 70; percent += 20) {
+        make_image(img, side, side, percent, 42 + percent);
+        clock_t t0 = clock();
+        int expect = connected_components(img, ref, side, side);
+        printf("  %6d%%  %9.1f", percent, px / seconds_since(t0) / 1e6);
+        for (int wi = 0; wi < NUM_WORKER_COUNTS; wi++) {
+            WorkClock clk;
+            int count = label_image(img, parent, labels, side, side, bench_workers[wi], &clk);
+            if (count != expect || memcmp(labels, ref, px * sizeof(int)) != 0) (*failures)++;
+            printf(" %7.1f x%-4.1f", clk.span > 0 ? px / clk.span / 1e6 : 0.0,
+                   clk.span > 0 ? clk.work / clk.span : 0.0);
+        }
+        printf("   %d\n", expect);
+    }
+    free(img);
+    free(ref);
+    free(labels);
+    free(parent);
+}
+
+int main() {
+    clock_t start = clock();
+    int failures = check_union_find();
+
+    bench_operations(UF_N, &failures);
+    bench_graphs(UF_N, &failures);
+    bench_images(IMAGE_SIZE, &failures);
+
+    clock_t end = clock();
+    printf("Union-find library: %d elements, %dx%d image, %.6f seconds\n",
+           UF_N, IMAGE_SIZE, IMAGE_SIZE, (double)(end - start) / CLOCKS_PER_SEC);
+    printf("Failures: %d\n", failures);
+    return 0;
+}
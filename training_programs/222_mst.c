@@ -0,0 +1,1010 @@
+// Minimum spanning forest library: filter-Kruskal, Boruvka on CSR with edge contraction across
+// workers, Prim over an indexed heap; geometric and power-law graphs, totals cross-checked
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+#include <time.h>
+
+#ifdef FULL_SIZE
+#define MST_EDGES (1 << 20)   // edges per benchmark graph; 10^8 needs about 6 GB for edges, CSR and cursors
+#else
+#define MST_EDGES (1 << 16)   // -DFULL_SIZE for 1M edges per graph
+#endif
+#define GEO_DEGREE 8          // expected neighbours per point in the geometric graph
+#define PL_ATTACH 4           // edges each new power-law vertex attaches with
+#define FK_BASE 2048          // filter-Kruskal sorts and scans ranges at most this long
+#define MAX_WORKERS 8         // Boruvka gives each worker a vertex range and an edge range every round
+#define DENSE_V 2000          // vertices of 22's adjacency matrix
+#define CHECK_V 1501          // vertices per correctness graph (odd, so slices are uneven)
+
+// ---------------------------------------------------------------------------
+// Simulated workers run one after another. Each phase records the time every
+// worker spent; the slowest one is the phase's span, so work / span estimates
+// the speedup real threads would get (memory bandwidth aside). Serial steps
+// count towards both.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    double work, span;
+    double worker[MAX_WORKERS];
+} WorkClock;
+
+static void phase_start(WorkClock *c) {
+    memset(c->worker, 0, sizeof(c->worker));
+}
+
+static void worker_done(WorkClock *c, int w, clock_t t0) {
+    c->worker[w] += (double)(clock() - t0) / CLOCKS_PER_SEC;
+}
+
+static void phase_end(WorkClock *c, int workers) {
+    double slowest = 0;
+    for (int w = 0; w < workers; w++) {
+        c->work += c->worker[w];
+        if (c->worker[w] > slowest) slowest = c->worker[w];
+    }
+    c->span += slowest;
+}
+
+static void serial_done(WorkClock *c, clock_t t0) {
+    double t = (double)(clock() - t0) / CLOCKS_PER_SEC;
+    c->work += t;
+    c->span += t;
+}
+
+static inline int slice_begin(int n, int w, int workers) {
+    return (int)((long long)n * w / workers);
+}
+
+// ---------------------------------------------------------------------------
+// Graphs are 21's edge lists. Every engine returns a spanning forest: its
+// total weight and edge count, which any two correct engines agree on even
+// when weights tie.
+// ---------------------------------------------------------------------------
+
+typedef struct Edge {
+    int src, dest, weight;
+} Edge;
+
+typedef struct Graph {
+    int V, E;
+    Edge* edge;
+} Graph;
+
+typedef struct {
+    long long weight;
+    int edges;
+} Forest;
+
+Graph* createGraph(int V, int E) {
+    Graph* graph = (Graph*)malloc(sizeof(Graph));
+    graph->V = V;
+    graph->E = E;
+    graph->edge = (Edge*)malloc(E * sizeof(Edge));
+    return graph;
+}
+
+void free_graph(Graph *graph) {
+    free(graph->edge);
+    free(graph);
+}
+
+// Path-halving union-find, linked by size (221).
+typedef struct {
+    int *parent;
+    int *size;
+} UnionFind;
+
+static void uf_init(UnionFind *uf, int n) {
+    uf->parent = (int*)malloc(n * sizeof(int));
+    uf->size = (int*)malloc(n * sizeof(int));
+    for (int i = 0; i < n; i++) {
+        uf->parent[i] = i;
+        uf->size[i] = 1;
+    }
+}
+
+static void uf_free(UnionFind *uf) {
+    free(uf->parent);
+    free(uf->size);
+}
+
+static inline int uf_find(int *parent, int x) {
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
+}
+
+static inline int uf_union(UnionFind *uf, int x, int y) {
+    int rx = uf_find(uf->parent, x);
+    int ry = uf_find(uf->parent, y);
+    if (rx == ry) return 0;
+    if (uf->size[rx] < uf->size[ry]) {
+        int t = rx; rx = ry; ry = t;
+    }
+    uf->size[rx] += uf->size[ry];
+    uf->parent[ry] = rx;
+    return 1;
+}
+
+// Lock-free union by index with CAS linking (221).
+static inline int cuf_find(int *parent, int x) {
+    for (;;) {
+        int p = parent[x];
+        if (p == x) return x;
+        int gp = parent[p];
+        if (gp != p) *(volatile int *)&parent[x] = gp;
+        x = gp;
+    }
+}
+
+static inline int cuf_union(int *parent, int x, int y) {
+    for (;;) {
+        x = cuf_find(parent, x);
+        y = cuf_find(parent, y);
+        if (x == y) return 0;
+        if (x < y) {
+            int t = x; x = y; y = t;
+        }
+        if (__sync_bool_compare_and_swap(&parent[x], x, y)) return 1;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Filter-Kruskal (Osipov, Sanders, Singler). Kruskal only needs the light
+// edges in order until the forest is complete, and most heavy edges end up
+// joining vertices that are already connected. So: split the range around a
+// pivot weight, solve the light part recursively, then drop every heavy edge
+// whose ends are already in one tree before recursing on the rest. Ranges of
+// at most FK_BASE edges are sorted and scanned as in 21. The split is three-
+// way, and edges equal to the pivot are scanned unsorted: with many tied
+// weights a two-way split would not shrink. Reorders the edge array.
+// ---------------------------------------------------------------------------
+
+int compareEdges(const void* a, const void* b) {
+    return ((Edge*)a)->weight - ((Edge*)b)->weight;
+}
+
+typedef struct {
+    UnionFind uf;
+    Forest forest;
+    int target;              // V - 1: a spanning tree ends the search early
+    unsigned int seed;       // pivot sampling
+} FilterState;
+
+static void kruskal_scan(const Edge *e, int n, FilterState *s) {
+    for (int i = 0; i < n && s->forest.edges < s->target; i++) {
+        if (uf_union(&s->uf, e[i].src, e[i].dest)) {
+            s->forest.weight += e[i].weight;
+            s->forest.edges++;
+        }
+    }
+}
+
+static int filter_edges(Edge *e, int n, FilterState *s) {
+    int kept = 0;
+    for (int i = 0; i < n; i++) {
+        if (uf_find(s->uf.parent, e[i].src) != uf_find(s->uf.parent, e[i].dest)) e[kept++] = e[i];
+    }
+    return kept;
+}
+
+static int sample_weight(const Edge *e, int n, FilterState *s) {
+    s->seed = s->seed * 1103515245 + 12345;
+    return e[(s->seed >> 8) % n].weight;
+}
+
+static void filter_kruskal_range(Edge *e, int n, FilterState *s) {
+    if (s->forest.edges >= s->target || n == 0) return;
+    if (n <= FK_BASE) {
+        qsort(e, n, sizeof(Edge), compareEdges);
+        kruskal_scan(e, n, s);
+        return;
+    }
+    int a = sample_weight(e, n, s), b = sample_weight(e, n, s), c = sample_weight(e, n, s);
+    int pivot = a < b ? (b < c ? b : (a < c ? c : a)) : (a < c ? a : (b < c ? c : b));
+
+    // Dutch flag: [0, lt) lighter, [lt, i) equal, (gt, n) heavier
+    int lt = 0, i = 0, gt = n - 1;
+    while (i <= gt) {
+        if (e[i].weight < pivot) {
+            Edge t = e[i]; e[i] = e[lt]; e[lt] = t;
+            lt++;
+            i++;
+        } else if (e[i].weight > pivot) {
+            Edge t = e[i]; e[i] = e[gt]; e[gt] = t;
+            gt--;
+        } else {
+            i++;
+        }
+    }
+    filter_kruskal_range(e, lt, s);
+    kruskal_scan(e + lt, i - lt, s);
+    if (s->forest.edges >= s->target) return;
+    int heavy = filter_edges(e + i, n - i, s);
+    filter_kruskal_range(e + i, heavy, s);
+}
+
+Forest filter_kruskal(Graph *graph) {
+    FilterState s;
+    uf_init(&s.uf, graph->V);
+    s.forest.weight = 0;
+    s.forest.edges = 0;
+    s.target = graph->V - 1;
+    s.seed = 1;
+    filter_kruskal_range(graph->edge, graph->E, &s);
+    uf_free(&s.uf);
+    return s.forest;
+}
+
+// ---------------------------------------------------------------------------
+// CSR over an edge list: the adjacency of v is a run of slots, each carrying
+// the neighbour, the weight and the edge's index, so a scan of v's run never
+// goes back to the edge list; every undirected edge appears under both ends.
+// Built as 219 builds its radix passes: each worker counts the endpoints of
+// its edge slice into a private row, a prefix over (vertex, worker) - split
+// by vertex slices, with a serial prefix over the slice totals - turns the
+// rows into private write cursors, and each worker scatters its own edges.
+// No atomics, and the order within a run is fixed (by worker, then by edge).
+// The rows take workers x V offsets.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    int to, weight, edge;
+} Slot;
+
+typedef struct {
+    int n;
+    long long *offset;       // n + 1
+    Slot *slot;              // 2 x edges
+    long long *fill;         // MAX_WORKERS x n cursors
+} EdgeCsr;
+
+static void csr_alloc(EdgeCsr *g, int n, int m, int workers) {
+    g->offset = (long long*)malloc((n + 1) * sizeof(long long));
+    g->fill = (long long*)malloc(((size_t)workers * n + 1) * sizeof(long long));
+    g->slot = (Slot*)malloc((2 * (size_t)m + 1) * sizeof(Slot));
+}
+
+static void csr_free(EdgeCsr *g) {
+    free(g->offset);
+    free(g->fill);
+    free(g->slot);
+}
+
+static void csr_build(EdgeCsr *g, int n, const Edge *edges, int m, int workers, WorkClock *clk) {
+    long long totals[MAX_WORKERS];
+    g->n = n;
+    phase_start(clk);
+    for (int w = 0; w < workers; w++) {
+        clock_t t0 = clock();
+        long long *row = g->fill + (size_t)w * n;
+        memset(row, 0, n * sizeof(long long));
+        for (int e = slice_begin(m, w, workers); e < slice_begin(m, w + 1, workers); e++) {
+            row[edges[e].src]++;
+            row[edges[e].dest]++;
+        }
+        worker_done(clk, w, t0);
+    }
+    phase_end(clk, workers);
+
+    phase_start(clk);
+    for (int w = 0; w < workers; w++) {
+        clock_t t0 = clock();
+        long long sum = 0;
+        for (int v = slice_begin(n, w, workers); v < slice_begin(n, w + 1, workers); v++) {
+            for (int r = 0; r < workers; r++) sum += g->fill[(size_t)r * n + v];
+        }
+        totals[w] = sum;
+        worker_done(clk, w, t0);
+    }
+    phase_end(clk, workers);
+
+    clock_t t0 = clock();
+    long long sum = 0;
+    for (int w = 0; w < workers; w++) {
+        long long c = totals[w];
+        totals[w] = sum;
+        sum += c;
+    }
+    g->offset[n] = sum;
+    serial_done(clk, t0);
+
+    phase_start(clk);
+    for (int w = 0; w < workers; w++) {
+        clock_t t1 = clock();
+        long long at = totals[w];
+        for (int v = slice_begin(n, w, workers); v < slice_begin(n, w + 1, workers); v++) {
+            g->offset[v] = at;
+            for (int r = 0; r < workers; r++) {
+                long long c = g->fill[(size_t)r * n + v];
+                g->fill[(size_t)r * n + v] = at;
+                at += c;
+            }
+        }
+        worker_done(clk, w, t1);
+    }
+    phase_end(clk, workers);
+
+    phase_start(clk);
+    for (int w = 0; w < workers; w++) {
+        clock_t t1 = clock();
+        long long *row = g->fill + (size_t)w * n;
+        for (int e = slice_begin(m, w, workers); e < slice_begin(m, w + 1, workers); e++) {
+            const Edge *ed = &edges[e];
+            Slot *a = &g->slot[row[ed->src]++];
+            a->to = ed->dest;
+            a->weight = ed->weight;
+            a->edge = e;
+            Slot *b = &g->slot[row[ed->dest]++];
+            b->to = ed->src;
+            b->weight = ed->weight;
+            b->edge = e;
+        }
+        worker_done(clk, w, t1);
+    }
+    phase_end(clk, workers);
+}
+
+// ---------------------------------------------------------------------------
+// Boruvka with contraction. Each round:
+//   1. every (super)vertex picks its lightest incident edge, ties broken by
+//      edge index, so the picks are a strict order and form a forest (an
+//      edge picked from both ends is just seen twice);
+//   2. every pick is hooked with the CAS union; the union that succeeds
+//      adds the edge, so a mutual pick is counted once;
+//   3. components are renumbered 0..k-1 (root counts per slice, a prefix,
+//      then every vertex reads its root's number);
+//   4. edges are relabeled, self-loops dropped, the survivors compacted by
+//      per-slice counts, and the CSR rebuilt for the contracted graph.
+// Every round at least halves the vertex count of each non-isolated
+// component, so there are O(log V) rounds. Parallel edges between two
+// super-vertices are kept; removing them needs a sort that costs more than
+// scanning them for the graphs here.
+// ---------------------------------------------------------------------------
+
+Forest boruvka(const Graph *graph, int workers, WorkClock *clk) {
+    Forest forest = {0, 0};
+    int n = graph->V, m = graph->E;
+    Edge *cur = (Edge*)malloc((size_t)m * sizeof(Edge));
+    Edge *next = (Edge*)malloc((size_t)m * sizeof(Edge));
+    int *best = (int*)malloc(n * sizeof(int));
+    int *parent = (int*)malloc(n * sizeof(int));
+    int *label = (int*)malloc(n * sizeof(int));
+    EdgeCsr g;
+    csr_alloc(&g, n, m, workers);
+    memset(clk, 0, sizeof(*clk));
+    memcpy(cur, graph->edge, (size_t)m * sizeof(Edge));
+
+    long long wsum[MAX_WORKERS];
+    int counts[MAX_WORKERS];
+    for (;;) {
+        csr_build(&g, n, cur, m, workers, clk);
+
+        phase_start(clk);
+        for (int w = 0; w < workers; w++) {
+            clock_t t0 = clock();
+            for (int v = slice_begin(n, w, workers); v < slice_begin(n, w + 1, workers); v++) {
+                int pick = -1, pick_w = INT_MAX;
+                for (long long k = g.offset[v]; k < g.offset[v + 1]; k++) {
+                    const Slot *sl = &g.slot[k];
+                    if (sl->to == v) continue;
+                    if (sl->weight < pick_w || (sl->weight == pick_w && sl->edge < pick)) {
+                        pick = sl->edge;
+                        pick_w = sl->weight;
+                    }
+                }
+                best[v] = pick;
+                parent[v] = v;
+            }
+            worker_done(clk, w, t0);
+        }
+        phase_end(clk, workers);
+
+        int merged = 0;
+        phase_start(clk);
+        for (int w = 0; w < workers; w++) {
+            clock_t t0 = clock();
+            long long sum = 0;
+            int cnt = 0;
+            for (int v = slice_begin(n, w, workers); v < slice_begin(n, w + 1, workers); v++) {
+                int e = best[v];
+                if (e < 0) continue;
+                int other = cur[e].src == v ? cur[e].dest : cur[e].src;
+                if (cuf_union(parent, v, other)) {
+                    sum += cur[e].weight;
+                    cnt++;
+                }
+            }
+            wsum[w] = sum;
+            counts[w] = cnt;
+            worker_done(clk, w, t0);
+        }
+        phase_end(clk, workers);
+        for (int w = 0; w < workers; w++) {
+            forest.weight += wsum[w];
+            forest.edges += counts[w];
+            merged += counts[w];
+        }
+        if (merged == 0) break;
+
+        phase_start(clk);
+        for (int w = 0; w < workers; w++) {
+            clock_t t0 = clock();
+            int roots = 0;
+            for (int v = slice_begin(n, w, workers); v < slice_begin(n, w + 1, workers); v++) {
+                parent[v] = cuf_find(parent, v);
+                roots += parent[v] == v;
+            }
+            counts[w] = roots;
+            worker_done(clk, w, t0);
+        }
+        phase_end(clk, workers);
+
+        clock_t t0 = clock();
+        int k = 0;
+        for (int w = 0; w < workers; w++) {
+            int c = counts[w];
+            counts[w] = k;
+            k += c;
+        }
+        serial_done(clk, t0);
+
+        phase_start(clk);
+        for (int w = 0; w < workers; w++) {
+            clock_t t1 = clock();
+            int id = counts[w];
+            for (int v = slice_begin(n, w, workers); v < slice_begin(n, w + 1, workers); v++) {
+                if (parent[v] == v) label[v] = id++;
+            }
+            worker_done(clk, w, t1);
+        }
+        phase_end(clk, workers);
+
+        phase_start(clk);
+        for (int w = 0; w < workers; w++) {
+            clock_t t1 = clock();
+            int kept = 0;
+            for (int e = slice_begin(m, w, workers); e < slice_begin(m, w + 1, workers); e++) {
+                kept += parent[cur[e].src] != parent[cur[e].dest];
+            }
+            counts[w] = kept;
+            worker_done(clk, w, t1);
+        }
+        phase_end(clk, workers);
+
+        t0 = clock();
+        int total = 0;
+        for (int w = 0; w < workers; w++) {
+            int c = counts[w];
+            counts[w] = total;
+            total += c;
+        }
+        serial_done(clk, t0);
+
+        phase_start(clk);
+        for (int w = 0; w < workers; w++) {
+            clock_t t1 = clock();
+            int out = counts[w];
+            for (int e = slice_begin(m, w, workers); e < slice_begin(m, w + 1, workers); e++) {
+                int a = parent[cur[e].src], b = parent[cur[e].dest];
+                if (a == b) continue;
+                next[out].src = label[a];
+                next[out].dest = label[b];
+                next[out].weight = cur[e].weight;
+                out++;
+            }
+            worker_done(clk, w, t1);
+        }
+        phase_end(clk, workers);
+
+        Edge *t = cur;
+        cur = next;
+        next = t;
+        n = k;
+        m = total;
+        if (m == 0) break;
+    }
+
+    csr_free(&g);
+    free(cur);
+    free(next);
+    free(best);
+    free(parent);
+    free(label);
+    return forest;
+}
+
+// ---------------------------------------------------------------------------
+// Prim for sparse graphs: a binary min-heap of vertices keyed by their
+// lightest known edge into the tree, with a position index so a cheaper
+// edge moves the vertex up in place instead of pushing a duplicate. Every
+// unreached vertex starts a new tree, so disconnected graphs give a forest.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    int *heap;               // vertices
+    int *pos;                // heap index of a vertex, -1 if not queued
+    int *key;
+    int size;
+} IndexedHeap;
+
+static void heap_sift_up(IndexedHeap *h, int i) {
+    int v = h->heap[i], k = h->key[v];
+    while (i > 0) {
+        int p = (i - 1) / 2;
+        if (h->key[h->heap[p]] <= k) break;
+        h->heap[i] = h->heap[p];
+        h->pos[h->heap[i]] = i;
+        i = p;
+    }
+    h->heap[i] = v;
+    h->pos[v] = i;
+}
+
+static void heap_sift_down(IndexedHeap *h, int i) {
+    int v = h->heap[i], k = h->key[v];
+    for (;;) {
+        int c = 2 * i + 1;
+        if (c >= h->size) break;
+        if (c + 1 < h->size && h->key[h->heap[c + 1]] < h->key[h->heap[c]]) c++;
+        if (h->key[h->heap[c]] >= k) break;
+        h->heap[i] = h->heap[c];
+        h->pos[h->heap[i]] = i;
+        i = c;
+    }
+    h->heap[i] = v;
+    h->pos[v] = i;
+}
+
+static int heap_pop(IndexedHeap *h) {
+    int top = h->heap[0];
+    h->pos[top] = -1;
+    if (--h->size > 0) {
+        h->heap[0] = h->heap[h->size];
+        heap_sift_down(h, 0);
+    }
+    return top;
+}
+
+static void heap_push_or_decrease(IndexedHeap *h, int v, int key) {
+    h->key[v] = key;
+    if (h->pos[v] < 0) {
+        h->heap[h->size] = v;
+        h->pos[v] = h->size++;
+    }
+    heap_sift_up(h, h->pos[v]);
+}
+
+Forest prim_heap(const Graph *graph) {
+    Forest forest = {0, 0};
+    int n = graph->V;
+    EdgeCsr g;
+    WorkClock clk;
+    csr_alloc(&g, n, graph->E, 1);
+    memset(&clk, 0, sizeof(clk));
+    csr_build(&g, n, graph->edge, graph->E, 1, &clk);
+
+    IndexedHeap h;
+    h.heap = (int*)malloc(n * sizeof(int));
+    h.pos = (int*)malloc(n * sizeof(int));
+    h.key = (int*)malloc(n * sizeof(int));
+    h.size = 0;
+    char *done = (char*)calloc(n, 1);
+    for (int v = 0; v < n; v++) {
+        h.pos[v] = -1;
+        h.key[v] = INT_MAX;
+    }
+
+    for (int s = 0; s < n; s++) {
+        if (done[s]) continue;
+        heap_push_or_decrease(&h, s, 0);
+        int root = 1;
+        while (h.size > 0) {
+            int u = heap_pop(&h);
+            done[u] = 1;
+            if (!root) {
+                forest.weight += h.key[u];
+                forest.edges++;
+            }
+            root = 0;
+            for (long long k = g.offset[u]; k < g.offset[u + 1]; k++) {
+                int v = g.slot[k].to, wt = g.slot[k].weight;
+                if (!done[v] && wt < h.key[v]) heap_push_or_decrease(&h, v, wt);
+            }
+        }
+    }
+
+    free(done);
+    free(h.heap);
+    free(h.pos);
+    free(h.key);
+    csr_free(&g);
+    return forest;
+}
+
+// ---------------------------------------------------------------------------
+// 21_kruskal_mst.c, made to return its forest. Its result array moved from
+// the stack to the heap: a million vertices' worth does not fit in a stack
+// frame.
+// ---------------------------------------------------------------------------
+
+typedef struct Subset {
+    int parent;
+    int rank;
+} Subset;
+
+int find(Subset subsets[], int i) {
+    if (subsets[i].parent != i)
+        subsets[i].parent = find(subsets, subsets[i].parent);
+    return subsets[i].parent;
+}
+
+void Union(Subset subsets[], int x, int y) {
+    int xroot = find(subsets, x);
+    int yroot = find(subsets, y);
+
+    if (subsets[xroot].rank < subsets[yroot].rank)
+        subsets[xroot].parent = yroot;
+    else if (subsets[xroot].rank > subsets[yroot].rank)
+        subsets[yroot].parent = xroot;
+    else {
+        subsets[yroot].parent = xroot;
+        subsets[xroot].rank++;
+    }
+}
+
+Forest kruskal(Graph* graph) {
+    int V = graph->V;
+    Edge *result = (Edge*)malloc(V * sizeof(Edge));
+    int e = 0;
+    int i = 0;
+    Forest forest = {0, 0};
+
+    qsort(graph->edge, graph->E, sizeof(Edge), compareEdges);
+
+    Subset* subsets = (Subset*)malloc(V * sizeof(Subset));
+    for (int v = 0; v < V; v++) {
+        subsets[v].parent = v;
+        subsets[v].rank = 0;
+    }
+
+    while (e < V - 1 && i < graph->E) {
+        Edge next_edge = graph->edge[i++];
+        int x = find(subsets, next_edge.src);
+        int y = find(subsets, next_edge.dest);
+
+        if (x != y) {
+            result[e++] = next_edge;
+            Union(subsets, x, y);
+        }
+    }
+
+    for (int k = 0; k < e; k++) forest.weight += result[k].weight;
+    forest.edges = e;
+    free(subsets);
+    free(result);
+    return forest;
+}
+
+// ---------------------------------------------------------------------------
+// 22_prim_mst.c (V renamed DENSE_V, which 21 uses as a variable name), made
+// to return its tree. O(V^2) over the adjacency matrix; it assumes the graph
+// is connected.
+// ---------------------------------------------------------------------------
+
+int minKey(int key[], int mstSet[]) {
+    int min = INT_MAX, min_index = 0;
+
+    for (int v = 0; v < DENSE_V; v++)
+        if (mstSet[v] == 0 && key[v] < min)
+            min = key[v], min_index = v;
+
+    return min_index;
+}
+
+Forest prim(int graph[DENSE_V][DENSE_V]) {
+    int parent[DENSE_V];
+    int key[DENSE_V];
+    int mstSet[DENSE_V];
+    Forest forest = {0, DENSE_V - 1};
+
+    for (int i = 0; i < DENSE_V; i++)
+        key[i] = INT_MAX, mstSet[i] = 0;
+
+    key[0] = 0;
+    parent[0] = -1;
+
+    for (int count = 0; count < DENSE_V - 1; count++) {
+        int u = minKey(key, mstSet);
+        mstSet[u] = 1;
+
+        for (int v = 0; v < DENSE_V; v++)
+            if (graph[u][v] && mstSet[v] == 0 && graph[u][v] < key[v])
+                parent[v] = u, key[v] = graph[u][v];
+    }
+
+    // Weigh the tree through its parent links, so a wrong link shows up as
+    // a weight mismatch against the other engines
+    for (int v = 1; v < DENSE_V; v++) forest.weight += graph[parent[v]][v];
+    return forest;
+}
+
+// ---------------------------------------------------------------------------
+// Inputs. Random geometric: points in the unit square joined when closer
+// than the radius that gives GEO_DEGREE expected neighbours, weighted by
+// distance (fixed point), found through a grid of radius-sized cells.
+// Power-law: preferential attachment, each new vertex linking PL_ATTACH
+// times to endpoints of earlier edges, weights 1..1000 (plenty of ties).
+// Uniform: 21's graph shape, random endpoints and weights below 100.
+// ---------------------------------------------------------------------------
+
+enum { GRAPH_GEOMETRIC, GRAPH_POWER_LAW, GRAPH_UNIFORM, NUM_GRAPHS };
+static const char *graph_names[NUM_GRAPHS] = {"geometric", "power-law", "uniform"};
+
+// top bits only: the LCG's low bits have short periods
+static unsigned int next_rand(unsigned int *seed) {
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 16;
+}
+
+static unsigned int rand_below(unsigned int *seed, unsigned int n) {
+    return (unsigned int)(((unsigned long long)next_rand(seed) << 16 | next_rand(seed)) % n);
+}
+
+static Graph *make_geometric(int target_edges, unsigned int seed) {
+    int n = (int)(2.0 * target_edges / GEO_DEGREE);
+    double r = sqrt(GEO_DEGREE / (M_PI * n));
+    int cells = (int)(1.0 / r);
+    if (cells < 1) cells = 1;
+    double *x = (double*)malloc(n * sizeof(double)), *y = (double*)malloc(n * sizeof(double));
+    int *cell_start = (int*)calloc((size_t)cells * cells + 1, sizeof(int));
+    int *order = (int*)malloc(n * sizeof(int));
+    int *cell_of = (int*)malloc(n * sizeof(int));
+    for (int i = 0; i < n; i++) {
+        x[i] = rand_below(&seed, 1u << 30) / (double)(1u << 30);
+        y[i] = rand_below(&seed, 1u << 30) / (double)(1u << 30);
+        int cx = (int)(x[i] * cells), cy = (int)(y[i] * cells);
+        cell_of[i] = cy * cells + cx;
+        cell_start[cell_of[i] + 1]++;
+    }
+    for (int c = 0; c < cells * cells; c++) cell_start[c + 1] += cell_start[c];
+    int *fill = (int*)malloc((size_t)cells * cells * sizeof(int));
+    memcpy(fill, cell_start, (size_t)cells * cells * sizeof(int));
+    for (int i = 0; i < n; i++) order[fill[cell_of[i]]++] = i;
+    free(fill);
+
+    int cap = target_edges + target_edges / 4 + 16, m = 0;
+    Edge *edges = (Edge*)malloc(cap * sizeof(Edge));
+    for (int i = 0; i < n; i++) {
+        int cx = cell_of[i] % cells, cy = cell_of[i] / cells;
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                int nx = cx + dx, ny = cy + dy;
+                if (nx < 0 || ny < 0 || nx >= cells || ny >= cells) continue;
+                int c = ny * cells + nx;
+                for (int k = cell_start[c]; k < cell_start[c + 1]; k++) {
+                    int j = order[k];
+                    if (j <= i) continue;
+                    double ddx = x[i] - x[j], ddy = y[i] - y[j];
+                    double d = sqrt(ddx * ddx + ddy * ddy);
+                    if (d >= r) continue;
+                    if (m == cap) {
+                        cap *= 2;
+                        edges = (Edge*)realloc(edges, cap * sizeof(Edge));
+                    }
+                    edges[m].src = i;
+                    edges[m].dest = j;
+                    edges[m].weight = 1 + (int)(d / r * 1000000);
+                    m++;
+                }
+            }
+        }
+    }
+    free(x);
+    free(y);
+    free(cell_start);
+    free(order);
+    free(cell_of);
+    Graph *g = createGraph(n, m);
+    memcpy(g->edge, edges, m * sizeof(Edge));
+    free(edges);
+    return g;
+}
+
+static Graph *make_power_law(int target_edges, unsigned int seed) {
+    int n = target_edges / PL_ATTACH + PL_ATTACH;
+    Graph *g = createGraph(n, (n - PL_ATTACH) * PL_ATTACH);
+    int m = 0;
+    for (int v = PL_ATTACH; v < n; v++) {
+        for (int k = 0; k < PL_ATTACH; k++) {
+            // half the time an endpoint of an earlier edge, i.e. a vertex
+            // picked in proportion to its degree, else any earlier vertex
+            int u;
+            if (m > 0 && (next_rand(&seed) & 1)) {
+                const Edge *e = &g->edge[rand_below(&seed, m)];
+                u = next_rand(&seed) & 1 ? e->src : e->dest;
+            } else {
+                u = rand_below(&seed, v);
+            }
+            g->edge[m].src = v;
+            g->edge[m].dest = u;
+            g->edge[m].weight = 1 + rand_below(&seed, 1000);
+            m++;
+        }
+    }
+    return g;
+}
+
+static Graph *make_uniform(int V, int E, unsigned int seed) {
+    Graph *g = createGraph(V, E);
+    for (int i = 0; i < E; i++) {
+        g->edge[i].src = rand_below(&seed, V);
+        g->edge[i].dest = rand_below(&seed, V);
+        g->edge[i].weight = rand_below(&seed, 100);
+    }
+    return g;
+}
+
+static Graph *make_graph(int kind, int edges, unsigned int seed) {
+    if (kind == GRAPH_GEOMETRIC) return make_geometric(edges, seed);
+    if (kind == GRAPH_POWER_LAW) return make_power_law(edges, seed);
+    return make_uniform(edges / 4, edges, seed);
+}
+
+static Graph *copy_graph(const Graph *g) {
+    Graph *c = createGraph(g->V, g->E);
+    memcpy(c->edge, g->edge, (size_t)g->E * sizeof(Edge));
+    return c;
+}
+
+// ---------------------------------------------------------------------------
+// Correctness: on every graph shape (plus an edgeless graph and one with
+// self-loops and parallel edges) all engines must give the same forest
+// weight and edge count as 21; on 22's own dense graph they must match 22.
+// ---------------------------------------------------------------------------
+
+static int same_forest(Forest a, Forest b) {
+    return a.weight == b.weight && a.edges == b.edges;
+}
+
+static int check_engines(const Graph *g, Forest expect) {
+    int failures = 0;
+    Graph *c = copy_graph(g);
+    if (!same_forest(filter_kruskal(c), expect)) failures++;
+    free_graph(c);
+    if (!same_forest(prim_heap(g), expect)) failures++;
+    for (int workers = 1; workers <= MAX_WORKERS; workers++) {
+        WorkClock clk;
+        if (!same_forest(boruvka(g, workers, &clk), expect)) failures++;
+    }
+    return failures;
+}
+
+static int check_mst(void) {
+    int failures = 0;
+    for (int kind = 0; kind < NUM_GRAPHS; kind++) {
+        for (int scale = 1; scale <= 16; scale *= 4) {
+            Graph *g = make_graph(kind, CHECK_V * scale, 3 + kind + scale);
+            Graph *c = copy_graph(g);
+            Forest expect = kruskal(c);
+            free_graph(c);
+            failures += check_engines(g, expect);
+            free_graph(g);
+        }
+    }
+
+    Graph *g = createGraph(CHECK_V, 0);
+    Forest none = {0, 0};
+    failures += check_engines(g, none);
+    free_graph(g);
+
+    unsigned int seed = 9;
+    g = make_uniform(64, 600, seed);
+    for (int i = 0; i < 100; i++) g->edge[i].dest = g->edge[i].src;        // self-loops
+    for (int i = 100; i < 300; i++) g->edge[i] = g->edge[i - 100 + 300];   // parallel copies
+    Graph *c = copy_graph(g);
+    Forest expect = kruskal(c);
+    free_graph(c);
+    failures += check_engines(g, expect);
+    free_graph(g);
+
+    // 22's graph, generated as 22 does
+    static int dense[DENSE_V][DENSE_V];
+    memset(dense, 0, sizeof(dense));
+    srand(42);
+    for (int i = 0; i < DENSE_V; i++) {
+        for (int j = 0; j < 5; j++) {
+            int dest = rand() % DENSE_V;
+            if (dest != i) {
+                int weight = rand() % 100 + 1;
+                dense[i][dest] = weight;
+                dense[dest][i] = weight;
+            }
+        }
+    }
+    int m = 0;
+    g = createGraph(DENSE_V, DENSE_V * 5);
+    for (int i = 0; i < DENSE_V; i++) {
+        for (int j = i + 1; j < DENSE_V; j++) {
+            if (dense[i][j]) {
+                g->edge[m].src = i;
+                g->edge[m].dest = j;
+                g->edge[m].weight = dense[i][j];
+                m++;
+            }
+        }
+    }
+    g->E = m;
+    failures += check_engines(g, prim(dense));
+    free_graph(g);
+    return failures;
+}
+
+// ---------------------------------------------------------------------------
+// Benchmark: each engine on geometric, power-law and uniform graphs of about
+// MST_EDGES edges, in Medges/s. Boruvka at 1-8 workers reports the rate over
+// the simulated critical path and work / critical path.
+// ---------------------------------------------------------------------------
+
+#define NUM_WORKER_COUNTS 4
+static const int bench_workers[NUM_WORKER_COUNTS] = {1, 2, 4, 8};
+
+static double seconds_since(clock_t t0) {
+    return (double)(clock() - t0) / CLOCKS_PER_SEC;
+}
+
+int main() {
+    clock_t start = clock();
+    int failures = check_mst();
+
+    printf("MST engines, ~%d edges per graph (Medges/s):\n", MST_EDGES);
+    printf("%-10s %9s %9s %9s %9s", "graph", "V", "21", "filterK", "prim");
+    for (int wi = 0; wi < NUM_WORKER_COUNTS; wi++) printf("    boruvka=%d", bench_workers[wi]);
+    printf("   forest weight\n");
+    for (int kind = 0; kind < NUM_GRAPHS; kind++) {
+        Graph *g = make_graph(kind, MST_EDGES, 17 + kind);
+        double m = g->E;
+
+        Graph *c = copy_graph(g);
+        clock_t t0 = clock();
+        Forest expect = kruskal(c);
+        double t_kruskal = seconds_since(t0);
+        free_graph(c);
+
+        c = copy_graph(g);
+        t0 = clock();
+        Forest f = filter_kruskal(c);
+        double t_filter = seconds_since(t0);
+        free_graph(c);
+        if (!same_forest(f, expect)) failures++;
+
+        t0 = clock();
+        f = prim_heap(g);
+        double t_prim = seconds_since(t0);
+        if (!same_forest(f, expect)) failures++;
+
+        printf("%-10s %9d %9.1f %9.1f %9.1f", graph_names[kind], g->V, m / t_kruskal / 1e6,
+               m / t_filter / 1e6, m / t_prim / 1e6);
+        for (int wi = 0; wi < NUM_WORKER_COUNTS; wi++) {
+            WorkClock clk;
+            f = boruvka(g, bench_workers[wi], &clk);
+            if (!same_forest(f, expect)) failures++;
+            printf(" %7.1f x%-4.1f", clk.span > 0 ? m / clk.span / 1e6 : 0.0,
+                   clk.span > 0 ? clk.work / clk.span : 0.0);
+        }
+        printf("   %lld (%d edges)\n", expect.weight, expect.edges);
+        free_graph(g);
+    }
+    printf("(boruvka: every step of a round waits for its busiest range; xN = summed range time / that)\n");
+
+    clock_t end = clock();
+    printf("MST library: %d edges per graph, %d graph kinds, %.6f seconds\n",
+           MST_EDGES, NUM_GRAPHS, (double)(end - start) / CLOCKS_PER_SEC);
+    printf("Failures: %d\n", failures);
+    return 0;
+}
@@ -0,0 +1,1134 @@
+// Network flow library: adjacency-array residual graphs, Dinic with current arcs, FIFO and
+// highest-label push-relabel with global relabeling and gaps, primal-dual min-cost flow
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+
+#ifdef FULL_SIZE
+#define FLOW_ARCS (1 << 19)   // input arcs per benchmark graph; 10^7 needs about 600 MB
+#define COST_ARCS (1 << 13)   // input arcs per min-cost flow benchmark graph
+#else
+#define FLOW_ARCS (1 << 16)   // -DFULL_SIZE for 512K flow arcs and 8K min-cost arcs
+#define COST_ARCS (1 << 12)
+#endif
+#define GRID_LENGTH 16        // grid columns between source and sink; the rows make up the arcs
+#define GRAPH_DEGREE 8        // arcs per vertex in the random and bipartite graphs
+#define GR_FREQ 6             // global relabel after GR_FREQ * n + m units of relabel work
+#define CHECK_ARCS 6000       // input arcs per correctness graph
+
+// ---------------------------------------------------------------------------
+// Residual graph. Arcs are added as (from, to, capacity, cost) and then laid
+// out as adjacency arrays: the arcs leaving v are arc[first[v] .. first[v+1])
+// and every arc stores the index of its reverse, which starts with capacity
+// 0 and cost -cost. cap holds residual capacity; cap0 keeps the original so
+// the graph can be reset between engines. The same storage serves max flow
+// and min-cost flow.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    int to, rev, cap, cost;
+} Arc;
+
+typedef struct {
+    int n, m;                // vertices, arcs (twice the input arcs)
+    int *first;              // n + 1
+    Arc *arc;
+    int *cap0;
+    int *in_from, *in_to, *in_cap, *in_cost;
+    int in_n, in_alloc;
+} FlowGraph;
+
+void fg_init(FlowGraph *g, int n) {
+    memset(g, 0, sizeof(*g));
+    g->n = n;
+    g->in_alloc = 1024;
+    g->in_from = (int*)malloc(g->in_alloc * sizeof(int));
+    g->in_to = (int*)malloc(g->in_alloc * sizeof(int));
+    g->in_cap = (int*)malloc(g->in_alloc * sizeof(int));
+    g->in_cost = (int*)malloc(g->in_alloc * sizeof(int));
+}
+
+void fg_add_arc(FlowGraph *g, int from, int to, int cap, int cost) {
+    if (g->in_n == g->in_alloc) {
+        g->in_alloc *= 2;
+        g->in_from = (int*)realloc(g->in_from, g->in_alloc * sizeof(int));
+        g->in_to = (int*)realloc(g->in_to, g->in_alloc * sizeof(int));
+        g->in_cap = (int*)realloc(g->in_cap, g->in_alloc * sizeof(int));
+        g->in_cost = (int*)realloc(g->in_cost, g->in_alloc * sizeof(int));
+    }
+    g->in_from[g->in_n] = from;
+    g->in_to[g->in_n] = to;
+    g->in_cap[g->in_n] = cap;
+    g->in_cost[g->in_n] = cost;
+    g->in_n++;
+}
+
+void fg_finalize(FlowGraph *g) {
+    int n = g->n;
+    g->m = 2 * g->in_n;
+    g->first = (int*)calloc(n + 1, sizeof(int));
+    g->arc = (Arc*)malloc((g->m + 1) * sizeof(Arc));
+    g->cap0 = (int*)malloc((g->m + 1) * sizeof(int));
+    for (int i = 0; i < g->in_n; i++) {
+        g->first[g->in_from[i] + 1]++;
+        g->first[g->in_to[i] + 1]++;
+    }
+    for (int v = 0; v < n; v++) g->first[v + 1] += g->first[v];
+    int *fill = (int*)malloc((n + 1) * sizeof(int));
+    memcpy(fill, g->first, (n + 1) * sizeof(int));
+    for (int i = 0; i < g->in_n; i++) {
+        int u = g->in_from[i], v = g->in_to[i];
+        int a = fill[u]++, b = fill[v]++;
+        g->arc[a] = (Arc){v, b, g->in_cap[i], g->in_cost[i]};
+        g->arc[b] = (Arc){u, a, 0, -g->in_cost[i]};
+    }
+    for (int a = 0; a < g->m; a++) g->cap0[a] = g->arc[a].cap;
+    free(fill);
+    free(g->in_from);
+    free(g->in_to);
+    free(g->in_cap);
+    free(g->in_cost);
+    g->in_from = g->in_to = g->in_cap = g->in_cost = NULL;
+}
+
+void fg_reset(FlowGraph *g) {
+    for (int a = 0; a < g->m; a++) g->arc[a].cap = g->cap0[a];
+}
+
+void fg_free(FlowGraph *g) {
+    free(g->first);
+    free(g->arc);
+    free(g->cap0);
+}
+
+static inline int arc_tail(const FlowGraph *g, int a) {
+    return g->arc[g->arc[a].rev].to;
+}
+
+// ---------------------------------------------------------------------------
+// Dinic. A BFS from the source labels vertices with their residual distance
+// (stopping at the sink's level); then a blocking flow is found by DFS over
+// arcs that go exactly one level up. The DFS is iterative (grid paths are
+// thousands of arcs long) and keeps a current arc per vertex: an arc that
+// was saturated or led to a dead end is never looked at again in the phase,
+// so a phase costs O(nm) at worst and O(m) per augmenting-path length in
+// practice. Dead-end vertices are also cut from the level graph.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    int *level, *cur, *queue, *path;
+} DinicWork;
+
+static int dinic_bfs(FlowGraph *g, int s, int t, DinicWork *w) {
+    for (int v = 0; v < g->n; v++) w->level[v] = -1;
+    int head = 0, tail = 0;
+    w->queue[tail++] = s;
+    w->level[s] = 0;
+    while (head < tail) {
+        int u = w->queue[head++];
+        if (w->level[t] >= 0 && w->level[u] >= w->level[t]) break;
+        for (int a = g->first[u]; a < g->first[u + 1]; a++) {
+            int v = g->arc[a].to;
+            if (g->arc[a].cap > 0 && w->level[v] < 0) {
+                w->level[v] = w->level[u] + 1;
+                w->queue[tail++] = v;
+            }
+        }
+    }
+    return w->level[t] >= 0;
+}
+
+static long long dinic_blocking(FlowGraph *g, int s, int t, DinicWork *w) {
+    long long total = 0;
+    int depth = 0, u = s;
+    for (int v = 0; v < g->n; v++) w->cur[v] = g->first[v];
+    for (;;) {
+        if (u == t) {
+            int f = INT_MAX, cut = 0;
+            for (int i = 0; i < depth; i++) {
+                if (g->arc[w->path[i]].cap < f) {
+                    f = g->arc[w->path[i]].cap;
+                    cut = i;
+                }
+            }
+            for (int i = 0; i < depth; i++) {
+                Arc *a = &g->arc[w->path[i]];
+                a->cap -= f;
+                g->arc[a->rev].cap += f;
+            }
+            total += f;
+            depth = cut;               // retreat to the tail of the first saturated arc
+            u = depth == 0 ? s : g->arc[w->path[depth - 1]].to;
+            continue;
+        }
+        int a = w->cur[u], end = g->first[u + 1];
+        while (a < end && !(g->arc[a].cap > 0 && w->level[g->arc[a].to] == w->level[u] + 1)) a++;
+        w->cur[u] = a;
+        if (a < end) {
+            w->path[depth++] = a;
+            u = g->arc[a].to;
+            continue;
+        }
+        w->level[u] = -1;              // dead end
+        if (depth == 0) break;
+        depth--;
+        u = arc_tail(g, w->path[depth]);
+        w->cur[u]++;
+    }
+    return total;
+}
+
+long long dinic(FlowGraph *g, int s, int t) {
+    DinicWork w;
+    w.level = (int*)malloc(g->n * sizeof(int));
+    w.cur = (int*)malloc(g->n * sizeof(int));
+    w.queue = (int*)malloc(g->n * sizeof(int));
+    w.path = (int*)malloc(g->n * sizeof(int));
+    long long flow = 0;
+    while (dinic_bfs(g, s, t, &w)) flow += dinic_blocking(g, s, t, &w);
+    free(w.level);
+    free(w.cur);
+    free(w.queue);
+    free(w.path);
+    return flow;
+}
+
+// ---------------------------------------------------------------------------
+// Push-relabel (Goldberg-Tarjan), first phase only: it finds a maximum
+// preflow, whose excess at the sink is the max-flow value, and stops there;
+// turning the preflow into a flow is not needed for the value or the cut.
+// Vertices are discharged either in FIFO order or highest label first.
+//
+// Heights are kept exact with two heuristics. Global relabeling sets every
+// height to its residual distance to the sink by a backward BFS - at the
+// start and again whenever relabel work since the last one exceeds
+// GR_FREQ * n + m. For the gap heuristic every live vertex sits in a
+// doubly-linked list for its height: when a relabel empties a height, no
+// vertex above the gap can reach the sink any more, so the lists above it
+// are emptied and their vertices lifted to n, which retires them. Heights
+// below the highest live one are never empty (a relabel cannot jump past an
+// empty height, and emptying one triggers the gap), so the lift costs only
+// the vertices it retires.
+// ---------------------------------------------------------------------------
+
+enum { PR_FIFO, PR_HIGHEST };
+
+typedef struct {
+    FlowGraph *g;
+    int s, t, rule;
+    int *height, *cur;
+    int *live, *live_next, *live_prev, max_live;   // all vertices below n, per height
+    long long *excess;
+    int *queue, qhead, qtail;          // FIFO ring, n slots
+    int *bucket, *next, max_active;    // highest label: active lists per height
+    char *in_queue;
+    long long work;
+    int relabels, gaps, global_relabels;
+} PushRelabel;
+
+static void live_insert(PushRelabel *p, int v) {
+    int h = p->height[v];
+    p->live_prev[v] = -1;
+    p->live_next[v] = p->live[h];
+    if (p->live[h] >= 0) p->live_prev[p->live[h]] = v;
+    p->live[h] = v;
+    if (h > p->max_live) p->max_live = h;
+}
+
+static void live_remove(PushRelabel *p, int v) {
+    if (p->live_prev[v] >= 0) p->live_next[p->live_prev[v]] = p->live_next[v];
+    else p->live[p->height[v]] = p->live_next[v];
+    if (p->live_next[v] >= 0) p->live_prev[p->live_next[v]] = p->live_prev[v];
+}
+
+static void pr_activate(PushRelabel *p, int v) {
+    if (v == p->s || v == p->t || p->height[v] >= p->g->n) return;
+    if (p->rule == PR_FIFO) {
+        if (p->in_queue[v]) return;
+        p->in_queue[v] = 1;
+        p->queue[p->qtail] = v;
+        p->qtail = p->qtail + 1 == p->g->n ? 0 : p->qtail + 1;
+    } else {
+        int h = p->height[v];
+        p->next[v] = p->bucket[h];
+        p->bucket[h] = v;
+        if (h > p->max_active) p->max_active = h;
+    }
+}
+
+static int pr_next_active(PushRelabel *p) {
+    for (;;) {
+        int v;
+        if (p->rule == PR_FIFO) {
+            if (p->qhead == p->qtail) return -1;   // never full: s and t are not queued
+            v = p->queue[p->qhead];
+            p->qhead = p->qhead + 1 == p->g->n ? 0 : p->qhead + 1;
+            p->in_queue[v] = 0;
+        } else {
+            while (p->max_active >= 0 && p->bucket[p->max_active] < 0) p->max_active--;
+            if (p->max_active < 0) return -1;
+            v = p->bucket[p->max_active];
+            p->bucket[p->max_active] = p->next[v];
+        }
+        // a gap or a global relabel may have retired it since it was queued
+        if (p->height[v] < p->g->n && p->excess[v] > 0) return v;
+    }
+}
+
+static void pr_global_relabel(PushRelabel *p) {
+    FlowGraph *g = p->g;
+    int n = g->n;
+    for (int v = 0; v < n; v++) p->height[v] = n;
+    for (int h = 0; h <= n; h++) p->live[h] = -1;
+    p->max_live = 0;
+    int *queue = p->cur;               // cur is reset below, so its array doubles as the BFS queue
+    int head = 0, tail = 0;
+    p->height[p->t] = 0;
+    queue[tail++] = p->t;
+    while (head < tail) {
+        int v = queue[head++];
+        live_insert(p, v);
+        for (int a = g->first[v]; a < g->first[v + 1]; a++) {
+            int u = g->arc[a].to;
+            if (p->height[u] == n && u != p->s && g->arc[g->arc[a].rev].cap > 0) {
+                p->height[u] = p->height[v] + 1;
+                queue[tail++] = u;
+            }
+        }
+    }
+    for (int v = 0; v < n; v++) p->cur[v] = g->first[v];
+    p->height[p->s] = n;
+    p->qhead = p->qtail = 0;
+    for (int v = 0; v < n; v++) p->in_queue[v] = 0;
+    for (int h = 0; h <= n; h++) p->bucket[h] = -1;
+    p->max_active = -1;
+    for (int v = 0; v < n; v++) {
+        if (p->excess[v] > 0) pr_activate(p, v);
+    }
+    p->work = 0;
+    p->global_relabels++;
+}
+
+static void pr_gap(PushRelabel *p, int gap) {
+    int n = p->g->n;
+    for (int h = gap + 1; h <= p->max_live; h++) {
+        for (int v = p->live[h]; v >= 0; v = p->live_next[v]) p->height[v] = n;
+        p->live[h] = -1;
+    }
+    p->max_live = gap - 1;
+    p->gaps++;
+}
+
+static void pr_relabel(PushRelabel *p, int u) {
+    FlowGraph *g = p->g;
+    int n = g->n, old = p->height[u], h = 2 * n;
+    for (int a = g->first[u]; a < g->first[u + 1]; a++) {
+        if (g->arc[a].cap > 0 && p->height[g->arc[a].to] + 1 < h) h = p->height[g->arc[a].to] + 1;
+    }
+    p->work += 12 + g->first[u + 1] - g->first[u];
+    p->relabels++;
+    p->cur[u] = g->first[u];
+    live_remove(p, u);
+    if (p->live[old] < 0) {
+        pr_gap(p, old);
+        h = n;
+    }
+    p->height[u] = h < n ? h : n;
+    if (p->height[u] < n) live_insert(p, u);
+}
+
+static void pr_discharge(PushRelabel *p, int u) {
+    FlowGraph *g = p->g;
+    int n = g->n;
+    while (p->excess[u] > 0) {
+        int a = p->cur[u];
+        if (a == g->first[u + 1]) {
+            pr_relabel(p, u);
+            if (p->height[u] >= n) return;
+            continue;
+        }
+        Arc *arc = &g->arc[a];
+        int v = arc->to;
+        if (arc->cap > 0 && p->height[u] == p->height[v] + 1) {
+            int d = p->excess[u] < arc->cap ? (int)p->excess[u] : arc->cap;
+            arc->cap -= d;
+            g->arc[arc->rev].cap += d;
+            p->excess[u] -= d;
+            p->excess[v] += d;
+            if (p->excess[v] == d) pr_activate(p, v);
+            if (p->excess[u] == 0) return;
+        }
+        p->cur[u]++;
+    }
+}
+
+long long push_relabel(FlowGraph *g, int s, int t, int rule, PushRelabel *stats) {
+    int n = g->n;
+    PushRelabel p;
+    memset(&p, 0, sizeof(p));
+    p.g = g;
+    p.s = s;
+    p.t = t;
+    p.rule = rule;
+    p.height = (int*)malloc(n * sizeof(int));
+    p.cur = (int*)malloc(n * sizeof(int));
+    p.live = (int*)malloc((n + 1) * sizeof(int));
+    p.live_next = (int*)malloc(n * sizeof(int));
+    p.live_prev = (int*)malloc(n * sizeof(int));
+    p.excess = (long long*)calloc(n, sizeof(long long));
+    p.queue = (int*)malloc(n * sizeof(int));
+    p.bucket = (int*)malloc((n + 1) * sizeof(int));
+    p.next = (int*)malloc(n * sizeof(int));
+    p.in_queue = (char*)calloc(n, 1);
+
+    for (int a = g->first[s]; a < g->first[s + 1]; a++) {
+        Arc *arc = &g->arc[a];
+        if (arc->cap == 0 || arc->to == s) continue;
+        p.excess[arc->to] += arc->cap;
+        p.excess[s] -= arc->cap;
+        g->arc[arc->rev].cap += arc->cap;
+        arc->cap = 0;
+    }
+    pr_global_relabel(&p);
+    long long threshold = (long long)GR_FREQ * n + g->m;
+    for (;;) {
+        int u = pr_next_active(&p);
+        if (u < 0) break;
+        pr_discharge(&p, u);
+        if (p.work > threshold) pr_global_relabel(&p);
+    }
+    long long flow = p.excess[t];
+
+    free(p.height);
+    free(p.cur);
+    free(p.live);
+    free(p.live_next);
+    free(p.live_prev);
+    free(p.excess);
+    free(p.queue);
+    free(p.bucket);
+    free(p.next);
+    free(p.in_queue);
+    if (stats) *stats = p;
+    return flow;
+}
+
+// ---------------------------------------------------------------------------
+// Min-cut certificate. From the residual graph an engine leaves behind, take
+// the vertices that can reach the sink (push-relabel) or that the source can
+// reach (Dinic); the original capacity of the arcs crossing that cut must
+// equal the flow value, which proves both the flow and the cut optimal.
+// ---------------------------------------------------------------------------
+
+long long residual_cut(const FlowGraph *g, int s, int t, int from_source) {
+    int n = g->n;
+    char *side = (char*)calloc(n, 1);
+    int *queue = (int*)malloc(n * sizeof(int));
+    int head = 0, tail = 0;
+    int root = from_source ? s : t;
+    side[root] = 1;
+    queue[tail++] = root;
+    while (head < tail) {
+        int v = queue[head++];
+        for (int a = g->first[v]; a < g->first[v + 1]; a++) {
+            int u = g->arc[a].to;
+            // forwards: arc v->u has room; backwards: u->v (the reverse of a) has room
+            int open = from_source ? g->arc[a].cap > 0 : g->arc[g->arc[a].rev].cap > 0;
+            if (open && !side[u]) {
+                side[u] = 1;
+                queue[tail++] = u;
+            }
+        }
+    }
+    long long cut = 0;
+    for (int v = 0; v < n; v++) {
+        for (int a = g->first[v]; a < g->first[v + 1]; a++) {
+            int u = g->arc[a].to;
+            int crosses = from_source ? side[v] && !side[u] : !side[v] && side[u];
+            if (crosses) cut += g->cap0[a];
+        }
+    }
+    free(side);
+    free(queue);
+    return cut;
+}
+
+// ---------------------------------------------------------------------------
+// Min-cost flow, primal-dual. Dijkstra over reduced costs c(u,v) + pi(u) -
+// pi(v), which the potentials keep non-negative, finds the distance to the
+// sink; every potential then grows by min(dist, dist to the sink). After
+// that the shortest augmenting paths are exactly the paths of zero reduced
+// cost, and a Dinic blocking flow over those arcs sends along all of them
+// at once instead of one path per Dijkstra. Costs must be non-negative.
+// Returns the flow sent (at most want) and stores its cost.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    long long dist;
+    int v;
+} HeapItem;
+
+static void heap_push(HeapItem *heap, int *size, long long dist, int v) {
+    int i = (*size)++;
+    while (i > 0) {
+        int p = (i - 1) / 2;
+        if (heap[p].dist <= dist) break;
+        heap[i] = heap[p];
+        i = p;
+    }
+    heap[i].dist = dist;
+    heap[i].v = v;
+}
+
+static HeapItem heap_pop(HeapItem *heap, int *size) {
+    HeapItem top = heap[0], last = heap[--(*size)];
+    int i = 0;
+    for (;;) {
+        int c = 2 * i + 1;
+        if (c >= *size) break;
+        if (c + 1 < *size && heap[c + 1].dist < heap[c].dist) c++;
+        if (heap[c].dist >= last.dist) break;
+        heap[i] = heap[c];
+        i = c;
+    }
+    heap[i] = last;
+    return top;
+}
+
+static inline int tight(const FlowGraph *g, const long long *pi, int u, int a) {
+    return g->arc[a].cap > 0 && g->arc[a].cost + pi[u] - pi[g->arc[a].to] == 0;
+}
+
+long long min_cost_flow_pd(FlowGraph *g, int s, int t, long long want, long long *cost_out) {
+    int n = g->n;
+    long long *pi = (long long*)calloc(n, sizeof(long long));
+    long long *dist = (long long*)malloc(n * sizeof(long long));
+    HeapItem *heap = (HeapItem*)malloc((g->m + 1) * sizeof(HeapItem));
+    int *level = (int*)malloc(n * sizeof(int)), *cur = (int*)malloc(n * sizeof(int));
+    int *queue = (int*)malloc(n * sizeof(int)), *path = (int*)malloc(n * sizeof(int));
+    long long flow = 0, cost = 0;
+
+    while (flow < want) {
+        for (int v = 0; v < n; v++) dist[v] = LLONG_MAX;
+        int size = 0;
+        dist[s] = 0;
+        heap_push(heap, &size, 0, s);
+        while (size > 0) {
+            HeapItem it = heap_pop(heap, &size);
+            int u = it.v;
+            if (it.dist != dist[u]) continue;
+            for (int a = g->first[u]; a < g->first[u + 1]; a++) {
+                if (g->arc[a].cap == 0) continue;
+                int v = g->arc[a].to;
+                long long d = it.dist + g->arc[a].cost + pi[u] - pi[v];
+                if (d < dist[v]) {
+                    dist[v] = d;
+                    heap_push(heap, &size, d, v);
+                }
+            }
+        }
+        if (dist[t] == LLONG_MAX) break;
+        for (int v = 0; v < n; v++) pi[v] += dist[v] < dist[t] ? dist[v] : dist[t];
+
+        // blocking flow on the tight arcs, as in dinic
+        for (;;) {
+            for (int v = 0; v < n; v++) level[v] = -1;
+            int head = 0, tail = 0;
+            queue[tail++] = s;
+            level[s] = 0;
+            while (head < tail) {
+                int u = queue[head++];
+                for (int a = g->first[u]; a < g->first[u + 1]; a++) {
+                    int v = g->arc[a].to;
+                    if (level[v] < 0 && tight(g, pi, u, a)) {
+                        level[v] = level[u] + 1;
+                        queue[tail++] = v;
+                    }
+                }
+            }
+            if (level[t] < 0) break;
+            for (int v = 0; v < n; v++) cur[v] = g->first[v];
+            int depth = 0, u = s;
+            while (flow < want) {
+                if (u == t) {
+                    long long f = want - flow;
+                    int cut = 0;
+                    for (int i = 0; i < depth; i++) {
+                        if (g->arc[path[i]].cap < f) {
+                            f = g->arc[path[i]].cap;
+                            cut = i;
+                        }
+                    }
+                    for (int i = 0; i < depth; i++) {
+                        Arc *a = &g->arc[path[i]];
+                        a->cap -= (int)f;
+                        g->arc[a->rev].cap += (int)f;
+                        cost += f * a->cost;
+                    }
+                    flow += f;
+                    depth = cut;
+                    u = depth == 0 ? s : g->arc[path[depth - 1]].to;
+                    continue;
+                }
+                int a = cur[u], end = g->first[u + 1];
+                while (a < end && !(level[g->arc[a].to] == level[u] + 1 && tight(g, pi, u, a))) a++;
+                cur[u] = a;
+                if (a < end) {
+                    path[depth++] = a;
+                    u = g->arc[a].to;
+                    continue;
+                }
+                level[u] = -1;
+                if (depth == 0) break;
+                depth--;
+                u = arc_tail(g, path[depth]);
+                cur[u]++;
+            }
+            if (flow >= want) break;
+        }
+    }
+
+    free(pi);
+    free(dist);
+    free(heap);
+    free(level);
+    free(cur);
+    free(queue);
+    free(path);
+    *cost_out = cost;
+    return flow;
+}
+
+// ---------------------------------------------------------------------------
+// 52_max_flow_ford_fulkerson.c: Edmonds-Karp over a MAX_V x MAX_V matrix,
+// the reference on small graphs.
+// ---------------------------------------------------------------------------
+
+#define MAX_V 100
+#define INF 1000000
+
+int bfs(int capacity[MAX_V][MAX_V], int source, int sink, int parent[], int n) {
+    int visited[MAX_V] = {0};
+    int queue[MAX_V];
+    int front = 0, rear = 0;
+
+    queue[rear++] = source;
+    visited[source] = 1;
+    parent[source] = -1;
+
+    while (front < rear) {
+        int u = queue[front++];
+
+        for (int v = 0; v < n; v++) {
+            if (!visited[v] && capacity[u][v] > 0) {
+                queue[rear++] = v;
+                parent[v] = u;
+                visited[v] = 1;
+
+                if (v == sink) {
+                    return 1;
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+int ford_fulkerson(int graph[MAX_V][MAX_V], int source, int sink, int n) {
+    int capacity[MAX_V][MAX_V];
+    int parent[MAX_V];
+    int max_flow = 0;
+
+    // Copy graph to capacity matrix
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            capacity[i][j] = graph[i][j];
+        }
+    }
+
+    // Augment flow while path exists
+    while (bfs(capacity, source, sink, parent, n)) {
+        int path_flow = INF;
+
+        // Find minimum capacity in path
+        for (int v = sink; v != source; v = parent[v]) {
+            int u = parent[v];
+            if (capacity[u][v] < path_flow) {
+                path_flow = capacity[u][v];
+            }
+        }
+
+        // Update capacities
+        for (int v = sink; v != source; v = parent[v]) {
+            int u = parent[v];
+            capacity[u][v] -= path_flow;
+            capacity[v][u] += path_flow;
+        }
+
+        max_flow += path_flow;
+    }
+
+    return max_flow;
+}
+
+void create_test_graph(int graph[MAX_V][MAX_V], int n) {
+    memset(graph, 0, sizeof(int) * MAX_V * MAX_V);
+
+    // Create a flow network
+    for (int i = 0; i < n-1; i++) {
+        // Forward edges
+        graph[i][i+1] = 10 + (i % 15);
+
+        // Some cross edges
+        if (i + 2 < n) {
+            graph[i][i+2] = 5 + (i % 8);
+        }
+        if (i + 3 < n) {
+            graph[i][i+3] = 3 + (i % 5);
+        }
+    }
+
+    // Add some backward edges for complexity
+    for (int i = 1; i < n; i += 3) {
+        if (i > 2) {
+            graph[i][i-2] = 7;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// 151_min_cost_flow.c (Edge renamed CostEdge, add_edge add_cost_edge), the
+// min-cost reference. Its network had no reverse edges, so flow could never
+// be rerouted and the "minimum" cost was only greedy; add_cost_edge now adds
+// the reverse edge at index ^ 1 (capacity 0, cost negated) and an
+// augmentation also updates it.
+// ---------------------------------------------------------------------------
+
+#define MAX_NODES 100
+#define MAX_EDGES 500
+
+typedef struct {
+    int from, to;
+    int capacity;
+    int cost;
+    int flow;
+} CostEdge;
+
+typedef struct {
+    CostEdge edges[MAX_EDGES];
+    int num_edges;
+    int num_nodes;
+} FlowNetwork;
+
+void init_network(FlowNetwork *net, int nodes) {
+    net->num_nodes = nodes;
+    net->num_edges = 0;
+}
+
+void add_cost_edge(FlowNetwork *net, int from, int to, int capacity, int cost) {
+    if (net->num_edges + 1 < MAX_EDGES) {
+        net->edges[net->num_edges] = (CostEdge){from, to, capacity, cost, 0};
+        net->edges[net->num_edges + 1] = (CostEdge){to, from, 0, -cost, 0};
+        net->num_edges += 2;
+    }
+}
+
+int bellman_ford(FlowNetwork *net, int source, int sink, int *dist, int *parent) {
+    for (int i = 0; i < net->num_nodes; i++) {
+        dist[i] = INT_MAX;
+        parent[i] = -1;
+    }
+    dist[source] = 0;
+
+    for (int iter = 0; iter < net->num_nodes - 1; iter++) {
+        for (int e = 0; e < net->num_edges; e++) {
+            int u = net->edges[e].from;
+            int v = net->edges[e].to;
+            int residual = net->edges[e].capacity - net->edges[e].flow;
+
+            if (residual > 0 && dist[u] != INT_MAX) {
+                if (dist[u] + net->edges[e].cost < dist[v]) {
+                    dist[v] = dist[u] + net->edges[e].cost;
+                    parent[v] = e;
+                }
+            }
+        }
+    }
+
+    return dist[sink] != INT_MAX;
+}
+
+int min_cost_flow(FlowNetwork *net, int source, int sink, int max_flow) {
+    int total_cost = 0;
+    int *dist = (int*)malloc(net->num_nodes * sizeof(int));
+    int *parent = (int*)malloc(net->num_nodes * sizeof(int));
+
+    while (max_flow > 0 && bellman_ford(net, source, sink, dist, parent)) {
+        int flow = max_flow;
+
+        for (int v = sink; v != source; v = net->edges[parent[v]].from) {
+            int e = parent[v];
+            int residual = net->edges[e].capacity - net->edges[e].flow;
+            if (residual < flow) {
+                flow = residual;
+            }
+        }
+
+        for (int v = sink; v != source; v = net->edges[parent[v]].from) {
+            int e = parent[v];
+            net->edges[e].flow += flow;
+            net->edges[e ^ 1].flow -= flow;
+            total_cost += flow * net->edges[e].cost;
+        }
+
+        max_flow -= flow;
+    }
+
+    free(dist);
+    free(parent);
+
+    return total_cost;
+}
+
+// ---------------------------------------------------------------------------
+// 98_hopcroft_karp.c (Edge renamed MatchEdge, Graph MatchGraph, add_edge,
+// bfs and dfs prefixed): the reference for unit-capacity bipartite flow.
+// ---------------------------------------------------------------------------
+
+#define NL 600
+#define NR 600
+#define MAXE 8000
+
+typedef struct MatchEdge { int v; int next; } MatchEdge;
+
+typedef struct {
+    int head[NL+1];
+    MatchEdge edges[MAXE];
+    int edge_cnt;
+} MatchGraph;
+
+void graph_init(MatchGraph *g) {
+    for (int i = 1; i <= NL; i++) g->head[i] = -1;
+    g->edge_cnt = 0;
+}
+
+void match_add_edge(MatchGraph *g, int u, int v) {
+    if (g->edge_cnt >= MAXE) return;
+    g->edges[g->edge_cnt] = (MatchEdge){v, g->head[u]};
+    g->head[u] = g->edge_cnt++;
+}
+
+int pairU[NL+1], pairV[NR+1], distArr[NL+1];
+
+int hk_bfs(MatchGraph *g) {
+    static int queue[NL+1];
+    int qh = 0, qt = 0;
+    for (int u = 1; u <= NL; u++) {
+        if (pairU[u] == 0) { distArr[u] = 0; queue[qt++] = u; }
+        else distArr[u] = INF;
+    }
+    int found = 0;
+    while (qh < qt) {
+        int u = queue[qh++];
+        for (int ei = g->head[u]; ei != -1; ei = g->edges[ei].next) {
+            int v = g->edges[ei].v;
+            int pu = pairV[v];
+            if (pu == 0) found = 1; // free vertex on right reachable
+            else if (distArr[pu] == INF) {
+                distArr[pu] = distArr[u] + 1;
+                queue[qt++] = pu;
+            }
+        }
+    }
+    return found;
+}
+
+int hk_dfs(MatchGraph *g, int u) {
+    for (int ei = g->head[u]; ei != -1; ei = g->edges[ei].next) {
+        int v = g->edges[ei].v;
+        int pu = pairV[v];
+        if (pu == 0 || (distArr[pu] == distArr[u] + 1 && hk_dfs(g, pu))) {
+            pairU[u] = v;
+            pairV[v] = u;
+            return 1;
+        }
+    }
+    distArr[u] = INF;
+    return 0;
+}
+
+int hopcroft_karp(MatchGraph *g) {
+    for (int i = 1; i <= NL; i++) pairU[i] = 0;
+    for (int i = 1; i <= NR; i++) pairV[i] = 0;
+    int matching = 0;
+    while (hk_bfs(g)) {
+        for (int u = 1; u <= NL; u++) {
+            if (pairU[u] == 0) matching += hk_dfs(g, u);
+        }
+    }
+    return matching;
+}
+
+void generate_bipartite_graph(MatchGraph *g) {
+    // Deterministic sparse bipartite graph
+    for (int u = 1; u <= NL; u++) {
+        int deg = 1 + (u % 7);
+        for (int k = 0; k < deg; k++) {
+            int v = 1 + ((u * 37 + k * 13) % NR);
+            match_add_edge(g, u, v);
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Inputs; the source is vertex 0 and the sink vertex n - 1 throughout.
+// Grid: a GRID_LENGTH-wide mesh with arcs both ways between neighbours
+// (capacity 1..100), the source feeding the left column and the right
+// column feeding the sink - many augmenting paths, each at least a grid
+// width long, and many more that wind along the columns. (A square grid of
+// the same size takes Dinic hundreds of phases.) Bipartite: unit
+// capacities, source to every left vertex, GRAPH_DEGREE random arcs to the
+// right, right vertices to the sink (a matching problem). Random: arcs
+// between random vertices, capacity 1..1000. Costs are 1..100 everywhere.
+// ---------------------------------------------------------------------------
+
+enum { GRAPH_GRID, GRAPH_BIPARTITE, GRAPH_RANDOM, NUM_GRAPHS };
+static const char *graph_names[NUM_GRAPHS] = {"grid", "bipartite", "random"};
+
+// top bits only: the LCG's low bits have short periods
+static unsigned int next_rand(unsigned int *seed) {
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 16;
+}
+
+static unsigned int rand_below(unsigned int *seed, unsigned int n) {
+    return (unsigned int)(((unsigned long long)next_rand(seed) << 16 | next_rand(seed)) % n);
+}
+
+static void make_graph(FlowGraph *g, int kind, int arcs, unsigned int seed) {
+    if (kind == GRAPH_GRID) {
+        int w = GRID_LENGTH, h = arcs / (4 * GRID_LENGTH) > 1 ? arcs / (4 * GRID_LENGTH) : 2;
+        int n = w * h + 2, t = n - 1;
+        fg_init(g, n);
+        for (int y = 0; y < h; y++) {
+            fg_add_arc(g, 0, 1 + y * w, 1000, 1 + rand_below(&seed, 100));
+            fg_add_arc(g, 1 + y * w + w - 1, t, 1000, 1 + rand_below(&seed, 100));
+            for (int x = 0; x < w; x++) {
+                int v = 1 + y * w + x;
+                if (x + 1 < w) {
+                    fg_add_arc(g, v, v + 1, 1 + rand_below(&seed, 100), 1 + rand_below(&seed, 100));
+                    fg_add_arc(g, v + 1, v, 1 + rand_below(&seed, 100), 1 + rand_below(&seed, 100));
+                }
+                if (y + 1 < h) {
+                    fg_add_arc(g, v, v + w, 1 + rand_below(&seed, 100), 1 + rand_below(&seed, 100));
+                    fg_add_arc(g, v + w, v, 1 + rand_below(&seed, 100), 1 + rand_below(&seed, 100));
+                }
+            }
+        }
+    } else if (kind == GRAPH_BIPARTITE) {
+        int side = arcs / (GRAPH_DEGREE + 2), n = 2 * side + 2, t = n - 1;
+        fg_init(g, n);
+        for (int i = 0; i < side; i++) {
+            fg_add_arc(g, 0, 1 + i, 1, 0);
+            fg_add_arc(g, 1 + side + i, t, 1, 0);
+        }
+        for (int i = 0; i < side; i++) {
+            for (int k = 0; k < GRAPH_DEGREE; k++) {
+                fg_add_arc(g, 1 + i, 1 + side + rand_below(&seed, side), 1, 1 + rand_below(&seed, 100));
+            }
+        }
+    } else {
+        int n = arcs / GRAPH_DEGREE + 2;
+        fg_init(g, n);
+        for (int e = 0; e < arcs; e++) {
+            int u = rand_below(&seed, n), v = rand_below(&seed, n);
+            if (u == v || v == 0 || u == n - 1) continue;
+            fg_add_arc(g, u, v, 1 + rand_below(&seed, 1000), 1 + rand_below(&seed, 100));
+        }
+    }
+    fg_finalize(g);
+}
+
+static void graph_from_matrix(FlowGraph *g, int m[MAX_V][MAX_V], int n) {
+    fg_init(g, n);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            if (m[i][j] > 0) fg_add_arc(g, i, j, m[i][j], 1);
+        }
+    }
+    fg_finalize(g);
+}
+
+// ---------------------------------------------------------------------------
+// Correctness. Every max-flow engine must match the others, prove its value
+// with a cut of equal capacity, and match 52 on matrix graphs and 98 on its
+// bipartite graph. Min-cost flow must match 151 (with reverse edges) on
+// small networks, both at full flow and at a partial target.
+// ---------------------------------------------------------------------------
+
+static int check_max_flow_engines(FlowGraph *g, long long expect) {
+    int failures = 0;
+    int s = 0, t = g->n - 1;
+    fg_reset(g);
+    if (dinic(g, s, t) != expect || residual_cut(g, s, t, 1) != expect) failures++;
+    for (int rule = PR_FIFO; rule <= PR_HIGHEST; rule++) {
+        fg_reset(g);
+        if (push_relabel(g, s, t, rule, NULL) != expect || residual_cut(g, s, t, 0) != expect) failures++;
+    }
+    fg_reset(g);
+    return failures;
+}
+
+static int check_flow(void) {
+    int failures = 0;
+    static int matrix[MAX_V][MAX_V];
+    FlowGraph g;
+
+    int sizes[4] = {50, 10, 37, 100};
+    unsigned int seed = 5;
+    for (int i = 0; i < 4; i++) {
+        int n = sizes[i];
+        if (i == 0) {
+            create_test_graph(matrix, n);
+        } else {
+            memset(matrix, 0, sizeof(matrix));
+            for (int u = 0; u < n; u++) {
+                for (int v = 0; v < n; v++) {
+                    if (u != v && rand_below(&seed, 100) < 12) matrix[u][v] = 1 + rand_below(&seed, 50);
+                }
+            }
+        }
+        graph_from_matrix(&g, matrix, n);
+        failures += check_max_flow_engines(&g, ford_fulkerson(matrix, 0, n - 1, n));
+        fg_free(&g);
+    }
+
+    for (int kind = 0; kind < NUM_GRAPHS; kind++) {
+        make_graph(&g, kind, CHECK_ARCS, 7 + kind);
+        long long expect = dinic(&g, 0, g.n - 1);
+        failures += check_max_flow_engines(&g, expect);
+        fg_free(&g);
+    }
+
+    // 98's graph: left u -> vertex u, right v -> vertex NL + v
+    static MatchGraph mg;
+    graph_init(&mg);
+    generate_bipartite_graph(&mg);
+    fg_init(&g, NL + NR + 2);
+    for (int u = 1; u <= NL; u++) {
+        fg_add_arc(&g, 0, u, 1, 0);
+        for (int ei = mg.head[u]; ei != -1; ei = mg.edges[ei].next) fg_add_arc(&g, u, NL + mg.edges[ei].v, 1, 0);
+    }
+    for (int v = 1; v <= NR; v++) fg_add_arc(&g, NL + v, NL + NR + 1, 1, 0);
+    fg_finalize(&g);
+    failures += check_max_flow_engines(&g, hopcroft_karp(&mg));
+    fg_free(&g);
+
+    // min-cost flow against 151 on its own network and on random ones
+    static FlowNetwork net;
+    for (int trial = 0; trial < 12; trial++) {
+        int nodes = trial == 0 ? 20 : 8 + rand_below(&seed, 60);
+        init_network(&net, nodes);
+        fg_init(&g, nodes);
+        unsigned int s151 = 42;
+        int edges = trial == 0 ? 15 : 40 + rand_below(&seed, 200);
+        for (int i = 0; i < edges; i++) {
+            int from, to, capacity, cost;
+            if (trial == 0) {   // 151's generator
+                s151 = s151 * 1103515245 + 12345;
+                from = s151 % 18;
+                s151 = s151 * 1103515245 + 12345;
+                to = (from + 1 + s151 % 5) % 20;
+                s151 = s151 * 1103515245 + 12345;
+                capacity = (s151 % 20) + 10;
+                s151 = s151 * 1103515245 + 12345;
+                cost = (s151 % 10) + 1;
+            } else {
+                from = rand_below(&seed, nodes);
+                to = rand_below(&seed, nodes);
+                capacity = 1 + rand_below(&seed, 30);
+                cost = rand_below(&seed, 20);
+            }
+            add_cost_edge(&net, from, to, capacity, cost);
+            fg_add_arc(&g, from, to, capacity, cost);
+        }
+        fg_finalize(&g);
+        int s = 0, t = nodes - 1;
+        long long max_flow = dinic(&g, s, t);
+        fg_reset(&g);
+        long long want = trial == 0 ? 50 : (trial % 2 ? max_flow : max_flow / 2 + 1);
+        long long cost;
+        long long sent = min_cost_flow_pd(&g, s, t, want, &cost);
+        if (sent != (want < max_flow ? want : max_flow)) failures++;
+        if (cost != min_cost_flow(&net, s, t, (int)want)) failures++;
+        fg_free(&g);
+    }
+    return failures;
+}
+
+// ---------------------------------------------------------------------------
+// Benchmark: the max-flow engines on each graph shape (Marcs/s over input
+// arcs, plus push-relabel's relabel / gap / global-relabel counts), then
+// min-cost max flow on smaller graphs of the same shapes.
+// ---------------------------------------------------------------------------
+
+static double seconds_since(clock_t t0) {
+    return (double)(clock() - t0) / CLOCKS_PER_SEC;
+}
+
+int main() {
+    clock_t start = clock();
+    int failures = check_flow();
+
+    printf("Max flow, ~%d arcs per graph (Marcs/s):\n", FLOW_ARCS);
+    printf("%-10s %8s %9s %9s %9s %12s   %s\n", "graph", "n", "dinic", "PR fifo", "PR high", "flow",
+           "relabels/gaps/globals (fifo, high)");
+    for (int kind = 0; kind < NUM_GRAPHS; kind++) {
+        FlowGraph g;
+        make_graph(&g, kind, FLOW_ARCS, 31 + kind);
+        double arcs = g.m / 2;
+        int s = 0, t = g.n - 1;
+        clock_t t0 = clock();
+        long long flow = dinic(&g, s, t);
+        double t_dinic = seconds_since(t0);
+        if (residual_cut(&g, s, t, 1) != flow) failures++;
+
+        PushRelabel stats[2];
+        double t_pr[2];
+        for (int rule = PR_FIFO; rule <= PR_HIGHEST; rule++) {
+            fg_reset(&g);
+            t0 = clock();
+            long long f = push_relabel(&g, s, t, rule, &stats[rule]);
+            t_pr[rule] = seconds_since(t0);
+            if (f != flow || residual_cut(&g, s, t, 0) != flow) failures++;
+        }
+        printf("%-10s %8d %9.2f %9.2f %9.2f %12lld   %d/%d/%d, %d/%d/%d\n", graph_names[kind], g.n,
+               arcs / t_dinic / 1e6, arcs / t_pr[0] / 1e6, arcs / t_pr[1] / 1e6, flow,
+               stats[0].relabels, stats[0].gaps, stats[0].global_relabels,
+               stats[1].relabels, stats[1].gaps, stats[1].global_relabels);
+        fg_free(&g);
+    }
+
+    printf("Min-cost max flow, ~%d arcs per graph:\n", COST_ARCS);
+    for (int kind = 0; kind < NUM_GRAPHS; kind++) {
+        FlowGraph g;
+        make_graph(&g, kind, COST_ARCS, 41 + kind);
+        long long cost;
+        clock_t t0 = clock();
+        long long flow = min_cost_flow_pd(&g, 0, g.n - 1, LLONG_MAX, &cost);
+        double secs = seconds_since(t0);
+        fg_reset(&g);
+        if (dinic(&g, 0, g.n - 1) != flow) failures++;
+        printf("%-10s %8d  flow %8lld  cost %12lld  %.3f s\n", graph_names[kind], g.n, flow, cost, secs);
+        fg_free(&g);
+    }
+
+    clock_t end = clock();
+    printf("Flow library: %d arcs per graph, %d graph kinds, %.6f seconds\n",
+           FLOW_ARCS, NUM_GRAPHS, (double)(end - start) / CLOCKS_PER_SEC);
+    printf("Failures: %d\n", failures);
+    return 0;
+}
@@ -0,0 +1,616 @@
+// PageRank engine: edge lists ingested into pull CSR, edge-balanced worker partitions, Jacobi or
+// Gauss-Seidel sweeps, per-vertex delta tracking for early convergence; synthetic graph benchmark
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#ifdef FULL_SIZE
+#define PR_EDGES (1 << 21)    // edges per benchmark graph; 10^8 needs about 3.5 GB with both CSRs
+#else
+#define PR_EDGES (1 << 17)    // -DFULL_SIZE for 2M edges per graph
+#endif
+#define PR_DEGREE 16          // average out-degree, so vertices = edges / PR_DEGREE
+#define MAX_ITERATIONS 100
+#define DAMPING_FACTOR 0.85
+#define TOLERANCE 1e-6        // stop once the L1 change of a sweep drops below this, as in 197
+#define VERTEX_TOLERANCE 3e-5 // delta mode: relative rank changes below this are not propagated
+#define MAX_WORKERS 8         // sweeps split vertices into ranges of about m / workers in-edges
+#define CHECK_N 2001          // vertices per correctness graph (odd, so slices are uneven)
+
+// ---------------------------------------------------------------------------
+// Simulated workers run one after another. Each phase records the time every
+// worker spent; the slowest one is the phase's span, so work / span estimates
+// the speedup real threads would get (memory bandwidth aside). Serial steps
+// count towards both.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    double work, span;
+    double worker[MAX_WORKERS];
+} WorkClock;
+
+static void phase_start(WorkClock *c) {
+    memset(c->worker, 0, sizeof(c->worker));
+}
+
+static void worker_done(WorkClock *c, int w, clock_t t0) {
+    c->worker[w] += (double)(clock() - t0) / CLOCKS_PER_SEC;
+}
+
+static void phase_end(WorkClock *c, int workers) {
+    double slowest = 0;
+    for (int w = 0; w < workers; w++) {
+        c->work += c->worker[w];
+        if (c->worker[w] > slowest) slowest = c->worker[w];
+    }
+    c->span += slowest;
+}
+
+static void serial_done(WorkClock *c, clock_t t0) {
+    double t = (double)(clock() - t0) / CLOCKS_PER_SEC;
+    c->work += t;
+    c->span += t;
+}
+
+static inline long long slice_begin(long long n, int w, int workers) {
+    return n * w / workers;
+}
+
+// ---------------------------------------------------------------------------
+// Graph. An edge list u -> v is ingested into two CSRs: the in-lists, which
+// the pull sweeps read (rank flows into v from every u that links to it),
+// and the out-lists, which delta mode uses to wake the out-neighbours of a
+// vertex that moved. 1 / out-degree is precomputed per vertex (0 for
+// dangling vertices, whose rank is spread evenly over all vertices instead).
+//
+// Ingestion is two counting sorts done as 219 and 222 build theirs: each
+// worker counts its edge slice into a private row, a prefix over (vertex,
+// worker) split by vertex slices turns the rows into private cursors, and
+// every worker scatters its own edges - no atomics, and the in-lists come
+// out in edge order. The rows take workers x V offsets.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    int n;
+    long long m;
+    long long *in_off;       // n + 1
+    int *in_src;
+    long long *out_off;      // n + 1
+    int *out_dst;
+    double *inv_out;
+    int dangling;            // vertices without out-edges
+} PrGraph;
+
+static void counting_csr(int n, long long m, const int *key, const int *val, long long *off, int *out,
+                         long long *rows, int workers, WorkClock *clk) {
+    long long totals[MAX_WORKERS];
+    phase_start(clk);
+    for (int w = 0; w < workers; w++) {
+        clock_t t0 = clock();
+        long long *row = rows + (size_t)w * n;
+        memset(row, 0, n * sizeof(long long));
+        for (long long e = slice_begin(m, w, workers); e < slice_begin(m, w + 1, workers); e++) row[key[e]]++;
+        worker_done(clk, w, t0);
+    }
+    phase_end(clk, workers);
+
+    phase_start(clk);
+    for (int w = 0; w < workers; w++) {
+        clock_t t0 = clock();
+        long long sum = 0;
+        for (long long v = slice_begin(n, w, workers); v < slice_begin(n, w + 1, workers); v++) {
+            for (int r = 0; r < workers; r++) sum += rows[(size_t)r * n + v];
+        }
+        totals[w] = sum;
+        worker_done(clk, w, t0);
+    }
+    phase_end(clk, workers);
+
+    clock_t t0 = clock();
+    long long sum = 0;
+    for (int w = 0; w < workers; w++) {
+        long long c = totals[w];
+        totals[w] = sum;
+        sum += c;
+    }
+    off[n] = sum;
+    serial_done(clk, t0);
+
+    phase_start(clk);
+    for (int w = 0; w < workers; w++) {
+        clock_t t1 = clock();
+        long long at = totals[w];
+        for (long long v = slice_begin(n, w, workers); v < slice_begin(n, w + 1, workers); v++) {
+            off[v] = at;
+            for (int r = 0; r < workers; r++) {
+                long long c = rows[(size_t)r * n + v];
+                rows[(size_t)r * n + v] = at;
+                at += c;
+            }
+        }
+        worker_done(clk, w, t1);
+    }
+    phase_end(clk, workers);
+
+    phase_start(clk);
+    for (int w = 0; w < workers; w++) {
+        clock_t t1 = clock();
+        long long *row = rows + (size_t)w * n;
+        for (long long e = slice_begin(m, w, workers); e < slice_begin(m, w + 1, workers); e++) {
+            out[row[key[e]]++] = val[e];
+        }
+        worker_done(clk, w, t1);
+    }
+    phase_end(clk, workers);
+}
+
+void pr_graph_build(PrGraph *g, int n, long long m, const int *src, const int *dst, int workers, WorkClock *clk) {
+    memset(clk, 0, sizeof(*clk));
+    g->n = n;
+    g->m = m;
+    g->in_off = (long long*)malloc((n + 1) * sizeof(long long));
+    g->in_src = (int*)malloc((m + 1) * sizeof(int));
+    g->out_off = (long long*)malloc((n + 1) * sizeof(long long));
+    g->out_dst = (int*)malloc((m + 1) * sizeof(int));
+    g->inv_out = (double*)malloc(n * sizeof(double));
+    long long *rows = (long long*)malloc(((size_t)workers * n + 1) * sizeof(long long));
+    counting_csr(n, m, dst, src, g->in_off, g->in_src, rows, workers, clk);
+    counting_csr(n, m, src, dst, g->out_off, g->out_dst, rows, workers, clk);
+    free(rows);
+
+    int counts[MAX_WORKERS];
+    phase_start(clk);
+    for (int w = 0; w < workers; w++) {
+        clock_t t0 = clock();
+        int dangling = 0;
+        for (long long v = slice_begin(n, w, workers); v < slice_begin(n, w + 1, workers); v++) {
+            long long deg = g->out_off[v + 1] - g->out_off[v];
+            g->inv_out[v] = deg ? 1.0 / deg : 0.0;
+            dangling += deg == 0;
+        }
+        counts[w] = dangling;
+        worker_done(clk, w, t0);
+    }
+    phase_end(clk, workers);
+    g->dangling = 0;
+    for (int w = 0; w < workers; w++) g->dangling += counts[w];
+}
+
+void pr_graph_free(PrGraph *g) {
+    free(g->in_off);
+    free(g->in_src);
+    free(g->out_off);
+    free(g->out_dst);
+    free(g->inv_out);
+}
+
+// ---------------------------------------------------------------------------
+// Sweeps. Each vertex keeps contrib = rank * inv_out, so the pull loop is
+// one load and one add per edge:
+//     rank'(v) = base + d * sum over in-edges of contrib(u),
+//     base = (1 - d) / n + d * (rank held by dangling vertices) / n.
+// Workers own row slices with equal in-edge counts (binary search on the
+// CSR offsets), so hubs with huge in-lists do not serialize one worker.
+//
+// Jacobi reads the previous sweep's contribs and writes new arrays. Gauss-
+// Seidel updates rank and contrib in place, so later vertices in the sweep
+// already see the new values and it needs fewer sweeps; with real threads
+// a worker sees other slices' values old or new depending on timing, which
+// still converges to the same vector. Jacobi keeps the total rank at 1 by
+// construction, Gauss-Seidel does not: left alone the lost mass drains at
+// about d per sweep and dominates the residual, so each sweep ends with a
+// cheap O(n) pass scaling rank, contrib and cached in-sums back to 1.
+//
+// Delta mode tracks which vertices can change. A vertex whose rank moved by
+// more than VERTEX_TOLERANCE of its old value wakes its out-neighbours for
+// the next sweep; a vertex nobody woke keeps its cached in-sum and is
+// updated in O(1) for the change of base alone. The in-sums it skips differ from the exact ones
+// by at most the changes that were not propagated.
+// ---------------------------------------------------------------------------
+
+enum { SWEEP_JACOBI, SWEEP_GAUSS_SEIDEL };
+
+typedef struct {
+    int sweep, delta, workers;
+    int max_iterations;
+    double tolerance;
+} PrOptions;
+
+typedef struct {
+    int iterations;
+    long long edges;         // in-edges actually pulled, summed over sweeps
+    double residual;         // L1 change of the last sweep
+} PrStats;
+
+static long long edge_slice_begin(const PrGraph *g, int w, int workers) {
+    long long target = g->m * w / workers;
+    long long lo = 0, hi = g->n;
+    while (lo < hi) {
+        long long mid = lo + (hi - lo) / 2;
+        if (g->in_off[mid] < target) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+void pagerank(const PrGraph *g, const PrOptions *opt, double *result, PrStats *stats, WorkClock *clk) {
+    int n = g->n, workers = opt->workers;
+    const double d = DAMPING_FACTOR;
+    int jacobi = opt->sweep == SWEEP_JACOBI;
+    double *scratch = jacobi ? (double*)malloc(3 * (size_t)n * sizeof(double)) : (double*)malloc(n * sizeof(double));
+    double *rank = result, *contrib = scratch;
+    double *next = jacobi ? scratch + n : rank;
+    double *next_contrib = jacobi ? scratch + 2 * (size_t)n : contrib;
+    double *in_sum = opt->delta ? (double*)malloc(n * sizeof(double)) : NULL;
+    char *awake = opt->delta ? (char*)malloc(n) : NULL;
+    char *wake = opt->delta ? (char*)calloc(n, 1) : NULL;
+    long long bound[MAX_WORKERS + 1];
+    double dangling_part[MAX_WORKERS], delta_part[MAX_WORKERS], mass_part[MAX_WORKERS];
+    long long edges_part[MAX_WORKERS];
+
+    memset(clk, 0, sizeof(*clk));
+    memset(stats, 0, sizeof(*stats));
+    clock_t t0 = clock();
+    for (int w = 0; w <= workers; w++) bound[w] = w == workers ? n : edge_slice_begin(g, w, workers);
+    serial_done(clk, t0);
+
+    double dangling = 0;
+    phase_start(clk);
+    for (int w = 0; w < workers; w++) {
+        clock_t t1 = clock();
+        double dsum = 0;
+        for (long long v = slice_begin(n, w, workers); v < slice_begin(n, w + 1, workers); v++) {
+            rank[v] = 1.0 / n;
+            contrib[v] = rank[v] * g->inv_out[v];
+            if (g->inv_out[v] == 0) dsum += rank[v];
+            if (awake) awake[v] = 1;
+        }
+        dangling_part[w] = dsum;
+        worker_done(clk, w, t1);
+    }
+    phase_end(clk, workers);
+    for (int w = 0; w < workers; w++) dangling += dangling_part[w];
+
+    for (int iter = 0; iter < opt->max_iterations; iter++) {
+        double base = (1.0 - d) / n + d * dangling / n;
+
+        phase_start(clk);
+        for (int w = 0; w < workers; w++) {
+            clock_t t1 = clock();
+            double dsum = 0, delta = 0, mass = 0;
+            long long pulled = 0;
+            for (long long v = bound[w]; v < bound[w + 1]; v++) {
+                double sum;
+                if (!awake || awake[v]) {
+                    sum = 0;
+                    for (long long e = g->in_off[v]; e < g->in_off[v + 1]; e++) sum += contrib[g->in_src[e]];
+                    pulled += g->in_off[v + 1] - g->in_off[v];
+                    if (in_sum) in_sum[v] = sum;
+                } else {
+                    sum = in_sum[v];
+                }
+                double old = rank[v], r = base + d * sum;
+                next[v] = r;
+                next_contrib[v] = r * g->inv_out[v];
+                if (g->inv_out[v] == 0) dsum += r;
+                mass += r;
+                double change = fabs(r - old);
+                delta += change;
+                if (wake && change > VERTEX_TOLERANCE * old) {
+                    for (long long e = g->out_off[v]; e < g->out_off[v + 1]; e++) wake[g->out_dst[e]] = 1;
+                }
+            }
+            dangling_part[w] = dsum;
+            delta_part[w] = delta;
+            mass_part[w] = mass;
+            edges_part[w] = pulled;
+            worker_done(clk, w, t1);
+        }
+        phase_end(clk, workers);
+
+        t0 = clock();
+        double delta = 0, mass = 0;
+        dangling = 0;
+        for (int w = 0; w < workers; w++) {
+            dangling += dangling_part[w];
+            delta += delta_part[w];
+            mass += mass_part[w];
+            stats->edges += edges_part[w];
+        }
+        if (next != rank) {
+            double *t = rank; rank = next; next = t;
+            t = contrib; contrib = next_contrib; next_contrib = t;
+        }
+        if (wake) {
+            char *t = awake; awake = wake; wake = t;
+        }
+        serial_done(clk, t0);
+        if (!jacobi) {
+            double scale = 1.0 / mass;
+            phase_start(clk);
+            for (int w = 0; w < workers; w++) {
+                clock_t t1 = clock();
+                for (long long v = slice_begin(n, w, workers); v < slice_begin(n, w + 1, workers); v++) {
+                    rank[v] *= scale;
+                    contrib[v] *= scale;
+                    if (in_sum) in_sum[v] *= scale;
+                }
+                worker_done(clk, w, t1);
+            }
+            phase_end(clk, workers);
+            dangling *= scale;
+        }
+        if (wake) {
+            phase_start(clk);
+            for (int w = 0; w < workers; w++) {
+                clock_t t1 = clock();
+                long long lo = slice_begin(n, w, workers);
+                memset(wake + lo, 0, slice_begin(n, w + 1, workers) - lo);
+                worker_done(clk, w, t1);
+            }
+            phase_end(clk, workers);
+        }
+        stats->iterations = iter + 1;
+        stats->residual = delta;
+        if (delta < opt->tolerance) break;
+    }
+
+    if (rank != result) memcpy(result, rank, n * sizeof(double));   // Jacobi ended on the scratch copy
+    free(scratch);
+    free(in_sum);
+    free(awake);
+    free(wake);
+}
+
+// ---------------------------------------------------------------------------
+// 197_pagerank_algorithm.c: the dense-matrix reference. It lets the rank of
+// dangling vertices leak away, so it is compared on graphs without any.
+// ---------------------------------------------------------------------------
+
+void compute_pagerank(double **adj_matrix, int n, double *pagerank, double damping) {
+    double *new_rank = (double*)malloc(n * sizeof(double));
+    int *out_degree = (int*)calloc(n, sizeof(int));
+
+    for (int i = 0; i < n; i++) {
+        pagerank[i] = 1.0 / n;
+        for (int j = 0; j < n; j++) {
+            if (adj_matrix[i][j] > 0) {
+                out_degree[i]++;
+            }
+        }
+    }
+
+    for (int iter = 0; iter < MAX_ITERATIONS; iter++) {
+        double diff = 0.0;
+
+        for (int i = 0; i < n; i++) {
+            new_rank[i] = (1.0 - damping) / n;
+
+            for (int j = 0; j < n; j++) {
+                if (adj_matrix[j][i] > 0 && out_degree[j] > 0) {
+                    new_rank[i] += damping * pagerank[j] / out_degree[j];
+                }
+            }
+
+            diff += fabs(new_rank[i] - pagerank[i]);
+        }
+
+        for (int i = 0; i < n; i++) {
+            pagerank[i] = new_rank[i];
+        }
+
+        if (diff < TOLERANCE) {
+            break;
+        }
+    }
+
+    free(new_rank);
+    free(out_degree);
+}
+
+// ---------------------------------------------------------------------------
+// Inputs. R-MAT (the Graph500 recursive-matrix generator, a = 0.57, b = c =
+// 0.19): power-law in- and out-degrees, hubs, plenty of dangling vertices.
+// Uniform: both ends uniformly random. Vertex ids of R-MAT graphs are
+// scrambled so hubs are spread over the id space as in real crawls.
+// ---------------------------------------------------------------------------
+
+enum { GRAPH_RMAT, GRAPH_UNIFORM, NUM_GRAPHS };
+static const char *graph_names[NUM_GRAPHS] = {"rmat", "uniform"};
+
+// top bits only: the LCG's low bits have short periods
+static unsigned int next_rand(unsigned int *seed) {
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 16;
+}
+
+static unsigned int rand_below(unsigned int *seed, unsigned int n) {
+    return (unsigned int)(((unsigned long long)next_rand(seed) << 16 | next_rand(seed)) % n);
+}
+
+// n must be a power of two for R-MAT
+static void make_edges(int kind, int n, long long m, int *src, int *dst, unsigned int seed) {
+    if (kind == GRAPH_UNIFORM) {
+        for (long long e = 0; e < m; e++) {
+            src[e] = rand_below(&seed, n);
+            dst[e] = rand_below(&seed, n);
+        }
+        return;
+    }
+    int bits = 0;
+    while ((1 << bits) < n) bits++;
+    int *scramble = (int*)malloc(n * sizeof(int));
+    for (int i = 0; i < n; i++) scramble[i] = i;
+    for (int i = n - 1; i > 0; i--) {
+        int j = rand_below(&seed, i + 1);
+        int t = scramble[i]; scramble[i] = scramble[j]; scramble[j] = t;
+    }
+    for (long long e = 0; e < m; e++) {
+        int u = 0, v = 0;
+        for (int b = 0; b < bits; b++) {
+            unsigned int r = next_rand(&seed) % 100;
+            int right = r >= 57 && r < 76 ? 1 : r >= 95;   // b quadrant or d quadrant
+            int down = r >= 76;                            // c or d
+            u = u << 1 | down;
+            v = v << 1 | right;
+        }
+        src[e] = scramble[u];
+        dst[e] = scramble[v];
+    }
+    free(scramble);
+}
+
+static double l1_distance(const double *a, const double *b, int n) {
+    double s = 0;
+    for (int i = 0; i < n; i++) s += fabs(a[i] - b[i]);
+    return s;
+}
+
+// ---------------------------------------------------------------------------
+// Correctness: on 197's own graph, Jacobi sweeps must reproduce 197; on
+// R-MAT and uniform graphs every sweep / delta / worker combination must
+// land within a small L1 distance of a tightly converged Jacobi reference,
+// and ranks must still sum to one.
+// ---------------------------------------------------------------------------
+
+static int check_pagerank(void) {
+    int failures = 0;
+    int n = 100;
+    double **adj_matrix = (double**)malloc(n * sizeof(double*));
+    for (int i = 0; i < n; i++) adj_matrix[i] = (double*)calloc(n, sizeof(double));
+    int *src = (int*)malloc(n * n * sizeof(int)), *dst = (int*)malloc(n * n * sizeof(int));
+    long long m = 0;
+    unsigned int seed = 42;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            if (i != j) {
+                seed = seed * 1103515245 + 12345;
+                if ((seed & 0xFF) < 20) {
+                    adj_matrix[i][j] = 1.0;
+                    src[m] = i;
+                    dst[m] = j;
+                    m++;
+                }
+            }
+        }
+    }
+    double *expect = (double*)malloc(n * sizeof(double)), *rank = (double*)malloc(n * sizeof(double));
+    compute_pagerank(adj_matrix, n, expect, DAMPING_FACTOR);
+    PrGraph g;
+    WorkClock clk;
+    PrStats stats;
+    pr_graph_build(&g, n, m, src, dst, 3, &clk);
+    if (g.dangling != 0) failures++;
+    for (int workers = 1; workers <= MAX_WORKERS; workers++) {
+        PrOptions opt = {SWEEP_JACOBI, 0, workers, MAX_ITERATIONS, TOLERANCE};
+        pagerank(&g, &opt, rank, &stats, &clk);
+        for (int i = 0; i < n; i++) {
+            if (fabs(rank[i] - expect[i]) > 1e-12) {
+                failures++;
+                break;
+            }
+        }
+    }
+    pr_graph_free(&g);
+    for (int i = 0; i < n; i++) free(adj_matrix[i]);
+    free(adj_matrix);
+    free(src);
+    free(dst);
+    free(expect);
+    free(rank);
+
+    n = CHECK_N;
+    m = (long long)n * PR_DEGREE;
+    src = (int*)malloc(m * sizeof(int));
+    dst = (int*)malloc(m * sizeof(int));
+    for (int kind = 0; kind < NUM_GRAPHS; kind++) {
+        int vertices = kind == GRAPH_RMAT ? 2048 : n;   // R-MAT wants a power of two
+        expect = (double*)malloc(vertices * sizeof(double));
+        rank = (double*)malloc(vertices * sizeof(double));
+        make_edges(kind, vertices, m, src, dst, 3 + kind);
+        pr_graph_build(&g, vertices, m, src, dst, 5, &clk);
+        PrOptions ref = {SWEEP_JACOBI, 0, 1, 1000, 1e-13};
+        pagerank(&g, &ref, expect, &stats, &clk);
+        for (int sweep = SWEEP_JACOBI; sweep <= SWEEP_GAUSS_SEIDEL; sweep++) {
+            for (int delta = 0; delta <= 1; delta++) {
+                for (int workers = 1; workers <= MAX_WORKERS; workers++) {
+                    PrOptions opt = {sweep, delta, workers, MAX_ITERATIONS, TOLERANCE};
+                    pagerank(&g, &opt, rank, &stats, &clk);
+                    double sum = 0;
+                    for (int i = 0; i < vertices; i++) sum += rank[i];
+                    if (fabs(sum - 1.0) > 1e-6) failures++;
+                    if (l1_distance(rank, expect, vertices) > 2e-5) failures++;
+                }
+            }
+        }
+        pr_graph_free(&g);
+        free(expect);
+        free(rank);
+    }
+    free(src);
+    free(dst);
+    return failures;
+}
+
+// ---------------------------------------------------------------------------
+// Benchmark: ingestion and every sweep / delta combination at 1-8 workers on
+// R-MAT and uniform graphs of PR_EDGES edges. Rates are in-edges pulled per
+// second of simulated critical path (delta mode pulls fewer), with the
+// sweeps to converge and the L1 distance from a tightly converged result.
+// ---------------------------------------------------------------------------
+
+#define NUM_WORKER_COUNTS 4
+static const int bench_workers[NUM_WORKER_COUNTS] = {1, 2, 4, 8};
+static const char *mode_names[4] = {"jacobi", "jacobi+delta", "gauss-seidel", "gs+delta"};
+
+int main() {
+    clock_t start = clock();
+    int failures = check_pagerank();
+
+    long long m = PR_EDGES;
+    int n = (int)(m / PR_DEGREE);
+    int *src = (int*)malloc(m * sizeof(int)), *dst = (int*)malloc(m * sizeof(int));
+    double *rank = (double*)malloc(n * sizeof(double)), *ref = (double*)malloc(n * sizeof(double));
+    for (int kind = 0; kind < NUM_GRAPHS; kind++) {
+        make_edges(kind, n, m, src, dst, 19 + kind);
+        PrGraph g;
+        WorkClock clk;
+        PrStats stats;
+        printf("%s: %d vertices, %lld edges (Medges/s per sweep on the slowest vertex range; xN = all ranges / slowest)\n",
+               graph_names[kind], n, m);
+        printf("  %-13s", "ingest");
+        for (int wi = 0; wi < NUM_WORKER_COUNTS; wi++) {
+            pr_graph_build(&g, n, m, src, dst, bench_workers[wi], &clk);
+            printf(" %7.1f x%-4.1f", 2.0 * m / clk.span / 1e6, clk.work / clk.span);
+            if (wi + 1 < NUM_WORKER_COUNTS) pr_graph_free(&g);
+        }
+        printf("   (%d dangling)\n", g.dangling);
+
+        PrOptions tight = {SWEEP_GAUSS_SEIDEL, 0, 1, 1000, 1e-12};
+        pagerank(&g, &tight, ref, &stats, &clk);
+        for (int mode = 0; mode < 4; mode++) {
+            printf("  %-13s", mode_names[mode]);
+            for (int wi = 0; wi < NUM_WORKER_COUNTS; wi++) {
+                PrOptions opt = {mode / 2, mode % 2, bench_workers[wi], MAX_ITERATIONS, TOLERANCE};
+                pagerank(&g, &opt, rank, &stats, &clk);
+                printf(" %7.1f x%-4.1f", stats.edges / clk.span / 1e6, clk.work / clk.span);
+                if (l1_distance(rank, ref, n) > 1e-4) failures++;
+            }
+            printf("   %3d sweeps, %4.1f%% edges, L1 error %.1e\n", stats.iterations,
+                   100.0 * stats.edges / ((double)m * stats.iterations), l1_distance(rank, ref, n));
+        }
+        pr_graph_free(&g);
+    }
+
+    free(src);
+    free(dst);
+    free(rank);
+    free(ref);
+    clock_t end = clock();
+    printf("PageRank engine: %lld edges per graph, %d graph kinds, %.6f seconds\n",
+           m, NUM_GRAPHS, (double)(end - start) / CLOCKS_PER_SEC);
+    printf("Failures: %d\n", failures);
+    return 0;
+}
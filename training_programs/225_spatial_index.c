@@ -0,0 +1,2137 @@
+// Spatial index library: implicit k-d tree with dimension-major leaf buckets, VP-tree, linear
+// quadtree and uniform grid; batched kNN / radius queries across workers, DBSCAN on top
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#ifdef FULL_SIZE
+#define SPATIAL_POINTS (1 << 17) // points per benchmark set; 10^7 x 16 dims needs about 3 GB with an index copy
+#define NUM_QUERIES (1 << 12) // kNN / radius queries per benchmark batch
+#define CHECK_N 3001          // points per correctness set (odd, so slices are uneven)
+#define CHECK_QUERIES 400     // queries per correctness set
+#define DB_BRUTE_POINTS 8192  // subset 199's DBSCAN runs on in the benchmark
+#else
+#define SPATIAL_POINTS (1 << 12) // -DFULL_SIZE for 128K points and 4K queries
+#define NUM_QUERIES (1 << 9)
+#define CHECK_N 2001          // odd, so slices are uneven, and room for 199's 2000 points
+#define CHECK_QUERIES 32
+#define DB_BRUTE_POINTS 1024
+#endif
+#define MAX_DIM 16
+#define LEAF_SIZE 32          // points per leaf bucket (k-d tree leaves are padded to exactly this)
+#define KNN_K 8               // neighbours per kNN query
+#define KD_SAMPLE 256         // k-d nodes pick their split dimension from this many points
+#define QT_BITS 16            // quadtree quantization per axis, so at most 16 levels
+#define GRID_DIMS 3           // grid cells use at most the first three coordinates
+#define NUM_CLUSTERS 64       // Gaussian blobs in the clustered point sets
+#define CLUSTER_SIGMA 2.0
+#define MIN_POINTS 5          // DBSCAN core threshold, as in 199
+#define MAX_WORKERS 8         // builds split the points, batches split the queries, one range per worker
+#define PAD_COORD 1e150       // fills unused leaf slots; squares stay finite
+
+// ---------------------------------------------------------------------------
+// Simulated workers run one after another. Each phase records the time every
+// worker spent; the slowest one is the phase's span, so work / span estimates
+// the speedup real threads would get (memory bandwidth aside). Serial steps
+// count towards both.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    double work, span;
+    double worker[MAX_WORKERS];
+} WorkClock;
+
+static void phase_start(WorkClock *c) {
+    memset(c->worker, 0, sizeof(c->worker));
+}
+
+static void worker_done(WorkClock *c, int w, clock_t t0) {
+    c->worker[w] += (double)(clock() - t0) / CLOCKS_PER_SEC;
+}
+
+static void phase_end(WorkClock *c, int workers) {
+    double slowest = 0;
+    for (int w = 0; w < workers; w++) {
+        c->work += c->worker[w];
+        if (c->worker[w] > slowest) slowest = c->worker[w];
+    }
+    c->span += slowest;
+}
+
+static void serial_done(WorkClock *c, clock_t t0) {
+    double t = (double)(clock() - t0) / CLOCKS_PER_SEC;
+    c->work += t;
+    c->span += t;
+}
+
+static inline long long slice_begin(long long n, int w, int workers) {
+    return n * w / workers;
+}
+
+// ---------------------------------------------------------------------------
+// Shared pieces. Points are rows of dim doubles. Squared distances always sum
+// the coordinates in order from 0, so every index and the brute-force scan
+// produce bit-identical values for the same pair.
+//
+// counting_csr is 224's stable counting sort: each worker counts its slice of
+// keys into a private row, a prefix over (key, worker) split by key slices
+// turns the rows into private cursors, and every worker scatters its own
+// values. Grid cells, quadtree radix passes and query batching all use it.
+// ---------------------------------------------------------------------------
+
+static inline double row_dist2(const double *a, const double *b, int dim) {
+    double s = 0;
+    for (int j = 0; j < dim; j++) {
+        double t = a[j] - b[j];
+        s += t * t;
+    }
+    return s;
+}
+
+static void counting_csr(int n, long long m, const int *key, const int *val, long long *off, int *out,
+                         long long *rows, int workers, WorkClock *clk) {
+    long long totals[MAX_WORKERS];
+    phase_start(clk);
+    for (int w = 0; w < workers; w++) {
+        clock_t t0 = clock();
+        long long *row = rows + (size_t)w * n;
+        memset(row, 0, n * sizeof(long long));
+        for (long long e = slice_begin(m, w, workers); e < slice_begin(m, w + 1, workers); e++) row[key[e]]++;
+        worker_done(clk, w, t0);
+    }
+    phase_end(clk, workers);
+
+    phase_start(clk);
+    for (int w = 0; w < workers; w++) {
+        clock_t t0 = clock();
+        long long sum = 0;
+        for (long long v = slice_begin(n, w, workers); v < slice_begin(n, w + 1, workers); v++) {
+            for (int r = 0; r < workers; r++) sum += rows[(size_t)r * n + v];
+        }
+        totals[w] = sum;
+        worker_done(clk, w, t0);
+    }
+    phase_end(clk, workers);
+
+    clock_t t0 = clock();
+    long long sum = 0;
+    for (int w = 0; w < workers; w++) {
+        long long c = totals[w];
+        totals[w] = sum;
+        sum += c;
+    }
+    off[n] = sum;
+    serial_done(clk, t0);
+
+    phase_start(clk);
+    for (int w = 0; w < workers; w++) {
+        clock_t t1 = clock();
+        long long at = totals[w];
+        for (long long v = slice_begin(n, w, workers); v < slice_begin(n, w + 1, workers); v++) {
+            off[v] = at;
+            for (int r = 0; r < workers; r++) {
+                long long c = rows[(size_t)r * n + v];
+                rows[(size_t)r * n + v] = at;
+                at += c;
+            }
+        }
+        worker_done(clk, w, t1);
+    }
+    phase_end(clk, workers);
+
+    phase_start(clk);
+    for (int w = 0; w < workers; w++) {
+        clock_t t1 = clock();
+        long long *row = rows + (size_t)w * n;
+        for (long long e = slice_begin(m, w, workers); e < slice_begin(m, w + 1, workers); e++) {
+            out[row[key[e]]++] = val[e];
+        }
+        worker_done(clk, w, t1);
+    }
+    phase_end(clk, workers);
+}
+
+static inline void swap_keyed(double *key, int *id, long long i, long long j) {
+    double k = key[i]; key[i] = key[j]; key[j] = k;
+    int t = id[i]; id[i] = id[j]; id[j] = t;
+}
+
+// Hoare partitions around a median-of-3 pivot until kth is in place, so
+// afterwards key[i] <= key[kth] <= key[j] for all i < kth < j. Duplicates
+// stop both scans and split evenly, as in 220's introselect.
+static void select_kth(double *key, int *id, long long n, long long kth) {
+    long long lo = 0, hi = n - 1;
+    while (hi - lo > 16) {
+        long long mid = lo + (hi - lo) / 2;
+        if (key[mid] < key[lo]) swap_keyed(key, id, lo, mid);
+        if (key[hi] < key[lo]) swap_keyed(key, id, lo, hi);
+        if (key[hi] < key[mid]) swap_keyed(key, id, mid, hi);
+        double pivot = key[mid];
+        long long i = lo - 1, j = hi + 1;
+        for (;;) {
+            do i++; while (key[i] < pivot);
+            do j--; while (key[j] > pivot);
+            if (i >= j) break;
+            swap_keyed(key, id, i, j);
+        }
+        if (kth <= j) hi = j;
+        else lo = j + 1;
+    }
+    for (long long i = lo + 1; i <= hi; i++) {
+        for (long long j = i; j > lo && key[j] < key[j - 1]; j--) swap_keyed(key, id, j, j - 1);
+    }
+}
+
+// kNN results live in a bounded max-heap ordered by (distance, id), so ties
+// resolve the same way in every index and the k survivors are well defined.
+typedef struct {
+    int k, size;
+    double *d2;
+    int *id;
+} KnnHeap;
+
+static inline int knn_before(double da, int ia, double db, int ib) {
+    return da < db || (da == db && ia < ib);
+}
+
+static inline double knn_bound(const KnnHeap *h) {
+    return h->size < h->k ? HUGE_VAL : h->d2[0];
+}
+
+static void knn_offer(KnnHeap *h, double d2, int id) {
+    int i;
+    if (h->size < h->k) {
+        i = h->size++;
+        while (i > 0 && knn_before(h->d2[(i - 1) / 2], h->id[(i - 1) / 2], d2, id)) {
+            h->d2[i] = h->d2[(i - 1) / 2];
+            h->id[i] = h->id[(i - 1) / 2];
+            i = (i - 1) / 2;
+        }
+    } else {
+        if (!knn_before(d2, id, h->d2[0], h->id[0])) return;
+        i = 0;
+        for (;;) {
+            int c = 2 * i + 1;
+            if (c >= h->size) break;
+            if (c + 1 < h->size && knn_before(h->d2[c], h->id[c], h->d2[c + 1], h->id[c + 1])) c++;
+            if (!knn_before(d2, id, h->d2[c], h->id[c])) break;
+            h->d2[i] = h->d2[c];
+            h->id[i] = h->id[c];
+            i = c;
+        }
+    }
+    h->d2[i] = d2;
+    h->id[i] = id;
+}
+
+// heap-sorts in place into ascending order; missing neighbours are id -1
+static void knn_finish(KnnHeap *h) {
+    for (int i = h->size; i < h->k; i++) {
+        h->d2[i] = HUGE_VAL;
+        h->id[i] = -1;
+    }
+    while (h->size > 1) {
+        double d2 = h->d2[h->size - 1];
+        int id = h->id[h->size - 1];
+        h->d2[h->size - 1] = h->d2[0];
+        h->id[h->size - 1] = h->id[0];
+        h->size--;
+        int i = 0;
+        for (;;) {
+            int c = 2 * i + 1;
+            if (c >= h->size) break;
+            if (c + 1 < h->size && knn_before(h->d2[c], h->id[c], h->d2[c + 1], h->id[c + 1])) c++;
+            if (!knn_before(d2, id, h->d2[c], h->id[c])) break;
+            h->d2[i] = h->d2[c];
+            h->id[i] = h->id[c];
+            i = c;
+        }
+        h->d2[i] = d2;
+        h->id[i] = id;
+    }
+}
+
+// radius results go to a growable per-worker buffer
+typedef struct {
+    int *ids;
+    long long size, cap;
+} IdBuffer;
+
+static inline void id_push(IdBuffer *b, int id) {
+    if (b->size == b->cap) {
+        b->cap = b->cap ? 2 * b->cap : 1024;
+        b->ids = (int*)realloc(b->ids, b->cap * sizeof(int));
+    }
+    b->ids[b->size++] = id;
+}
+
+static int compare_ints(const void *a, const void *b) {
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+static void sort_ids(int *a, long long n) {
+    if (n > 32) {
+        qsort(a, n, sizeof(int), compare_ints);
+        return;
+    }
+    for (long long i = 1; i < n; i++) {
+        int v = a[i];
+        long long j = i;
+        for (; j > 0 && a[j - 1] > v; j--) a[j] = a[j - 1];
+        a[j] = v;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Index interface. Each index fills in a SpatialIndex with its query
+// callbacks; the batch drivers below work with any of them. locate maps a
+// query to the leaf (bucket) it falls in: a batch is reordered by bucket
+// first, so consecutive queries walk the same paths and leaves while they
+// are still in cache.
+// ---------------------------------------------------------------------------
+
+typedef void (*KnnFn)(const void *index, const double *q, KnnHeap *h);
+typedef void (*RadiusFn)(const void *index, const double *q, double r2, IdBuffer *out);
+typedef int (*LocateFn)(const void *index, const double *q);
+
+typedef struct {
+    const void *index;
+    int dim;
+    KnnFn knn;            // NULL: no kNN search (quadtree, grid)
+    RadiusFn radius;
+    LocateFn locate;      // NULL: queries run in the caller's order
+    int buckets;          // locate() returns 0 .. buckets - 1
+} SpatialIndex;
+
+// CSR neighbour lists, one per query in query order, ids ascending
+typedef struct {
+    long long *off;       // nq + 1
+    int *ids;
+} NeighborLists;
+
+void neighbor_lists_free(NeighborLists *nl) {
+    free(nl->off);
+    free(nl->ids);
+}
+
+// ---------------------------------------------------------------------------
+// k-d tree, implicit and pointer-free. The tree is complete: level l has
+// 2^l nodes, node p of level l owns points [n p / 2^l, n (p + 1) / 2^l) of
+// the build order, so ranges, children (2i + 1, 2i + 2) and leaves all follow
+// from the index and only the split dimension and value are stored. Levels
+// stop once ranges fit in LEAF_SIZE, so leaves hold LEAF_SIZE / 2 .. LEAF_SIZE
+// points. Each node splits at the median (select_kth on the keys, not a
+// sort) along the dimension with the widest spread over an evenly spaced
+// sample of KD_SAMPLE of its points. A level's nodes are shared across
+// workers; the top levels have fewer nodes than workers and show up in the
+// span.
+//
+// Leaves are copied into fixed-size buckets stored dimension-major
+// (coordinate j of slot i at j * LEAF_SIZE + i): the distance kernel is then
+// dim passes of one fixed-length loop over contiguous doubles, which the
+// compiler vectorizes without intrinsics. Empty slots hold PAD_COORD and id
+// -1. Searches keep, per dimension, how far the query lies outside the
+// current cell (Arya and Mount's incremental distance), so the bound for the
+// far child costs one subtraction and one square.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    int n, dim, levels;          // 1 << levels leaves
+    unsigned char *split_dim;    // (1 << levels) - 1 internal nodes, heap order
+    double *split_val;
+    double *block;               // leaves x dim x LEAF_SIZE
+    int *ids;                    // leaves x LEAF_SIZE
+} KdTree;
+
+static inline long long kd_cut(long long n, long long p, int level) {
+    return (n * p) >> level;
+}
+
+void kd_build(KdTree *t, const double *pts, int n, int dim, int workers, WorkClock *clk) {
+    memset(clk, 0, sizeof(*clk));
+    t->n = n;
+    t->dim = dim;
+    t->levels = 0;
+    while (((long long)n + (1LL << t->levels) - 1) >> t->levels > LEAF_SIZE) t->levels++;
+    int leaves = 1 << t->levels;
+    t->split_dim = (unsigned char*)malloc(leaves);
+    t->split_val = (double*)malloc(leaves * sizeof(double));
+    t->block = (double*)malloc((size_t)leaves * dim * LEAF_SIZE * sizeof(double));
+    t->ids = (int*)malloc((size_t)leaves * LEAF_SIZE * sizeof(int));
+    int *perm = (int*)malloc((n + 1) * sizeof(int));
+    double *key = (double*)malloc((n + 1) * sizeof(double));
+
+    phase_start(clk);
+    for (int w = 0; w < workers; w++) {
+        clock_t t0 = clock();
+        for (long long i = slice_begin(n, w, workers); i < slice_begin(n, w + 1, workers); i++) perm[i] = i;
+        worker_done(clk, w, t0);
+    }
+    phase_end(clk, workers);
+
+    for (int level = 0; level < t->levels; level++) {
+        long long nodes = 1LL << level;
+        phase_start(clk);
+        for (int w = 0; w < workers; w++) {
+            clock_t t0 = clock();
+            for (long long p = slice_begin(nodes, w, workers); p < slice_begin(nodes, w + 1, workers); p++) {
+                long long lo = kd_cut(n, p, level), hi = kd_cut(n, p + 1, level);
+                long long mid = kd_cut(n, 2 * p + 1, level + 1);
+                double mn[MAX_DIM], mx[MAX_DIM];
+                for (int j = 0; j < dim; j++) {
+                    mn[j] = HUGE_VAL;
+                    mx[j] = -HUGE_VAL;
+                }
+                for (long long i = lo; i < hi; i += (hi - lo + KD_SAMPLE - 1) / KD_SAMPLE) {
+                    const double *x = pts + (size_t)perm[i] * dim;
+                    for (int j = 0; j < dim; j++) {
+                        if (x[j] < mn[j]) mn[j] = x[j];
+                        if (x[j] > mx[j]) mx[j] = x[j];
+                    }
+                }
+                int s = 0;
+                for (int j = 1; j < dim; j++) {
+                    if (mx[j] - mn[j] > mx[s] - mn[s]) s = j;
+                }
+                for (long long i = lo; i < hi; i++) key[i] = pts[(size_t)perm[i] * dim + s];
+                select_kth(key + lo, perm + lo, hi - lo, mid - lo);
+                t->split_dim[nodes - 1 + p] = s;
+                t->split_val[nodes - 1 + p] = key[mid];
+            }
+            worker_done(clk, w, t0);
+        }
+        phase_end(clk, workers);
+    }
+
+    phase_start(clk);
+    for (int w = 0; w < workers; w++) {
+        clock_t t0 = clock();
+        for (long long p = slice_begin(leaves, w, workers); p < slice_begin(leaves, w + 1, workers); p++) {
+            long long lo = kd_cut(n, p, t->levels), count = kd_cut(n, p + 1, t->levels) - lo;
+            double *b = t->block + (size_t)p * dim * LEAF_SIZE;
+            for (int i = 0; i < LEAF_SIZE; i++) {
+                int id = i < count ? perm[lo + i] : -1;
+                t->ids[p * LEAF_SIZE + i] = id;
+                for (int j = 0; j < dim; j++) b[j * LEAF_SIZE + i] = id >= 0 ? pts[(size_t)id * dim + j] : PAD_COORD;
+            }
+        }
+        worker_done(clk, w, t0);
+    }
+    phase_end(clk, workers);
+    free(perm);
+    free(key);
+}
+
+void kd_free(KdTree *t) {
+    free(t->split_dim);
+    free(t->split_val);
+    free(t->block);
+    free(t->ids);
+}
+
+static void kd_leaf_dist2(const KdTree *t, int leaf, const double *q, double *d2) {
+    const double *b = t->block + (size_t)leaf * t->dim * LEAF_SIZE;
+    for (int i = 0; i < LEAF_SIZE; i++) d2[i] = 0;
+    for (int j = 0; j < t->dim; j++) {
+        const double *x = b + j * LEAF_SIZE;
+        double qj = q[j];
+        for (int i = 0; i < LEAF_SIZE; i++) {
+            double d = x[i] - qj;
+            d2[i] += d * d;
+        }
+    }
+}
+
+static void kd_knn_node(const KdTree *t, int node, const double *q, double *off, double rd, KnnHeap *h) {
+    int internal = (1 << t->levels) - 1;
+    if (node >= internal) {
+        int leaf = node - internal;
+        double d2[LEAF_SIZE];
+        kd_leaf_dist2(t, leaf, q, d2);
+        const int *ids = t->ids + leaf * LEAF_SIZE;
+        for (int i = 0; i < LEAF_SIZE && ids[i] >= 0; i++) {
+            if (d2[i] <= knn_bound(h)) knn_offer(h, d2[i], ids[i]);
+        }
+        return;
+    }
+    int s = t->split_dim[node];
+    double diff = q[s] - t->split_val[node];
+    int right = diff >= 0;
+    kd_knn_node(t, 2 * node + 1 + right, q, off, rd, h);
+    double old = off[s];
+    double far_rd = rd - old * old + diff * diff;
+    if (far_rd <= knn_bound(h)) {
+        off[s] = diff;
+        kd_knn_node(t, 2 * node + 2 - right, q, off, far_rd, h);
+        off[s] = old;
+    }
+}
+
+static void kd_radius_node(const KdTree *t, int node, const double *q, double *off, double rd, double r2,
+                           IdBuffer *out) {
+    int internal = (1 << t->levels) - 1;
+    if (node >= internal) {
+        int leaf = node - internal;
+        double d2[LEAF_SIZE];
+        kd_leaf_dist2(t, leaf, q, d2);
+        const int *ids = t->ids + leaf * LEAF_SIZE;
+        for (int i = 0; i < LEAF_SIZE && ids[i] >= 0; i++) {
+            if (d2[i] <= r2) id_push(out, ids[i]);
+        }
+        return;
+    }
+    int s = t->split_dim[node];
+    double diff = q[s] - t->split_val[node];
+    int right = diff >= 0;
+    kd_radius_node(t, 2 * node + 1 + right, q, off, rd, r2, out);
+    double old = off[s];
+    double far_rd = rd - old * old + diff * diff;
+    if (far_rd <= r2) {
+        off[s] = diff;
+        kd_radius_node(t, 2 * node + 2 - right, q, off, far_rd, r2, out);
+        off[s] = old;
+    }
+}
+
+static void kd_knn_one(const void *index, const double *q, KnnHeap *h) {
+    double off[MAX_DIM] = {0};
+    kd_knn_node(index, 0, q, off, 0, h);
+}
+
+static void kd_radius_one(const void *index, const double *q, double r2, IdBuffer *out) {
+    double off[MAX_DIM] = {0};
+    kd_radius_node(index, 0, q, off, 0, r2, out);
+}
+
+static int kd_locate(const void *index, const double *q) {
+    const KdTree *t = index;
+    int node = 0, internal = (1 << t->levels) - 1;
+    while (node < internal) node = 2 * node + 1 + (q[t->split_dim[node]] >= t->split_val[node]);
+    return node - internal;
+}
+
+SpatialIndex kd_index(const KdTree *t) {
+    SpatialIndex s = {t, t->dim, kd_knn_one, kd_radius_one, kd_locate, 1 << t->levels};
+    return s;
+}
+
+// ---------------------------------------------------------------------------
+// Vantage-point tree, implicit in the point order. A range [lo, hi) longer
+// than LEAF_SIZE keeps its vantage point at lo; the rest is split at the
+// median distance mu from it into an inner half [lo + 1, mid) (distance
+// <= mu) and an outer half [mid, hi) (>= mu), with mid fixed by the range
+// length alone. Only mu is stored, at mu[lo]. Unlike the k-d tree it prunes
+// with the triangle inequality on true distances, so it does not care how
+// the dimensions are laid out and degrades more gracefully on clustered
+// high-dimensional data. Leaves are scanned row by row.
+//
+// Vantage points are picked pseudo-randomly inside each range. The build
+// runs one frontier of ranges per level across workers; ranges short enough
+// to be leaves drop out of the frontier between levels.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    int n, dim;
+    double *pts;          // n rows in tree order
+    int *ids;
+    double *mu;           // mu[lo] for every split range starting at lo
+} VpTree;
+
+static inline int vp_mid(int lo, int hi) {
+    return lo + 1 + (hi - lo - 1) / 2;
+}
+
+void vp_build(VpTree *t, const double *pts, int n, int dim, int workers, WorkClock *clk) {
+    memset(clk, 0, sizeof(*clk));
+    t->n = n;
+    t->dim = dim;
+    t->pts = (double*)malloc(((size_t)n * dim + 1) * sizeof(double));
+    t->ids = (int*)malloc((n + 1) * sizeof(int));
+    t->mu = (double*)malloc((n + 1) * sizeof(double));
+    double *key = (double*)malloc((n + 1) * sizeof(double));
+    int *frontier = (int*)malloc(2 * (n / LEAF_SIZE + 2) * sizeof(int));   // (lo, hi) pairs
+    int *next = (int*)malloc(4 * (n / LEAF_SIZE + 2) * sizeof(int));
+    int count = 0;
+
+    phase_start(clk);
+    for (int w = 0; w < workers; w++) {
+        clock_t t0 = clock();
+        for (long long i = slice_begin(n, w, workers); i < slice_begin(n, w + 1, workers); i++) t->ids[i] = i;
+        worker_done(clk, w, t0);
+    }
+    phase_end(clk, workers);
+    if (n > LEAF_SIZE) {
+        frontier[0] = 0;
+        frontier[1] = n;
+        count = 1;
+    }
+
+    while (count > 0) {
+        phase_start(clk);
+        for (int w = 0; w < workers; w++) {
+            clock_t t0 = clock();
+            for (long long r = slice_begin(count, w, workers); r < slice_begin(count, w + 1, workers); r++) {
+                int lo = frontier[2 * r], hi = frontier[2 * r + 1], mid = vp_mid(lo, hi);
+                int v = lo + (int)((unsigned int)lo * 2654435761u % (unsigned int)(hi - lo));
+                int t1 = t->ids[lo]; t->ids[lo] = t->ids[v]; t->ids[v] = t1;
+                const double *vp = pts + (size_t)t->ids[lo] * dim;
+                for (int i = lo + 1; i < hi; i++) key[i] = sqrt(row_dist2(pts + (size_t)t->ids[i] * dim, vp, dim));
+                select_kth(key + lo + 1, t->ids + lo + 1, hi - lo - 1, mid - lo - 1);
+                t->mu[lo] = key[mid];
+                next[4 * r] = lo + 1;
+                next[4 * r + 1] = mid;
+                next[4 * r + 2] = mid;
+                next[4 * r + 3] = hi;
+            }
+            worker_done(clk, w, t0);
+        }
+        phase_end(clk, workers);
+
+        clock_t t0 = clock();
+        int kept = 0;
+        for (int c = 0; c < 2 * count; c++) {
+            if (next[2 * c + 1] - next[2 * c] > LEAF_SIZE) {
+                frontier[2 * kept] = next[2 * c];
+                frontier[2 * kept + 1] = next[2 * c + 1];
+                kept++;
+            }
+        }
+        count = kept;
+        serial_done(clk, t0);
+    }
+
+    phase_start(clk);
+    for (int w = 0; w < workers; w++) {
+        clock_t t0 = clock();
+        for (long long i = slice_begin(n, w, workers); i < slice_begin(n, w + 1, workers); i++) {
+            memcpy(t->pts + (size_t)i * dim, pts + (size_t)t->ids[i] * dim, dim * sizeof(double));
+        }
+        worker_done(clk, w, t0);
+    }
+    phase_end(clk, workers);
+    free(key);
+    free(frontier);
+    free(next);
+}
+
+void vp_free(VpTree *t) {
+    free(t->pts);
+    free(t->ids);
+    free(t->mu);
+}
+
+// distances carry a little slack so rounding in sqrt never prunes a point
+// lying exactly on the search radius
+static void vp_knn_range(const VpTree *t, int lo, int hi, const double *q, KnnHeap *h) {
+    if (hi - lo <= LEAF_SIZE) {
+        for (int i = lo; i < hi; i++) {
+            double d2 = row_dist2(t->pts + (size_t)i * t->dim, q, t->dim);
+            if (d2 <= knn_bound(h)) knn_offer(h, d2, t->ids[i]);
+        }
+        return;
+    }
+    double d2 = row_dist2(t->pts + (size_t)lo * t->dim, q, t->dim);
+    knn_offer(h, d2, t->ids[lo]);
+    double d = sqrt(d2), mu = t->mu[lo], slack = 1e-12 * (d + mu);
+    int mid = vp_mid(lo, hi);
+    if (d < mu) {
+        vp_knn_range(t, lo + 1, mid, q, h);
+        if (mu - d <= sqrt(knn_bound(h)) + slack) vp_knn_range(t, mid, hi, q, h);
+    } else {
+        vp_knn_range(t, mid, hi, q, h);
+        if (d - mu <= sqrt(knn_bound(h)) + slack) vp_knn_range(t, lo + 1, mid, q, h);
+    }
+}
+
+static void vp_radius_range(const VpTree *t, int lo, int hi, const double *q, double r2, IdBuffer *out) {
+    if (hi - lo <= LEAF_SIZE) {
+        for (int i = lo; i < hi; i++) {
+            if (row_dist2(t->pts + (size_t)i * t->dim, q, t->dim) <= r2) id_push(out, t->ids[i]);
+        }
+        return;
+    }
+    double d2 = row_dist2(t->pts + (size_t)lo * t->dim, q, t->dim);
+    if (d2 <= r2) id_push(out, t->ids[lo]);
+    double d = sqrt(d2), mu = t->mu[lo], r = sqrt(r2), slack = 1e-12 * (d + mu);
+    int mid = vp_mid(lo, hi);
+    if (d - mu <= r + slack) vp_radius_range(t, lo + 1, mid, q, r2, out);
+    if (mu - d <= r + slack) vp_radius_range(t, mid, hi, q, r2, out);
+}
+
+static void vp_knn_one(const void *index, const double *q, KnnHeap *h) {
+    const VpTree *t = index;
+    vp_knn_range(t, 0, t->n, q, h);
+}
+
+static void vp_radius_one(const void *index, const double *q, double r2, IdBuffer *out) {
+    const VpTree *t = index;
+    vp_radius_range(t, 0, t->n, q, r2, out);
+}
+
+// the bucket is the first position of the leaf range the query descends to
+static int vp_locate(const void *index, const double *q) {
+    const VpTree *t = index;
+    int lo = 0, hi = t->n;
+    while (hi - lo > LEAF_SIZE) {
+        int mid = vp_mid(lo, hi);
+        if (sqrt(row_dist2(t->pts + (size_t)lo * t->dim, q, t->dim)) < t->mu[lo]) {
+            hi = mid;
+            lo++;
+        } else {
+            lo = mid;
+        }
+    }
+    return lo;
+}
+
+SpatialIndex vp_index(const VpTree *t) {
+    SpatialIndex s = {t, t->dim, vp_knn_one, vp_radius_one, vp_locate, t->n + 1};
+    return s;
+}
+
+// ---------------------------------------------------------------------------
+// Linear quadtree (2-D). Points are quantized to QT_BITS per axis inside a
+// square around their bounding box and sorted by Morton (Z-order) code with
+// two stable 16-bit counting passes. A quadtree cell is then a code prefix
+// and owns a contiguous run of the sorted array, so there are no nodes at
+// all: a query descends from the root and finds each child's run by binary
+// search on the codes. Runs that fit in LEAF_SIZE are scanned; cells entirely
+// inside the query are emitted without testing their points. Coordinates
+// are kept as separate x and y arrays in code order.
+//
+// Besides circles, the quadtree answers axis-aligned box queries.
+// Cell boxes are widened by a tiny slack so a point quantized across a cell
+// edge by rounding is never pruned.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    int n;
+    double x0, y0, side;   // root square
+    unsigned int *code;    // Morton codes, ascending
+    double *xs, *ys;
+    int *ids;
+} QuadIndex;
+
+typedef struct {
+    int circle;
+    double x, y;
+    double hx, hy;         // box: half extents, inclusive
+    double r2;             // circle: squared radius, inclusive
+} QtQuery;
+
+static inline unsigned int spread_bits(unsigned int x) {
+    x &= 0xFFFF;
+    x = (x | x << 8) & 0x00FF00FF;
+    x = (x | x << 4) & 0x0F0F0F0F;
+    x = (x | x << 2) & 0x33333333;
+    x = (x | x << 1) & 0x55555555;
+    return x;
+}
+
+static inline unsigned int qt_code(const QuadIndex *t, double x, double y) {
+    double scale = (1 << QT_BITS) / t->side;
+    double fx = (x - t->x0) * scale, fy = (y - t->y0) * scale;
+    int cx = fx < 0 ? 0 : fx >= (1 << QT_BITS) ? (1 << QT_BITS) - 1 : (int)fx;
+    int cy = fy < 0 ? 0 : fy >= (1 << QT_BITS) ? (1 << QT_BITS) - 1 : (int)fy;
+    return spread_bits(cx) | spread_bits(cy) << 1;
+}
+
+void qt_build(QuadIndex *t, const double *pts, int n, int workers, WorkClock *clk) {
+    memset(clk, 0, sizeof(*clk));
+    t->n = n;
+    t->code = (unsigned int*)malloc((n + 1) * sizeof(unsigned int));
+    t->xs = (double*)malloc((n + 1) * sizeof(double));
+    t->ys = (double*)malloc((n + 1) * sizeof(double));
+    t->ids = (int*)malloc((n + 1) * sizeof(int));
+    int *key = (int*)calloc(n + 1, sizeof(int)), *seq = (int*)calloc(n + 1, sizeof(int));
+    long long *off = (long long*)malloc(((1 << 16) + 1) * sizeof(long long));
+    long long *rows = (long long*)malloc((size_t)workers * (1 << 16) * sizeof(long long));
+    double box[MAX_WORKERS][4];
+
+    phase_start(clk);
+    for (int w = 0; w < workers; w++) {
+        clock_t t0 = clock();
+        double *b = box[w];
+        b[0] = b[1] = HUGE_VAL;
+        b[2] = b[3] = -HUGE_VAL;
+        for (long long i = slice_begin(n, w, workers); i < slice_begin(n, w + 1, workers); i++) {
+            double x = pts[2 * i], y = pts[2 * i + 1];
+            if (x < b[0]) b[0] = x;
+            if (y < b[1]) b[1] = y;
+            if (x > b[2]) b[2] = x;
+            if (y > b[3]) b[3] = y;
+        }
+        worker_done(clk, w, t0);
+    }
+    phase_end(clk, workers);
+    clock_t t0 = clock();
+    for (int w = 1; w < workers; w++) {
+        if (box[w][0] < box[0][0]) box[0][0] = box[w][0];
+        if (box[w][1] < box[0][1]) box[0][1] = box[w][1];
+        if (box[w][2] > box[0][2]) box[0][2] = box[w][2];
+        if (box[w][3] > box[0][3]) box[0][3] = box[w][3];
+    }
+    t->x0 = n ? box[0][0] : 0;
+    t->y0 = n ? box[0][1] : 0;
+    t->side = n ? fmax(box[0][2] - box[0][0], box[0][3] - box[0][1]) * (1 + 1e-9) : 0;
+    if (!(t->side > 0)) t->side = 1;
+    serial_done(clk, t0);
+
+    // low 16 code bits first, then the high 16: two stable passes
+    phase_start(clk);
+    for (int w = 0; w < workers; w++) {
+        clock_t t1 = clock();
+        for (long long i = slice_begin(n, w, workers); i < slice_begin(n, w + 1, workers); i++) {
+            t->code[i] = qt_code(t, pts[2 * i], pts[2 * i + 1]);
+            key[i] = t->code[i] & 0xFFFF;
+            seq[i] = i;
+        }
+        worker_done(clk, w, t1);
+    }
+    phase_end(clk, workers);
+    counting_csr(1 << 16, n, key, seq, off, t->ids, rows, workers, clk);
+    phase_start(clk);
+    for (int w = 0; w < workers; w++) {
+        clock_t t1 = clock();
+        for (long long i = slice_begin(n, w, workers); i < slice_begin(n, w + 1, workers); i++) {
+            seq[i] = t->ids[i];
+            key[i] = t->code[seq[i]] >> 16;
+        }
+        worker_done(clk, w, t1);
+    }
+    phase_end(clk, workers);
+    counting_csr(1 << 16, n, key, seq, off, t->ids, rows, workers, clk);
+
+    phase_start(clk);
+    for (int w = 0; w < workers; w++) {
+        clock_t t1 = clock();
+        for (long long i = slice_begin(n, w, workers); i < slice_begin(n, w + 1, workers); i++) key[i] = t->code[t->ids[i]];
+        worker_done(clk, w, t1);
+    }
+    phase_end(clk, workers);
+    phase_start(clk);
+    for (int w = 0; w < workers; w++) {
+        clock_t t1 = clock();
+        for (long long i = slice_begin(n, w, workers); i < slice_begin(n, w + 1, workers); i++) {
+            int id = t->ids[i];
+            t->code[i] = key[i];
+            t->xs[i] = pts[2 * (size_t)id];
+            t->ys[i] = pts[2 * (size_t)id + 1];
+        }
+        worker_done(clk, w, t1);
+    }
+    phase_end(clk, workers);
+    free(key);
+    free(seq);
+    free(off);
+    free(rows);
+}
+
+void qt_free(QuadIndex *t) {
+    free(t->code);
+    free(t->xs);
+    free(t->ys);
+    free(t->ids);
+}
+
+static inline int qt_point_in(const QtQuery *q, double px, double py) {
+    if (!q->circle) return px >= q->x - q->hx && px <= q->x + q->hx && py >= q->y - q->hy && py <= q->y + q->hy;
+    double d = px - q->x, s = d * d;
+    d = py - q->y;
+    s += d * d;
+    return s <= q->r2;
+}
+
+// 0: the cell misses the query, 2: the query covers it, 1: neither
+static int qt_classify(const QtQuery *q, double bx0, double by0, double bx1, double by1) {
+    if (!q->circle) {
+        if (bx1 < q->x - q->hx || bx0 > q->x + q->hx || by1 < q->y - q->hy || by0 > q->y + q->hy) return 0;
+        return bx0 >= q->x - q->hx && bx1 <= q->x + q->hx && by0 >= q->y - q->hy && by1 <= q->y + q->hy ? 2 : 1;
+    }
+    double dx = fmax(fmax(bx0 - q->x, q->x - bx1), 0), dy = fmax(fmax(by0 - q->y, q->y - by1), 0);
+    if (dx * dx + dy * dy > q->r2) return 0;
+    double fx = fmax(q->x - bx0, bx1 - q->x), fy = fmax(q->y - by0, by1 - q->y);
+    return fx * fx + fy * fy <= q->r2 ? 2 : 1;
+}
+
+static int qt_lower_bound(const unsigned int *code, int a, int b, unsigned long long value) {
+    while (a < b) {
+        int mid = a + (b - a) / 2;
+        if (code[mid] < value) a = mid + 1;
+        else b = mid;
+    }
+    return a;
+}
+
+static void qt_visit(const QuadIndex *t, const QtQuery *q, int level, int cx, int cy, unsigned long long base,
+                     int a, int b, IdBuffer *out) {
+    if (a == b) return;
+    double cs = t->side / (1 << level), slack = cs * 1e-6;
+    double bx0 = t->x0 + cx * cs - slack, by0 = t->y0 + cy * cs - slack;
+    int c = qt_classify(q, bx0, by0, bx0 + cs + 2 * slack, by0 + cs + 2 * slack);
+    if (c == 0) return;
+    if (c == 2) {
+        for (int i = a; i < b; i++) id_push(out, t->ids[i]);
+        return;
+    }
+    if (b - a <= LEAF_SIZE || level == QT_BITS) {
+        for (int i = a; i < b; i++) {
+            if (qt_point_in(q, t->xs[i], t->ys[i])) id_push(out, t->ids[i]);
+        }
+        return;
+    }
+    int shift = 2 * (QT_BITS - 1 - level), start = a;
+    for (int k = 0; k < 4; k++) {
+        int end = k == 3 ? b : qt_lower_bound(t->code, start, b, base + ((unsigned long long)(k + 1) << shift));
+        qt_visit(t, q, level + 1, 2 * cx + (k & 1), 2 * cy + (k >> 1), base + ((unsigned long long)k << shift),
+                 start, end, out);
+        start = end;
+    }
+}
+
+// points with |x - cx| <= hx and |y - cy| <= hy
+void qt_box_query(const QuadIndex *t, double cx, double cy, double hx, double hy, IdBuffer *out) {
+    QtQuery q = {0, cx, cy, hx, hy, 0};
+    qt_visit(t, &q, 0, 0, 0, 0, 0, t->n, out);
+}
+
+static void qt_radius_one(const void *index, const double *q, double r2, IdBuffer *out) {
+    const QuadIndex *t = index;
+    QtQuery c = {1, q[0], q[1], 0, 0, r2};
+    qt_visit(t, &c, 0, 0, 0, 0, 0, t->n, out);
+}
+
+// buckets are the 2^16 cells eight levels down
+static int qt_locate(const void *index, const double *q) {
+    return qt_code(index, q[0], q[1]) >> 16;
+}
+
+SpatialIndex qt_index(const QuadIndex *t) {
+    SpatialIndex s = {t, 2, NULL, qt_radius_one, qt_locate, 1 << 16};
+    return s;
+}
+
+// ---------------------------------------------------------------------------
+// Uniform grid over the first min(dim, GRID_DIMS) coordinates. Cells are
+// cubes of the given side (usually the query radius), enlarged until there
+// are at most about two cells per point, and points are bucketed by cell
+// with counting_csr, rows copied in cell order. A radius query scans the
+// block of cells its bounding box touches; cells adjacent along the last
+// grid axis are contiguous, so each row of the block is one run. Distances
+// are tested on all coordinates, so higher dimensions still answer exactly,
+// only with weaker pruning. This is the index for fixed-radius work such as
+// DBSCAN on low-dimensional data.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    int n, dim, gdim;
+    double origin[GRID_DIMS], cell;
+    int extent[GRID_DIMS];
+    int cells;
+    long long *start;      // cells + 1
+    double *pts;           // rows in cell order
+    int *ids;
+} GridIndex;
+
+static inline int grid_cell_of(const GridIndex *g, const double *p) {
+    int c = 0;
+    for (int j = 0; j < g->gdim; j++) {
+        int k = (int)((p[j] - g->origin[j]) / g->cell);
+        if (k < 0) k = 0;
+        if (k >= g->extent[j]) k = g->extent[j] - 1;
+        c = c * g->extent[j] + k;
+    }
+    return c;
+}
+
+void grid_build(GridIndex *g, const double *pts, int n, int dim, double cell, int workers, WorkClock *clk) {
+    memset(clk, 0, sizeof(*clk));
+    g->n = n;
+    g->dim = dim;
+    g->gdim = dim < GRID_DIMS ? dim : GRID_DIMS;
+    double box[MAX_WORKERS][2 * GRID_DIMS];
+    phase_start(clk);
+    for (int w = 0; w < workers; w++) {
+        clock_t t0 = clock();
+        for (int j = 0; j < g->gdim; j++) {
+            box[w][j] = HUGE_VAL;
+            box[w][GRID_DIMS + j] = -HUGE_VAL;
+        }
+        for (long long i = slice_begin(n, w, workers); i < slice_begin(n, w + 1, workers); i++) {
+            for (int j = 0; j < g->gdim; j++) {
+                double x = pts[(size_t)i * dim + j];
+                if (x < box[w][j]) box[w][j] = x;
+                if (x > box[w][GRID_DIMS + j]) box[w][GRID_DIMS + j] = x;
+            }
+        }
+        worker_done(clk, w, t0);
+    }
+    phase_end(clk, workers);
+
+    clock_t t0 = clock();
+    double span[GRID_DIMS];
+    for (int j = 0; j < g->gdim; j++) {
+        double lo = box[0][j], hi = box[0][GRID_DIMS + j];
+        for (int w = 1; w < workers; w++) {
+            if (box[w][j] < lo) lo = box[w][j];
+            if (box[w][GRID_DIMS + j] > hi) hi = box[w][GRID_DIMS + j];
+        }
+        g->origin[j] = n ? lo : 0;
+        span[j] = n ? hi - lo : 0;
+    }
+    g->cell = cell > 0 ? cell : 1;
+    for (;;) {
+        double cells = 1;
+        for (int j = 0; j < g->gdim; j++) cells *= floor(span[j] / g->cell) + 1;
+        if (cells <= 2.0 * n + 16) break;
+        g->cell *= 1.5;
+    }
+    g->cells = 1;
+    for (int j = 0; j < g->gdim; j++) {
+        g->extent[j] = (int)floor(span[j] / g->cell) + 1;
+        g->cells *= g->extent[j];
+    }
+    g->start = (long long*)malloc((g->cells + 1) * sizeof(long long));
+    g->pts = (double*)malloc(((size_t)n * dim + 1) * sizeof(double));
+    g->ids = (int*)malloc((n + 1) * sizeof(int));
+    int *key = (int*)calloc(n + 1, sizeof(int)), *seq = (int*)calloc(n + 1, sizeof(int));
+    long long *rows = (long long*)malloc(((size_t)workers * g->cells + 1) * sizeof(long long));
+    serial_done(clk, t0);
+
+    phase_start(clk);
+    for (int w = 0; w < workers; w++) {
+        clock_t t1 = clock();
+        for (long long i = slice_begin(n, w, workers); i < slice_begin(n, w + 1, workers); i++) {
+            key[i] = grid_cell_of(g, pts + (size_t)i * dim);
+            seq[i] = i;
+        }
+        worker_done(clk, w, t1);
+    }
+    phase_end(clk, workers);
+    counting_csr(g->cells, n, key, seq, g->start, g->ids, rows, workers, clk);
+
+    phase_start(clk);
+    for (int w = 0; w < workers; w++) {
+        clock_t t1 = clock();
+        for (long long i = slice_begin(n, w, workers); i < slice_begin(n, w + 1, workers); i++) {
+            memcpy(g->pts + (size_t)i * dim, pts + (size_t)g->ids[i] * dim, dim * sizeof(double));
+        }
+        worker_done(clk, w, t1);
+    }
+    phase_end(clk, workers);
+    free(key);
+    free(seq);
+    free(rows);
+}
+
+void grid_free(GridIndex *g) {
+    free(g->start);
+    free(g->pts);
+    free(g->ids);
+}
+
+static void grid_radius_one(const void *index, const double *q, double r2, IdBuffer *out) {
+    const GridIndex *g = index;
+    double r = sqrt(r2);
+    int lo[GRID_DIMS], hi[GRID_DIMS], at[GRID_DIMS];
+    for (int j = 0; j < g->gdim; j++) {
+        double a = floor((q[j] - r - g->origin[j]) / g->cell), b = floor((q[j] + r - g->origin[j]) / g->cell);
+        if (b < 0 || a >= g->extent[j]) return;
+        lo[j] = a < 0 ? 0 : (int)a;
+        hi[j] = b >= g->extent[j] ? g->extent[j] - 1 : (int)b;
+        at[j] = lo[j];
+    }
+    int last = g->gdim - 1;
+    for (;;) {
+        int c = 0;
+        for (int j = 0; j < last; j++) c = c * g->extent[j] + at[j];
+        c = c * g->extent[last];
+        for (long long i = g->start[c + lo[last]]; i < g->start[c + hi[last] + 1]; i++) {
+            if (row_dist2(g->pts + (size_t)i * g->dim, q, g->dim) <= r2) id_push(out, g->ids[i]);
+        }
+        int j = last - 1;
+        while (j >= 0 && at[j] == hi[j]) {
+            at[j] = lo[j];
+            j--;
+        }
+        if (j < 0) break;
+        at[j]++;
+    }
+}
+
+static int grid_locate(const void *index, const double *q) {
+    return grid_cell_of(index, q);
+}
+
+SpatialIndex grid_index(const GridIndex *g) {
+    SpatialIndex s = {g, g->dim, NULL, grid_radius_one, grid_locate, g->cells};
+    return s;
+}
+
+// ---------------------------------------------------------------------------
+// Brute force: every query scans every point. The reference for the checks
+// and the baseline row of the benchmark.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    int n, dim;
+    const double *pts;
+} BruteIndex;
+
+static void brute_knn_one(const void *index, const double *q, KnnHeap *h) {
+    const BruteIndex *b = index;
+    for (int i = 0; i < b->n; i++) {
+        double d2 = row_dist2(b->pts + (size_t)i * b->dim, q, b->dim);
+        if (d2 <= knn_bound(h)) knn_offer(h, d2, i);
+    }
+}
+
+static void brute_radius_one(const void *index, const double *q, double r2, IdBuffer *out) {
+    const BruteIndex *b = index;
+    for (int i = 0; i < b->n; i++) {
+        if (row_dist2(b->pts + (size_t)i * b->dim, q, b->dim) <= r2) id_push(out, i);
+    }
+}
+
+SpatialIndex brute_index(const BruteIndex *b) {
+    SpatialIndex s = {b, b->dim, brute_knn_one, brute_radius_one, NULL, 0};
+    return s;
+}
+
+// ---------------------------------------------------------------------------
+// Batched queries. The batch is reordered by bucket with counting_csr (when
+// the index can locate queries), then split into equal slices of that order
+// across workers. kNN writes k (id, squared distance) pairs per query into
+// the caller's arrays, nearest first. Radius queries append to per-worker
+// buffers; a prefix over the per-query counts places every list, and each
+// worker copies its own lists into the shared CSR. Lists come out sorted by
+// id whatever order the index found them in.
+// ---------------------------------------------------------------------------
+
+static int *batch_order(const SpatialIndex *s, const double *queries, int nq, int workers, WorkClock *clk) {
+    if (!s->locate) return NULL;
+    int *bucket = (int*)malloc((nq + 1) * sizeof(int)), *seq = (int*)malloc((nq + 1) * sizeof(int));
+    int *order = (int*)malloc((nq + 1) * sizeof(int));
+    long long *off = (long long*)malloc((s->buckets + 1) * sizeof(long long));
+    long long *rows = (long long*)malloc(((size_t)workers * s->buckets + 1) * sizeof(long long));
+    phase_start(clk);
+    for (int w = 0; w < workers; w++) {
+        clock_t t0 = clock();
+        for (long long i = slice_begin(nq, w, workers); i < slice_begin(nq, w + 1, workers); i++) {
+            bucket[i] = s->locate(s->index, queries + (size_t)i * s->dim);
+            seq[i] = i;
+        }
+        worker_done(clk, w, t0);
+    }
+    phase_end(clk, workers);
+    counting_csr(s->buckets, nq, bucket, seq, off, order, rows, workers, clk);
+    free(bucket);
+    free(seq);
+    free(off);
+    free(rows);
+    return order;
+}
+
+void knn_batch(const SpatialIndex *s, const double *queries, int nq, int k, int *ids, double *dist2,
+               int workers, WorkClock *clk) {
+    memset(clk, 0, sizeof(*clk));
+    int *order = batch_order(s, queries, nq, workers, clk);
+    phase_start(clk);
+    for (int w = 0; w < workers; w++) {
+        clock_t t0 = clock();
+        for (long long i = slice_begin(nq, w, workers); i < slice_begin(nq, w + 1, workers); i++) {
+            long long q = order ? order[i] : i;
+            KnnHeap h = {k, 0, dist2 + q * k, ids + q * k};
+            s->knn(s->index, queries + q * s->dim, &h);
+            knn_finish(&h);
+        }
+        worker_done(clk, w, t0);
+    }
+    phase_end(clk, workers);
+    free(order);
+}
+
+void radius_batch(const SpatialIndex *s, const double *queries, int nq, double r, NeighborLists *out,
+                  int workers, WorkClock *clk) {
+    memset(clk, 0, sizeof(*clk));
+    int *order = batch_order(s, queries, nq, workers, clk);
+    IdBuffer buf[MAX_WORKERS];
+    memset(buf, 0, sizeof(buf));
+    out->off = (long long*)malloc((nq + 1) * sizeof(long long));
+    phase_start(clk);
+    for (int w = 0; w < workers; w++) {
+        clock_t t0 = clock();
+        for (long long i = slice_begin(nq, w, workers); i < slice_begin(nq, w + 1, workers); i++) {
+            long long q = order ? order[i] : i, before = buf[w].size;
+            s->radius(s->index, queries + q * s->dim, r * r, &buf[w]);
+            sort_ids(buf[w].ids + before, buf[w].size - before);
+            out->off[q + 1] = buf[w].size - before;
+        }
+        worker_done(clk, w, t0);
+    }
+    phase_end(clk, workers);
+
+    clock_t t0 = clock();
+    out->off[0] = 0;
+    for (int q = 0; q < nq; q++) out->off[q + 1] += out->off[q];
+    out->ids = (int*)malloc((out->off[nq] + 1) * sizeof(int));
+    serial_done(clk, t0);
+
+    phase_start(clk);
+    for (int w = 0; w < workers; w++) {
+        clock_t t1 = clock();
+        long long at = 0;
+        for (long long i = slice_begin(nq, w, workers); i < slice_begin(nq, w + 1, workers); i++) {
+            long long q = order ? order[i] : i, len = out->off[q + 1] - out->off[q];
+            if (len == 0) continue;    // an idle worker's buffer is still NULL
+            memcpy(out->ids + out->off[q], buf[w].ids + at, len * sizeof(int));
+            at += len;
+        }
+        free(buf[w].ids);
+        worker_done(clk, w, t1);
+    }
+    phase_end(clk, workers);
+    free(order);
+}
+
+// ---------------------------------------------------------------------------
+// DBSCAN over an index. All eps-neighbourhoods are found up front as one
+// batched radius self-join, which is where the time goes; the expansion then
+// follows 199's dbscan step for step on the precomputed lists (same visiting
+// order, same queue rules, same handling of points already marked as noise),
+// so cluster ids match 199 exactly. Labels: cluster 1, 2, ... or -1 for noise.
+// ---------------------------------------------------------------------------
+
+int dbscan_indexed(const SpatialIndex *s, const double *pts, int n, double eps, int min_pts, int *cluster,
+                   int workers, WorkClock *clk) {
+    NeighborLists nb;
+    radius_batch(s, pts, n, eps, &nb, workers, clk);
+    clock_t t0 = clock();
+    char *visited = (char*)calloc(n + 1, 1);
+    int *queue = (int*)malloc((nb.off[n] + 1) * sizeof(int));
+    for (int i = 0; i < n; i++) cluster[i] = 0;
+    int clusters = 0;
+    for (int i = 0; i < n; i++) {
+        if (visited[i]) continue;
+        visited[i] = 1;
+        if (nb.off[i + 1] - nb.off[i] < min_pts) {
+            cluster[i] = -1;
+            continue;
+        }
+        int id = ++clusters;
+        cluster[i] = id;
+        long long head = 0, tail = 0;
+        for (long long e = nb.off[i]; e < nb.off[i + 1]; e++) {
+            if (nb.ids[e] != i) queue[tail++] = nb.ids[e];
+        }
+        while (head < tail) {
+            int p = queue[head++];
+            if (visited[p]) continue;
+            visited[p] = 1;
+            if (nb.off[p + 1] - nb.off[p] >= min_pts) {
+                for (long long e = nb.off[p]; e < nb.off[p + 1]; e++) {
+                    if (cluster[nb.ids[e]] == 0) queue[tail++] = nb.ids[e];
+                }
+            }
+            if (cluster[p] == 0) cluster[p] = id;
+        }
+    }
+    free(visited);
+    free(queue);
+    neighbor_lists_free(&nb);
+    serial_done(clk, t0);
+    return clusters;
+}
+
+// ---------------------------------------------------------------------------
+// 183_kdtree_nearest.c: the pointer k-d tree, one malloc per node, built
+// with a selection sort per node. K renamed KD_K and create_node renamed
+// create_kd_node; free_kd_nodes is new (183 never frees its tree).
+// ---------------------------------------------------------------------------
+
+#define KD_K 2
+
+typedef struct KDNode {
+    double point[KD_K];
+    struct KDNode *left, *right;
+} KDNode;
+
+KDNode* create_kd_node(double *point) {
+    KDNode *node = (KDNode*)malloc(sizeof(KDNode));
+    for (int i = 0; i < KD_K; i++) {
+        node->point[i] = point[i];
+    }
+    node->left = node->right = NULL;
+    return node;
+}
+
+KDNode* build_kdtree(double points[][KD_K], int start, int end, int depth) {
+    if (start > end) return NULL;
+
+    int axis = depth % KD_K;
+    int mid = (start + end) / 2;
+
+    // Simple selection instead of full sort
+    for (int i = start; i <= end; i++) {
+        int min_idx = i;
+        for (int j = i + 1; j <= end; j++) {
+            if (points[j][axis] < points[min_idx][axis]) {
+                min_idx = j;
+            }
+        }
+        if (min_idx != i) {
+            for (int k = 0; k < KD_K; k++) {
+                double temp = points[i][k];
+                points[i][k] = points[min_idx][k];
+                points[min_idx][k] = temp;
+            }
+        }
+    }
+
+    KDNode *node = create_kd_node(points[mid]);
+    node->left = build_kdtree(points, start, mid - 1, depth + 1);
+    node->right = build_kdtree(points, mid + 1, end, depth + 1);
+
+    return node;
+}
+
+double distance_squared(double *a, double *b) {
+    double sum = 0;
+    for (int i = 0; i < KD_K; i++) {
+        double diff = a[i] - b[i];
+        sum += diff * diff;
+    }
+    return sum;
+}
+
+void nearest_neighbor(KDNode *root, double *query, int depth,
+                     double *best_point, double *best_dist) {
+    if (!root) return;
+
+    double dist = distance_squared(root->point, query);
+    if (dist < *best_dist) {
+        *best_dist = dist;
+        for (int i = 0; i < KD_K; i++) {
+            best_point[i] = root->point[i];
+        }
+    }
+
+    int axis = depth % KD_K;
+    double diff = query[axis] - root->point[axis];
+
+    KDNode *near = (diff < 0) ? root->left : root->right;
+    KDNode *far = (diff < 0) ? root->right : root->left;
+
+    nearest_neighbor(near, query, depth + 1, best_point, best_dist);
+
+    if (diff * diff < *best_dist) {
+        nearest_neighbor(far, query, depth + 1, best_point, best_dist);
+    }
+}
+
+static void free_kd_nodes(KDNode *node) {
+    if (!node) return;
+    free_kd_nodes(node->left);
+    free_kd_nodes(node->right);
+    free(node);
+}
+
+// ---------------------------------------------------------------------------
+// 129_vantage_point_tree.c: the pointer VP-tree, which copies both halves
+// into fresh arrays at every node. DIM renamed VP_DIM, Point renamed
+// VpPoint and distance renamed vp_distance.
+// ---------------------------------------------------------------------------
+
+#define VP_DIM 5
+
+typedef struct {
+    double coords[VP_DIM];
+} VpPoint;
+
+typedef struct VPNode {
+    VpPoint point;
+    double median_dist;
+    struct VPNode *left;
+    struct VPNode *right;
+} VPNode;
+
+double vp_distance(VpPoint *a, VpPoint *b) {
+    double sum = 0.0;
+    for (int i = 0; i < VP_DIM; i++) {
+        double diff = a->coords[i] - b->coords[i];
+        sum += diff * diff;
+    }
+    return sqrt(sum);
+}
+
+int compare_dist(const void *a, const void *b) {
+    double *da = (double*)a;
+    double *db = (double*)b;
+    if (*da < *db) return -1;
+    if (*da > *db) return 1;
+    return 0;
+}
+
+VPNode* build_vp_tree(VpPoint points[], int n) {
+    if (n == 0) return NULL;
+
+    VPNode *node = (VPNode*)malloc(sizeof(VPNode));
+    node->point = points[0];
+
+    if (n == 1) {
+        node->left = NULL;
+        node->right = NULL;
+        node->median_dist = 0;
+        return node;
+    }
+
+    // Calculate distances from vantage point
+    double *distances = (double*)malloc((n - 1) * sizeof(double));
+    for (int i = 1; i < n; i++) {
+        distances[i - 1] = vp_distance(&points[0], &points[i]);
+    }
+
+    // Find median distance
+    qsort(distances, n - 1, sizeof(double), compare_dist);
+    node->median_dist = distances[(n - 1) / 2];
+
+    // Partition points
+    VpPoint *left_points = (VpPoint*)malloc((n - 1) * sizeof(VpPoint));
+    VpPoint *right_points = (VpPoint*)malloc((n - 1) * sizeof(VpPoint));
+    int left_count = 0, right_count = 0;
+
+    for (int i = 1; i < n; i++) {
+        double dist = vp_distance(&points[0], &points[i]);
+        if (dist < node->median_dist) {
+            left_points[left_count++] = points[i];
+        } else {
+            right_points[right_count++] = points[i];
+        }
+    }
+
+    // Recursively build subtrees
+    node->left = build_vp_tree(left_points, left_count);
+    node->right = build_vp_tree(right_points, right_count);
+
+    free(distances);
+    free(left_points);
+    free(right_points);
+
+    return node;
+}
+
+void search_nearest(VPNode *node, VpPoint *target, double *best_dist, VpPoint *best_point) {
+    if (!node) return;
+
+    double dist = vp_distance(&node->point, target);
+
+    if (dist < *best_dist) {
+        *best_dist = dist;
+        *best_point = node->point;
+    }
+
+    if (dist < node->median_dist) {
+        search_nearest(node->left, target, best_dist, best_point);
+        if (dist + *best_dist >= node->median_dist) {
+            search_nearest(node->right, target, best_dist, best_point);
+        }
+    } else {
+        search_nearest(node->right, target, best_dist, best_point);
+        if (dist - *best_dist < node->median_dist) {
+            search_nearest(node->left, target, best_dist, best_point);
+        }
+    }
+}
+
+void free_vp_tree(VPNode *node) {
+    if (!node) return;
+    free_vp_tree(node->left);
+    free_vp_tree(node->right);
+    free(node);
+}
+
+// ---------------------------------------------------------------------------
+// 182_quadtree_spatial.c: the pointer quadtree, one malloc per node and per
+// point, with half-open boxes. Point renamed QtPoint, QuadTree renamed
+// QuadTreeNode and range_query renamed quad_range_query; free_quad_nodes is
+// new (182 never frees its tree). 136_quadtree.c is the same structure but
+// its subdivide centres the children half a child off, so points near cell
+// edges are never inserted; it is not used as a reference.
+// ---------------------------------------------------------------------------
+
+#define MAX_POINTS_PER_NODE 4
+
+typedef struct QtPoint {
+    double x, y;
+    struct QtPoint *next;
+} QtPoint;
+
+typedef struct QuadTreeNode {
+    double x, y, width, height;
+    QtPoint *points;
+    int point_count;
+    struct QuadTreeNode *nw, *ne, *sw, *se;
+} QuadTreeNode;
+
+QuadTreeNode* create_quadtree(double x, double y, double width, double height) {
+    QuadTreeNode *node = (QuadTreeNode*)malloc(sizeof(QuadTreeNode));
+    node->x = x;
+    node->y = y;
+    node->width = width;
+    node->height = height;
+    node->points = NULL;
+    node->point_count = 0;
+    node->nw = node->ne = node->sw = node->se = NULL;
+    return node;
+}
+
+int contains_point(QuadTreeNode *qt, double px, double py) {
+    return px >= qt->x && px < qt->x + qt->width &&
+           py >= qt->y && py < qt->y + qt->height;
+}
+
+void subdivide(QuadTreeNode *qt) {
+    double hw = qt->width / 2.0;
+    double hh = qt->height / 2.0;
+
+    qt->nw = create_quadtree(qt->x, qt->y, hw, hh);
+    qt->ne = create_quadtree(qt->x + hw, qt->y, hw, hh);
+    qt->sw = create_quadtree(qt->x, qt->y + hh, hw, hh);
+    qt->se = create_quadtree(qt->x + hw, qt->y + hh, hw, hh);
+}
+
+int insert_point(QuadTreeNode *qt, double x, double y) {
+    if (!contains_point(qt, x, y)) return 0;
+
+    if (qt->point_count < MAX_POINTS_PER_NODE && qt->nw == NULL) {
+        QtPoint *p = (QtPoint*)malloc(sizeof(QtPoint));
+        p->x = x;
+        p->y = y;
+        p->next = qt->points;
+        qt->points = p;
+        qt->point_count++;
+        return 1;
+    }
+
+    if (qt->nw == NULL) {
+        subdivide(qt);
+    }
+
+    if (insert_point(qt->nw, x, y)) return 1;
+    if (insert_point(qt->ne, x, y)) return 1;
+    if (insert_point(qt->sw, x, y)) return 1;
+    if (insert_point(qt->se, x, y)) return 1;
+
+    return 0;
+}
+
+int quad_range_query(QuadTreeNode *qt, double qx, double qy, double qw, double qh, int *count) {
+    if (qt->x > qx + qw || qt->x + qt->width < qx ||
+        qt->y > qy + qh || qt->y + qt->height < qy) {
+        return 0;
+    }
+
+    QtPoint *p = qt->points;
+    while (p) {
+        if (p->x >= qx && p->x < qx + qw && p->y >= qy && p->y < qy + qh) {
+            (*count)++;
+        }
+        p = p->next;
+    }
+
+    if (qt->nw) {
+        quad_range_query(qt->nw, qx, qy, qw, qh, count);
+        quad_range_query(qt->ne, qx, qy, qw, qh, count);
+        quad_range_query(qt->sw, qx, qy, qw, qh, count);
+        quad_range_query(qt->se, qx, qy, qw, qh, count);
+    }
+
+    return *count;
+}
+
+static void free_quad_nodes(QuadTreeNode *qt) {
+    if (!qt) return;
+    while (qt->points) {
+        QtPoint *p = qt->points;
+        qt->points = p->next;
+        free(p);
+    }
+    free_quad_nodes(qt->nw);
+    free_quad_nodes(qt->ne);
+    free_quad_nodes(qt->sw);
+    free_quad_nodes(qt->se);
+    free(qt);
+}
+
+// ---------------------------------------------------------------------------
+// 199_dbscan_clustering.c as it was, with the O(n) brute-force range_query
+// behind every expansion step. DIM renamed DB_DIM and Point renamed DbPoint.
+// 199 queued a point once per core neighbour into an n-entry queue and ran
+// off its end on its own input; the queue now doubles when full, which is
+// the only change. 199 itself now uses a grid; this copy is the reference
+// dbscan_indexed must match label for label.
+// ---------------------------------------------------------------------------
+
+#define DB_DIM 2
+
+typedef struct {
+    double coords[DB_DIM];
+    int cluster_id;
+    int visited;
+} DbPoint;
+
+double euclidean_distance(DbPoint *a, DbPoint *b) {
+    double sum = 0.0;
+    for (int i = 0; i < DB_DIM; i++) {
+        double diff = a->coords[i] - b->coords[i];
+        sum += diff * diff;
+    }
+    return sqrt(sum);
+}
+
+void range_query(DbPoint *points, int n, int point_idx, double eps, int *neighbors, int *count) {
+    *count = 0;
+    for (int i = 0; i < n; i++) {
+        if (euclidean_distance(&points[point_idx], &points[i]) <= eps) {
+            neighbors[(*count)++] = i;
+        }
+    }
+}
+
+void expand_cluster(DbPoint *points, int n, int point_idx, int cluster_id, double eps, int min_pts) {
+    int *neighbors = (int*)malloc(n * sizeof(int));
+    int neighbor_count;
+
+    range_query(points, n, point_idx, eps, neighbors, &neighbor_count);
+
+    if (neighbor_count < min_pts) {
+        points[point_idx].cluster_id = -1;
+        free(neighbors);
+        return;
+    }
+
+    points[point_idx].cluster_id = cluster_id;
+
+    int *queue = (int*)malloc(n * sizeof(int));
+    int queue_size = 0, queue_cap = n;
+
+    for (int i = 0; i < neighbor_count; i++) {
+        int neighbor_idx = neighbors[i];
+        if (neighbor_idx != point_idx) {
+            queue[queue_size++] = neighbor_idx;
+        }
+    }
+
+    int queue_pos = 0;
+    while (queue_pos < queue_size) {
+        int current_idx = queue[queue_pos++];
+
+        if (points[current_idx].visited) continue;
+        points[current_idx].visited = 1;
+
+        int current_neighbor_count;
+        range_query(points, n, current_idx, eps, neighbors, &current_neighbor_count);
+
+        if (current_neighbor_count >= min_pts) {
+            for (int i = 0; i < current_neighbor_count; i++) {
+                int neighbor_idx = neighbors[i];
+                if (points[neighbor_idx].cluster_id == 0) {
+                    if (queue_size == queue_cap) {
+                        queue_cap *= 2;
+                        queue = (int*)realloc(queue, queue_cap * sizeof(int));
+                    }
+                    queue[queue_size++] = neighbor_idx;
+                }
+            }
+        }
+
+        if (points[current_idx].cluster_id == 0) {
+            points[current_idx].cluster_id = cluster_id;
+        }
+    }
+
+    free(neighbors);
+    free(queue);
+}
+
+int dbscan(DbPoint *points, int n, double eps, int min_pts) {
+    int cluster_id = 0;
+
+    for (int i = 0; i < n; i++) {
+        points[i].cluster_id = 0;
+        points[i].visited = 0;
+    }
+
+    for (int i = 0; i < n; i++) {
+        if (points[i].visited) continue;
+
+        points[i].visited = 1;
+
+        int *neighbors = (int*)malloc(n * sizeof(int));
+        int neighbor_count;
+        range_query(points, n, i, eps, neighbors, &neighbor_count);
+
+        if (neighbor_count >= min_pts) {
+            cluster_id++;
+            expand_cluster(points, n, i, cluster_id, eps, min_pts);
+        } else {
+            points[i].cluster_id = -1;
+        }
+
+        free(neighbors);
+    }
+
+    return cluster_id;
+}
+
+// ---------------------------------------------------------------------------
+// Inputs. Clustered: NUM_CLUSTERS Gaussian blobs (sigma CLUSTER_SIGMA) with
+// centres uniform in [0, 100)^dim, plus 10% uniform background. Lattice:
+// integer coordinates 0..7, so exact duplicates and equal distances are
+// everywhere. Uniform: [0, 100)^dim, the distribution 129 and 182 use.
+// ---------------------------------------------------------------------------
+
+enum { POINTS_CLUSTERED, POINTS_LATTICE, POINTS_UNIFORM, NUM_POINT_KINDS };
+
+// top bits only: the LCG's low bits have short periods
+static unsigned int next_rand(unsigned int *seed) {
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 16;
+}
+
+static double rand_unit(unsigned int *seed) {
+    unsigned int hi = next_rand(seed);
+    return (hi * 65536.0 + next_rand(seed)) / 4294967296.0;
+}
+
+static void make_points(int kind, double *pts, int n, int dim, unsigned int seed) {
+    double centre[NUM_CLUSTERS][MAX_DIM];
+    for (int c = 0; c < NUM_CLUSTERS; c++) {
+        for (int j = 0; j < dim; j++) centre[c][j] = rand_unit(&seed) * 100.0;
+    }
+    for (int i = 0; i < n; i++) {
+        double *x = pts + (size_t)i * dim;
+        if (kind == POINTS_LATTICE) {
+            for (int j = 0; j < dim; j++) x[j] = next_rand(&seed) % 8;
+        } else if (kind == POINTS_UNIFORM || next_rand(&seed) % 10 == 0) {
+            for (int j = 0; j < dim; j++) x[j] = rand_unit(&seed) * 100.0;
+        } else {
+            int c = next_rand(&seed) % NUM_CLUSTERS;
+            for (int j = 0; j < dim; j++) {
+                double u = 1.0 - rand_unit(&seed), v = rand_unit(&seed);
+                x[j] = centre[c][j] + CLUSTER_SIGMA * sqrt(-2.0 * log(u)) * cos(6.283185307179586 * v);
+            }
+        }
+    }
+}
+
+enum { INDEX_KD, INDEX_VP, INDEX_QUAD, INDEX_GRID, NUM_INDEXES };
+static const char *index_names[NUM_INDEXES] = {"kd-tree", "vp-tree", "quadtree", "grid"};
+
+// one of each index over the same points; the quadtree only exists for 2-D
+typedef struct {
+    KdTree kd;
+    VpTree vp;
+    QuadIndex qt;
+    GridIndex grid;
+} IndexSet;
+
+static double build_index(int which, IndexSet *set, const double *pts, int n, int dim, double cell,
+                          int workers, SpatialIndex *out) {
+    WorkClock clk;
+    if (which == INDEX_KD) {
+        kd_build(&set->kd, pts, n, dim, workers, &clk);
+        *out = kd_index(&set->kd);
+    } else if (which == INDEX_VP) {
+        vp_build(&set->vp, pts, n, dim, workers, &clk);
+        *out = vp_index(&set->vp);
+    } else if (which == INDEX_QUAD) {
+        qt_build(&set->qt, pts, n, workers, &clk);
+        *out = qt_index(&set->qt);
+    } else {
+        grid_build(&set->grid, pts, n, dim, cell, workers, &clk);
+        *out = grid_index(&set->grid);
+    }
+    return clk.span;
+}
+
+static void free_index(int which, IndexSet *set) {
+    if (which == INDEX_KD) kd_free(&set->kd);
+    else if (which == INDEX_VP) vp_free(&set->vp);
+    else if (which == INDEX_QUAD) qt_free(&set->qt);
+    else grid_free(&set->grid);
+}
+
+static int same_lists(const NeighborLists *a, const NeighborLists *b, int nq) {
+    for (int q = 0; q <= nq; q++) {
+        if (a->off[q] != b->off[q]) return 0;
+    }
+    return memcmp(a->ids, b->ids, a->off[nq] * sizeof(int)) == 0;
+}
+
+// ---------------------------------------------------------------------------
+// Correctness. For every point kind, dimension 2 / 3 / 8 / 16 and a few
+// worker counts, kNN from the k-d and VP trees and radius lists from every
+// index must equal brute force (kNN distances to rounding, ids exactly
+// where distances differ; lists exactly). The radius on the lattice is an
+// integer, so many points sit exactly on the boundary. The ported programs
+// must agree too: 183's and 129's nearest distances, 182's box counts, and
+// 199's labels, which dbscan_indexed must reproduce over every index.
+// ---------------------------------------------------------------------------
+
+static const int check_dims[4] = {2, 3, 8, 16};
+
+static int check_knn(const int *ids, const double *d2, const int *expect_ids, const double *expect_d2, int count) {
+    for (int i = 0; i < count; i++) {
+        if (fabs(d2[i] - expect_d2[i]) > 1e-9 * (1 + expect_d2[i])) return 1;
+        if (ids[i] != expect_ids[i] && d2[i] != expect_d2[i]) return 1;
+    }
+    return 0;
+}
+
+static int check_spatial(void) {
+    int failures = 0;
+    int n = CHECK_N, nq = CHECK_QUERIES;
+    double *pts = (double*)malloc((size_t)n * MAX_DIM * sizeof(double));
+    double *queries = (double*)malloc((size_t)nq * MAX_DIM * sizeof(double));
+    int *ids = (int*)malloc((size_t)nq * KNN_K * sizeof(int)), *expect_ids = (int*)malloc((size_t)nq * KNN_K * sizeof(int));
+    double *d2 = (double*)malloc((size_t)nq * KNN_K * sizeof(double));
+    double *expect_d2 = (double*)malloc((size_t)nq * KNN_K * sizeof(double));
+    WorkClock clk;
+
+    for (int kind = 0; kind < NUM_POINT_KINDS; kind++) {
+        for (int di = 0; di < 4; di++) {
+            int dim = check_dims[di];
+            make_points(kind, pts, n, dim, 7 + kind * 4 + di);
+            // half the queries are data points, half fresh ones
+            memcpy(queries, pts, (size_t)nq / 2 * dim * sizeof(double));
+            make_points(kind, queries + (size_t)nq / 2 * dim, nq - nq / 2, dim, 101 + di);
+            double r = kind == POINTS_LATTICE ? 2.0 : CLUSTER_SIGMA * sqrt(dim);
+            BruteIndex brute = {n, dim, pts};
+            SpatialIndex b = brute_index(&brute);
+            NeighborLists expect, got;
+            knn_batch(&b, queries, nq, KNN_K, expect_ids, expect_d2, 1, &clk);
+            radius_batch(&b, queries, nq, r, &expect, 1, &clk);
+            for (int workers = 1; workers <= MAX_WORKERS; workers += 3) {
+                for (int which = 0; which < NUM_INDEXES; which++) {
+                    if (which == INDEX_QUAD && dim != 2) continue;
+                    IndexSet set;
+                    SpatialIndex s;
+                    build_index(which, &set, pts, n, dim, r, workers, &s);
+                    if (s.knn) {
+                        knn_batch(&s, queries, nq, KNN_K, ids, d2, workers, &clk);
+                        if (check_knn(ids, d2, expect_ids, expect_d2, nq * KNN_K)) failures++;
+                        knn_batch(&s, queries, nq, 1, ids, d2, workers, &clk);
+                        for (int q = 0; q < nq; q++) {
+                            if (check_knn(ids + q, d2 + q, expect_ids + q * KNN_K, expect_d2 + q * KNN_K, 1)) {
+                                failures++;
+                                break;
+                            }
+                        }
+                    }
+                    radius_batch(&s, queries, nq, r, &got, workers, &clk);
+                    if (!same_lists(&got, &expect, nq)) failures++;
+                    neighbor_lists_free(&got);
+                    free_index(which, &set);
+                }
+            }
+            neighbor_lists_free(&expect);
+        }
+    }
+
+    // 183: 1-NN distances on 2-D points, 129: on 5-D points
+    make_points(POINTS_CLUSTERED, pts, n, KD_K, 11);
+    make_points(POINTS_CLUSTERED, queries, nq, KD_K, 12);
+    double (*kd_points)[KD_K] = (double (*)[2])malloc(n * sizeof(*kd_points));
+    memcpy(kd_points, pts, n * sizeof(*kd_points));
+    KDNode *root = build_kdtree(kd_points, 0, n - 1, 0);
+    KdTree kd;
+    kd_build(&kd, pts, n, KD_K, 3, &clk);
+    SpatialIndex s = kd_index(&kd);
+    knn_batch(&s, queries, nq, 1, ids, d2, 3, &clk);
+    for (int q = 0; q < nq; q++) {
+        double best_point[KD_K], best_dist = 1e30;
+        nearest_neighbor(root, queries + q * KD_K, 0, best_point, &best_dist);
+        if (best_dist != d2[q]) failures++;
+    }
+    kd_free(&kd);
+    free_kd_nodes(root);
+    free(kd_points);
+
+    make_points(POINTS_UNIFORM, pts, n, VP_DIM, 13);
+    make_points(POINTS_UNIFORM, queries, nq, VP_DIM, 14);
+    VpPoint *vp_points = (VpPoint*)malloc(n * sizeof(VpPoint));
+    memcpy(vp_points, pts, n * sizeof(VpPoint));
+    VPNode *tree = build_vp_tree(vp_points, n);
+    VpTree vp;
+    vp_build(&vp, pts, n, VP_DIM, 4, &clk);
+    s = vp_index(&vp);
+    knn_batch(&s, queries, nq, 1, ids, d2, 4, &clk);
+    for (int q = 0; q < nq; q++) {
+        double best_dist = 1e100;
+        VpPoint best_point;
+        search_nearest(tree, (VpPoint*)(queries + q * VP_DIM), &best_dist, &best_point);
+        if (fabs(best_dist - sqrt(d2[q])) > 1e-12 * (1 + best_dist)) failures++;
+    }
+    vp_free(&vp);
+    free_vp_tree(tree);
+    free(vp_points);
+
+    // 182: 20 x 20 box counts on its 100 x 100 square (no point lands on a
+    // box edge, so its half-open boxes and ours count the same points)
+    make_points(POINTS_UNIFORM, pts, n, 2, 15);
+    QuadTreeNode *qtree = create_quadtree(0.0, 0.0, 100.0, 100.0);
+    for (int i = 0; i < n; i++) insert_point(qtree, pts[2 * i], pts[2 * i + 1]);
+    QuadIndex qt;
+    qt_build(&qt, pts, n, 2, &clk);
+    IdBuffer box = {0};
+    unsigned int seed = 123;
+    for (int q = 0; q < nq; q++) {
+        double qx = rand_unit(&seed) * 80.0, qy = rand_unit(&seed) * 80.0;
+        int count = 0;
+        quad_range_query(qtree, qx, qy, 20.0, 20.0, &count);
+        box.size = 0;
+        qt_box_query(&qt, qx + 10.0, qy + 10.0, 10.0, 10.0, &box);
+        if (box.size != count) failures++;
+    }
+    free(box.ids);
+    qt_free(&qt);
+    free_quad_nodes(qtree);
+
+    // 199: its own input (2000 points uniform on 100 x 100, eps 5) and a clustered one
+    DbPoint *db = (DbPoint*)malloc(n * sizeof(DbPoint));
+    int *label = (int*)malloc(n * sizeof(int));
+    for (int kind = 0; kind < 2; kind++) {
+        n = kind == 0 ? 2000 : CHECK_N;
+        if (kind == 0) {
+            seed = 42;
+            for (int i = 0; i < n; i++) {
+                for (int d = 0; d < DB_DIM; d++) {
+                    seed = seed * 1103515245 + 12345;
+                    pts[i * DB_DIM + d] = ((seed & 0xFFFF) / (double)0xFFFF) * 100.0;
+                }
+            }
+        } else {
+            make_points(POINTS_CLUSTERED, pts, n, DB_DIM, 16);
+        }
+        double eps = kind == 0 ? 5.0 : 1.0;
+        for (int i = 0; i < n; i++) memcpy(db[i].coords, pts + i * DB_DIM, sizeof(db[i].coords));
+        int clusters = dbscan(db, n, eps, MIN_POINTS);
+        for (int which = 0; which < NUM_INDEXES; which++) {
+            IndexSet set;
+            build_index(which, &set, pts, n, DB_DIM, eps, 3, &s);
+            if (dbscan_indexed(&s, pts, n, eps, MIN_POINTS, label, 3, &clk) != clusters) failures++;
+            for (int i = 0; i < n; i++) {
+                if (label[i] != db[i].cluster_id) {
+                    failures++;
+                    break;
+                }
+            }
+            free_index(which, &set);
+        }
+    }
+    free(db);
+    free(label);
+
+    free(pts);
+    free(queries);
+    free(ids);
+    free(expect_ids);
+    free(d2);
+    free(expect_d2);
+    return failures;
+}
+
+// ---------------------------------------------------------------------------
+// Benchmark, on SPATIAL_POINTS clustered points. kNN: for 2, 4, 8 and 16
+// dimensions, build rate and batched query rate of the k-d and VP trees at
+// 1-8 workers, with brute force on a small batch for scale. Radius (2-D):
+// every index answers a self-join batch with the radius at which points
+// have about 2 KNN_K neighbours. DBSCAN (2-D): all points clustered over
+// the grid, and 199's brute-force version against dbscan_indexed on a
+// subset small enough for it. Worker rates count only the slowest worker of
+// each phase; xN is the summed time of all workers over that.
+// ---------------------------------------------------------------------------
+
+#define NUM_WORKER_COUNTS 4
+#define BRUTE_QUERIES 32
+static const int bench_workers[NUM_WORKER_COUNTS] = {1, 2, 4, 8};
+static const int bench_dims[4] = {2, 4, 8, 16};
+
+static double seconds_since(clock_t t0) {
+    return (double)(clock() - t0) / CLOCKS_PER_SEC;
+}
+
+int main() {
+    clock_t start = clock();
+    int failures = check_spatial();
+
+    int n = SPATIAL_POINTS, nq = NUM_QUERIES;
+    double *pts = (double*)malloc((size_t)n * MAX_DIM * sizeof(double));
+    double *queries = (double*)malloc((size_t)nq * MAX_DIM * sizeof(double));
+    int *ids = (int*)malloc((size_t)nq * 2 * KNN_K * sizeof(int)), *expect_ids = (int*)malloc(BRUTE_QUERIES * KNN_K * sizeof(int));
+    double *d2 = (double*)malloc((size_t)nq * 2 * KNN_K * sizeof(double));
+    double *expect_d2 = (double*)malloc(BRUTE_QUERIES * KNN_K * sizeof(double));
+    unsigned int seed = 31;
+
+    printf("knn: %d clustered points, k = %d, %d queries (Mpoints/s build, Kqueries/s; xN = all workers / slowest)\n",
+           n, KNN_K, nq);
+    for (int di = 0; di < 4; di++) {
+        int dim = bench_dims[di];
+        make_points(POINTS_CLUSTERED, pts, n, dim, 17 + di);
+        for (int q = 0; q < nq; q++) {
+            memcpy(queries + (size_t)q * dim, pts + (size_t)(next_rand(&seed) * 65536u % n) * dim, dim * sizeof(double));
+        }
+        BruteIndex brute = {n, dim, pts};
+        SpatialIndex b = brute_index(&brute);
+        WorkClock clk;
+        printf("  d=%-2d %-12s", dim, "brute");
+        for (int wi = 0; wi < NUM_WORKER_COUNTS; wi++) {
+            knn_batch(&b, queries, BRUTE_QUERIES, KNN_K, expect_ids, expect_d2, bench_workers[wi], &clk);
+            printf(" %8.2f x%-4.1f", BRUTE_QUERIES / clk.span / 1e3, clk.work / clk.span);
+        }
+        printf("\n");
+        for (int which = INDEX_KD; which <= INDEX_VP; which++) {
+            double build_rate[NUM_WORKER_COUNTS], build_x[NUM_WORKER_COUNTS];
+            printf("  d=%-2d %-12s", dim, index_names[which]);
+            for (int wi = 0; wi < NUM_WORKER_COUNTS; wi++) {
+                IndexSet set;
+                SpatialIndex s;
+                WorkClock bc;
+                if (which == INDEX_KD) {
+                    kd_build(&set.kd, pts, n, dim, bench_workers[wi], &bc);
+                    s = kd_index(&set.kd);
+                } else {
+                    vp_build(&set.vp, pts, n, dim, bench_workers[wi], &bc);
+                    s = vp_index(&set.vp);
+                }
+                build_rate[wi] = n / bc.span / 1e6;
+                build_x[wi] = bc.work / bc.span;
+                knn_batch(&s, queries, nq, KNN_K, ids, d2, bench_workers[wi], &clk);
+                printf(" %8.2f x%-4.1f", nq / clk.span / 1e3, clk.work / clk.span);
+                if (check_knn(ids, d2, expect_ids, expect_d2, BRUTE_QUERIES * KNN_K)) failures++;
+                free_index(which, &set);
+            }
+            printf("   build");
+            for (int wi = 0; wi < NUM_WORKER_COUNTS; wi++) printf(" %.1f x%.1f", build_rate[wi], build_x[wi]);
+            printf("\n");
+        }
+    }
+
+    // radius self-join in 2-D at the median distance to the 2k-th neighbour
+    make_points(POINTS_CLUSTERED, pts, n, 2, 23);
+    for (int q = 0; q < nq; q++) memcpy(queries + 2 * q, pts + 2 * (size_t)(next_rand(&seed) * 65536u % n), 2 * sizeof(double));
+    double r;
+    {
+        KdTree kd;
+        WorkClock clk;
+        kd_build(&kd, pts, n, 2, 1, &clk);
+        SpatialIndex s = kd_index(&kd);
+        knn_batch(&s, queries, nq, 2 * KNN_K, ids, d2, 1, &clk);
+        double *last = (double*)malloc(nq * sizeof(double));
+        for (int q = 0; q < nq; q++) last[q] = d2[(size_t)q * 2 * KNN_K + 2 * KNN_K - 1];
+        int *perm = (int*)malloc(nq * sizeof(int));
+        for (int q = 0; q < nq; q++) perm[q] = q;
+        select_kth(last, perm, nq, nq / 2);
+        r = sqrt(last[nq / 2]);
+        free(last);
+        free(perm);
+        kd_free(&kd);
+    }
+    NeighborLists expect;
+    {
+        WorkClock clk;
+        BruteIndex brute = {n, 2, pts};
+        SpatialIndex b = brute_index(&brute);
+        radius_batch(&b, queries, BRUTE_QUERIES, r, &expect, 1, &clk);
+    }
+    printf("radius: %d clustered 2-D points, r = %.3f, %d queries (Kqueries/s)\n", n, r, nq);
+    long long found = 0;
+    for (int which = 0; which < NUM_INDEXES; which++) {
+        double build_rate[NUM_WORKER_COUNTS];
+        printf("  %-17s", index_names[which]);
+        for (int wi = 0; wi < NUM_WORKER_COUNTS; wi++) {
+            IndexSet set;
+            SpatialIndex s;
+            build_rate[wi] = n / build_index(which, &set, pts, n, 2, r, bench_workers[wi], &s) / 1e6;
+            NeighborLists nl, head;
+            WorkClock clk;
+            radius_batch(&s, queries, nq, r, &nl, bench_workers[wi], &clk);
+            printf(" %8.1f x%-4.1f", nq / clk.span / 1e3, clk.work / clk.span);
+            head.off = nl.off;
+            head.ids = nl.ids;
+            if (!same_lists(&head, &expect, BRUTE_QUERIES)) failures++;
+            found = nl.off[nq];
+            neighbor_lists_free(&nl);
+            free_index(which, &set);
+        }
+        printf("   build Mpoints/s");
+        for (int wi = 0; wi < NUM_WORKER_COUNTS; wi++) printf(" %.1f", build_rate[wi]);
+        printf("\n");
+    }
+    printf("  (%.1f neighbours per query)\n", (double)found / nq);
+    neighbor_lists_free(&expect);
+
+    // DBSCAN: the whole set over the grid, then 199 against the grid on a subset
+    int *label = (int*)malloc(n * sizeof(int)), *label2 = (int*)malloc(n * sizeof(int));
+    printf("dbscan: %d clustered 2-D points, eps = %.3f, min_pts = %d (Mpoints/s incl. grid build)\n",
+           n, r, MIN_POINTS);
+    printf("  %-17s", "grid");
+    int clusters = 0;
+    for (int wi = 0; wi < NUM_WORKER_COUNTS; wi++) {
+        IndexSet set;
+        SpatialIndex s;
+        WorkClock clk;
+        double build = build_index(INDEX_GRID, &set, pts, n, 2, r, bench_workers[wi], &s);
+        clusters = dbscan_indexed(&s, pts, n, r, MIN_POINTS, bench_workers[wi] == 1 ? label : label2,
+                                  bench_workers[wi], &clk);
+        printf(" %8.2f x%-4.1f", n / (build + clk.span) / 1e6, clk.work / clk.span);
+        if (memcmp(label, label2, n * sizeof(int)) && wi > 0) failures++;
+        free_index(INDEX_GRID, &set);
+    }
+    int noise = 0;
+    for (int i = 0; i < n; i++) noise += label[i] == -1;
+    printf("   %d clusters, %d noise\n", clusters, noise);
+
+    int small = DB_BRUTE_POINTS;
+    DbPoint *db = (DbPoint*)malloc(small * sizeof(DbPoint));
+    for (int i = 0; i < small; i++) memcpy(db[i].coords, pts + 2 * i, sizeof(db[i].coords));
+    clock_t t0 = clock();
+    int brute_clusters = dbscan(db, small, r, MIN_POINTS);
+    double brute_time = seconds_since(t0);
+    IndexSet set;
+    SpatialIndex s;
+    WorkClock clk;
+    t0 = clock();
+    build_index(INDEX_GRID, &set, pts, small, 2, r, 1, &s);
+    int grid_clusters = dbscan_indexed(&s, pts, small, r, MIN_POINTS, label, 1, &clk);
+    double grid_time = seconds_since(t0);
+    free_index(INDEX_GRID, &set);
+    if (grid_clusters != brute_clusters) failures++;
+    for (int i = 0; i < small; i++) {
+        if (label[i] != db[i].cluster_id) {
+            failures++;
+            break;
+        }
+    }
+    printf("  199 on %d points: %.4f s brute force, %.4f s over the grid (%d clusters)\n",
+           small, brute_time, grid_time, grid_clusters);
+    free(db);
+    free(label);
+    free(label2);
+
+    free(pts);
+    free(queries);
+    free(ids);
+    free(expect_ids);
+    free(d2);
+    free(expect_d2);
+    clock_t end = clock();
+    printf("Spatial index library: %d points, dims 2-16, %.6f seconds\n",
+           n, (double)(end - start) / CLOCKS_PER_SEC);
+    printf("Failures: %d\n", failures);
+    return 0;
+}
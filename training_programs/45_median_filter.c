@@ -1,5 +1,5 @@
 // Median filter for image noise reduction
-// Sorting-based, sliding window, different from other filters
+// Running-histogram sliding window, different from other filters
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
@@ -12,48 +12,55 @@ typedef struct {
     unsigned char data[HEIGHT][WIDTH];
 } Image;
 
-void insertion_sort(unsigned char *arr, int n) {
-    for (int i = 1; i < n; i++) {
-        unsigned char key = arr[i];
-        int j = i - 1;
-        while (j >= 0 && arr[j] > key) {
-            arr[j + 1] = arr[j];
-            j--;
-        }
-        arr[j + 1] = key;
-    }
+// Running histogram (Huang): 256 fine bins plus 16 coarse bins for the
+// window's values. Sliding one pixel right removes a column and adds a
+// column, and the median query walks at most 16 + 16 bins, instead of
+// sorting window_size^2 values per pixel. Border windows are clipped and the
+// median is the value of rank count/2, as with the sorted window.
+static int histogram_rank(const int *coarse, const int *fine, int rank) {
+    int c = 0;
+    while (rank >= coarse[c]) rank -= coarse[c++];
+    int v = c << 4;
+    while (rank >= fine[v]) rank -= fine[v++];
+    return v;
 }
 
-unsigned char find_median(unsigned char *values, int count) {
-    insertion_sort(values, count);
-    return values[count / 2];
+static void histogram_column(const Image *img, int *coarse, int *fine, int x, int y0, int y1, int delta) {
+    for (int py = y0; py <= y1; py++) {
+        int v = img->data[py][x];
+        fine[v] += delta;
+        coarse[v >> 4] += delta;
+    }
 }
 
 void median_filter(Image *input, Image *output, int window_size) {
     int half = window_size / 2;
-    int max_values = window_size * window_size;
-    unsigned char *window = (unsigned char*)malloc(max_values);
     
     for (int y = 0; y < HEIGHT; y++) {
+        int y0 = y - half < 0 ? 0 : y - half;
+        int y1 = y + half >= HEIGHT ? HEIGHT - 1 : y + half;
+        int rows = y1 - y0 + 1;
+        int coarse[16] = {0}, fine[256] = {0};
+        int count = 0;
+        
+        for (int x = 0; x <= half && x < WIDTH; x++) {
+            histogram_column(input, coarse, fine, x, y0, y1, 1);
+            count += rows;
+        }
+        
         for (int x = 0; x < WIDTH; x++) {
-            int count = 0;
-            
-            for (int wy = -half; wy <= half; wy++) {
-                for (int wx = -half; wx <= half; wx++) {
-                    int py = y + wy;
-                    int px = x + wx;
-                    
-                    if (py >= 0 && py < HEIGHT && px >= 0 && px < WIDTH) {
-                        window[count++] = input->data[py][px];
-                    }
-                }
+            if (x > 0 && x - half - 1 >= 0) {
+                histogram_column(input, coarse, fine, x - half - 1, y0, y1, -1);
+                count -= rows;
+            }
+            if (x > 0 && x + half < WIDTH) {
+                histogram_column(input, coarse, fine, x + half, y0, y1, 1);
+                count += rows;
             }
             
-            output->data[y][x] = find_median(window, count);
+            output->data[y][x] = (unsigned char)histogram_rank(coarse, fine, count / 2);
         }
     }
-    
-    free(window);
 }
 
 void add_salt_pepper_noise(Image *img, int noise_level) {